@@ -0,0 +1,232 @@
+/*
+ * arq.h file
+ *
+ * This file contains the sliding-window ARQ (automatic repeat request) of the lander link. It replaces stop-and-wait,
+ * where every reliable message had to wait a full round trip for its ACK, by a window of frames that can be on the way
+ * at the same time.
+ *
+ *  - Every reliable frame carries a sequence number. The message type gets the MSG_TYPE_RELIABLE bit and the payload
+ *    starts with a 4 byte header: sequence number, oldest unacknowledged sequence number of the sender (base),
+ *    cumulative ACK and selective ACK bitmap.
+ *  - The cumulative ACK is the next sequence number the receiver expects, every frame before it has been received. The
+ *    selective ACK bitmap tells which of the following frames have already arrived, bit 0 is ACK + 1.
+ *  - ACKs ride along on outgoing reliable frames. When there is nothing to send, a MSG_TYPE_ARQ_ACK frame with only the
+ *    ACK and bitmap is sent after ack_delay ticks.
+ *  - Every frame has its own retransmission timer, only frames that have not been (selectively) acknowledged are sent
+ *    again.
+ *  - The receiver delivers frames in order and without duplicates. Frames that arrive early are kept in a small
+ *    reorder buffer until the missing frames are in.
+ *  - A frame that is given up after max_transmissions is skipped by the receiver as soon as it sees a base beyond it.
+ *    A base that is far outside the window means that the other side has restarted, the receiver then starts again
+ *    at that base.
+ *  - The top bit of the selective ACK byte of a reliable frame is the session bit of the sender, bit 0 of the session
+ *    in its configuration. A restart of the sender flips it, the receiver then starts again at the base of the frame
+ *    also when the new sequence numbers fall inside the window of the old session. Without it, a restart early in a
+ *    session looks like a retransmission of frames that were already delivered.
+ *
+ * Reliable frames are built on the Message protocol: received frames are handed to arq_receive and the delivered
+ * frames are normal Messages (without the ARQ header) that can be given to handle_message().
+ *
+ * The payload of a frame is not copied, the caller must keep it unchanged until the frame has been acknowledged. The
+ * messages of payload_messages.h satisfy this.
+ *
+ * Time is given in ticks by the caller, such that the same code runs on the MSP430 and in the host tests.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef ARQ_H
+#define ARQ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <lander_communication_lib/lander_communication_protocol.h>
+#include <lander_communication_lib/slip_frame_writer.h>
+
+// Largest window, must be a power of two and at most 8 such that the selective ACK bitmap fits in one byte
+#define ARQ_WINDOW_MAX 8
+#define ARQ_WINDOW_MASK (ARQ_WINDOW_MAX - 1)
+
+// Size of the ARQ header at the start of the payload: sequence number, base, cumulative ACK and selective ACK bitmap
+#define ARQ_HEADER_SIZE 4
+// Size of the payload of a MSG_TYPE_ARQ_ACK frame: cumulative ACK and selective ACK bitmap
+#define ARQ_ACK_SIZE 2
+// Bit of the selective ACK byte of the ARQ header that holds the session bit of the sender
+#define ARQ_SESSION_BIT 0x80
+#define ARQ_MAX_PAYLOAD_SIZE (MAX_PAYLOAD_SIZE - ARQ_HEADER_SIZE)
+
+// Largest payload that is kept when a frame arrives before the frames in front of it. Larger early frames are dropped
+// and not acknowledged, so the sender repeats them. Kept small because the reorder buffer lives in SRAM.
+#define ARQ_REORDER_PAYLOAD_SIZE 16
+
+typedef struct ARQ_link ARQ_link;
+
+// Sends a frame, for example send_messagev. Returns false if the frame could not be queued.
+typedef bool (*ARQ_send_function)(ARQ_link *link, uint8_t msg_type, const Payload_segment *segments,
+                                  uint8_t segment_count);
+
+// Handles a frame that has been received in order, for example handle_message
+typedef void (*ARQ_deliver_function)(ARQ_link *link, const Message *msg);
+
+// Settings of a link
+typedef struct {
+    uint8_t window;             // frames that may be unacknowledged at the same time, 1 to ARQ_WINDOW_MAX
+    uint16_t timeout;           // ticks before an unacknowledged frame is sent again
+    uint8_t max_transmissions;  // a frame is given up after this many transmissions, 0 means never
+    uint16_t ack_delay;         // ticks to wait for outgoing data to carry an ACK before a separate ACK is sent
+    uint8_t session;            // must differ from the session of the previous start of this side, only bit 0 is sent
+} ARQ_config;
+
+// Statistics of a link, the counters wrap around at 65535
+typedef struct {
+    uint16_t sent;              // new reliable frames
+    uint16_t retransmissions;
+    uint16_t acknowledged;
+    uint16_t failed;            // frames given up after max_transmissions
+    uint16_t delivered;         // frames handed to the deliver function
+    uint16_t duplicates;        // received frames that had already been delivered or buffered
+    uint16_t out_of_order;      // received frames that were kept in the reorder buffer
+    uint16_t skipped;           // frames the other side gave up on
+    uint16_t resynchronisations; // times the other side restarted its sequence numbers
+    uint16_t acks_sent;         // separate MSG_TYPE_ARQ_ACK frames
+} ARQ_statistics;
+
+// Frame that is waiting for its ACK
+typedef struct {
+    const uint8_t *payload;
+    uint8_t length;
+    uint8_t msg_type;
+    uint8_t transmissions;
+    bool acknowledged;
+    uint16_t sent_at;
+} ARQ_tx_slot;
+
+// Frame that arrived before the frames in front of it
+typedef struct {
+    uint8_t msg_type;
+    uint8_t length;
+    uint8_t payload[ARQ_REORDER_PAYLOAD_SIZE];
+} ARQ_rx_slot;
+
+// Link structure
+struct ARQ_link {
+    ARQ_config config;
+    ARQ_send_function send;
+    ARQ_deliver_function deliver;
+    void *context;                          // free for the user of the link
+
+    // sender
+    ARQ_tx_slot tx_slots[ARQ_WINDOW_MAX];   // indexed by sequence number & ARQ_WINDOW_MASK
+    uint8_t base;                           // oldest sequence number that is not acknowledged
+    uint8_t next_seq;                       // sequence number of the next new frame
+
+    // receiver
+    ARQ_rx_slot rx_slots[ARQ_WINDOW_MAX];
+    uint8_t expected;                       // next sequence number to deliver
+    uint8_t rx_mask;                        // bit i is set when frame expected + i is in the reorder buffer
+    uint8_t rx_session;                     // session bit of the last reliable frame, ARQ_SESSION_BIT or 0
+    bool rx_session_known;                  // false until the first reliable frame has arrived
+    bool ack_pending;
+    uint16_t ack_pending_since;
+
+    ARQ_statistics statistics;
+};
+
+/*
+ * Initialises a link and resets its sequence numbers.
+ *
+ * parameters:
+ *  ARQ_link *link: link to initialise
+ *  const ARQ_config *config: settings of the link
+ *  ARQ_send_function send: function that puts a frame on the wire
+ *  ARQ_deliver_function deliver: function that handles the received frames
+ *  void *context: free for the user of the link
+ */
+void arq_init(ARQ_link *link, const ARQ_config *config, ARQ_send_function send, ARQ_deliver_function deliver,
+              void *context);
+
+/*
+ * Gives up every outstanding frame, for example before the initialisation handshake. The sequence numbers continue
+ * such that the other side skips the given up frames. The receiver and the statistics are kept.
+ *
+ * parameters:
+ *  ARQ_link *link: link to reset
+ */
+void arq_reset(ARQ_link *link);
+
+/*
+ * Sends a reliable frame. The payload is not copied and must stay unchanged until the frame has been acknowledged.
+ *
+ * parameters:
+ *  ARQ_link *link: link to send the frame on
+ *  uint8_t msg_type: message type, without the MSG_TYPE_RELIABLE bit
+ *  const uint8_t *payload: address of the payload
+ *  uint8_t length: length of the payload, at most ARQ_MAX_PAYLOAD_SIZE
+ *  uint16_t now: current time in ticks
+ *
+ * Returns:
+ *  bool : false if the window is full or the payload is too large
+ */
+bool arq_send(ARQ_link *link, uint8_t msg_type, const uint8_t *payload, uint8_t length, uint16_t now);
+
+/*
+ * Checks whether a received message belongs to the ARQ (a reliable frame or a separate ACK).
+ *
+ * parameters:
+ *  const Message *msg: received message
+ *
+ * Returns:
+ *  bool : true if the message has to be given to arq_receive
+ */
+bool arq_is_frame(const Message *msg);
+
+/*
+ * Handles a received reliable frame or ACK. Frames that are next in line are delivered right away, followed by the
+ * buffered frames that were waiting for them. The message is used as buffer for the delivered frames, such that no
+ * second Message has to be kept in SRAM.
+ *
+ * parameters:
+ *  ARQ_link *link: link the frame was received on
+ *  Message *msg: received message, its contents are changed
+ *  uint16_t now: current time in ticks
+ */
+void arq_receive(ARQ_link *link, Message *msg, uint16_t now);
+
+/*
+ * Sends the frames whose retransmission timer expired again and sends a separate ACK when one is due. Must be called
+ * regularly, for example from process_received_data().
+ *
+ * parameters:
+ *  ARQ_link *link: link to service
+ *  uint16_t now: current time in ticks
+ */
+void arq_poll(ARQ_link *link, uint16_t now);
+
+/*
+ * Checks whether a frame is no longer waiting for its ACK, because it has been acknowledged or given up.
+ *
+ * parameters:
+ *  const ARQ_link *link: link the frame was sent on
+ *  uint8_t seq: sequence number of the frame
+ *
+ * Returns:
+ *  bool : true if the frame is done
+ */
+bool arq_is_done(const ARQ_link *link, uint8_t seq);
+
+/*
+ * Returns the amount of frames that have been sent but not acknowledged yet.
+ *
+ * parameters:
+ *  const ARQ_link *link: link to inspect
+ *
+ * Returns:
+ *  uint8_t : amount of outstanding frames
+ */
+uint8_t arq_outstanding(const ARQ_link *link);
+
+#endif // ARQ_H
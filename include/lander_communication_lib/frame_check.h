@@ -0,0 +1,155 @@
+/*
+ * frame_check.h file
+ *
+ * This file contains the frame checks that can be used for the Message protocol. The check covers the message type,
+ * the length and the payload of a frame and is sent in place of the checksum field.
+ *
+ *  - FRAME_CHECK_XOR8: the original one byte XOR checksum. It is cheap, but every even number of bit flips in the same
+ *    bit position cancels out, so many corrupted frames are accepted.
+ *  - FRAME_CHECK_CRC16: CRC-16-CCITT (polynomial 0x1021, initial value 0xFFFF, sent high byte first). It detects all
+ *    single and double bit errors, all odd numbers of bit errors and all burst errors up to 16 bits.
+ *
+ * Every link selects its check at compile time, see LANDER_LINK_FRAME_CHECK in lander_communication_protocol.h.
+ *
+ * The CRC is calculated with a 256 entry table that is generated by the compiler. On the MSP430FR5969 the hardware
+ * CRC16 module is used for blocks of data in the main loop. The RX interrupt always uses the table, such that it never
+ * shares the CRC module with the main loop.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef FRAME_CHECK_H
+#define FRAME_CHECK_H
+
+#include <stdint.h>
+
+/**
+ * enumerate object with the frame checks that a link can use
+ */
+typedef enum {
+    FRAME_CHECK_XOR8,
+    FRAME_CHECK_CRC16
+} Frame_check_type;
+
+#define CRC16_CCITT_POLYNOMIAL  0x1021
+#define CRC16_CCITT_INIT        0xFFFF
+
+// CRC lookup table, one entry for every value of the byte that is shifted in
+typedef struct {
+    uint16_t entry[256];
+} CRC16_table;
+
+/*
+ * Calculates one entry of the CRC-16-CCITT table. Used by the compiler to generate crc16_table.
+ */
+constexpr uint16_t crc16_table_entry(uint8_t index)
+{
+    uint16_t crc = (uint16_t)(index << 8);
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ CRC16_CCITT_POLYNOMIAL) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+/*
+ * Generates the complete CRC-16-CCITT table at compile time.
+ */
+constexpr CRC16_table crc16_make_table(void)
+{
+    CRC16_table table = {};
+    for (uint16_t i = 0; i < 256; i++) {
+        table.entry[i] = crc16_table_entry((uint8_t)i);
+    }
+    return table;
+}
+
+// Table generated at compile time, stored in FRAM on the MSP430
+extern const CRC16_table crc16_table;
+
+/*
+ * Returns the amount of bytes the check takes in a frame.
+ */
+static inline uint8_t frame_check_size(Frame_check_type type)
+{
+    return (type == FRAME_CHECK_CRC16) ? 2 : 1;
+}
+
+/*
+ * Returns the start value of the check.
+ */
+static inline uint16_t frame_check_init(Frame_check_type type)
+{
+    return (type == FRAME_CHECK_CRC16) ? CRC16_CCITT_INIT : 0;
+}
+
+/*
+ * Adds one byte to a CRC-16-CCITT with the table. Safe to use in interrupts.
+ */
+static inline uint16_t crc16_update(uint16_t crc, uint8_t byte)
+{
+    return (uint16_t)(crc << 8) ^ crc16_table.entry[(uint8_t)(crc >> 8) ^ byte];
+}
+
+/*
+ * Adds one byte to a check. Safe to use in interrupts.
+ *
+ * parameters:
+ *  Frame_check_type type: check of the link
+ *  uint16_t check: check calculated so far
+ *  uint8_t byte: byte to add
+ *
+ * Returns:
+ *  uint16_t : updated check
+ */
+static inline uint16_t frame_check_update(Frame_check_type type, uint16_t check, uint8_t byte)
+{
+    return (type == FRAME_CHECK_CRC16) ? crc16_update(check, byte) : (uint16_t)(check ^ byte);
+}
+
+/*
+ * Adds a block of bytes to a CRC-16-CCITT with the table.
+ *
+ * parameters:
+ *  uint16_t crc: CRC calculated so far
+ *  const uint8_t *data: address of the data
+ *  uint16_t length: length of the data
+ *
+ * Returns:
+ *  uint16_t : updated CRC
+ */
+uint16_t crc16_block_software(uint16_t crc, const uint8_t *data, uint16_t length);
+
+#if defined(__MSP430__)
+/*
+ * Adds a block of bytes to a CRC-16-CCITT with the hardware CRC16 module. Must not be used in interrupts.
+ *
+ * parameters:
+ *  uint16_t crc: CRC calculated so far
+ *  const uint8_t *data: address of the data
+ *  uint16_t length: length of the data
+ *
+ * Returns:
+ *  uint16_t : updated CRC
+ */
+uint16_t crc16_block_hardware(uint16_t crc, const uint8_t *data, uint16_t length);
+#endif
+
+/*
+ * Adds a block of bytes to a check. Uses the hardware CRC16 module on the MSP430, so it must not be used in interrupts.
+ *
+ * parameters:
+ *  Frame_check_type type: check of the link
+ *  uint16_t check: check calculated so far
+ *  const uint8_t *data: address of the data
+ *  uint16_t length: length of the data
+ *
+ * Returns:
+ *  uint16_t : updated check
+ */
+uint16_t frame_check_block(Frame_check_type type, uint16_t check, const uint8_t *data, uint16_t length);
+
+#endif // FRAME_CHECK_H
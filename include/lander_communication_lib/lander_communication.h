@@ -16,12 +16,42 @@
 #include <lander_communication_lib/lander_communication_protocol.h>
 #include <lander_communication_lib/uart_communication.h>
 #include <lander_communication_lib/payload_messages.h>
+#include <lander_communication_lib/arq.h>
+#include <lander_communication_lib/telemetry.h>
+#include <lander_communication_lib/message_batch.h>
+#include <lander_communication_lib/message_dispatch.h>
+#include <lander_communication_lib/link_speed.h>
+#include <lander_communication_lib/telemetry_log.h>
 #include <system_health_lib/temp_sensors.h>
 #include <msp430.h>
 #include <cstdint>
 
+// Settings of the sliding-window ARQ of the lander link, the ticks are milliseconds of system_tick_now()
+#define LANDER_ARQ_WINDOW 4
+#define LANDER_ARQ_TIMEOUT_MS 15       // same timeout as the former stop-and-wait handshake
+#define LANDER_ARQ_ACK_DELAY_MS 2
+
+// Settings of the link speed negotiation, see link_speed.h
+#define LANDER_LINK_SPEEDS LINK_SPEED_ALL       // speeds the UART of the RDS can run at
+#define LANDER_LINK_SPEED_TIMEOUT_MS 20
+#define LANDER_LINK_SPEED_MAX_TRIES 3
+#define LANDER_LINK_SPEED_ERROR_WINDOW 32       // frames
+#define LANDER_LINK_SPEED_MAX_ERRORS 8          // invalid frames within the window before stepping down
+
+// Settings of the store-and-forward telemetry log, see telemetry_log.h. The block is a persistent array in FRAM.
+#define LANDER_LOG_BLOCK_SIZE 8192              // bytes of FRAM, room for about 530 binary measurements
+#define LANDER_LOG_INDEX_SLOTS 64
+#define LANDER_LOG_FRAME_SIZE 96                // payload of a replay frame, like MESSAGE_BATCH_SIZE_LIMIT
+
 // External global variables
 extern bool ack_received;
+extern ARQ_link lander_arq;
+extern volatile Telemetry_format telemetry_format;
+extern Message_batch message_batch;
+extern Message_dispatcher lander_dispatcher;
+extern Link_speed_negotiator lander_link_speed;
+extern Telemetry_log lander_log;
+extern Telemetry_log_replay lander_log_replay;
 
 /*
  * This method serializes the Message struct such that the data is entered into a buffer
@@ -95,7 +125,117 @@ void send_message_struct(const Message* msg);
 void send_message(uint8_t msg_type, const uint8_t *payload, uint8_t length);
 
 /*
- * Sends a message and waits for an ACK response.
+ * Send a message of the payload message catalog using UART TX
+ * parameters:
+ *  uint8_t msg_type : message type
+ *  Message_id id: catalog message to be sent, e.g. MSG_ID_ACK
+ */
+void send_message(uint8_t msg_type, Message_id id);
+
+/*
+ * Send a message whose payload consists of several parts using UART TX, for example a catalog message
+ * followed by a formatted number. The checksum is calculated over the parts and the frame is SLIP encoded straight
+ * into the transmission queue, without building a Message struct or intermediate buffers. Messages that are waiting
+ * in the message batch are sent first.
+ *
+ * parameters:
+ *  uint8_t msg_type : message type
+ *  const Payload_segment *segments: payload parts in the order in which they are sent
+ *  uint8_t segment_count: amount of payload parts
+ *
+ * Returns:
+ *  bool : false if the payload is too large or the frame has been dropped because the queue was full
+ */
+bool send_messagev(uint8_t msg_type, const Payload_segment *segments, uint8_t segment_count);
+
+/*
+ * Sends the messages that are waiting in the message batch as one frame. process_received_data() does this at the end
+ * of every task step.
+ */
+void flush_message_batch(void);
+
+/*
+ * Opens a scope in which the message batch is only sent when it is full, for example around a sweep that sends many
+ * status messages over several task steps. Scopes can be nested.
+ */
+void begin_message_batch(void);
+
+/*
+ * Closes a begin_message_batch scope and sends the batch when it was the outermost one.
+ */
+void end_message_batch(void);
+
+/*
+ * Sends a status event in the current telemetry format: its catalog message in ASCII telemetry, its 1 byte ID in
+ * binary telemetry. The event is added to the message batch and its binary record to lander_log.
+ *
+ * parameters:
+ *  Telemetry_event event: event to be sent
+ */
+void send_event(Telemetry_event event);
+
+/*
+ * Sends a measurement in the current telemetry format: a decimal number followed by a description in ASCII telemetry,
+ * its ID followed by a 16-bit fixed-point value in binary telemetry. The measurement is added to the message batch and
+ * its binary record to lander_log. The sensors convert their readouts to the fixed-point value themselves, such that
+ * no float is needed (see sensor_fixed_point.h).
+ *
+ * parameters:
+ *  Telemetry_measurement measurement: what is measured
+ *  int16_t fixed_point: measured value times 10^decimals of the measurement, e.g. millivolts or centidegrees
+ */
+void send_measurement_fixed(Telemetry_measurement measurement, int16_t fixed_point);
+
+/*
+ * Initialises the sliding-window ARQ of the lander link.
+ */
+void lander_arq_init(void);
+
+/*
+ * Initialises the message dispatcher of the lander link with the handlers of the protocol: INIT, ACK, DEPLOY, the
+ * telemetry format requests "TA" and "TB" and the transit mode commands. Subsystems register their own handlers on
+ * lander_dispatcher afterwards.
+ */
+void lander_dispatch_init(void);
+
+/*
+ * Initialises the link speed negotiation of the lander link at 115200 baud and registers its handler on
+ * lander_dispatcher, so it is called after lander_dispatch_init(). The RDS proposes the faster speeds with
+ * link_speed_propose(&lander_link_speed, system_tick_now()) once the INIT handshake is done.
+ */
+void lander_link_speed_init(void);
+
+/*
+ * Opens the store-and-forward telemetry log in FRAM, recovering what was logged before the reset, and registers its
+ * MSG_TYPE_LOG handler on lander_dispatcher, so it is called after lander_dispatch_init(). From then on every
+ * telemetry record is logged, and process_received_data() sends the replays the lander asks for.
+ */
+void lander_log_init(void);
+
+/*
+ * Starts sending every logged record the lander has not acknowledged, for example when the lander opens the link
+ * again with INIT. process_received_data() sends it as fast as the transmission queue empties.
+ */
+void lander_log_replay_backlog(void);
+
+/*
+ * Sends a message through the sliding-window ARQ of the lander link. The method returns as soon as the frame is sent,
+ * it is sent again by process_received_data() until the lander acknowledges it. The payload is not copied and must
+ * stay unchanged until then, which the catalog messages do.
+ *
+ * parameters:
+ *  uint8_t msg_type : message type
+ *  const uint8_t *payload: pointer to array to be sent
+ *  uint8_t length: length of array to be sent
+ *
+ * Returns:
+ *  bool : false if the window is full or the payload is too large
+ */
+bool send_message_reliable(uint8_t msg_type, const uint8_t *payload, uint8_t length);
+
+/*
+ * Sends a message through the sliding-window ARQ and waits until the lander has acknowledged it. Received frames are
+ * handled while waiting.
  *
  * Parameters:
  *  uint8_t msg_type : message type
@@ -108,7 +248,21 @@ void send_message(uint8_t msg_type, const uint8_t *payload, uint8_t length);
 void send_message_and_wait_for_ACK(uint8_t msg_type, const uint8_t *payload, uint8_t length);
 
 /*
- * Sends a message and waits for an ACK response 3 times.
+ * Sends a message of the payload message catalog through the sliding-window ARQ and waits until the lander has
+ * acknowledged it, see send_message_and_wait_for_ACK.
+ *
+ * Parameters:
+ *  uint8_t msg_type : message type
+ *  Message_id id : catalog message to be sent
+ *
+ * Returns:
+ *  void
+ */
+void send_message_and_wait_for_ACK(uint8_t msg_type, Message_id id);
+
+/*
+ * Sends a message through the sliding-window ARQ and waits until the lander has acknowledged it or it has been sent
+ * 3 times. For an INIT message the frames of a previous session are given up first.
  *
  * Parameters:
  *  uint8_t msg_type : message type
@@ -120,9 +274,33 @@ void send_message_and_wait_for_ACK(uint8_t msg_type, const uint8_t *payload, uin
  */
 void send_message_and_wait_for_ACK_3_times(uint8_t msg_type, const uint8_t *payload, uint8_t length);
 
+/*
+ * Sends a message of the payload message catalog through the sliding-window ARQ and waits until the lander has
+ * acknowledged it or it has been sent 3 times, see send_message_and_wait_for_ACK_3_times.
+ *
+ * Parameters:
+ *  uint8_t msg_type : message type
+ *  Message_id id : catalog message to be sent, e.g. MSG_ID_INIT
+ *
+ * Returns:
+ *  void
+ */
+void send_message_and_wait_for_ACK_3_times(uint8_t msg_type, Message_id id);
+
 /*
  * process the RX_buffer
  */
 void process_received_data(void);
 
+/*
+ * Sleeps until there is new work for process_received_data(): a received frame, a receive error or the next 1 ms tick
+ * for the timers of the ARQ and the link speed negotiation. Used by every wait that keeps the lander link running:
+ *
+ *  while(!done){
+ *      process_received_data();
+ *      wait_for_received_data();
+ *  }
+ */
+void wait_for_received_data(void);
+
 #endif // LANDER_COMMUNICATION_H
@@ -14,6 +14,7 @@
 
 
 #include <lander_communication_lib/payload_messages.h>
+#include <lander_communication_lib/frame_check.h>
 
 #include <cstdint>
 
@@ -27,19 +28,33 @@
 #define MSG_TYPE_DEPLOY         0x07
 #define MSG_TYPE_TRANSIT_MODE   0x08
 #define MSG_TYPE_ERROR          0x09
+#define MSG_TYPE_ARQ_ACK        0x0A    // ACK of the sliding-window ARQ, see arq.h
+#define MSG_TYPE_TELEMETRY      0x0B    // binary telemetry records, see telemetry.h
+#define MSG_TYPE_CONTAINER      0x0C    // several messages in one frame, see message_batch.h
+#define MSG_TYPE_LINK_SPEED     0x0D    // link speed negotiation, see link_speed.h
+#define MSG_TYPE_LOG            0x0E    // store-and-forward telemetry log, see telemetry_log.h
+
+// Set in the message type of frames that are sent through the sliding-window ARQ
+#define MSG_TYPE_RELIABLE       0x80
 
 #define MSG_START_BYTE  0x7E
 #define MSG_END_BYTE    0x7F
 
 #define MAX_PAYLOAD_SIZE 249  // UART buffer size - 7 (extra bytes)
 
+// Frame check of the link with the lander (FRAME_CHECK_XOR8 or FRAME_CHECK_CRC16), both sides have to use the same one.
+// Can be overruled from the build settings, e.g. --define=LANDER_LINK_FRAME_CHECK=FRAME_CHECK_CRC16
+#ifndef LANDER_LINK_FRAME_CHECK
+#define LANDER_LINK_FRAME_CHECK FRAME_CHECK_XOR8
+#endif
+
 // Message structure
 typedef struct {
     uint8_t start_byte;
     uint8_t msg_type;
     uint8_t length;
     uint8_t payload[MAX_PAYLOAD_SIZE]; // pointer to payload array
-    uint8_t checksum;
+    uint16_t checksum; // XOR checksum or CRC, depending on LANDER_LINK_FRAME_CHECK
     uint8_t end_byte;
 } Message;
 
@@ -71,7 +86,8 @@ extern volatile transit_states transit_state;
 Message create_message(uint8_t msg_type, const uint8_t *payload, uint8_t length);
 
 /*
- * Reads a message struct and handles each type of response using a switch statement.
+ * Checks a received message and hands it to its handler in lander_dispatcher, see message_dispatch.h. Messages
+ * without handler are ignored.
  *
  * Parameters:
  *  const Message *msg: message to be handled
@@ -79,7 +95,8 @@ Message create_message(uint8_t msg_type, const uint8_t *payload, uint8_t length)
 void handle_message(const Message *msg);
 
 /*
- * Calculates the checksum of a message to check for errors during transmission.
+ * Calculates the checksum of a message to check for errors during transmission, using the frame check of the lander
+ * link (LANDER_LINK_FRAME_CHECK).
  *
  * Parameters:
  *  uint8_t msg_type: message type
@@ -87,9 +104,9 @@ void handle_message(const Message *msg);
  *  const uint8_t *payload: the message to be used for calculating a checksum
  *
  * Returns:
- *  uint8_t: the calculated checksum
+ *  uint16_t: the calculated checksum
  */
-uint8_t calculate_checksum_helper(uint8_t msg_type, uint8_t length, const uint8_t *payload);
+uint16_t calculate_checksum_helper(uint8_t msg_type, uint8_t length, const uint8_t *payload);
 
 /*
  * Calculates the checksum of a message to check for errors during transmission.
@@ -98,8 +115,8 @@ uint8_t calculate_checksum_helper(uint8_t msg_type, uint8_t length, const uint8_
  *  const Message *msg : message structure
  *
  * Returns:
- *  uint8_t: the calculated checksum
+ *  uint16_t: the calculated checksum
  */
-uint8_t calculate_checksum(const Message *msg);
+uint16_t calculate_checksum(const Message *msg);
 
 #endif // LANDER_COMMUNICATION_PROTOCOL_H
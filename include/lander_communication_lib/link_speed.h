@@ -0,0 +1,211 @@
+/*
+ * link_speed.h file
+ *
+ * This file contains the link speed negotiation of the lander link. The link always starts at 115200 baud. After the
+ * INIT handshake the RDS proposes the faster speeds it supports, and both sides switch to the fastest speed they have
+ * in common. When errors rise on a fast link, it steps down one speed. When the other side stops answering during a
+ * switch, the link falls back to 115200 baud.
+ *
+ * The exchange uses MSG_TYPE_LINK_SPEED frames. The first payload byte is the command:
+ *
+ *  - PROPOSE [P][speeds]: the speeds the sender supports, bit n is Link_speed n
+ *  - SELECT  [S][speed][speeds]: the speed that the sender switches to right after this frame, and the speeds both
+ *    sides have in common
+ *  - CONFIRM [C][speed]: sent at the new speed by the side that received SELECT, the side that sent SELECT answers
+ *    with the same CONFIRM
+ *
+ *   RDS                         lander
+ *    |--- PROPOSE 115200..1M ---->|
+ *    |<-- SELECT 1M --------------|  lander switches after the frame has been sent
+ *    |    switch                  |
+ *    |--- CONFIRM 1M ------------>|  at 1M
+ *    |<-- CONFIRM 1M -------------|  both sides are done
+ *
+ * Every command is sent again when it is not answered within the timeout, SELECT then at the new speed. A side that
+ * sent SELECT or CONFIRM max_tries times without answer falls back to LINK_SPEED_DEFAULT. A PROPOSE that is not
+ * answered leaves the link at its speed, the other side does not negotiate.
+ *
+ * Either side can step down by sending SELECT itself. The SELECT goes out at the noisy speed and may get lost, but the
+ * other side sees the same errors and steps down to the same speed, where the repeated SELECT reaches it.
+ *
+ * The baud rates are listed once in LINK_SPEEDS. Their register settings are calculated at compile time by
+ * uart_baud.h, and a speed whose modulation error is too large at UART_BRCLK_HZ does not compile.
+ *
+ * Time is given in ticks by the caller, such that the same code runs on the MSP430 and in the host tests.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef LINK_SPEED_H
+#define LINK_SPEED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <lander_communication_lib/lander_communication_protocol.h>
+#include <lander_communication_lib/uart_baud.h>
+
+// Baud rates of the link from slow to fast, the first one is the speed every link starts at
+#define LINK_SPEEDS(X) \
+    X(115200)          \
+    X(230400)          \
+    X(460800)          \
+    X(1000000)
+
+// Index of a baud rate in LINK_SPEEDS, e.g. LINK_SPEED_460800
+#define LINK_SPEED_ENUM(baud) LINK_SPEED_##baud,
+typedef enum {
+    LINK_SPEEDS(LINK_SPEED_ENUM)
+    LINK_SPEED_COUNT
+} Link_speed;
+#undef LINK_SPEED_ENUM
+
+#define LINK_SPEED_DEFAULT LINK_SPEED_115200
+
+// Bit of a speed in a set of speeds
+#define LINK_SPEED_BIT(speed) ((uint8_t)(1u << (speed)))
+#define LINK_SPEED_ALL ((uint8_t)((1u << LINK_SPEED_COUNT) - 1))
+
+// Commands in the first payload byte of MSG_TYPE_LINK_SPEED
+#define LINK_SPEED_PROPOSE 'P'
+#define LINK_SPEED_SELECT  'S'
+#define LINK_SPEED_CONFIRM 'C'
+
+// Register settings of every speed at UART_BRCLK_HZ, indexed by Link_speed
+extern const UART_baud_setting link_speed_settings[LINK_SPEED_COUNT];
+
+/**
+ * enumerate object with the steps of the exchange
+ */
+typedef enum {
+    LINK_SPEED_IDLE,            // running at the current speed
+    LINK_SPEED_PROPOSED,        // PROPOSE sent, waiting for SELECT
+    LINK_SPEED_SELECTED,        // SELECT sent and switched, waiting for CONFIRM
+    LINK_SPEED_CONFIRMING       // SELECT received and switched, sending CONFIRM until it is answered
+} Link_speed_state;
+
+// Settings of a negotiator
+typedef struct {
+    uint16_t timeout;           // ticks to wait for an answer
+    uint8_t max_tries;          // every command is sent at most this many times
+    uint8_t error_window;       // received frames over which errors are counted
+    uint8_t max_errors;         // errors within the window that make the link step down one speed
+} Link_speed_config;
+
+// Statistics of a negotiator, the counters wrap around at 65535
+typedef struct {
+    uint16_t switches;          // speed changes that both sides confirmed
+    uint16_t fallbacks;         // times the link went back to LINK_SPEED_DEFAULT because the other side did not answer
+    uint16_t step_downs;        // times this side stepped down because of errors
+} Link_speed_statistics;
+
+typedef struct Link_speed_negotiator Link_speed_negotiator;
+
+// Sends a MSG_TYPE_LINK_SPEED frame at the current speed. Returns false if the frame could not be queued.
+typedef bool (*Link_speed_send_function)(Link_speed_negotiator *negotiator, const uint8_t *payload, uint8_t length);
+
+// Switches the UART to a speed, after every queued byte has been sent
+typedef void (*Link_speed_apply_function)(Link_speed_negotiator *negotiator, Link_speed speed);
+
+// Negotiator structure
+struct Link_speed_negotiator {
+    Link_speed_config config;
+    Link_speed_send_function send;
+    Link_speed_apply_function apply;
+    void *context;                  // free for the user of the negotiator
+
+    uint8_t supported;              // speeds of this side
+    uint8_t common;                 // speeds of both sides, only LINK_SPEED_DEFAULT until a negotiation
+    Link_speed speed;               // current speed
+    Link_speed_state state;
+    bool selector;                  // this side sent the last SELECT, it answers CONFIRM
+    uint8_t tries;                  // frames sent in the current step of the exchange
+    uint16_t since;                 // tick of the last frame of the exchange
+
+    // error monitor
+    uint8_t frames;                 // received frames in the current window
+    uint8_t errors;                 // invalid frames in the current window
+
+    Link_speed_statistics statistics;
+};
+
+/*
+ * Returns the baud rate of a speed.
+ *
+ * parameters:
+ *  Link_speed speed: speed
+ *
+ * Returns:
+ *  uint32_t : baud rate, 0 if the speed is out of range
+ */
+uint32_t link_speed_baud(Link_speed speed);
+
+/*
+ * Initialises a negotiator at LINK_SPEED_DEFAULT. The UART is expected to run at that speed already.
+ *
+ * parameters:
+ *  Link_speed_negotiator *negotiator: negotiator to initialise
+ *  const Link_speed_config *config: settings
+ *  uint8_t supported: speeds this side supports, LINK_SPEED_DEFAULT is always added
+ *  Link_speed_send_function send: function that sends a MSG_TYPE_LINK_SPEED frame
+ *  Link_speed_apply_function apply: function that switches the UART
+ *  void *context: free for the user of the negotiator
+ */
+void link_speed_init(Link_speed_negotiator *negotiator, const Link_speed_config *config, uint8_t supported,
+                     Link_speed_send_function send, Link_speed_apply_function apply, void *context);
+
+/*
+ * Goes back to LINK_SPEED_DEFAULT without telling the other side, for example before a new INIT handshake.
+ *
+ * parameters:
+ *  Link_speed_negotiator *negotiator: negotiator
+ */
+void link_speed_reset(Link_speed_negotiator *negotiator);
+
+/*
+ * Proposes the supported speeds to the other side, which selects the fastest common one.
+ *
+ * parameters:
+ *  Link_speed_negotiator *negotiator: negotiator
+ *  uint16_t now: current time in ticks
+ *
+ * Returns:
+ *  bool : false if an exchange is already going on or the frame could not be sent
+ */
+bool link_speed_propose(Link_speed_negotiator *negotiator, uint16_t now);
+
+/*
+ * Handles a received MSG_TYPE_LINK_SPEED frame.
+ *
+ * parameters:
+ *  Link_speed_negotiator *negotiator: negotiator
+ *  const Message *msg: received message
+ *  uint16_t now: current time in ticks
+ */
+void link_speed_receive(Link_speed_negotiator *negotiator, const Message *msg, uint16_t now);
+
+/*
+ * Counts a received frame for the error monitor. When max_errors of the last error_window frames were invalid, the
+ * link steps down one speed.
+ *
+ * parameters:
+ *  Link_speed_negotiator *negotiator: negotiator
+ *  bool valid: false for a frame with a wrong format or checksum
+ *  uint16_t now: current time in ticks
+ */
+void link_speed_frame_received(Link_speed_negotiator *negotiator, bool valid, uint16_t now);
+
+/*
+ * Repeats unanswered commands and falls back when the other side does not answer in time. Must be called regularly, for example
+ * from process_received_data().
+ *
+ * parameters:
+ *  Link_speed_negotiator *negotiator: negotiator
+ *  uint16_t now: current time in ticks
+ */
+void link_speed_poll(Link_speed_negotiator *negotiator, uint16_t now);
+
+#endif // LINK_SPEED_H
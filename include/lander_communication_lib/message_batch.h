@@ -0,0 +1,115 @@
+/*
+ * message_batch.h file
+ *
+ * This file contains the message batch of the lander link. Messages that are sent shortly after each other, like the
+ * status messages of one ECCS sweep, are collected and sent as one container frame instead of one frame each, which
+ * saves the start/end bytes, length, checksum and SLIP delimiters of every frame and the per-frame handling on the
+ * lander.
+ *
+ * A container frame has message type MSG_TYPE_CONTAINER and its payload is a sequence of sub-records:
+ *
+ *   [msg_type][length][payload of length bytes]
+ *
+ * Binary telemetry records (MSG_TYPE_TELEMETRY) already describe their own size, so consecutive telemetry messages
+ * are merged into one sub-record. A batch with a single sub-record is sent as a normal frame of that message type.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef MESSAGE_BATCH_H
+#define MESSAGE_BATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <lander_communication_lib/lander_communication_protocol.h>
+#include <lander_communication_lib/slip_frame_writer.h>
+
+// Largest container payload. Even when every byte has to be escaped the SLIP encoded frame (2 * (96 + 6) + 2 bytes)
+// fits in the UART transmission queue, which uart_tx_reserve requires.
+#define MESSAGE_BATCH_SIZE_LIMIT 96
+
+// Size of the header of a sub-record: message type and length
+#define MESSAGE_BATCH_RECORD_HEADER_SIZE 2
+
+// Message batch structure
+typedef struct {
+    uint8_t buffer[MESSAGE_BATCH_SIZE_LIMIT];
+    uint8_t length;
+    uint8_t records;            // sub-records in the buffer
+    uint8_t last_record;        // offset of the header of the last sub-record
+    uint16_t batched_messages;  // messages added since initialisation, wraps around at 65535
+    uint16_t sent_frames;       // frames sent since initialisation, wraps around at 65535
+} Message_batch;
+
+/*
+ * Initialises an empty batch.
+ *
+ * parameters:
+ *  Message_batch *batch: batch to initialise
+ */
+void message_batch_init(Message_batch *batch);
+
+/*
+ * Adds a message to the batch.
+ *
+ * parameters:
+ *  Message_batch *batch: batch to add the message to
+ *  uint8_t msg_type: message type
+ *  const Payload_segment *segments: payload parts in the order in which they are sent
+ *  uint8_t segment_count: amount of payload parts
+ *
+ * Returns:
+ *  bool : false if the message does not fit, the batch has to be sent first. A message that does not even fit in an
+ *         empty batch has to be sent on its own.
+ */
+bool message_batch_add(Message_batch *batch, uint8_t msg_type, const Payload_segment *segments,
+                       uint8_t segment_count);
+
+/*
+ * Checks whether the batch holds no messages.
+ *
+ * parameters:
+ *  const Message_batch *batch: batch to check
+ *
+ * Returns:
+ *  bool : true if there is nothing to send
+ */
+bool message_batch_is_empty(const Message_batch *batch);
+
+/*
+ * Returns the frame that sends the batch, to be given to send_messagev. The segment points into the batch, so the
+ * batch may only be cleared after the frame has been sent.
+ *
+ * parameters:
+ *  const Message_batch *batch: batch to send, must not be empty
+ *  uint8_t *msg_type: message type of the frame
+ *  Payload_segment *segment: payload of the frame
+ */
+void message_batch_frame(const Message_batch *batch, uint8_t *msg_type, Payload_segment *segment);
+
+/*
+ * Empties the batch after its frame has been sent.
+ *
+ * parameters:
+ *  Message_batch *batch: batch to empty
+ */
+void message_batch_clear(Message_batch *batch);
+
+/*
+ * Takes the next message out of a container frame.
+ *
+ * parameters:
+ *  const Message *container: received MSG_TYPE_CONTAINER message
+ *  uint8_t *offset: offset of the next sub-record, start at 0
+ *  Message *msg: message to be filled, including its checksum
+ *
+ * Returns:
+ *  bool : false if there are no more sub-records or the next one is incomplete
+ */
+bool message_container_next(const Message *container, uint8_t *offset, Message *msg);
+
+#endif // MESSAGE_BATCH_H
@@ -0,0 +1,111 @@
+/*
+ * message_dispatch.h file
+ *
+ * This file contains the message dispatcher of the lander link. Received messages are handed to a handler that is
+ * looked up in a table indexed by the message type, such that the cost of a dispatch does not depend on how many
+ * message types are handled.
+ *
+ * Some message types carry a command in their payload, like the transit mode commands "GS", "LI", "T", "PD" and "D".
+ * Handlers for those are registered per command and looked up in a small hash table, also without walking through
+ * the other commands. A command matches only when the payload is exactly the command, so
+ * "T" does not match "TB" or "TX". Messages of such a type that match no command go to the handler of the type.
+ *
+ * Subsystems register their handlers during initialisation, the protocol file does not have to know them.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef MESSAGE_DISPATCH_H
+#define MESSAGE_DISPATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <lander_communication_lib/lander_communication_protocol.h>
+
+// Message types 0x00 up to 0x0F can have a handler
+#define MESSAGE_DISPATCH_TYPE_COUNT 16
+
+// Slots of the command hash table, a power of 2. Every slot takes 6 bytes of RAM.
+#define MESSAGE_DISPATCH_COMMAND_SLOTS 16
+
+// Largest amount of registered commands, the table is kept at most 3/4 full such that a lookup rarely probes more
+// than one slot
+#define MESSAGE_DISPATCH_COMMAND_COUNT 12
+
+// Largest size of a command
+#define MESSAGE_COMMAND_SIZE 2
+
+typedef void (*Message_handler)(const Message *msg);
+
+// Slot of the command table, the slot is free when handler is NULL
+typedef struct {
+    uint8_t msg_type;
+    uint8_t length;
+    uint16_t opcode;            // characters of the command, the first one in the low byte
+    Message_handler handler;
+} Message_command;
+
+// Message dispatcher structure
+typedef struct {
+    Message_handler handlers[MESSAGE_DISPATCH_TYPE_COUNT];
+    Message_command commands[MESSAGE_DISPATCH_COMMAND_SLOTS];   // hash table of the commands
+    uint8_t command_count;
+    uint16_t command_types;     // bit n is set when message type n has registered commands
+    uint16_t unhandled;         // messages without handler, wraps around at 65535
+} Message_dispatcher;
+
+/*
+ * Initialises a dispatcher without commands.
+ *
+ * parameters:
+ *  Message_dispatcher *dispatcher: dispatcher to initialise
+ *  const Message_handler *handlers: MESSAGE_DISPATCH_TYPE_COUNT handlers indexed by message type, NULL for message
+ *                                   types without handler. NULL for no handlers at all.
+ */
+void message_dispatch_init(Message_dispatcher *dispatcher, const Message_handler *handlers);
+
+/*
+ * Registers the handler of a message type, it replaces the previous one.
+ *
+ * parameters:
+ *  Message_dispatcher *dispatcher: dispatcher
+ *  uint8_t msg_type: message type
+ *  Message_handler handler: handler, NULL to remove the handler
+ *
+ * Returns:
+ *  bool : false if the message type is out of range
+ */
+bool message_dispatch_register(Message_dispatcher *dispatcher, uint8_t msg_type, Message_handler handler);
+
+/*
+ * Registers the handler of a command, it replaces the previous handler of the same command.
+ *
+ * parameters:
+ *  Message_dispatcher *dispatcher: dispatcher
+ *  uint8_t msg_type: message type that carries the command
+ *  const char *opcode: command of 1 or 2 characters, e.g. "GS"
+ *  Message_handler handler: handler, commands cannot be removed
+ *
+ * Returns:
+ *  bool : false if the message type or command size is out of range, the handler is NULL or the command table is full
+ */
+bool message_dispatch_register_command(Message_dispatcher *dispatcher, uint8_t msg_type, const char *opcode,
+                                       Message_handler handler);
+
+/*
+ * Hands a message to its handler: the handler of a matching command, otherwise the handler of its message type.
+ *
+ * parameters:
+ *  Message_dispatcher *dispatcher: dispatcher
+ *  const Message *msg: checked message
+ *
+ * Returns:
+ *  bool : false if the message has no handler, it is counted as unhandled
+ */
+bool message_dispatch(Message_dispatcher *dispatcher, const Message *msg);
+
+#endif // MESSAGE_DISPATCH_H
@@ -1,7 +1,14 @@
 /*
  * payload_messages.h
  *
- * This header file contains definitions for static payload messages used throughout the project.
+ * This header file contains the catalog of static payload messages used throughout the project.
+ *
+ * Every message is listed once in PAYLOAD_MESSAGES and its text is stored once in payload_messages.cpp, such that all
+ * translation units share the same copy in FRAM. Each message gets:
+ *  - an ID, MSG_ID_<name>, to send it with send_message(msg_type, MSG_ID_<name>),
+ *  - its length and frame checksum as compile-time constants, see PAYLOAD_LENGTH and PAYLOAD_CHECKSUM.
+ *
+ * The file does not depend on msp430.h such that the host tests use the same catalog.
  *
  * Author: Henri Vanhuynegem
  * created: 19/06/2024
@@ -14,54 +21,138 @@
 
 #include <stdint.h>
 
-// Example payload messages
+// X(name, text) for every payload message, new messages are added at the end of their group
+#define PAYLOAD_MESSAGES(X) \
+    /* initialisation and acknowledgements */ \
+    X(INIT, "INIT") \
+    X(ACK, "ACK") \
+    X(NACK, "NACK") \
+    /* transit modes */ \
+    X(GENERAL_STARTUP, "GENERAL_STARTUP") \
+    X(LAUNCH_INTEGRATION, "LAUNCH_INTEGRATION") \
+    X(TRANSIT, "TRANSIT") \
+    X(PRE_DEPLOYMENT, "PRE_DEPLOYMENT") \
+    X(DEPLOYMENT, "DEPLOYMENT") \
+    /* transit mode request */ \
+    X(TRANSIT_MODE, "TM") \
+    /* electronic components checkup messages */ \
+    X(UMBILICAL_CONNECTED, "umbilical cord connected") \
+    X(UMBILICAL_NOT_CONNECTED, "umbilical cord not connected") \
+    X(BUS_SENSE_BROKEN, "The bus voltage cannot be measured") \
+    X(TEMP_SENSOR_1_BROKEN, "Temperature sensor 1 is broken") \
+    X(TEMP_SENSOR_2_BROKEN, "Temperature sensor 2 is broken") \
+    X(SUPERCAP_VOLTAGE_ERROR, "The supercap voltage cannot be read") \
+    X(SUPERCAP_VOLTAGE_ZERO, "The supercap voltage is 0V") \
+    X(ALL_NEA_READY, "All the NEAs are ready") \
+    X(NEA1_READY, "NEA 1 is ready") \
+    X(NEA1_NOT_READY, "NEA 1 is not ready") \
+    X(NEA2_READY, "NEA 2 is ready") \
+    X(NEA2_NOT_READY, "NEA 2 is not ready") \
+    X(NEA3_READY, "NEA 3 is ready") \
+    X(NEA3_NOT_READY, "NEA 3 is not ready") \
+    X(NEA4_READY, "NEA 4 is ready") \
+    X(NEA4_NOT_READY, "NEA 4 is not ready") \
+    X(SUPERCAP1_READY, "supercapacitor 1 is ready") \
+    X(SUPERCAP1_NOT_READY, "supercapacitor 1 is not ready") \
+    X(SUPERCAP2_READY, "supercapacitor 2 is ready") \
+    X(SUPERCAP2_NOT_READY, "supercapacitor 2 is not ready") \
+    X(SUPERCAP3_READY, "supercapacitor 3 is ready") \
+    X(SUPERCAP3_NOT_READY, "supercapacitor 3 is not ready") \
+    X(POWER_ROVER_OFF, "Power to the rover is switched off") \
+    X(DEPLOYMENT_COMPLETE, "Deployment is complete") \
+    X(TASK_OVERRUN, "A task missed its deadline") \
+    X(NEA_SEQUENCE_ABORTED, "The NEA firing sequence is aborted") \
+    X(NEA_SEQUENCE_HELD, "The NEA firing sequence is held") \
+    X(NEA_SEQUENCE_RESUMED, "The NEA firing sequence is resumed") \
+    X(BUS_OVERCURRENT, "The bus current is above its limit") \
+    X(BUS_CURRENT_NORMAL, "The bus current is back within its limit") \
+    X(SUPERCAP_BROWNOUT, "The supercap voltage is below its limit") \
+    X(SUPERCAP_VOLTAGE_NORMAL, "The supercap voltage is back within its limit") \
+    X(NEA1_RELEASED, "NEA 1 is released") \
+    X(NEA1_NOT_RELEASED, "NEA 1 is not released after the last attempt") \
+    X(NEA2_RELEASED, "NEA 2 is released") \
+    X(NEA2_NOT_RELEASED, "NEA 2 is not released after the last attempt") \
+    X(NEA3_RELEASED, "NEA 3 is released") \
+    X(NEA3_NOT_RELEASED, "NEA 3 is not released after the last attempt") \
+    X(NEA4_RELEASED, "NEA 4 is released") \
+    X(NEA4_NOT_RELEASED, "NEA 4 is not released after the last attempt") \
+    /* measurements, sent after the value in ASCII telemetry */ \
+    X(BUS_VOLTAGE, " is the current bus voltage") \
+    X(SUPERCAP_VOLTAGE, " is the current supercap voltage") \
+    X(TEMP_SENSOR_1, " is the current temperature of sensor 1") \
+    X(TEMP_SENSOR_2, " is the current temperature of sensor 2") \
+    X(CPU_ACTIVE_GENERAL_STARTUP, " % of the time the CPU was awake in GENERAL_STARTUP") \
+    X(CPU_ACTIVE_LAUNCH_INTEGRATION, " % of the time the CPU was awake in LAUNCH_INTEGRATION") \
+    X(CPU_ACTIVE_TRANSIT, " % of the time the CPU was awake in TRANSIT") \
+    X(CPU_ACTIVE_PRE_DEPLOYMENT, " % of the time the CPU was awake in PRE_DEPLOYMENT") \
+    X(CPU_ACTIVE_DEPLOYMENT, " % of the time the CPU was awake in DEPLOYMENT") \
+    X(NEA1_SEQUENCE_TIME, " s was the firing sequence of NEA 1") \
+    X(NEA2_SEQUENCE_TIME, " s was the firing sequence of NEA 2") \
+    X(NEA3_SEQUENCE_TIME, " s was the firing sequence of NEA 3") \
+    X(NEA4_SEQUENCE_TIME, " s was the firing sequence of NEA 4") \
+    X(NEA1_SEQUENCE_ATTEMPTS, " attempts were made to release NEA 1") \
+    X(NEA2_SEQUENCE_ATTEMPTS, " attempts were made to release NEA 2") \
+    X(NEA3_SEQUENCE_ATTEMPTS, " attempts were made to release NEA 3") \
+    X(NEA4_SEQUENCE_ATTEMPTS, " attempts were made to release NEA 4") \
+    /* error messages */ \
+    X(ERROR, "ERROR_MESSAGE") \
+    X(TOO_LARGE, "MESSAGE_TOO_LARGE") \
+    X(INVALID_MESSAGE, "INVALID_MESSAGE") \
+    X(INVALID_CHECKSUM, "INVALID_CHECKSUM") \
+    X(EMPTY, "")
 
-// initialisation and acknowledgements
-static const uint8_t PAYLOAD_INIT[] = "INIT";
-static const uint8_t PAYLOAD_ACK[] = "ACK";
-static const uint8_t PAYLOAD_NACK[] = "NACK";
-// transit modes
-static const uint8_t PAYLOAD_GENERAL_STARTUP[] = "GENERAL_STARTUP";
-static const uint8_t PAYLOAD_LAUNCH_INTEGRATION[] = "LAUNCH_INTEGRATION";
-static const uint8_t PAYLOAD_TRANSIT[] = "TRANSIT";
-static const uint8_t PAYLOAD_PRE_DEPLOYMENT[] = "PRE_DEPLOYMENT";
-static const uint8_t PAYLOAD_DEPLOYMENT[] = "DEPLOYMENT";
+// Message IDs, MSG_ID_INIT, MSG_ID_ACK, ...
+typedef enum {
+#define PAYLOAD_MESSAGE_ID(name, text) MSG_ID_##name,
+    PAYLOAD_MESSAGES(PAYLOAD_MESSAGE_ID)
+#undef PAYLOAD_MESSAGE_ID
+    MSG_ID_END
+} Message_id;
 
-// transit mode request
-static const uint8_t PAYLOAD_TRANSIT_MODE[] = "TM";
+/*
+ * XOR of all characters of a text, only used by the compiler to fill in PAYLOAD_CHECKSUM.
+ */
+constexpr uint8_t payload_xor(const char *text, uint8_t check = 0)
+{
+    return (*text == '\0') ? check : payload_xor(text + 1, check ^ (uint8_t)*text);
+}
 
-// electronic components checkup messages
-static const uint8_t PAYLOAD_UMBILICAL_CONNECTED[] = "umbilical cord connected";
-static const uint8_t PAYLOAD_UMBILICAL_NOT_CONNECTED[] = "umbilical cord not connected";
-static const uint8_t PAYLOAD_BUS_SENSE_BROKEN[] = "The bus voltage cannot be measured";
-static const uint8_t PAYLOAD_TEMP_SENSOR_1_BROKEN[] = "Temperature sensor 1 is broken";
-static const uint8_t PAYLOAD_TEMP_SENSOR_2_BROKEN[] = "Temperature sensor 2 is broken";
-static const uint8_t PAYLOAD_SUPERCAP_VOLTAGE_ERROR[] = "The supercap voltage cannot be read";
-static const uint8_t PAYLOAD_SUPERCAP_VOLTAGE_ZERO[] = "The supercap voltage is 0V";
-static const uint8_t PAYLOAD_ALL_NEA_READY[] = "All the NEAs are ready";
-static const uint8_t PAYLOAD_NEA1_READY[] = "NEA 1 is ready";
-static const uint8_t PAYLOAD_NEA1_NOT_READY[] = "NEA 1 is not ready";
-static const uint8_t PAYLOAD_NEA2_READY[] = "NEA 2 is ready";
-static const uint8_t PAYLOAD_NEA2_NOT_READY[] = "NEA 2 is not ready";
-static const uint8_t PAYLOAD_NEA3_READY[] = "NEA 3 is ready";
-static const uint8_t PAYLOAD_NEA3_NOT_READY[] = "NEA 3 is not ready";
-static const uint8_t PAYLOAD_NEA4_READY[] = "NEA 4 is ready";
-static const uint8_t PAYLOAD_NEA4_NOT_READY[] = "NEA 4 is not ready";
-static const uint8_t PAYLOAD_SUPERCAP1_READY[] = "supercapacitor 1 is ready";
-static const uint8_t PAYLOAD_SUPERCAP1_NOT_READY[] = "supercapacitor 1 is not ready";
-static const uint8_t PAYLOAD_SUPERCAP2_READY[] = "supercapacitor 2 is ready";
-static const uint8_t PAYLOAD_SUPERCAP2_NOT_READY[] = "supercapacitor 2 is not ready";
-static const uint8_t PAYLOAD_SUPERCAP3_READY[] = "supercapacitor 3 is ready";
-static const uint8_t PAYLOAD_SUPERCAP3_NOT_READY[] = "supercapacitor 3 is not ready";
-static const uint8_t PAYLOAD_POWER_ROVER_OFF[] = "Power to the rover is switched off";
-static const uint8_t PAYLOAD_DEPLOYMENT_COMPLETE[] = "Deployment is complete";
+// Compile-time length and XOR of every message, MSG_LENGTH_INIT, MSG_CHECK_INIT, ...
+enum {
+#define PAYLOAD_MESSAGE_CONSTANTS(name, text) \
+    MSG_LENGTH_##name = sizeof(text) - 1, \
+    MSG_CHECK_##name = payload_xor(text),
+    PAYLOAD_MESSAGES(PAYLOAD_MESSAGE_CONSTANTS)
+#undef PAYLOAD_MESSAGE_CONSTANTS
+};
 
-// error messages
-static const uint8_t PAYLOAD_ERROR[] = "ERROR_MESSAGE";
-static const uint8_t PAYLOAD_TOO_LARGE[] = "MESSAGE_TOO_LARGE";
-static const uint8_t PAYLOAD_INVALID_MESSAGE[] = "INVALID_MESSAGE";
-static const uint8_t PAYLOAD_INVALID_CHECKSUM[] = "INVALID_CHECKSUM";
-static const uint8_t PAYLOAD_EMPTY[] = "";
+// Amount of characters of a message, known at compile time, e.g. PAYLOAD_LENGTH(ACK) is 3
+#define PAYLOAD_LENGTH(name) ((uint8_t)MSG_LENGTH_##name)
+
+// XOR checksum of a frame that carries a message, known at compile time, equal to calculate_checksum_helper with
+// the XOR frame check
+#define PAYLOAD_CHECKSUM(msg_type, name) ((uint8_t)((msg_type) ^ MSG_LENGTH_##name ^ MSG_CHECK_##name))
+
+/*
+ * Returns the text of a message. The text is not null terminated, all texts are stored back to back.
+ *
+ * parameters:
+ *  Message_id id: message ID
+ *
+ * Returns:
+ *  const uint8_t* : first character of the message, the empty message if the ID is not in the catalog
+ */
+const uint8_t *payload_message_text(Message_id id);
 
+/*
+ * Returns the amount of characters of a message.
+ *
+ * parameters:
+ *  Message_id id: message ID
+ *
+ * Returns:
+ *  uint8_t : amount of characters, 0 if the ID is not in the catalog
+ */
+uint8_t payload_message_length(Message_id id);
 
 #endif // PAYLOAD_MESSAGES_H
@@ -0,0 +1,75 @@
+/*
+ * slip_frame_writer.h file
+ *
+ * This file contains the scatter-gather frame writer of the UART communication library. A message is described by its
+ * message type and a list of payload segments (for example a catalog message in FRAM followed by a formatted
+ * number). The writer calculates the length and checksum over the segments and SLIP encodes the complete Message
+ * protocol frame straight into the UART transmission queue.
+ *
+ * This replaces building a Message struct with create_message(), serialising it with convert_message_to_array() and
+ * encoding it with slip_encode(), which copied the payload three times before uart_write() copied it into the queue.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef SLIP_FRAME_WRITER_H
+#define SLIP_FRAME_WRITER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <lander_communication_lib/lander_communication_protocol.h>
+#include <lander_communication_lib/slip_stream_decoder.h>
+#include <lander_communication_lib/frame_check.h>
+#include <lander_communication_lib/uart_tx_queue.h>
+
+// One part of the payload of a message
+typedef struct {
+    const uint8_t *data;
+    uint8_t length;
+} Payload_segment;
+
+// Header information of a frame, filled in by slip_frame_prepare
+typedef struct {
+    uint8_t msg_type;
+    uint8_t length;             // total payload length of all segments
+    Frame_check_type check;     // frame check of the link
+    uint16_t checksum;
+    uint8_t payload_escapes;    // payload bytes that have to be escaped, 0 means the segments can be copied as they are
+    uint16_t encoded_length;    // amount of characters on the wire, including both SLIP END characters
+} SLIP_frame_info;
+
+/*
+ * Calculates the payload length, frame check and SLIP encoded length of a frame. Uses frame_check_block, so it must not
+ * be used in interrupts.
+ *
+ * parameters:
+ *  uint8_t msg_type: message type
+ *  const Payload_segment *segments: payload segments in the order in which they are sent
+ *  uint8_t segment_count: amount of segments
+ *  Frame_check_type check: frame check of the link
+ *  SLIP_frame_info *info: structure to be filled
+ *
+ * Returns:
+ *  bool : false if the payload is larger than MAX_PAYLOAD_SIZE
+ */
+bool slip_frame_prepare(uint8_t msg_type, const Payload_segment *segments, uint8_t segment_count, Frame_check_type check,
+                        SLIP_frame_info *info);
+
+/*
+ * SLIP encodes a prepared frame straight into the transmission queue. The caller has to make sure that at least
+ * info->encoded_length bytes are free, the bytes are published to the TX interrupt all at once at the end.
+ *
+ * parameters:
+ *  UART_TX_queue *queue: queue to write the frame to
+ *  const SLIP_frame_info *info: information calculated by slip_frame_prepare
+ *  const Payload_segment *segments: the same segments that were given to slip_frame_prepare
+ *  uint8_t segment_count: amount of segments
+ */
+void slip_frame_write(UART_TX_queue *queue, const SLIP_frame_info *info, const Payload_segment *segments,
+                      uint8_t segment_count);
+
+#endif // SLIP_FRAME_WRITER_H
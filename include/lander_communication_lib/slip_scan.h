@@ -0,0 +1,53 @@
+/*
+ * slip_scan.h file
+ *
+ * This file contains the helpers that slip_encode() uses to find the bytes that have to be escaped. Almost no
+ * payload byte is SLIP END or ESC, so instead of checking every byte a whole word is checked at once (SWAR): 16 bit
+ * words on the MSP430 and 64 bit words on the host. Only a word that contains a special byte is encoded byte by byte,
+ * the other words are copied as a whole.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef SLIP_SCAN_H
+#define SLIP_SCAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <lander_communication_lib/slip_stream_decoder.h>
+
+// Widest word the CPU loads in one instruction. Words are only loaded from aligned addresses, the MSP430 cannot load a
+// word from an odd address.
+#if defined(__MSP430__)
+typedef uint16_t Slip_scan_word;
+#else
+typedef uint64_t Slip_scan_word;
+#endif
+
+// A word with every byte set to 0x01, and one with every byte set to 0x80
+#define SLIP_SCAN_ONES  ((Slip_scan_word)-1 / 0xFF)
+#define SLIP_SCAN_HIGHS (SLIP_SCAN_ONES * 0x80)
+
+/*
+ * Returns whether one of the bytes of a word is zero. Bytes above a zero byte can give false hits, but a word without
+ * zero byte never gives one, so the result is exact.
+ */
+static inline bool slip_word_has_zero(Slip_scan_word word)
+{
+    return ((word - SLIP_SCAN_ONES) & ~word & SLIP_SCAN_HIGHS) != 0;
+}
+
+/*
+ * Returns whether one of the bytes of a word is SLIP END or ESC.
+ */
+static inline bool slip_word_has_special(Slip_scan_word word)
+{
+    return slip_word_has_zero(word ^ (SLIP_SCAN_ONES * SLIP_END)) ||
+           slip_word_has_zero(word ^ (SLIP_SCAN_ONES * SLIP_ESC));
+}
+
+#endif // SLIP_SCAN_H
@@ -0,0 +1,161 @@
+/*
+ * slip_stream_decoder.h file
+ *
+ * This file contains the incremental SLIP decoder that is used inside the USCI_A1 RX interrupt. Every received character
+ * is un-escaped, checked against the Message protocol format (start byte, message type, length, payload, checksum, end
+ * byte) and the payload is written straight into the RX ring buffer. When the closing SLIP END character arrives the
+ * frame has already been fully validated, so the main loop only has to read the payload out of the ring buffer.
+ *
+ * This replaces copying the ring buffer into a temporary array, decoding it into a second array with slip_decode() and
+ * deserialising it with convert_array_to_message(), which needed about 770 bytes of stack and three passes over the data.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef SLIP_STREAM_DECODER_H
+#define SLIP_STREAM_DECODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <lander_communication_lib/lander_communication_protocol.h>
+#include <lander_communication_lib/frame_check.h>
+
+// definition of slip encoding characters
+#define SLIP_END        0xC0
+#define SLIP_ESC        0xDB
+#define SLIP_ESC_END    0xDC
+#define SLIP_ESC_ESC    0xDD
+
+/**
+ * enumerate object with the field of the Message protocol that the decoder expects next
+ */
+typedef enum {
+    SLIP_STREAM_OUT_OF_FRAME,   // waiting for a SLIP END character that opens a frame
+    SLIP_STREAM_START_BYTE,
+    SLIP_STREAM_MSG_TYPE,
+    SLIP_STREAM_LENGTH,
+    SLIP_STREAM_PAYLOAD,
+    SLIP_STREAM_CHECKSUM_HIGH,  // only used with FRAME_CHECK_CRC16
+    SLIP_STREAM_CHECKSUM,
+    SLIP_STREAM_END_BYTE,
+    SLIP_STREAM_COMPLETE,       // end byte received, waiting for the closing SLIP END character
+    SLIP_STREAM_DISCARD         // frame is invalid, skip everything until the next SLIP END character
+} SLIP_stream_state;
+
+/**
+ * enumerate object with the result of feeding one character to the decoder
+ */
+typedef enum {
+    SLIP_STREAM_BUSY,               // character accepted, frame not finished yet
+    SLIP_STREAM_FRAME_READY,        // a validated frame is available in last_frame
+    SLIP_STREAM_INVALID_MESSAGE,    // wrong start/end byte, bad escape sequence or wrong length
+    SLIP_STREAM_INVALID_CHECKSUM,   // frame is complete but the checksum does not match
+    SLIP_STREAM_OVERFLOW            // the payload does not fit in the free part of the ring buffer
+} SLIP_stream_result;
+
+// Location of a validated frame in the RX ring buffer
+typedef struct {
+    uint8_t msg_type;
+    uint8_t length;     // payload length
+    uint16_t offset;    // ring buffer index of the first payload byte
+    uint16_t checksum;  // received (and verified) checksum
+} SLIP_stream_frame;
+
+// Decoder structure
+typedef struct {
+    uint8_t *ring;                  // ring buffer the payload bytes are written to
+    uint16_t ring_mask;             // ring buffer size - 1, the size must be a power of two
+    volatile uint16_t read_index;   // first ring buffer byte that is still in use by the main loop
+    uint16_t write_index;           // next ring buffer byte to write, only used by the decoder
+    uint16_t frame_offset;          // ring buffer index of the frame that is being received
+    SLIP_stream_state state;
+    bool escaped;
+    uint8_t msg_type;
+    uint8_t length;
+    uint8_t received;               // payload bytes received so far
+    Frame_check_type check;         // frame check of the link
+    uint16_t checksum;              // running check, see calculate_checksum_helper
+    uint16_t received_checksum;
+    SLIP_stream_frame last_frame;   // most recent validated frame
+    uint16_t invalid_messages;
+    uint16_t invalid_checksums;
+    uint16_t overflows;
+} SLIP_stream_decoder;
+
+/*
+ * Initialises the decoder and connects it to a ring buffer.
+ *
+ * parameters:
+ *  SLIP_stream_decoder *decoder: decoder to initialise
+ *  uint8_t *ring: address of the ring buffer
+ *  uint16_t ring_size: size of the ring buffer, must be a power of two
+ *  Frame_check_type check: frame check of the link
+ */
+void slip_stream_init(SLIP_stream_decoder *decoder, uint8_t *ring, uint16_t ring_size, Frame_check_type check);
+
+/*
+ * Feeds one received character to the decoder. Meant to be called from the RX interrupt.
+ *
+ * parameters:
+ *  SLIP_stream_decoder *decoder: decoder that handles the character
+ *  uint8_t character: received character
+ *
+ * Returns:
+ *  SLIP_stream_result : SLIP_STREAM_FRAME_READY once a complete and valid frame has been received
+ */
+SLIP_stream_result slip_stream_decode_byte(SLIP_stream_decoder *decoder, uint8_t character);
+
+/*
+ * Drops the frame that is being received, for example after an inter-byte timeout. The ring buffer space of the
+ * frame is given back.
+ *
+ * parameters:
+ *  SLIP_stream_decoder *decoder: decoder to reset
+ */
+void slip_stream_abort(SLIP_stream_decoder *decoder);
+
+/*
+ * Checks whether the decoder is in the middle of a frame.
+ *
+ * parameters:
+ *  const SLIP_stream_decoder *decoder: decoder to inspect
+ *
+ * Returns:
+ *  bool : true if a frame has been started but not finished
+ */
+bool slip_stream_in_frame(const SLIP_stream_decoder *decoder);
+
+/*
+ * Gives the ring buffer space of the frame that has just been reported with SLIP_STREAM_FRAME_READY back, for when the
+ * caller has no room to keep track of it. Must be called before the next character is fed to the decoder.
+ *
+ * parameters:
+ *  SLIP_stream_decoder *decoder: decoder that received the frame
+ */
+void slip_stream_drop_last_frame(SLIP_stream_decoder *decoder);
+
+/*
+ * Copies a validated frame out of the ring buffer into a Message struct.
+ *
+ * parameters:
+ *  const SLIP_stream_decoder *decoder: decoder that received the frame
+ *  const SLIP_stream_frame *frame: frame to copy
+ *  Message *msg: message structure to be filled
+ */
+void slip_stream_frame_to_message(const SLIP_stream_decoder *decoder, const SLIP_stream_frame *frame, Message *msg);
+
+/*
+ * Gives the ring buffer space of a frame back to the decoder once the main loop has handled it. Frames have to be
+ * released in the order in which they were received.
+ *
+ * parameters:
+ *  SLIP_stream_decoder *decoder: decoder that received the frame
+ *  const SLIP_stream_frame *frame: frame that has been handled
+ */
+void slip_stream_release(SLIP_stream_decoder *decoder, const SLIP_stream_frame *frame);
+
+#endif // SLIP_STREAM_DECODER_H
@@ -0,0 +1,223 @@
+/*
+ * telemetry.h file
+ *
+ * This file contains the telemetry catalog of the RDS: every status event and measurement that is reported to the
+ * lander, together with the two ways in which they can be sent.
+ *
+ *  - ASCII telemetry sends the messages of payload_messages.h, measurements are sent as a decimal number
+ *    followed by a description. This is easy to read on a terminal during bench debugging.
+ *  - Binary telemetry sends MSG_TYPE_TELEMETRY frames whose payload is a sequence of records. An event record is its
+ *    1 byte ID, a measurement record is its 1 byte ID followed by a signed 16-bit fixed-point value, high byte first.
+ *    "supercapacitor 3 is not ready" takes 1 byte instead of 29.
+ *
+ * Measurements are converted to a fixed-point value first (millivolts, hundredths of a degree), such that both modes
+ * report exactly the same number.
+ *
+ * The IDs are part of the link with the lander, existing IDs must never be renumbered. The lander side can turn
+ * the records back into text with the same catalog.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <lander_communication_lib/lander_communication_protocol.h>
+#include <lander_communication_lib/slip_frame_writer.h>
+#include <lander_communication_lib/payload_messages.h>
+
+// Telemetry format of the RDS, can be overruled from the build settings, e.g.
+// --define=LANDER_TELEMETRY_FORMAT=TELEMETRY_ASCII for bench debugging. The lander can also switch it at run time.
+#ifndef LANDER_TELEMETRY_FORMAT
+#define LANDER_TELEMETRY_FORMAT TELEMETRY_BINARY
+#endif
+
+// Size of a measurement record: ID and 16-bit value
+#define TELEMETRY_MEASUREMENT_RECORD_SIZE 3
+
+// Largest amount of characters of a measurement value in ASCII telemetry, e.g. "-327.68"
+#define TELEMETRY_VALUE_TEXT_SIZE 8
+
+typedef enum {
+    TELEMETRY_ASCII,
+    TELEMETRY_BINARY
+} Telemetry_format;
+
+// Event IDs, 0x00 is not used such that a zeroed buffer is never a valid record
+typedef enum {
+    EVENT_GENERAL_STARTUP = 0x01,
+    EVENT_LAUNCH_INTEGRATION = 0x02,
+    EVENT_TRANSIT = 0x03,
+    EVENT_PRE_DEPLOYMENT = 0x04,
+    EVENT_DEPLOYMENT = 0x05,
+    EVENT_UMBILICAL_CONNECTED = 0x06,
+    EVENT_UMBILICAL_NOT_CONNECTED = 0x07,
+    EVENT_BUS_SENSE_BROKEN = 0x08,
+    EVENT_TEMP_SENSOR_1_BROKEN = 0x09,
+    EVENT_TEMP_SENSOR_2_BROKEN = 0x0A,
+    EVENT_SUPERCAP_VOLTAGE_ERROR = 0x0B,
+    EVENT_SUPERCAP_VOLTAGE_ZERO = 0x0C,
+    EVENT_ALL_NEA_READY = 0x0D,
+    EVENT_NEA1_READY = 0x0E,
+    EVENT_NEA1_NOT_READY = 0x0F,
+    EVENT_NEA2_READY = 0x10,
+    EVENT_NEA2_NOT_READY = 0x11,
+    EVENT_NEA3_READY = 0x12,
+    EVENT_NEA3_NOT_READY = 0x13,
+    EVENT_NEA4_READY = 0x14,
+    EVENT_NEA4_NOT_READY = 0x15,
+    EVENT_SUPERCAP1_READY = 0x16,
+    EVENT_SUPERCAP1_NOT_READY = 0x17,
+    EVENT_SUPERCAP2_READY = 0x18,
+    EVENT_SUPERCAP2_NOT_READY = 0x19,
+    EVENT_SUPERCAP3_READY = 0x1A,
+    EVENT_SUPERCAP3_NOT_READY = 0x1B,
+    EVENT_POWER_ROVER_OFF = 0x1C,
+    EVENT_DEPLOYMENT_COMPLETE = 0x1D,
+    EVENT_MESSAGE_TOO_LARGE = 0x1E,
+    EVENT_INVALID_MESSAGE = 0x1F,
+    EVENT_INVALID_CHECKSUM = 0x20,
+    EVENT_TASK_OVERRUN = 0x21,
+    EVENT_NEA_SEQUENCE_ABORTED = 0x22,
+    EVENT_NEA_SEQUENCE_HELD = 0x23,
+    EVENT_NEA_SEQUENCE_RESUMED = 0x24,
+    EVENT_BUS_OVERCURRENT = 0x25,
+    EVENT_BUS_CURRENT_NORMAL = 0x26,
+    EVENT_SUPERCAP_BROWNOUT = 0x27,
+    EVENT_SUPERCAP_VOLTAGE_NORMAL = 0x28,
+    EVENT_NEA1_RELEASED = 0x29,             // result of the firing sequence of a NEA, see nea_sequencer.h
+    EVENT_NEA1_NOT_RELEASED = 0x2A,
+    EVENT_NEA2_RELEASED = 0x2B,
+    EVENT_NEA2_NOT_RELEASED = 0x2C,
+    EVENT_NEA3_RELEASED = 0x2D,
+    EVENT_NEA3_NOT_RELEASED = 0x2E,
+    EVENT_NEA4_RELEASED = 0x2F,
+    EVENT_NEA4_NOT_RELEASED = 0x30,
+    TELEMETRY_EVENT_END
+} Telemetry_event;
+
+// Measurement IDs, they start at 0x80 such that events and measurements share one ID byte
+typedef enum {
+    MEASUREMENT_BUS_VOLTAGE = 0x80,         // millivolts
+    MEASUREMENT_SUPERCAP_VOLTAGE = 0x81,    // millivolts
+    MEASUREMENT_TEMP_SENSOR_1 = 0x82,       // hundredths of a degree Celsius
+    MEASUREMENT_TEMP_SENSOR_2 = 0x83,       // hundredths of a degree Celsius
+    MEASUREMENT_CPU_ACTIVE_GENERAL_STARTUP = 0x84,      // tenths of a percent of the time the CPU was awake
+    MEASUREMENT_CPU_ACTIVE_LAUNCH_INTEGRATION = 0x85,   // in the transit mode, see low_power.h
+    MEASUREMENT_CPU_ACTIVE_TRANSIT = 0x86,
+    MEASUREMENT_CPU_ACTIVE_PRE_DEPLOYMENT = 0x87,
+    MEASUREMENT_CPU_ACTIVE_DEPLOYMENT = 0x88,
+    MEASUREMENT_NEA1_SEQUENCE_TIME = 0x89,      // seconds from the first charge of the NEA to its
+    MEASUREMENT_NEA2_SEQUENCE_TIME = 0x8A,      // result, see nea_sequencer.h
+    MEASUREMENT_NEA3_SEQUENCE_TIME = 0x8B,
+    MEASUREMENT_NEA4_SEQUENCE_TIME = 0x8C,
+    MEASUREMENT_NEA1_SEQUENCE_ATTEMPTS = 0x8D,  // attempts the firing sequence of the NEA made
+    MEASUREMENT_NEA2_SEQUENCE_ATTEMPTS = 0x8E,
+    MEASUREMENT_NEA3_SEQUENCE_ATTEMPTS = 0x8F,
+    MEASUREMENT_NEA4_SEQUENCE_ATTEMPTS = 0x90,
+    TELEMETRY_MEASUREMENT_END
+} Telemetry_measurement;
+
+#define TELEMETRY_FIRST_MEASUREMENT MEASUREMENT_BUS_VOLTAGE
+
+// Catalog entry of an event
+typedef struct {
+    uint8_t message;        // Message_id of the text of the event
+    uint8_t msg_type;       // message type of the event in ASCII telemetry
+} Telemetry_event_info;
+
+// Catalog entry of a measurement
+typedef struct {
+    uint8_t message;        // Message_id of the description that follows the value in ASCII telemetry
+    uint8_t decimals;       // the fixed-point value is the measurement times 10^decimals
+} Telemetry_measurement_info;
+
+// Frame that is ready to be given to send_messagev, the segments point into the catalog and the buffer
+typedef struct {
+    uint8_t msg_type;
+    uint8_t segment_count;
+    Payload_segment segments[2];
+    uint8_t buffer[TELEMETRY_VALUE_TEXT_SIZE];
+} Telemetry_frame;
+
+/*
+ * Looks up an event in the catalog.
+ *
+ * parameters:
+ *  uint8_t id: event ID
+ *
+ * Returns:
+ *  const Telemetry_event_info* : catalog entry, NULL if the ID is not an event
+ */
+const Telemetry_event_info *telemetry_event_info(uint8_t id);
+
+/*
+ * Looks up a measurement in the catalog.
+ *
+ * parameters:
+ *  uint8_t id: measurement ID
+ *
+ * Returns:
+ *  const Telemetry_measurement_info* : catalog entry, NULL if the ID is not a measurement
+ */
+const Telemetry_measurement_info *telemetry_measurement_info(uint8_t id);
+
+/*
+ * Writes a fixed-point value as a decimal number, e.g. 3300 with 3 decimals becomes "3.300".
+ *
+ * parameters:
+ *  int16_t value: fixed-point value
+ *  uint8_t decimals: amount of decimals of the value
+ *  uint8_t *text: array of at least TELEMETRY_VALUE_TEXT_SIZE characters, it is not null terminated
+ *
+ * Returns:
+ *  uint8_t : amount of characters written
+ */
+uint8_t telemetry_format_value(int16_t value, uint8_t decimals, uint8_t *text);
+
+/*
+ * Builds the frame of an event.
+ *
+ * parameters:
+ *  Telemetry_format format: ASCII or binary telemetry
+ *  Telemetry_event event: event to be sent
+ *  Telemetry_frame *frame: frame to be filled
+ *
+ * Returns:
+ *  bool : false if the event is not in the catalog
+ */
+bool telemetry_encode_event(Telemetry_format format, Telemetry_event event, Telemetry_frame *frame);
+
+/*
+ * Builds the frame of a measurement.
+ *
+ * parameters:
+ *  Telemetry_format format: ASCII or binary telemetry
+ *  Telemetry_measurement measurement: what is measured
+ *  int16_t value: fixed-point value, the measurement times 10^decimals of its catalog entry
+ *  Telemetry_frame *frame: frame to be filled
+ *
+ * Returns:
+ *  bool : false if the measurement is not in the catalog
+ */
+bool telemetry_encode_measurement(Telemetry_format format, Telemetry_measurement measurement, int16_t value,
+                                  Telemetry_frame *frame);
+
+/*
+ * Returns the size of the record that starts with the given ID.
+ *
+ * parameters:
+ *  uint8_t id: first byte of the record
+ *
+ * Returns:
+ *  uint8_t : size of the record, 0 if the ID is unknown
+ */
+uint8_t telemetry_record_size(uint8_t id);
+
+#endif // TELEMETRY_H
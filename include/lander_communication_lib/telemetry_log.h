@@ -0,0 +1,316 @@
+/*
+ * telemetry_log.h file
+ *
+ * This file contains the store-and-forward log of the telemetry of the RDS. Every telemetry record that is sent to the
+ * lander is also kept in a circular log in FRAM, with a sequence number and a time stamp, such that what is sent while
+ * the link is down or the lander is not listening can be sent again later. When the log is full the oldest entries are
+ * overwritten.
+ *
+ * The log lives in one block of byte-writable memory, on the MSP430 a persistent array in FRAM:
+ *
+ *   [control block A][control block B][index slots][ring of entries]
+ *
+ *  - An entry is [sequence number][time][length][payload][CRC-16], the sequence numbers count up without gaps and the
+ *    times never go down.
+ *  - The control block holds where the oldest and the next entry are, their sequence numbers, the time of the newest
+ *    entry and how far the lander has acknowledged the log. It is kept twice. A change is written into the older copy
+ *    with a higher generation and a CRC, so a power failure halfway leaves the other copy intact.
+ *  - An entry is written into the free part of the ring first and only becomes part of the log when the control block
+ *    is committed. The oldest entries are dropped with a commit before their bytes are overwritten. A power failure
+ *    at any moment loses at most the entry that was being written.
+ *  - Every TELEMETRY_LOG_INDEX_INTERVAL entries the sequence number, time and offset of the entry are written into an
+ *    index slot. A search looks up the slot in front of its target (by sequence number directly, by time with a
+ *    binary search over the slots) and walks at most TELEMETRY_LOG_INDEX_INTERVAL entries from there. A slot is only a
+ *    hint: the entry it points to is checked, and a slot that is overwritten, torn or out of date makes the search
+ *    walk from the oldest entry instead.
+ *
+ * telemetry_log_open() recovers the log after a reset: it takes the newest valid control block and checks every entry,
+ * a log that is cut short by damaged memory keeps the entries in front of the damage. Times are given by the caller in
+ * ticks since its start. The log adds the time of its newest entry at the moment it was opened, such that the times
+ * keep going up over resets.
+ *
+ * Every write to the block goes through the write function of the log, memcpy when none is given. The host tests use
+ * it to cut the power at every byte.
+ *
+ * The lander reads the log with MSG_TYPE_LOG frames. The first payload byte is the command, numbers are sent high byte
+ * first like the telemetry values:
+ *
+ *  - lander to RDS:
+ *    - SEQUENCE [S][first sequence number, 4][count, 2]: send the entries from a sequence number on
+ *    - TIME     [T][from, 4][to, 4]: send the entries with a time from up to and including to
+ *    - BACKLOG  [B]: send every entry the lander has not acknowledged, also the ones that are added in the meantime.
+ *      The RDS starts this by itself when the lander opens the link with INIT.
+ *    - ACK      [A][sequence number, 4]: the lander has received every entry in front of the sequence number
+ *    - STOP     [X]: stop sending
+ *  - RDS to lander:
+ *    - ENTRIES  [E] followed by entries [sequence number, 4][time, 4][length, 1][payload]
+ *    - FINISHED [F][sequence number, 4]: the replay is done, the next entry gets this sequence number
+ *
+ * The replay sends one frame at a time through telemetry_log_replay_next(), the caller asks for the next frame as long
+ * as the link has room for it, so the backlog goes out at the full speed of the link.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef TELEMETRY_LOG_H
+#define TELEMETRY_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Largest payload of an entry, a telemetry record is at most 3 bytes
+#define TELEMETRY_LOG_MAX_PAYLOAD 16
+
+// Size of an entry around its payload: sequence number, time and length in front, CRC-16 behind
+#define TELEMETRY_LOG_ENTRY_HEADER_SIZE 9
+#define TELEMETRY_LOG_ENTRY_OVERHEAD (TELEMETRY_LOG_ENTRY_HEADER_SIZE + 2)
+
+// Every TELEMETRY_LOG_INDEX_INTERVAL-th entry is written into an index slot, a power of 2
+#define TELEMETRY_LOG_INDEX_INTERVAL 16
+
+// Identifies a formatted block, "TL"
+#define TELEMETRY_LOG_MAGIC 0x544C
+
+// Commands in the first payload byte of MSG_TYPE_LOG
+#define TELEMETRY_LOG_SEQUENCE 'S'
+#define TELEMETRY_LOG_TIME     'T'
+#define TELEMETRY_LOG_BACKLOG  'B'
+#define TELEMETRY_LOG_ACK      'A'
+#define TELEMETRY_LOG_STOP     'X'
+#define TELEMETRY_LOG_ENTRIES  'E'
+#define TELEMETRY_LOG_FINISHED 'F'
+
+// Size of an entry in an ENTRIES frame around its payload: sequence number, time and length
+#define TELEMETRY_LOG_REPLAY_HEADER_SIZE 9
+
+// Persistent control block, kept twice at the start of the block
+typedef struct {
+    uint32_t tail_seq;          // sequence number of the oldest entry
+    uint32_t next_seq;          // sequence number of the next entry, the log is empty when it equals tail_seq
+    uint32_t last_time;         // time of the newest entry
+    uint32_t acked_seq;         // the lander has received every entry in front of this one
+    uint16_t magic;
+    uint16_t generation;        // the valid copy with the newest generation is the current one
+    uint16_t tail;              // offset of the oldest entry in the ring
+    uint16_t head;              // offset of the next entry in the ring
+    uint16_t check;             // CRC-16 of the fields in front of it
+} Telemetry_log_control;
+
+// Index slot of an entry whose sequence number is a multiple of TELEMETRY_LOG_INDEX_INTERVAL
+typedef struct {
+    uint32_t seq;
+    uint32_t time;
+    uint16_t offset;            // offset of the entry in the ring
+} Telemetry_log_index_slot;
+
+// Entry as it is read from the log
+typedef struct {
+    uint32_t seq;
+    uint32_t time;
+    uint8_t length;
+    uint8_t payload[TELEMETRY_LOG_MAX_PAYLOAD];
+} Telemetry_log_entry;
+
+// Position in the log, of the entry that is read next
+typedef struct {
+    uint32_t seq;
+    uint16_t offset;
+} Telemetry_log_cursor;
+
+// Statistics of a log, the counters wrap around at 65535
+typedef struct {
+    uint16_t recovered;         // times an existing log was found by telemetry_log_open
+    uint16_t truncated;         // times telemetry_log_open cut the log short at a damaged entry
+    uint16_t overwritten;       // entries that were dropped to make room
+    uint16_t index_hits;        // searches that started from an index slot
+    uint16_t index_misses;      // searches that had to walk from the oldest entry
+} Telemetry_log_statistics;
+
+// Replay of a part of the log to the lander
+typedef struct {
+    Telemetry_log_cursor cursor;    // next entry to send
+    uint32_t end_seq;               // the replay ends in front of this entry
+    uint32_t end_time;              // or at the first entry after this time
+    bool active;                    // entries or the FINISHED frame still have to be sent
+    uint16_t sent_entries;          // entries sent since initialisation, wraps around at 65535
+} Telemetry_log_replay;
+
+typedef struct Telemetry_log Telemetry_log;
+
+// Writes bytes into the block of the log, like memcpy
+typedef void (*Telemetry_log_write_function)(Telemetry_log *log, uint8_t *destination, const uint8_t *source,
+                                             uint16_t length);
+
+// Log structure, in RAM, the block it works on is persistent
+struct Telemetry_log {
+    uint8_t *block;
+    uint16_t index_slots;
+    uint8_t *index;                     // first index slot in the block
+    uint8_t *ring;                      // ring of entries in the block
+    uint16_t ring_size;
+    Telemetry_log_write_function write;
+    void *context;                      // free for the user of the log
+
+    Telemetry_log_control control;      // copy of the current control block
+    uint8_t current;                    // which of the two control blocks is the current one
+    uint32_t time_offset;               // added to the times of the caller
+
+    Telemetry_log_statistics statistics;
+};
+
+/*
+ * Returns the size of a block for a ring of entries and an amount of index slots.
+ *
+ * parameters:
+ *  uint16_t ring_size: bytes of the ring of entries
+ *  uint16_t index_slots: amount of index slots
+ *
+ * Returns:
+ *  uint32_t : bytes of the block
+ */
+uint32_t telemetry_log_block_size(uint16_t ring_size, uint16_t index_slots);
+
+/*
+ * Opens the log in a block. An existing log is recovered, otherwise the block is formatted as an empty log.
+ *
+ * parameters:
+ *  Telemetry_log *log: log to open
+ *  uint8_t *block: block of byte-writable persistent memory
+ *  uint16_t size: bytes of the block
+ *  uint16_t index_slots: amount of index slots, at least 1. The same value has to be given after every reset.
+ *  Telemetry_log_write_function write: writes into the block, NULL for memcpy
+ *
+ * Returns:
+ *  bool : false if the block is too small, the log cannot be used
+ */
+bool telemetry_log_open(Telemetry_log *log, uint8_t *block, uint16_t size, uint16_t index_slots,
+                        Telemetry_log_write_function write);
+
+/*
+ * Empties the log. The sequence numbers and times go on where they were.
+ *
+ * parameters:
+ *  Telemetry_log *log: log to empty
+ */
+void telemetry_log_clear(Telemetry_log *log);
+
+/*
+ * Adds an entry to the log, the oldest entries are dropped when there is no room.
+ *
+ * parameters:
+ *  Telemetry_log *log: log
+ *  const uint8_t *payload: payload of the entry
+ *  uint8_t length: bytes of the payload, 1 to TELEMETRY_LOG_MAX_PAYLOAD
+ *  uint32_t now: current time in ticks since the start of the caller
+ *
+ * Returns:
+ *  bool : false if the payload is empty or too large
+ */
+bool telemetry_log_append(Telemetry_log *log, const uint8_t *payload, uint8_t length, uint32_t now);
+
+/*
+ * Returns the amount of entries in the log.
+ *
+ * parameters:
+ *  const Telemetry_log *log: log
+ *
+ * Returns:
+ *  uint32_t : amount of entries
+ */
+uint32_t telemetry_log_count(const Telemetry_log *log);
+
+/*
+ * Places a cursor on the first entry with at least a sequence number, or on the oldest entry if that one is newer.
+ *
+ * parameters:
+ *  Telemetry_log *log: log
+ *  uint32_t seq: sequence number
+ *  Telemetry_log_cursor *cursor: cursor to place
+ */
+void telemetry_log_seek_seq(Telemetry_log *log, uint32_t seq, Telemetry_log_cursor *cursor);
+
+/*
+ * Places a cursor on the first entry with at least a time.
+ *
+ * parameters:
+ *  Telemetry_log *log: log
+ *  uint32_t time: time as stored in the log
+ *  Telemetry_log_cursor *cursor: cursor to place
+ */
+void telemetry_log_seek_time(Telemetry_log *log, uint32_t time, Telemetry_log_cursor *cursor);
+
+/*
+ * Reads the entry at a cursor and moves the cursor to the next one. A cursor whose entry has been overwritten in the
+ * meantime moves to the oldest entry first.
+ *
+ * parameters:
+ *  Telemetry_log *log: log
+ *  Telemetry_log_cursor *cursor: cursor
+ *  Telemetry_log_entry *entry: entry to fill
+ *
+ * Returns:
+ *  bool : false if the cursor is at the end of the log
+ */
+bool telemetry_log_read(Telemetry_log *log, Telemetry_log_cursor *cursor, Telemetry_log_entry *entry);
+
+/*
+ * Records that the lander has received every entry in front of a sequence number. It only moves forward.
+ *
+ * parameters:
+ *  Telemetry_log *log: log
+ *  uint32_t seq: sequence number of the first entry the lander has not received
+ */
+void telemetry_log_acknowledge(Telemetry_log *log, uint32_t seq);
+
+/*
+ * Initialises a replay that sends nothing.
+ *
+ * parameters:
+ *  Telemetry_log_replay *replay: replay to initialise
+ */
+void telemetry_log_replay_init(Telemetry_log_replay *replay);
+
+/*
+ * Starts a replay of every entry the lander has not acknowledged, up to the end of the log at the moment it is sent.
+ *
+ * parameters:
+ *  Telemetry_log *log: log
+ *  Telemetry_log_replay *replay: replay to start, a running replay is replaced
+ */
+void telemetry_log_replay_backlog(Telemetry_log *log, Telemetry_log_replay *replay);
+
+/*
+ * Handles the payload of a MSG_TYPE_LOG frame of the lander.
+ *
+ * parameters:
+ *  Telemetry_log *log: log
+ *  Telemetry_log_replay *replay: replay that is started or stopped by the command
+ *  const uint8_t *payload: payload of the frame
+ *  uint8_t length: length of the payload
+ *
+ * Returns:
+ *  bool : false if the command is unknown or has the wrong length
+ */
+bool telemetry_log_command(Telemetry_log *log, Telemetry_log_replay *replay, const uint8_t *payload, uint8_t length);
+
+/*
+ * Builds the payload of the next MSG_TYPE_LOG frame of a replay: as many entries as fit, or FINISHED after the last
+ * one. The replay only moves on when the frame is used, a caller that cannot send the frame yet restores a copy of
+ * the replay made before the call.
+ *
+ * parameters:
+ *  Telemetry_log *log: log
+ *  Telemetry_log_replay *replay: replay
+ *  uint8_t *payload: payload to fill
+ *  uint8_t size: size of the payload, at least TELEMETRY_LOG_REPLAY_HEADER_SIZE + TELEMETRY_LOG_MAX_PAYLOAD + 1
+ *
+ * Returns:
+ *  uint8_t : length of the payload, 0 if the replay has nothing to send
+ */
+uint8_t telemetry_log_replay_next(Telemetry_log *log, Telemetry_log_replay *replay, uint8_t *payload, uint8_t size);
+
+#endif // TELEMETRY_LOG_H
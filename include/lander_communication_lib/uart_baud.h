@@ -0,0 +1,145 @@
+/*
+ * uart_baud.h file
+ *
+ * This file contains the baud rate calculator of the eUSCI_A UART. It derives the register settings (UCBRx, UCOS16,
+ * UCBRFx and UCBRSx) from the clock and baud rate the same way as the user's guide (SLAU367, section 30.3.10), so the
+ * tables of the user's guide do not have to be worked through again for a new link speed:
+ *
+ *  - N = f_BRCLK / baud
+ *  - above 16, oversampling is used: UCOS16 = 1, UCBRx = INT(N / 16) and UCBRFx = INT((N / 16 - INT(N / 16)) * 16)
+ *  - otherwise UCOS16 = 0 and UCBRx = INT(N)
+ *  - UCBRSx is looked up from the fractional part of N in table 30-4
+ *
+ * Everything is constexpr. Together with uart_baud_error() a baud rate whose modulation error is too large is rejected
+ * by a static_assert when the firmware is compiled, see link_speed.cpp.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef UART_BAUD_H
+#define UART_BAUD_H
+
+#include <stdint.h>
+
+// Clock of the UART (SMCLK, see setup_SMCLK)
+#ifndef UART_BRCLK_HZ
+#define UART_BRCLK_HZ 16000000UL
+#endif
+
+// Largest transmit bit error that is accepted, in 0.01 %. Both sides of the link may be off in opposite directions,
+// so each side gets a bit less than half of the ~5 % that a UART can take at the stop bit.
+#define UART_BAUD_MAX_ERROR 200
+
+// Register values of the bits of UCAxMCTLW
+#define UART_MCTLW_UCOS16       0x0001
+#define UART_MCTLW_UCBRF_SHIFT  4
+#define UART_MCTLW_UCBRS_SHIFT  8
+
+// Register settings of one baud rate
+typedef struct {
+    uint16_t brw;       // UCAxBRW: UCBRx
+    uint16_t mctlw;     // UCAxMCTLW: UCBRSx, UCBRFx and UCOS16
+} UART_baud_setting;
+
+// User's guide table 30-4: lowest fractional part of N (in 1/10000) for every UCBRSx value
+static constexpr uint16_t uart_ucbrs_fractions[] = {
+    0,    529,  715,  835,  1001, 1252, 1430, 1670, 2147, 2224, 2503, 3000, 3335, 3575, 3753, 4003, 4286, 4378,
+    5002, 5715, 6003, 6254, 6432, 6667, 7001, 7147, 7503, 7861, 8004, 8333, 8464, 8572, 8751, 9004, 9170, 9288
+};
+static constexpr uint8_t uart_ucbrs_values[] = {
+    0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x11, 0x21, 0x22, 0x44, 0x25, 0x49, 0x4A, 0x52, 0x92, 0x53, 0x55,
+    0xAA, 0x6B, 0xAD, 0xB5, 0xB6, 0xD6, 0xB7, 0xBB, 0xDD, 0xED, 0xEE, 0xBF, 0xDF, 0xEF, 0xF7, 0xFB, 0xFD, 0xFE
+};
+
+static_assert(sizeof(uart_ucbrs_fractions) / sizeof(uart_ucbrs_fractions[0]) == sizeof(uart_ucbrs_values),
+              "every fraction of table 30-4 has a UCBRSx value");
+
+/*
+ * Returns the UCBRSx value of the fractional part of N, in 1/10000.
+ */
+constexpr uint8_t uart_ucbrs(uint32_t fraction)
+{
+    uint8_t value = 0;
+    for (uint8_t i = 0; i < sizeof(uart_ucbrs_values); i++) {
+        if (uart_ucbrs_fractions[i] <= fraction) {
+            value = uart_ucbrs_values[i];
+        }
+    }
+    return value;
+}
+
+/*
+ * Calculates the register settings of a baud rate.
+ *
+ * parameters:
+ *  uint32_t brclk: clock of the UART in Hz
+ *  uint32_t baud: baud rate
+ *
+ * Returns:
+ *  UART_baud_setting : values for UCAxBRW and UCAxMCTLW
+ */
+constexpr UART_baud_setting uart_baud_setting(uint32_t brclk, uint32_t baud)
+{
+    uint32_t n = brclk / baud;
+    // fractional part of N in 1/10000, rounded like the fractions of table 30-4 (2/3 is listed as 0.6667)
+    uint32_t fraction = (uint32_t)(((uint64_t)(brclk % baud) * 10000 + baud / 2) / baud);
+    uint16_t mctlw = (uint16_t)(uart_ucbrs(fraction) << UART_MCTLW_UCBRS_SHIFT);
+    uint16_t brw = (uint16_t)n;
+
+    if (n > 16) {
+        // UCBRFx = INT((N / 16 - INT(N / 16)) * 16) = INT(N) mod 16
+        brw = (uint16_t)(n / 16);
+        mctlw |= (uint16_t)(UART_MCTLW_UCOS16 | (n % 16) << UART_MCTLW_UCBRF_SHIFT);
+    }
+    return UART_baud_setting{brw, mctlw};
+}
+
+/*
+ * Calculates the largest transmit bit error of a setting over one character (start bit, 8 data bits, stop bit), like
+ * the "max TX error" of table 30-5. Every bit lasts 16 * UCBRx + UCBRFx clocks with oversampling, or UCBRx clocks
+ * without, plus one clock when its bit of UCBRSx is set. Bit 7 of UCBRSx belongs to the start bit, the pattern
+ * repeats after 8 bits.
+ *
+ * parameters:
+ *  uint32_t brclk: clock of the UART in Hz
+ *  uint32_t baud: baud rate
+ *  UART_baud_setting setting: register settings
+ *
+ * Returns:
+ *  uint32_t : largest deviation of a bit edge from its ideal time, in 0.01 % of a bit
+ */
+constexpr uint32_t uart_baud_error(uint32_t brclk, uint32_t baud, UART_baud_setting setting)
+{
+    uint32_t bit_clocks = setting.brw;
+    if ((setting.mctlw & UART_MCTLW_UCOS16) != 0) {
+        bit_clocks = 16u * setting.brw + ((setting.mctlw >> UART_MCTLW_UCBRF_SHIFT) & 0x0F);
+    }
+    uint8_t ucbrs = (uint8_t)(setting.mctlw >> UART_MCTLW_UCBRS_SHIFT);
+
+    int64_t clocks = 0;
+    uint32_t largest = 0;
+    for (uint8_t bit = 0; bit < 10; bit++) {
+        clocks += bit_clocks + ((ucbrs >> (7 - bit % 8)) & 1);
+        // (actual end - ideal end) / ideal bit time, where the ideal end of the bit is (bit + 1) * brclk / baud
+        int64_t deviation = (clocks * baud - (int64_t)(bit + 1) * brclk) * 10000 / brclk;
+        uint32_t error = (uint32_t)(deviation < 0 ? -deviation : deviation);
+        if (error > largest) {
+            largest = error;
+        }
+    }
+    return largest;
+}
+
+/*
+ * Calculates the largest transmit bit error of a baud rate with the settings of uart_baud_setting().
+ */
+constexpr uint32_t uart_baud_error(uint32_t brclk, uint32_t baud)
+{
+    return uart_baud_error(brclk, baud, uart_baud_setting(brclk, baud));
+}
+
+#endif // UART_BAUD_H
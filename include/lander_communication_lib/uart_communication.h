@@ -3,12 +3,11 @@
  *
  * This is the UART communication library that contains the following functionality:
  *
- *  - starting, stopping, and resetting a timer
+ *  - starting, stopping, and resetting the inter-byte timeout (a software timer on the system tick)
  *  - Initialising and configure the UART pins and states
  *  - Enter data into UART transmission buffer
  *  - UART interrupt handler
  *  - ISR for A0 and A1 UART modules
- *  - ISR for timer A0 module
  *
  *  The library works using interrupts for transmission and receiving of characters via the UART ports.
  *  It initialises the system to be used on the USCI_A1 module, since the PCB design of the RDS system
@@ -29,6 +28,11 @@
 #include <lander_communication_lib/lander_communication.h>
 #include <lander_communication_lib/lander_communication_protocol.h>
 #include <lander_communication_lib/payload_messages.h>
+#include <lander_communication_lib/uart_tx_queue.h>
+#include <lander_communication_lib/slip_stream_decoder.h>
+#include <lander_communication_lib/uart_rx_queue.h>
+#include <lander_communication_lib/slip_frame_writer.h>
+#include <lander_communication_lib/uart_baud.h>
 #include <msp430.h>
 #include <cstdint>
 
@@ -36,12 +40,21 @@
 #define UART_BUFFER_SIZE 256
 
 // global UART buffers and state variables
-extern uint8_t TX_buffer[UART_BUFFER_SIZE];
-extern volatile uint16_t TX_start;
-extern volatile uint16_t TX_end;
+extern UART_TX_queue TX_queue;
+extern volatile UART_TX_full_policy TX_full_policy;
 extern uint8_t RX_buffer[UART_BUFFER_SIZE];
-extern volatile uint16_t RX_start;
-extern volatile uint16_t RX_end;
+extern SLIP_stream_decoder RX_decoder;
+extern UART_RX_queue RX_queue;
+
+// Receive statistics, the counters wrap around at 65535
+typedef struct {
+    uint16_t received_frames;   // validated frames placed in RX_queue
+    uint16_t dropped_frames;    // validated frames discarded because RX_queue was full
+    uint16_t overflows;         // frames discarded because the RX ring buffer was full
+    uint16_t invalid_messages;  // frames with a wrong format
+    uint16_t invalid_checksums; // frames with a wrong checksum
+    uint8_t high_water;         // largest amount of frames that has been waiting in RX_queue
+} UART_RX_statistics;
 
 /**
  * enumerate object that will be used for the finite state machine that handles incoming data
@@ -59,33 +72,25 @@ typedef enum {
 extern volatile UART_states UART_state;
 
 /* bools for uart states*/
-extern bool buffer_full_state;
-extern bool error_state;
-extern bool timeout_state;
+extern volatile bool buffer_full_state;
+extern volatile bool error_state;
+extern volatile bool checksum_error_state;
+extern volatile bool timeout_state;
 
 
 /**
- * Starts the timer that runs on TA1 module
- *
- */
-inline static void start_timeout(void);
-
-/**
- * resets the timer to 0 that runs on TA1 module
- *
+ * Configures the A1 module to initialise pins 2.6 (RX) and 2.5 (TX) as UART at the default link speed of 115200 baud/s.
  */
-inline static void reset_timeout(void);
+void uart_init(void);
 
-/**
- * Stops/Disables the timer that runs on TA1 module
+/*
+ * Changes the baud rate of the A1 module. Bytes that are still being sent or received are lost, so the transmission
+ * queue has to be flushed first.
  *
+ * parameters:
+ *  const UART_baud_setting *setting: register settings of the baud rate, see uart_baud.h and link_speed.h
  */
-inline static void stop_timeout(void);
-
-/**
- * Configures the A1 module to initialise pins 2.6 (RX) and 2.5 (TX) as UART at a baud rate of 115200 baud/s.
- */
-void uart_init(void);
+void uart_set_baud(const UART_baud_setting *setting);
 
 /**
  * Configures the UART state and indexes of the buffers
@@ -94,12 +99,48 @@ void uart_configure(void);
 
 /*
  * This method is able to send an array of data through the UART output pin by adding the data to the transmission buffer.
+ * It returns as soon as the data is queued, the TX interrupt sends the bytes in the background. When the queue is full
+ * the TX_full_policy decides whether the method waits for room or drops the data.
  *
  * parameters:
  *  const uint8_t* data: This is the address of array to be sent.
  *  uint16_t length: This is the length of the array to be sent.
+ *
+ * Returns:
+ *  bool : false if the data has been dropped because the queue was full
+ */
+bool uart_write(const uint8_t *data, uint16_t length);
+
+/*
+ * Makes sure that a frame of the given length fits in the transmission queue before it is written straight into it
+ * (see slip_frame_writer.h). Depending on TX_full_policy it waits for the TX interrupt to make room or gives up.
+ *
+ * parameters:
+ *  uint16_t length: amount of bytes that will be written
+ *
+ * Returns:
+ *  bool : false if the frame has to be dropped
+ */
+bool uart_tx_reserve(uint16_t length);
+
+/*
+ * Starts sending the bytes that have been written straight into the transmission queue.
+ */
+void uart_tx_start(void);
+
+/*
+ * Sleeps until every queued byte has been shifted out of the UART, for example before the baud rate is changed or the
+ * MCU is put to sleep. Bytes that are received in the meantime do not keep it waiting.
  */
-void uart_write(uint8_t *data, uint16_t length);
+void uart_flush(void);
+
+/*
+ * Returns the amount of bytes that are still waiting in the transmission queue.
+ *
+ * Returns:
+ *  uint16_t : amount of queued bytes
+ */
+uint16_t uart_tx_pending(void);
 
 /**
  * Generic handler for UART interrupts
@@ -110,9 +151,32 @@ void uart_write(uint8_t *data, uint16_t length);
 inline static void uart_interrupt_handler(uint8_t character);
 
 /*
- * This method handles the data in the RX buffer
+ * Takes the oldest validated frame that the RX interrupt has decoded out of the RX buffer. Frames that arrive in the
+ * meantime are queued in RX_queue, so this method can be called until it returns false to handle a burst of frames.
+ *
+ * parameters:
+ *  Message *msg: message structure to be filled
+ *
+ * Returns:
+ *  bool : false if no frame is waiting
+ */
+bool uart_receive_frame(Message *msg);
+
+/*
+ * Returns the amount of received frames that are waiting to be handled.
+ *
+ * Returns:
+ *  uint8_t : amount of queued frames
+ */
+uint8_t uart_rx_pending(void);
+
+/*
+ * Copies the receive statistics (queued, dropped, overflowed and rejected frames).
+ *
+ * parameters:
+ *  UART_RX_statistics *statistics: structure to be filled
  */
-uint16_t read_RX_buffer(uint16_t start, uint16_t end);
+void uart_rx_get_statistics(UART_RX_statistics *statistics);
 
 
 #endif // UART_COMM_H
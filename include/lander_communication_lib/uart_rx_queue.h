@@ -0,0 +1,106 @@
+/*
+ * uart_rx_queue.h file
+ *
+ * This file contains the receive queue of the UART communication library. The RX interrupt decodes complete frames into
+ * the RX ring buffer (see slip_stream_decoder.h) and places a descriptor of every validated frame (message type,
+ * length and location in the ring buffer) in this queue. The main loop takes the descriptors out in the order in which
+ * the frames arrived, so the interrupt can keep receiving while earlier frames are still being handled.
+ *
+ * The queue has exactly one producer (the RX interrupt) and one consumer (the main loop). The producer only writes
+ * the head index and the consumer only writes the tail index, so no interrupts have to be disabled to access it.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef UART_RX_QUEUE_H
+#define UART_RX_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <lander_communication_lib/slip_stream_decoder.h>
+
+// Amount of frame descriptors, must be a power of two. One slot is kept free to tell a full and an empty queue apart,
+// so at most UART_RX_QUEUE_SIZE - 1 frames can be waiting at the same time.
+#define UART_RX_QUEUE_SIZE 8
+#define UART_RX_QUEUE_MASK (UART_RX_QUEUE_SIZE - 1)
+
+// Receive queue structure
+typedef struct {
+    SLIP_stream_frame frames[UART_RX_QUEUE_SIZE];
+    volatile uint8_t head;              // index of the next free descriptor, only written by the RX interrupt
+    volatile uint8_t tail;              // index of the oldest waiting frame, only written by the main loop
+    volatile uint16_t received_frames;  // frames that have been queued
+    volatile uint16_t dropped_frames;   // validated frames discarded because every descriptor was in use
+    uint8_t high_water;                 // largest amount of frames that has been waiting in the queue
+} UART_RX_queue;
+
+/*
+ * Empties the queue and resets the statistics.
+ *
+ * parameters:
+ *  UART_RX_queue *queue: queue to initialise
+ */
+void uart_rx_queue_init(UART_RX_queue *queue);
+
+/*
+ * Returns the amount of frames that are waiting to be handled.
+ *
+ * parameters:
+ *  const UART_RX_queue *queue: queue to inspect
+ *
+ * Returns:
+ *  uint8_t : amount of queued frames
+ */
+uint8_t uart_rx_queue_count(const UART_RX_queue *queue);
+
+/*
+ * Checks whether all queued frames have been taken out by the main loop.
+ *
+ * parameters:
+ *  const UART_RX_queue *queue: queue to inspect
+ *
+ * Returns:
+ *  bool : true if no frames are waiting
+ */
+bool uart_rx_queue_is_empty(const UART_RX_queue *queue);
+
+/*
+ * Adds the descriptor of a validated frame to the queue. Called by the RX interrupt only. When the queue is full the
+ * frame is counted in dropped_frames and the caller has to give its ring buffer space back.
+ *
+ * parameters:
+ *  UART_RX_queue *queue: queue to add the frame to
+ *  const SLIP_stream_frame *frame: descriptor of the frame
+ *
+ * Returns:
+ *  bool : false if the queue is full
+ */
+bool uart_rx_queue_push(UART_RX_queue *queue, const SLIP_stream_frame *frame);
+
+/*
+ * Returns the oldest waiting frame without taking it out of the queue. Called by the main loop only.
+ *
+ * parameters:
+ *  const UART_RX_queue *queue: queue to inspect
+ *
+ * Returns:
+ *  const SLIP_stream_frame * : descriptor of the oldest frame, NULL if the queue is empty
+ */
+const SLIP_stream_frame *uart_rx_queue_peek(const UART_RX_queue *queue);
+
+/*
+ * Takes the oldest frame out of the queue once it has been handled. Called by the main loop only.
+ *
+ * parameters:
+ *  UART_RX_queue *queue: queue to take the frame from
+ *
+ * Returns:
+ *  bool : false if the queue is empty
+ */
+bool uart_rx_queue_pop(UART_RX_queue *queue);
+
+#endif // UART_RX_QUEUE_H
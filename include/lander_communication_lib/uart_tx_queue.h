@@ -0,0 +1,124 @@
+/*
+ * uart_tx_queue.h file
+ *
+ * This file contains the transmission queue of the UART communication library. Bytes that have to be sent to the lander
+ * are placed in a ring buffer by the main loop and are taken out again one by one by the USCI_A1 TX interrupt, such
+ * that the CPU does not have to wait for every byte to be shifted out of the UART.
+ *
+ * The queue has exactly one producer (the main loop) and one consumer (the TX interrupt). The producer only writes
+ * the head index and the consumer only writes the tail index, so no interrupts have to be disabled to access it.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef UART_TX_QUEUE_H
+#define UART_TX_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Size of the transmission ring buffer, must be a power of two. One slot is kept free to tell a full and an empty
+// buffer apart, so at most UART_TX_QUEUE_SIZE - 1 bytes can be waiting at the same time.
+#define UART_TX_QUEUE_SIZE 256
+#define UART_TX_QUEUE_MASK (UART_TX_QUEUE_SIZE - 1)
+
+/**
+ * enumerate object that describes what uart_write does when a frame does not fit in the queue
+ */
+typedef enum {
+    UART_TX_BLOCK,          // wait until the TX interrupt has made room, no frame is ever lost (default)
+    UART_TX_DROP_FRAME      // discard the complete frame and count it, uart_write never waits
+} UART_TX_full_policy;
+
+// Transmission queue structure
+typedef struct {
+    uint8_t buffer[UART_TX_QUEUE_SIZE];
+    volatile uint16_t head;             // index of the next free slot, only written by the main loop
+    volatile uint16_t tail;             // index of the next byte to send, only written by the TX interrupt
+    volatile uint16_t dropped_frames;   // frames discarded by the UART_TX_DROP_FRAME policy
+    uint16_t high_water;                // largest amount of bytes that has been waiting in the queue
+} UART_TX_queue;
+
+/*
+ * Empties the queue and resets the statistics.
+ *
+ * parameters:
+ *  UART_TX_queue *queue: queue to initialise
+ */
+void uart_tx_queue_init(UART_TX_queue *queue);
+
+/*
+ * Returns the amount of bytes that are waiting to be sent.
+ *
+ * parameters:
+ *  const UART_TX_queue *queue: queue to inspect
+ *
+ * Returns:
+ *  uint16_t : amount of queued bytes
+ */
+uint16_t uart_tx_queue_used(const UART_TX_queue *queue);
+
+/*
+ * Returns the amount of bytes that can still be added to the queue.
+ *
+ * parameters:
+ *  const UART_TX_queue *queue: queue to inspect
+ *
+ * Returns:
+ *  uint16_t : amount of free slots
+ */
+uint16_t uart_tx_queue_free(const UART_TX_queue *queue);
+
+/*
+ * Checks whether all queued bytes have been taken out by the consumer.
+ *
+ * parameters:
+ *  const UART_TX_queue *queue: queue to inspect
+ *
+ * Returns:
+ *  bool : true if no bytes are waiting
+ */
+bool uart_tx_queue_is_empty(const UART_TX_queue *queue);
+
+/*
+ * Adds as many bytes of the array to the queue as there is room for. Called by the main loop only.
+ *
+ * parameters:
+ *  UART_TX_queue *queue: queue to add the data to
+ *  const uint8_t *data: address of the array to be queued
+ *  uint16_t length: length of the array
+ *
+ * Returns:
+ *  uint16_t : amount of bytes that have actually been queued
+ */
+uint16_t uart_tx_queue_push(UART_TX_queue *queue, const uint8_t *data, uint16_t length);
+
+/*
+ * Adds a single byte to the queue. Called by the main loop only.
+ *
+ * parameters:
+ *  UART_TX_queue *queue: queue to add the byte to
+ *  uint8_t byte: byte to be queued
+ *
+ * Returns:
+ *  bool : false if the queue is full
+ */
+bool uart_tx_queue_push_byte(UART_TX_queue *queue, uint8_t byte);
+
+/*
+ * Takes the oldest byte out of the queue. Called by the TX interrupt only.
+ *
+ * parameters:
+ *  UART_TX_queue *queue: queue to take the byte from
+ *  uint8_t *byte: address where the byte is stored
+ *
+ * Returns:
+ *  bool : false if the queue is empty
+ */
+bool uart_tx_queue_pop(UART_TX_queue *queue, uint8_t *byte);
+
+#endif // UART_TX_QUEUE_H
@@ -24,15 +24,23 @@
 #include "system_health_lib/NEA_readout.h"
 #include "system_health_lib/temp_sensors.h"
 #include "system_health_lib/heat_resistor_control.h"
+#include "system_health_lib/sensor_filters.h"
 #include "lander_communication_lib/lander_communication.h"
 #include "lander_communication_lib/payload_messages.h"
 
+// Sweeps in the outlier rejection of the bus sense and the supercap voltage
+#define ECCS_FILTER_WINDOW 5
+// Deviation in ADC counts that is never an outlier, about 13 mV of noise
+#define ECCS_FILTER_MIN_DEVIATION 16
+// Weight of a sweep in the average of the bus sense and the supercap voltage, 1 / 2^ECCS_FILTER_SHIFT
+#define ECCS_FILTER_SHIFT 2
+
 // Enumeration for task states
 typedef enum {
     TASK_CHECK_UMBILICAL_ECCS,
     TASK_BUS_CURRENT_SENSE,
-    TASK_TEMPERATURE_SENSORS_CHECK_1,
-    TASK_TEMPERATURE_SENSORS_CHECK_2,
+    TASK_TEMPERATURE_SENSORS_START,
+    TASK_TEMPERATURE_SENSORS_READ,
     TASK_HEAT_RESISTOR_CONTROL,
     TASK_SUPER_CAP_CHECK,
     TASK_NEA_CHECK,
@@ -53,7 +61,7 @@ extern ECCSTaskState EECSTask;
 void initialize_all_electronic_pins(void);
 
 /*
- * Performs the RDS electronics status check.
+ * Performs the RDS electronics status check at once, handling received messages between the steps.
  *
  * Parameters:
  *  None
@@ -63,4 +71,29 @@ void initialize_all_electronic_pins(void);
  */
 void RDS_electronics_status_check(void);
 
+/*
+ * Performs one step of the RDS electronics status check, such that a task of the scheduler can run the check without
+ * blocking the lander link for the whole sweep. The status messages of a sweep are batched from the first to the last
+ * step.
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  bool: true if this step completed the sweep, the next step starts a new sweep
+ */
+bool RDS_electronics_status_step(void);
+
+/*
+ * Abandons the running sweep of RDS_electronics_status_step, for example when the transit mode changes, and sends its
+ * batched messages.
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  void
+ */
+void RDS_electronics_status_reset(void);
+
 #endif // ECCS_H
@@ -17,6 +17,7 @@
 #include <stdbool.h>
 
 #include "system_health_lib/supercap_readout.h"
+#include "system_health_lib/nea_sequencer.h"
 
 /*
  * Initializes all 4 NEA's.
@@ -33,7 +34,7 @@ void initialize_all_nea_pins(void);
  * Actuate NEA n.
  *
  * Parameters:
- *  None
+ *  int nea: NEA 1 to 4
  *
  * Returns:
  *  void
@@ -44,7 +45,7 @@ void activate_NEA_n(int nea);
  * stop Actuating NEA n
  *
  * Parameters:
- *  None
+ *  int nea: NEA 1 to 4
  *
  * Returns:
  *  void
@@ -52,7 +53,44 @@ void activate_NEA_n(int nea);
 void deactivate_NEA_n(int nea);
 
 /*
- * Actuate all four NEAs.
+ * Initialises the NEA firing sequence and registers its lander commands on MSG_TYPE_DEPLOY: "AB" aborts, "HO" holds
+ * and "RE" resumes the sequence. Called after lander_dispatch_init().
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  void
+ */
+void NEA_sequence_init(void);
+
+/*
+ * Starts the firing sequence of all four NEAs, see nea_sequencer.h. The sequence has to be polled with
+ * NEA_sequence_poll().
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  void
+ */
+void NEA_sequence_start(void);
+
+/*
+ * Continues the firing sequence without waiting. The ready pin after every attempt and the time of every NEA are sent
+ * to the lander.
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  bool: true when the sequence is not running (anymore)
+ */
+bool NEA_sequence_poll(void);
+
+/*
+ * Aborts a running firing sequence, every NEA flag and the supercap charge are switched off right away. Nothing
+ * happens when the sequence is not running.
  *
  * Parameters:
  *  None
@@ -60,19 +98,30 @@ void deactivate_NEA_n(int nea);
  * Returns:
  *  void
  */
-void activate_NEAs(void);
+void NEA_sequence_abort(void);
+
+/*
+ * Returns the state of the firing sequence.
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  Nea_sequence_state: state of the sequence
+ */
+Nea_sequence_state NEA_sequence_state(void);
 
 /*
  * send a message to the Lander about nea x and its status
  *
  * Parameters:
- *  int nea: nea 0,1,2,3
+ *  uint8_t nea: nea 0,1,2,3
  *  bool status: true or false about whether it is still deployable
  *
  * Returns:
  *  void
  */
-void send_NEA_message(int nea, bool status);
+void send_NEA_message(uint8_t nea, bool status);
 
 /*
  * Reads the status of the NEA ready bit.
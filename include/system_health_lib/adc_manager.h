@@ -0,0 +1,200 @@
+/*
+ * adc_manager.h
+ *
+ * This header file contains the ADC manager of the RDS. The ADC12 is configured once for a sequence-of-channels
+ * conversion of all analog channels of ADC_CHANNELS (see adc_sequence.h), every sample has an ADC12MEMx slot of its
+ * own.
+ * A snapshot triggers the whole sequence once and returns the averaged result of every channel, instead of
+ * reconfiguring ADC12MCTL0 and converting a single channel for every readout.
+ *
+ * Between the snapshots the channels are monitored continuously (see adc_monitor.h). The monitor has a sequence of
+ * its own with one slot per channel after the slots of the snapshot, repeated without the CPU:
+ *
+ *  - Every system tick the output of TA0.1 triggers the conversion of the next slot, every channel is sampled once
+ *    per ADC_MONITOR_SAMPLE_PERIOD_MS.
+ *  - At the end of every sequence DMA channel n copies the slot of channel n into the ring of the channel. The DMA
+ *    repeats over the ring, the last DMA channel interrupts when the rings are full.
+ *  - The window comparator checks ADC_MONITOR_COMPARATOR_CHANNEL on every sample, the other channels are checked
+ *    by the DMA interrupt when the rings are full.
+ *
+ * The CPU only wakes up when a channel leaves or reenters its window, adc_monitor_report() then sends it to the
+ * lander. A snapshot pauses the monitor for the time of its own sequence.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef ADC_MANAGER_H
+#define ADC_MANAGER_H
+
+#include <msp430.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "system_health_lib/adc_sequence.h"
+#include "system_health_lib/adc_monitor.h"
+#include "system_health_lib/sensor_fixed_point.h"
+
+// Analog channels in conversion order: X(name, analog input, oversampling). A new channel is added here, its pin has
+// to be set to its analog function by its own module.
+#define ADC_CHANNELS(X) \
+    X(SUPERCAP, 7, 4)       /* P2.4, the supercap voltage */ \
+    X(BUS_SENSE, 11, 4)     /* P4.3, the bus current sense */
+
+// Channel IDs, ADC_CHANNEL_SUPERCAP, ADC_CHANNEL_BUS_SENSE, ...
+typedef enum {
+#define ADC_CHANNEL_ID(name, input, oversampling) ADC_CHANNEL_##name,
+    ADC_CHANNELS(ADC_CHANNEL_ID)
+#undef ADC_CHANNEL_ID
+    ADC_CHANNEL_COUNT
+} Adc_channel;
+
+// Slots of the sequence, known at compile time
+enum {
+#define ADC_CHANNEL_SLOTS(name, input, oversampling) + (oversampling)
+    ADC_SEQUENCE_SLOTS = 0 ADC_CHANNELS(ADC_CHANNEL_SLOTS)
+#undef ADC_CHANNEL_SLOTS
+};
+
+static_assert(ADC_SEQUENCE_SLOTS <= ADC_SEQUENCE_MAX_SLOTS, "the samples of ADC_CHANNELS do not fit in ADC12MEMx");
+
+// Value of ADC12IV when the last slot of the sequence is done, the end of a snapshot
+#define ADC_SEQUENCE_IV (ADC12IV_ADC12IFG0 + 2 * (ADC_SEQUENCE_SLOTS - 1))
+
+// Sample time of every slot in ADC12CLK cycles, see ADC12SHT0_2 in initialize_adc_sequence()
+#define ADC_SAMPLE_CYCLES 16
+
+// First slot of the sequence of the monitor, the monitor takes one slot per channel
+#define ADC_MONITOR_START_SLOT ADC_SEQUENCE_SLOTS
+
+static_assert(ADC_MONITOR_START_SLOT + ADC_CHANNEL_COUNT <= ADC_SEQUENCE_MAX_SLOTS,
+              "the slots of the monitor do not fit in ADC12MEMx");
+static_assert(ADC_CHANNEL_COUNT <= ADC_MONITOR_MAX_CHANNELS, "every monitored channel needs a DMA channel");
+
+// Time between two samples of a channel in ms, the monitor converts one slot per system tick
+#define ADC_MONITOR_SAMPLE_PERIOD_MS ADC_CHANNEL_COUNT
+
+// Value of DMAIV when the rings are full, the last DMA channel of the monitor
+#define ADC_MONITOR_DMA_IV (DMAIV_DMA0IFG + 2 * (ADC_CHANNEL_COUNT - 1))
+
+// Channel that is checked by the window comparator on every sample
+#define ADC_MONITOR_COMPARATOR_CHANNEL ADC_CHANNEL_BUS_SENSE
+
+// Limits of the monitor in volts. An overcurrent to the rover raises the bus sense voltage above its high limit. The
+// supercap voltage pin only shows a cap while it is measured, its low limit of 0 V leaves the channel unwatched.
+#define ADC_MONITOR_BUS_SENSE_HIGH_V 3.0
+#define ADC_MONITOR_SUPERCAP_LOW_V 0.0
+
+// Results of all channels at one moment
+typedef struct {
+    uint16_t raw[ADC_CHANNEL_COUNT];    // averaged 12-bit result of every channel
+    uint16_t tick;                      // system tick at which the sequence was done
+    bool valid;                         // false when the conversion failed
+} Adc_snapshot;
+
+/*
+ * Configures the ADC12 for the sequence of ADC_CHANNELS and enables conversions. Replaces the configuration of a
+ * single channel per readout.
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  void
+ */
+void initialize_adc_sequence(void);
+
+/*
+ * Converts all channels in one sequence and averages their samples. Sleeps in LPM0 during the conversion, which takes
+ * adc_sequence_cycles(ADC_SAMPLE_CYCLES, ADC_SEQUENCE_SLOTS) ADC12CLK cycles.
+ *
+ * Parameters:
+ *  Adc_snapshot *snapshot: filled with the results
+ *
+ * Returns:
+ *  bool: false if the conversion failed, the snapshot is then not valid
+ */
+bool adc_snapshot(Adc_snapshot *snapshot);
+
+/*
+ * Converts the result of a channel in a snapshot to a voltage in millivolts, without a float (see
+ * sensor_fixed_point.h).
+ *
+ * Parameters:
+ *  const Adc_snapshot *snapshot: snapshot
+ *  Adc_channel channel: channel
+ *
+ * Returns:
+ *  uint16_t: voltage of the channel in mV, SENSOR_MILLIVOLTS_ERROR when the snapshot is not valid
+ */
+uint16_t adc_snapshot_millivolts(const Adc_snapshot *snapshot, Adc_channel channel);
+
+/*
+ * Starts the continuous monitoring of all channels, after initialize_adc_sequence() and start_system_tick().
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  void
+ */
+void adc_monitor_start(void);
+
+/*
+ * Stops the continuous monitoring of all channels.
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  void
+ */
+void adc_monitor_stop(void);
+
+/*
+ * Checks whether a channel left or reentered its window since the previous report.
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  bool: true if adc_monitor_report() has something to send
+ */
+bool adc_monitor_pending(void);
+
+/*
+ * Sends the channels that left or reentered their window to the lander, an event with the voltage of the channel.
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  void
+ */
+void adc_monitor_report(void);
+
+/*
+ * Handles an interrupt of the window comparator, called from ADC12_ISR.
+ *
+ * Parameters:
+ *  Adc_window_state state: ADC_WINDOW_ABOVE for ADC12HIIFG, ADC_WINDOW_BELOW for ADC12LOIFG, ADC_WINDOW_INSIDE for
+ *                          ADC12INIFG
+ *
+ * Returns:
+ *  bool: true if the CPU has to wake up
+ */
+bool adc_monitor_comparator_isr(Adc_window_state state);
+
+/*
+ * Ends the sequence that is converting, called from ADC12_ISR.
+ *
+ * Parameters:
+ *  bool failed: true when the conversion failed
+ *
+ * Returns:
+ *  void
+ */
+void adc_sequence_done_isr(bool failed);
+
+#endif // ADC_MANAGER_H
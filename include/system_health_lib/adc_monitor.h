@@ -0,0 +1,141 @@
+/*
+ * adc_monitor.h
+ *
+ * This header file contains the continuous monitoring of the analog channels of the RDS. Between the readouts of the
+ * ECCS the ADC12 converts every channel periodically without the CPU, and the DMA writes the results of every channel
+ * into a ring of its own (see adc_manager.h for the hardware):
+ *
+ *  - Every channel has a window of limits. One channel is checked on every sample by the window comparator of the
+ *    ADC12, its interrupt comes only when the channel leaves or reenters its window. The other channels are checked
+ *    when their ring is full, once per ADC_MONITOR_RING_LENGTH samples.
+ *  - A channel is above its window if a sample is above the high limit, below if a sample is below the low limit and
+ *    inside otherwise. A change of the state of a channel is kept until the main code takes it, the CPU only has to
+ *    wake up for a change.
+ *  - The comparator only interrupts for the states the channel is not in, such that a channel that stays out of its
+ *    window does not interrupt on every sample.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef ADC_MONITOR_H
+#define ADC_MONITOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Channels that can be monitored, every channel needs a DMA channel and the MSP430FR5969 has 3
+#define ADC_MONITOR_MAX_CHANNELS 3
+
+// Samples in the ring of every channel
+#define ADC_MONITOR_RING_LENGTH 32
+
+// Interrupts of the window comparator, see adc_monitor_comparator_enables()
+#define ADC_MONITOR_IE_BELOW 0x01
+#define ADC_MONITOR_IE_ABOVE 0x02
+#define ADC_MONITOR_IE_INSIDE 0x04
+
+// Limits of a channel in ADC counts, a sample is inside the window if low <= sample <= high
+typedef struct {
+    uint16_t low;
+    uint16_t high;
+} Adc_window;
+
+typedef enum {
+    ADC_WINDOW_INSIDE,
+    ADC_WINDOW_BELOW,
+    ADC_WINDOW_ABOVE
+} Adc_window_state;
+
+typedef struct {
+    Adc_window window[ADC_MONITOR_MAX_CHANNELS];
+    uint8_t channel_count;
+    uint8_t comparator_channel;                     // channel checked by the window comparator
+    Adc_window_state state[ADC_MONITOR_MAX_CHANNELS];
+    uint16_t value[ADC_MONITOR_MAX_CHANNELS];       // sample that changed the state, the extreme of the ring
+    volatile uint8_t changed;                       // bit per channel whose state changed and was not taken yet
+    uint16_t rings;                                 // full rings
+    uint16_t wakeups;                               // changes that woke the CPU
+} Adc_monitor;
+
+/*
+ * Initializes the monitor, all channels start inside their window.
+ *
+ * Parameters:
+ *  Adc_monitor *monitor: monitor
+ *  const Adc_window *windows: window of every channel
+ *  uint8_t channel_count: amount of channels, at most ADC_MONITOR_MAX_CHANNELS
+ *  uint8_t comparator_channel: channel checked by the window comparator
+ *
+ * Returns:
+ *  bool: false if the amount of channels or the comparator channel is not valid
+ */
+bool adc_monitor_init(Adc_monitor *monitor, const Adc_window *windows, uint8_t channel_count,
+                      uint8_t comparator_channel);
+
+/*
+ * Returns the state of a sample in a window.
+ *
+ * Parameters:
+ *  const Adc_window *window: window
+ *  uint16_t sample: sample in ADC counts
+ *
+ * Returns:
+ *  Adc_window_state: state of the sample
+ */
+Adc_window_state adc_window_check(const Adc_window *window, uint16_t sample);
+
+/*
+ * Returns the interrupts of the window comparator for the state of the comparator channel, the interrupts of the
+ * other states.
+ *
+ * Parameters:
+ *  const Adc_monitor *monitor: monitor
+ *
+ * Returns:
+ *  uint8_t: ADC_MONITOR_IE_* bits
+ */
+uint8_t adc_monitor_comparator_enables(const Adc_monitor *monitor);
+
+/*
+ * Handles an interrupt of the window comparator, called from the ADC12 interrupt.
+ *
+ * Parameters:
+ *  Adc_monitor *monitor: monitor
+ *  Adc_window_state state: state of the interrupt, ADC12HIIFG is above, ADC12LOIFG below and ADC12INIFG inside
+ *  uint16_t sample: result of the comparator channel
+ *
+ * Returns:
+ *  bool: true if the state changed, the CPU has to wake up
+ */
+bool adc_monitor_comparator_event(Adc_monitor *monitor, Adc_window_state state, uint16_t sample);
+
+/*
+ * Checks the rings of the channels that are not checked by the comparator, called from the DMA interrupt when the
+ * rings are full.
+ *
+ * Parameters:
+ *  Adc_monitor *monitor: monitor
+ *  const volatile uint16_t *rings: ADC_MONITOR_RING_LENGTH samples of every channel, one ring after the other
+ *
+ * Returns:
+ *  bool: true if the state of a channel changed, the CPU has to wake up
+ */
+bool adc_monitor_ring_full(Adc_monitor *monitor, const volatile uint16_t *rings);
+
+/*
+ * Takes the channels whose state changed since the previous call, their state and value are in the monitor. Has to be
+ * called with the interrupts of the monitor disabled.
+ *
+ * Parameters:
+ *  Adc_monitor *monitor: monitor
+ *
+ * Returns:
+ *  uint8_t: bit per channel whose state changed
+ */
+uint8_t adc_monitor_take_changes(Adc_monitor *monitor);
+
+#endif // ADC_MONITOR_H
@@ -0,0 +1,98 @@
+/*
+ * adc_sequence.h
+ *
+ * This header file contains the layout of the ADC12 conversion sequence of the RDS. All analog channels are converted
+ * in one sequence-of-channels conversion, every sample in an ADC12MEMx slot of its own:
+ *
+ *  - The channels are converted in the order of their table, a channel with an oversampling of n takes n consecutive
+ *    slots. With ADC12MSC set the ADC converts the slots back to back without the CPU, and only the last slot
+ *    interrupts.
+ *  - The ADC12_B of the MSP430FR5969 has no averaging of its own, so the samples of an oversampled channel are averaged
+ *    once when the sequence is done. The oversampling is a power of 2, such that the average is a shift.
+ *  - The conversion time of the sequence is known from the sample time and the amount of slots.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef ADC_SEQUENCE_H
+#define ADC_SEQUENCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ADC12MEM0 up to ADC12MEM31
+#define ADC_SEQUENCE_MAX_SLOTS 32
+
+// Largest oversampling of a channel, 16 samples of 12 bits still add up within 16 bits
+#define ADC_SEQUENCE_MAX_OVERSAMPLING 16
+
+// Highest analog input, A0 up to A31
+#define ADC_SEQUENCE_MAX_INPUT 31
+
+// ADC12CLK cycles of a 12-bit conversion after the sample time
+#define ADC_SEQUENCE_CONVERSION_CYCLES 14
+
+// Channel of the sequence
+typedef struct {
+    uint8_t input;              // analog input, e.g. 7 for A7
+    uint8_t oversampling;       // samples that are averaged, 1, 2, 4, 8 or 16
+} Adc_channel_config;
+
+/*
+ * Checks a channel table: every oversampling is a power of 2 of at most ADC_SEQUENCE_MAX_OVERSAMPLING, every input
+ * exists and the samples fit in the ADC12MEMx slots.
+ *
+ * Parameters:
+ *  const Adc_channel_config *channels: channel table in conversion order
+ *  uint8_t channel_count: amount of channels, at least 1
+ *
+ * Returns:
+ *  bool: true if the table is valid
+ */
+bool adc_sequence_valid(const Adc_channel_config *channels, uint8_t channel_count);
+
+/*
+ * Fills in the analog input of every slot of the sequence.
+ *
+ * Parameters:
+ *  const Adc_channel_config *channels: valid channel table in conversion order
+ *  uint8_t channel_count: amount of channels
+ *  uint8_t *slot_inputs: analog input of every slot, room for ADC_SEQUENCE_MAX_SLOTS
+ *
+ * Returns:
+ *  uint8_t: amount of slots of the sequence
+ */
+uint8_t adc_sequence_layout(const Adc_channel_config *channels, uint8_t channel_count, uint8_t *slot_inputs);
+
+/*
+ * Averages the samples of every channel of a completed sequence, rounded to the nearest count.
+ *
+ * Parameters:
+ *  const Adc_channel_config *channels: valid channel table in conversion order
+ *  uint8_t channel_count: amount of channels
+ *  const volatile uint16_t *slots: results of the slots, ADC12MEM0 onwards on the MSP430
+ *  uint16_t *results: 12-bit result of every channel
+ *
+ * Returns:
+ *  void
+ */
+void adc_sequence_average(const Adc_channel_config *channels, uint8_t channel_count, const volatile uint16_t *slots,
+                          uint16_t *results);
+
+/*
+ * Returns the conversion time of a sequence in ADC12CLK cycles, every slot is sampled and converted once.
+ *
+ * Parameters:
+ *  uint16_t sample_cycles: sample time of a slot in ADC12CLK cycles, 16 for ADC12SHT0_2
+ *  uint8_t slots: amount of slots of the sequence
+ *
+ * Returns:
+ *  uint32_t: ADC12CLK cycles from the trigger to the last result
+ */
+uint32_t adc_sequence_cycles(uint16_t sample_cycles, uint8_t slots);
+
+#endif // ADC_SEQUENCE_H
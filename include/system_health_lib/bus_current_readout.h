@@ -30,17 +30,6 @@
  */
 void initialize_bus_current_sense_pin(void);
 
-/*
- * Initializes the ADC for bus current sensing.
- *
- * Parameters:
- *  None
- *
- * Returns:
- *  void
- */
-void initialize_adc_bus_sense(void);
-
 /*
  * Initializes pin 4.2 as an output pin for bus flag.
  *
@@ -76,40 +65,15 @@ void switch_off_bus_flag_pin(void);
 
 
 /*
- * Reads the voltage from the bus current sense pin via ADC.
+ * Reads the voltage from the bus current sense pin via ADC, from a snapshot of all channels (see adc_manager.h).
  *
  * Parameters:
  *  None
  *
  * Returns:
- *  float : the measured voltage
+ *  uint16_t : the measured voltage in mV, SENSOR_MILLIVOLTS_ERROR when the conversion failed
  */
-float voltage_adc_bus_sense(void);
-
+uint16_t millivolts_adc_bus_sense(void);
 
-/*
- * Converts a float to a uint8_t array.
- *
- * Parameters:
- *  float value : the float value to convert
- *  uint8_t* array : pointer to the array where the converted values will be stored
- *  size_t n : length of the array (should be at least 4 to store the float)
- *
- * Returns:
- *  void
- */
-void float_to_uint8_array(float value, uint8_t* array, size_t n);
-
-/*
- * Converts a float to a uint8_t array with 7 digits.
- *
- * Parameters:
- *  float value : the float value to convert
- *  uint8_t* array : pointer to the array where the converted values will be stored
- *
- * Returns:
- *  void
- */
-void float_to_uint8_array_2(float value, uint8_t* array);
 
 #endif // BUS_CURRENT_READOUT_H
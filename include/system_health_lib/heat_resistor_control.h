@@ -18,6 +18,16 @@
 #include "lander_communication_lib/lander_communication.h"
 #include "lander_communication_lib/payload_messages.h"
 #include "system_health_lib/bus_current_readout.h"
+#include "system_health_lib/sensor_fixed_point.h"
+
+// The heater switches on below 20 and off above 40 degrees Celsius, in 0.01 degrees Celsius
+#define HEATER_ON_BELOW_CENTIDEGREES 2000
+#define HEATER_OFF_ABOVE_CENTIDEGREES 4000
+
+// The same thresholds as periods of a temperature sensor, computed at compile time: a temperature below 20 degrees
+// Celsius is a period below HEATER_ON_BELOW_PERIOD, one above 40 degrees Celsius a period from HEATER_OFF_FROM_PERIOD
+static constexpr uint16_t HEATER_ON_BELOW_PERIOD = centidegrees_to_period(HEATER_ON_BELOW_CENTIDEGREES);
+static constexpr uint16_t HEATER_OFF_FROM_PERIOD = centidegrees_to_period(HEATER_OFF_ABOVE_CENTIDEGREES + 1);
 
 /*
  * Initializes the pins for controlling the heat resistors.
@@ -86,38 +96,38 @@ void MCU_heaterOn_high(void);
 bool is_heater_on(void);
 
 /*
- * Controls the heat resistors based on two temperature readings.
+ * Controls the heat resistors based on the periods of both temperature sensors and sends their temperatures.
  *
  * Parameters:
- *  float temperature1 : temperature from sensor 1
- *  float temperature2 : temperature from sensor 2
+ *  uint16_t period1 : median period of sensor 1 in capture ticks, out of the range of period_is_valid() if broken
+ *  uint16_t period2 : median period of sensor 2 in capture ticks, out of the range of period_is_valid() if broken
  *
  * Returns:
  *  void
  */
-void heat_resistor_control(float temperature1, float temperature2);
+void heat_resistor_control(uint16_t period1, uint16_t period2);
 
 /*
- * Controls the heat resistor based on one temperature reading.
+ * Controls the heat resistor based on the period of one temperature sensor.
  *
  * Parameters:
- *  float temperature : temperature from the sensor
+ *  uint16_t period : valid period of the sensor in capture ticks
  *
  * Returns:
  *  void
  */
-void heat_resistor_control_one_sensor(float temperature);
+void heat_resistor_control_one_sensor(uint16_t period);
 
 /*
- * Controls the heat resistors based on two temperature readings.
+ * Controls the heat resistors based on the periods of two temperature sensors.
  *
  * Parameters:
- *  float temperature1 : temperature from sensor 1
- *  float temperature2 : temperature from sensor 2
+ *  uint16_t period1 : valid period of sensor 1 in capture ticks
+ *  uint16_t period2 : valid period of sensor 2 in capture ticks
  *
  * Returns:
  *  void
  */
-void heat_resistor_control_two_sensors(float temperature1, float temperature2);
+void heat_resistor_control_two_sensors(uint16_t period1, uint16_t period2);
 
 #endif // HEAT_RESISTOR_CONTROL_H
@@ -0,0 +1,101 @@
+/*
+ * low_power.h
+ *
+ * This header file contains the function declarations and macros of low_power.cpp, the low-power wait of the RDS.
+ * Instead of spinning at 16 MHz until an interrupt sets a flag, the CPU sleeps in LPM0 and the interrupt that sets the
+ * flag wakes it up with LOW_POWER_WAKE_ON_EXIT(). LPM0 only stops MCLK, SMCLK keeps the UART, the timers and the ADC
+ * running.
+ *
+ * The interrupts that wake the CPU are the 1 ms system tick (TA0), which also runs the software timers of
+ * soft_timer.h, the UART (a received frame, a receive error or a sent byte), the ADC12, the captures of the
+ * temperature sensors on TB0 and the ADC monitor (a channel that left or reentered its window, see adc_manager.h).
+ *
+ * The time the CPU is awake is measured per transit mode with the 1 MHz count of TA0. Every minute, and when the
+ * transit mode changes, the fraction is sent to the lander as the MEASUREMENT_CPU_ACTIVE_* measurement of the mode.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef LOW_POWER_H
+#define LOW_POWER_H
+
+#include <msp430.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lander_communication_lib/lander_communication_protocol.h"
+
+// Low-power mode of the waits, LPM0 keeps SMCLK running for the UART, the timers and the ADC
+#define LOW_POWER_MODE_BITS LPM0_bits
+
+// Number of transit modes that are measured, indexed by transit_states
+#define LOW_POWER_MODE_COUNT (DEPLOYMENT + 1)
+
+// Length of a measurement of the active fraction, in microseconds
+#define LOW_POWER_REPORT_PERIOD_US 60000000UL
+
+// Used at the end of an interrupt service routine that sets a flag the main code may be waiting for. It clears the
+// low-power bits in the status register that is restored when the ISR returns, so the CPU stays awake.
+#define LOW_POWER_WAKE_ON_EXIT() __bic_SR_register_on_exit(LPM4_bits)
+
+// Sleeps until the condition is true. The condition is checked with interrupts disabled, such that an interrupt that
+// makes it true cannot slip in between the check and going to sleep. The condition has to be made true by an ISR that
+// uses LOW_POWER_WAKE_ON_EXIT(), or by the 1 ms system tick.
+#define LOW_POWER_WAIT_UNTIL(condition)     \
+    do {                                    \
+        __disable_interrupt();              \
+        while (!(condition)) {              \
+            low_power_sleep();              \
+        }                                   \
+        __enable_interrupt();               \
+    } while (0)
+
+/*
+ * Starts measuring the active time of the CPU, after start_system_tick() and uart_configure().
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  void
+ */
+void low_power_init(void);
+
+/*
+ * Enters LOW_POWER_MODE_BITS until the next interrupt that wakes the CPU. It has to be called with interrupts
+ * disabled and returns with interrupts disabled, use LOW_POWER_WAIT_UNTIL() instead of calling it directly.
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  void
+ */
+void low_power_sleep(void);
+
+/*
+ * Sends the active fraction of the transit modes whose measurement finished since the previous call. Called at the end
+ * of every task step by process_received_data().
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  void
+ */
+void low_power_report(void);
+
+/*
+ * Returns the fraction of the time the CPU was awake in a transit mode, over every finished measurement since boot.
+ *
+ * Parameters:
+ *  transit_states mode: transit mode
+ *
+ * Returns:
+ *  uint16_t: active time in 1/1000 of the time in the mode, 0 if the mode has no finished measurement yet
+ */
+uint16_t low_power_active_per_mille(transit_states mode);
+
+#endif // LOW_POWER_H
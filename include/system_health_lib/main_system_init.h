@@ -16,10 +16,13 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "system_health_lib/soft_timer.h"
+
+// Milliseconds since start_system_tick, wraps around every 65.5 seconds
+extern volatile uint16_t system_ticks_ms;
+// Software timers on the system tick, see soft_timer.h
+extern Soft_timer_list system_timers;
 
-// External global variable to indicate if a timeout occurred
-extern volatile bool timeoutOccurred;
-extern volatile unsigned int timeoutCounterTA3;
 /*
  * Initializes everything of the RDS.
  *
@@ -31,17 +34,6 @@ extern volatile unsigned int timeoutCounterTA3;
  */
 void boot_up_initialisation(void);
 
-/*
- * Initializes the general ADC settings.
- *
- * Parameters:
- *  None
- *
- * Returns:
- *  void
- */
-void initialize_adc_general(void);
-
 /*
  * Sets sub main clock (SMCLK) and digitally controlled oscillator (DCO) to 16 MHz.
  *
@@ -54,7 +46,8 @@ void initialize_adc_general(void);
 void setup_SMCLK(void);
 
 /*
- * Starts the timeout timer TA2.
+ * Starts the 1 ms system tick on timer TA0, used for the retransmission timers of the lander link and the software
+ * timers of system_timers.
  *
  * Parameters:
  *  None
@@ -62,40 +55,44 @@ void setup_SMCLK(void);
  * Returns:
  *  void
  */
-void startTimeoutTimer_TA2(void);
+void start_system_tick(void);
 
 /*
- * Stops the timeout timer TA2.
+ * Returns the current system tick. Differences between two ticks are wrap-safe when calculated as uint16_t.
  *
  * Parameters:
  *  None
  *
  * Returns:
- *  void
+ *  uint16_t: milliseconds since start_system_tick
  */
-void stopTimeoutTimer_TA2(void);
+uint16_t system_tick_now(void);
 
 /*
- * Starts the timeout timer TA3.
+ * (Re)starts a software timer of system_timers, it expires in the tick interrupt. Can also be called from an
+ * interrupt service routine.
  *
  * Parameters:
- *  None
+ *  Soft_timer *timer: timer that has been initialised with soft_timer_init()
+ *  uint16_t delay_ms: milliseconds until the first expiry, 1 to SOFT_TIMER_MAX_DELAY. The timer expires after at least
+ *                     delay_ms - 1 ms.
+ *  uint16_t period_ms: milliseconds between the following expiries, 0 for a one-shot timer
  *
  * Returns:
- *  void
+ *  bool: false if the delay or period is out of range
  */
-void startTimeoutTimer_TA3(void);
+bool system_timer_start(Soft_timer *timer, uint16_t delay_ms, uint16_t period_ms);
 
 /*
- * Stops the timeout timer TA3.
+ * Stops a software timer of system_timers. A timer on the stack has to be stopped before the function returns.
  *
  * Parameters:
- *  None
+ *  Soft_timer *timer: timer to stop
  *
  * Returns:
  *  void
  */
-void stopTimeoutTimer_TA3(void);
+void system_timer_stop(Soft_timer *timer);
 
 /*
  * Setup led light when mcu turns on.
@@ -0,0 +1,167 @@
+/*
+ * nea_sequencer.h
+ *
+ * This header file contains the firing sequence of the four NEAs as a state machine that is polled, instead of a loop
+ * that waits 3 minutes per attempt and only looks at the lander when the whole sequence is over.
+ *
+ * Every NEA goes through the states:
+ *  - CHARGING: the functional supercaps charge for NEA_CHARGE_QUARTERS.
+ *  - FIRING: the NEA flag is high for NEA_FIRE_QUARTERS.
+ *  - VERIFYING: the ready pin is read while the flag is still high, then the flag goes low. A NEA whose ready pin went
+ *    low is released. A NEA that is still ready is tried again, up to NEA_MAX_ATTEMPTS attempts.
+ *  - RETRY: the supercaps charge again for NEA_CHARGE_QUARTERS before the next attempt.
+ * After the last NEA the sequence is DONE. The result of every attempt is reported, and per NEA the amount of attempts
+ * and the time from the start of its first charge to its result.
+ *
+ * An abort switches off every NEA flag and the supercap charge right away and ends the sequence as ABORTED, so the
+ * abort latency is the time until the lander command is handled. A hold keeps the sequence from firing: a NEA that is
+ * charged waits in CHARGING or RETRY until the hold is released, a pulse that is firing is finished.
+ *
+ * The pins are reached through the functions of Nea_sequencer_hardware, and time is given by the caller in quarter
+ * seconds, such that the same code runs on the MSP430 and in the host tests. The NEAs are numbered 0 to 3.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef NEA_SEQUENCER_H
+#define NEA_SEQUENCER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define NEA_COUNT 4
+
+// Charge time before every attempt, 720 times 0.25 seconds is 3 minutes
+#define NEA_CHARGE_QUARTERS 720
+
+// Time the NEA flag is high before the ready pin is read, 0.25 seconds
+#define NEA_FIRE_QUARTERS 1
+
+// Attempts per NEA before it is given up
+#define NEA_MAX_ATTEMPTS 3
+
+// States of the sequence
+typedef enum {
+    NEA_SEQUENCE_IDLE,
+    NEA_SEQUENCE_CHARGING,
+    NEA_SEQUENCE_FIRING,
+    NEA_SEQUENCE_VERIFYING,
+    NEA_SEQUENCE_RETRY,
+    NEA_SEQUENCE_DONE,
+    NEA_SEQUENCE_ABORTED
+} Nea_sequence_state;
+
+// Pins used by the sequence and the reports of its results
+typedef struct {
+    void (*set_charge)(bool on);                // charge flags of the functional supercaps
+    void (*set_fire)(uint8_t nea, bool on);     // NEA flag
+    bool (*read_ready)(uint8_t nea);            // ready pin, true while the NEA has not been released
+    void (*report_attempt)(uint8_t nea, bool ready);    // ready pin after every attempt
+    void (*report_nea)(uint8_t nea, bool released, uint8_t attempts, uint16_t quarters);    // result of a NEA
+} Nea_sequencer_hardware;
+
+// NEA sequencer structure
+typedef struct {
+    const Nea_sequencer_hardware *hardware;
+    Nea_sequence_state state;
+    bool held;
+    uint8_t nea;                        // NEA of the current state
+    uint8_t attempts;                   // attempts of the current NEA
+    uint16_t state_start;               // quarter second at which the current state started
+    uint16_t nea_start;                 // quarter second at which the first charge of the current NEA started
+    bool released[NEA_COUNT];
+    uint8_t nea_attempts[NEA_COUNT];
+    uint16_t nea_quarters[NEA_COUNT];   // time from the first charge to the result of every NEA
+} Nea_sequencer;
+
+/*
+ * Initialises a sequencer that is idle.
+ *
+ * Parameters:
+ *  Nea_sequencer *sequencer: sequencer to initialise
+ *  const Nea_sequencer_hardware *hardware: pins and reports
+ *
+ * Returns:
+ *  void
+ */
+void nea_sequencer_init(Nea_sequencer *sequencer, const Nea_sequencer_hardware *hardware);
+
+/*
+ * Starts the sequence with the first NEA, the supercaps start charging. The hold is released.
+ *
+ * Parameters:
+ *  Nea_sequencer *sequencer: sequencer
+ *  uint16_t now: current time in quarter seconds
+ *
+ * Returns:
+ *  void
+ */
+void nea_sequencer_start(Nea_sequencer *sequencer, uint16_t now);
+
+/*
+ * Moves the sequence on as far as the time allows. Does not wait, it can be polled as often as wanted.
+ *
+ * Parameters:
+ *  Nea_sequencer *sequencer: sequencer
+ *  uint16_t now: current time in quarter seconds
+ *
+ * Returns:
+ *  bool: true when the sequence is DONE or ABORTED
+ */
+bool nea_sequencer_poll(Nea_sequencer *sequencer, uint16_t now);
+
+/*
+ * Aborts a running sequence: every NEA flag and the supercap charge are switched off right away.
+ *
+ * Parameters:
+ *  Nea_sequencer *sequencer: sequencer
+ *
+ * Returns:
+ *  bool: true if a running sequence was aborted, false if it was idle, done or aborted already
+ */
+bool nea_sequencer_abort(Nea_sequencer *sequencer);
+
+/*
+ * Holds or releases the sequence, a held sequence does not start the next firing.
+ *
+ * Parameters:
+ *  Nea_sequencer *sequencer: sequencer
+ *  bool held: true to hold, false to continue
+ *
+ * Returns:
+ *  void
+ */
+void nea_sequencer_hold(Nea_sequencer *sequencer, bool held);
+
+/*
+ * Converts the time of a NEA to the whole seconds that are reported in the telemetry, rounded. A NEA that needs
+ * NEA_MAX_ATTEMPTS attempts takes more than 540 seconds, which does not fit in an int16_t in hundredths of a second.
+ *
+ * Parameters:
+ *  uint16_t quarters: time in quarter seconds
+ *
+ * Returns:
+ *  int16_t: time in seconds
+ */
+int16_t nea_sequencer_seconds(uint16_t quarters);
+
+/*
+ * Returns whether the sequence is running, from CHARGING up to RETRY.
+ *
+ * Parameters:
+ *  const Nea_sequencer *sequencer: sequencer
+ *
+ * Returns:
+ *  bool: true while the sequence runs
+ */
+static inline bool nea_sequencer_running(const Nea_sequencer *sequencer)
+{
+    return sequencer->state != NEA_SEQUENCE_IDLE && sequencer->state != NEA_SEQUENCE_DONE &&
+           sequencer->state != NEA_SEQUENCE_ABORTED;
+}
+
+#endif // NEA_SEQUENCER_H
@@ -0,0 +1,86 @@
+/*
+ * period_capture.h
+ *
+ * This header file contains the period measurement of a temperature sensor from the captures of its oscillator. The
+ * capture interrupt of the timer hands every rising edge to period_capture_edge(), which keeps the time between
+ * consecutive edges until PERIOD_CAPTURE_COUNT periods are known. Both sensors are captured at the same time, each by
+ * a channel of its own, and the median of the periods of every sensor is taken when they are done.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef PERIOD_CAPTURE_H
+#define PERIOD_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Periods of a measurement, the median is the middle one
+#define PERIOD_CAPTURE_COUNT 9
+
+// Value of a period that was not captured before the timeout, like the former timeout of a single period. The median
+// is only valid when more than half of the periods were captured.
+#define PERIOD_CAPTURE_MISSING 1
+
+// Period measurement of one sensor
+typedef struct {
+    uint16_t periods[PERIOD_CAPTURE_COUNT];     // timer ticks between consecutive rising edges
+    uint16_t last_edge;                         // capture of the previous edge
+    uint8_t count;                              // periods captured
+    bool started;                               // the first edge was captured
+} Period_capture;
+
+/*
+ * Starts a new measurement, the next edge is the start of the first period.
+ *
+ * Parameters:
+ *  Period_capture *capture: measurement
+ *
+ * Returns:
+ *  void
+ */
+void period_capture_start(Period_capture *capture);
+
+/*
+ * Handles a rising edge, called from the capture interrupt. The timer is 16 bits, a period has to be shorter than the
+ * time the timer takes to wrap around.
+ *
+ * Parameters:
+ *  Period_capture *capture: measurement
+ *  uint16_t edge: capture of the edge
+ *
+ * Returns:
+ *  bool: true if the measurement is done, the capture interrupt can be switched off
+ */
+bool period_capture_edge(Period_capture *capture, uint16_t edge);
+
+/*
+ * Checks whether all periods of a measurement are captured.
+ *
+ * Parameters:
+ *  const Period_capture *capture: measurement
+ *
+ * Returns:
+ *  bool: true if the measurement is done
+ */
+static inline bool period_capture_done(const Period_capture *capture) {
+    return capture->count >= PERIOD_CAPTURE_COUNT;
+}
+
+/*
+ * Returns the median of the periods, the periods that were not captured count as PERIOD_CAPTURE_MISSING. The median is
+ * taken by the median network of sensor_filters.h.
+ *
+ * Parameters:
+ *  const Period_capture *capture: measurement
+ *
+ * Returns:
+ *  uint16_t: median period in timer ticks
+ */
+uint16_t period_capture_median(const Period_capture *capture);
+
+#endif // PERIOD_CAPTURE_H
@@ -0,0 +1,138 @@
+/*
+ * scheduler.h
+ *
+ * This header file contains the cooperative task scheduler of the RDS. The work of the transit modes is split in short
+ * tasks that run to completion, such that a received command never waits longer than the longest task step.
+ *
+ *  - A periodic task is released every period ticks, an event task is released by scheduler_signal().
+ *  - The tasks are kept in a table in order of priority, the first released task of the table runs next.
+ *  - Every task has a set of transit modes in which it is enabled. A transit mode is a task set: scheduler_set_mode()
+ *    enables the tasks of the new mode and disables the others.
+ *  - A task that finishes later than its deadline after its release is an overrun, as is a periodic task without a
+ *    deadline that is released again before it ran. Overruns are counted per task and handed to the overrun function
+ *    of the scheduler. Periods that pass completely while a task waits are skipped, not queued.
+ *  - Per task the worst latency (release to start) and worst response time (release to end) are kept.
+ *
+ * Time is read through the clock function given to scheduler_init(), system_tick_now() on the MSP430 and a simulated
+ * clock in the host tests. Ticks are 16-bit, so periods and deadlines are at most SCHEDULER_MAX_PERIOD ticks. The
+ * scheduler runs in the main loop only, it is not called from interrupts.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Longest period and deadline in ticks, such that ticks can be compared across the wrap-around of the 16-bit tick
+#define SCHEDULER_MAX_PERIOD 0x7FFF
+
+// Bit of a transit mode in the modes of a task, SCHEDULER_ALL_MODES for a task that is always enabled
+#define SCHEDULER_MODE(mode) ((uint8_t)(1u << (mode)))
+#define SCHEDULER_ALL_MODES 0xFF
+
+typedef struct Task Task;
+typedef struct Scheduler Scheduler;
+
+// Runs one step of a task, it has to return within the deadline of the task
+typedef void (*Task_function)(Task *task);
+
+// Reads the current tick
+typedef uint16_t (*Scheduler_clock_function)(void);
+
+// Called after a task overran its deadline or missed a release
+typedef void (*Scheduler_overrun_function)(Scheduler *scheduler, Task *task);
+
+// Statistics of a task, the counters wrap around at 65535
+typedef struct {
+    uint16_t runs;
+    uint16_t overruns;          // runs that ended after the deadline, or releases that came before the previous run
+    uint16_t worst_latency;     // most ticks from a release to the start of the run
+    uint16_t worst_response;    // most ticks from a release to the end of the run
+} Task_statistics;
+
+// Task structure, the first four fields are filled in the task table
+struct Task {
+    Task_function run;
+    uint16_t period;            // ticks between releases, 0 for an event task
+    uint16_t deadline;          // ticks after a release in which the run has to end, 0 for the period
+    uint8_t modes;              // bit n is set when the task is enabled in transit mode n, see SCHEDULER_MODE
+    void *context;              // free for the owner of the task
+
+    bool enabled;
+    bool released;              // waiting to run
+    uint16_t release;           // tick of the waiting release
+    uint16_t next_release;      // tick of the next release of a periodic task
+    Task_statistics statistics;
+};
+
+// Scheduler structure
+struct Scheduler {
+    Task *tasks;                // table in order of priority, the first task has the highest priority
+    uint8_t task_count;
+    uint8_t mode;               // current transit mode
+    Scheduler_clock_function clock;
+    Scheduler_overrun_function overrun;     // NULL when overruns are only counted
+};
+
+/*
+ * Initialises a scheduler, no task is enabled until scheduler_set_mode() is called.
+ *
+ * Parameters:
+ *  Scheduler *scheduler: scheduler to initialise
+ *  Task *tasks: task table in order of priority, run, period, deadline and modes have to be filled
+ *  uint8_t task_count: amount of tasks in the table
+ *  Scheduler_clock_function clock: reads the current tick
+ *  Scheduler_overrun_function overrun: called after every overrun, NULL when overruns are only counted
+ *
+ * Returns:
+ *  bool: false if a period or deadline is larger than SCHEDULER_MAX_PERIOD
+ */
+bool scheduler_init(Scheduler *scheduler, Task *tasks, uint8_t task_count, Scheduler_clock_function clock,
+                    Scheduler_overrun_function overrun);
+
+/*
+ * Switches to the task set of a transit mode. Tasks that are enabled in the mode and were disabled start: periodic
+ * tasks are released right away, event tasks wait for a signal. Tasks of the previous mode that are not enabled in the
+ * new mode are disabled and their waiting release is dropped. Tasks that are enabled in both modes are not affected.
+ *
+ * Parameters:
+ *  Scheduler *scheduler: scheduler
+ *  uint8_t mode: transit mode, 0 to 7
+ *
+ * Returns:
+ *  void
+ */
+void scheduler_set_mode(Scheduler *scheduler, uint8_t mode);
+
+/*
+ * Releases an event task, or a periodic task ahead of its period. Signals that come before the task ran are merged
+ * into one run. Nothing happens when the task is disabled.
+ *
+ * Parameters:
+ *  Scheduler *scheduler: scheduler
+ *  Task *task: task of the scheduler
+ *
+ * Returns:
+ *  void
+ */
+void scheduler_signal(Scheduler *scheduler, Task *task);
+
+/*
+ * Releases the periodic tasks that are due and runs the released task with the highest priority.
+ *
+ * Parameters:
+ *  Scheduler *scheduler: scheduler
+ *
+ * Returns:
+ *  bool: false if no task was released, the main loop can then sleep until the next tick or interrupt
+ */
+bool scheduler_run_next(Scheduler *scheduler);
+
+#endif // SCHEDULER_H
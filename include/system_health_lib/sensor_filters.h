@@ -0,0 +1,399 @@
+/*
+ * sensor_filters.h
+ *
+ * This header file contains the streaming filters of the sensor readouts of the RDS. They are templates on the sample
+ * type and their size, such that everything is known at compile time, nothing is allocated and an integer type of at
+ * most 16 bits (ADC counts, timer ticks, ...) needs no floating point:
+ *
+ *  - filter_sort() and filter_median() run a sorting network of N inputs. The comparators of Batcher's odd-even merge
+ *    sort are generated at compile time and unrolled, the median only keeps the comparators the middle output depends
+ *    on. A median of 9 takes 24 compare-exchanges instead of the 36 of an exchange sort, without any loop or branch
+ *    apart from the exchanges themselves.
+ *  - Running_window keeps the last W samples and gives their median, mean, minimum and maximum.
+ *  - Ema_filter is an exponential moving average with a weight of 1 / 2^SHIFT, kept with FRACTION extra bits.
+ *  - Hampel_filter replaces a sample that deviates from the median of the last W samples by more than K times the
+ *    standard deviation, estimated from the median absolute deviation (MAD), by that median.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef SENSOR_FILTERS_H
+#define SENSOR_FILTERS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Largest amount of inputs of a sorting network
+#define FILTER_NETWORK_MAX_INPUTS 32
+
+// Comparators of the sorting network of FILTER_NETWORK_MAX_INPUTS inputs
+#define FILTER_NETWORK_MAX_COMPARATORS 191
+
+/*
+ * Orders two samples, afterwards a <= b.
+ *
+ * Parameters:
+ *  T &a: first sample, gets the smallest
+ *  T &b: second sample, gets the largest
+ *
+ * Returns:
+ *  void
+ */
+template <typename T>
+static inline void filter_compare_exchange(T &a, T &b) {
+    if (b < a) {
+        T temp = a;
+        a = b;
+        b = temp;
+    }
+}
+
+/*
+ * Generates the comparators of a sorting network at compile time, Batcher's odd-even merge sort of the next power of 2
+ * without the comparators of the inputs beyond n. For a median only the comparators are kept that the middle output
+ * depends on, found backwards from the last comparator.
+ *
+ * Parameters:
+ *  uint8_t n: amount of inputs, at most FILTER_NETWORK_MAX_INPUTS
+ *  bool median: only keep the comparators of output n / 2
+ *  uint8_t *low: filled with the first input of every comparator, NULL to only count them
+ *  uint8_t *high: filled with the second input of every comparator, NULL to only count them
+ *
+ * Returns:
+ *  uint16_t: amount of comparators
+ */
+constexpr uint16_t filter_network_build(uint8_t n, bool median, uint8_t *low, uint8_t *high) {
+    uint8_t all_low[FILTER_NETWORK_MAX_COMPARATORS] = {};
+    uint8_t all_high[FILTER_NETWORK_MAX_COMPARATORS] = {};
+    uint16_t all = 0;
+    for (uint16_t p = 1; p < n; p <<= 1) {
+        for (uint16_t k = p; k >= 1; k >>= 1) {
+            for (uint16_t j = k % p; j + k < n; j += 2 * k) {
+                for (uint16_t i = 0; i < k && i + j + k < n; i++) {
+                    // only merge within the same block of 2p inputs
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        all_low[all] = (uint8_t)(i + j);
+                        all_high[all] = (uint8_t)(i + j + k);
+                        all++;
+                    }
+                }
+            }
+        }
+    }
+
+    bool keep[FILTER_NETWORK_MAX_COMPARATORS] = {};
+    bool needed[FILTER_NETWORK_MAX_INPUTS] = {};
+    needed[n / 2] = true;
+    for (uint16_t c = all; c > 0; c--) {
+        // a comparator is needed when one of its outputs is, then both of its inputs are
+        keep[c - 1] = !median || needed[all_low[c - 1]] || needed[all_high[c - 1]];
+        if (keep[c - 1]) {
+            needed[all_low[c - 1]] = true;
+            needed[all_high[c - 1]] = true;
+        }
+    }
+
+    uint16_t count = 0;
+    for (uint16_t c = 0; c < all; c++) {
+        if (keep[c]) {
+            if (low != nullptr) {
+                low[count] = all_low[c];
+                high[count] = all_high[c];
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+// Comparators of a sorting network of N inputs, or of the median of N inputs
+template <uint8_t N, bool MEDIAN>
+struct Filter_network {
+    static_assert(N >= 1 && N <= FILTER_NETWORK_MAX_INPUTS, "no sorting network of this size");
+
+    enum : uint16_t { size = filter_network_build(N, MEDIAN, nullptr, nullptr) };
+
+    uint8_t low[size > 0 ? size : 1];
+    uint8_t high[size > 0 ? size : 1];
+
+    constexpr Filter_network() : low{}, high{} {
+        filter_network_build(N, MEDIAN, low, high);
+    }
+};
+
+// The network of every size that is used, in the constant data
+template <uint8_t N, bool MEDIAN>
+struct Filter_network_table {
+    static constexpr Filter_network<N, MEDIAN> value{};
+};
+
+template <uint8_t N, bool MEDIAN>
+constexpr Filter_network<N, MEDIAN> Filter_network_table<N, MEDIAN>::value;
+
+// Runs comparator I and the ones after it, unrolled at compile time
+template <typename T, uint8_t N, bool MEDIAN, uint16_t I = 0, bool END = (I >= Filter_network<N, MEDIAN>::size)>
+struct Filter_network_step {
+    static inline void run(T *values) {
+        constexpr uint8_t low = Filter_network_table<N, MEDIAN>::value.low[I];
+        constexpr uint8_t high = Filter_network_table<N, MEDIAN>::value.high[I];
+        filter_compare_exchange(values[low], values[high]);
+        Filter_network_step<T, N, MEDIAN, I + 1>::run(values);
+    }
+};
+
+template <typename T, uint8_t N, bool MEDIAN, uint16_t I>
+struct Filter_network_step<T, N, MEDIAN, I, true> {
+    static inline void run(T *values) {
+        (void)values;
+    }
+};
+
+/*
+ * Sorts N samples in place in ascending order.
+ *
+ * Parameters:
+ *  T *values: N samples
+ *
+ * Returns:
+ *  void
+ */
+template <uint8_t N, typename T>
+static inline void filter_sort(T *values) {
+    Filter_network_step<T, N, false>::run(values);
+}
+
+/*
+ * Finds the median of N samples in place, the other samples are only partly ordered afterwards. For an even N this is
+ * the higher of the two middle samples.
+ *
+ * Parameters:
+ *  T *values: N samples
+ *
+ * Returns:
+ *  T: sample N / 2 of the sorted samples
+ */
+template <uint8_t N, typename T>
+static inline T filter_median_in_place(T *values) {
+    Filter_network_step<T, N, true>::run(values);
+    return values[N / 2];
+}
+
+/*
+ * Finds the median of N samples from a copy, see filter_median_in_place().
+ *
+ * Parameters:
+ *  const T *values: N samples
+ *
+ * Returns:
+ *  T: sample N / 2 of the sorted samples
+ */
+template <uint8_t N, typename T>
+static inline T filter_median(const T *values) {
+    T copy[N];
+    for (uint8_t i = 0; i < N; i++) {
+        copy[i] = values[i];
+    }
+    return filter_median_in_place<N>(copy);
+}
+
+/*
+ * Distance between two samples of at most 16 bits, without an overflow of a signed type.
+ *
+ * Parameters:
+ *  T a: first sample
+ *  T b: second sample
+ *
+ * Returns:
+ *  uint16_t: |a - b|
+ */
+template <typename T>
+static inline uint16_t filter_distance(T a, T b) {
+    return (uint16_t)(a < b ? (int32_t)b - (int32_t)a : (int32_t)a - (int32_t)b);
+}
+
+// Last W samples of a channel. The sum is kept while the samples come in, the other statistics look at all W samples,
+// which is cheap for the small windows of the sensors.
+template <typename T, uint8_t W, typename SUM = int32_t>
+struct Running_window {
+    static_assert(W >= 1 && W <= FILTER_NETWORK_MAX_INPUTS, "no running window of this size");
+
+    T samples[W];       // ring of the samples, not in the order they came in
+    SUM sum;            // sum of the samples in the window
+    uint8_t next;       // index of the oldest sample, which is replaced by the next one
+    uint8_t count;      // samples in the window, W once it is full
+
+    Running_window() {
+        reset();
+    }
+
+    // Empties the window
+    void reset(void) {
+        sum = 0;
+        next = 0;
+        count = 0;
+    }
+
+    // Adds a sample, the oldest sample leaves a full window
+    void push(T sample) {
+        if (count == W) {
+            sum -= samples[next];
+        } else {
+            count++;
+        }
+        samples[next] = sample;
+        sum += sample;
+        next = (uint8_t)(next + 1 == W ? 0 : next + 1);
+    }
+
+    bool full(void) const {
+        return count == W;
+    }
+
+    // Mean of the samples rounded to the nearest, 0 for an empty window
+    T mean(void) const {
+        if (count == 0) {
+            return 0;
+        }
+        SUM half = (SUM)(count / 2);
+        return (T)(sum >= 0 ? (sum + half) / count : (sum - half) / count);
+    }
+
+    // Smallest sample, 0 for an empty window
+    T min(void) const {
+        T result = count ? samples[0] : 0;
+        for (uint8_t i = 1; i < count; i++) {
+            if (samples[i] < result) {
+                result = samples[i];
+            }
+        }
+        return result;
+    }
+
+    // Largest sample, 0 for an empty window
+    T max(void) const {
+        T result = count ? samples[0] : 0;
+        for (uint8_t i = 1; i < count; i++) {
+            if (result < samples[i]) {
+                result = samples[i];
+            }
+        }
+        return result;
+    }
+
+    // Median of the samples, sample count / 2 of the sorted samples. A full window runs the median network, a window
+    // that is still filling up is sorted by insertion.
+    T median(void) const {
+        if (count == W) {
+            return filter_median<W>(samples);
+        }
+        if (count == 0) {
+            return 0;
+        }
+        T sorted[W];
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t j = i;
+            while (j > 0 && samples[i] < sorted[j - 1]) {
+                sorted[j] = sorted[j - 1];
+                j--;
+            }
+            sorted[j] = samples[i];
+        }
+        return sorted[count / 2];
+    }
+};
+
+// Exponential moving average: every sample moves the average 1 / 2^SHIFT of the way to it. The average is kept with
+// FRACTION extra bits, otherwise it would stop up to 2^SHIFT - 1 counts away from a constant input.
+template <typename T, uint8_t SHIFT, uint8_t FRACTION = 8>
+struct Ema_filter {
+    static_assert(sizeof(T) <= 2 && FRACTION <= 15, "the average of 16-bit samples is kept in 32 bits");
+
+    int32_t state;      // average * 2^FRACTION
+    bool started;       // the first sample starts the average
+
+    Ema_filter() {
+        reset();
+    }
+
+    // Forgets the average, the next sample starts over
+    void reset(void) {
+        state = 0;
+        started = false;
+    }
+
+    // Adds a sample and returns the new average
+    T update(T sample) {
+        int32_t target = (int32_t)sample * ((int32_t)1 << FRACTION);
+        if (!started) {
+            state = target;
+            started = true;
+        } else {
+            // a right shift of a negative value is not portable, the step is shifted as a positive value
+            int32_t step = target - state;
+            if (step >= 0) {
+                state += step >> SHIFT;
+            } else {
+                state -= (-step) >> SHIFT;
+            }
+        }
+        return value();
+    }
+
+    // Average rounded to the nearest
+    T value(void) const {
+        const int32_t half = ((int32_t)1 << FRACTION) >> 1;
+        if (state >= 0) {
+            return (T)((state + half) >> FRACTION);
+        }
+        return (T)-((-state + half) >> FRACTION);
+    }
+};
+
+// Outlier rejection of Hampel: a sample is an outlier when its distance to the median m of the last W samples, itself
+// included, is larger than K * 1.4826 * MAD, the standard deviation of normal noise estimated from the median absolute
+// deviation. 1.4826 is taken as 3 / 2. An outlier is replaced by m. On a quiet channel the MAD is 0 and every change
+// would be an outlier, so a distance of at most MIN_DEVIATION never is. A step of the signal passes once it is in more
+// than half of the window.
+template <typename T, uint8_t W, uint16_t MIN_DEVIATION = 0, uint8_t K = 3>
+struct Hampel_filter {
+    static_assert(sizeof(T) <= 2, "the distances of the samples are kept in 16 bits");
+
+    Running_window<T, W> window;    // last W samples as they came in, outliers included
+    uint16_t rejected;              // outliers replaced since the reset
+
+    Hampel_filter() {
+        rejected = 0;
+    }
+
+    // Empties the window, the next W - 1 samples pass as they are
+    void reset(void) {
+        window.reset();
+        rejected = 0;
+    }
+
+    // Adds a sample and returns it, or the median of the window if it is an outlier
+    T update(T sample) {
+        window.push(sample);
+        if (!window.full()) {
+            return sample;
+        }
+        T median = filter_median<W>(window.samples);
+        uint16_t deviations[W];
+        for (uint8_t i = 0; i < W; i++) {
+            deviations[i] = filter_distance(window.samples[i], median);
+        }
+        uint16_t mad = filter_median_in_place<W>(deviations);
+        uint16_t distance = filter_distance(sample, median);
+        if (distance > MIN_DEVIATION && (uint32_t)distance * 2 > (uint32_t)mad * 3 * K) {
+            rejected++;
+            return median;
+        }
+        return sample;
+    }
+};
+
+#endif // SENSOR_FILTERS_H
@@ -0,0 +1,162 @@
+/*
+ * sensor_fixed_point.h
+ *
+ * This header file contains the conversions of the sensor readouts to the units of the telemetry in integers only. The
+ * MSP430FR5969 has no floating point unit, every float multiplication or division is a call into the software floating
+ * point library. The conversions work in the fixed-point units the telemetry already sends (see telemetry.h):
+ *
+ *  - Voltages in millivolts, ADC counts times the full scale of 3640 mV over 4095 counts, as one multiplication with a
+ *    Q16 reciprocal.
+ *  - Frequencies in centihertz, the capture clock over the period as one integer division.
+ *  - Temperatures in centidegrees Celsius. The resistance of the PT1000 is linear in the period of its oscillator, so
+ *    the temperature of a period is one multiplication with a Q15 slope and an offset, without a division or a lookup
+ *    table. From a frequency the temperature is one division and an offset. A temperature threshold is a period at
+ *    compile time, see centidegrees_to_period().
+ *
+ * The constants are computed at compile time from the same physical values as the float conversions the firmware used
+ * before: convert_adc_to_voltage(), calculateFrequency(), frequency_to_temperature() and float_to_uint8_array_2().
+ * Those are only kept in the host tests, as the reference. The results are those of the float conversions of the same
+ * input rounded to the nearest step, within 1 step: 1 mV, 0.01 Hz or 0.01 degrees Celsius.
+ * Below 300 Hz one centihertz is more than one centidegree, a temperature from a period is more precise than one from
+ * its rounded frequency.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef SENSOR_FIXED_POINT_H
+#define SENSOR_FIXED_POINT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 12-bit ADC and its full scale, ADC_MAX_VALUE and MAX_VOLTAGE of supercap_readout.h
+#define SENSOR_ADC_MAX_VALUE 4095
+#define SENSOR_ADC_FULL_SCALE_MILLIVOLTS 3640
+
+// Voltage of a conversion that failed, above every voltage that can be measured, the 99 V of the float readout
+#define SENSOR_MILLIVOLTS_ERROR 0xFFFF
+
+// Clock of the period captures of the temperature sensors, SMCLK / 4
+#define SENSOR_CAPTURE_CLOCK_HZ 4000000UL
+
+// Valid frequencies of the temperature sensors and the periods in capture ticks that belong to them
+#define SENSOR_MIN_FREQUENCY_HZ 150
+#define SENSOR_MAX_FREQUENCY_HZ 800
+#define SENSOR_MAX_PERIOD (SENSOR_CAPTURE_CLOCK_HZ / SENSOR_MIN_FREQUENCY_HZ)
+#define SENSOR_MIN_PERIOD (SENSOR_CAPTURE_CLOCK_HZ / SENSOR_MAX_FREQUENCY_HZ)
+
+// Oscillator of a temperature sensor: f = 1 / (SENSOR_OSCILLATOR_FACTOR * C * R), with the resistance of the PT1000
+// R = SENSOR_RTD_R0_OHM + SENSOR_RTD_OHM_PER_DEGREE * T
+#define SENSOR_OSCILLATOR_FACTOR (0.4055 * 2.0)
+#define SENSOR_OSCILLATOR_CAPACITANCE 0.0000022
+#define SENSOR_RTD_R0_OHM 1000.0
+#define SENSOR_RTD_OHM_PER_DEGREE 3.85
+
+// Temperature of a broken sensor or a frequency out of range, the -99 degrees of the float readout
+#define SENSOR_CENTIDEGREES_ERROR (-9900)
+
+// Centidegrees per capture tick of the period in Q15 and the centidegrees of a period of 0 in Q15: the resistance is
+// the period over (capture clock * factor * C), the temperature is linear in the resistance
+static constexpr uint32_t SENSOR_CENTIDEGREES_PER_TICK_Q15 =
+    (uint32_t)(32768.0 * 100.0 / (SENSOR_RTD_OHM_PER_DEGREE * SENSOR_CAPTURE_CLOCK_HZ * SENSOR_OSCILLATOR_FACTOR *
+                                  SENSOR_OSCILLATOR_CAPACITANCE) + 0.5);
+static constexpr uint32_t SENSOR_CENTIDEGREES_OFFSET_Q15 =
+    (uint32_t)(32768.0 * 100.0 * SENSOR_RTD_R0_OHM / SENSOR_RTD_OHM_PER_DEGREE + 0.5);
+
+/*
+ * Gives the shortest period of which period_to_centidegrees() is at least a temperature, at compile time. The
+ * temperature rises with the period, so a comparison of a temperature with a threshold is the same comparison of the
+ * period with the period of the threshold:
+ *
+ *  period_to_centidegrees(period) >= centidegrees  <=>  period >= centidegrees_to_period(centidegrees)
+ *
+ * for every valid period. Only for positive temperatures, below 0 degrees Celsius the rounding is mirrored.
+ *
+ * Parameters:
+ *  int16_t centidegrees: temperature in 0.01 degrees Celsius, above 0
+ *
+ * Returns:
+ *  uint16_t: period in capture ticks
+ */
+constexpr uint16_t centidegrees_to_period(int16_t centidegrees)
+{
+    return (uint16_t)(((uint32_t)centidegrees * 32768 + SENSOR_CENTIDEGREES_OFFSET_Q15 - 16384 +
+                       SENSOR_CENTIDEGREES_PER_TICK_Q15 - 1) / SENSOR_CENTIDEGREES_PER_TICK_Q15);
+}
+
+/*
+ * Converts an ADC result to a voltage, convert_adc_to_voltage() in millivolts.
+ *
+ * Parameters:
+ *  uint16_t adc_value: ADC result, at most SENSOR_ADC_MAX_VALUE
+ *
+ * Returns:
+ *  uint16_t: voltage in mV
+ */
+uint16_t adc_to_millivolts(uint16_t adc_value);
+
+/*
+ * Converts a period of a temperature sensor to its frequency, calculateFrequency() in centihertz.
+ *
+ * Parameters:
+ *  uint16_t period: period in capture ticks
+ *
+ * Returns:
+ *  uint32_t: frequency in 0.01 Hz, 0 for a period of 0
+ */
+uint32_t period_to_centihertz(uint16_t period);
+
+/*
+ * Converts a frequency of a temperature sensor to its temperature, frequency_to_temperature() in centidegrees.
+ *
+ * Parameters:
+ *  uint32_t centihertz: frequency in 0.01 Hz
+ *
+ * Returns:
+ *  int16_t: temperature in 0.01 degrees Celsius, SENSOR_CENTIDEGREES_ERROR outside of 150 Hz to 800 Hz
+ */
+int16_t centihertz_to_centidegrees(uint32_t centihertz);
+
+/*
+ * Checks whether a period of a temperature sensor belongs to a frequency of 150 Hz to 800 Hz. A sensor that is broken
+ * or timed out gives a period out of this range.
+ *
+ * Parameters:
+ *  uint16_t period: period in capture ticks
+ *
+ * Returns:
+ *  bool: true if the period is SENSOR_MIN_PERIOD to SENSOR_MAX_PERIOD
+ */
+bool period_is_valid(uint16_t period);
+
+/*
+ * Converts a period of a temperature sensor to its temperature, frequency_to_temperature(calculateFrequency()) in
+ * centidegrees, without a division.
+ *
+ * Parameters:
+ *  uint16_t period: period in capture ticks
+ *
+ * Returns:
+ *  int16_t: temperature in 0.01 degrees Celsius, SENSOR_CENTIDEGREES_ERROR outside of SENSOR_MIN_PERIOD to
+ *  SENSOR_MAX_PERIOD
+ */
+int16_t period_to_centidegrees(uint16_t period);
+
+/*
+ * Writes a fixed-point value with 4 decimals in the layout of float_to_uint8_array_2(): "XXX.XXXX", or "-XX.XXXX" for
+ * a negative value, null terminated.
+ *
+ * Parameters:
+ *  int32_t value: value in 0.0001 steps
+ *  uint8_t *array: array of at least 9 characters
+ *
+ * Returns:
+ *  void
+ */
+void fixed_to_uint8_array_2(int32_t value, uint8_t *array);
+
+#endif // SENSOR_FIXED_POINT_H
@@ -0,0 +1,152 @@
+/*
+ * soft_timer.h
+ *
+ * This header file contains the software timers of the RDS. Every timeout of the firmware is a software timer on the
+ * 1 ms system tick of TA0, instead of a Timer_A module of its own. Any number of timers can run at the same time, so
+ * for example the ARQ wait and a temperature capture can both be timed, and the Timer_A modules stay free for
+ * captures and PWM.
+ *
+ *  - A timer is one-shot or periodic. A periodic timer is rescheduled from its previous expiry, so it does not drift
+ *    when the tick is handled late.
+ *  - Every expiry increments the expirations counter of the timer, which can be polled as a flag, and calls the
+ *    callback of the timer when it has one.
+ *  - The running timers are kept in a list sorted on their expiry. A tick only looks at the first timer, so the cost
+ *    of a tick does not depend on how many timers are running.
+ *
+ * Callbacks are called from soft_timer_tick(), on the MSP430 in the interrupt of the system tick. They have to be short
+ * and may start and stop timers, also their own timer.
+ *
+ * Time is given in ticks by the caller, such that the same code runs on the MSP430 and in the host tests. The list is
+ * not protected against interrupts, on the MSP430 the timers of system_timers are started and stopped with
+ * system_timer_start() and system_timer_stop() of main_system_init.h.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef SOFT_TIMER_H
+#define SOFT_TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Longest delay and period in ticks, such that expiries can be compared across the wrap-around of the 16-bit tick
+#define SOFT_TIMER_MAX_DELAY 0x7FFF
+
+typedef struct Soft_timer Soft_timer;
+
+// Called when a timer expires
+typedef void (*Soft_timer_callback)(Soft_timer *timer);
+
+// Software timer structure
+struct Soft_timer {
+    Soft_timer *next;               // next running timer in the list
+    uint16_t expiry;                // tick of the next expiry
+    uint16_t period;                // ticks between expiries, 0 for a one-shot timer
+    bool running;
+    volatile uint16_t expirations;  // expiries since the timer was started, wraps around at 65535
+    Soft_timer_callback callback;   // NULL for a timer that is only polled
+    void *context;                  // free for the owner of the timer
+};
+
+// List of running timers, sorted on their expiry
+typedef struct {
+    Soft_timer *first;
+    uint16_t now;                   // tick of the last soft_timer_tick
+} Soft_timer_list;
+
+/*
+ * Initialises an empty timer list.
+ *
+ * Parameters:
+ *  Soft_timer_list *list: list to initialise
+ *  uint16_t now: current tick
+ *
+ * Returns:
+ *  void
+ */
+void soft_timer_list_init(Soft_timer_list *list, uint16_t now);
+
+/*
+ * Initialises a timer that is not running. A zero-initialised timer, like a static one, is a stopped timer without
+ * callback and does not have to be initialised.
+ *
+ * Parameters:
+ *  Soft_timer *timer: timer to initialise
+ *  Soft_timer_callback callback: called at every expiry, NULL for a timer that is only polled
+ *  void *context: free for the owner of the timer
+ *
+ * Returns:
+ *  void
+ */
+void soft_timer_init(Soft_timer *timer, Soft_timer_callback callback, void *context);
+
+/*
+ * (Re)starts a timer, a running timer is rescheduled. The expirations counter starts at 0.
+ *
+ * Parameters:
+ *  Soft_timer_list *list: list of the timer
+ *  Soft_timer *timer: timer to start
+ *  uint16_t delay: ticks until the first expiry, 1 to SOFT_TIMER_MAX_DELAY. The timer expires at the delay-th
+ *                  soft_timer_tick, so it waits between delay - 1 and delay ticks of time.
+ *  uint16_t period: ticks between the following expiries, 0 for a one-shot timer
+ *
+ * Returns:
+ *  bool: false if the delay or period is out of range, the timer is then not started
+ */
+bool soft_timer_start(Soft_timer_list *list, Soft_timer *timer, uint16_t delay, uint16_t period);
+
+/*
+ * Stops a timer, nothing happens when it is not running. The expirations counter is kept.
+ *
+ * Parameters:
+ *  Soft_timer_list *list: list of the timer
+ *  Soft_timer *timer: timer to stop
+ *
+ * Returns:
+ *  void
+ */
+void soft_timer_stop(Soft_timer_list *list, Soft_timer *timer);
+
+/*
+ * Advances the list to the current tick and handles every timer that expired, in the order of their expiry. Ticks
+ * that were skipped are caught up, a periodic timer then expires once for every period that passed.
+ *
+ * Parameters:
+ *  Soft_timer_list *list: list of the timers
+ *  uint16_t now: current tick
+ *
+ * Returns:
+ *  void
+ */
+void soft_timer_tick(Soft_timer_list *list, uint16_t now);
+
+/*
+ * Returns the ticks until the first running timer expires, for example to know how long the CPU can sleep.
+ *
+ * Parameters:
+ *  const Soft_timer_list *list: list of the timers
+ *
+ * Returns:
+ *  uint16_t: ticks after the last soft_timer_tick, 0 when no timer is running
+ */
+uint16_t soft_timer_next_expiry(const Soft_timer_list *list);
+
+/*
+ * Returns whether a one-shot timer has expired, or a periodic timer has expired at least once since it was started.
+ *
+ * Parameters:
+ *  const Soft_timer *timer: timer
+ *
+ * Returns:
+ *  bool: true if the timer has expired
+ */
+static inline bool soft_timer_expired(const Soft_timer *timer)
+{
+    return timer->expirations != 0;
+}
+
+#endif // SOFT_TIMER_H
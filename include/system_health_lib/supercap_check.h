@@ -0,0 +1,109 @@
+/*
+ * supercap_check.h
+ *
+ * This header file contains the functionality check of the three supercapacitors as a state machine that is polled,
+ * instead of a loop that charges the caps one after the other and waits 2 minutes for every cap.
+ *
+ *  - Up to a given amount of caps charge at the same time, the power budget. With a budget of SUPERCAP_COUNT all caps
+ *    charge together, like the NEA firing sequence does, and the check takes SUPERCAP_CHARGE_QUARTERS once instead
+ *    of three times. A cap that is waiting starts charging as soon as another cap has been checked.
+ *  - A cap that charged for SUPERCAP_CHARGE_QUARTERS is measured right away and its result is reported, so the
+ *    lander gets the result of every cap when it is known instead of after the whole check.
+ *  - The caps share one voltage pin, so the other caps that are charging are taken off their charge flag while a cap
+ *    is measured. A conversion takes microseconds, which does not matter for their charge time.
+ *  - A voltage above SUPERCAP_MAX_MILLIVOLTS, such as the SENSOR_MILLIVOLTS_ERROR of a failed conversion (see
+ *    sensor_fixed_point.h), is not a ready cap. The voltages are in millivolts, such that the check needs no float.
+ *
+ * The pins and the ADC are reached through the functions of Supercap_check_hardware, and time is given by the caller
+ * in quarter seconds, such that the same code runs on the MSP430 and in the host tests.
+ *
+ * The file does not depend on msp430.h such that it can also be compiled and tested on the host.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef SUPERCAP_CHECK_H
+#define SUPERCAP_CHECK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SUPERCAP_COUNT 3
+
+// Charge time of a cap before it is measured, 480 times 0.25 seconds is 2 minutes
+#define SUPERCAP_CHARGE_QUARTERS 480
+
+// A cap is ready when its voltage after charging is above SUPERCAP_READY_MILLIVOLTS and at most SUPERCAP_MAX_MILLIVOLTS
+#define SUPERCAP_READY_MILLIVOLTS 2475
+#define SUPERCAP_MAX_MILLIVOLTS 3640
+
+// Pins and ADC used by the check
+typedef struct {
+    void (*set_charge)(uint8_t cap, bool on);   // charge cap flag of cap 0 to 2
+    void (*set_discharge)(bool on);             // discharge cap flag
+    uint16_t (*measure)(void);                  // voltage of the supercap pin in mV, 0xFFFF when the conversion failed
+    void (*report)(uint8_t cap, bool ready);    // called once per cap when its result is known
+} Supercap_check_hardware;
+
+// State of a cap during the check
+typedef enum {
+    SUPERCAP_WAITING,
+    SUPERCAP_CHARGING,
+    SUPERCAP_CHECKED
+} Supercap_state;
+
+// Supercap check structure
+typedef struct {
+    const Supercap_check_hardware *hardware;
+    uint8_t budget;                             // most caps that charge at the same time
+    Supercap_state state[SUPERCAP_COUNT];
+    uint16_t charge_start[SUPERCAP_COUNT];      // quarter second at which the cap started charging
+    bool ready[SUPERCAP_COUNT];
+    uint8_t checked;                            // caps that have been checked
+} Supercap_check;
+
+/*
+ * Starts the check: all flags are switched off, then the first caps of the budget start charging.
+ *
+ * Parameters:
+ *  Supercap_check *check: check to start
+ *  const Supercap_check_hardware *hardware: pins and ADC
+ *  uint8_t budget: most caps that charge at the same time, 1 to SUPERCAP_COUNT, 0 is taken as 1
+ *  uint16_t now: current time in quarter seconds
+ *
+ * Returns:
+ *  void
+ */
+void supercap_check_start(Supercap_check *check, const Supercap_check_hardware *hardware, uint8_t budget,
+                          uint16_t now);
+
+/*
+ * Measures and reports the caps that charged long enough, and starts the caps that are waiting when the budget allows.
+ * Does not wait, it can be polled as often as wanted.
+ *
+ * Parameters:
+ *  Supercap_check *check: check
+ *  uint16_t now: current time in quarter seconds
+ *
+ * Returns:
+ *  bool: true when all caps have been checked
+ */
+bool supercap_check_poll(Supercap_check *check, uint16_t now);
+
+/*
+ * Returns whether all caps have been checked.
+ *
+ * Parameters:
+ *  const Supercap_check *check: check
+ *
+ * Returns:
+ *  bool: true when all caps have been checked
+ */
+static inline bool supercap_check_done(const Supercap_check *check)
+{
+    return check->checked == SUPERCAP_COUNT;
+}
+
+#endif // SUPERCAP_CHECK_H
@@ -20,6 +20,9 @@
 #include "lander_communication_lib/lander_communication.h"
 #include "lander_communication_lib/payload_messages.h"
 #include "system_health_lib/main_system_init.h"
+#include "system_health_lib/low_power.h"
+#include "system_health_lib/supercap_check.h"
+#include "system_health_lib/adc_manager.h"
 
 extern bool supercap_functionality[3];
 
@@ -27,10 +30,8 @@ extern bool supercap_functionality[3];
 #define ADC_MAX_VALUE        4095      // 12-bit ADC resolution (2^12 - 1)
 #define MAX_VOLTAGE          3.64      // Reference voltage for ADC (measured 3.64 V)
 
-// External global flag for ADC conversion failure
-extern volatile bool adc_conversion_fail;
-extern volatile bool measurement_finished;
-extern volatile unsigned int ADC_capture; // Variable to store ADC result
+// Caps that charge at the same time during the functionality check, the NEA firing sequence charges all caps together
+#define SUPERCAP_CHARGE_BUDGET SUPERCAP_COUNT
 
 
 /*
@@ -61,17 +62,6 @@ void switch_off_discharge_cap_flag(void);
 void initialize_capready(void);
 
 
-/*
- * Initializes the ADC for super capacitors.
- *
- * Parameters:
- *  None
- *
- * Returns:
- *  void
- */
-void initialize_adc_supercaps(void);
-
 /*
  * Converts ADC value to voltage.
  *
@@ -84,18 +74,19 @@ void initialize_adc_supercaps(void);
 //unsigned int read_ADC(void);
 
 /*
- * Initializes interrupts for the ADC for super capacitors.
+ * Gets the voltage of super capacitors via ADC, from a snapshot of all channels (see adc_manager.h).
  *
  * Parameters:
  *  None
  *
  * Returns:
- *  void
+ *  uint16_t : the measured voltage in mV, SENSOR_MILLIVOLTS_ERROR when the conversion failed
  */
-void enable_interrupt_adc(void);
+uint16_t millivolts_adc_supercaps(void);
 
 /*
- * Disables interrupts for the ADC for super capacitors.
+ * Starts the functionality check of the supercapacitors, see supercap_check.h. The caps charge
+ * SUPERCAP_CHARGE_BUDGET at a time, the check has to be polled with supercap_functionality_check_poll().
  *
  * Parameters:
  *  None
@@ -103,39 +94,30 @@ void enable_interrupt_adc(void);
  * Returns:
  *  void
  */
-void disable_interrupt_adc(void);
+void supercap_functionality_check_start(void);
 
 /*
- * Converts ADC value to voltage.
- *
- * Parameters:
- *  volatile unsigned int adc_value : the ADC value to convert
- *
- * Returns:
- *  float : the calculated voltage
- */
-float convert_adc_to_voltage(volatile unsigned int adc_value);
-
-/*
- * Gets the voltage of super capacitors via ADC.
+ * Continues the functionality check of the supercapacitors without waiting. Every cap that has been charged is
+ * measured, its result is stored in supercap_functionality and sent to the lander right away.
  *
  * Parameters:
  *  None
  *
  * Returns:
- *  float : the measured voltage
+ *  bool: true when all supercapacitors have been checked
  */
-float voltage_adc_supercaps(void);
+bool supercap_functionality_check_poll(void);
 
 /*
- * Check the supercapacitor functionality of each supercapacitor
+ * Abandons a functionality check of the supercapacitors that is running, all cap flags are switched off. Nothing
+ * happens when no check is running.
  *
  * Parameters:
  *  None
  *
  * Returns:
- *  None
+ *  void
  */
-void check_supercap_functionality(void);
+void supercap_functionality_check_stop(void);
 
 #endif /* INCLUDE_SYSTEM_HEALTH_LIB_SUPERCAP_READOUT_H_ */
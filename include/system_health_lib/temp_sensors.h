@@ -17,9 +17,20 @@
 #include <stdbool.h>
 
 #include "system_health_lib/main_system_init.h"
+#include "system_health_lib/low_power.h"
+#include "system_health_lib/period_capture.h"
+#include "system_health_lib/sensor_fixed_point.h"
 
-// Define the number of runs for the measurement
-#define numberOfRuns 9
+// Timeout of an acquisition in ms of the system tick: the first edge and PERIOD_CAPTURE_COUNT periods of the slowest
+// valid oscillator (150 Hz)
+#define TEMPERATURE_ACQUISITION_TIMEOUT_MS 70
+
+// Sensors, sensor 1 is captured by TB0CCR3 (P3.4) and sensor 2 by TB0CCR1 (P1.4)
+typedef enum {
+    TEMPERATURE_SENSOR_1,
+    TEMPERATURE_SENSOR_2,
+    TEMPERATURE_SENSOR_COUNT
+} Temperature_sensor;
 
 /*
  * Initializes all the pins used to measure the temperature via oscillation.
@@ -33,18 +44,20 @@
 void initialize_temperature_pins(void);
 
 /*
- * Converts frequency to temperature.
+ * Sets up Timer_B0 related to the temperature pins.
  *
  * Parameters:
- *  float frequency : the frequency to convert to temperature
+ *  None
  *
  * Returns:
- *  float : the calculated temperature
+ *  void
  */
-float frequency_to_temperature(float frequency);
+void setupTimer_B0(void);
 
 /*
- * Sets up Timer_B0 related to the temperature pins.
+ * Starts the acquisition of both temperature sensors. Both oscillators are captured at the same time, every rising
+ * edge interrupts and the periods are kept per sensor (see period_capture.h). The acquisition takes
+ * PERIOD_CAPTURE_COUNT + 1 edges of the slowest sensor, or TEMPERATURE_ACQUISITION_TIMEOUT_MS for a dead sensor.
  *
  * Parameters:
  *  None
@@ -52,51 +65,52 @@ float frequency_to_temperature(float frequency);
  * Returns:
  *  void
  */
-void setupTimer_B0(void);
+void temperature_acquisition_start(void);
 
 /*
- * Calculates frequency from the period.
+ * Checks whether the acquisition of both sensors is done.
  *
  * Parameters:
- *  float period : the period from which to calculate the frequency
+ *  None
  *
  * Returns:
- *  float : the calculated frequency
+ *  bool: true if the periods of both sensors are captured or the acquisition timed out
  */
-float calculateFrequency(float period);
+bool temperature_acquisition_done(void);
 
 /*
- * Reads out the temperature sensor measurements.
+ * Stops the acquisition, also when it is not done. The captures of the sensors no longer interrupt.
  *
  * Parameters:
- *  volatile unsigned int* TxxCCTLx : pointer to Timer B control register
- *  volatile unsigned int* TxxCCRx : pointer to Timer B capture/compare register
+ *  None
  *
  * Returns:
- *  float temperature: the measured temperature
+ *  void
  */
-float readout_temperature_sensor_n(volatile unsigned int* TxxCCTLx, volatile unsigned int* TxxCCRx);
+void temperature_acquisition_stop(void);
 
 /*
- * Reads out the temperature sensor measurements from sensor 1.
+ * Gives the median period of a sensor, after the acquisition is done.
  *
  * Parameters:
- *  None
+ *  Temperature_sensor sensor: sensor
  *
  * Returns:
- *  float temperature: the measured temperature
+ *  uint16_t: the median period in capture ticks, out of the range of period_is_valid() if the frequency is out of
+ *  range or the sensor timed out
  */
-float readout_temperature_sensor_1(void);
+uint16_t temperature_acquisition_period(Temperature_sensor sensor);
 
 /*
- * Reads out the temperature sensor measurements from sensor 2.
+ * Converts the median period of a sensor to its temperature, after the acquisition is done.
  *
  * Parameters:
- *  None
+ *  Temperature_sensor sensor: sensor
  *
  * Returns:
- *  float temperature: the measured temperature
+ *  int16_t: the measured temperature in 0.01 degrees Celsius, SENSOR_CENTIDEGREES_ERROR if the frequency is out of
+ *  range or the sensor timed out
  */
-float readout_temperature_sensor_2(void);
+int16_t temperature_acquisition_result(Temperature_sensor sensor);
 
 #endif /* INCLUDE_SYSTEM_HEALTH_LIB_TEMP_SENSORS_H_ */
@@ -24,24 +24,26 @@
 #include "system_health_lib/main_system_init.h"
 #include "system_health_lib/bus_current_readout.h"
 #include "system_health_lib/ECCS.h"
+#include "system_health_lib/scheduler.h"
 #include "transit_modes_lib/general_startup.h"
 
 // Enumeration for task states
 typedef enum {
     TASK_DEPLOY_SWITCH_OFF_HEATERS,
-    TASK_DEPLOY_CHECK_SUPERCAP_FUNCTIONALITY,
     TASK_DEPLOY_CHECK_ALL_NEAS,
+    TASK_DEPLOY_CHECK_SUPERCAP_FUNCTIONALITY,
     TASK_DEPLOY_COMMUNICATE_DEPLOYMENT_TO_ROVER,
     TASK_DEPLOY_TURN_OFF_ROVER_POWER,
     TASK_DEPLOY_DISCONNECT_UMBILICAL,
     TASK_DEPLOY_ACTIVATE_NEAS,
-    TASK_DEPLOY_DONE
+    TASK_DEPLOY_DONE,
+    TASK_DEPLOY_COMPLETE
 } DeploymentTaskState;
 
 extern DeploymentTaskState deploymentModeTask;
 
 /*
- * deployment mode function for RDSS.
+ * Starts the deployment sequence of RDSS, called when the transit mode changes to DEPLOYMENT.
  *
  * Parameters:
  *  None
@@ -49,7 +51,20 @@ extern DeploymentTaskState deploymentModeTask;
  * Returns:
  *  void
  */
-void deployment_mode(void);
+void deployment_mode_enter(void);
+
+/*
+ * Performs the next step of the deployment sequence, run by the scheduler as a periodic task of DEPLOYMENT (see
+ * transit_tasks.h). The task signals itself for the next step, a step that waits for the supercap check or the NEA
+ * firing sequence returns and is polled again the next period. task->context is its scheduler.
+ *
+ * Parameters:
+ *  Task *task: task of the scheduler
+ *
+ * Returns:
+ *  void
+ */
+void deployment_mode_step(Task *task);
 
 
 #endif // DEPLOYMENT_MODE_H
@@ -23,6 +23,7 @@
 #include "system_health_lib/umbilical_cord.h"
 #include "system_health_lib/main_system_init.h"
 #include "system_health_lib/ECCS.h"
+#include "system_health_lib/scheduler.h"
 
 // Enumeration for task states
 typedef enum {
@@ -37,7 +38,8 @@ typedef enum {
 extern TaskState generalStartupTask;
 
 /*
- * General startup function for RDSS.
+ * Starts the general startup of RDSS, called when the transit mode changes to GENERAL_STARTUP.
+ * Sets up the connection with the lander first.
  *
  * Parameters:
  *  None
@@ -45,7 +47,19 @@ extern TaskState generalStartupTask;
  * Returns:
  *  void
  */
-void general_startup(void);
+void general_startup_enter(void);
+
+/*
+ * Performs the next step of the general startup, run by the scheduler as a periodic task of GENERAL_STARTUP (see
+ * transit_tasks.h).
+ *
+ * Parameters:
+ *  Task *task: task of the scheduler
+ *
+ * Returns:
+ *  void
+ */
+void general_startup_step(Task *task);
 
 /*
  * Sends a transit mode request message.
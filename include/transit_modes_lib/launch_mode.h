@@ -23,11 +23,13 @@
 #include "system_health_lib/umbilical_cord.h"
 #include "system_health_lib/main_system_init.h"
 #include "system_health_lib/ECCS.h"
+#include "system_health_lib/scheduler.h"
 #include "transit_modes_lib/general_startup.h"
 
 
 /*
- * launch mode function for RDSS.
+ * Starts the launch mode of RDSS, called when the transit mode changes to LAUNCH_INTEGRATION.
+ * Sets up the connection with the lander first.
  *
  * Parameters:
  *  None
@@ -35,7 +37,19 @@
  * Returns:
  *  void
  */
-void launch_mode(void);
+void launch_mode_enter(void);
+
+/*
+ * Performs the next step of the launch mode, run by the scheduler as a periodic task of LAUNCH_INTEGRATION (see
+ * transit_tasks.h).
+ *
+ * Parameters:
+ *  Task *task: task of the scheduler
+ *
+ * Returns:
+ *  void
+ */
+void launch_mode_step(Task *task);
 
 
 #endif // LAUNCH_MODE_H
@@ -23,11 +23,12 @@
 #include "system_health_lib/umbilical_cord.h"
 #include "system_health_lib/main_system_init.h"
 #include "system_health_lib/ECCS.h"
+#include "system_health_lib/scheduler.h"
 #include "transit_modes_lib/general_startup.h"
 
 
 /*
- * pre-deployment mode function for RDSS.
+ * Starts the pre-deployment mode of RDSS, called when the transit mode changes to PRE_DEPLOYMENT.
  *
  * Parameters:
  *  None
@@ -35,7 +36,19 @@
  * Returns:
  *  void
  */
-void pre_deployment_mode(void);
+void pre_deployment_mode_enter(void);
+
+/*
+ * Performs the next step of the pre-deployment mode, run by the scheduler as a periodic task of PRE_DEPLOYMENT (see
+ * transit_tasks.h).
+ *
+ * Parameters:
+ *  Task *task: task of the scheduler
+ *
+ * Returns:
+ *  void
+ */
+void pre_deployment_mode_step(Task *task);
 
 
 #endif // PRE_DEPLOYMENT_MODE_H
@@ -23,11 +23,12 @@
 #include "system_health_lib/umbilical_cord.h"
 #include "system_health_lib/main_system_init.h"
 #include "system_health_lib/ECCS.h"
+#include "system_health_lib/scheduler.h"
 #include "transit_modes_lib/general_startup.h"
 
 
 /*
- * transit mode function for RDSS.
+ * Starts the transit mode of RDSS, called when the transit mode changes to TRANSIT.
  *
  * Parameters:
  *  None
@@ -35,7 +36,19 @@
  * Returns:
  *  void
  */
-void transit_mode(void);
+void transit_mode_enter(void);
+
+/*
+ * Performs the next step of the transit mode, run by the scheduler as a periodic task of TRANSIT (see
+ * transit_tasks.h).
+ *
+ * Parameters:
+ *  Task *task: task of the scheduler
+ *
+ * Returns:
+ *  void
+ */
+void transit_mode_step(Task *task);
 
 
 #endif // TRANSIT_MODE_H
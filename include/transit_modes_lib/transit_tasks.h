@@ -0,0 +1,60 @@
+/*
+ * transit_tasks.h
+ *
+ * This header file contains the task sets of the transit modes of RDSS, run by the cooperative scheduler of
+ * scheduler.h. Every transit mode is a set of tasks that is enabled when the lander switches to the mode:
+ *
+ *  - the lander link task (every mode): handles the received messages, the ARQ and the link speed. It has the highest
+ *    priority, it runs every TRANSIT_LINK_TASK_PERIOD_MS and right away when a frame or a receive error comes in.
+ *  - the ADC monitor task (every mode): sends the analog channels that left or reentered their window, see
+ *    adc_manager.h. An event task, signalled when the monitor woke the CPU.
+ *  - the step task of the mode: one step of the mode per run, e.g. one step of the RDS electronics checkup. Periodic
+ *    every TRANSIT_MODE_TASK_PERIOD_MS. The deployment sequence signals itself for its next step and polls the
+ *    supercap check and the NEA firing sequence every TRANSIT_DEPLOYMENT_TASK_PERIOD_MS.
+ *
+ * A received command therefore waits at most for the task step that is running, instead of a whole loop of the mode.
+ * Overruns of a task are reported to the lander with EVENT_TASK_OVERRUN.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef TRANSIT_TASKS_H
+#define TRANSIT_TASKS_H
+
+#include <msp430.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "system_health_lib/scheduler.h"
+
+// Period and deadline of the lander link task in ms, the ARQ timers have a resolution of the period. The deadline
+// covers the longest step of a mode task that can run before it.
+#define TRANSIT_LINK_TASK_PERIOD_MS 5
+#define TRANSIT_LINK_TASK_DEADLINE_MS 200
+
+// Period and deadline of the step tasks of the transit modes in ms. The temperature sensors are captured in the
+// background of the steps, the step that reads them waits in the next periods instead of blocking.
+#define TRANSIT_MODE_TASK_PERIOD_MS 20
+#define TRANSIT_MODE_TASK_DEADLINE_MS 250
+
+// Period of the deployment sequence in ms, the supercap check and the NEA firing sequence count in quarter seconds
+#define TRANSIT_DEPLOYMENT_TASK_PERIOD_MS 250
+
+// Scheduler of the transit modes
+extern Scheduler transit_scheduler;
+
+/*
+ * Runs the task sets of the transit modes, switching task set whenever the transit mode changes. Called by main()
+ * after boot_up_initialisation() and never returns.
+ *
+ * Parameters:
+ *  None
+ *
+ * Returns:
+ *  void
+ */
+void transit_tasks_run(void);
+
+#endif // TRANSIT_TASKS_H
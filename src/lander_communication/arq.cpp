@@ -0,0 +1,303 @@
+/*
+ * arq.cpp file
+ *
+ * This file contains the sliding-window ARQ of the lander link, see arq.h for the frame format and the rules on both
+ * sides of the link.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <lander_communication_lib/arq.h>
+#include <string.h>
+
+/*
+ * Returns the selective ACK bitmap of the receiver, bit 0 is the frame after the next expected one.
+ */
+static inline uint8_t arq_selective_ack(const ARQ_link *link)
+{
+    return (uint8_t)(link->rx_mask >> 1);
+}
+
+/*
+ * Sends (again) the frame with the given sequence number, with the current ACK of the receiver piggybacked.
+ */
+static void arq_transmit(ARQ_link *link, uint8_t seq, uint16_t now)
+{
+    ARQ_tx_slot *slot = &link->tx_slots[seq & ARQ_WINDOW_MASK];
+    uint8_t header[ARQ_HEADER_SIZE];
+    header[0] = seq;
+    header[1] = link->base;
+    header[2] = link->expected;
+    header[3] = arq_selective_ack(link);
+    if (link->config.session & 1) {
+        header[3] |= ARQ_SESSION_BIT;
+    }
+
+    Payload_segment segments[2] = {{header, ARQ_HEADER_SIZE}, {slot->payload, slot->length}};
+    link->send(link, (uint8_t)(slot->msg_type | MSG_TYPE_RELIABLE), segments, 2);
+
+    // a failed send is handled like a lost frame, the timer sends it again
+    slot->sent_at = now;
+    slot->transmissions++;
+    link->ack_pending = false;
+}
+
+/*
+ * Marks a frame as done, the statistics only count frames that were acknowledged by the other side.
+ */
+static inline void arq_mark_acknowledged(ARQ_link *link, uint8_t seq)
+{
+    ARQ_tx_slot *slot = &link->tx_slots[seq & ARQ_WINDOW_MASK];
+    if (!slot->acknowledged) {
+        slot->acknowledged = true;
+        link->statistics.acknowledged++;
+    }
+}
+
+/*
+ * Moves the base of the window past the frames that are done.
+ */
+static void arq_slide_window(ARQ_link *link)
+{
+    while (link->base != link->next_seq && link->tx_slots[link->base & ARQ_WINDOW_MASK].acknowledged) {
+        link->base++;
+    }
+}
+
+/*
+ * Handles the cumulative and selective ACK of the other side.
+ */
+static void arq_process_ack(ARQ_link *link, uint8_t ack, uint8_t selective_ack)
+{
+    uint8_t outstanding = (uint8_t)(link->next_seq - link->base);
+    uint8_t acknowledged = (uint8_t)(ack - link->base);
+
+    // an ACK outside the window is old or comes from before a restart of the other side
+    if (acknowledged > outstanding) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < acknowledged; i++) {
+        arq_mark_acknowledged(link, (uint8_t)(link->base + i));
+    }
+    for (uint8_t i = 0; i < ARQ_WINDOW_MAX - 1; i++) {
+        uint8_t seq = (uint8_t)(ack + 1 + i);
+        if ((selective_ack & (1 << i)) && (uint8_t)(seq - link->base) < outstanding) {
+            arq_mark_acknowledged(link, seq);
+        }
+    }
+    arq_slide_window(link);
+}
+
+/*
+ * Turns a reliable frame into the Message the other side has sent: the ARQ header is removed, the MSG_TYPE_RELIABLE
+ * bit is cleared and the checksum is calculated again such that handle_message accepts it.
+ */
+static void arq_deliver(ARQ_link *link, Message *msg, uint8_t msg_type, uint8_t length)
+{
+    msg->start_byte = MSG_START_BYTE;
+    msg->msg_type = (uint8_t)(msg_type & ~MSG_TYPE_RELIABLE);
+    msg->length = length;
+    msg->checksum = calculate_checksum_helper(msg->msg_type, msg->length, msg->payload);
+    msg->end_byte = MSG_END_BYTE;
+    link->statistics.delivered++;
+    link->deliver(link, msg);
+}
+
+/*
+ * Delivers the buffered frame that is next in line, the message is used as buffer.
+ */
+static void arq_deliver_buffered(ARQ_link *link, Message *msg)
+{
+    const ARQ_rx_slot *slot = &link->rx_slots[link->expected & ARQ_WINDOW_MASK];
+    memcpy(msg->payload, slot->payload, slot->length);
+    link->expected++;
+    link->rx_mask >>= 1;
+    arq_deliver(link, msg, slot->msg_type, slot->length);
+}
+
+/*
+ * Moves the receiver to the base of the sender, the frames in between have been given up by the sender. Frames in
+ * between that are already buffered are still delivered.
+ */
+static void arq_skip_to(ARQ_link *link, Message *msg, uint8_t base)
+{
+    while (link->expected != base) {
+        if (link->rx_mask & 1) {
+            arq_deliver_buffered(link, msg);
+        } else {
+            link->statistics.skipped++;
+            link->expected++;
+            link->rx_mask >>= 1;
+        }
+    }
+}
+
+void arq_init(ARQ_link *link, const ARQ_config *config, ARQ_send_function send, ARQ_deliver_function deliver,
+              void *context)
+{
+    memset(link, 0, sizeof(*link));
+    link->config = *config;
+    if (link->config.window == 0) {
+        link->config.window = 1;
+    } else if (link->config.window > ARQ_WINDOW_MAX) {
+        link->config.window = ARQ_WINDOW_MAX;
+    }
+    link->send = send;
+    link->deliver = deliver;
+    link->context = context;
+}
+
+void arq_reset(ARQ_link *link)
+{
+    while (link->base != link->next_seq) {
+        ARQ_tx_slot *slot = &link->tx_slots[link->base & ARQ_WINDOW_MASK];
+        if (!slot->acknowledged) {
+            slot->acknowledged = true;
+            link->statistics.failed++;
+        }
+        link->base++;
+    }
+}
+
+bool arq_send(ARQ_link *link, uint8_t msg_type, const uint8_t *payload, uint8_t length, uint16_t now)
+{
+    if (length > ARQ_MAX_PAYLOAD_SIZE || arq_outstanding(link) >= link->config.window) {
+        return false;
+    }
+
+    uint8_t seq = link->next_seq++;
+    ARQ_tx_slot *slot = &link->tx_slots[seq & ARQ_WINDOW_MASK];
+    slot->payload = payload;
+    slot->length = length;
+    slot->msg_type = msg_type;
+    slot->transmissions = 0;
+    slot->acknowledged = false;
+    link->statistics.sent++;
+
+    arq_transmit(link, seq, now);
+    return true;
+}
+
+bool arq_is_frame(const Message *msg)
+{
+    return (msg->msg_type & MSG_TYPE_RELIABLE) || msg->msg_type == MSG_TYPE_ARQ_ACK;
+}
+
+void arq_receive(ARQ_link *link, Message *msg, uint16_t now)
+{
+    if (msg->msg_type == MSG_TYPE_ARQ_ACK) {
+        if (msg->length >= ARQ_ACK_SIZE) {
+            arq_process_ack(link, msg->payload[0], msg->payload[1]);
+        }
+        return;
+    }
+    if (!(msg->msg_type & MSG_TYPE_RELIABLE) || msg->length < ARQ_HEADER_SIZE) {
+        return;
+    }
+
+    uint8_t seq = msg->payload[0];
+    uint8_t base = msg->payload[1];
+    uint8_t msg_type = msg->msg_type;
+    uint8_t length = (uint8_t)(msg->length - ARQ_HEADER_SIZE);
+    uint8_t session = (uint8_t)(msg->payload[3] & ARQ_SESSION_BIT);
+    arq_process_ack(link, msg->payload[2], (uint8_t)(msg->payload[3] & ~ARQ_SESSION_BIT));
+
+    // the base of the sender is never more than a window behind or ahead of the receiver, unless it restarted. A
+    // restart shortly after the previous one has its base inside the window, the session bit tells it apart from a
+    // retransmission.
+    uint8_t ahead = (uint8_t)(base - link->expected);
+    uint8_t behind = (uint8_t)(link->expected - base);
+    bool restarted = link->rx_session_known && session != link->rx_session;
+    link->rx_session = session;
+    link->rx_session_known = true;
+    bool skip_later = false;
+    if (restarted || (ahead > ARQ_WINDOW_MAX && behind > ARQ_WINDOW_MAX)) {
+        link->expected = base;
+        link->rx_mask = 0;
+        link->statistics.resynchronisations++;
+    } else if (ahead != 0 && ahead <= ARQ_WINDOW_MAX) {
+        // skipping buffered frames delivers them through msg, which still holds the received frame
+        if (link->rx_mask & ((1 << ahead) - 1)) {
+            skip_later = true;
+        } else {
+            arq_skip_to(link, msg, base);
+        }
+    }
+
+    uint8_t offset = (uint8_t)(seq - link->expected);
+    if (offset == 0) {
+        memmove(msg->payload, &msg->payload[ARQ_HEADER_SIZE], length);
+        link->expected++;
+        link->rx_mask >>= 1;
+        arq_deliver(link, msg, msg_type, length);
+    } else if (offset < ARQ_WINDOW_MAX) {
+        if (link->rx_mask & (1 << offset)) {
+            link->statistics.duplicates++;
+        } else if (length <= ARQ_REORDER_PAYLOAD_SIZE) {
+            ARQ_rx_slot *slot = &link->rx_slots[seq & ARQ_WINDOW_MASK];
+            slot->msg_type = msg_type;
+            slot->length = length;
+            memcpy(slot->payload, &msg->payload[ARQ_HEADER_SIZE], length);
+            link->rx_mask |= (uint8_t)(1 << offset);
+            link->statistics.out_of_order++;
+        } else {}
+    } else if (offset >= 0x80) {
+        // delivered before, the ACK got lost
+        link->statistics.duplicates++;
+    } else {}
+
+    if (skip_later) {
+        arq_skip_to(link, msg, base);
+    }
+    while (link->rx_mask & 1) {
+        arq_deliver_buffered(link, msg);
+    }
+
+    if (!link->ack_pending) {
+        link->ack_pending = true;
+        link->ack_pending_since = now;
+    }
+}
+
+void arq_poll(ARQ_link *link, uint16_t now)
+{
+    for (uint8_t seq = link->base; seq != link->next_seq; seq++) {
+        ARQ_tx_slot *slot = &link->tx_slots[seq & ARQ_WINDOW_MASK];
+        if (slot->acknowledged || (uint16_t)(now - slot->sent_at) < link->config.timeout) {
+            continue;
+        }
+        if (link->config.max_transmissions != 0 && slot->transmissions >= link->config.max_transmissions) {
+            slot->acknowledged = true;
+            link->statistics.failed++;
+        } else {
+            link->statistics.retransmissions++;
+            arq_transmit(link, seq, now);
+        }
+    }
+    arq_slide_window(link);
+
+    if (link->ack_pending && (uint16_t)(now - link->ack_pending_since) >= link->config.ack_delay) {
+        uint8_t ack[ARQ_ACK_SIZE] = {link->expected, arq_selective_ack(link)};
+        Payload_segment segment = {ack, ARQ_ACK_SIZE};
+        if (link->send(link, MSG_TYPE_ARQ_ACK, &segment, 1)) {
+            link->ack_pending = false;
+            link->statistics.acks_sent++;
+        }
+    }
+}
+
+bool arq_is_done(const ARQ_link *link, uint8_t seq)
+{
+    if ((uint8_t)(seq - link->base) >= arq_outstanding(link)) {
+        return true;
+    }
+    return link->tx_slots[seq & ARQ_WINDOW_MASK].acknowledged;
+}
+
+uint8_t arq_outstanding(const ARQ_link *link)
+{
+    return (uint8_t)(link->next_seq - link->base);
+}
@@ -0,0 +1,60 @@
+/*
+ * frame_check.cpp file
+ *
+ * This file contains the frame checks that can be used for the Message protocol: the one byte XOR checksum and
+ * CRC-16-CCITT, calculated with a compile-time table or with the hardware CRC16 module of the MSP430FR5969.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <lander_communication_lib/frame_check.h>
+#if defined(__MSP430__)
+#include <msp430.h>
+#endif
+
+extern constexpr CRC16_table crc16_table = crc16_make_table();
+
+// spot checks of the generated table against the published CRC-16-CCITT table
+static_assert(crc16_table.entry[0x00] == 0x0000, "CRC16 table is not generated correctly");
+static_assert(crc16_table.entry[0x01] == 0x1021, "CRC16 table is not generated correctly");
+static_assert(crc16_table.entry[0x80] == 0x9188, "CRC16 table is not generated correctly");
+static_assert(crc16_table.entry[0xFF] == 0x1EF0, "CRC16 table is not generated correctly");
+
+uint16_t crc16_block_software(uint16_t crc, const uint8_t *data, uint16_t length)
+{
+    for (uint16_t i = 0; i < length; i++) {
+        crc = crc16_update(crc, data[i]);
+    }
+    return crc;
+}
+
+#if defined(__MSP430__)
+uint16_t crc16_block_hardware(uint16_t crc, const uint8_t *data, uint16_t length)
+{
+    // writing to CRCDIRB shifts the bits in most significant bit first, which gives the standard CRC-16-CCITT result
+    CRCINIRES = crc;
+    for (uint16_t i = 0; i < length; i++) {
+        CRCDIRB_L = data[i];
+    }
+    return CRCINIRES;
+}
+#endif
+
+uint16_t frame_check_block(Frame_check_type type, uint16_t check, const uint8_t *data, uint16_t length)
+{
+    if (type == FRAME_CHECK_CRC16) {
+#if defined(__MSP430__)
+        return crc16_block_hardware(check, data, length);
+#else
+        return crc16_block_software(check, data, length);
+#endif
+    }
+
+    uint8_t checksum = (uint8_t)check;
+    for (uint16_t i = 0; i < length; i++) {
+        checksum ^= data[i];
+    }
+    return checksum;
+}
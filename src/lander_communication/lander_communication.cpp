@@ -11,11 +11,49 @@
  */
 
 #include <lander_communication_lib/lander_communication.h>
+#include <lander_communication_lib/slip_scan.h>
+#include <system_health_lib/main_system_init.h>
+#include <system_health_lib/low_power.h>
 #include <cstring>
 
 // Global variables
 bool ack_received = false;
 
+// ARQ of the lander link, only used by the main loop and kept in FRAM to save SRAM
+#pragma PERSISTENT
+ARQ_link lander_arq = {0};
+
+Link_speed_negotiator lander_link_speed;
+volatile Telemetry_format telemetry_format = LANDER_TELEMETRY_FORMAT;
+
+// Messages that are collected into one frame, only used by the main loop and kept in FRAM to save SRAM
+#pragma PERSISTENT
+Message_batch message_batch = {0};
+
+Telemetry_log lander_log;
+Telemetry_log_replay lander_log_replay;
+
+// Block of the telemetry log, persistent such that it is neither cleared at a reset nor reloaded by a new program. In
+// C++ the pragma applies to the declaration that follows it.
+#pragma PERSISTENT
+static uint8_t lander_log_block[LANDER_LOG_BLOCK_SIZE] = {0};
+
+// Session of the ARQ, persistent such that every start of the RDS flips the session bit in its reliable frames and
+// the lander also notices a restart shortly after the previous one
+#pragma PERSISTENT
+static uint8_t lander_arq_session = 0;
+
+// Payload of the replay frame that is being built, the frame leaves through the transmission queue right away.
+// Kept in FRAM to save SRAM, like message_batch.
+#pragma PERSISTENT
+static uint8_t lander_log_frame[LANDER_LOG_FRAME_SIZE] = {0};
+
+// lander_log_append is only used once the log has been opened
+static bool lander_log_open = false;
+
+// Amount of open begin_message_batch scopes, the batch is only sent at the end of the outermost one
+static uint8_t message_batch_depth = 0;
+
 
 void convert_message_to_array(const Message* msg, uint8_t* buffer, uint8_t* length) {
 
@@ -40,8 +78,11 @@ void convert_message_to_array(const Message* msg, uint8_t* buffer, uint8_t* leng
         index += msg->length;
     }
 
-    // Copy checksum
-    buffer[index++] = msg->checksum;
+    // Copy checksum, a CRC is sent high byte first
+    if (frame_check_size(LANDER_LINK_FRAME_CHECK) == 2) {
+        buffer[index++] = (uint8_t)(msg->checksum >> 8);
+    }
+    buffer[index++] = (uint8_t)msg->checksum;
 
     // Copy end_byte
     buffer[index++] = msg->end_byte;
@@ -52,7 +93,7 @@ void convert_message_to_array(const Message* msg, uint8_t* buffer, uint8_t* leng
 
 
 bool convert_array_to_message(const uint8_t* buffer, uint16_t length, Message* msg) {
-    if (length < 5) {
+    if (length < 4 + frame_check_size(LANDER_LINK_FRAME_CHECK)) {
         return false; // Handle invalid length
     }
 
@@ -84,8 +125,11 @@ bool convert_array_to_message(const uint8_t* buffer, uint16_t length, Message* m
         index += msg->length;
     }
 
-    // Extract checksum
+    // Extract checksum, a CRC is sent high byte first
     msg->checksum = buffer[index++];
+    if (frame_check_size(LANDER_LINK_FRAME_CHECK) == 2) {
+        msg->checksum = (uint16_t)(msg->checksum << 8) | buffer[index++];
+    }
 
     // Extract end_byte
     msg->end_byte = buffer[index++];
@@ -104,7 +148,26 @@ bool slip_encode(const uint8_t *buffer, uint16_t length, uint8_t *output_buffer,
     uint16_t index = 0;
     output_buffer[index++] = END;
 
-    for (uint16_t i = 0; i < length; i++) {
+    uint16_t i = 0;
+    while (i < length) {
+        // fast path: aligned words without END or ESC are copied at once, as long as they fit before the final END
+        if (((uintptr_t)&buffer[i] & (sizeof(Slip_scan_word) - 1)) == 0) {
+            while (length - i >= sizeof(Slip_scan_word) && index + sizeof(Slip_scan_word) < UART_BUFFER_SIZE) {
+                Slip_scan_word word;
+                memcpy(&word, &buffer[i], sizeof(word));
+                if (slip_word_has_special(word)) {
+                    break;
+                }
+                memcpy(&output_buffer[index], &word, sizeof(word));
+                index += sizeof(Slip_scan_word);
+                i += sizeof(Slip_scan_word);
+            }
+            if (i == length) {
+                break;
+            }
+        }
+
+        // byte by byte around special bytes, at the unaligned start and in the last bytes
         switch (buffer[i]) {
             case END:
                 if (index + 2 >= UART_BUFFER_SIZE) {
@@ -129,6 +192,7 @@ bool slip_encode(const uint8_t *buffer, uint16_t length, uint8_t *output_buffer,
                 }
                 output_buffer[index++] = buffer[i];
         }
+        i++;
     }
 
     output_buffer[index++] = END;
@@ -182,101 +246,338 @@ bool slip_decode(const uint8_t *input_buffer, uint16_t input_length, uint8_t *ou
 
 
 void send_message_struct(const Message* msg) {
-    // Static buffer to hold serialized and encoded data
-    static uint8_t buffer[UART_BUFFER_SIZE];
-    static uint8_t temp_buffer[UART_BUFFER_SIZE];
-    uint8_t serialized_length;
-    uint16_t encoded_length;
-    bool result;
-
-    // Serialize the message into the first part of the buffer
-    convert_message_to_array(msg, temp_buffer, &serialized_length);
-
-    // Encode the message using SLIP into the second part of the buffer
-    result = slip_encode(temp_buffer, serialized_length, buffer, &encoded_length);
-    if (!result) {
-        // Handle encoding failure
+    // the payload is encoded straight into the transmission queue, the checksum is calculated again on the way
+    uint8_t length = msg->length > MAX_PAYLOAD_SIZE ? MAX_PAYLOAD_SIZE : msg->length;
+    Payload_segment segment = {msg->payload, length};
+    send_messagev(msg->msg_type, &segment, 1);
+}
+
+
+void send_message(uint8_t msg_type, const uint8_t *payload, uint8_t length){
+    // the payload is encoded straight from its original location
+    Payload_segment segment = {payload, length};
+    send_messagev(msg_type, &segment, 1);
+}
+
+void send_message(uint8_t msg_type, Message_id id){
+    send_message(msg_type, payload_message_text(id), payload_message_length(id));
+}
+
+/*
+ * Encodes a frame straight into the transmission queue, without looking at the message batch.
+ */
+static bool send_frame(uint8_t msg_type, const Payload_segment *segments, uint8_t segment_count){
+    SLIP_frame_info info;
+
+    // calculate the length and checksum first, they are sent before the payload
+    if (!slip_frame_prepare(msg_type, segments, segment_count, LANDER_LINK_FRAME_CHECK, &info)) {
+        return false;
+    }
+
+    // wait for room (or drop the frame) and encode it straight into the transmission queue
+    if (!uart_tx_reserve(info.encoded_length)) {
+        return false;
+    }
+    slip_frame_write(&TX_queue, &info, segments, segment_count);
+    uart_tx_start();
+    return true;
+}
+
+bool send_messagev(uint8_t msg_type, const Payload_segment *segments, uint8_t segment_count){
+    // batched messages were queued first, they keep their place in front of this one
+    flush_message_batch();
+    return send_frame(msg_type, segments, segment_count);
+}
+
+void flush_message_batch(void){
+    if (message_batch_is_empty(&message_batch)) {
         return;
     }
+    uint8_t msg_type;
+    Payload_segment segment;
+    message_batch_frame(&message_batch, &msg_type, &segment);
+    send_frame(msg_type, &segment, 1);
+    message_batch_clear(&message_batch);
+}
 
-    // Send the encoded message
-    uart_write(buffer, encoded_length);
+void begin_message_batch(void){
+    message_batch_depth++;
 }
 
+void end_message_batch(void){
+    if (message_batch_depth > 0) {
+        message_batch_depth--;
+    }
+    if (message_batch_depth == 0) {
+        flush_message_batch();
+    }
+}
 
-void send_message(uint8_t msg_type, const uint8_t *payload, uint8_t length){
-    // Create a message structure
-    Message msg = create_message(msg_type, payload, length);
+/*
+ * Adds a message to the batch, the batch is sent first when the message does not fit anymore.
+ */
+static void send_batched(uint8_t msg_type, const Payload_segment *segments, uint8_t segment_count){
+    if (message_batch_add(&message_batch, msg_type, segments, segment_count)) {
+        return;
+    }
+    flush_message_batch();
+    if (!message_batch_add(&message_batch, msg_type, segments, segment_count)) {
+        // too large for a container
+        send_frame(msg_type, segments, segment_count);
+    }
+}
 
-    // Send the message
-    send_message_struct(&msg);
+/*
+ * Milliseconds since the start, system_tick_now() extended to 32 bits. process_received_data() calls it every task
+ * step, far more often than the 65 s after which the tick wraps around.
+ */
+static uint32_t lander_log_clock(void){
+    static uint32_t clock = 0;
+    static uint16_t last_tick = 0;
+    uint16_t tick = system_tick_now();
+    clock += (uint16_t)(tick - last_tick);
+    last_tick = tick;
+    return clock;
 }
 
-void send_message_and_wait_for_ACK(uint8_t msg_type, const uint8_t *payload, uint8_t length){
-    // Initialize connection with the lander
-    bool acknowledgement = false;
-    while(!acknowledgement){
-        // send an initialisation message to the lander
-        send_message(msg_type, payload, length);
-        // start a timeout using timer TA2
-        startTimeoutTimer_TA2();
-        // wait until timeout is done
-        while(!timeoutOccurred && UART_state != RECEIVED){}
-        // check whether the response is an ACK
-        process_received_data();
-        if(ack_received){
-            acknowledgement = true;
-            ack_received = false;
+/*
+ * Logs the binary record of a telemetry frame, whatever the telemetry format is.
+ */
+static void lander_log_append(const Telemetry_frame *binary){
+    if (lander_log_open) {
+        telemetry_log_append(&lander_log, binary->segments[0].data, binary->segments[0].length, lander_log_clock());
+    }
+}
+
+void send_event(Telemetry_event event){
+    Telemetry_frame frame;
+    if (telemetry_encode_event(TELEMETRY_BINARY, event, &frame)) {
+        lander_log_append(&frame);
+    }
+    if (telemetry_format == TELEMETRY_BINARY || telemetry_encode_event(telemetry_format, event, &frame)) {
+        send_batched(frame.msg_type, frame.segments, frame.segment_count);
+    }
+}
+
+void send_measurement_fixed(Telemetry_measurement measurement, int16_t fixed_point){
+    Telemetry_frame frame;
+    if (!telemetry_encode_measurement(TELEMETRY_BINARY, measurement, fixed_point, &frame)) {
+        return;
+    }
+    lander_log_append(&frame);
+    if (telemetry_format == TELEMETRY_BINARY ||
+        telemetry_encode_measurement(telemetry_format, measurement, fixed_point, &frame)) {
+        send_batched(frame.msg_type, frame.segments, frame.segment_count);
+    }
+}
+
+static bool lander_arq_send(ARQ_link *link, uint8_t msg_type, const Payload_segment *segments, uint8_t segment_count){
+    return send_messagev(msg_type, segments, segment_count);
+}
+
+static void lander_arq_deliver(ARQ_link *link, const Message *msg){
+    handle_message(msg);
+}
+
+void lander_arq_init(void){
+    ARQ_config config;
+    config.window = LANDER_ARQ_WINDOW;
+    config.timeout = LANDER_ARQ_TIMEOUT_MS;
+    config.max_transmissions = 0;
+    config.ack_delay = LANDER_ARQ_ACK_DELAY_MS;
+    config.session = ++lander_arq_session;
+    arq_init(&lander_arq, &config, lander_arq_send, lander_arq_deliver, NULL);
+}
+
+static bool lander_link_speed_send(Link_speed_negotiator *negotiator, const uint8_t *payload, uint8_t length){
+    Payload_segment segment = {payload, length};
+    return send_messagev(MSG_TYPE_LINK_SPEED, &segment, 1);
+}
+
+static void lander_link_speed_apply(Link_speed_negotiator *negotiator, Link_speed speed){
+    // the frame that announced the switch has to leave at the old speed
+    uart_flush();
+    uart_set_baud(&link_speed_settings[speed]);
+    // what has been received of a frame at the old speed is garbage at the new one
+    slip_stream_abort(&RX_decoder);
+}
+
+static void handle_link_speed(const Message *msg){
+    link_speed_receive(&lander_link_speed, msg, system_tick_now());
+}
+
+void lander_link_speed_init(void){
+    Link_speed_config config;
+    config.timeout = LANDER_LINK_SPEED_TIMEOUT_MS;
+    config.max_tries = LANDER_LINK_SPEED_MAX_TRIES;
+    config.error_window = LANDER_LINK_SPEED_ERROR_WINDOW;
+    config.max_errors = LANDER_LINK_SPEED_MAX_ERRORS;
+    link_speed_init(&lander_link_speed, &config, LANDER_LINK_SPEEDS, lander_link_speed_send, lander_link_speed_apply,
+                    NULL);
+    message_dispatch_register(&lander_dispatcher, MSG_TYPE_LINK_SPEED, handle_link_speed);
+}
+
+static void handle_log(const Message *msg){
+    telemetry_log_command(&lander_log, &lander_log_replay, msg->payload, msg->length);
+}
+
+void lander_log_init(void){
+    telemetry_log_replay_init(&lander_log_replay);
+    lander_log_open = telemetry_log_open(&lander_log, lander_log_block, LANDER_LOG_BLOCK_SIZE, LANDER_LOG_INDEX_SLOTS,
+                                         NULL);
+    message_dispatch_register(&lander_dispatcher, MSG_TYPE_LOG, handle_log);
+}
+
+void lander_log_replay_backlog(void){
+    if (lander_log_open) {
+        telemetry_log_replay_backlog(&lander_log, &lander_log_replay);
+    }
+}
+
+/*
+ * Sends frames of the running replay as long as they fit in the transmission queue without waiting, such that the
+ * replay goes out at the speed of the link without holding up the task step. The payload is built in
+ * lander_log_frame, it does not fit on the stack.
+ */
+static void lander_log_replay_poll(void){
+    while (lander_log_replay.active) {
+        Telemetry_log_replay previous = lander_log_replay;
+        Payload_segment segment = {lander_log_frame, 0};
+        segment.length = telemetry_log_replay_next(&lander_log, &lander_log_replay, lander_log_frame,
+                                                   sizeof(lander_log_frame));
+        SLIP_frame_info info;
+        if (segment.length == 0 ||
+            !slip_frame_prepare(MSG_TYPE_LOG, &segment, 1, LANDER_LINK_FRAME_CHECK, &info) ||
+            uart_tx_queue_free(&TX_queue) < info.encoded_length) {
+            // sent again on the next call
+            lander_log_replay = previous;
             return;
         }
+        slip_frame_write(&TX_queue, &info, &segment, 1);
+        uart_tx_start();
     }
 }
 
-void send_message_and_wait_for_ACK_3_times(uint8_t msg_type, const uint8_t *payload, uint8_t length){
-    // Initialize connection with the lander
-    bool acknowledgement = false;
-    int x = 0;
-    while(!acknowledgement && x < 3){
-        // send an initialisation message to the lander
-        send_message(msg_type, payload, length);
-        // start a timeout using timer TA2
-        startTimeoutTimer_TA2();
-        // wait until timeout is done or message is received
-        while(!timeoutOccurred && UART_state != RECEIVED){}
-        // check whether the response is an ACK
-        process_received_data();
-        x++;
+bool send_message_reliable(uint8_t msg_type, const uint8_t *payload, uint8_t length){
+    return arq_send(&lander_arq, msg_type, payload, length, system_tick_now());
+}
 
-        if(ack_received){
-            acknowledgement = true;
-            ack_received = false;
+/*
+ * Sends a message through the ARQ and handles received data until the lander acknowledged it or the ARQ gave it up.
+ */
+static void send_message_reliable_and_wait(uint8_t msg_type, const uint8_t *payload, uint8_t length){
+    // wait for room in the window
+    while(!send_message_reliable(msg_type, payload, length)){
+        if(length > ARQ_MAX_PAYLOAD_SIZE){
             return;
         }
+        process_received_data();
+        wait_for_received_data();
+    }
+    // the ACKs arrive through process_received_data, which also sends the frame again after a timeout
+    uint8_t seq = (uint8_t)(lander_arq.next_seq - 1);
+    while(!arq_is_done(&lander_arq, seq)){
+        process_received_data();
+        wait_for_received_data();
     }
 }
 
+void send_message_and_wait_for_ACK(uint8_t msg_type, const uint8_t *payload, uint8_t length){
+    send_message_reliable_and_wait(msg_type, payload, length);
+}
+
+void send_message_and_wait_for_ACK(uint8_t msg_type, Message_id id){
+    send_message_reliable_and_wait(msg_type, payload_message_text(id), payload_message_length(id));
+}
+
+void send_message_and_wait_for_ACK_3_times(uint8_t msg_type, const uint8_t *payload, uint8_t length){
+    // a new session does not wait for the frames of the previous one
+    if(msg_type == MSG_TYPE_INIT){
+        arq_reset(&lander_arq);
+        link_speed_reset(&lander_link_speed);
+    }
+    // frames that are outstanding at the same time are also given up after 3 transmissions
+    uint8_t max_transmissions = lander_arq.config.max_transmissions;
+    lander_arq.config.max_transmissions = 3;
+    send_message_reliable_and_wait(msg_type, payload, length);
+    lander_arq.config.max_transmissions = max_transmissions;
+}
+
+void send_message_and_wait_for_ACK_3_times(uint8_t msg_type, Message_id id){
+    send_message_and_wait_for_ACK_3_times(msg_type, payload_message_text(id), payload_message_length(id));
+}
+
+// Received frame that is being handled. It is as large as RX_buffer, so it is kept in FRAM to leave the 2 KB of SRAM
+// to the stack and the buffers of the interrupts. In C++ the pragma applies to the declaration that follows it.
+#pragma PERSISTENT
+static Message lander_rx_message = {0};
+
 void process_received_data(void) {
-    __disable_interrupt();
-    uint16_t start = RX_start;
-    uint16_t end = RX_end;
-    UART_states state = UART_state;
-    __enable_interrupt();
-
-    if (UART_state == RECEIVED && start != end) {
-        UART_state = IDLE;
-        RX_start = read_RX_buffer(start, end);
+    // the RX interrupt has already decoded and validated the frame
+    Message *msg = &lander_rx_message;
+
+    // the end of a task step is a flush point of the message batch, unless a begin_message_batch scope is open
+    if (message_batch_depth == 0) {
+        flush_message_batch();
+    }
+
+    // handle every frame of a burst, the RX interrupt keeps queueing new ones in the meantime
+    bool received = false;
+    while (uart_receive_frame(msg)) {
+        link_speed_frame_received(&lander_link_speed, true, system_tick_now());
+        if (arq_is_frame(msg)) {
+            arq_receive(&lander_arq, msg, system_tick_now());
+        } else {
+            handle_message(msg);
+        }
+        received = true;
+    }
+
+    if (received) {
+        // errors of frames in the same burst are reported on the next call
     } else if (buffer_full_state){
         // Create a ERROR message
-        send_message(MSG_TYPE_ERROR, PAYLOAD_TOO_LARGE, sizeof(PAYLOAD_TOO_LARGE) - 1);
+        send_event(EVENT_MESSAGE_TOO_LARGE);
         buffer_full_state = false;
     } else if(error_state){
         // Create a ERROR message
-        send_message(MSG_TYPE_ERROR, PAYLOAD_EMPTY, sizeof(PAYLOAD_EMPTY) - 1);
+        send_event(EVENT_INVALID_MESSAGE);
         error_state = false;
+    } else if(checksum_error_state){
+        // Create a ERROR message
+        send_event(EVENT_INVALID_CHECKSUM);
+        checksum_error_state = false;
     } else if (timeout_state) {
         // Create a NACK message
-        send_message(MSG_TYPE_NACK, PAYLOAD_EMPTY, sizeof(PAYLOAD_EMPTY) - 1);
+        send_message(MSG_TYPE_NACK, MSG_ID_EMPTY);
         timeout_state = false;
     } else {}
+
+    // frames that were rejected by the RX interrupt count as errors of the link speed
+    static uint16_t rejected_frames = 0;
+    UART_RX_statistics statistics;
+    uart_rx_get_statistics(&statistics);
+    uint16_t rejected = (uint16_t)(statistics.invalid_messages + statistics.invalid_checksums);
+    while (rejected_frames != rejected) {
+        link_speed_frame_received(&lander_link_speed, false, system_tick_now());
+        rejected_frames++;
+    }
+    link_speed_poll(&lander_link_speed, system_tick_now());
+
+    // retransmissions and ACKs of the sliding-window ARQ
+    arq_poll(&lander_arq, system_tick_now());
+
+    // the replay of the telemetry log fills what is left of the transmission queue, the clock of the log is kept
+    // going also when nothing is logged
+    lander_log_clock();
+    lander_log_replay_poll();
+
+    // active fraction of the CPU in the transit modes
+    low_power_report();
 }
 
+void wait_for_received_data(void) {
+    uint16_t tick = system_tick_now();
+    LOW_POWER_WAIT_UNTIL(system_tick_now() != tick || UART_state == RECEIVED || buffer_full_state || error_state ||
+                         checksum_error_state || timeout_state);
+}
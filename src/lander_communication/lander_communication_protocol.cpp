@@ -18,12 +18,11 @@
 volatile transit_states transit_state;
 
 // Helper function to calculate checksum
-uint8_t calculate_checksum_helper(uint8_t msg_type, uint8_t length, const uint8_t *payload) {
-    uint8_t checksum = msg_type ^ length;
-    for (uint8_t i = 0; i < length; i++) {
-        checksum ^= payload[i];
-    }
-    return checksum;
+uint16_t calculate_checksum_helper(uint8_t msg_type, uint8_t length, const uint8_t *payload) {
+    uint8_t header[2] = {msg_type, length};
+    uint16_t checksum = frame_check_init(LANDER_LINK_FRAME_CHECK);
+    checksum = frame_check_block(LANDER_LINK_FRAME_CHECK, checksum, header, sizeof(header));
+    return frame_check_block(LANDER_LINK_FRAME_CHECK, checksum, payload, length);
 }
 
 Message create_message(uint8_t msg_type, const uint8_t *payload, uint8_t length) {
@@ -44,65 +43,100 @@ Message create_message(uint8_t msg_type, const uint8_t *payload, uint8_t length)
     return msg;
 }
 
-uint8_t calculate_checksum(const Message *msg){
+uint16_t calculate_checksum(const Message *msg){
     return calculate_checksum_helper(msg->msg_type, msg->length, msg->payload);
 }
 
+/* handlers of the lander link */
+
+static void handle_init(const Message *msg) {
+    // Handle initialization sequence
+    send_message(MSG_TYPE_ACK, MSG_ID_ACK);
+    // the link is back, send what the lander has missed
+    lander_log_replay_backlog();
+}
+
+static void handle_ack(const Message *msg) {
+    // Handle acknowledgment
+    ack_received = true;
+}
+
+static void handle_deploy(const Message *msg) {
+    transit_state = DEPLOYMENT;
+}
+
+static void select_ascii_telemetry(const Message *msg) {
+    telemetry_format = TELEMETRY_ASCII;
+}
+
+static void select_binary_telemetry(const Message *msg) {
+    telemetry_format = TELEMETRY_BINARY;
+}
+
+static void select_general_startup(const Message *msg) {
+    transit_state = GENERAL_STARTUP;
+}
+
+static void select_launch_integration(const Message *msg) {
+    transit_state = LAUNCH_INTEGRATION;
+}
+
+static void select_transit(const Message *msg) {
+    transit_state = TRANSIT;
+}
+
+static void select_pre_deployment(const Message *msg) {
+    transit_state = PRE_DEPLOYMENT;
+}
+
+static void select_deployment(const Message *msg) {
+    transit_state = DEPLOYMENT;
+}
+
+// Handlers indexed by message type, REQUEST, DATA, RESPONSE and ERROR are left to the subsystems
+static const Message_handler lander_handlers[MESSAGE_DISPATCH_TYPE_COUNT] = {
+    NULL,               // 0x00
+    handle_init,        // MSG_TYPE_INIT
+    handle_ack,         // MSG_TYPE_ACK
+    NULL,               // MSG_TYPE_NACK
+    NULL,               // MSG_TYPE_REQUEST
+    NULL,               // MSG_TYPE_DATA
+    NULL,               // MSG_TYPE_RESPONSE
+    handle_deploy,      // MSG_TYPE_DEPLOY
+    NULL,               // MSG_TYPE_TRANSIT_MODE, only commands
+    NULL,               // MSG_TYPE_ERROR
+};
+
+// Only written by lander_dispatch_init, in FRAM to save SRAM
+#pragma PERSISTENT
+Message_dispatcher lander_dispatcher = {0};
+
+void lander_dispatch_init(void) {
+    message_dispatch_init(&lander_dispatcher, lander_handlers);
+    // telemetry format, ASCII for bench debugging
+    message_dispatch_register_command(&lander_dispatcher, MSG_TYPE_REQUEST, "TA", select_ascii_telemetry);
+    message_dispatch_register_command(&lander_dispatcher, MSG_TYPE_REQUEST, "TB", select_binary_telemetry);
+    // transit modes
+    message_dispatch_register_command(&lander_dispatcher, MSG_TYPE_TRANSIT_MODE, "GS", select_general_startup);
+    message_dispatch_register_command(&lander_dispatcher, MSG_TYPE_TRANSIT_MODE, "LI", select_launch_integration);
+    message_dispatch_register_command(&lander_dispatcher, MSG_TYPE_TRANSIT_MODE, "T", select_transit);
+    message_dispatch_register_command(&lander_dispatcher, MSG_TYPE_TRANSIT_MODE, "PD", select_pre_deployment);
+    message_dispatch_register_command(&lander_dispatcher, MSG_TYPE_TRANSIT_MODE, "D", select_deployment);
+}
+
 void handle_message(const Message *msg) {
     if (msg->start_byte != MSG_START_BYTE || msg->end_byte != MSG_END_BYTE) {
         // Invalid message
-        send_message(MSG_TYPE_ERROR, PAYLOAD_INVALID_MESSAGE, sizeof(PAYLOAD_INVALID_MESSAGE) - 1);
+        send_event(EVENT_INVALID_MESSAGE);
         return;
     }
 
     if (msg->checksum != calculate_checksum(msg)) {
         // Invalid checksum
-        send_message(MSG_TYPE_ERROR, PAYLOAD_INVALID_CHECKSUM, sizeof(PAYLOAD_INVALID_CHECKSUM) - 1);
+        send_event(EVENT_INVALID_CHECKSUM);
         return;
     }
 
-    switch (msg->msg_type) {
-        case MSG_TYPE_INIT:
-            // Handle initialization sequence
-            send_message(MSG_TYPE_ACK, PAYLOAD_ACK, sizeof(PAYLOAD_ACK) - 1);
-            break;
-        case MSG_TYPE_ACK:
-            // Handle acknowledgment
-            ack_received = true;
-            break;
-        case MSG_TYPE_REQUEST:
-            // Handle request
-            break;
-        case MSG_TYPE_DATA:
-            // Handle data
-            break;
-        case MSG_TYPE_RESPONSE:
-            // Handle response
-            break;
-        case MSG_TYPE_DEPLOY:
-            transit_state = DEPLOYMENT;
-            break;
-        case MSG_TYPE_TRANSIT_MODE:
-            if (msg->payload[0] == 'G' && msg->payload[1] == 'S') { // general startup (GS)
-                transit_state = GENERAL_STARTUP;
-            } else if (msg->payload[0] == 'L' && msg->payload[1] == 'I') { // Launch Integration (LI)
-                transit_state = LAUNCH_INTEGRATION;
-            } else if (msg->payload[0] == 'T') { // Transit (T)
-                transit_state = TRANSIT;
-            } else if (msg->payload[0] == 'P' && msg->payload[1] == 'D') { // Pre-Deployment (PD)
-                transit_state = PRE_DEPLOYMENT;
-            } else if (msg->payload[0] == 'D') { // Deployment (D)
-                transit_state = DEPLOYMENT;
-            } else {
-                // Handle unknown state or do nothing
-            }
-
-            break;
-        case MSG_TYPE_ERROR:
-            // Handle mode
-            break;
-        default:
-            // Unknown message type
-            break;
-    }
+    // messages without handler are ignored
+    message_dispatch(&lander_dispatcher, msg);
 }
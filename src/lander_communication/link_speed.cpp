@@ -0,0 +1,292 @@
+/*
+ * link_speed.cpp file
+ *
+ * This file contains the link speed negotiation of the lander link, see link_speed.h for the exchange on both sides
+ * of the link.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <lander_communication_lib/link_speed.h>
+
+// Every speed has to be usable at the clock of the UART, otherwise the firmware does not compile
+#define LINK_SPEED_CHECK(baud)                                                      \
+    static_assert(uart_baud_error(UART_BRCLK_HZ, baud) <= UART_BAUD_MAX_ERROR,      \
+                  "the modulation error of " #baud " baud is too large at UART_BRCLK_HZ");
+LINK_SPEEDS(LINK_SPEED_CHECK)
+#undef LINK_SPEED_CHECK
+
+#define LINK_SPEED_SETTING(baud) uart_baud_setting(UART_BRCLK_HZ, baud),
+const UART_baud_setting link_speed_settings[LINK_SPEED_COUNT] = {
+    LINK_SPEEDS(LINK_SPEED_SETTING)
+};
+#undef LINK_SPEED_SETTING
+
+#define LINK_SPEED_RATE(baud) baud,
+static const uint32_t link_speed_rates[LINK_SPEED_COUNT] = {
+    LINK_SPEEDS(LINK_SPEED_RATE)
+};
+#undef LINK_SPEED_RATE
+
+uint32_t link_speed_baud(Link_speed speed)
+{
+    if ((unsigned)speed >= LINK_SPEED_COUNT) {
+        return 0;
+    }
+    return link_speed_rates[speed];
+}
+
+/*
+ * Returns the fastest speed of a set, LINK_SPEED_DEFAULT for an empty set.
+ */
+static Link_speed link_speed_fastest(uint8_t speeds)
+{
+    for (uint8_t i = LINK_SPEED_COUNT; i > 0; i--) {
+        if ((speeds & LINK_SPEED_BIT(i - 1)) != 0) {
+            return (Link_speed)(i - 1);
+        }
+    }
+    return LINK_SPEED_DEFAULT;
+}
+
+/*
+ * Switches the UART when the speed changes. The error monitor starts over at every switch.
+ */
+static void link_speed_switch(Link_speed_negotiator *negotiator, Link_speed speed)
+{
+    if (speed != negotiator->speed) {
+        negotiator->apply(negotiator, speed);
+        negotiator->speed = speed;
+    }
+    negotiator->frames = 0;
+    negotiator->errors = 0;
+}
+
+/*
+ * Goes back to LINK_SPEED_DEFAULT because the other side did not answer.
+ */
+static void link_speed_fall_back(Link_speed_negotiator *negotiator)
+{
+    link_speed_switch(negotiator, LINK_SPEED_DEFAULT);
+    negotiator->state = LINK_SPEED_IDLE;
+    negotiator->selector = false;
+    negotiator->statistics.fallbacks++;
+}
+
+/*
+ * Sends PROPOSE with the supported speeds.
+ */
+static bool link_speed_send_propose(Link_speed_negotiator *negotiator)
+{
+    uint8_t payload[2] = {LINK_SPEED_PROPOSE, negotiator->supported};
+    return negotiator->send(negotiator, payload, sizeof(payload));
+}
+
+/*
+ * Sends SELECT with the given speed.
+ */
+static bool link_speed_send_select(Link_speed_negotiator *negotiator, Link_speed speed)
+{
+    uint8_t payload[3] = {LINK_SPEED_SELECT, (uint8_t)speed, negotiator->common};
+    return negotiator->send(negotiator, payload, sizeof(payload));
+}
+
+/*
+ * Sends SELECT and switches once it has been sent.
+ */
+static bool link_speed_select(Link_speed_negotiator *negotiator, Link_speed speed, uint16_t now)
+{
+    if (!link_speed_send_select(negotiator, speed)) {
+        return false;
+    }
+    link_speed_switch(negotiator, speed);
+    negotiator->state = LINK_SPEED_SELECTED;
+    negotiator->selector = true;
+    negotiator->tries = 1;
+    negotiator->since = now;
+    return true;
+}
+
+/*
+ * Sends CONFIRM with the current speed.
+ */
+static void link_speed_confirm(Link_speed_negotiator *negotiator)
+{
+    uint8_t payload[2] = {LINK_SPEED_CONFIRM, (uint8_t)negotiator->speed};
+    // a failed send is handled like a lost frame
+    negotiator->send(negotiator, payload, sizeof(payload));
+}
+
+void link_speed_init(Link_speed_negotiator *negotiator, const Link_speed_config *config, uint8_t supported,
+                     Link_speed_send_function send, Link_speed_apply_function apply, void *context)
+{
+    negotiator->config = *config;
+    negotiator->send = send;
+    negotiator->apply = apply;
+    negotiator->context = context;
+    negotiator->supported = (uint8_t)((supported & LINK_SPEED_ALL) | LINK_SPEED_BIT(LINK_SPEED_DEFAULT));
+    negotiator->common = LINK_SPEED_BIT(LINK_SPEED_DEFAULT);
+    negotiator->speed = LINK_SPEED_DEFAULT;
+    negotiator->state = LINK_SPEED_IDLE;
+    negotiator->selector = false;
+    negotiator->tries = 0;
+    negotiator->since = 0;
+    negotiator->frames = 0;
+    negotiator->errors = 0;
+    negotiator->statistics = Link_speed_statistics{0, 0, 0};
+}
+
+void link_speed_reset(Link_speed_negotiator *negotiator)
+{
+    link_speed_switch(negotiator, LINK_SPEED_DEFAULT);
+    negotiator->common = LINK_SPEED_BIT(LINK_SPEED_DEFAULT);
+    negotiator->state = LINK_SPEED_IDLE;
+    negotiator->selector = false;
+}
+
+bool link_speed_propose(Link_speed_negotiator *negotiator, uint16_t now)
+{
+    if (negotiator->state != LINK_SPEED_IDLE || !link_speed_send_propose(negotiator)) {
+        return false;
+    }
+    negotiator->state = LINK_SPEED_PROPOSED;
+    negotiator->tries = 1;
+    negotiator->since = now;
+    return true;
+}
+
+void link_speed_receive(Link_speed_negotiator *negotiator, const Message *msg, uint16_t now)
+{
+    if (msg->length < 2) {
+        return;
+    }
+    uint8_t speed = msg->payload[1];
+
+    switch (msg->payload[0]) {
+        case LINK_SPEED_PROPOSE:
+            // a new proposal restarts the exchange, e.g. after the other side was restarted
+            negotiator->common = (uint8_t)((speed & negotiator->supported) | LINK_SPEED_BIT(LINK_SPEED_DEFAULT));
+            link_speed_select(negotiator, link_speed_fastest(negotiator->common), now);
+            break;
+
+        case LINK_SPEED_SELECT:
+            // an unknown speed is not confirmed, the other side falls back on its own
+            if (msg->length < 3 || speed >= LINK_SPEED_COUNT ||
+                (negotiator->supported & LINK_SPEED_BIT(speed)) == 0) {
+                break;
+            }
+            negotiator->common = (uint8_t)((msg->payload[2] & negotiator->supported) |
+                                           LINK_SPEED_BIT(LINK_SPEED_DEFAULT));
+            link_speed_switch(negotiator, (Link_speed)speed);
+            negotiator->state = LINK_SPEED_CONFIRMING;
+            negotiator->selector = false;
+            negotiator->tries = 1;
+            negotiator->since = now;
+            link_speed_confirm(negotiator);
+            break;
+
+        case LINK_SPEED_CONFIRM:
+            if (speed != negotiator->speed) {
+                break;
+            }
+            if (negotiator->state == LINK_SPEED_SELECTED) {
+                link_speed_confirm(negotiator);
+                negotiator->state = LINK_SPEED_IDLE;
+                negotiator->statistics.switches++;
+            } else if (negotiator->state == LINK_SPEED_CONFIRMING) {
+                negotiator->state = LINK_SPEED_IDLE;
+                negotiator->statistics.switches++;
+            } else if (negotiator->state == LINK_SPEED_IDLE && negotiator->selector) {
+                // the answer got lost, the other side repeats its CONFIRM
+                link_speed_confirm(negotiator);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void link_speed_frame_received(Link_speed_negotiator *negotiator, bool valid, uint16_t now)
+{
+    // frames at the wrong speed are expected while switching
+    if (negotiator->state != LINK_SPEED_IDLE || negotiator->config.max_errors == 0) {
+        return;
+    }
+
+    negotiator->frames++;
+    if (!valid) {
+        negotiator->errors++;
+    }
+
+    if (negotiator->errors >= negotiator->config.max_errors) {
+        negotiator->frames = 0;
+        negotiator->errors = 0;
+        if (negotiator->speed != LINK_SPEED_DEFAULT) {
+            // the default speed is always common, so there is a slower one
+            uint8_t slower = (uint8_t)(negotiator->common & (LINK_SPEED_BIT(negotiator->speed) - 1));
+            if (link_speed_select(negotiator, link_speed_fastest(slower), now)) {
+                negotiator->statistics.step_downs++;
+            }
+        }
+    } else if (negotiator->frames >= negotiator->config.error_window) {
+        negotiator->frames = 0;
+        negotiator->errors = 0;
+    }
+}
+
+void link_speed_poll(Link_speed_negotiator *negotiator, uint16_t now)
+{
+    if (negotiator->state == LINK_SPEED_IDLE) {
+        return;
+    }
+    // PROPOSE is only repeated after the other side has given up a SELECT that got lost, such that the repeated PROPOSE
+    // reaches it at LINK_SPEED_DEFAULT again
+    uint32_t timeout = negotiator->config.timeout;
+    if (negotiator->state == LINK_SPEED_PROPOSED) {
+        timeout *= (uint32_t)negotiator->config.max_tries + 1;
+    }
+    if ((uint16_t)(now - negotiator->since) < timeout) {
+        return;
+    }
+
+    switch (negotiator->state) {
+        case LINK_SPEED_PROPOSED:
+            if (negotiator->tries < negotiator->config.max_tries) {
+                negotiator->tries++;
+                negotiator->since = now;
+                link_speed_send_propose(negotiator);
+            } else {
+                // the other side does not negotiate, the link stays at the current speed
+                negotiator->state = LINK_SPEED_IDLE;
+            }
+            break;
+
+        case LINK_SPEED_SELECTED:
+            // SELECT again at the new speed, the other side may have switched on its own because of the errors
+            if (negotiator->tries < negotiator->config.max_tries) {
+                negotiator->tries++;
+                negotiator->since = now;
+                // a failed send is handled like a lost frame
+                link_speed_send_select(negotiator, negotiator->speed);
+            } else {
+                link_speed_fall_back(negotiator);
+            }
+            break;
+
+        case LINK_SPEED_CONFIRMING:
+            if (negotiator->tries < negotiator->config.max_tries) {
+                negotiator->tries++;
+                negotiator->since = now;
+                link_speed_confirm(negotiator);
+            } else {
+                link_speed_fall_back(negotiator);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ * message_batch.cpp file
+ *
+ * This file contains the message batch of the lander link, see message_batch.h for the container frame format.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <lander_communication_lib/message_batch.h>
+#include <string.h>
+
+/*
+ * Copies the payload segments to the end of the batch.
+ */
+static void message_batch_append(Message_batch *batch, const Payload_segment *segments, uint8_t segment_count)
+{
+    for (uint8_t i = 0; i < segment_count; i++) {
+        memcpy(&batch->buffer[batch->length], segments[i].data, segments[i].length);
+        batch->length += segments[i].length;
+    }
+}
+
+void message_batch_init(Message_batch *batch)
+{
+    memset(batch, 0, sizeof(*batch));
+}
+
+bool message_batch_add(Message_batch *batch, uint8_t msg_type, const Payload_segment *segments,
+                       uint8_t segment_count)
+{
+    uint16_t length = 0;
+    for (uint8_t i = 0; i < segment_count; i++) {
+        length += segments[i].length;
+    }
+
+    // telemetry records describe their own size, they are appended to a telemetry sub-record in front of them
+    if (msg_type == MSG_TYPE_TELEMETRY && batch->records != 0 &&
+        batch->buffer[batch->last_record] == MSG_TYPE_TELEMETRY) {
+        uint8_t *record_length = &batch->buffer[batch->last_record + 1];
+        if (batch->length + length > MESSAGE_BATCH_SIZE_LIMIT || *record_length + length > UINT8_MAX) {
+            return false;
+        }
+        *record_length += (uint8_t)length;
+        message_batch_append(batch, segments, segment_count);
+        batch->batched_messages++;
+        return true;
+    }
+
+    if (batch->length + MESSAGE_BATCH_RECORD_HEADER_SIZE + length > MESSAGE_BATCH_SIZE_LIMIT) {
+        return false;
+    }
+    batch->last_record = batch->length;
+    batch->buffer[batch->length++] = msg_type;
+    batch->buffer[batch->length++] = (uint8_t)length;
+    message_batch_append(batch, segments, segment_count);
+    batch->records++;
+    batch->batched_messages++;
+    return true;
+}
+
+bool message_batch_is_empty(const Message_batch *batch)
+{
+    return batch->records == 0;
+}
+
+void message_batch_frame(const Message_batch *batch, uint8_t *msg_type, Payload_segment *segment)
+{
+    if (batch->records == 1) {
+        // a single sub-record does not need a container
+        *msg_type = batch->buffer[0];
+        segment->data = &batch->buffer[MESSAGE_BATCH_RECORD_HEADER_SIZE];
+        segment->length = batch->buffer[1];
+    } else {
+        *msg_type = MSG_TYPE_CONTAINER;
+        segment->data = batch->buffer;
+        segment->length = batch->length;
+    }
+}
+
+void message_batch_clear(Message_batch *batch)
+{
+    if (batch->records != 0) {
+        batch->sent_frames++;
+    }
+    batch->length = 0;
+    batch->records = 0;
+    batch->last_record = 0;
+}
+
+bool message_container_next(const Message *container, uint8_t *offset, Message *msg)
+{
+    if (*offset + MESSAGE_BATCH_RECORD_HEADER_SIZE > container->length) {
+        return false;
+    }
+    uint8_t length = container->payload[*offset + 1];
+    if (*offset + MESSAGE_BATCH_RECORD_HEADER_SIZE + length > container->length) {
+        return false;
+    }
+
+    msg->start_byte = MSG_START_BYTE;
+    msg->msg_type = container->payload[*offset];
+    msg->length = length;
+    memcpy(msg->payload, &container->payload[*offset + MESSAGE_BATCH_RECORD_HEADER_SIZE], length);
+    msg->checksum = calculate_checksum_helper(msg->msg_type, msg->length, msg->payload);
+    msg->end_byte = MSG_END_BYTE;
+    *offset += MESSAGE_BATCH_RECORD_HEADER_SIZE + length;
+    return true;
+}
@@ -0,0 +1,117 @@
+/*
+ * message_dispatch.cpp file
+ *
+ * This file contains the message dispatcher of the lander link, see message_dispatch.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <lander_communication_lib/message_dispatch.h>
+#include <string.h>
+
+void message_dispatch_init(Message_dispatcher *dispatcher, const Message_handler *handlers)
+{
+    memset(dispatcher, 0, sizeof(*dispatcher));
+    if (handlers != NULL) {
+        memcpy(dispatcher->handlers, handlers, sizeof(dispatcher->handlers));
+    }
+}
+
+bool message_dispatch_register(Message_dispatcher *dispatcher, uint8_t msg_type, Message_handler handler)
+{
+    if (msg_type >= MESSAGE_DISPATCH_TYPE_COUNT) {
+        return false;
+    }
+    dispatcher->handlers[msg_type] = handler;
+    return true;
+}
+
+/*
+ * Packs a command of at most MESSAGE_COMMAND_SIZE characters in one integer, such that commands are compared at once.
+ */
+static inline uint16_t message_command_opcode(const uint8_t *opcode, uint8_t length)
+{
+    return (length == 2) ? (uint16_t)(opcode[0] | (opcode[1] << 8)) : opcode[0];
+}
+
+/*
+ * Returns the first slot to look at for a command: a multiplicative hash of the command, its size and message type.
+ */
+static inline uint8_t message_command_slot(uint8_t msg_type, uint16_t opcode, uint8_t length)
+{
+    uint16_t key = opcode ^ (uint16_t)(msg_type << 12) ^ (uint16_t)(length << 4);
+    return (uint8_t)((uint16_t)(key * 40503u) >> 12) & (MESSAGE_DISPATCH_COMMAND_SLOTS - 1);
+}
+
+/*
+ * Looks up a command, returns its slot or the free slot where it belongs when it is not registered.
+ */
+static Message_command *message_dispatch_find(Message_dispatcher *dispatcher, uint8_t msg_type, uint16_t opcode,
+                                              uint8_t length)
+{
+    uint8_t slot = message_command_slot(msg_type, opcode, length);
+    // the table is never full, so a free slot ends the search
+    while (true) {
+        Message_command *command = &dispatcher->commands[slot];
+        if (command->handler == NULL ||
+            (command->opcode == opcode && command->length == length && command->msg_type == msg_type)) {
+            return command;
+        }
+        slot = (slot + 1) & (MESSAGE_DISPATCH_COMMAND_SLOTS - 1);
+    }
+}
+
+bool message_dispatch_register_command(Message_dispatcher *dispatcher, uint8_t msg_type, const char *opcode,
+                                       Message_handler handler)
+{
+    size_t length = strlen(opcode);
+    // commands cannot be removed, a free slot in the middle of a chain would hide the commands behind it
+    if (msg_type >= MESSAGE_DISPATCH_TYPE_COUNT || length == 0 || length > MESSAGE_COMMAND_SIZE || handler == NULL) {
+        return false;
+    }
+
+    uint16_t key = message_command_opcode((const uint8_t *)opcode, (uint8_t)length);
+    Message_command *command = message_dispatch_find(dispatcher, msg_type, key, (uint8_t)length);
+    if (command->handler == NULL) {
+        if (dispatcher->command_count >= MESSAGE_DISPATCH_COMMAND_COUNT) {
+            return false;
+        }
+        dispatcher->command_count++;
+        command->msg_type = msg_type;
+        command->length = (uint8_t)length;
+        command->opcode = key;
+    }
+    command->handler = handler;
+    dispatcher->command_types |= (uint16_t)(1u << msg_type);
+    return true;
+}
+
+bool message_dispatch(Message_dispatcher *dispatcher, const Message *msg)
+{
+    uint8_t msg_type = msg->msg_type;
+    if (msg_type >= MESSAGE_DISPATCH_TYPE_COUNT) {
+        dispatcher->unhandled++;
+        return false;
+    }
+
+    // only the few message types that carry commands look at the payload
+    if ((dispatcher->command_types & (1u << msg_type)) != 0 && msg->length != 0 &&
+        msg->length <= MESSAGE_COMMAND_SIZE) {
+        uint16_t opcode = message_command_opcode(msg->payload, msg->length);
+        Message_command *command = message_dispatch_find(dispatcher, msg_type, opcode, msg->length);
+        if (command->handler != NULL) {
+            command->handler(msg);
+            return true;
+        }
+    }
+
+    Message_handler handler = dispatcher->handlers[msg_type];
+    if (handler == NULL) {
+        dispatcher->unhandled++;
+        return false;
+    }
+    handler(msg);
+    return true;
+}
@@ -0,0 +1,56 @@
+/*
+ * payload_messages.cpp file
+ *
+ * This file contains the only copy of every payload message, see payload_messages.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <lander_communication_lib/payload_messages.h>
+
+// All texts back to back, without null terminators or alignment between them
+#define PAYLOAD_MESSAGE_TEXT(name, text) text
+static const uint8_t payload_message_texts[] = PAYLOAD_MESSAGES(PAYLOAD_MESSAGE_TEXT);
+#undef PAYLOAD_MESSAGE_TEXT
+
+// Lengths in the order of the message IDs, only used by the compiler to fill in payload_message_offsets
+#define PAYLOAD_MESSAGE_LENGTH(name, text) MSG_LENGTH_##name,
+static constexpr uint8_t payload_message_lengths[] = {PAYLOAD_MESSAGES(PAYLOAD_MESSAGE_LENGTH)};
+#undef PAYLOAD_MESSAGE_LENGTH
+
+/*
+ * Position of a message in payload_message_texts, evaluated by the compiler.
+ */
+static constexpr uint16_t payload_message_offset(uint8_t id)
+{
+    return (id == 0) ? 0 : payload_message_offset(id - 1) + payload_message_lengths[id - 1];
+}
+
+// Start of every message, the last entry is the end of the last message
+#define PAYLOAD_MESSAGE_OFFSET(name, text) payload_message_offset(MSG_ID_##name),
+static const uint16_t payload_message_offsets[MSG_ID_END + 1] = {
+    PAYLOAD_MESSAGES(PAYLOAD_MESSAGE_OFFSET)
+    payload_message_offset(MSG_ID_END)
+};
+#undef PAYLOAD_MESSAGE_OFFSET
+
+static_assert(sizeof(payload_message_texts) == payload_message_offset(MSG_ID_END) + 1,
+              "the texts are stored back to back");
+
+const uint8_t *payload_message_text(Message_id id)
+{
+    if ((unsigned)id >= MSG_ID_END) {
+        id = MSG_ID_EMPTY;
+    }
+    return &payload_message_texts[payload_message_offsets[id]];
+}
+
+uint8_t payload_message_length(Message_id id)
+{
+    if ((unsigned)id >= MSG_ID_END) {
+        return 0;
+    }
+    return (uint8_t)(payload_message_offsets[id + 1] - payload_message_offsets[id]);
+}
@@ -0,0 +1,133 @@
+/*
+ * slip_frame_writer.cpp file
+ *
+ * This file contains the scatter-gather frame writer of the UART communication library. The Message protocol frame is
+ * SLIP encoded straight from the payload segments into the UART transmission queue.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <lander_communication_lib/slip_frame_writer.h>
+#include <string.h>
+
+/*
+ * Returns the amount of characters a byte takes after SLIP encoding.
+ */
+static inline uint8_t slip_encoded_size(uint8_t character)
+{
+    return (character == SLIP_END || character == SLIP_ESC) ? 2 : 1;
+}
+
+/*
+ * Writes one SLIP encoded byte at the given ring buffer index and returns the next index.
+ */
+static inline uint16_t slip_put(uint8_t *buffer, uint16_t head, uint8_t character)
+{
+    if (character == SLIP_END) {
+        buffer[head] = SLIP_ESC;
+        head = (head + 1) & UART_TX_QUEUE_MASK;
+        character = SLIP_ESC_END;
+    } else if (character == SLIP_ESC) {
+        buffer[head] = SLIP_ESC;
+        head = (head + 1) & UART_TX_QUEUE_MASK;
+        character = SLIP_ESC_ESC;
+    }
+    buffer[head] = character;
+    return (head + 1) & UART_TX_QUEUE_MASK;
+}
+
+/*
+ * Copies a segment that contains no SLIP characters into the ring buffer, in at most two parts.
+ */
+static inline uint16_t slip_copy(uint8_t *buffer, uint16_t head, const uint8_t *data, uint8_t length)
+{
+    uint16_t first_part_length = UART_TX_QUEUE_SIZE - head;
+    if (first_part_length > length) {
+        first_part_length = length;
+    }
+    memcpy(&buffer[head], data, first_part_length);
+    memcpy(buffer, data + first_part_length, length - first_part_length);
+    return (head + length) & UART_TX_QUEUE_MASK;
+}
+
+bool slip_frame_prepare(uint8_t msg_type, const Payload_segment *segments, uint8_t segment_count, Frame_check_type check,
+                        SLIP_frame_info *info)
+{
+    uint16_t length = 0;
+    uint16_t encoded_length = 0;
+
+    for (uint8_t s = 0; s < segment_count; s++) {
+        const uint8_t *data = segments[s].data;
+        for (uint8_t i = 0; i < segments[s].length; i++) {
+            encoded_length += slip_encoded_size(data[i]);
+        }
+        length += segments[s].length;
+    }
+    if (length > MAX_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    // same check as calculate_checksum_helper, the length is only known now
+    uint8_t header[2] = {msg_type, (uint8_t)length};
+    uint16_t checksum = frame_check_block(check, frame_check_init(check), header, sizeof(header));
+    for (uint8_t s = 0; s < segment_count; s++) {
+        checksum = frame_check_block(check, checksum, segments[s].data, segments[s].length);
+    }
+
+    info->msg_type = msg_type;
+    info->length = (uint8_t)length;
+    info->check = check;
+    info->checksum = checksum;
+    info->payload_escapes = (uint8_t)(encoded_length - length);
+    // two SLIP END characters, start byte, end byte and the encoded header and checksum fields
+    info->encoded_length = encoded_length + 4 + slip_encoded_size(msg_type) + slip_encoded_size((uint8_t)length)
+                           + slip_encoded_size((uint8_t)checksum);
+    if (check == FRAME_CHECK_CRC16) {
+        info->encoded_length += slip_encoded_size((uint8_t)(checksum >> 8));
+    }
+    return true;
+}
+
+void slip_frame_write(UART_TX_queue *queue, const SLIP_frame_info *info, const Payload_segment *segments,
+                      uint8_t segment_count)
+{
+    uint8_t *buffer = queue->buffer;
+    uint16_t head = queue->head;
+
+    buffer[head] = SLIP_END;
+    head = (head + 1) & UART_TX_QUEUE_MASK;
+    head = slip_put(buffer, head, MSG_START_BYTE);
+    head = slip_put(buffer, head, info->msg_type);
+    head = slip_put(buffer, head, info->length);
+
+    for (uint8_t s = 0; s < segment_count; s++) {
+        const uint8_t *data = segments[s].data;
+        if (info->payload_escapes == 0) {
+            // most payloads are plain text, those are copied without checking every byte again
+            head = slip_copy(buffer, head, data, segments[s].length);
+        } else {
+            for (uint8_t i = 0; i < segments[s].length; i++) {
+                head = slip_put(buffer, head, data[i]);
+            }
+        }
+    }
+
+    if (info->check == FRAME_CHECK_CRC16) {
+        // a CRC is sent high byte first
+        head = slip_put(buffer, head, (uint8_t)(info->checksum >> 8));
+    }
+    head = slip_put(buffer, head, (uint8_t)info->checksum);
+    head = slip_put(buffer, head, MSG_END_BYTE);
+    buffer[head] = SLIP_END;
+    head = (head + 1) & UART_TX_QUEUE_MASK;
+
+    // publish the complete frame to the interrupt only after it has been written
+    queue->head = head;
+
+    uint16_t used = uart_tx_queue_used(queue);
+    if (used > queue->high_water) {
+        queue->high_water = used;
+    }
+}
@@ -0,0 +1,231 @@
+/*
+ * slip_stream_decoder.cpp file
+ *
+ * This file contains the incremental SLIP decoder that is used inside the USCI_A1 RX interrupt. Every received character
+ * is un-escaped, checked against the Message protocol format and the payload is written straight into the RX ring buffer.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <lander_communication_lib/slip_stream_decoder.h>
+
+/*
+ * Rejects the current frame, gives its ring buffer space back and skips the rest of it.
+ */
+static SLIP_stream_result slip_stream_reject(SLIP_stream_decoder *decoder, SLIP_stream_result reason)
+{
+    decoder->write_index = decoder->frame_offset;
+    decoder->state = SLIP_STREAM_DISCARD;
+    decoder->escaped = false;
+    switch (reason) {
+        case SLIP_STREAM_INVALID_CHECKSUM:
+            decoder->invalid_checksums++;
+            break;
+        case SLIP_STREAM_OVERFLOW:
+            decoder->overflows++;
+            break;
+        default:
+            decoder->invalid_messages++;
+            break;
+    }
+    return reason;
+}
+
+/*
+ * Starts a new frame at the current write position of the ring buffer.
+ */
+static void slip_stream_open_frame(SLIP_stream_decoder *decoder)
+{
+    decoder->frame_offset = decoder->write_index;
+    decoder->state = SLIP_STREAM_START_BYTE;
+    decoder->escaped = false;
+}
+
+/*
+ * Handles one un-escaped character according to the Message protocol format.
+ */
+static SLIP_stream_result slip_stream_field(SLIP_stream_decoder *decoder, uint8_t character)
+{
+    switch (decoder->state) {
+        case SLIP_STREAM_START_BYTE:
+            if (character != MSG_START_BYTE) {
+                return slip_stream_reject(decoder, SLIP_STREAM_INVALID_MESSAGE);
+            }
+            decoder->state = SLIP_STREAM_MSG_TYPE;
+            break;
+        case SLIP_STREAM_MSG_TYPE:
+            decoder->msg_type = character;
+            decoder->checksum = frame_check_update(decoder->check, frame_check_init(decoder->check), character);
+            decoder->received_checksum = 0;
+            decoder->state = SLIP_STREAM_LENGTH;
+            break;
+        case SLIP_STREAM_LENGTH:
+            if (character > MAX_PAYLOAD_SIZE) {
+                return slip_stream_reject(decoder, SLIP_STREAM_INVALID_MESSAGE);
+            }
+            // check at the start whether the complete payload fits next to the frames the main loop still uses
+            if (character > ((decoder->read_index - decoder->write_index - 1) & decoder->ring_mask)) {
+                return slip_stream_reject(decoder, SLIP_STREAM_OVERFLOW);
+            }
+            decoder->length = character;
+            decoder->received = 0;
+            decoder->checksum = frame_check_update(decoder->check, decoder->checksum, character);
+            if (character != 0) {
+                decoder->state = SLIP_STREAM_PAYLOAD;
+            } else {
+                decoder->state = (decoder->check == FRAME_CHECK_CRC16) ? SLIP_STREAM_CHECKSUM_HIGH : SLIP_STREAM_CHECKSUM;
+            }
+            break;
+        case SLIP_STREAM_PAYLOAD:
+            decoder->ring[decoder->write_index] = character;
+            decoder->write_index = (decoder->write_index + 1) & decoder->ring_mask;
+            decoder->checksum = frame_check_update(decoder->check, decoder->checksum, character);
+            if (++decoder->received == decoder->length) {
+                decoder->state = (decoder->check == FRAME_CHECK_CRC16) ? SLIP_STREAM_CHECKSUM_HIGH : SLIP_STREAM_CHECKSUM;
+            }
+            break;
+        case SLIP_STREAM_CHECKSUM_HIGH:
+            // a CRC is sent high byte first
+            decoder->received_checksum = (uint16_t)character << 8;
+            decoder->state = SLIP_STREAM_CHECKSUM;
+            break;
+        case SLIP_STREAM_CHECKSUM:
+            decoder->received_checksum |= character;
+            if (decoder->received_checksum != decoder->checksum) {
+                return slip_stream_reject(decoder, SLIP_STREAM_INVALID_CHECKSUM);
+            }
+            decoder->state = SLIP_STREAM_END_BYTE;
+            break;
+        case SLIP_STREAM_END_BYTE:
+            if (character != MSG_END_BYTE) {
+                return slip_stream_reject(decoder, SLIP_STREAM_INVALID_MESSAGE);
+            }
+            decoder->state = SLIP_STREAM_COMPLETE;
+            break;
+        case SLIP_STREAM_COMPLETE:
+            // more data than the length byte announced
+            return slip_stream_reject(decoder, SLIP_STREAM_INVALID_MESSAGE);
+        default:
+            break;
+    }
+    return SLIP_STREAM_BUSY;
+}
+
+void slip_stream_init(SLIP_stream_decoder *decoder, uint8_t *ring, uint16_t ring_size, Frame_check_type check)
+{
+    decoder->ring = ring;
+    decoder->ring_mask = ring_size - 1;
+    decoder->read_index = 0;
+    decoder->write_index = 0;
+    decoder->frame_offset = 0;
+    decoder->state = SLIP_STREAM_OUT_OF_FRAME;
+    decoder->escaped = false;
+    decoder->msg_type = 0;
+    decoder->length = 0;
+    decoder->received = 0;
+    decoder->check = check;
+    decoder->checksum = 0;
+    decoder->received_checksum = 0;
+    decoder->last_frame.msg_type = 0;
+    decoder->last_frame.length = 0;
+    decoder->last_frame.offset = 0;
+    decoder->last_frame.checksum = 0;
+    decoder->invalid_messages = 0;
+    decoder->invalid_checksums = 0;
+    decoder->overflows = 0;
+}
+
+SLIP_stream_result slip_stream_decode_byte(SLIP_stream_decoder *decoder, uint8_t character)
+{
+    if (character == SLIP_END) {
+        switch (decoder->state) {
+            case SLIP_STREAM_COMPLETE:
+                // closing END of a valid frame, the same character may also open the next one
+                decoder->last_frame.msg_type = decoder->msg_type;
+                decoder->last_frame.length = decoder->length;
+                decoder->last_frame.offset = decoder->frame_offset;
+                decoder->last_frame.checksum = decoder->checksum;
+                decoder->frame_offset = decoder->write_index;
+                decoder->state = SLIP_STREAM_START_BYTE;
+                decoder->escaped = false;
+                return SLIP_STREAM_FRAME_READY;
+            case SLIP_STREAM_OUT_OF_FRAME:
+            case SLIP_STREAM_START_BYTE:
+            case SLIP_STREAM_DISCARD:
+                // opening END, or an empty frame between two END characters
+                slip_stream_open_frame(decoder);
+                return SLIP_STREAM_BUSY;
+            default: {
+                // frame ended before all fields were received
+                SLIP_stream_result result = slip_stream_reject(decoder, SLIP_STREAM_INVALID_MESSAGE);
+                slip_stream_open_frame(decoder);
+                return result;
+            }
+        }
+    }
+
+    if (decoder->state == SLIP_STREAM_OUT_OF_FRAME || decoder->state == SLIP_STREAM_DISCARD) {
+        return SLIP_STREAM_BUSY;
+    }
+
+    if (decoder->escaped) {
+        decoder->escaped = false;
+        if (character == SLIP_ESC_END) {
+            character = SLIP_END;
+        } else if (character == SLIP_ESC_ESC) {
+            character = SLIP_ESC;
+        } else {
+            return slip_stream_reject(decoder, SLIP_STREAM_INVALID_MESSAGE);
+        }
+    } else if (character == SLIP_ESC) {
+        decoder->escaped = true;
+        return SLIP_STREAM_BUSY;
+    }
+
+    return slip_stream_field(decoder, character);
+}
+
+void slip_stream_abort(SLIP_stream_decoder *decoder)
+{
+    decoder->write_index = decoder->frame_offset;
+    decoder->state = SLIP_STREAM_OUT_OF_FRAME;
+    decoder->escaped = false;
+}
+
+bool slip_stream_in_frame(const SLIP_stream_decoder *decoder)
+{
+    // a frame only counts as started once its first character after the opening END has arrived
+    return decoder->state != SLIP_STREAM_OUT_OF_FRAME && decoder->state != SLIP_STREAM_START_BYTE
+           && decoder->state != SLIP_STREAM_DISCARD;
+}
+
+void slip_stream_drop_last_frame(SLIP_stream_decoder *decoder)
+{
+    // nothing of the next frame has been written yet, so the write position can simply move back
+    decoder->write_index = decoder->last_frame.offset;
+    decoder->frame_offset = decoder->last_frame.offset;
+}
+
+void slip_stream_frame_to_message(const SLIP_stream_decoder *decoder, const SLIP_stream_frame *frame, Message *msg)
+{
+    msg->start_byte = MSG_START_BYTE;
+    msg->msg_type = frame->msg_type;
+    msg->length = frame->length;
+
+    // copy the payload out of the ring buffer
+    uint16_t index = frame->offset;
+    for (uint8_t i = 0; i < frame->length; i++) {
+        msg->payload[i] = decoder->ring[index];
+        index = (index + 1) & decoder->ring_mask;
+    }
+
+    msg->checksum = frame->checksum;
+    msg->end_byte = MSG_END_BYTE;
+}
+
+void slip_stream_release(SLIP_stream_decoder *decoder, const SLIP_stream_frame *frame)
+{
+    decoder->read_index = (frame->offset + frame->length) & decoder->ring_mask;
+}
@@ -0,0 +1,198 @@
+/*
+ * telemetry.cpp file
+ *
+ * This file contains the telemetry catalog and the ASCII and binary encoding of events and measurements, see
+ * telemetry.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <lander_communication_lib/telemetry.h>
+#include <stddef.h>
+
+#define TELEMETRY_EVENT(message, msg_type) {MSG_ID_##message, msg_type}
+
+// Events in the order of their ID, starting at ID 0x01
+static const Telemetry_event_info telemetry_events[] = {
+    TELEMETRY_EVENT(GENERAL_STARTUP, MSG_TYPE_RESPONSE),
+    TELEMETRY_EVENT(LAUNCH_INTEGRATION, MSG_TYPE_RESPONSE),
+    TELEMETRY_EVENT(TRANSIT, MSG_TYPE_RESPONSE),
+    TELEMETRY_EVENT(PRE_DEPLOYMENT, MSG_TYPE_RESPONSE),
+    TELEMETRY_EVENT(DEPLOYMENT, MSG_TYPE_RESPONSE),
+    TELEMETRY_EVENT(UMBILICAL_CONNECTED, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(UMBILICAL_NOT_CONNECTED, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(BUS_SENSE_BROKEN, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(TEMP_SENSOR_1_BROKEN, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(TEMP_SENSOR_2_BROKEN, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(SUPERCAP_VOLTAGE_ERROR, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(SUPERCAP_VOLTAGE_ZERO, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(ALL_NEA_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA1_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA1_NOT_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA2_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA2_NOT_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA3_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA3_NOT_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA4_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA4_NOT_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(SUPERCAP1_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(SUPERCAP1_NOT_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(SUPERCAP2_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(SUPERCAP2_NOT_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(SUPERCAP3_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(SUPERCAP3_NOT_READY, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(POWER_ROVER_OFF, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(DEPLOYMENT_COMPLETE, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(TOO_LARGE, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(INVALID_MESSAGE, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(INVALID_CHECKSUM, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(TASK_OVERRUN, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(NEA_SEQUENCE_ABORTED, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA_SEQUENCE_HELD, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA_SEQUENCE_RESUMED, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(BUS_OVERCURRENT, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(BUS_CURRENT_NORMAL, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(SUPERCAP_BROWNOUT, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(SUPERCAP_VOLTAGE_NORMAL, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA1_RELEASED, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA1_NOT_RELEASED, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(NEA2_RELEASED, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA2_NOT_RELEASED, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(NEA3_RELEASED, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA3_NOT_RELEASED, MSG_TYPE_ERROR),
+    TELEMETRY_EVENT(NEA4_RELEASED, MSG_TYPE_DATA),
+    TELEMETRY_EVENT(NEA4_NOT_RELEASED, MSG_TYPE_ERROR),
+};
+
+#define TELEMETRY_MEASUREMENT(message, decimals) {MSG_ID_##message, decimals}
+
+// Measurements in the order of their ID, starting at TELEMETRY_FIRST_MEASUREMENT
+static const Telemetry_measurement_info telemetry_measurements[] = {
+    TELEMETRY_MEASUREMENT(BUS_VOLTAGE, 3),
+    TELEMETRY_MEASUREMENT(SUPERCAP_VOLTAGE, 3),
+    TELEMETRY_MEASUREMENT(TEMP_SENSOR_1, 2),
+    TELEMETRY_MEASUREMENT(TEMP_SENSOR_2, 2),
+    TELEMETRY_MEASUREMENT(CPU_ACTIVE_GENERAL_STARTUP, 1),
+    TELEMETRY_MEASUREMENT(CPU_ACTIVE_LAUNCH_INTEGRATION, 1),
+    TELEMETRY_MEASUREMENT(CPU_ACTIVE_TRANSIT, 1),
+    TELEMETRY_MEASUREMENT(CPU_ACTIVE_PRE_DEPLOYMENT, 1),
+    TELEMETRY_MEASUREMENT(CPU_ACTIVE_DEPLOYMENT, 1),
+    TELEMETRY_MEASUREMENT(NEA1_SEQUENCE_TIME, 0),
+    TELEMETRY_MEASUREMENT(NEA2_SEQUENCE_TIME, 0),
+    TELEMETRY_MEASUREMENT(NEA3_SEQUENCE_TIME, 0),
+    TELEMETRY_MEASUREMENT(NEA4_SEQUENCE_TIME, 0),
+    TELEMETRY_MEASUREMENT(NEA1_SEQUENCE_ATTEMPTS, 0),
+    TELEMETRY_MEASUREMENT(NEA2_SEQUENCE_ATTEMPTS, 0),
+    TELEMETRY_MEASUREMENT(NEA3_SEQUENCE_ATTEMPTS, 0),
+    TELEMETRY_MEASUREMENT(NEA4_SEQUENCE_ATTEMPTS, 0),
+};
+
+static_assert(sizeof(telemetry_events) / sizeof(telemetry_events[0]) == TELEMETRY_EVENT_END - 1,
+              "every event ID needs a catalog entry");
+static_assert(sizeof(telemetry_measurements) / sizeof(telemetry_measurements[0]) ==
+              TELEMETRY_MEASUREMENT_END - TELEMETRY_FIRST_MEASUREMENT, "every measurement ID needs a catalog entry");
+
+const Telemetry_event_info *telemetry_event_info(uint8_t id)
+{
+    if (id == 0 || id >= TELEMETRY_EVENT_END) {
+        return NULL;
+    }
+    return &telemetry_events[id - 1];
+}
+
+const Telemetry_measurement_info *telemetry_measurement_info(uint8_t id)
+{
+    if (id < TELEMETRY_FIRST_MEASUREMENT || id >= TELEMETRY_MEASUREMENT_END) {
+        return NULL;
+    }
+    return &telemetry_measurements[id - TELEMETRY_FIRST_MEASUREMENT];
+}
+
+uint8_t telemetry_format_value(int16_t value, uint8_t decimals, uint8_t *text)
+{
+    uint8_t digits[5];
+    uint8_t digit_count = 0;
+    uint8_t length = 0;
+
+    // int32_t such that -32768 can be made positive
+    int32_t magnitude = value;
+    if (magnitude < 0) {
+        text[length++] = '-';
+        magnitude = -magnitude;
+    }
+
+    // digits from least to most significant, with at least one digit before the decimal point
+    do {
+        digits[digit_count++] = (uint8_t)(magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0 || digit_count <= decimals);
+
+    while (digit_count > 0) {
+        if (digit_count == decimals) {
+            text[length++] = '.';
+        }
+        text[length++] = (uint8_t)('0' + digits[--digit_count]);
+    }
+    return length;
+}
+
+bool telemetry_encode_event(Telemetry_format format, Telemetry_event event, Telemetry_frame *frame)
+{
+    const Telemetry_event_info *info = telemetry_event_info(event);
+    if (info == NULL) {
+        return false;
+    }
+
+    if (format == TELEMETRY_BINARY) {
+        frame->buffer[0] = (uint8_t)event;
+        frame->msg_type = MSG_TYPE_TELEMETRY;
+        frame->segments[0].data = frame->buffer;
+        frame->segments[0].length = 1;
+    } else {
+        frame->msg_type = info->msg_type;
+        frame->segments[0].data = payload_message_text((Message_id)info->message);
+        frame->segments[0].length = payload_message_length((Message_id)info->message);
+    }
+    frame->segment_count = 1;
+    return true;
+}
+
+bool telemetry_encode_measurement(Telemetry_format format, Telemetry_measurement measurement, int16_t value,
+                                  Telemetry_frame *frame)
+{
+    const Telemetry_measurement_info *info = telemetry_measurement_info(measurement);
+    if (info == NULL) {
+        return false;
+    }
+
+    if (format == TELEMETRY_BINARY) {
+        frame->buffer[0] = (uint8_t)measurement;
+        frame->buffer[1] = (uint8_t)((uint16_t)value >> 8);
+        frame->buffer[2] = (uint8_t)value;
+        frame->msg_type = MSG_TYPE_TELEMETRY;
+        frame->segments[0].data = frame->buffer;
+        frame->segments[0].length = TELEMETRY_MEASUREMENT_RECORD_SIZE;
+        frame->segment_count = 1;
+    } else {
+        frame->msg_type = MSG_TYPE_DATA;
+        frame->segments[0].data = frame->buffer;
+        frame->segments[0].length = telemetry_format_value(value, info->decimals, frame->buffer);
+        frame->segments[1].data = payload_message_text((Message_id)info->message);
+        frame->segments[1].length = payload_message_length((Message_id)info->message);
+        frame->segment_count = 2;
+    }
+    return true;
+}
+
+uint8_t telemetry_record_size(uint8_t id)
+{
+    if (telemetry_event_info(id) != NULL) {
+        return 1;
+    }
+    if (telemetry_measurement_info(id) != NULL) {
+        return TELEMETRY_MEASUREMENT_RECORD_SIZE;
+    }
+    return 0;
+}
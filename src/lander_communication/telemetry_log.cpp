@@ -0,0 +1,584 @@
+/*
+ * telemetry_log.cpp file
+ *
+ * This file contains the store-and-forward log of the telemetry, see telemetry_log.h for the layout in FRAM and what
+ * happens on a power failure.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <lander_communication_lib/telemetry_log.h>
+#include <lander_communication_lib/frame_check.h>
+#include <stddef.h>
+#include <string.h>
+
+#define TELEMETRY_LOG_CONTROL_SIZE ((uint16_t)sizeof(Telemetry_log_control))
+#define TELEMETRY_LOG_SLOT_SIZE ((uint16_t)sizeof(Telemetry_log_index_slot))
+
+// The ring has to hold at least two of the largest entries, such that an entry never has to drop itself
+#define TELEMETRY_LOG_MIN_RING_SIZE (2 * (TELEMETRY_LOG_ENTRY_OVERHEAD + TELEMETRY_LOG_MAX_PAYLOAD) + 1)
+
+static_assert((TELEMETRY_LOG_INDEX_INTERVAL & (TELEMETRY_LOG_INDEX_INTERVAL - 1)) == 0,
+              "TELEMETRY_LOG_INDEX_INTERVAL must be a power of 2");
+
+static uint16_t telemetry_log_crc(const uint8_t *data, uint16_t length)
+{
+    return frame_check_block(FRAME_CHECK_CRC16, frame_check_init(FRAME_CHECK_CRC16), data, length);
+}
+
+// CRC-16 of an entry, over its header and its payload. They are handled apart such that no copy of the whole entry
+// has to be kept on the stack.
+static uint16_t telemetry_log_entry_crc(const uint8_t *header, const uint8_t *payload, uint8_t length)
+{
+    uint16_t crc = telemetry_log_crc(header, TELEMETRY_LOG_ENTRY_HEADER_SIZE);
+    return frame_check_block(FRAME_CHECK_CRC16, crc, payload, length);
+}
+
+static void telemetry_log_put_u32(uint8_t *bytes, uint32_t value)
+{
+    bytes[0] = (uint8_t)value;
+    bytes[1] = (uint8_t)(value >> 8);
+    bytes[2] = (uint8_t)(value >> 16);
+    bytes[3] = (uint8_t)(value >> 24);
+}
+
+// Numbers in MSG_TYPE_LOG frames are sent high byte first
+static void telemetry_log_put_u32_high_first(uint8_t *bytes, uint32_t value)
+{
+    bytes[0] = (uint8_t)(value >> 24);
+    bytes[1] = (uint8_t)(value >> 16);
+    bytes[2] = (uint8_t)(value >> 8);
+    bytes[3] = (uint8_t)value;
+}
+
+static uint32_t telemetry_log_get_u32_high_first(const uint8_t *bytes)
+{
+    return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) | (uint32_t)bytes[3];
+}
+
+static uint32_t telemetry_log_get_u32(const uint8_t *bytes)
+{
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static void telemetry_log_write(Telemetry_log *log, uint8_t *destination, const void *source, uint16_t length)
+{
+    if (log->write != NULL) {
+        log->write(log, destination, (const uint8_t *)source, length);
+    } else {
+        memcpy(destination, source, length);
+    }
+}
+
+static uint16_t telemetry_log_advance(const Telemetry_log *log, uint16_t offset, uint16_t length)
+{
+    uint32_t next = (uint32_t)offset + length;
+    return (uint16_t)(next >= log->ring_size ? next - log->ring_size : next);
+}
+
+/*
+ * Copies bytes out of the ring, wrapping around at its end.
+ */
+static void telemetry_log_ring_read(const Telemetry_log *log, uint16_t offset, uint8_t *data, uint16_t length)
+{
+    uint16_t first = (uint16_t)(log->ring_size - offset);
+    if (length <= first) {
+        memcpy(data, &log->ring[offset], length);
+    } else {
+        memcpy(data, &log->ring[offset], first);
+        memcpy(&data[first], log->ring, (uint16_t)(length - first));
+    }
+}
+
+/*
+ * Writes bytes into the ring, wrapping around at its end.
+ */
+static void telemetry_log_ring_write(Telemetry_log *log, uint16_t offset, const uint8_t *data, uint16_t length)
+{
+    uint16_t first = (uint16_t)(log->ring_size - offset);
+    if (length <= first) {
+        telemetry_log_write(log, &log->ring[offset], data, length);
+    } else {
+        telemetry_log_write(log, &log->ring[offset], data, first);
+        telemetry_log_write(log, log->ring, &data[first], (uint16_t)(length - first));
+    }
+}
+
+/*
+ * Returns the bytes of the entries in the ring.
+ */
+static uint16_t telemetry_log_used(const Telemetry_log *log)
+{
+    if (log->control.next_seq == log->control.tail_seq) {
+        return 0;
+    }
+    if (log->control.head >= log->control.tail) {
+        return (uint16_t)(log->control.head - log->control.tail);
+    }
+    return (uint16_t)(log->ring_size - log->control.tail + log->control.head);
+}
+
+/*
+ * Returns the size of the committed entry at an offset, from its length byte.
+ */
+static uint16_t telemetry_log_entry_size(const Telemetry_log *log, uint16_t offset)
+{
+    uint8_t length;
+    telemetry_log_ring_read(log, telemetry_log_advance(log, offset, TELEMETRY_LOG_ENTRY_HEADER_SIZE - 1), &length, 1);
+    return (uint16_t)(TELEMETRY_LOG_ENTRY_OVERHEAD + length);
+}
+
+/*
+ * Reads the entry at an offset and checks that it is complete and has the expected sequence number.
+ */
+static bool telemetry_log_entry_check(const Telemetry_log *log, uint16_t offset, uint32_t seq,
+                                      Telemetry_log_entry *entry)
+{
+    uint8_t header[TELEMETRY_LOG_ENTRY_HEADER_SIZE];
+    telemetry_log_ring_read(log, offset, header, TELEMETRY_LOG_ENTRY_HEADER_SIZE);
+    uint8_t length = header[TELEMETRY_LOG_ENTRY_HEADER_SIZE - 1];
+    if (length == 0 || length > TELEMETRY_LOG_MAX_PAYLOAD || telemetry_log_get_u32(header) != seq) {
+        return false;
+    }
+    // the payload is read straight into the entry, it is only valid when the CRC matches
+    offset = telemetry_log_advance(log, offset, TELEMETRY_LOG_ENTRY_HEADER_SIZE);
+    telemetry_log_ring_read(log, offset, entry->payload, length);
+    uint8_t check[2];
+    telemetry_log_ring_read(log, telemetry_log_advance(log, offset, length), check, 2);
+    if (telemetry_log_entry_crc(header, entry->payload, length) != (uint16_t)(check[0] | (check[1] << 8))) {
+        return false;
+    }
+    entry->seq = seq;
+    entry->time = telemetry_log_get_u32(&header[4]);
+    entry->length = length;
+    return true;
+}
+
+/*
+ * Writes the control block into the older copy, which then becomes the current one.
+ */
+static void telemetry_log_commit(Telemetry_log *log)
+{
+    log->control.magic = TELEMETRY_LOG_MAGIC;
+    log->control.generation++;
+    log->control.check = telemetry_log_crc((const uint8_t *)&log->control, offsetof(Telemetry_log_control, check));
+    uint8_t older = (uint8_t)(log->current ^ 1);
+    telemetry_log_write(log, &log->block[older * TELEMETRY_LOG_CONTROL_SIZE], &log->control,
+                        TELEMETRY_LOG_CONTROL_SIZE);
+    log->current = older;
+}
+
+static bool telemetry_log_control_valid(const Telemetry_log *log, const Telemetry_log_control *control)
+{
+    return control->magic == TELEMETRY_LOG_MAGIC &&
+           control->check == telemetry_log_crc((const uint8_t *)control, offsetof(Telemetry_log_control, check)) &&
+           control->tail < log->ring_size && control->head < log->ring_size &&
+           control->tail_seq <= control->next_seq && control->acked_seq <= control->next_seq;
+}
+
+/*
+ * Checks every entry from the oldest one on, the log ends in front of the first entry that is damaged.
+ */
+static void telemetry_log_recover(Telemetry_log *log)
+{
+    Telemetry_log_entry entry;
+    uint16_t offset = log->control.tail;
+    uint32_t seq = log->control.tail_seq;
+    uint16_t used = 0;
+    uint16_t total = telemetry_log_used(log);
+    while (seq != log->control.next_seq) {
+        if (!telemetry_log_entry_check(log, offset, seq, &entry) ||
+            used + TELEMETRY_LOG_ENTRY_OVERHEAD + entry.length > total) {
+            log->control.head = offset;
+            log->control.next_seq = seq;
+            if (log->control.acked_seq > seq) {
+                log->control.acked_seq = seq;
+            }
+            telemetry_log_commit(log);
+            log->statistics.truncated++;
+            return;
+        }
+        used = (uint16_t)(used + TELEMETRY_LOG_ENTRY_OVERHEAD + entry.length);
+        offset = telemetry_log_advance(log, offset, (uint16_t)(TELEMETRY_LOG_ENTRY_OVERHEAD + entry.length));
+        seq++;
+    }
+    if (offset != log->control.head) {
+        // the entries end in front of the head, the bytes in between belong to no entry
+        log->control.head = offset;
+        telemetry_log_commit(log);
+        log->statistics.truncated++;
+    }
+}
+
+uint32_t telemetry_log_block_size(uint16_t ring_size, uint16_t index_slots)
+{
+    return 2u * TELEMETRY_LOG_CONTROL_SIZE + (uint32_t)index_slots * TELEMETRY_LOG_SLOT_SIZE + ring_size;
+}
+
+bool telemetry_log_open(Telemetry_log *log, uint8_t *block, uint16_t size, uint16_t index_slots,
+                        Telemetry_log_write_function write)
+{
+    uint32_t overhead = telemetry_log_block_size(0, index_slots);
+    if (index_slots == 0 || size < overhead + TELEMETRY_LOG_MIN_RING_SIZE) {
+        return false;
+    }
+    memset(&log->statistics, 0, sizeof(log->statistics));
+    log->block = block;
+    log->index_slots = index_slots;
+    log->index = &block[2 * TELEMETRY_LOG_CONTROL_SIZE];
+    log->ring = &block[overhead];
+    log->ring_size = (uint16_t)(size - overhead);
+    log->write = write;
+
+    // the newest of the valid control blocks
+    Telemetry_log_control copies[2];
+    memcpy(copies, block, sizeof(copies));
+    bool valid[2] = {telemetry_log_control_valid(log, &copies[0]), telemetry_log_control_valid(log, &copies[1])};
+    if (valid[0] && valid[1]) {
+        log->current = (int16_t)(copies[1].generation - copies[0].generation) > 0 ? 1 : 0;
+    } else if (valid[0] || valid[1]) {
+        log->current = valid[0] ? 0 : 1;
+    } else {
+        // a new block, the copy that is written first becomes the current one
+        memset(&log->control, 0, sizeof(log->control));
+        log->current = 1;
+        telemetry_log_commit(log);
+        log->time_offset = 0;
+        return true;
+    }
+    log->control = copies[log->current];
+    log->statistics.recovered++;
+    telemetry_log_recover(log);
+    log->time_offset = log->control.last_time;
+    return true;
+}
+
+void telemetry_log_clear(Telemetry_log *log)
+{
+    log->control.tail = log->control.head;
+    log->control.tail_seq = log->control.next_seq;
+    log->control.acked_seq = log->control.next_seq;
+    telemetry_log_commit(log);
+}
+
+bool telemetry_log_append(Telemetry_log *log, const uint8_t *payload, uint8_t length, uint32_t now)
+{
+    if (length == 0 || length > TELEMETRY_LOG_MAX_PAYLOAD) {
+        return false;
+    }
+    uint16_t size = (uint16_t)(TELEMETRY_LOG_ENTRY_OVERHEAD + length);
+    uint32_t time = log->time_offset + now;
+    if (time < log->control.last_time) {
+        time = log->control.last_time;
+    }
+
+    // drop the oldest entries before their bytes are overwritten, one byte stays free such that a full ring differs
+    // from an empty one
+    bool dropped = false;
+    while (log->control.tail_seq != log->control.next_seq && log->ring_size - telemetry_log_used(log) <= size) {
+        log->control.tail = telemetry_log_advance(log, log->control.tail,
+                                                  telemetry_log_entry_size(log, log->control.tail));
+        log->control.tail_seq++;
+        log->statistics.overwritten++;
+        dropped = true;
+    }
+    if (dropped) {
+        telemetry_log_commit(log);
+    }
+
+    // the entry only becomes part of the log with the commit after it. Header, payload and CRC are written one after
+    // the other, such that the entry is not copied on the stack.
+    uint8_t header[TELEMETRY_LOG_ENTRY_HEADER_SIZE];
+    uint32_t seq = log->control.next_seq;
+    uint16_t offset = log->control.head;
+    telemetry_log_put_u32(header, seq);
+    telemetry_log_put_u32(&header[4], time);
+    header[TELEMETRY_LOG_ENTRY_HEADER_SIZE - 1] = length;
+    uint16_t crc = telemetry_log_entry_crc(header, payload, length);
+    uint8_t check[2] = {(uint8_t)crc, (uint8_t)(crc >> 8)};
+    uint16_t position = offset;
+    telemetry_log_ring_write(log, position, header, TELEMETRY_LOG_ENTRY_HEADER_SIZE);
+    position = telemetry_log_advance(log, position, TELEMETRY_LOG_ENTRY_HEADER_SIZE);
+    telemetry_log_ring_write(log, position, payload, length);
+    telemetry_log_ring_write(log, telemetry_log_advance(log, position, length), check, 2);
+
+    log->control.head = telemetry_log_advance(log, offset, size);
+    log->control.next_seq = seq + 1;
+    log->control.last_time = time;
+    telemetry_log_commit(log);
+
+    if ((seq & (TELEMETRY_LOG_INDEX_INTERVAL - 1)) == 0) {
+        Telemetry_log_index_slot slot;
+        memset(&slot, 0, sizeof(slot));
+        slot.seq = seq;
+        slot.time = time;
+        slot.offset = offset;
+        uint16_t number = (uint16_t)((seq / TELEMETRY_LOG_INDEX_INTERVAL) % log->index_slots);
+        telemetry_log_write(log, &log->index[number * TELEMETRY_LOG_SLOT_SIZE], &slot, TELEMETRY_LOG_SLOT_SIZE);
+    }
+    return true;
+}
+
+uint32_t telemetry_log_count(const Telemetry_log *log)
+{
+    return log->control.next_seq - log->control.tail_seq;
+}
+
+/*
+ * Looks up the index slot of an entry whose sequence number is a multiple of TELEMETRY_LOG_INDEX_INTERVAL and checks
+ * the entry it points to. Only the offset of the slot is used, the rest comes from the checked entry.
+ */
+static bool telemetry_log_index_lookup(Telemetry_log *log, uint32_t seq, Telemetry_log_cursor *cursor,
+                                       Telemetry_log_entry *entry)
+{
+    if (seq < log->control.tail_seq || seq >= log->control.next_seq) {
+        return false;
+    }
+    Telemetry_log_index_slot slot;
+    uint16_t number = (uint16_t)((seq / TELEMETRY_LOG_INDEX_INTERVAL) % log->index_slots);
+    memcpy(&slot, &log->index[number * TELEMETRY_LOG_SLOT_SIZE], sizeof(slot));
+    if (slot.seq != seq || slot.offset >= log->ring_size ||
+        !telemetry_log_entry_check(log, slot.offset, seq, entry)) {
+        return false;
+    }
+    cursor->seq = seq;
+    cursor->offset = slot.offset;
+    return true;
+}
+
+static void telemetry_log_cursor_tail(const Telemetry_log *log, Telemetry_log_cursor *cursor)
+{
+    cursor->seq = log->control.tail_seq;
+    cursor->offset = log->control.tail;
+}
+
+void telemetry_log_seek_seq(Telemetry_log *log, uint32_t seq, Telemetry_log_cursor *cursor)
+{
+    if (seq >= log->control.next_seq) {
+        cursor->seq = log->control.next_seq;
+        cursor->offset = log->control.head;
+        return;
+    }
+    telemetry_log_cursor_tail(log, cursor);
+    if (seq <= log->control.tail_seq) {
+        return;
+    }
+
+    // start at the index slot in front of the entry, when it is newer than the oldest entry
+    uint32_t indexed = seq & ~(uint32_t)(TELEMETRY_LOG_INDEX_INTERVAL - 1);
+    if (indexed > log->control.tail_seq) {
+        Telemetry_log_entry entry;
+        if (telemetry_log_index_lookup(log, indexed, cursor, &entry)) {
+            log->statistics.index_hits++;
+        } else {
+            log->statistics.index_misses++;
+        }
+    }
+    while (cursor->seq < seq) {
+        cursor->offset = telemetry_log_advance(log, cursor->offset, telemetry_log_entry_size(log, cursor->offset));
+        cursor->seq++;
+    }
+}
+
+void telemetry_log_seek_time(Telemetry_log *log, uint32_t time, Telemetry_log_cursor *cursor)
+{
+    Telemetry_log_entry entry;
+    telemetry_log_cursor_tail(log, cursor);
+    if (log->control.tail_seq == log->control.next_seq || time > log->control.last_time) {
+        cursor->seq = log->control.next_seq;
+        cursor->offset = log->control.head;
+        return;
+    }
+
+    // the indexed entries that are still in the log and in the index, from old to new
+    uint32_t first = (log->control.tail_seq + TELEMETRY_LOG_INDEX_INTERVAL - 1) &
+                     ~(uint32_t)(TELEMETRY_LOG_INDEX_INTERVAL - 1);
+    uint32_t last = (log->control.next_seq - 1) & ~(uint32_t)(TELEMETRY_LOG_INDEX_INTERVAL - 1);
+    uint32_t span = (uint32_t)(log->index_slots - 1) * TELEMETRY_LOG_INDEX_INTERVAL;
+    if (last >= span && first < last - span) {
+        first = last - span;
+    }
+
+    // binary search for the newest indexed entry before the time, the entries from there on have rising times
+    if (first <= last) {
+        uint32_t low = 0;
+        uint32_t high = (last - first) / TELEMETRY_LOG_INDEX_INTERVAL;
+        bool found = false;
+        Telemetry_log_cursor candidate;
+        while (low <= high) {
+            uint32_t middle = low + (high - low) / 2;
+            if (!telemetry_log_index_lookup(log, first + middle * TELEMETRY_LOG_INDEX_INTERVAL, &candidate, &entry)) {
+                // a slot that cannot be trusted, walk from the oldest entry instead
+                log->statistics.index_misses++;
+                found = false;
+                telemetry_log_cursor_tail(log, cursor);
+                break;
+            }
+            if (entry.time < time) {
+                *cursor = candidate;
+                found = true;
+                low = middle + 1;
+            } else if (middle == 0) {
+                break;
+            } else {
+                high = middle - 1;
+            }
+        }
+        if (found) {
+            log->statistics.index_hits++;
+        }
+    }
+
+    while (cursor->seq != log->control.next_seq) {
+        uint8_t bytes[TELEMETRY_LOG_ENTRY_HEADER_SIZE];
+        telemetry_log_ring_read(log, cursor->offset, bytes, TELEMETRY_LOG_ENTRY_HEADER_SIZE);
+        if (telemetry_log_get_u32(&bytes[4]) >= time) {
+            return;
+        }
+        cursor->offset = telemetry_log_advance(log, cursor->offset,
+                                               (uint16_t)(TELEMETRY_LOG_ENTRY_OVERHEAD +
+                                                          bytes[TELEMETRY_LOG_ENTRY_HEADER_SIZE - 1]));
+        cursor->seq++;
+    }
+}
+
+bool telemetry_log_read(Telemetry_log *log, Telemetry_log_cursor *cursor, Telemetry_log_entry *entry)
+{
+    if (cursor->seq < log->control.tail_seq) {
+        telemetry_log_cursor_tail(log, cursor);
+    }
+    if (cursor->seq >= log->control.next_seq || !telemetry_log_entry_check(log, cursor->offset, cursor->seq, entry)) {
+        return false;
+    }
+    cursor->offset = telemetry_log_advance(log, cursor->offset,
+                                           (uint16_t)(TELEMETRY_LOG_ENTRY_OVERHEAD + entry->length));
+    cursor->seq++;
+    return true;
+}
+
+void telemetry_log_acknowledge(Telemetry_log *log, uint32_t seq)
+{
+    if (seq > log->control.next_seq) {
+        seq = log->control.next_seq;
+    }
+    if (seq > log->control.acked_seq) {
+        log->control.acked_seq = seq;
+        telemetry_log_commit(log);
+    }
+}
+
+void telemetry_log_replay_init(Telemetry_log_replay *replay)
+{
+    memset(replay, 0, sizeof(*replay));
+}
+
+/*
+ * Starts a replay from a cursor up to an entry and a time.
+ */
+static void telemetry_log_replay_start(Telemetry_log_replay *replay, const Telemetry_log_cursor *cursor,
+                                       uint32_t end_seq, uint32_t end_time)
+{
+    replay->cursor = *cursor;
+    replay->end_seq = end_seq;
+    replay->end_time = end_time;
+    replay->active = true;
+}
+
+void telemetry_log_replay_backlog(Telemetry_log *log, Telemetry_log_replay *replay)
+{
+    Telemetry_log_cursor cursor;
+    telemetry_log_seek_seq(log, log->control.acked_seq, &cursor);
+    telemetry_log_replay_start(replay, &cursor, UINT32_MAX, UINT32_MAX);
+}
+
+bool telemetry_log_command(Telemetry_log *log, Telemetry_log_replay *replay, const uint8_t *payload, uint8_t length)
+{
+    if (length == 0) {
+        return false;
+    }
+    Telemetry_log_cursor cursor;
+    switch (payload[0]) {
+        case TELEMETRY_LOG_SEQUENCE: {
+            if (length != 7) {
+                return false;
+            }
+            uint32_t first = telemetry_log_get_u32_high_first(&payload[1]);
+            uint16_t count = (uint16_t)((payload[5] << 8) | payload[6]);
+            uint32_t end = first + count < first ? UINT32_MAX : first + count;
+            telemetry_log_seek_seq(log, first, &cursor);
+            telemetry_log_replay_start(replay, &cursor, end, UINT32_MAX);
+            return true;
+        }
+        case TELEMETRY_LOG_TIME: {
+            if (length != 9) {
+                return false;
+            }
+            telemetry_log_seek_time(log, telemetry_log_get_u32_high_first(&payload[1]), &cursor);
+            telemetry_log_replay_start(replay, &cursor, UINT32_MAX, telemetry_log_get_u32_high_first(&payload[5]));
+            return true;
+        }
+        case TELEMETRY_LOG_BACKLOG:
+            if (length != 1) {
+                return false;
+            }
+            telemetry_log_replay_backlog(log, replay);
+            return true;
+        case TELEMETRY_LOG_ACK:
+            if (length != 5) {
+                return false;
+            }
+            telemetry_log_acknowledge(log, telemetry_log_get_u32_high_first(&payload[1]));
+            return true;
+        case TELEMETRY_LOG_STOP:
+            if (length != 1) {
+                return false;
+            }
+            replay->active = false;
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint8_t telemetry_log_replay_next(Telemetry_log *log, Telemetry_log_replay *replay, uint8_t *payload, uint8_t size)
+{
+    if (!replay->active) {
+        return 0;
+    }
+    uint8_t length = 1;
+    payload[0] = TELEMETRY_LOG_ENTRIES;
+    while (replay->cursor.seq < replay->end_seq) {
+        // the entry is only taken when it fits and is within the range
+        Telemetry_log_cursor next = replay->cursor;
+        Telemetry_log_entry entry;
+        if (!telemetry_log_read(log, &next, &entry) || entry.time > replay->end_time) {
+            replay->end_seq = replay->cursor.seq;
+            break;
+        }
+        if (entry.seq >= replay->end_seq) {
+            // entries in front of the range have been overwritten, the cursor moved into it
+            break;
+        }
+        if (length + TELEMETRY_LOG_REPLAY_HEADER_SIZE + entry.length > size) {
+            return length;
+        }
+        telemetry_log_put_u32_high_first(&payload[length], entry.seq);
+        telemetry_log_put_u32_high_first(&payload[length + 4], entry.time);
+        payload[length + 8] = entry.length;
+        memcpy(&payload[length + TELEMETRY_LOG_REPLAY_HEADER_SIZE], entry.payload, entry.length);
+        length = (uint8_t)(length + TELEMETRY_LOG_REPLAY_HEADER_SIZE + entry.length);
+        replay->cursor = next;
+        replay->sent_entries++;
+    }
+    if (length > 1) {
+        return length;
+    }
+
+    // nothing left in the range
+    payload[0] = TELEMETRY_LOG_FINISHED;
+    telemetry_log_put_u32_high_first(&payload[1], log->control.next_seq);
+    replay->active = false;
+    return 5;
+}
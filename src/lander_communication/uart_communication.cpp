@@ -3,12 +3,11 @@
  *
  * This is the UART communication library that contains the following functionality:
  *
- *  - starting, stopping, and resetting a timer
+ *  - starting, stopping, and resetting the inter-byte timeout (a software timer on the system tick)
  *  - Initialising and configure the UART pins and states
  *  - Enter data into UART transmission buffer
  *  - UART interrupt handler
  *  - ISR for A1 UART module
- *  - ISR for timer A0 module
  *
  *  The library works using interrupts for transmission and receiving of characters via the UART ports.
  *  It initialises the system to be used on the USCI_A1 module, since the PCB design of the RDS system
@@ -23,6 +22,9 @@
  */
 
 #include <lander_communication_lib/uart_communication.h>
+#include <lander_communication_lib/link_speed.h>
+#include <system_health_lib/low_power.h>
+#include <system_health_lib/main_system_init.h>
 #include <cstring>
 
 
@@ -39,53 +41,59 @@
 #define UCAxTXBUF UCA1TXBUF
 #define UCAxSTATW UCA1STATW
 
-/* The amount of ticks that need to be reached for the timeout to trigger
- *   The tick rate is tied to SMCLK, which in current implementation is configured to ~16Mhz.
- *   The clock is further divided by 8 and only triggers a tick on the rising edge.
- *   The time for the timer to expire is calculated by  TIMEOUT_TICKS / (CLOCK_FREQUENCY / DIVIDER)
- *   Current timeout = 2000 / (16M / 8) = 10000 / 2M = 0.001s = 1 ms
+/* Inter-byte timeout in ms of the system tick. A frame that stops halfway is thrown away after at least 1 ms, which is
+ * more than 10 characters at 115200 baud.
  */
-#define DEFAULT_TIMEOUT_TICKS 2000
+#define UART_RX_TIMEOUT_MS 2
 
 
+/* transmission queue, filled by uart_write and emptied by the TX interrupt */
+UART_TX_queue TX_queue;
+volatile UART_TX_full_policy TX_full_policy = UART_TX_BLOCK;
+
+/* the last byte written to UCAxTXBUF has left the shift register, set by the UCTXCPTIFG interrupt */
+static volatile bool TX_complete = true;
+
+/* receive ring buffer, holds the decoded payloads of the received frames */
 uint8_t RX_buffer[UART_BUFFER_SIZE];
-volatile uint16_t RX_start = 0;
-volatile uint16_t RX_end = 0;
+SLIP_stream_decoder RX_decoder;
 
-/* size of incoming message */
-volatile uint16_t message_pointer;
+/* descriptors of the validated frames that are waiting for the main loop */
+UART_RX_queue RX_queue;
 
 /* uart state definition */
 volatile UART_states UART_state;
 
 /* bools for uart states*/
-bool buffer_full_state = false;
-bool error_state = false;
-bool timeout_state = false;
+volatile bool buffer_full_state = false;
+volatile bool error_state = false;
+volatile bool checksum_error_state = false;
+volatile bool timeout_state = false;
 
+/* inter-byte timeout, a software timer on the system tick */
+static Soft_timer RX_timeout;
 
-/**
- * Starts the timer that runs on TA1 module
- *
- */
-inline static void start_timeout(void);
 
-/**
- * resets the timer to 0 that runs on TA1 module
+/*
+ * Throws away a frame that stopped halfway, called by the software timer RX_timeout in the interrupt of the system tick.
  *
+ * parameters:
+ *  Soft_timer *timer: RX_timeout
  */
-inline static void reset_timeout(void);
+static void uart_rx_timeout(Soft_timer *timer);
 
 /**
- * Stops/Disables the timer that runs on TA1 module
- *
+ * Configures the A1 module to initialise pins 2.6 (RX) and 2.5 (TX) as UART at the default link speed of 115200 baud/s.
  */
-inline static void stop_timeout(void);
+void uart_init(void);
 
-/**
- * Configures the A1 module to initialise pins 2.6 (RX) and 2.5 (TX) as UART at a baud rate of 115200 baud/s.
+/*
+ * Changes the baud rate of the A1 module.
+ *
+ * parameters:
+ *  const UART_baud_setting *setting: register settings of the baud rate
  */
-void uart_init(void);
+void uart_set_baud(const UART_baud_setting *setting);
 
 /**
  * Configures the UART state and indexes of the buffers
@@ -98,8 +106,16 @@ void uart_configure(void);
  * parameters:
  *  const uint8_t* data: This is the address of array to be sent.
  *  uint16_t length: This is the length of the array to be sent.
+ *
+ * Returns:
+ *  bool : false if the data has been dropped because the queue was full
+ */
+bool uart_write(const uint8_t *data, uint16_t length);
+
+/**
+ * Puts the next queued byte into the transmission register, or disables the TX interrupt when the queue is empty
  */
-void uart_write(uint8_t *data, uint16_t length);
+inline static void uart_transmit_next_byte(void);
 
 /**
  * Generic handler for UART interrupts
@@ -110,46 +126,13 @@ void uart_write(uint8_t *data, uint16_t length);
 inline static void uart_interrupt_handler(uint8_t character);
 
 
-inline static void start_timeout(void)
-{
-    // TACCR0 interrupt enabled
-    TA1CCTL0 = CCIE; // enable the interrupt
-    TA1CCR0 = DEFAULT_TIMEOUT_TICKS; // set timeout time
-    // SMCLK, UP mode, divide the clock by 64 (8 from ID and 8 from TAIDEX)
-    TA1CTL = TASSEL__SMCLK | MC__UP | ID__8;
-    TA1EX0 |= 8; // Further divide by 8
-}
-
-inline static void reset_timeout(void)
+static void uart_rx_timeout(Soft_timer *timer)
 {
-    TA1CTL = MC__STOP | TACLR;
-
-    // resets it again
-    TA1CCTL0 = CCIE;
-    TA1CCR0 = DEFAULT_TIMEOUT_TICKS;
-    TA1CTL = TASSEL__SMCLK | MC__UP | ID__8;
-    TA1EX0 |= 8; // Further divide by 8
-}
-
-inline static void stop_timeout(void)
-{
-    // Stops the timer
-    TA1CTL = MC__STOP | TACLR;
-}
-
-// Timer A1 interrupt service routine
-#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
-#pragma vector = TIMER1_A0_VECTOR
-__interrupt void Timer1_A0_ISR(void)
-#elif defined(__GNUC__)
-void __attribute__ ((interrupt(TIMER1_A0_VECTOR))) Timer1_A0_ISR (void)
-#else
-#error Compiler not supported!
-#endif
-{
-    UART_state = TIMEOUT; // should be TIMEOUT
+    // the frame stopped halfway, throw away what has been received of it
+    slip_stream_abort(&RX_decoder);
+    UART_state = uart_rx_queue_is_empty(&RX_queue) ? TIMEOUT : RECEIVED;
     timeout_state = true;
-    stop_timeout();
+    // the tick interrupt wakes the CPU
 }
 
 
@@ -173,13 +156,22 @@ void __attribute__((interrupt(USCI_A1_VECTOR))) USCI_A1_ISR(void)
         {
             uint8_t character = UCA1RXBUF; // save incoming character
             uart_interrupt_handler(character); // handle the incoming character
+            // only a complete frame or an error is work for process_received_data
+            if(UART_state == RECEIVED || error_state || checksum_error_state || buffer_full_state)
+            {
+                LOW_POWER_WAKE_ON_EXIT();
+            }
         }
         break;
         case USCI_UART_UCTXIFG: // vector 4 - TXIFG
+            uart_transmit_next_byte(); // send the next queued character
+            LOW_POWER_WAKE_ON_EXIT(); // there is room in the queue for a waiting uart_tx_reserve or uart_flush
             break;
         case USCI_UART_UCSTTIFG:
             break;
-        case USCI_UART_UCTXCPTIFG:
+        case USCI_UART_UCTXCPTIFG: // only enabled by uart_flush
+            TX_complete = true;
+            LOW_POWER_WAKE_ON_EXIT();
             break;
         default:
             break;
@@ -203,163 +195,203 @@ void uart_init(void)
     UCAxCTL1 |= UCSSEL__SMCLK;    // CLK = SMCLK, which currently is set to
                                    // 16Mhz (can be changed in future!)
 
-    // User's Guide Table 30-5:
+    // User's Guide Table 30-5, calculated by uart_baud_setting() (UART_BRCLK_HZ has to match SMCLK):
     // UCBRx = 8
     // UCOS16 = 1
     // UCBRFx = 10
     // UCBRSx = 0xF7
-    UCAxBR0_local = 8;    // UCA1BR0 is int(16000000/(16*115200)) = 8
-    UCAxBR1_local = 0x00;
-    UCAxMCTLW |= UCOS16 | UCBRF_10 | 0xF700;    // UCOS16 enables over-sampling mode for high clock
-                                                // speeds UCBRF_10 is int ((8.6805555555-8)*16) = 10
-                                                // 0xF7 is the UCBRS modulation value
+    uart_set_baud(&link_speed_settings[LINK_SPEED_DEFAULT]);
+}
+
+void uart_set_baud(const UART_baud_setting *setting)
+{
+    UCAxCTL1 |= UCSWRST;    // the baud rate can only be changed while the eUSCI is in reset
+
+    UCAxBR0_local = (uint8_t)setting->brw;
+    UCAxBR1_local = (uint8_t)(setting->brw >> 8);
+    UCAxMCTLW = setting->mctlw;
 
     UCAxCTL1 &= ~UCSWRST;    // Initialize eUSCI by clearing reset
 
-    UCAxIE |= UCRXIE;    // Enable USCI_A1 RX
+    UCAxIE |= UCRXIE;    // Enable USCI_A1 RX, the reset clears the interrupt enables
 }
 
 void uart_configure(void)
 {
     UART_state = IDLE;
+    uart_tx_queue_init(&TX_queue);
+    TX_complete = true;
+    slip_stream_init(&RX_decoder, RX_buffer, UART_BUFFER_SIZE, LANDER_LINK_FRAME_CHECK);
+    uart_rx_queue_init(&RX_queue);
+    system_timer_stop(&RX_timeout);
+    soft_timer_init(&RX_timeout, uart_rx_timeout, NULL);
     transit_state = GENERAL_STARTUP;
     uart_init();
 }
 
 
 
-void uart_write(uint8_t *data, uint16_t length)
+bool uart_write(const uint8_t *data, uint16_t length)
 {
-    uint16_t i;
-    for(i = 0; i < length; i++)
+    // a frame is either queued completely or not at all when dropping is allowed
+    if(TX_full_policy == UART_TX_DROP_FRAME && uart_tx_queue_free(&TX_queue) < length)
     {
-        // check if TX buffer is ready.
-        while(!(UCAxIFG & UCTXIFG)) {}
-        UCAxTXBUF = data[i];
+        TX_queue.dropped_frames++;
+        return false;
     }
-}
 
-inline static void uart_interrupt_handler(uint8_t character)
-{
-    // Put state in receiving mode if the state is idle and prepare for receiving a message
-    if(UART_state == IDLE)
+    uint16_t written = 0;
+    while(written < length)
     {
-        message_pointer = 0;
-        // Check if its a valid start of the message, otherwise, do nothing
-        if(character == 0xC0)
+        written += uart_tx_queue_push(&TX_queue, &data[written], length - written);
+        // (re)enable the TX interrupt, uart_transmit_next_byte left UCTXIFG set when the queue ran empty so this starts
+        // sending
+        UCAxIE |= UCTXIE;
+        if(written < length)
         {
-            RX_buffer[RX_end] = character;
-            RX_end = (RX_end + 1) % UART_BUFFER_SIZE;
-            message_pointer++;
-            UART_state = RECEIVING;
-            start_timeout();
+            // the queue is full, sleep until the interrupt has sent a byte
+            LOW_POWER_WAIT_UNTIL(uart_tx_queue_free(&TX_queue) != 0);
         }
     }
-    // Check if state is in receiving mode to receive messages
-    else if(UART_state == RECEIVING)
-    {
+    return true;
+}
 
-        // reset timeout, to not cause a timeout
-        reset_timeout();
+bool uart_tx_reserve(uint16_t length)
+{
+    // frames are written into the queue in one go, so they can never be larger than the queue itself
+    if(length > UART_TX_QUEUE_SIZE - 1)
+    {
+        TX_queue.dropped_frames++;
+        return false;
+    }
 
-        if(message_pointer >= UART_BUFFER_SIZE - 1)
+    if(uart_tx_queue_free(&TX_queue) < length)
+    {
+        if(TX_full_policy == UART_TX_DROP_FRAME)
         {
-            UART_state = BUFFER_FULL;
-            buffer_full_state = true;
+            TX_queue.dropped_frames++;
+            return false;
         }
-        else
-        {
-            RX_buffer[RX_end] = character;
-            RX_end = (RX_end + 1) % UART_BUFFER_SIZE;
-            message_pointer++;
+        // make sure the interrupt is emptying the queue and sleep until there is room
+        UCAxIE |= UCTXIE;
+        LOW_POWER_WAIT_UNTIL(uart_tx_queue_free(&TX_queue) >= length);
+    }
+    return true;
+}
 
-            // If this is the last byte, set state to RECEIVED
-            if (character == 0xC0)
-            {
-                stop_timeout();
-                UART_state = RECEIVED;
-            }
-        }
+void uart_tx_start(void)
+{
+    // uart_transmit_next_byte left UCTXIFG set when the queue ran empty, so this starts sending
+    UCAxIE |= UCTXIE;
+}
+
+void uart_flush(void)
+{
+    // sleep until the interrupt has taken every byte out of the queue and the last one has left the shift register.
+    // UCBUSY cannot tell the latter, it is also set while a byte is received.
+    UCAxIE |= UCTXCPTIE;
+    LOW_POWER_WAIT_UNTIL(uart_tx_queue_is_empty(&TX_queue) && TX_complete);
+    UCAxIE &= ~UCTXCPTIE;
+}
+
+uint16_t uart_tx_pending(void)
+{
+    return uart_tx_queue_used(&TX_queue);
+}
+
+inline static void uart_transmit_next_byte(void)
+{
+    uint8_t character;
+    if(uart_tx_queue_pop(&TX_queue, &character))
+    {
+        UCAxTXBUF = character; // writing the buffer clears UCTXIFG until the byte has moved to the shift register
+        // the previous byte may have completed just before, UCTXCPTIFG is only set again after this one
+        UCAxIFG &= ~UCTXCPTIFG;
+        TX_complete = false;
     }
-    // Add additional state handling if needed
-    else if (UART_state == BUFFER_FULL)
+    else
+    {
+        // nothing left to send. Reading UCA1IV has cleared UCTXIFG although the buffer is empty, set it again such that
+        // the interrupt is taken right away when uart_write or uart_tx_start enables it again
+        UCAxIFG |= UCTXIFG;
+        UCAxIE &= ~UCTXIE;
+    }
+}
+
+inline static void uart_interrupt_handler(uint8_t character)
+{
+    // decode the character right away, the payload ends up in RX_buffer
+    switch(slip_stream_decode_byte(&RX_decoder, character))
     {
-        // Handle buffer full state if needed
-        // For example, log an error or reset the state
-        RX_start = 0;
-        RX_end = 0;
-        // send ERROR msg
-        stop_timeout();
-        UART_state == IDLE;
+        case SLIP_STREAM_FRAME_READY:
+            if(!uart_rx_queue_push(&RX_queue, &RX_decoder.last_frame))
+            {
+                // every descriptor is in use, give the ring buffer space back (counted in RX_queue.dropped_frames)
+                slip_stream_drop_last_frame(&RX_decoder);
+            }
+            break;
+        case SLIP_STREAM_INVALID_MESSAGE:
+            error_state = true;
+            break;
+        case SLIP_STREAM_INVALID_CHECKSUM:
+            checksum_error_state = true;
+            break;
+        case SLIP_STREAM_OVERFLOW:
+            buffer_full_state = true;
+            break;
+        default:
+            break;
     }
-    else if (UART_state == ERROR)
+
+    // restart the inter-byte timeout while a frame is being received, earlier frames keep waiting in RX_queue
+    bool frames_waiting = !uart_rx_queue_is_empty(&RX_queue);
+    if(slip_stream_in_frame(&RX_decoder))
     {
-        // Handle error state if needed
-        // For example, log an error or reset the state
-        RX_start = 0;
-        RX_end = 0;
-        // send ERROR msg
-        stop_timeout();
-        UART_state == IDLE;
+        system_timer_start(&RX_timeout, UART_RX_TIMEOUT_MS, 0);
+        UART_state = frames_waiting ? RECEIVED : RECEIVING;
     }
-    else if (UART_state == TIMEOUT)
+    else
     {
-        // Handle timeout state if needed
-        // For example, log an error or reset the state
-        RX_start = 0;
-        RX_end = 0;
-        // send ERROR msg
-        stop_timeout();
-        UART_state == IDLE;
+        system_timer_stop(&RX_timeout);
+        UART_state = frames_waiting ? RECEIVED : IDLE;
     }
-    else {}
 }
 
-uint16_t read_RX_buffer(uint16_t start, uint16_t end){
-    // Process received data
-    uint16_t input_length = (end >= start) ? (end - start) : (UART_BUFFER_SIZE - start + end);
-    uint8_t decoded_msg[UART_BUFFER_SIZE];
-    uint16_t decoded_length;
-    // create a message
-    Message msg;
-    Message* msg_pointer = &msg;
-
-    // Temporary buffer to hold the data from the circular buffer
-    uint8_t temp_buffer[UART_BUFFER_SIZE];
-    uint16_t temp_length = 0;
-
-    // Copy data from the circular buffer to the temporary buffer
-    if (end >= start) {
-        memcpy(temp_buffer, &RX_buffer[start], input_length);
-        temp_length = input_length;
-    } else {
-        uint16_t first_part_length = UART_BUFFER_SIZE - start;
-        memcpy(temp_buffer, &RX_buffer[start], first_part_length);
-        memcpy(temp_buffer + first_part_length, RX_buffer, end);
-        temp_length = first_part_length + end;
+bool uart_receive_frame(Message *msg)
+{
+    const SLIP_stream_frame *frame = uart_rx_queue_peek(&RX_queue);
+    if(frame == NULL)
+    {
+        return false;
     }
 
-    // Decode the SLIP-encoded message
-    slip_decode(temp_buffer, temp_length, decoded_msg, &decoded_length);
+    // single copy from the ring buffer into the message structure
+    slip_stream_frame_to_message(&RX_decoder, frame, msg);
 
-    // Deserialize the message
-    bool result = convert_array_to_message(decoded_msg, decoded_length, msg_pointer);
+    // give the ring buffer space and the descriptor back, the interrupt may fill them again right away
+    slip_stream_release(&RX_decoder, frame);
+    uart_rx_queue_pop(&RX_queue);
 
-    if(!result){
-        // Handle error
-        send_message(MSG_TYPE_ERROR, PAYLOAD_INVALID_MESSAGE, sizeof(PAYLOAD_INVALID_MESSAGE) - 1);
+    __disable_interrupt();
+    if(UART_state == RECEIVED && uart_rx_queue_is_empty(&RX_queue))
+    {
+        UART_state = slip_stream_in_frame(&RX_decoder) ? RECEIVING : IDLE;
     }
+    __enable_interrupt();
+    return true;
+}
 
-    // Handle the message
-    handle_message(msg_pointer);
-
-    // Clean up the dynamically allocated message
-    delete msg_pointer;
-
-    // reset the start index
-    start = end;
-
-    // return the updated start index
-    return start;
+uint8_t uart_rx_pending(void)
+{
+    return uart_rx_queue_count(&RX_queue);
 }
 
+void uart_rx_get_statistics(UART_RX_statistics *statistics)
+{
+    statistics->received_frames = RX_queue.received_frames;
+    statistics->dropped_frames = RX_queue.dropped_frames;
+    statistics->overflows = RX_decoder.overflows;
+    statistics->invalid_messages = RX_decoder.invalid_messages;
+    statistics->invalid_checksums = RX_decoder.invalid_checksums;
+    statistics->high_water = RX_queue.high_water;
+}
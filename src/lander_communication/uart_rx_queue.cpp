@@ -0,0 +1,71 @@
+/*
+ * uart_rx_queue.cpp file
+ *
+ * This file contains the receive queue of the UART communication library. The RX interrupt places a descriptor of every
+ * validated frame in the queue and the main loop takes them out again in the order in which the frames arrived.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <lander_communication_lib/uart_rx_queue.h>
+#include <stddef.h>
+
+void uart_rx_queue_init(UART_RX_queue *queue)
+{
+    queue->head = 0;
+    queue->tail = 0;
+    queue->received_frames = 0;
+    queue->dropped_frames = 0;
+    queue->high_water = 0;
+}
+
+uint8_t uart_rx_queue_count(const UART_RX_queue *queue)
+{
+    return (uint8_t)(queue->head - queue->tail) & UART_RX_QUEUE_MASK;
+}
+
+bool uart_rx_queue_is_empty(const UART_RX_queue *queue)
+{
+    return queue->head == queue->tail;
+}
+
+bool uart_rx_queue_push(UART_RX_queue *queue, const SLIP_stream_frame *frame)
+{
+    uint8_t head = queue->head;
+    uint8_t next = (head + 1) & UART_RX_QUEUE_MASK;
+    if (next == queue->tail) {
+        queue->dropped_frames++;
+        return false;
+    }
+    queue->frames[head] = *frame;
+
+    // publish the descriptor to the main loop only after it has been written
+    queue->head = next;
+    queue->received_frames++;
+
+    uint8_t count = uart_rx_queue_count(queue);
+    if (count > queue->high_water) {
+        queue->high_water = count;
+    }
+    return true;
+}
+
+const SLIP_stream_frame *uart_rx_queue_peek(const UART_RX_queue *queue)
+{
+    if (queue->tail == queue->head) {
+        return NULL;
+    }
+    return &queue->frames[queue->tail];
+}
+
+bool uart_rx_queue_pop(UART_RX_queue *queue)
+{
+    uint8_t tail = queue->tail;
+    if (tail == queue->head) {
+        return false;
+    }
+    queue->tail = (tail + 1) & UART_RX_QUEUE_MASK;
+    return true;
+}
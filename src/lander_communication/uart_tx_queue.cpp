@@ -0,0 +1,90 @@
+/*
+ * uart_tx_queue.cpp file
+ *
+ * This file contains the transmission queue of the UART communication library. Bytes that have to be sent to the lander
+ * are placed in a ring buffer by the main loop and are taken out again one by one by the USCI_A1 TX interrupt.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <lander_communication_lib/uart_tx_queue.h>
+#include <string.h>
+
+void uart_tx_queue_init(UART_TX_queue *queue)
+{
+    queue->head = 0;
+    queue->tail = 0;
+    queue->dropped_frames = 0;
+    queue->high_water = 0;
+}
+
+uint16_t uart_tx_queue_used(const UART_TX_queue *queue)
+{
+    return (uint16_t)(queue->head - queue->tail) & UART_TX_QUEUE_MASK;
+}
+
+uint16_t uart_tx_queue_free(const UART_TX_queue *queue)
+{
+    return (UART_TX_QUEUE_SIZE - 1) - uart_tx_queue_used(queue);
+}
+
+bool uart_tx_queue_is_empty(const UART_TX_queue *queue)
+{
+    return queue->head == queue->tail;
+}
+
+uint16_t uart_tx_queue_push(UART_TX_queue *queue, const uint8_t *data, uint16_t length)
+{
+    uint16_t free_space = uart_tx_queue_free(queue);
+    if (length > free_space) {
+        length = free_space;
+    }
+
+    // copy in at most two parts, the second one starts at the beginning of the ring
+    uint16_t head = queue->head;
+    uint16_t first_part_length = UART_TX_QUEUE_SIZE - head;
+    if (first_part_length > length) {
+        first_part_length = length;
+    }
+    memcpy(&queue->buffer[head], data, first_part_length);
+    memcpy(queue->buffer, data + first_part_length, length - first_part_length);
+
+    // publish the bytes to the interrupt only after they have been written
+    queue->head = (head + length) & UART_TX_QUEUE_MASK;
+
+    uint16_t used = uart_tx_queue_used(queue);
+    if (used > queue->high_water) {
+        queue->high_water = used;
+    }
+    return length;
+}
+
+bool uart_tx_queue_push_byte(UART_TX_queue *queue, uint8_t byte)
+{
+    uint16_t head = queue->head;
+    uint16_t next = (head + 1) & UART_TX_QUEUE_MASK;
+    if (next == queue->tail) {
+        return false;
+    }
+    queue->buffer[head] = byte;
+    queue->head = next;
+
+    uint16_t used = uart_tx_queue_used(queue);
+    if (used > queue->high_water) {
+        queue->high_water = used;
+    }
+    return true;
+}
+
+bool uart_tx_queue_pop(UART_TX_queue *queue, uint8_t *byte)
+{
+    uint16_t tail = queue->tail;
+    if (tail == queue->head) {
+        return false;
+    }
+    *byte = queue->buffer[tail];
+    queue->tail = (tail + 1) & UART_TX_QUEUE_MASK;
+    return true;
+}
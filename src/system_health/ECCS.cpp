@@ -20,17 +20,35 @@
 // Global variable for current task
 ECCSTaskState EECSTask = TASK_CHECK_UMBILICAL_ECCS;
 
+// Temperatures of the running sweep, used by the heat resistor control
+static uint16_t period_of_sensor_1 = PERIOD_CAPTURE_MISSING;
+static uint16_t period_of_sensor_2 = PERIOD_CAPTURE_MISSING;
+// Analog channels of the running sweep, converted once for the bus sense and the supercap check
+static Adc_snapshot ECCS_snapshot;
+// Filters of the analog channels over the sweeps: a sweep with a spike of a channel is replaced by the median of its last
+// ECCS_FILTER_WINDOW sweeps and the voltage that is sent is the average of the sweeps without spikes. A lasting change
+// passes after half of the window, the ADC monitor still reports a channel that leaves its window at once.
+static Hampel_filter<uint16_t, ECCS_FILTER_WINDOW, ECCS_FILTER_MIN_DEVIATION> ECCS_outliers[ADC_CHANNEL_COUNT];
+static Ema_filter<uint16_t, ECCS_FILTER_SHIFT> ECCS_averages[ADC_CHANNEL_COUNT];
+// Whether the running sweep has opened its message batch
+static bool ECCS_batch_open = false;
+
+// Filters the result of a channel in the snapshot of the running sweep and converts it to a voltage in mV
+static uint16_t ECCS_filtered_millivolts(Adc_channel channel) {
+    uint16_t sample = ECCS_outliers[channel].update(ECCS_snapshot.raw[channel]);
+    return adc_to_millivolts(ECCS_averages[channel].update(sample));
+}
+
 void initialize_all_electronic_pins(void){
     // initialize the umbilicalcord readout pin 2.2
     initialize_umbilicalcord_pin_rover();
     // initialize the umbilicalcord detach pin 4.6
     initialize_umbilicalcord_detach_pin();
-    // initialize the general adc settings
-    initialize_adc_general();
+    // initialize the adc sequence of all analog channels and monitor them between the readouts
+    initialize_adc_sequence();
+    adc_monitor_start();
     // initialize bus current readout pin 4.3
     initialize_bus_current_sense_pin();
-    //initialize the adc settings for the bus current readout pin 4.3
-//    initialize_adc_bus_sense();
     // initialize bus flag pin 4.2 for conduction to the rover
     initialize_bus_flag_pin();
     // initialise temperature sensor pins
@@ -41,147 +59,177 @@ void initialize_all_electronic_pins(void){
     initialize_charge_cap_flags();
     // initialize the supercap voltage pin 2.4
     initialize_capready();
-    // initialize adc for supercaps
-//    initialize_adc_supercaps();
     // initialize all nea pins for ready signals and flags
     initialize_all_nea_pins();
+    // initialize the NEA firing sequence and its lander commands
+    NEA_sequence_init();
     // initialize the led on pin 1.5
     init_LED();
     // initialize heater pins
     initialize_heat_resistor_pins();
 }
 
-void RDS_electronics_status_check(void) {
-    EECSTask = TASK_CHECK_UMBILICAL_ECCS;
-    float temperature_of_sensor_1 = -99;
-    float temperature_of_sensor_2 = -99;
-    while (EECSTask != TASK_DONE) {
-        switch (EECSTask) {
-            case TASK_CHECK_UMBILICAL_ECCS: {
-                // Check if umbilical cord is connected
-                bool status_umbilical_cord_rover = umbilicalcord_rover_connected();
-                if (status_umbilical_cord_rover) {
-                    send_message(MSG_TYPE_DATA, PAYLOAD_UMBILICAL_CONNECTED, sizeof(PAYLOAD_UMBILICAL_CONNECTED) - 1);
-                } else {
-                    send_message(MSG_TYPE_ERROR, PAYLOAD_UMBILICAL_NOT_CONNECTED, sizeof(PAYLOAD_UMBILICAL_NOT_CONNECTED) - 1);
-                }
-                EECSTask = TASK_BUS_CURRENT_SENSE;
-                break;
+bool RDS_electronics_status_step(void) {
+    if (!ECCS_batch_open) {
+        period_of_sensor_1 = PERIOD_CAPTURE_MISSING;
+        period_of_sensor_2 = PERIOD_CAPTURE_MISSING;
+        // the status messages of the whole sweep are sent together in as few frames as possible
+        begin_message_batch();
+        ECCS_batch_open = true;
+    }
+    switch (EECSTask) {
+        case TASK_CHECK_UMBILICAL_ECCS: {
+            // Check if umbilical cord is connected
+            bool status_umbilical_cord_rover = umbilicalcord_rover_connected();
+            if (status_umbilical_cord_rover) {
+                send_event(EVENT_UMBILICAL_CONNECTED);
+            } else {
+                send_event(EVENT_UMBILICAL_NOT_CONNECTED);
             }
+            EECSTask = TASK_BUS_CURRENT_SENSE;
+            break;
+        }
 
-            case TASK_BUS_CURRENT_SENSE: {
-                // Bus current sensing, read the value of the bus and send it to the earth
-                float bus_sense_voltage = voltage_adc_bus_sense();
-                if (bus_sense_voltage == 99) {
-                    send_message(MSG_TYPE_ERROR, PAYLOAD_BUS_SENSE_BROKEN, sizeof(PAYLOAD_BUS_SENSE_BROKEN) - 1);
-                } else {
-                    // Convert the float to the array of 7 characters and send message
-                    uint8_t PAYLOAD_BUS_SENSE_WORKS[] = "        is the current bus voltage"; // the first 5 characters are blank since they will be overridden
-                    float_to_uint8_array_2(bus_sense_voltage, PAYLOAD_BUS_SENSE_WORKS);
-                    send_message(MSG_TYPE_DATA, PAYLOAD_BUS_SENSE_WORKS, sizeof(PAYLOAD_BUS_SENSE_WORKS) - 1);
-                }
-                EECSTask = TASK_TEMPERATURE_SENSORS_CHECK_1;
-                break;
+        case TASK_BUS_CURRENT_SENSE: {
+            // Convert all analog channels at once, read the value of the bus and send it to the earth
+            adc_snapshot(&ECCS_snapshot);
+            uint16_t bus_sense_millivolts = adc_snapshot_millivolts(&ECCS_snapshot, ADC_CHANNEL_BUS_SENSE);
+            if (bus_sense_millivolts == SENSOR_MILLIVOLTS_ERROR) {
+                send_event(EVENT_BUS_SENSE_BROKEN);
+            } else {
+                // Send the filtered bus voltage in the current telemetry format
+                send_measurement_fixed(MEASUREMENT_BUS_VOLTAGE,
+                                       (int16_t)ECCS_filtered_millivolts(ADC_CHANNEL_BUS_SENSE));
             }
+            EECSTask = TASK_TEMPERATURE_SENSORS_START;
+            break;
+        }
 
-            case TASK_TEMPERATURE_SENSORS_CHECK_1: {
-                // Temperature sensors check
-                // Registers for temp sensor 1: TxxCCTLx = &TB0CCTL3, TxxCCRx = &TB0CCR3
-                temperature_of_sensor_1 = readout_temperature_sensor_1();
-                EECSTask = TASK_TEMPERATURE_SENSORS_CHECK_2;
-                break;
-            }
+        case TASK_TEMPERATURE_SENSORS_START: {
+            // Temperature sensors check, both sensors are captured at the same time in the background
+            // Registers for temp sensor 1: TB0CCTL3, TB0CCR3, for temp sensor 2: TB0CCTL1, TB0CCR1
+            temperature_acquisition_start();
+            EECSTask = TASK_TEMPERATURE_SENSORS_READ;
+            break;
+        }
 
-            case TASK_TEMPERATURE_SENSORS_CHECK_2: {
-                // Temperature sensors check
-                // Registers for temp sensor 2: TxxCCTLx = &TB0CCTL1, TxxCCRx = &TB0CCR1
-                temperature_of_sensor_2 = readout_temperature_sensor_2();
-                EECSTask = TASK_HEAT_RESISTOR_CONTROL;
+        case TASK_TEMPERATURE_SENSORS_READ: {
+            // Wait for the periods of both sensors in the next steps
+            if (!temperature_acquisition_done()) {
                 break;
             }
+            temperature_acquisition_stop();
+            period_of_sensor_1 = temperature_acquisition_period(TEMPERATURE_SENSOR_1);
+            period_of_sensor_2 = temperature_acquisition_period(TEMPERATURE_SENSOR_2);
+            EECSTask = TASK_HEAT_RESISTOR_CONTROL;
+            break;
+        }
 
-            case TASK_HEAT_RESISTOR_CONTROL: {
-                // Control the heat resistors and send an error message if a temp sensor is broken
-                heat_resistor_control(temperature_of_sensor_1, temperature_of_sensor_2);
-                EECSTask = TASK_SUPER_CAP_CHECK;
-                break;
-            }
+        case TASK_HEAT_RESISTOR_CONTROL: {
+            // Control the heat resistors and send an error message if a temp sensor is broken
+            heat_resistor_control(period_of_sensor_1, period_of_sensor_2);
+            EECSTask = TASK_SUPER_CAP_CHECK;
+            break;
+        }
 
-            case TASK_SUPER_CAP_CHECK: {
-                // Check the super capacitors.
-                float supercap_voltage = voltage_adc_supercaps();
-                if (supercap_voltage == 99) {
-                    // Send an error message if the supercap voltage cannot be read
-                    send_message(MSG_TYPE_ERROR, PAYLOAD_SUPERCAP_VOLTAGE_ERROR, sizeof(PAYLOAD_SUPERCAP_VOLTAGE_ERROR) - 1);
+        case TASK_SUPER_CAP_CHECK: {
+            // Check the super capacitors, from the snapshot of the bus current sense.
+            uint16_t supercap_millivolts = adc_snapshot_millivolts(&ECCS_snapshot, ADC_CHANNEL_SUPERCAP);
+            if (supercap_millivolts == SENSOR_MILLIVOLTS_ERROR) {
+                // Send an error message if the supercap voltage cannot be read
+                send_event(EVENT_SUPERCAP_VOLTAGE_ERROR);
+            } else {
+                if (supercap_millivolts == 0) {
+                    // Send a message that the voltage is 0V
+                    send_event(EVENT_SUPERCAP_VOLTAGE_ZERO);
                 } else {
-                    if (supercap_voltage == 0) {
-                        // Send a message that the voltage is 0V
-                        send_message(MSG_TYPE_DATA, PAYLOAD_SUPERCAP_VOLTAGE_ZERO, sizeof(PAYLOAD_SUPERCAP_VOLTAGE_ZERO) - 1);
-                    } else {
-                        // Convert the float to the array of 7 characters and send message
-                        uint8_t PAYLOAD_SUPERCAP_VOLTAGE_WORKS[] = "        is the current supercap voltage"; // the first 5 characters are blank since they will be overridden
-                        float_to_uint8_array_2(supercap_voltage, PAYLOAD_SUPERCAP_VOLTAGE_WORKS);
-                        send_message(MSG_TYPE_DATA, PAYLOAD_SUPERCAP_VOLTAGE_WORKS, sizeof(PAYLOAD_SUPERCAP_VOLTAGE_WORKS) - 1);
-
-                        // Set all the chargeCap flags and dischargecap flag to low
-                        initialize_charge_cap_flags();
-                    }
+                    // Send the filtered supercap voltage in the current telemetry format
+                    send_measurement_fixed(MEASUREMENT_SUPERCAP_VOLTAGE,
+                                           (int16_t)ECCS_filtered_millivolts(ADC_CHANNEL_SUPERCAP));
+
+                    // Set all the chargeCap flags and dischargecap flag to low
+                    initialize_charge_cap_flags();
                 }
-                EECSTask = TASK_NEA_CHECK;
-                break;
             }
+            EECSTask = TASK_NEA_CHECK;
+            break;
+        }
 
-            case TASK_NEA_CHECK: {
-                // NEA checkup
-                // Check the status of the 4 NEA's
-                bool status_NEA_1 = read_NEAready_status(&P3IN, BIT1);
-                bool status_NEA_2 = read_NEAready_status(&P3IN, BIT2);
-                bool status_NEA_3 = read_NEAready_status(&P3IN, BIT3);
-                bool status_NEA_4 = read_NEAready_status(&P4IN, BIT7);
-
-                if (status_NEA_1 && status_NEA_2 && status_NEA_3 && status_NEA_4) {
-                    // Send message that none of the NEA's is activated already
-                    send_message(MSG_TYPE_DATA, PAYLOAD_ALL_NEA_READY, sizeof(PAYLOAD_ALL_NEA_READY) - 1);
+        case TASK_NEA_CHECK: {
+            // NEA checkup
+            // Check the status of the 4 NEA's
+            bool status_NEA_1 = read_NEAready_status(&P3IN, BIT1);
+            bool status_NEA_2 = read_NEAready_status(&P3IN, BIT2);
+            bool status_NEA_3 = read_NEAready_status(&P3IN, BIT3);
+            bool status_NEA_4 = read_NEAready_status(&P4IN, BIT7);
+
+            if (status_NEA_1 && status_NEA_2 && status_NEA_3 && status_NEA_4) {
+                // Send message that none of the NEA's is activated already
+                send_event(EVENT_ALL_NEA_READY);
+            } else {
+                if (status_NEA_1) {
+                    // Send message that NEA 1 is not activated yet
+                    send_event(EVENT_NEA1_READY);
                 } else {
-                    if (status_NEA_1) {
-                        // Send message that NEA 1 is not activated yet
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA1_READY, sizeof(PAYLOAD_NEA1_READY) - 1);
-                    } else {
-                        // Send message that NEA 1 is already activated
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA1_NOT_READY, sizeof(PAYLOAD_NEA1_NOT_READY) - 1);
-                    }
-                    if (status_NEA_2) {
-                        // Send message that NEA 2 is not activated yet
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA2_READY, sizeof(PAYLOAD_NEA2_READY) - 1);
-                    } else {
-                        // Send message that NEA 2 is already activated
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA2_NOT_READY, sizeof(PAYLOAD_NEA2_NOT_READY) - 1);
-                    }
-                    if (status_NEA_3) {
-                        // Send message that NEA 3 is not activated yet
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA3_READY, sizeof(PAYLOAD_NEA3_READY) - 1);
-                    } else {
-                        // Send message that NEA 3 is already activated
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA3_NOT_READY, sizeof(PAYLOAD_NEA3_NOT_READY) - 1);
-                    }
-                    if (status_NEA_4) {
-                        // Send message that NEA 4 is not activated yet
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA4_READY, sizeof(PAYLOAD_NEA4_READY) - 1);
-                    } else {
-                        // Send message that NEA 4 is already activated
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA4_NOT_READY, sizeof(PAYLOAD_NEA4_NOT_READY) - 1);
-                    }
+                    // Send message that NEA 1 is already activated
+                    send_event(EVENT_NEA1_NOT_READY);
+                }
+                if (status_NEA_2) {
+                    // Send message that NEA 2 is not activated yet
+                    send_event(EVENT_NEA2_READY);
+                } else {
+                    // Send message that NEA 2 is already activated
+                    send_event(EVENT_NEA2_NOT_READY);
+                }
+                if (status_NEA_3) {
+                    // Send message that NEA 3 is not activated yet
+                    send_event(EVENT_NEA3_READY);
+                } else {
+                    // Send message that NEA 3 is already activated
+                    send_event(EVENT_NEA3_NOT_READY);
+                }
+                if (status_NEA_4) {
+                    // Send message that NEA 4 is not activated yet
+                    send_event(EVENT_NEA4_READY);
+                } else {
+                    // Send message that NEA 4 is already activated
+                    send_event(EVENT_NEA4_NOT_READY);
                 }
-                EECSTask = TASK_DONE;
-                break;
             }
-
-            case TASK_DONE:
-            default:
-                break;
+            EECSTask = TASK_DONE;
+            break;
         }
-        // Process received messages
+
+        case TASK_DONE:
+        default:
+            EECSTask = TASK_DONE;
+            break;
+    }
+
+    if (EECSTask != TASK_DONE) {
+        return false;
+    }
+    // the sweep is complete, the next step starts a new one
+    RDS_electronics_status_reset();
+    return true;
+}
+
+void RDS_electronics_status_reset(void) {
+    // a temperature acquisition of the abandoned sweep no longer interrupts
+    temperature_acquisition_stop();
+    if (ECCS_batch_open) {
+        end_message_batch();
+        ECCS_batch_open = false;
+    }
+    EECSTask = TASK_CHECK_UMBILICAL_ECCS;
+}
+
+void RDS_electronics_status_check(void) {
+    RDS_electronics_status_reset();
+    while (!RDS_electronics_status_step()) {
+        // Process received messages, sleep until the next tick while a step waits for the temperature sensors
         process_received_data();
+        wait_for_received_data();
     }
 }
 
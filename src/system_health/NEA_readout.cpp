@@ -15,6 +15,14 @@
 #include <stdbool.h>
 #include <system_health_lib/NEA_readout.h>
 
+static_assert(EVENT_NEA4_NOT_RELEASED - EVENT_NEA1_RELEASED == 2 * NEA_COUNT - 1 &&
+              MEASUREMENT_NEA4_SEQUENCE_ATTEMPTS - MEASUREMENT_NEA1_SEQUENCE_ATTEMPTS == NEA_COUNT - 1 &&
+              MEASUREMENT_NEA4_SEQUENCE_TIME - MEASUREMENT_NEA1_SEQUENCE_TIME == NEA_COUNT - 1,
+              "every NEA needs a RELEASED and NOT_RELEASED event and its own measurements, in the order of the NEAs");
+
+// Timer that expires every 0.25 seconds during the NEA firing sequence, the clock of the sequence
+static Soft_timer quarterSecondTimer;
+
 // Function to initialize all 4 NEA's
 void initialize_all_nea_pins(void) {
 
@@ -85,97 +93,140 @@ void deactivate_NEA_n(int nea) {
     PM5CTL0 &= ~LOCKLPM5;                   // Disable the GPIO power-on default high-impedance mode
 }
 
-void activate_NEAs(void){
-    int k = 0;
-    for(int i=0; i<4 ; i++){
-        while(k < 3){
-            if(supercap_functionality[0]){
-                switch_on_charge_cap_flag(0);
-            }
-            if(supercap_functionality[1]){
-                switch_on_charge_cap_flag(1);
-            }
-            if(supercap_functionality[2]){
-                switch_on_charge_cap_flag(2);
-            }
-            //timer 3 min = 180 seconds = 180x4 = 0.25 seconds x 720
-            startTimeoutTimer_TA3();
-            while(timeoutCounterTA3 < 720){
-                process_received_data(); // read the RX buffer while waiting for timer
-            } // 720 times 0.25 seconds is 3 minutes
-            stopTimeoutTimer_TA3();
-
-            // activate NEA x
-            activate_NEA_n(i);
-
-            // timer of 0.25 seconds
-            startTimeoutTimer_TA3();
-            while(timeoutCounterTA3 < 1){
-                process_received_data(); // read the RX buffer while waiting for timer
-            } // 1 times 0.25 seconds is 0.25 seconds
-            stopTimeoutTimer_TA3();
-
-            // check if NEA x detonated
-            bool status_NEA_n = true;
-            if(i == 0){
-                status_NEA_n = read_NEAready_status(&P3IN, BIT1);
-            } else if (i == 1){
-                status_NEA_n = read_NEAready_status(&P3IN, BIT2);
-            } else if (i == 2){
-                status_NEA_n = read_NEAready_status(&P3IN, BIT3);
-            } else if (i == 3){
-                status_NEA_n = read_NEAready_status(&P4IN, BIT7);
-            } else {}
-
-            // send a message to lander
-            send_NEA_message(i, status_NEA_n);
-
-            if(status_NEA_n){
-                k++;
-            } else {
-                k = 3;
-            }
+// Ready pins of NEA 1 to 4
+static volatile uint8_t *const NEAreadyPorts[NEA_COUNT] = {&P3IN, &P3IN, &P3IN, &P4IN};
+static const uint8_t NEAreadyPins[NEA_COUNT] = {BIT1, BIT2, BIT3, BIT7};
+
+// Pins of the NEA firing sequence, the sequencer numbers the NEAs from 0
+static void NEA_sequence_set_charge(bool on){
+    for(int i = 0; i < 3; i++){
+        if(on && supercap_functionality[i]){
+            switch_on_charge_cap_flag(i);
+        } else {
+            switch_off_charge_cap_flag(i);
         }
-        deactivate_NEA_n(i);
     }
+}
+
+static void NEA_sequence_set_fire(uint8_t nea, bool on){
+    if(on){
+        activate_NEA_n(nea + 1);
+    } else {
+        deactivate_NEA_n(nea + 1);
+    }
+}
+
+static bool NEA_sequence_read_ready(uint8_t nea){
+    return read_NEAready_status(NEAreadyPorts[nea], NEAreadyPins[nea]);
+}
+
+static void NEA_sequence_report_nea(uint8_t nea, bool released, uint8_t attempts, uint16_t quarters){
+    // the ready pin after the last attempt alone does not tell a released NEA from one that was given up
+    send_event((Telemetry_event)((released ? EVENT_NEA1_RELEASED : EVENT_NEA1_NOT_RELEASED) + 2 * nea));
+    send_measurement_fixed((Telemetry_measurement)(MEASUREMENT_NEA1_SEQUENCE_ATTEMPTS + nea), attempts);
+    send_measurement_fixed((Telemetry_measurement)(MEASUREMENT_NEA1_SEQUENCE_TIME + nea),
+                           nea_sequencer_seconds(quarters));
+}
+
+static const Nea_sequencer_hardware NEAsequenceHardware = {
+    NEA_sequence_set_charge,
+    NEA_sequence_set_fire,
+    NEA_sequence_read_ready,
+    send_NEA_message,
+    NEA_sequence_report_nea
+};
+
+static Nea_sequencer NEAsequencer;
+
+// lander commands of the NEA firing sequence, they take effect as soon as the lander link task handles them
+static void handle_NEA_abort(const Message *msg){
+    NEA_sequence_abort();
+}
+
+static void handle_NEA_hold(const Message *msg){
+    if(nea_sequencer_running(&NEAsequencer)){
+        nea_sequencer_hold(&NEAsequencer, true);
+        send_event(EVENT_NEA_SEQUENCE_HELD);
+    }
+}
+
+static void handle_NEA_resume(const Message *msg){
+    if(nea_sequencer_running(&NEAsequencer)){
+        nea_sequencer_hold(&NEAsequencer, false);
+        send_event(EVENT_NEA_SEQUENCE_RESUMED);
+    }
+}
+
+void NEA_sequence_init(void){
+    nea_sequencer_init(&NEAsequencer, &NEAsequenceHardware);
+    message_dispatch_register_command(&lander_dispatcher, MSG_TYPE_DEPLOY, "AB", handle_NEA_abort);
+    message_dispatch_register_command(&lander_dispatcher, MSG_TYPE_DEPLOY, "HO", handle_NEA_hold);
+    message_dispatch_register_command(&lander_dispatcher, MSG_TYPE_DEPLOY, "RE", handle_NEA_resume);
+}
+
+void NEA_sequence_start(void){
+    // the quarter seconds of the timer are the clock of the sequence
+    system_timer_start(&quarterSecondTimer, 250, 250);
+    nea_sequencer_start(&NEAsequencer, quarterSecondTimer.expirations);
+}
+
+bool NEA_sequence_poll(void){
+    if(!nea_sequencer_running(&NEAsequencer)){
+        return true;
+    }
+    bool finished = nea_sequencer_poll(&NEAsequencer, quarterSecondTimer.expirations);
+    if(finished){
+        system_timer_stop(&quarterSecondTimer);
+    }
+    return finished;
+}
+
+void NEA_sequence_abort(void){
+    if(nea_sequencer_abort(&NEAsequencer)){
+        system_timer_stop(&quarterSecondTimer);
+        send_event(EVENT_NEA_SEQUENCE_ABORTED);
+    }
+}
 
+Nea_sequence_state NEA_sequence_state(void){
+    return NEAsequencer.state;
 }
 
-void send_NEA_message(int nea, bool status){
+void send_NEA_message(uint8_t nea, bool status){
     if (nea == 0) {
         if(status){
             // Send message that NEA 1 is not activated yet
-            send_message(MSG_TYPE_DATA, PAYLOAD_NEA1_READY, sizeof(PAYLOAD_NEA1_READY) - 1);
+            send_event(EVENT_NEA1_READY);
         } else {
             // Send message that NEA 1 is already activated
-            send_message(MSG_TYPE_DATA, PAYLOAD_NEA1_NOT_READY, sizeof(PAYLOAD_NEA1_NOT_READY) - 1);
+            send_event(EVENT_NEA1_NOT_READY);
         }
     }
     if (nea == 1) {
         if(status){
             // Send message that NEA 2 is not activated yet
-            send_message(MSG_TYPE_DATA, PAYLOAD_NEA2_READY, sizeof(PAYLOAD_NEA2_READY) - 1);
+            send_event(EVENT_NEA2_READY);
         } else {
             // Send message that NEA 2 is already activated
-            send_message(MSG_TYPE_DATA, PAYLOAD_NEA2_NOT_READY, sizeof(PAYLOAD_NEA2_NOT_READY) - 1);
+            send_event(EVENT_NEA2_NOT_READY);
         }
     }
     if (nea == 2) {
         if(status){
             // Send message that NEA 3 is not activated yet
-            send_message(MSG_TYPE_DATA, PAYLOAD_NEA3_READY, sizeof(PAYLOAD_NEA3_READY) - 1);
+            send_event(EVENT_NEA3_READY);
         } else {
             // Send message that NEA 3 is already activated
-            send_message(MSG_TYPE_DATA, PAYLOAD_NEA3_NOT_READY, sizeof(PAYLOAD_NEA3_NOT_READY) - 1);
+            send_event(EVENT_NEA3_NOT_READY);
         }
     }
     if (nea == 3) {
         if(status){
             // Send message that NEA 4 is not activated yet
-            send_message(MSG_TYPE_DATA, PAYLOAD_NEA4_READY, sizeof(PAYLOAD_NEA4_READY) - 1);
+            send_event(EVENT_NEA4_READY);
         } else {
             // Send message that NEA 4 is already activated
-            send_message(MSG_TYPE_DATA, PAYLOAD_NEA4_NOT_READY, sizeof(PAYLOAD_NEA4_NOT_READY) - 1);
+            send_event(EVENT_NEA4_NOT_READY);
         }
     }
 }
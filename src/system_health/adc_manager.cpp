@@ -0,0 +1,284 @@
+/*
+ * adc_manager.cpp file
+ *
+ * This file includes the ADC manager of the RDS, see adc_manager.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include <msp430.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "system_health_lib/adc_manager.h"
+#include "system_health_lib/supercap_readout.h"
+#include "system_health_lib/main_system_init.h"
+#include "system_health_lib/low_power.h"
+
+// Converts a voltage to ADC counts, rounded
+#define ADC_COUNTS(volts) ((uint16_t)((volts) * ADC_MAX_VALUE / MAX_VOLTAGE + 0.5))
+
+// Channel table in conversion order
+static const Adc_channel_config adcChannels[ADC_CHANNEL_COUNT] = {
+#define ADC_CHANNEL_CONFIG(name, input, oversampling) {input, oversampling},
+    ADC_CHANNELS(ADC_CHANNEL_CONFIG)
+#undef ADC_CHANNEL_CONFIG
+};
+
+// Set by the ADC12 interrupt at the end of a sequence
+static volatile bool adcSequenceDone = false;
+static volatile bool adcSequenceFailed = false;
+
+// Windows of the monitor in the order of ADC_CHANNELS: the supercap voltage, the bus sense
+static const Adc_window adcMonitorWindows[ADC_CHANNEL_COUNT] = {
+    {ADC_COUNTS(ADC_MONITOR_SUPERCAP_LOW_V), ADC_MAX_VALUE},
+    {0, ADC_COUNTS(ADC_MONITOR_BUS_SENSE_HIGH_V)},
+};
+
+// Events of a channel that reenters its window, goes below it or goes above it, in the order of ADC_CHANNELS
+static const Telemetry_event adcMonitorEvents[ADC_CHANNEL_COUNT][3] = {
+    {EVENT_SUPERCAP_VOLTAGE_NORMAL, EVENT_SUPERCAP_BROWNOUT, EVENT_SUPERCAP_VOLTAGE_NORMAL},
+    {EVENT_BUS_CURRENT_NORMAL, EVENT_BUS_CURRENT_NORMAL, EVENT_BUS_OVERCURRENT},
+};
+
+// Measurement of the voltage of a channel, in the order of ADC_CHANNELS
+static const Telemetry_measurement adcMonitorMeasurements[ADC_CHANNEL_COUNT] = {
+    MEASUREMENT_SUPERCAP_VOLTAGE,
+    MEASUREMENT_BUS_VOLTAGE,
+};
+
+// Rings of the monitor, written by the DMA
+static uint16_t adcMonitorRings[ADC_CHANNEL_COUNT][ADC_MONITOR_RING_LENGTH];
+static Adc_monitor adcMonitor;
+static bool adcMonitoring = false;
+
+// Word offsets of the registers of a DMA channel, the trigger selects of the channels are the bytes of DMACTL0 and
+// DMACTL1
+enum {
+    DMA_CTL = 0,
+    DMA_SA = 1,
+    DMA_DA = 3,
+    DMA_SZ = 5
+};
+
+// Registers of DMA channel n, the channels are 0x10 bytes apart
+static volatile uint16_t *adc_monitor_dma(uint8_t channel) {
+    return &DMA0CTL + channel * 8;
+}
+
+// Stops the conversions right away, also a repeated sequence
+static void adc_stop_conversions(void) {
+    ADC12CTL1 &= ~ADC12CONSEQ_3;                        // Single conversion mode together with ENC = 0 stops at once
+    ADC12CTL0 &= ~ADC12ENC;
+    while (ADC12CTL1 & ADC12BUSY);                      // Wait for the ADC to be idle
+}
+
+// Configures the sequence of the snapshot, ADC12ENC has to be 0
+static void adc_configure_snapshot(void) {
+    ADC12CTL0 |= ADC12MSC;                              // Slots back to back after the software trigger
+    ADC12CTL1 = ADC12SHP | ADC12SHS_0 | ADC12CONSEQ_1;  // Sampling timer, ADC12SC trigger, sequence-of-channels
+    ADC12CTL3 = ADC12CSTARTADD_0;                       // The sequence starts at ADC12MEM0
+}
+
+// Configures the repeated sequence of the monitor, ADC12ENC has to be 0
+static void adc_configure_monitor(void) {
+    ADC12CTL0 &= ~ADC12MSC;                             // Every slot waits for a trigger
+    ADC12CTL1 = ADC12SHP | ADC12SHS_1 | ADC12CONSEQ_3;  // Sampling timer, TA0.1 trigger, repeat-sequence-of-channels
+    ADC12CTL3 = ADC_MONITOR_START_SLOT;                 // The sequence starts at the first slot of the monitor
+}
+
+// Enables the interrupts of the window comparator for the state of the comparator channel
+static void adc_monitor_enable_comparator(void) {
+    uint8_t enables = adc_monitor_comparator_enables(&adcMonitor);
+    ADC12IER2 &= ~(ADC12HIIE | ADC12LOIE | ADC12INIE);
+    // the comparator sets its flags on every sample, old flags of a disabled interrupt must not fire
+    ADC12IFGR2 &= ~(ADC12HIIFG | ADC12LOIFG | ADC12INIFG);
+    ADC12IER2 |= ((enables & ADC_MONITOR_IE_ABOVE) ? ADC12HIIE : 0) |
+                 ((enables & ADC_MONITOR_IE_BELOW) ? ADC12LOIE : 0) |
+                 ((enables & ADC_MONITOR_IE_INSIDE) ? ADC12INIE : 0);
+}
+
+// Function to configure the ADC12 for the sequence of all channels
+void initialize_adc_sequence(void) {
+    uint8_t slotInputs[ADC_SEQUENCE_MAX_SLOTS];
+    uint8_t slots = adc_sequence_layout(adcChannels, ADC_CHANNEL_COUNT, slotInputs);
+    uint8_t last = slots - 1;
+
+    ADC12CTL0 &= ~ADC12ENC;                             // Disable ADC12 before configuration
+    ADC12CTL0 = ADC12SHT0_2 | ADC12SHT1_2 | ADC12ON;    // 16 cycles sample time, ADC on
+    ADC12CTL2 = ADC12RES_2;                             // 12-bit conversion results
+    adc_configure_snapshot();
+
+    // one slot per sample, written once instead of or-ed into ADC12MCTL0 for every readout
+    for (uint8_t slot = 0; slot < slots; slot++) {
+        (&ADC12MCTL0)[slot] = slotInputs[slot] | (slot == last ? ADC12EOS : 0);
+    }
+    // one slot per channel for the monitor, the window comparator checks its channel
+    for (uint8_t channel = 0; channel < ADC_CHANNEL_COUNT; channel++) {
+        (&ADC12MCTL0)[ADC_MONITOR_START_SLOT + channel] = adcChannels[channel].input |
+            (channel == ADC_MONITOR_COMPARATOR_CHANNEL ? ADC12WINC : 0) |
+            (channel == ADC_CHANNEL_COUNT - 1 ? ADC12EOS : 0);
+    }
+
+    // only the last slot of the snapshot interrupts, together with the overflow and conversion time overflow. The
+    // slots of the monitor are read by the DMA.
+    ADC12IFGR0 = 0;
+    ADC12IFGR1 = 0;
+    ADC12IER0 = last < 16 ? (1u << last) : 0;
+    ADC12IER1 = last < 16 ? 0 : (1u << (last - 16));
+    ADC12IER2 = ADC12TOVIE | ADC12OVIE;
+
+    ADC12CTL0 |= ADC12ENC;                              // Enable conversions
+    PM5CTL0 &= ~LOCKLPM5;                               // Disable the GPIO power-on default high-impedance mode
+}
+
+// Function to convert all channels at once
+bool adc_snapshot(Adc_snapshot *snapshot) {
+    if (adcMonitoring) {
+        // the end of the snapshot also triggers the DMA, the rings then get the last sample of the monitor again
+        adc_stop_conversions();
+        adc_configure_snapshot();
+        ADC12CTL0 |= ADC12ENC;
+    }
+
+    adcSequenceDone = false;
+    adcSequenceFailed = false;
+    ADC12CTL0 |= ADC12SC;                               // Start the sequence - software trigger
+    LOW_POWER_WAIT_UNTIL(adcSequenceDone);
+
+    snapshot->tick = system_tick_now();
+    snapshot->valid = !adcSequenceFailed;
+    if (snapshot->valid) {
+        adc_sequence_average(adcChannels, ADC_CHANNEL_COUNT, &ADC12MEM0, snapshot->raw);
+    }
+
+    if (adcMonitoring) {
+        adc_stop_conversions();
+        adc_configure_monitor();
+        ADC12CTL0 |= ADC12ENC;
+    }
+    return snapshot->valid;
+}
+
+uint16_t adc_snapshot_millivolts(const Adc_snapshot *snapshot, Adc_channel channel) {
+    if (!snapshot->valid) {
+        return SENSOR_MILLIVOLTS_ERROR;                 // Error voltage
+    }
+    return adc_to_millivolts(snapshot->raw[channel]);
+}
+
+void adc_sequence_done_isr(bool failed) {
+    if (failed) {
+        ADC12CTL0 &= ~ADC12SC;                          // Stop conversion
+        adcSequenceFailed = true;
+    }
+    adcSequenceDone = true;
+}
+
+// Function to start the continuous monitoring
+void adc_monitor_start(void) {
+    if (adcMonitoring) {
+        return;
+    }
+    adc_monitor_init(&adcMonitor, adcMonitorWindows, ADC_CHANNEL_COUNT, ADC_MONITOR_COMPARATOR_CHANNEL);
+
+    // DMA channel n copies the slot of channel n into its ring at the end of every sequence
+    for (uint8_t channel = 0; channel < ADC_CHANNEL_COUNT; channel++) {
+        volatile uint16_t *dma = adc_monitor_dma(channel);
+        dma[DMA_CTL] = 0;                               // Disable the DMA channel before configuration
+        ((volatile uint8_t *)&DMACTL0)[channel] = DMA0TSEL__ADC12IFG;
+        __data16_write_addr((unsigned short)(uintptr_t)&dma[DMA_SA],
+                            (unsigned long)(uintptr_t)&(&ADC12MEM0)[ADC_MONITOR_START_SLOT + channel]);
+        __data16_write_addr((unsigned short)(uintptr_t)&dma[DMA_DA],
+                            (unsigned long)(uintptr_t)adcMonitorRings[channel]);
+        dma[DMA_SZ] = ADC_MONITOR_RING_LENGTH;
+        // repeated single transfer: the ring starts again after ADC_MONITOR_RING_LENGTH samples
+        dma[DMA_CTL] = DMADT_4 | DMADSTINCR_3 | DMASRCINCR_0 | DMAEN | (channel == ADC_CHANNEL_COUNT - 1 ? DMAIE : 0);
+    }
+
+    // TA0.1 is reset halfway and set at the end of every system tick, the rising edge triggers the next slot
+    TA0CCR1 = TA0CCR0 / 2;
+    TA0CCTL1 = OUTMOD_7;                                // Reset/set, no interrupt
+
+    adc_stop_conversions();
+    ADC12LO = adcMonitorWindows[ADC_MONITOR_COMPARATOR_CHANNEL].low;
+    ADC12HI = adcMonitorWindows[ADC_MONITOR_COMPARATOR_CHANNEL].high;
+    adc_monitor_enable_comparator();
+    adc_configure_monitor();
+    adcMonitoring = true;
+    ADC12CTL0 |= ADC12ENC;
+}
+
+// Function to stop the continuous monitoring
+void adc_monitor_stop(void) {
+    if (!adcMonitoring) {
+        return;
+    }
+    adcMonitoring = false;
+    adc_stop_conversions();
+    TA0CCTL1 = OUTMOD_0;                                // No more triggers
+    ADC12IER2 &= ~(ADC12HIIE | ADC12LOIE | ADC12INIE);
+    for (uint8_t channel = 0; channel < ADC_CHANNEL_COUNT; channel++) {
+        adc_monitor_dma(channel)[DMA_CTL] = 0;
+    }
+    adc_configure_snapshot();
+    ADC12CTL0 |= ADC12ENC;
+}
+
+bool adc_monitor_pending(void) {
+    return adcMonitor.changed != 0;
+}
+
+void adc_monitor_report(void) {
+    Adc_window_state state[ADC_CHANNEL_COUNT];
+    uint16_t value[ADC_CHANNEL_COUNT];
+
+    // take the changes and their values together, the interrupts of the monitor must not change them halfway
+    unsigned short interrupt_state = __get_interrupt_state();
+    __disable_interrupt();
+    uint8_t changed = adc_monitor_take_changes(&adcMonitor);
+    for (uint8_t channel = 0; channel < ADC_CHANNEL_COUNT; channel++) {
+        state[channel] = adcMonitor.state[channel];
+        value[channel] = adcMonitor.value[channel];
+    }
+    __set_interrupt_state(interrupt_state);
+
+    for (uint8_t channel = 0; channel < ADC_CHANNEL_COUNT; channel++) {
+        if (changed & (1u << channel)) {
+            send_event(adcMonitorEvents[channel][state[channel]]);
+            send_measurement_fixed(adcMonitorMeasurements[channel], (int16_t)adc_to_millivolts(value[channel]));
+        }
+    }
+}
+
+bool adc_monitor_comparator_isr(Adc_window_state state) {
+    uint16_t sample = (&ADC12MEM0)[ADC_MONITOR_START_SLOT + ADC_MONITOR_COMPARATOR_CHANNEL];
+    bool changed = adc_monitor_comparator_event(&adcMonitor, state, sample);
+    adc_monitor_enable_comparator();
+    return changed;
+}
+
+// DMA interrupt service routine, the rings of the monitor are full
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector = DMA_VECTOR
+__interrupt void DMA_ISR(void)
+#elif defined(__GNUC__)
+void __attribute__ ((interrupt(DMA_VECTOR))) DMA_ISR (void)
+#else
+#error Compiler not supported!
+#endif
+{
+  switch(__even_in_range(DMAIV, DMAIV_DMA2IFG))
+  {
+    case ADC_MONITOR_DMA_IV:
+        // the DMA starts again at the front of the rings, the next sample comes ADC_MONITOR_SAMPLE_PERIOD_MS later
+        if (adc_monitor_ring_full(&adcMonitor, &adcMonitorRings[0][0])) {
+            LOW_POWER_WAKE_ON_EXIT();
+        }
+        break;
+    default:
+        break;
+  }
+}
@@ -0,0 +1,115 @@
+/*
+ * adc_monitor.cpp file
+ *
+ * This file includes the continuous monitoring of the analog channels, see adc_monitor.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+// include header files
+#include "system_health_lib/adc_monitor.h"
+
+/*
+ * Keeps the new state of a channel, returns true if it changed.
+ */
+static bool adc_monitor_set_state(Adc_monitor *monitor, uint8_t channel, Adc_window_state state, uint16_t value)
+{
+    if (monitor->state[channel] == state) {
+        return false;
+    }
+    monitor->state[channel] = state;
+    monitor->value[channel] = value;
+    monitor->changed |= (uint8_t)(1u << channel);
+    monitor->wakeups++;
+    return true;
+}
+
+bool adc_monitor_init(Adc_monitor *monitor, const Adc_window *windows, uint8_t channel_count,
+                      uint8_t comparator_channel)
+{
+    if (channel_count == 0 || channel_count > ADC_MONITOR_MAX_CHANNELS || comparator_channel >= channel_count) {
+        return false;
+    }
+    monitor->channel_count = channel_count;
+    monitor->comparator_channel = comparator_channel;
+    for (uint8_t i = 0; i < channel_count; i++) {
+        monitor->window[i] = windows[i];
+        monitor->state[i] = ADC_WINDOW_INSIDE;
+        monitor->value[i] = 0;
+    }
+    monitor->changed = 0;
+    monitor->rings = 0;
+    monitor->wakeups = 0;
+    return true;
+}
+
+Adc_window_state adc_window_check(const Adc_window *window, uint16_t sample)
+{
+    if (sample > window->high) {
+        return ADC_WINDOW_ABOVE;
+    }
+    if (sample < window->low) {
+        return ADC_WINDOW_BELOW;
+    }
+    return ADC_WINDOW_INSIDE;
+}
+
+uint8_t adc_monitor_comparator_enables(const Adc_monitor *monitor)
+{
+    switch (monitor->state[monitor->comparator_channel]) {
+        case ADC_WINDOW_BELOW:
+            return ADC_MONITOR_IE_INSIDE | ADC_MONITOR_IE_ABOVE;
+        case ADC_WINDOW_ABOVE:
+            return ADC_MONITOR_IE_INSIDE | ADC_MONITOR_IE_BELOW;
+        default:
+            return ADC_MONITOR_IE_BELOW | ADC_MONITOR_IE_ABOVE;
+    }
+}
+
+bool adc_monitor_comparator_event(Adc_monitor *monitor, Adc_window_state state, uint16_t sample)
+{
+    return adc_monitor_set_state(monitor, monitor->comparator_channel, state, sample);
+}
+
+bool adc_monitor_ring_full(Adc_monitor *monitor, const volatile uint16_t *rings)
+{
+    bool changed = false;
+    monitor->rings++;
+    for (uint8_t channel = 0; channel < monitor->channel_count; channel++) {
+        const volatile uint16_t *ring = rings + channel * ADC_MONITOR_RING_LENGTH;
+        if (channel == monitor->comparator_channel) {
+            continue;
+        }
+
+        uint16_t lowest = ring[0];
+        uint16_t highest = ring[0];
+        for (uint8_t i = 1; i < ADC_MONITOR_RING_LENGTH; i++) {
+            if (ring[i] < lowest) {
+                lowest = ring[i];
+            }
+            if (ring[i] > highest) {
+                highest = ring[i];
+            }
+        }
+
+        // a single sample out of the window is enough, above goes before below
+        const Adc_window *window = &monitor->window[channel];
+        if (highest > window->high) {
+            changed |= adc_monitor_set_state(monitor, channel, ADC_WINDOW_ABOVE, highest);
+        } else if (lowest < window->low) {
+            changed |= adc_monitor_set_state(monitor, channel, ADC_WINDOW_BELOW, lowest);
+        } else {
+            changed |= adc_monitor_set_state(monitor, channel, ADC_WINDOW_INSIDE, ring[ADC_MONITOR_RING_LENGTH - 1]);
+        }
+    }
+    return changed;
+}
+
+uint8_t adc_monitor_take_changes(Adc_monitor *monitor)
+{
+    uint8_t changed = monitor->changed;
+    monitor->changed = 0;
+    return changed;
+}
@@ -0,0 +1,72 @@
+/*
+ * adc_sequence.cpp file
+ *
+ * This file includes the layout of the ADC12 conversion sequence, see adc_sequence.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+// include header files
+#include "system_health_lib/adc_sequence.h"
+
+/*
+ * Returns the shift that divides by the oversampling, the oversampling is a power of 2.
+ */
+static uint8_t adc_sequence_shift(uint8_t oversampling)
+{
+    uint8_t shift = 0;
+    while ((1u << shift) < oversampling) {
+        shift++;
+    }
+    return shift;
+}
+
+bool adc_sequence_valid(const Adc_channel_config *channels, uint8_t channel_count)
+{
+    if (channel_count == 0) {
+        return false;
+    }
+    uint16_t slots = 0;
+    for (uint8_t i = 0; i < channel_count; i++) {
+        uint8_t oversampling = channels[i].oversampling;
+        if (oversampling == 0 || oversampling > ADC_SEQUENCE_MAX_OVERSAMPLING ||
+            (oversampling & (oversampling - 1)) != 0 || channels[i].input > ADC_SEQUENCE_MAX_INPUT) {
+            return false;
+        }
+        slots += oversampling;
+    }
+    return slots <= ADC_SEQUENCE_MAX_SLOTS;
+}
+
+uint8_t adc_sequence_layout(const Adc_channel_config *channels, uint8_t channel_count, uint8_t *slot_inputs)
+{
+    uint8_t slot = 0;
+    for (uint8_t i = 0; i < channel_count; i++) {
+        for (uint8_t sample = 0; sample < channels[i].oversampling; sample++) {
+            slot_inputs[slot++] = channels[i].input;
+        }
+    }
+    return slot;
+}
+
+void adc_sequence_average(const Adc_channel_config *channels, uint8_t channel_count, const volatile uint16_t *slots,
+                          uint16_t *results)
+{
+    for (uint8_t i = 0; i < channel_count; i++) {
+        uint8_t oversampling = channels[i].oversampling;
+        uint8_t shift = adc_sequence_shift(oversampling);
+        uint16_t sum = 0;
+        for (uint8_t sample = 0; sample < oversampling; sample++) {
+            sum += *slots++;
+        }
+        // the sum of 16 samples of 4095 is 65520, adding half of the divisor for the rounding does not overflow
+        results[i] = (uint16_t)((sum + (oversampling >> 1)) >> shift);
+    }
+}
+
+uint32_t adc_sequence_cycles(uint16_t sample_cycles, uint8_t slots)
+{
+    return (uint32_t)slots * (sample_cycles + ADC_SEQUENCE_CONVERSION_CYCLES);
+}
@@ -51,13 +51,13 @@ bool is_heater_on(void){
     return (P3IN & BIT7) == 0; // it is an active low signal
 }
 
-void heat_resistor_control(float temperature1, float temperature2) {
+void heat_resistor_control(uint16_t period1, uint16_t period2) {
     int condition = 0;
-    if (temperature1 == -99 && temperature2 == -99) {
+    if (!period_is_valid(period1) && !period_is_valid(period2)) {
         condition = 1;
-    } else if (temperature1 == -99) {
+    } else if (!period_is_valid(period1)) {
         condition = 2;
-    } else if (temperature2 == -99) {
+    } else if (!period_is_valid(period2)) {
         condition = 3;
     } else {
         condition = 4;
@@ -69,40 +69,32 @@ void heat_resistor_control(float temperature1, float temperature2) {
             MCU_heaterOff_low();
             MCU_heaterOn_low();
             // send an error message for sensor 1
-            send_message(MSG_TYPE_ERROR, PAYLOAD_TEMP_SENSOR_1_BROKEN, sizeof(PAYLOAD_TEMP_SENSOR_1_BROKEN) - 1);
+            send_event(EVENT_TEMP_SENSOR_1_BROKEN);
             // send an error message for sensor 2
-            send_message(MSG_TYPE_ERROR, PAYLOAD_TEMP_SENSOR_2_BROKEN, sizeof(PAYLOAD_TEMP_SENSOR_2_BROKEN) - 1);
+            send_event(EVENT_TEMP_SENSOR_2_BROKEN);
             break;
 
         case 2:
             // send an error message for sensor 1
-            send_message(MSG_TYPE_ERROR, PAYLOAD_TEMP_SENSOR_1_BROKEN, sizeof(PAYLOAD_TEMP_SENSOR_1_BROKEN) - 1);
-            heat_resistor_control_one_sensor(temperature2);
-            // convert the float to the array of 5 characters and send message
-            uint8_t PAYLOAD_TEMP_SENSOR_2_WORKS[] = "        is the current temperature of sensor 2"; // the first 7 characters are blank since they will be overriden
-            float_to_uint8_array_2(temperature2, PAYLOAD_TEMP_SENSOR_2_WORKS);
-            send_message(MSG_TYPE_DATA, PAYLOAD_TEMP_SENSOR_2_WORKS, sizeof(PAYLOAD_TEMP_SENSOR_2_WORKS) - 1);
+            send_event(EVENT_TEMP_SENSOR_1_BROKEN);
+            heat_resistor_control_one_sensor(period2);
+            // send the temperature in the current telemetry format
+            send_measurement_fixed(MEASUREMENT_TEMP_SENSOR_2, period_to_centidegrees(period2));
             break;
 
         case 3:
             // send an error message for sensor 2
-            send_message(MSG_TYPE_ERROR, PAYLOAD_TEMP_SENSOR_2_BROKEN, sizeof(PAYLOAD_TEMP_SENSOR_2_BROKEN) - 1);
-            heat_resistor_control_one_sensor(temperature1);
-            uint8_t PAYLOAD_TEMP_SENSOR_1_WORKS[] = "        is the current temperature of sensor 1"; // the first 7 characters are blank since they will be overriden
-            float_to_uint8_array_2(temperature1, PAYLOAD_TEMP_SENSOR_1_WORKS);
-            send_message(MSG_TYPE_DATA, PAYLOAD_TEMP_SENSOR_1_WORKS, sizeof(PAYLOAD_TEMP_SENSOR_1_WORKS) - 1);
+            send_event(EVENT_TEMP_SENSOR_2_BROKEN);
+            heat_resistor_control_one_sensor(period1);
+            // send the temperature in the current telemetry format
+            send_measurement_fixed(MEASUREMENT_TEMP_SENSOR_1, period_to_centidegrees(period1));
             break;
 
         case 4:
-            heat_resistor_control_two_sensors(temperature1, temperature2);
-            // convert the float to the array of 5 characters and send message
-            uint8_t PAYLOAD_TEMP_SENSOR_1_WORKS_2[] = "        is the current temperature of sensor 1"; // the first 7 characters are blank since they will be overriden
-            float_to_uint8_array_2(temperature1, PAYLOAD_TEMP_SENSOR_1_WORKS_2);
-            send_message(MSG_TYPE_DATA, PAYLOAD_TEMP_SENSOR_1_WORKS_2, sizeof(PAYLOAD_TEMP_SENSOR_1_WORKS_2) - 1);
-            // convert the float to the array of 5 characters and send message
-            uint8_t PAYLOAD_TEMP_SENSOR_2_WORKS_2[] = "        is the current temperature of sensor 2"; // the first 7 characters are blank since they will be overriden
-            float_to_uint8_array_2(temperature2, PAYLOAD_TEMP_SENSOR_2_WORKS_2);
-            send_message(MSG_TYPE_DATA, PAYLOAD_TEMP_SENSOR_2_WORKS_2, sizeof(PAYLOAD_TEMP_SENSOR_2_WORKS_2) - 1);
+            heat_resistor_control_two_sensors(period1, period2);
+            // send the temperatures in the current telemetry format
+            send_measurement_fixed(MEASUREMENT_TEMP_SENSOR_1, period_to_centidegrees(period1));
+            send_measurement_fixed(MEASUREMENT_TEMP_SENSOR_2, period_to_centidegrees(period2));
             break;
 
         default:
@@ -112,38 +104,38 @@ void heat_resistor_control(float temperature1, float temperature2) {
 }
 
 
-void heat_resistor_control_one_sensor(float temperature){
+void heat_resistor_control_one_sensor(uint16_t period){
     // check if the heater is on
     bool heater_status = is_heater_on();
 
     if(heater_status){
         // if heater on and above 40 degrees celcius, turn off
-        if(temperature > 40){
+        if(period >= HEATER_OFF_FROM_PERIOD){
             MCU_heaterOn_low();
             MCU_heaterOff_high();
         }
     } else {
         // if heater off and below 20 degrees celcius, turn on
-        if(temperature < 20){
+        if(period < HEATER_ON_BELOW_PERIOD){
             MCU_heaterOff_low();
             MCU_heaterOn_high();
         }
     }
 }
 
-void heat_resistor_control_two_sensors(float temperature1, float temperature2){
+void heat_resistor_control_two_sensors(uint16_t period1, uint16_t period2){
     // check if the heater is on
     bool heater_status = is_heater_on();
 
     if(heater_status){
         // if heater on and above 40 degrees celcius, turn off
-        if(temperature1 > 40 || temperature2 > 40){
+        if(period1 >= HEATER_OFF_FROM_PERIOD || period2 >= HEATER_OFF_FROM_PERIOD){
             MCU_heaterOn_low();
             MCU_heaterOff_high();
         }
     } else {
         // if heater off and below 20 degrees celcius, turn on
-        if(temperature1 < 20 || temperature2 < 20){
+        if(period1 < HEATER_ON_BELOW_PERIOD || period2 < HEATER_ON_BELOW_PERIOD){
             MCU_heaterOff_low();
             MCU_heaterOn_high();
         }
@@ -0,0 +1,147 @@
+/*
+ * low_power.cpp file
+ *
+ * This file includes the low-power wait of the RDS and the measurement of the time the CPU is awake per transit mode,
+ * see low_power.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+// import packages
+#include <msp430.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// include header files
+#include "system_health_lib/low_power.h"
+#include "system_health_lib/main_system_init.h"
+#include "lander_communication_lib/lander_communication.h"
+
+// Timestamps are microseconds of the system tick, which wraps around after 65536 ms
+#define LOW_POWER_TIMESTAMP_WRAP 65536000UL
+
+static_assert(MEASUREMENT_CPU_ACTIVE_DEPLOYMENT - MEASUREMENT_CPU_ACTIVE_GENERAL_STARTUP == DEPLOYMENT - GENERAL_STARTUP,
+              "every transit mode needs a MEASUREMENT_CPU_ACTIVE_* measurement, in the order of transit_states");
+
+// Time of a transit mode
+typedef struct {
+    uint32_t active_us;     // awake in the current measurement
+    uint32_t asleep_us;     // asleep in the current measurement
+    uint32_t active_ms;     // awake in the finished measurements
+    uint32_t total_ms;      // length of the finished measurements
+} Low_power_mode_time;
+
+static Low_power_mode_time low_power_times[LOW_POWER_MODE_COUNT];
+static uint16_t low_power_results[LOW_POWER_MODE_COUNT];   // active per mille of the last finished measurement
+static volatile uint8_t low_power_pending = 0;              // bit n is set when the result of mode n is not sent yet
+static uint32_t low_power_last = 0;                         // timestamp of the previous accounting
+static transit_states low_power_mode = GENERAL_STARTUP;     // mode of the current measurement
+
+/*
+ * Returns the current time in microseconds, with interrupts disabled. TA0 counts at 1 MHz from 0 up to 999.
+ */
+static uint32_t low_power_timestamp(void)
+{
+    uint16_t ms = system_ticks_ms;
+    uint16_t count = TA0R;
+    // a tick that is pending while interrupts are disabled has not been counted yet
+    if ((TA0CCTL0 & CCIFG) && count < 500) {
+        ms++;
+    }
+    return (uint32_t)ms * 1000 + count;
+}
+
+/*
+ * Finishes the measurement of a transit mode and marks its result to be sent.
+ */
+static void low_power_finish(transit_states mode)
+{
+    Low_power_mode_time *time = &low_power_times[mode];
+    uint32_t active_ms = time->active_us / 1000;
+    uint32_t total_ms = (time->active_us + time->asleep_us) / 1000;
+
+    if (total_ms != 0) {
+        low_power_results[mode] = (uint16_t)(active_ms * 1000 / total_ms);
+        time->active_ms += active_ms;
+        time->total_ms += total_ms;
+        low_power_pending |= (uint8_t)(1u << mode);
+    }
+    time->active_us = 0;
+    time->asleep_us = 0;
+}
+
+/*
+ * Adds the time since the previous accounting to the current transit mode, with interrupts disabled.
+ */
+static void low_power_account(bool asleep)
+{
+    uint32_t now = low_power_timestamp();
+    uint32_t elapsed = now >= low_power_last ? now - low_power_last : now + LOW_POWER_TIMESTAMP_WRAP - low_power_last;
+    low_power_last = now;
+
+    Low_power_mode_time *time = &low_power_times[low_power_mode];
+    if (asleep) {
+        time->asleep_us += elapsed;
+    } else {
+        time->active_us += elapsed;
+    }
+
+    if (transit_state != low_power_mode || time->active_us + time->asleep_us >= LOW_POWER_REPORT_PERIOD_US) {
+        low_power_finish(low_power_mode);
+        low_power_mode = transit_state;
+    }
+}
+
+void low_power_init(void)
+{
+    for (uint8_t i = 0; i < LOW_POWER_MODE_COUNT; i++) {
+        low_power_times[i] = Low_power_mode_time{0, 0, 0, 0};
+        low_power_results[i] = 0;
+    }
+    low_power_pending = 0;
+    low_power_mode = transit_state;
+    low_power_last = low_power_timestamp();
+}
+
+void low_power_sleep(void)
+{
+    low_power_account(false);
+    // GIE is set together with the low-power bits, so an interrupt can only wake the CPU once it is asleep
+    __bis_SR_register(LOW_POWER_MODE_BITS | GIE);
+    __no_operation();
+    __disable_interrupt();
+    // the interrupts that ran in the meantime are counted as asleep
+    low_power_account(true);
+}
+
+void low_power_report(void)
+{
+    __disable_interrupt();
+    low_power_account(false);
+    uint8_t pending = low_power_pending;
+    low_power_pending = 0;
+    __enable_interrupt();
+
+    for (uint8_t mode = 0; mode < LOW_POWER_MODE_COUNT; mode++) {
+        if (pending & (1u << mode)) {
+            // per mille is the percentage with 1 decimal
+            send_measurement_fixed((Telemetry_measurement)(MEASUREMENT_CPU_ACTIVE_GENERAL_STARTUP + mode),
+                                   (int16_t)low_power_results[mode]);
+        }
+    }
+}
+
+uint16_t low_power_active_per_mille(transit_states mode)
+{
+    __disable_interrupt();
+    uint32_t active_ms = low_power_times[mode].active_ms;
+    uint32_t total_ms = low_power_times[mode].total_ms;
+    __enable_interrupt();
+
+    if (total_ms == 0) {
+        return 0;
+    }
+    return (uint16_t)((uint64_t)active_ms * 1000 / total_ms);
+}
@@ -17,29 +17,26 @@
 // include header files
 #include "system_health_lib/main_system_init.h"
 #include "system_health_lib/ECCS.h"
+#include "system_health_lib/low_power.h"
 
-// Global variable to indicate if a timeout occurred
-volatile bool timeoutOccurred = false;
-volatile unsigned int timeoutCounterTA3 = 0;
+volatile uint16_t system_ticks_ms = 0;
+Soft_timer_list system_timers;
 
 void boot_up_initialisation(void){
     setup_SMCLK();
+    start_system_tick();
     uart_configure();
+    // the batch is in FRAM and still holds what was collected before the reset
+    message_batch_init(&message_batch);
+    low_power_init();
+    lander_arq_init();
+    lander_dispatch_init();
+    lander_link_speed_init();
+    lander_log_init();
     initialize_all_electronic_pins();
 
 }
 
-// Function to initialize the general ADC settings
-void initialize_adc_general(void) {
-    ADC12CTL0 &= ~ADC12ENC;            // Disable ADC12
-    ADC12CTL0 = ADC12SHT0_2 | ADC12ON; // Set sampling time, S&H=16, ADC12 on
-    ADC12CTL1 = ADC12SHP;              // Use sampling timer
-    ADC12CTL2 |= ADC12RES_2;           // 12-bit conversion results
-    ADC12IER2 |= ADC12TOVIE | ADC12OVIE; // Enable overflow interrupts
-    ADC12CTL0 |= ADC12ENC;             // Enable conversions
-    PM5CTL0 &= ~LOCKLPM5;              // Disable the GPIO power-on default high-impedance mode
-}
-
 // function to set sub main clock and digital clock oscillator to 16MHz
 void setup_SMCLK(void)
 {
@@ -55,41 +52,39 @@ void setup_SMCLK(void)
     CSCTL0_H = 0;                               // Lock CS registers
 }
 
-// Function to start the timeout timer
-void startTimeoutTimer_TA2()
-{
-    timeoutOccurred = false;  // Reset timeout flag
-    TA2CTL = TASSEL_2 + MC_1 + ID__4 + TACLR; // SMCLK = 16 MHz, up mode, input divider by 4, clear TAR
-    TA2CCTL0 = CCIE;          // Enable interrupt
-    TA2CCR0 = 60000;          // Set CCR0 value for the timer
+// Function to start the 1 ms system tick
+void start_system_tick(void) {
+    system_ticks_ms = 0;
+    soft_timer_list_init(&system_timers, 0);
+    TA0CTL = TASSEL_2 + MC_1 + ID__8 + TACLR; // SMCLK = 16 MHz, up mode, input divider by 8, clear TAR
+    TA0EX0 = TAIDEX_1;  // Expanded divider by 2, the timer counts at 1 MHz
+    TA0CCTL0 = CCIE;    // Enable interrupt
+    TA0CCR0 = 1000 - 1; // Interrupt every 1000 counts (1 ms)
 }
 
-// Function to stop the timeout timer
-void stopTimeoutTimer_TA2()
-{
-    TA2CTL = MC_0;       // Stop the timer
-    TA2CCTL0 = ~CCIE;    // Disable interrupt
-    timeoutOccurred = false;  // Reset timeout flag
+// Function to read the system tick, a 16-bit read is atomic on the MSP430
+uint16_t system_tick_now(void) {
+    return system_ticks_ms;
 }
 
-// Function to start the timeout timer with the lowest clock frequency timeout occurs every 0.25 seconds
-void startTimeoutTimer_TA3() {
-    timeoutCounterTA3 = 0;  // Reset timeout counter
-    TA3CTL = TASSEL_2 + MC_1 + ID__8 + TACLR; // SMCLK = 16 MHz, up mode, input divider by 8, clear TAR
-    TA3EX0 = TAIDEX_7;  // Expanded divider by 8
-    TA3CCTL0 = CCIE;    // Enable interrupt
-    TA3CCR0 = 62500;    // Set CCR0 value for the timer
+// Function to start a software timer, the tick interrupt must not see the list halfway
+bool system_timer_start(Soft_timer *timer, uint16_t delay_ms, uint16_t period_ms) {
+    unsigned short interrupt_state = __get_interrupt_state();
+    __disable_interrupt();
+    bool started = soft_timer_start(&system_timers, timer, delay_ms, period_ms);
+    __set_interrupt_state(interrupt_state);
+    return started;
 }
 
-// Function to stop the timeout timer
-void stopTimeoutTimer_TA3() {
-    TA3CTL = MC_0;       // Stop the timer
-    TA3CCTL0 = 0;        // Disable interrupt (clearing the CCIE bit)
-    timeoutCounterTA3 = 0;  // Reset timeout counter
+// Function to stop a software timer
+void system_timer_stop(Soft_timer *timer) {
+    unsigned short interrupt_state = __get_interrupt_state();
+    __disable_interrupt();
+    soft_timer_stop(&system_timers, timer);
+    __set_interrupt_state(interrupt_state);
 }
 
 
-
 // Initialize LED
 void init_LED(void) {
     P1DIR |= BIT5;   // Set P1.5 as output
@@ -98,34 +93,20 @@ void init_LED(void) {
 
 
 
-// Timer A2 CCR0 interrupt service routine
-#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
-#pragma vector = TIMER2_A0_VECTOR
-__interrupt void Timer_A2_ISR (void)
-#elif defined(__GNUC__)
-void __attribute__ ((interrupt(TIMER2_A0_VECTOR))) Timer_A2_ISR (void)
-#else
-#error Compiler not supported!
-#endif
-{
-    // Handle CCR0 interrupt
-    timeoutOccurred = true;  // Set timeout flag
-    TA2CTL = MC_0;           // Stop the timer
-    TA2CCTL0 &= ~CCIE;       // Disable interrupt
-}
-
-
-// Timer A3 CCR0 interrupt service routine
+// Timer A0 CCR0 interrupt service routine
 #if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
-#pragma vector = TIMER3_A0_VECTOR
-__interrupt void Timer_A3_ISR(void)
+#pragma vector = TIMER0_A0_VECTOR
+__interrupt void Timer_A0_ISR(void)
 #elif defined(__GNUC__)
-void __attribute__ ((interrupt(TIMER3_A0_VECTOR))) Timer_A3_ISR(void)
+void __attribute__ ((interrupt(TIMER0_A0_VECTOR))) Timer_A0_ISR(void)
 #else
 #error Compiler not supported!
 #endif
 {
-    // Handle CCR0 interrupt
-    TA3CCTL0 &= ~CCIFG;  // Clear interrupt flag
-    timeoutCounterTA3++;
+    // CCR0 flag is cleared automatically
+    system_ticks_ms++;
+    // every timeout of the firmware is a software timer on this tick
+    soft_timer_tick(&system_timers, system_ticks_ms);
+    // the waits on the lander link and on the software timers check their flags every tick
+    LOW_POWER_WAKE_ON_EXIT();
 }
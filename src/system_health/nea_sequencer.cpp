@@ -0,0 +1,152 @@
+/*
+ * nea_sequencer.cpp file
+ *
+ * This file includes the polled firing sequence of the NEAs, see nea_sequencer.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+// include header files
+#include "system_health_lib/nea_sequencer.h"
+
+/*
+ * Enters a state at the given quarter second.
+ */
+static void nea_sequencer_enter(Nea_sequencer *sequencer, Nea_sequence_state state, uint16_t now)
+{
+    sequencer->state = state;
+    sequencer->state_start = now;
+}
+
+/*
+ * Returns the quarter seconds since the current state started.
+ */
+static uint16_t nea_sequencer_elapsed(const Nea_sequencer *sequencer, uint16_t now)
+{
+    return (uint16_t)(now - sequencer->state_start);
+}
+
+/*
+ * Reports the result of the current NEA and goes on with the next one, or ends the sequence after the last one.
+ */
+static void nea_sequencer_finish_nea(Nea_sequencer *sequencer, bool released, uint16_t now)
+{
+    uint8_t nea = sequencer->nea;
+    sequencer->released[nea] = released;
+    sequencer->nea_attempts[nea] = sequencer->attempts;
+    sequencer->nea_quarters[nea] = (uint16_t)(now - sequencer->nea_start);
+    sequencer->hardware->report_nea(nea, released, sequencer->attempts, sequencer->nea_quarters[nea]);
+
+    sequencer->nea++;
+    sequencer->attempts = 0;
+    sequencer->nea_start = now;
+    if (sequencer->nea == NEA_COUNT) {
+        sequencer->hardware->set_charge(false);
+        nea_sequencer_enter(sequencer, NEA_SEQUENCE_DONE, now);
+    } else {
+        nea_sequencer_enter(sequencer, NEA_SEQUENCE_CHARGING, now);
+    }
+}
+
+/*
+ * Handles the current state once, returns true when the state changed.
+ */
+static bool nea_sequencer_step(Nea_sequencer *sequencer, uint16_t now)
+{
+    const Nea_sequencer_hardware *hardware = sequencer->hardware;
+    switch (sequencer->state) {
+        case NEA_SEQUENCE_CHARGING:
+        case NEA_SEQUENCE_RETRY:
+            if (sequencer->held || nea_sequencer_elapsed(sequencer, now) < NEA_CHARGE_QUARTERS) {
+                return false;
+            }
+            hardware->set_fire(sequencer->nea, true);
+            nea_sequencer_enter(sequencer, NEA_SEQUENCE_FIRING, now);
+            return true;
+
+        case NEA_SEQUENCE_FIRING:
+            if (nea_sequencer_elapsed(sequencer, now) < NEA_FIRE_QUARTERS) {
+                return false;
+            }
+            nea_sequencer_enter(sequencer, NEA_SEQUENCE_VERIFYING, now);
+            return true;
+
+        case NEA_SEQUENCE_VERIFYING: {
+            bool ready = hardware->read_ready(sequencer->nea);
+            hardware->set_fire(sequencer->nea, false);
+            sequencer->attempts++;
+            hardware->report_attempt(sequencer->nea, ready);
+            if (!ready) {
+                nea_sequencer_finish_nea(sequencer, true, now);
+            } else if (sequencer->attempts < NEA_MAX_ATTEMPTS) {
+                nea_sequencer_enter(sequencer, NEA_SEQUENCE_RETRY, now);
+            } else {
+                nea_sequencer_finish_nea(sequencer, false, now);
+            }
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+void nea_sequencer_init(Nea_sequencer *sequencer, const Nea_sequencer_hardware *hardware)
+{
+    sequencer->hardware = hardware;
+    sequencer->state = NEA_SEQUENCE_IDLE;
+    sequencer->held = false;
+    sequencer->nea = 0;
+    sequencer->attempts = 0;
+    sequencer->state_start = 0;
+    sequencer->nea_start = 0;
+    for (uint8_t nea = 0; nea < NEA_COUNT; nea++) {
+        sequencer->released[nea] = false;
+        sequencer->nea_attempts[nea] = 0;
+        sequencer->nea_quarters[nea] = 0;
+    }
+}
+
+void nea_sequencer_start(Nea_sequencer *sequencer, uint16_t now)
+{
+    nea_sequencer_init(sequencer, sequencer->hardware);
+    for (uint8_t nea = 0; nea < NEA_COUNT; nea++) {
+        sequencer->hardware->set_fire(nea, false);
+    }
+    sequencer->hardware->set_charge(true);
+    sequencer->nea_start = now;
+    nea_sequencer_enter(sequencer, NEA_SEQUENCE_CHARGING, now);
+}
+
+bool nea_sequencer_poll(Nea_sequencer *sequencer, uint16_t now)
+{
+    while (nea_sequencer_step(sequencer, now)) {
+    }
+    return sequencer->state == NEA_SEQUENCE_DONE || sequencer->state == NEA_SEQUENCE_ABORTED;
+}
+
+bool nea_sequencer_abort(Nea_sequencer *sequencer)
+{
+    if (!nea_sequencer_running(sequencer)) {
+        return false;
+    }
+    for (uint8_t nea = 0; nea < NEA_COUNT; nea++) {
+        sequencer->hardware->set_fire(nea, false);
+    }
+    sequencer->hardware->set_charge(false);
+    sequencer->state = NEA_SEQUENCE_ABORTED;
+    return true;
+}
+
+void nea_sequencer_hold(Nea_sequencer *sequencer, bool held)
+{
+    sequencer->held = held;
+}
+
+int16_t nea_sequencer_seconds(uint16_t quarters)
+{
+    // a half second or more rounds up
+    return (int16_t)((quarters >> 2) + ((quarters >> 1) & 1));
+}
@@ -0,0 +1,43 @@
+/*
+ * period_capture.cpp file
+ *
+ * This file includes the period measurement of a temperature sensor, see period_capture.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+// include header files
+#include "system_health_lib/period_capture.h"
+#include "system_health_lib/sensor_filters.h"
+
+void period_capture_start(Period_capture *capture)
+{
+    capture->count = 0;
+    capture->started = false;
+    capture->last_edge = 0;
+}
+
+bool period_capture_edge(Period_capture *capture, uint16_t edge)
+{
+    if (period_capture_done(capture)) {
+        return true;
+    }
+    if (capture->started) {
+        // the subtraction wraps around with the timer
+        capture->periods[capture->count++] = (uint16_t)(edge - capture->last_edge);
+    }
+    capture->started = true;
+    capture->last_edge = edge;
+    return period_capture_done(capture);
+}
+
+uint16_t period_capture_median(const Period_capture *capture)
+{
+    uint16_t periods[PERIOD_CAPTURE_COUNT];
+    for (uint8_t i = 0; i < PERIOD_CAPTURE_COUNT; i++) {
+        periods[i] = i < capture->count ? capture->periods[i] : PERIOD_CAPTURE_MISSING;
+    }
+    return filter_median_in_place<PERIOD_CAPTURE_COUNT>(periods);
+}
@@ -0,0 +1,158 @@
+/*
+ * scheduler.cpp file
+ *
+ * This file includes the cooperative task scheduler of the RDS, see scheduler.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+// include header files
+#include "system_health_lib/scheduler.h"
+
+#include <stddef.h>
+
+/*
+ * Returns whether tick a comes before tick b, across the wrap-around of the tick.
+ */
+static inline bool scheduler_before(uint16_t a, uint16_t b)
+{
+    return (int16_t)(a - b) < 0;
+}
+
+/*
+ * Counts an overrun of a task and reports it.
+ */
+static void scheduler_overrun(Scheduler *scheduler, Task *task)
+{
+    task->statistics.overruns++;
+    if (scheduler->overrun != NULL) {
+        scheduler->overrun(scheduler, task);
+    }
+}
+
+/*
+ * Releases a task at the given tick, a task that is still waiting keeps its first release.
+ */
+static void scheduler_release(Task *task, uint16_t tick)
+{
+    if (!task->released) {
+        task->released = true;
+        task->release = tick;
+    }
+}
+
+/*
+ * Releases the periodic tasks whose period has passed.
+ */
+static void scheduler_release_periodic(Scheduler *scheduler, uint16_t now)
+{
+    for (uint8_t i = 0; i < scheduler->task_count; i++) {
+        Task *task = &scheduler->tasks[i];
+        if (!task->enabled || task->period == 0 || scheduler_before(now, task->next_release)) {
+            continue;
+        }
+        // without a deadline the period is the deadline, a release that comes while the previous one still waits
+        if (task->released && task->deadline == 0) {
+            scheduler_overrun(scheduler, task);
+        }
+        scheduler_release(task, task->next_release);
+        // periods that passed completely while the task could not run are skipped, a late run is caught by the deadline
+        task->next_release = (uint16_t)(task->next_release + task->period);
+        if (!scheduler_before(now, task->next_release)) {
+            task->next_release = (uint16_t)(now + task->period);
+        }
+    }
+}
+
+bool scheduler_init(Scheduler *scheduler, Task *tasks, uint8_t task_count, Scheduler_clock_function clock,
+                    Scheduler_overrun_function overrun)
+{
+    scheduler->tasks = tasks;
+    scheduler->task_count = task_count;
+    scheduler->mode = 0;
+    scheduler->clock = clock;
+    scheduler->overrun = overrun;
+
+    bool valid = true;
+    for (uint8_t i = 0; i < task_count; i++) {
+        Task *task = &tasks[i];
+        if (task->period > SCHEDULER_MAX_PERIOD || task->deadline > SCHEDULER_MAX_PERIOD) {
+            valid = false;
+        }
+        task->enabled = false;
+        task->released = false;
+        task->release = 0;
+        task->next_release = 0;
+        task->statistics = Task_statistics{0, 0, 0, 0};
+    }
+    return valid;
+}
+
+void scheduler_set_mode(Scheduler *scheduler, uint8_t mode)
+{
+    uint16_t now = scheduler->clock();
+    scheduler->mode = mode;
+
+    for (uint8_t i = 0; i < scheduler->task_count; i++) {
+        Task *task = &scheduler->tasks[i];
+        bool enabled = (task->modes & SCHEDULER_MODE(mode)) != 0;
+        if (enabled && !task->enabled) {
+            task->enabled = true;
+            task->released = false;
+            if (task->period != 0) {
+                scheduler_release(task, now);
+                task->next_release = (uint16_t)(now + task->period);
+            }
+        } else if (!enabled) {
+            task->enabled = false;
+            task->released = false;
+        }
+    }
+}
+
+void scheduler_signal(Scheduler *scheduler, Task *task)
+{
+    if (task->enabled) {
+        scheduler_release(task, scheduler->clock());
+    }
+}
+
+bool scheduler_run_next(Scheduler *scheduler)
+{
+    uint16_t start = scheduler->clock();
+    scheduler_release_periodic(scheduler, start);
+
+    Task *task = NULL;
+    for (uint8_t i = 0; i < scheduler->task_count; i++) {
+        if (scheduler->tasks[i].released) {
+            task = &scheduler->tasks[i];
+            break;
+        }
+    }
+    if (task == NULL) {
+        return false;
+    }
+
+    // released before the run, such that the task can signal itself to run again
+    task->released = false;
+    uint16_t release = task->release;
+    task->run(task);
+    uint16_t end = scheduler->clock();
+
+    Task_statistics *statistics = &task->statistics;
+    uint16_t latency = (uint16_t)(start - release);
+    uint16_t response = (uint16_t)(end - release);
+    statistics->runs++;
+    if (latency > statistics->worst_latency) {
+        statistics->worst_latency = latency;
+    }
+    if (response > statistics->worst_response) {
+        statistics->worst_response = response;
+    }
+    if (task->deadline != 0 && response > task->deadline) {
+        scheduler_overrun(scheduler, task);
+    }
+    return true;
+}
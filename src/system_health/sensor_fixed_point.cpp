@@ -0,0 +1,103 @@
+/*
+ * sensor_fixed_point.cpp file
+ *
+ * This file includes the integer conversions of the sensor readouts, see sensor_fixed_point.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+// include header files
+#include "system_health_lib/sensor_fixed_point.h"
+
+// Millivolts per ADC count in Q16. 3640 / 4095 is 8 / 9, the error of the reciprocal stays far below the distance of
+// 1 / 18 mV between a result and the next rounding point, so every count gives the rounded float result.
+static constexpr uint32_t SENSOR_MILLIVOLTS_PER_COUNT_Q16 =
+    (((uint32_t)SENSOR_ADC_FULL_SCALE_MILLIVOLTS << 16) + SENSOR_ADC_MAX_VALUE / 2) / SENSOR_ADC_MAX_VALUE;
+
+// Capture ticks per second times 100, the frequency in centihertz is this over the period
+static constexpr uint32_t SENSOR_CAPTURE_CENTIHERTZ = SENSOR_CAPTURE_CLOCK_HZ * 100;
+
+// Half centidegrees times the frequency in centihertz, the temperature is this over the frequency minus the offset of
+// R0. 2.91e9 still fits in 32 bits.
+static constexpr uint32_t SENSOR_HALF_CENTIDEGREES_CENTIHERTZ =
+    (uint32_t)(2.0 * 100.0 * 100.0 / (SENSOR_OSCILLATOR_FACTOR * SENSOR_OSCILLATOR_CAPACITANCE *
+                                      SENSOR_RTD_OHM_PER_DEGREE) + 0.5);
+static constexpr uint32_t SENSOR_HALF_CENTIDEGREES_OFFSET =
+    (uint32_t)(2.0 * 100.0 * SENSOR_RTD_R0_OHM / SENSOR_RTD_OHM_PER_DEGREE + 0.5);
+
+static_assert((uint64_t)SENSOR_MAX_PERIOD * SENSOR_CENTIDEGREES_PER_TICK_Q15 <= UINT32_MAX,
+              "the temperature of the longest period does not fit in 32 bits");
+
+/*
+ * Gives a temperature its sign and limits it to the int16_t range.
+ */
+static int16_t sensor_signed_centidegrees(uint32_t magnitude, bool negative)
+{
+    if (magnitude > 32767) {
+        return negative ? -32767 : 32767;
+    }
+    return negative ? -(int16_t)magnitude : (int16_t)magnitude;
+}
+
+uint16_t adc_to_millivolts(uint16_t adc_value)
+{
+    return (uint16_t)(((uint32_t)adc_value * SENSOR_MILLIVOLTS_PER_COUNT_Q16 + 0x8000) >> 16);
+}
+
+uint32_t period_to_centihertz(uint16_t period)
+{
+    if (period == 0) {
+        return 0;
+    }
+    return (SENSOR_CAPTURE_CENTIHERTZ + period / 2) / period;
+}
+
+int16_t centihertz_to_centidegrees(uint32_t centihertz)
+{
+    if (centihertz < SENSOR_MIN_FREQUENCY_HZ * 100UL || centihertz > SENSOR_MAX_FREQUENCY_HZ * 100UL) {
+        return SENSOR_CENTIDEGREES_ERROR;
+    }
+    uint32_t half = (SENSOR_HALF_CENTIDEGREES_CENTIHERTZ + centihertz / 2) / centihertz;
+    bool negative = half < SENSOR_HALF_CENTIDEGREES_OFFSET;
+    uint32_t above = negative ? SENSOR_HALF_CENTIDEGREES_OFFSET - half : half - SENSOR_HALF_CENTIDEGREES_OFFSET;
+    uint32_t magnitude = (above + 1) / 2;
+    return sensor_signed_centidegrees(magnitude, negative);
+}
+
+bool period_is_valid(uint16_t period)
+{
+    return period >= SENSOR_MIN_PERIOD && period <= SENSOR_MAX_PERIOD;
+}
+
+int16_t period_to_centidegrees(uint16_t period)
+{
+    if (!period_is_valid(period)) {
+        return SENSOR_CENTIDEGREES_ERROR;
+    }
+    uint32_t scaled = (uint32_t)period * SENSOR_CENTIDEGREES_PER_TICK_Q15;
+    bool negative = scaled < SENSOR_CENTIDEGREES_OFFSET_Q15;
+    uint32_t magnitude = negative ? SENSOR_CENTIDEGREES_OFFSET_Q15 - scaled : scaled - SENSOR_CENTIDEGREES_OFFSET_Q15;
+    return sensor_signed_centidegrees((magnitude + 0x4000) >> 15, negative);
+}
+
+void fixed_to_uint8_array_2(int32_t value, uint8_t *array)
+{
+    // Split the value in the integer and the fractional part, both positive
+    bool is_negative = value < 0;
+    uint32_t magnitude = is_negative ? 0u - (uint32_t)value : (uint32_t)value;
+    uint16_t integer_part = (uint16_t)(magnitude / 10000);
+    uint16_t decimal_part = (uint16_t)(magnitude % 10000);
+
+    // Format the value into the array as "XXX.XXXX", a negative value has its sign instead of the hundreds digit
+    array[0] = is_negative ? '-' : '0' + ((integer_part / 100) % 10);
+    array[1] = '0' + ((integer_part / 10) % 10);    // Tens digit of integer part
+    array[2] = '0' + (integer_part % 10);           // Units digit of integer part
+    array[3] = '.';                                 // Decimal point
+    array[4] = '0' + (decimal_part / 1000);         // First decimal place
+    array[5] = '0' + ((decimal_part / 100) % 10);   // Second decimal place
+    array[6] = '0' + ((decimal_part / 10) % 10);    // Third decimal place
+    array[7] = '0' + (decimal_part % 10);           // Fourth decimal place
+    array[8] = '\0';                                // Null terminator
+}
@@ -0,0 +1,123 @@
+/*
+ * soft_timer.cpp file
+ *
+ * This file includes the software timers of the RDS, see soft_timer.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+// include header files
+#include "system_health_lib/soft_timer.h"
+
+#include <stddef.h>
+
+/*
+ * Returns whether tick a comes before tick b, across the wrap-around of the tick.
+ */
+static inline bool soft_timer_before(uint16_t a, uint16_t b)
+{
+    return (int16_t)(a - b) < 0;
+}
+
+/*
+ * Puts a timer in the list behind the timers that expire at the same tick or earlier.
+ */
+static void soft_timer_insert(Soft_timer_list *list, Soft_timer *timer)
+{
+    Soft_timer **link = &list->first;
+    while (*link != NULL && !soft_timer_before(timer->expiry, (*link)->expiry)) {
+        link = &(*link)->next;
+    }
+    timer->next = *link;
+    *link = timer;
+    timer->running = true;
+}
+
+/*
+ * Takes a timer out of the list.
+ */
+static void soft_timer_remove(Soft_timer_list *list, Soft_timer *timer)
+{
+    Soft_timer **link = &list->first;
+    while (*link != NULL) {
+        if (*link == timer) {
+            *link = timer->next;
+            break;
+        }
+        link = &(*link)->next;
+    }
+    timer->next = NULL;
+    timer->running = false;
+}
+
+void soft_timer_list_init(Soft_timer_list *list, uint16_t now)
+{
+    list->first = NULL;
+    list->now = now;
+}
+
+void soft_timer_init(Soft_timer *timer, Soft_timer_callback callback, void *context)
+{
+    timer->next = NULL;
+    timer->expiry = 0;
+    timer->period = 0;
+    timer->running = false;
+    timer->expirations = 0;
+    timer->callback = callback;
+    timer->context = context;
+}
+
+bool soft_timer_start(Soft_timer_list *list, Soft_timer *timer, uint16_t delay, uint16_t period)
+{
+    if (delay == 0 || delay > SOFT_TIMER_MAX_DELAY || period > SOFT_TIMER_MAX_DELAY) {
+        return false;
+    }
+    if (timer->running) {
+        soft_timer_remove(list, timer);
+    }
+    timer->expiry = (uint16_t)(list->now + delay);
+    timer->period = period;
+    timer->expirations = 0;
+    soft_timer_insert(list, timer);
+    return true;
+}
+
+void soft_timer_stop(Soft_timer_list *list, Soft_timer *timer)
+{
+    if (timer->running) {
+        soft_timer_remove(list, timer);
+    }
+}
+
+void soft_timer_tick(Soft_timer_list *list, uint16_t now)
+{
+    list->now = now;
+    // the list is sorted, so the first timer that has not expired ends the tick
+    while (list->first != NULL && !soft_timer_before(now, list->first->expiry)) {
+        Soft_timer *timer = list->first;
+        list->first = timer->next;
+        timer->next = NULL;
+        timer->running = false;
+
+        // rescheduled before the callback, such that the callback can stop or restart its own timer
+        if (timer->period != 0) {
+            timer->expiry = (uint16_t)(timer->expiry + timer->period);
+            soft_timer_insert(list, timer);
+        }
+        timer->expirations++;
+        if (timer->callback != NULL) {
+            timer->callback(timer);
+        }
+    }
+}
+
+uint16_t soft_timer_next_expiry(const Soft_timer_list *list)
+{
+    if (list->first == NULL) {
+        return 0;
+    }
+    int16_t remaining = (int16_t)(list->first->expiry - list->now);
+    return remaining > 0 ? (uint16_t)remaining : 1;
+}
@@ -0,0 +1,92 @@
+/*
+ * supercap_check.cpp file
+ *
+ * This file includes the polled functionality check of the supercapacitors, see supercap_check.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+// include header files
+#include "system_health_lib/supercap_check.h"
+
+/*
+ * Starts charging waiting caps until the budget is used.
+ */
+static void supercap_check_start_waiting(Supercap_check *check, uint16_t now)
+{
+    uint8_t charging = 0;
+    for (uint8_t cap = 0; cap < SUPERCAP_COUNT; cap++) {
+        if (check->state[cap] == SUPERCAP_CHARGING) {
+            charging++;
+        }
+    }
+    for (uint8_t cap = 0; cap < SUPERCAP_COUNT && charging < check->budget; cap++) {
+        if (check->state[cap] == SUPERCAP_WAITING) {
+            check->state[cap] = SUPERCAP_CHARGING;
+            check->charge_start[cap] = now;
+            check->hardware->set_charge(cap, true);
+            charging++;
+        }
+    }
+}
+
+/*
+ * Measures a cap that is charged, with the other charging caps taken off the shared voltage pin.
+ */
+static void supercap_check_measure(Supercap_check *check, uint8_t measured)
+{
+    const Supercap_check_hardware *hardware = check->hardware;
+    for (uint8_t cap = 0; cap < SUPERCAP_COUNT; cap++) {
+        if (cap != measured && check->state[cap] == SUPERCAP_CHARGING) {
+            hardware->set_charge(cap, false);
+        }
+    }
+
+    hardware->set_discharge(true);
+    uint16_t millivolts = hardware->measure();
+    hardware->set_charge(measured, false);
+    hardware->set_discharge(false);
+
+    for (uint8_t cap = 0; cap < SUPERCAP_COUNT; cap++) {
+        if (cap != measured && check->state[cap] == SUPERCAP_CHARGING) {
+            hardware->set_charge(cap, true);
+        }
+    }
+
+    bool ready = millivolts > SUPERCAP_READY_MILLIVOLTS && millivolts <= SUPERCAP_MAX_MILLIVOLTS;
+    check->ready[measured] = ready;
+    check->state[measured] = SUPERCAP_CHECKED;
+    check->checked++;
+    hardware->report(measured, ready);
+}
+
+void supercap_check_start(Supercap_check *check, const Supercap_check_hardware *hardware, uint8_t budget,
+                          uint16_t now)
+{
+    check->hardware = hardware;
+    check->budget = budget == 0 ? 1 : budget;
+    check->checked = 0;
+    for (uint8_t cap = 0; cap < SUPERCAP_COUNT; cap++) {
+        check->state[cap] = SUPERCAP_WAITING;
+        check->charge_start[cap] = 0;
+        check->ready[cap] = false;
+        hardware->set_charge(cap, false);
+    }
+    hardware->set_discharge(false);
+
+    supercap_check_start_waiting(check, now);
+}
+
+bool supercap_check_poll(Supercap_check *check, uint16_t now)
+{
+    for (uint8_t cap = 0; cap < SUPERCAP_COUNT; cap++) {
+        if (check->state[cap] == SUPERCAP_CHARGING &&
+            (uint16_t)(now - check->charge_start[cap]) >= SUPERCAP_CHARGE_QUARTERS) {
+            supercap_check_measure(check, cap);
+        }
+    }
+    supercap_check_start_waiting(check, now);
+    return supercap_check_done(check);
+}
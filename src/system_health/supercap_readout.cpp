@@ -23,10 +23,8 @@ bool supercap_functionality[3]  = {false,false,false};
 #define MAX_VOLTAGE          3.64      // Reference voltage for ADC (measured 3.64 V)
 #define ADC_TIMEOUT 100 // Define a timeout value
 
-// Global flag for ADC conversion failure
-volatile bool adc_conversion_fail = false;
-volatile bool measurement_finished = false;
-volatile unsigned int ADC_capture = 0; // Variable to store ADC result
+// Timer that expires every 0.25 seconds during the supercap check, the clock of the check
+static Soft_timer quarterSecondTimer;
 
 // ADC12 interrupt service routine
 #if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
@@ -46,17 +44,34 @@ void __attribute__ ((interrupt(ADC12_VECTOR))) ADC12_ISR (void)
     case ADC12IV_ADC12OVIFG:
         // ADC12MEMx Overflow (could be implemented later)
         break;
+    case ADC12IV_ADC12HIIFG:
+        // Comparator channel of the monitor above its window
+        if (adc_monitor_comparator_isr(ADC_WINDOW_ABOVE)) {
+            LOW_POWER_WAKE_ON_EXIT();
+        }
+        break;
+    case ADC12IV_ADC12LOIFG:
+        // Comparator channel of the monitor below its window
+        if (adc_monitor_comparator_isr(ADC_WINDOW_BELOW)) {
+            LOW_POWER_WAKE_ON_EXIT();
+        }
+        break;
+    case ADC12IV_ADC12INIFG:
+        // Comparator channel of the monitor back inside its window
+        if (adc_monitor_comparator_isr(ADC_WINDOW_INSIDE)) {
+            LOW_POWER_WAKE_ON_EXIT();
+        }
+        break;
     case ADC12IV_ADC12TOVIFG:
         // Conversion time overflow
-        adc_conversion_fail = true;
-        ADC12CTL0 &= ~ADC12SC; // Stop conversion
+        adc_sequence_done_isr(true);
+        LOW_POWER_WAKE_ON_EXIT();
+        break;
+    case ADC_SEQUENCE_IV:
+        // Last slot of the sequence converted, the results are read by adc_snapshot()
+        adc_sequence_done_isr(false);
+        LOW_POWER_WAKE_ON_EXIT();
         break;
-    case ADC12IV_ADC12IFG0:
-         ADC_capture = ADC12MEM0;           // Read conversion result
-         ADC12CTL0 &= ~ADC12SC;
-         measurement_finished = true;
-
-         break;
     default:
         break;
   }
@@ -142,43 +157,6 @@ void initialize_capready(void) {
     PM5CTL0 &= ~LOCKLPM5;         // Disable the GPIO power-on default high-impedance mode
 }
 
-// Function to initialize the ADC for super capacitors
-void initialize_adc_supercaps(void) {
-    ADC12CTL0 &= ~ADC12ENC;            // Disable ADC12
-    ADC12MCTL0 |= ADC12INCH_7;         // Select channel A7 for conversion
-    ADC12CTL0 |= ADC12ENC;             // Enable conversions
-    PM5CTL0 &= ~LOCKLPM5;              // Disable the GPIO power-on default high-impedance mode
-}
-
-//// Function to initialize the ADC for super capacitors for polling
-//void initialize_adc_supercaps(void) {
-//    ADC12CTL0 &= ~ADC12ENC;            // Disable ADC12
-//    ADC12CTL0 = ADC12SHT0_2 | ADC12ON; // 16 ADC12CLK cycles, ADC on
-//    ADC12CTL1 = ADC12SHP | ADC12CONSEQ_0 | ADC12SSEL_3; // ADCCLK = SMCLK; single-channel single-conversion
-//    ADC12CTL2 = ADC12RES_2;            // 12-bit conversion results
-//    ADC12MCTL0 = ADC12INCH_7;          // Select channel A7 for conversion
-//    PM5CTL0 &= ~LOCKLPM5;              // Disable the GPIO power-on default high-impedance mode
-//}
-
-void enable_interrupt_adc(void){
-    ADC12CTL0 &= ~ADC12ENC;            // Disable ADC12
-    ADC12IER0 |= ADC12IE0;             // Enable ADC conversion complete interrupt
-    ADC12CTL0 |= ADC12ENC;             // Enable conversions
-    PM5CTL0 &= ~LOCKLPM5;              // Disable the GPIO power-on default high-impedance mode
-}
-
-void disable_interrupt_adc(void){
-    ADC12CTL0 &= ~ADC12ENC;            // Disable ADC12
-    ADC12IER0 &= ~ADC12IE0;             // Enable ADC conversion complete interrupt
-    ADC12CTL0 |= ADC12ENC;             // Enable conversions
-    PM5CTL0 &= ~LOCKLPM5;              // Disable the GPIO power-on default high-impedance mode
-}
-
-// Function to convert ADC value to voltage
-float convert_adc_to_voltage(volatile unsigned int adc_value) {
-    return (adc_value * (float)MAX_VOLTAGE) / (float)ADC_MAX_VALUE;
-}
-
 //// Function to read ADC value with polling and handle timeout
 //unsigned int read_ADC(void) {
 //    unsigned int timeout = 0;
@@ -219,73 +197,79 @@ float convert_adc_to_voltage(volatile unsigned int adc_value) {
 //    }
 //}
 
-// Function to get the voltage of super capacitors via ADC
-float voltage_adc_supercaps(void) {
-    initialize_adc_supercaps();        // Initialize the ADC for super capacitors
-    float voltage = 0;                 // Variable to store calculated voltage
+// Function to get the voltage of super capacitors via ADC in mV
+uint16_t millivolts_adc_supercaps(void) {
+    Adc_snapshot snapshot;
+    adc_snapshot(&snapshot);           // Convert all channels, SENSOR_MILLIVOLTS_ERROR when the conversion failed
+    return adc_snapshot_millivolts(&snapshot, ADC_CHANNEL_SUPERCAP);
+}
+
 
-    enable_interrupt_adc();
-    ADC12CTL0 |= ADC12SC;              // Start conversion - software trigger
-    while (!measurement_finished && !adc_conversion_fail);
-    disable_interrupt_adc();
-    measurement_finished = false;
-    if (adc_conversion_fail) {
-        // Conversion failed
-        voltage = 99;                  // Set error voltage
-        return voltage;
+// Pins and ADC of the supercap check
+static void supercap_check_set_charge(uint8_t cap, bool on){
+    if(on){
+        switch_on_charge_cap_flag(cap);
     } else {
-        voltage = convert_adc_to_voltage(ADC_capture); // Convert ADC result to voltage
-        return voltage;
+        switch_off_charge_cap_flag(cap);
     }
 }
 
-
-// function to check the functionality of each supercapacitor
-void check_supercap_functionality(void){
-    switch_off_charge_cap_flag(0);
-    switch_off_charge_cap_flag(1);
-    switch_off_charge_cap_flag(2);
-    switch_off_discharge_cap_flag();
-
-    for(int i=0; i < 3; i++){
-        switch_on_charge_cap_flag(i);
-        //timer 2 min = 120 seconds = 120x4 = 0.25 seconds x 480
-        startTimeoutTimer_TA3();
-        while(timeoutCounterTA3 < 480){
-            process_received_data();
-        } // 480 times 0.25 seconds is 2 minutes
-        stopTimeoutTimer_TA3();
-
+static void supercap_check_set_discharge(bool on){
+    if(on){
         switch_on_discharge_cap_flag();
+    } else {
+        switch_off_discharge_cap_flag();
+    }
+}
 
-        float voltage_supercap_i = voltage_adc_supercaps();
-        if(voltage_supercap_i > 2.475){ // above 2.475V
-            supercap_functionality[i] = true;
-        } else {
-            supercap_functionality[i] = false;
-        }
-        if(i == 0) {
-            if(supercap_functionality[i] == true){
-                send_message(MSG_TYPE_DATA, PAYLOAD_SUPERCAP1_READY, sizeof(PAYLOAD_SUPERCAP1_READY) - 1);
-            } else {
-                send_message(MSG_TYPE_DATA, PAYLOAD_SUPERCAP1_NOT_READY, sizeof(PAYLOAD_SUPERCAP1_NOT_READY) - 1);
-            }
-        } else if(i == 1) {
-            if(supercap_functionality[i] == true){
-                send_message(MSG_TYPE_DATA, PAYLOAD_SUPERCAP2_READY, sizeof(PAYLOAD_SUPERCAP2_READY) - 1);
-            } else {
-                send_message(MSG_TYPE_DATA, PAYLOAD_SUPERCAP2_NOT_READY, sizeof(PAYLOAD_SUPERCAP2_NOT_READY) - 1);
-            }
-        } else if(i == 2) {
-            if(supercap_functionality[i] == true){
-                send_message(MSG_TYPE_DATA, PAYLOAD_SUPERCAP3_READY, sizeof(PAYLOAD_SUPERCAP3_READY) - 1);
-            } else {
-                send_message(MSG_TYPE_DATA, PAYLOAD_SUPERCAP3_NOT_READY, sizeof(PAYLOAD_SUPERCAP3_NOT_READY) - 1);
-            }
-        } else {}
-        switch_off_charge_cap_flag(i);
-        switch_off_discharge_cap_flag(i);
+// Sends the result of a cap to the lander as soon as it is known
+static void supercap_check_report(uint8_t cap, bool ready){
+    static const Telemetry_event ready_events[3] = {EVENT_SUPERCAP1_READY, EVENT_SUPERCAP2_READY,
+                                                    EVENT_SUPERCAP3_READY};
+    static const Telemetry_event not_ready_events[3] = {EVENT_SUPERCAP1_NOT_READY, EVENT_SUPERCAP2_NOT_READY,
+                                                        EVENT_SUPERCAP3_NOT_READY};
+    supercap_functionality[cap] = ready;
+    send_event(ready ? ready_events[cap] : not_ready_events[cap]);
+}
+
+static const Supercap_check_hardware supercapCheckHardware = {
+    supercap_check_set_charge,
+    supercap_check_set_discharge,
+    millivolts_adc_supercaps,
+    supercap_check_report
+};
+
+static Supercap_check supercapCheck;
+
+// function to start the check of the functionality of each supercapacitor
+void supercap_functionality_check_start(void){
+    // the quarter seconds of the timer are the clock of the check
+    system_timer_start(&quarterSecondTimer, 250, 250);
+    supercap_check_start(&supercapCheck, &supercapCheckHardware, SUPERCAP_CHARGE_BUDGET,
+                         quarterSecondTimer.expirations);
+}
 
+// function to continue the check of the functionality of each supercapacitor
+bool supercap_functionality_check_poll(void){
+    if(supercap_check_done(&supercapCheck)){
+        return true;
+    }
+    bool done = supercap_check_poll(&supercapCheck, quarterSecondTimer.expirations);
+    if(done){
+        system_timer_stop(&quarterSecondTimer);
     }
+    return done;
 }
 
+// function to abandon the check of the functionality of each supercapacitor
+void supercap_functionality_check_stop(void){
+    system_timer_stop(&quarterSecondTimer);
+    if(!supercap_check_done(&supercapCheck)){
+        // no cap is left charging, the results that are known are kept
+        switch_off_charge_cap_flag(0);
+        switch_off_charge_cap_flag(1);
+        switch_off_charge_cap_flag(2);
+        switch_off_discharge_cap_flag();
+        supercapCheck.checked = SUPERCAP_COUNT;
+    }
+}
@@ -15,8 +15,11 @@
 
 #include "system_health_lib/temp_sensors.h"
 
-// Define the number of runs for the measurement
-#define numberOfRuns 9
+// Period measurements of the sensors, filled in by the capture interrupt
+static Period_capture temperatureCaptures[TEMPERATURE_SENSOR_COUNT];
+
+// Timeout of the acquisition of both sensors
+static Soft_timer temperatureTimeout;
 
 
 // Function to initialize all the pins used to measure the temperature via oscillation
@@ -44,18 +47,6 @@ void initialize_temperature_pins(void) {
 }
 
 
-// Function to convert frequency to temperature
-float frequency_to_temperature(float frequency) {
-    if (frequency >= 150 && frequency <= 800) {
-        float capacitance = 0.0000022; // Capacitance in Farads
-        float x = 1.0 / (0.4055 * 2.0 * capacitance * frequency); // Intermediate calculation using the frequency
-        float temperature = (x - 1000.0) / 3.85; // Convert intermediate value to temperature
-        return temperature; // Return the calculated temperature
-    } else {
-        return -99.0;  // returns an error value that is impossible to record
-    }
-}
-
 // Function to set up Timer_B0 related to the temperature pins
 void setupTimer_B0(void) {
     TB0CTL = TBSSEL_2 | MC_2 | TBCLR | ID__4; // SMCLK, Continuous mode, clear TBR, divide the input clock by 4
@@ -69,94 +60,72 @@ void setupTimer_B0(void) {
     TB0CCTL1 &= ~CCIFG;                       // Clear interrupt flag
 }
 
-// Function to calculate frequency from the period
-float calculateFrequency(float period) {
-    if (period == 0.0) {
-        return 0;
-    }
-    const float clockFrequency = 4000000; // Assume SMCLK is 4 MHz
-    return clockFrequency / period;       // Calculate the frequency
-}
-
-// Function to read out the temperature sensor measurements
-float readout_temperature_sensor_n(volatile unsigned int* TxxCCTLx, volatile unsigned int* TxxCCRx) {
-    volatile unsigned int firstCapture = 0; // First capture value
-    volatile unsigned int secondCapture = 0; // Second capture value
-    float singlePeriod = 0;                 // Single period measurement
-    unsigned int singlePeriodMeasurements[numberOfRuns]; // Array to store period measurements
-    int i, j; // Loop counters
-    float frequency;
-
-    // Loop to take numberOfRuns period measurements
-    for (i = 0; i < numberOfRuns; i++) {
-        startTimeoutTimer_TA2();  // Start the timeout timer
-
-        *TxxCCTLx &= ~CCIFG;      // Clear interrupt flag
-
-        // Wait for the first capture or timeout
-        while (!(*TxxCCTLx & CCIFG) && !timeoutOccurred);
-
-        firstCapture = *TxxCCRx;  // Read first capture value
-        *TxxCCTLx &= ~CCIFG;      // Clear interrupt flag
-
-        // Wait for the second capture or timeout
-        while (!(*TxxCCTLx & CCIFG) && !timeoutOccurred);
-
-        secondCapture = *TxxCCRx;  // Read second capture value
-        *TxxCCTLx &= ~CCIFG;       // Clear interrupt flag
-
-        if (timeoutOccurred) {
-            stopTimeoutTimer_TA2();  // Stop the timer if timeout occurred
-            singlePeriodMeasurements[i] = 1; // Set period to 1 if timeout occurred
-        } else {
-            stopTimeoutTimer_TA2();  // Stop the timer since measurement completed within time
-
-            // Calculate the period
-            if (secondCapture >= firstCapture) {
-                singlePeriod = secondCapture - firstCapture;
-            } else {
-                singlePeriod = (secondCapture + 0x10000) - firstCapture;
+// Timer B0 CCR1 to CCR6 and overflow interrupt service routine, only the captures of the temperature sensors are enabled
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector = TIMER0_B1_VECTOR
+__interrupt void Timer_B0_ISR(void)
+#elif defined(__GNUC__)
+void __attribute__ ((interrupt(TIMER0_B1_VECTOR))) Timer_B0_ISR(void)
+#else
+#error Compiler not supported!
+#endif
+{
+    switch (__even_in_range(TB0IV, TB0IV_TBIFG)) {
+        case TB0IV_TBCCR1:
+            // Rising edge of sensor 2, the CPU only wakes up when its periods are complete
+            if (period_capture_edge(&temperatureCaptures[TEMPERATURE_SENSOR_2], TB0CCR1)) {
+                TB0CCTL1 &= ~CCIE;
+                LOW_POWER_WAKE_ON_EXIT();
             }
-
-            singlePeriodMeasurements[i] = singlePeriod; // Store the period measurement
-        }
-    }
-
-    // Sort the array to find the median
-    unsigned int temp;
-    for (i = 0; i < numberOfRuns; i++) {
-        for (j = i + 1; j < numberOfRuns; j++) {
-            if (singlePeriodMeasurements[i] > singlePeriodMeasurements[j]) {
-                temp = singlePeriodMeasurements[i];
-                singlePeriodMeasurements[i] = singlePeriodMeasurements[j];
-                singlePeriodMeasurements[j] = temp;
+            break;
+        case TB0IV_TBCCR3:
+            // Rising edge of sensor 1
+            if (period_capture_edge(&temperatureCaptures[TEMPERATURE_SENSOR_1], TB0CCR3)) {
+                TB0CCTL3 &= ~CCIE;
+                LOW_POWER_WAKE_ON_EXIT();
             }
-        }
+            break;
+        default:
+            break;
     }
+}
 
-    // Median of numberOfRuns measurements
-    float median = singlePeriodMeasurements[4];
-
-    // Calculate the frequency using the median value
-    frequency = calculateFrequency(median);
-
-    // Check if the frequency is within the valid range
-    if (frequency >= 150 && frequency <= 800) {
-        // return the temperature
-        return frequency_to_temperature(frequency); // Convert frequency to temperature
-    } else {
-        // return error value
-        return -99;
+// Function to start the acquisition of both sensors
+void temperature_acquisition_start(void) {
+    for (uint8_t sensor = 0; sensor < TEMPERATURE_SENSOR_COUNT; sensor++) {
+        period_capture_start(&temperatureCaptures[sensor]);
     }
+    system_timer_start(&temperatureTimeout, TEMPERATURE_ACQUISITION_TIMEOUT_MS, 0);  // Start the timeout timer
+
+    TB0CCTL3 &= ~CCIFG;           // Clear interrupt flag of sensor 1
+    TB0CCTL1 &= ~CCIFG;           // Clear interrupt flag of sensor 2
+    TB0CCTL3 |= CCIE;             // Every rising edge interrupts
+    TB0CCTL1 |= CCIE;
 }
 
+// Function to stop the acquisition, also when it is not done
+void temperature_acquisition_stop(void) {
+    TB0CCTL3 &= ~CCIE;
+    TB0CCTL1 &= ~CCIE;
+    system_timer_stop(&temperatureTimeout);
+}
 
-float readout_temperature_sensor_1(void){
-    return readout_temperature_sensor_n(&TB0CCTL3, &TB0CCR3);
+// Function to check whether both sensors are done or the acquisition timed out
+bool temperature_acquisition_done(void) {
+    return (period_capture_done(&temperatureCaptures[TEMPERATURE_SENSOR_1]) &&
+            period_capture_done(&temperatureCaptures[TEMPERATURE_SENSOR_2])) ||
+           soft_timer_expired(&temperatureTimeout);
 }
 
-float readout_temperature_sensor_2(void){
-    return readout_temperature_sensor_n(&TB0CCTL1, &TB0CCR1);
+// Function to get the median of the periods of a sensor, the periods that were not captured before the timeout count
+// as 1
+uint16_t temperature_acquisition_period(Temperature_sensor sensor) {
+    return period_capture_median(&temperatureCaptures[sensor]);
 }
 
+// Function to get the temperature of a sensor in centidegrees from the median of its periods
+int16_t temperature_acquisition_result(Temperature_sensor sensor) {
+    // Convert the period to the temperature, the error value when the frequency is out of range (150 Hz to 800 Hz)
+    return period_to_centidegrees(temperature_acquisition_period(sensor));
+}
 
@@ -47,9 +47,9 @@ void detach_umbilicalcord(void){
             return;
         }
         if (umbilicalcord_rover_connected()) {
-            send_message(MSG_TYPE_DATA, PAYLOAD_UMBILICAL_CONNECTED, sizeof(PAYLOAD_UMBILICAL_CONNECTED) - 1);
+            send_event(EVENT_UMBILICAL_CONNECTED);
         } else {
-            send_message(MSG_TYPE_ERROR, PAYLOAD_UMBILICAL_NOT_CONNECTED, sizeof(PAYLOAD_UMBILICAL_NOT_CONNECTED) - 1);
+            send_event(EVENT_UMBILICAL_NOT_CONNECTED);
         }
         x++;
     }
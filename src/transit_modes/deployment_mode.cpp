@@ -17,103 +17,122 @@
 // Global variable for current task
 DeploymentTaskState deploymentModeTask = TASK_DEPLOY_SWITCH_OFF_HEATERS;
 
-void deployment_mode(void){
+void deployment_mode_enter(void){
     deploymentModeTask = TASK_DEPLOY_SWITCH_OFF_HEATERS;
-    // Implement cooperative multi-tasking
-    while(transit_state == DEPLOYMENT){
-        switch(deploymentModeTask){
-            case TASK_DEPLOY_SWITCH_OFF_HEATERS:
-                // Switch off the heaters
-                MCU_heaterOn_low();
-                MCU_heaterOff_low();
-                deploymentModeTask = TASK_DEPLOY_CHECK_SUPERCAP_FUNCTIONALITY;
-                break;
+}
 
-            case TASK_DEPLOY_CHECK_SUPERCAP_FUNCTIONALITY:
-                // Check supercapacitor functionality
-                check_supercap_functionality();
-                deploymentModeTask = TASK_DEPLOY_CHECK_ALL_NEAS;
-                break;
+void deployment_mode_step(Task *task){
+    // one step per run, the task signals itself for the next step, a step that waits is polled every period
+    switch(deploymentModeTask){
+        case TASK_DEPLOY_SWITCH_OFF_HEATERS:
+            // Switch off the heaters
+            MCU_heaterOn_low();
+            MCU_heaterOff_low();
+            // the supercaps charge while the NEAs are checked
+            supercap_functionality_check_start();
+            deploymentModeTask = TASK_DEPLOY_CHECK_ALL_NEAS;
+            break;
 
-            case TASK_DEPLOY_CHECK_ALL_NEAS:
-                // NEA checkup
-                // Check the status of the 4 NEA's
-                bool status_NEA_1 = read_NEAready_status(&P3IN, BIT1);
-                bool status_NEA_2 = read_NEAready_status(&P3IN, BIT2);
-                bool status_NEA_3 = read_NEAready_status(&P3IN, BIT3);
-                bool status_NEA_4 = read_NEAready_status(&P4IN, BIT7);
+        case TASK_DEPLOY_CHECK_ALL_NEAS: {
+            // NEA checkup
+            // Check the status of the 4 NEA's
+            bool status_NEA_1 = read_NEAready_status(&P3IN, BIT1);
+            bool status_NEA_2 = read_NEAready_status(&P3IN, BIT2);
+            bool status_NEA_3 = read_NEAready_status(&P3IN, BIT3);
+            bool status_NEA_4 = read_NEAready_status(&P4IN, BIT7);
 
-                if (status_NEA_1 && status_NEA_2 && status_NEA_3 && status_NEA_4) {
-                    // Send message that none of the NEA's is activated already
-                    send_message(MSG_TYPE_DATA, PAYLOAD_ALL_NEA_READY, sizeof(PAYLOAD_ALL_NEA_READY) - 1);
+            if (status_NEA_1 && status_NEA_2 && status_NEA_3 && status_NEA_4) {
+                // Send message that none of the NEA's is activated already
+                send_event(EVENT_ALL_NEA_READY);
+            } else {
+                if (status_NEA_1) {
+                    // Send message that NEA 1 is not activated yet
+                    send_event(EVENT_NEA1_READY);
+                } else {
+                    // Send message that NEA 1 is already activated
+                    send_event(EVENT_NEA1_NOT_READY);
+                }
+                if (status_NEA_2) {
+                    // Send message that NEA 2 is not activated yet
+                    send_event(EVENT_NEA2_READY);
                 } else {
-                    if (status_NEA_1) {
-                        // Send message that NEA 1 is not activated yet
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA1_READY, sizeof(PAYLOAD_NEA1_READY) - 1);
-                    } else {
-                        // Send message that NEA 1 is already activated
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA1_NOT_READY, sizeof(PAYLOAD_NEA1_NOT_READY) - 1);
-                    }
-                    if (status_NEA_2) {
-                        // Send message that NEA 2 is not activated yet
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA2_READY, sizeof(PAYLOAD_NEA2_READY) - 1);
-                    } else {
-                        // Send message that NEA 2 is already activated
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA2_NOT_READY, sizeof(PAYLOAD_NEA2_NOT_READY) - 1);
-                    }
-                    if (status_NEA_3) {
-                        // Send message that NEA 3 is not activated yet
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA3_READY, sizeof(PAYLOAD_NEA3_READY) - 1);
-                    } else {
-                        // Send message that NEA 3 is already activated
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA3_NOT_READY, sizeof(PAYLOAD_NEA3_NOT_READY) - 1);
-                    }
-                    if (status_NEA_4) {
-                        // Send message that NEA 4 is not activated yet
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA4_READY, sizeof(PAYLOAD_NEA4_READY) - 1);
-                    } else {
-                        // Send message that NEA 4 is already activated
-                        send_message(MSG_TYPE_DATA, PAYLOAD_NEA4_NOT_READY, sizeof(PAYLOAD_NEA4_NOT_READY) - 1);
-                    }
+                    // Send message that NEA 2 is already activated
+                    send_event(EVENT_NEA2_NOT_READY);
                 }
-                deploymentModeTask = TASK_DEPLOY_COMMUNICATE_DEPLOYMENT_TO_ROVER;
-                break;
+                if (status_NEA_3) {
+                    // Send message that NEA 3 is not activated yet
+                    send_event(EVENT_NEA3_READY);
+                } else {
+                    // Send message that NEA 3 is already activated
+                    send_event(EVENT_NEA3_NOT_READY);
+                }
+                if (status_NEA_4) {
+                    // Send message that NEA 4 is not activated yet
+                    send_event(EVENT_NEA4_READY);
+                } else {
+                    // Send message that NEA 4 is already activated
+                    send_event(EVENT_NEA4_NOT_READY);
+                }
+            }
+            deploymentModeTask = TASK_DEPLOY_CHECK_SUPERCAP_FUNCTIONALITY;
+            break;
+        }
 
-            case TASK_DEPLOY_COMMUNICATE_DEPLOYMENT_TO_ROVER:
-                // Communicate deployment status to rover
-                deploymentModeTask = TASK_DEPLOY_TURN_OFF_ROVER_POWER;
-                break;
+        case TASK_DEPLOY_CHECK_SUPERCAP_FUNCTIONALITY:
+            // Check supercapacitor functionality, polled every period of the task until all caps are checked
+            if (!supercap_functionality_check_poll()) {
+                return;
+            }
+            deploymentModeTask = TASK_DEPLOY_COMMUNICATE_DEPLOYMENT_TO_ROVER;
+            break;
 
-            case TASK_DEPLOY_TURN_OFF_ROVER_POWER:
-                // Turn off rover power
-                switch_off_bus_flag_pin();
-                send_message(MSG_TYPE_DATA, PAYLOAD_POWER_ROVER_OFF, sizeof(PAYLOAD_POWER_ROVER_OFF) - 1);
-                deploymentModeTask = TASK_DEPLOY_DISCONNECT_UMBILICAL;
-                break;
+        case TASK_DEPLOY_COMMUNICATE_DEPLOYMENT_TO_ROVER:
+            // Communicate deployment status to rover
+            deploymentModeTask = TASK_DEPLOY_TURN_OFF_ROVER_POWER;
+            break;
 
-            case TASK_DEPLOY_DISCONNECT_UMBILICAL:
-                // Disconnect umbilical cord
-                detach_umbilicalcord();
-                deploymentModeTask = TASK_DEPLOY_ACTIVATE_NEAS;
-                break;
+        case TASK_DEPLOY_TURN_OFF_ROVER_POWER:
+            // Turn off rover power
+            switch_off_bus_flag_pin();
+            send_event(EVENT_POWER_ROVER_OFF);
+            deploymentModeTask = TASK_DEPLOY_DISCONNECT_UMBILICAL;
+            break;
 
-            case TASK_DEPLOY_ACTIVATE_NEAS:
-                // Activate NEAs
-                activate_NEAs();
-                deploymentModeTask = TASK_DEPLOY_DONE;
-                break;
+        case TASK_DEPLOY_DISCONNECT_UMBILICAL:
+            // Disconnect umbilical cord
+            detach_umbilicalcord();
+            NEA_sequence_start();
+            deploymentModeTask = TASK_DEPLOY_ACTIVATE_NEAS;
+            break;
 
-            case TASK_DEPLOY_DONE:
-                // Deployment done
-                // Optionally, set a flag or perform an action indicating deployment is complete
-                send_message(MSG_TYPE_DATA, PAYLOAD_DEPLOYMENT_COMPLETE, sizeof(PAYLOAD_DEPLOYMENT_COMPLETE) - 1);
-                break;
+        case TASK_DEPLOY_ACTIVATE_NEAS:
+            // Activate NEAs, polled every period of the task until the firing sequence is over
+            if (!NEA_sequence_poll()) {
+                return;
+            }
+            if (NEA_sequence_state() == NEA_SEQUENCE_ABORTED) {
+                // the lander aborted the deployment, it is not complete
+                deploymentModeTask = TASK_DEPLOY_COMPLETE;
+                return;
+            }
+            deploymentModeTask = TASK_DEPLOY_DONE;
+            break;
 
-            default:
-                deploymentModeTask = TASK_DEPLOY_DONE;
-                break;
-        }
-        // Process received messages
-        process_received_data();
+        case TASK_DEPLOY_DONE:
+            // Deployment done
+            // Optionally, set a flag or perform an action indicating deployment is complete
+            send_event(EVENT_DEPLOYMENT_COMPLETE);
+            deploymentModeTask = TASK_DEPLOY_COMPLETE;
+            return;
+
+        case TASK_DEPLOY_COMPLETE:
+            // nothing left to do until the transit mode changes
+            return;
+
+        default:
+            deploymentModeTask = TASK_DEPLOY_DONE;
+            break;
     }
+    // the lander link task runs first, then the next step
+    scheduler_signal((Scheduler *)task->context, task);
 }
@@ -18,30 +18,30 @@
 // Global variable for current task
 TaskState preDeploymentModeTask = TASK_SETUP_ROVER_CONNECTION;
 
-void pre_deployment_mode(void){
+void pre_deployment_mode_enter(void){
     preDeploymentModeTask = TASK_SETUP_ROVER_CONNECTION;
-    // implement cooperative multi-tasking
-    while(transit_state == PRE_DEPLOYMENT){
-        switch(preDeploymentModeTask){
-            case TASK_SETUP_ROVER_CONNECTION:
-                // Set up a connection with the rover
-                /* TO BE IMPLEMENTED */
-                preDeploymentModeTask = TASK_RDS_CHECKUP;
-                break;
+}
+
+void pre_deployment_mode_step(Task *task){
+    // one step per run, the lander link task handles the received messages in between
+    switch(preDeploymentModeTask){
+        case TASK_SETUP_ROVER_CONNECTION:
+            // Set up a connection with the rover
+            /* TO BE IMPLEMENTED */
+            preDeploymentModeTask = TASK_RDS_CHECKUP;
+            break;
 
-            case TASK_RDS_CHECKUP:
-                // Perform the RDS electronics checkup
-                RDS_electronics_status_check();
+        case TASK_RDS_CHECKUP:
+            // Perform the next step of the RDS electronics checkup
+            if (RDS_electronics_status_step()) {
                 preDeploymentModeTask = TASK_CLEAR;
-                break;
-            case TASK_CLEAR:
-                preDeploymentModeTask = TASK_SETUP_ROVER_CONNECTION;
-                break;
-            default:
-                preDeploymentModeTask = TASK_SETUP_ROVER_CONNECTION;
-                break;
-        }
-        // Process received messages
-        process_received_data();
+            }
+            break;
+        case TASK_CLEAR:
+            preDeploymentModeTask = TASK_SETUP_ROVER_CONNECTION;
+            break;
+        default:
+            preDeploymentModeTask = TASK_SETUP_ROVER_CONNECTION;
+            break;
     }
 }
@@ -18,30 +18,30 @@
 // Global variable for current task
 TaskState transitModeTask = TASK_SETUP_ROVER_CONNECTION;
 
-void transit_mode(void){
+void transit_mode_enter(void){
     transitModeTask = TASK_SETUP_ROVER_CONNECTION;
-    // implement cooperative multi-tasking
-    while(transit_state == TRANSIT){
-        switch(transitModeTask){
-            case TASK_SETUP_ROVER_CONNECTION:
-                // Set up a connection with the rover
-                /* TO BE IMPLEMENTED */
-                transitModeTask = TASK_RDS_CHECKUP;
-                break;
+}
+
+void transit_mode_step(Task *task){
+    // one step per run, the lander link task handles the received messages in between
+    switch(transitModeTask){
+        case TASK_SETUP_ROVER_CONNECTION:
+            // Set up a connection with the rover
+            /* TO BE IMPLEMENTED */
+            transitModeTask = TASK_RDS_CHECKUP;
+            break;
 
-            case TASK_RDS_CHECKUP:
-                // Perform the RDS electronics checkup
-                RDS_electronics_status_check();
+        case TASK_RDS_CHECKUP:
+            // Perform the next step of the RDS electronics checkup
+            if (RDS_electronics_status_step()) {
                 transitModeTask = TASK_CLEAR;
-                break;
-            case TASK_CLEAR:
-                transitModeTask = TASK_SETUP_ROVER_CONNECTION;
-                break;
-            default:
-                transitModeTask = TASK_SETUP_ROVER_CONNECTION;
-                break;
-        }
-        // Process received messages
-        process_received_data();
+            }
+            break;
+        case TASK_CLEAR:
+            transitModeTask = TASK_SETUP_ROVER_CONNECTION;
+            break;
+        default:
+            transitModeTask = TASK_SETUP_ROVER_CONNECTION;
+            break;
     }
 }
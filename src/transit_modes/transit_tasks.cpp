@@ -0,0 +1,126 @@
+/*
+ * file "transit_tasks.cpp"
+ *
+ * task sets of the transit modes of RDSS, see transit_tasks.h
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ */
+
+#include <msp430.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "transit_modes_lib/transit_tasks.h"
+#include "transit_modes_lib/general_startup.h"
+#include "transit_modes_lib/launch_mode.h"
+#include "transit_modes_lib/transit_mode.h"
+#include "transit_modes_lib/pre_deployment_mode.h"
+#include "transit_modes_lib/deployment_mode.h"
+
+Scheduler transit_scheduler;
+
+// Handles the received messages, the ARQ and the link speed
+static void lander_link_task(Task *task){
+    process_received_data();
+}
+
+// Sends the analog channels that left or reentered their window
+static void adc_monitor_task(Task *task){
+    adc_monitor_report();
+}
+
+// Tasks in order of priority
+typedef enum {
+    TRANSIT_TASK_LANDER_LINK,
+    TRANSIT_TASK_ADC_MONITOR,
+    TRANSIT_TASK_GENERAL_STARTUP,
+    TRANSIT_TASK_LAUNCH_INTEGRATION,
+    TRANSIT_TASK_TRANSIT,
+    TRANSIT_TASK_PRE_DEPLOYMENT,
+    TRANSIT_TASK_DEPLOYMENT,
+    TRANSIT_TASK_COUNT
+} Transit_task;
+
+static Task transit_tasks[TRANSIT_TASK_COUNT] = {
+    {lander_link_task, TRANSIT_LINK_TASK_PERIOD_MS, TRANSIT_LINK_TASK_DEADLINE_MS, SCHEDULER_ALL_MODES, NULL},
+    {adc_monitor_task, 0, TRANSIT_MODE_TASK_DEADLINE_MS, SCHEDULER_ALL_MODES, NULL},
+    {general_startup_step, TRANSIT_MODE_TASK_PERIOD_MS, TRANSIT_MODE_TASK_DEADLINE_MS,
+     SCHEDULER_MODE(GENERAL_STARTUP), NULL},
+    {launch_mode_step, TRANSIT_MODE_TASK_PERIOD_MS, TRANSIT_MODE_TASK_DEADLINE_MS,
+     SCHEDULER_MODE(LAUNCH_INTEGRATION), NULL},
+    {transit_mode_step, TRANSIT_MODE_TASK_PERIOD_MS, TRANSIT_MODE_TASK_DEADLINE_MS, SCHEDULER_MODE(TRANSIT), NULL},
+    {pre_deployment_mode_step, TRANSIT_MODE_TASK_PERIOD_MS, TRANSIT_MODE_TASK_DEADLINE_MS,
+     SCHEDULER_MODE(PRE_DEPLOYMENT), NULL},
+    {deployment_mode_step, TRANSIT_DEPLOYMENT_TASK_PERIOD_MS, 0, SCHEDULER_MODE(DEPLOYMENT), &transit_scheduler},
+};
+
+// Reports an overrun to the lander
+static void transit_task_overrun(Scheduler *scheduler, Task *task){
+    send_event(EVENT_TASK_OVERRUN);
+}
+
+// Switches to the task set of a transit mode
+static void transit_tasks_enter(transit_states mode){
+    // a checkup sweep, supercap check or NEA firing sequence of the previous mode is abandoned
+    RDS_electronics_status_reset();
+    supercap_functionality_check_stop();
+    NEA_sequence_abort();
+
+    switch (mode){
+    case GENERAL_STARTUP:
+        send_event(EVENT_GENERAL_STARTUP);
+        general_startup_enter();
+        break;
+    case LAUNCH_INTEGRATION:
+        send_event(EVENT_LAUNCH_INTEGRATION);
+        launch_mode_enter();
+        break;
+    case TRANSIT:
+        send_event(EVENT_TRANSIT);
+        transit_mode_enter();
+        break;
+    case PRE_DEPLOYMENT:
+        send_event(EVENT_PRE_DEPLOYMENT);
+        pre_deployment_mode_enter();
+        break;
+    case DEPLOYMENT:
+        send_event(EVENT_DEPLOYMENT);
+        deployment_mode_enter();
+        break;
+    default:
+        break;
+    }
+
+    scheduler_set_mode(&transit_scheduler, (uint8_t)mode);
+}
+
+void transit_tasks_run(void){
+    scheduler_init(&transit_scheduler, transit_tasks, TRANSIT_TASK_COUNT, system_tick_now, transit_task_overrun);
+    if (transit_state > DEPLOYMENT){
+        transit_state = GENERAL_STARTUP;
+    }
+    transit_tasks_enter(transit_state);
+
+    while (1){
+        // the lander switched the transit mode, also while the previous mode was entered
+        if (transit_state != (transit_states)transit_scheduler.mode){
+            transit_tasks_enter(transit_state);
+        }
+
+        // a received frame or a receive error is handled before the next step of the mode
+        if (UART_state == RECEIVED || buffer_full_state || error_state || checksum_error_state || timeout_state){
+            scheduler_signal(&transit_scheduler, &transit_tasks[TRANSIT_TASK_LANDER_LINK]);
+        }
+
+        // an analog channel left or reentered its window
+        if (adc_monitor_pending()){
+            scheduler_signal(&transit_scheduler, &transit_tasks[TRANSIT_TASK_ADC_MONITOR]);
+        }
+
+        if (!scheduler_run_next(&transit_scheduler)){
+            // nothing to do until the next tick or frame
+            wait_for_received_data();
+        }
+    }
+}
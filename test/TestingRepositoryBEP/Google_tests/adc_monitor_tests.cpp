@@ -0,0 +1,238 @@
+/*
+ * adc_monitor_tests.cpp file
+ *
+ * Testing file for the continuous monitoring of the analog channels. The hardware is simulated: every ms the ADC
+ * converts the next slot of the repeated sequence, the window comparator checks the comparator channel, and at the end
+ * of every sequence the DMA copies every channel into its ring. The signals of the channels are functions of the time
+ * in ms. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Init test: No channels, too many channels and a comparator channel that does not exist are not valid.
+ * - Window test: The limits belong to the window.
+ * - Comparator test: An overcurrent wakes the CPU at its first sample, a lasting overcurrent does not interrupt again
+ *   and the return into the window wakes the CPU once.
+ * - Ring test: A single sample below the window is found when the ring is full, with its value, and a channel that
+ *   stays below does not wake the CPU again.
+ * - Changes test: The changes are taken once, a change in both channels is taken together.
+ * - Quiet test: Signals within their windows never wake the CPU, only the ring interrupts run. Reports the detection
+ *   latency and the interrupts compared with the readout of the former ECCS sweep.
+ */
+
+#include "gtest/gtest.h"
+#include <system_health_lib/adc_monitor.h>
+#include <cstdio>
+
+// Channels of the simulation, in the order of ADC_CHANNELS: the supercap voltage and the bus sense
+#define SIM_CHANNELS 2
+#define SIM_SUPERCAP 0
+#define SIM_BUS_SENSE 1
+
+typedef uint16_t (*Sim_signal)(uint32_t ms);
+
+static const Adc_window sim_windows[SIM_CHANNELS] = {{2000, 4095}, {0, 3000}};
+
+// Simulated hardware
+static Adc_monitor monitor;
+static Sim_signal signals[SIM_CHANNELS];
+static uint16_t memory[SIM_CHANNELS];
+static uint16_t rings[SIM_CHANNELS][ADC_MONITOR_RING_LENGTH];
+static uint8_t ring_index;
+static uint8_t slot;
+static uint8_t comparator_enables;
+
+// What the monitor did
+static int interrupts;
+static int wakeups;
+static uint32_t last_wakeup_ms;
+
+static uint16_t sim_supercap_charged(uint32_t ms) {
+    return 3000;
+}
+
+static uint16_t sim_bus_normal(uint32_t ms) {
+    return 1500 + (ms % 7);
+}
+
+static void sim_wakeup(uint32_t ms) {
+    wakeups++;
+    last_wakeup_ms = ms;
+}
+
+static void reset_simulation(Sim_signal supercap, Sim_signal bus_sense) {
+    ASSERT_TRUE(adc_monitor_init(&monitor, sim_windows, SIM_CHANNELS, SIM_BUS_SENSE));
+    signals[SIM_SUPERCAP] = supercap;
+    signals[SIM_BUS_SENSE] = bus_sense;
+    ring_index = 0;
+    slot = 0;
+    comparator_enables = adc_monitor_comparator_enables(&monitor);
+    interrupts = 0;
+    wakeups = 0;
+    last_wakeup_ms = 0;
+}
+
+// One system tick: TA0.1 triggers the conversion of the next slot
+static void sim_tick(uint32_t ms) {
+    memory[slot] = signals[slot](ms);
+
+    if (slot == SIM_BUS_SENSE) {
+        // the window comparator, only the enabled interrupts reach the CPU
+        Adc_window_state state = adc_window_check(&sim_windows[SIM_BUS_SENSE], memory[slot]);
+        uint8_t flag = state == ADC_WINDOW_ABOVE ? ADC_MONITOR_IE_ABOVE :
+                       state == ADC_WINDOW_BELOW ? ADC_MONITOR_IE_BELOW : ADC_MONITOR_IE_INSIDE;
+        if (comparator_enables & flag) {
+            interrupts++;
+            if (adc_monitor_comparator_event(&monitor, state, memory[slot])) {
+                sim_wakeup(ms);
+            }
+            comparator_enables = adc_monitor_comparator_enables(&monitor);
+        }
+    }
+
+    slot++;
+    if (slot == SIM_CHANNELS) {
+        // end of the sequence, the DMA copies every channel into its ring
+        slot = 0;
+        for (int channel = 0; channel < SIM_CHANNELS; channel++) {
+            rings[channel][ring_index] = memory[channel];
+        }
+        ring_index++;
+        if (ring_index == ADC_MONITOR_RING_LENGTH) {
+            ring_index = 0;
+            interrupts++;
+            if (adc_monitor_ring_full(&monitor, &rings[0][0])) {
+                sim_wakeup(ms);
+            }
+        }
+    }
+}
+
+static void run_simulation(uint32_t from_ms, uint32_t to_ms) {
+    for (uint32_t ms = from_ms; ms < to_ms; ms++) {
+        sim_tick(ms);
+    }
+}
+
+static uint16_t sim_overcurrent(uint32_t ms) {
+    return (ms >= 1001 && ms < 1501) ? 3500 : 1500;
+}
+
+static uint16_t sim_brownout_dip(uint32_t ms) {
+    return ms == 1000 ? 1800 : 3000;
+}
+
+static uint16_t sim_brownout_lasting(uint32_t ms) {
+    return ms < 1000 ? 3000 : 1000;
+}
+
+TEST(adcMonitorTestSuite, initTest) {
+    Adc_monitor invalid;
+    EXPECT_FALSE(adc_monitor_init(&invalid, sim_windows, 0, 0));
+    EXPECT_FALSE(adc_monitor_init(&invalid, sim_windows, ADC_MONITOR_MAX_CHANNELS + 1, 0));
+    EXPECT_FALSE(adc_monitor_init(&invalid, sim_windows, SIM_CHANNELS, SIM_CHANNELS));
+    ASSERT_TRUE(adc_monitor_init(&invalid, sim_windows, SIM_CHANNELS, SIM_BUS_SENSE));
+    EXPECT_EQ(ADC_WINDOW_INSIDE, invalid.state[SIM_SUPERCAP]);
+    EXPECT_EQ(ADC_WINDOW_INSIDE, invalid.state[SIM_BUS_SENSE]);
+    EXPECT_EQ(0, invalid.changed);
+    EXPECT_EQ(ADC_MONITOR_IE_ABOVE | ADC_MONITOR_IE_BELOW, adc_monitor_comparator_enables(&invalid));
+}
+
+TEST(adcMonitorTestSuite, windowTest) {
+    Adc_window window = {100, 200};
+    EXPECT_EQ(ADC_WINDOW_BELOW, adc_window_check(&window, 99));
+    EXPECT_EQ(ADC_WINDOW_INSIDE, adc_window_check(&window, 100));
+    EXPECT_EQ(ADC_WINDOW_INSIDE, adc_window_check(&window, 200));
+    EXPECT_EQ(ADC_WINDOW_ABOVE, adc_window_check(&window, 201));
+}
+
+TEST(adcMonitorTestSuite, comparatorTest) {
+    reset_simulation(sim_supercap_charged, sim_overcurrent);
+
+    // the bus sense is converted on the odd ms, the overcurrent starts at 1001 ms
+    run_simulation(0, 1001);
+    EXPECT_EQ(0, wakeups);
+    run_simulation(1001, 1002);
+    EXPECT_EQ(1, wakeups);
+    EXPECT_EQ(1001u, last_wakeup_ms);
+    EXPECT_EQ(ADC_WINDOW_ABOVE, monitor.state[SIM_BUS_SENSE]);
+    EXPECT_EQ(3500, monitor.value[SIM_BUS_SENSE]);
+    EXPECT_EQ(ADC_MONITOR_IE_INSIDE | ADC_MONITOR_IE_BELOW, comparator_enables);
+
+    // 250 samples of overcurrent, no more interrupts of the comparator
+    int interrupts_before = interrupts;
+    uint16_t rings_before = monitor.rings;
+    run_simulation(1002, 1501);
+    EXPECT_EQ(1, wakeups);
+    EXPECT_EQ(interrupts_before + (monitor.rings - rings_before), interrupts);
+
+    run_simulation(1501, 1502);
+    EXPECT_EQ(2, wakeups);
+    EXPECT_EQ(1501u, last_wakeup_ms);
+    EXPECT_EQ(ADC_WINDOW_INSIDE, monitor.state[SIM_BUS_SENSE]);
+    EXPECT_EQ(ADC_MONITOR_IE_ABOVE | ADC_MONITOR_IE_BELOW, comparator_enables);
+
+    run_simulation(1502, 3000);
+    EXPECT_EQ(2, wakeups);
+    EXPECT_EQ(ADC_WINDOW_INSIDE, monitor.state[SIM_SUPERCAP]);
+}
+
+TEST(adcMonitorTestSuite, ringTest) {
+    reset_simulation(sim_brownout_dip, sim_bus_normal);
+
+    // the supercap is converted on the even ms, a ring of 32 samples is full every 64 ms
+    run_simulation(0, 1000);
+    EXPECT_EQ(0, wakeups);
+    run_simulation(1000, 1024);
+    EXPECT_EQ(1, wakeups);
+    EXPECT_EQ(1023u, last_wakeup_ms);
+    EXPECT_EQ(ADC_WINDOW_BELOW, monitor.state[SIM_SUPERCAP]);
+    EXPECT_EQ(1800, monitor.value[SIM_SUPERCAP]);
+
+    // the next ring is inside again
+    run_simulation(1024, 1100);
+    EXPECT_EQ(2, wakeups);
+    EXPECT_EQ(1087u, last_wakeup_ms);
+    EXPECT_EQ(ADC_WINDOW_INSIDE, monitor.state[SIM_SUPERCAP]);
+
+    // a lasting brown-out wakes the CPU once
+    reset_simulation(sim_brownout_lasting, sim_bus_normal);
+    run_simulation(0, 5000);
+    EXPECT_EQ(1, wakeups);
+    EXPECT_LT(last_wakeup_ms - 1000, 2u * 2 * ADC_MONITOR_RING_LENGTH);
+    EXPECT_EQ(1000, monitor.value[SIM_SUPERCAP]);
+    EXPECT_EQ(ADC_WINDOW_INSIDE, monitor.state[SIM_BUS_SENSE]);
+}
+
+TEST(adcMonitorTestSuite, changesTest) {
+    reset_simulation(sim_brownout_lasting, sim_overcurrent);
+    run_simulation(0, 1100);
+    EXPECT_EQ(2, wakeups);
+    EXPECT_EQ((1 << SIM_SUPERCAP) | (1 << SIM_BUS_SENSE), adc_monitor_take_changes(&monitor));
+    EXPECT_EQ(0, adc_monitor_take_changes(&monitor));
+
+    run_simulation(1100, 1600);
+    EXPECT_EQ(1 << SIM_BUS_SENSE, adc_monitor_take_changes(&monitor));
+    EXPECT_EQ(ADC_WINDOW_INSIDE, monitor.state[SIM_BUS_SENSE]);
+    EXPECT_EQ(ADC_WINDOW_BELOW, monitor.state[SIM_SUPERCAP]);
+    EXPECT_EQ(0, adc_monitor_take_changes(&monitor));
+}
+
+TEST(adcMonitorTestSuite, quietTest) {
+    const uint32_t duration_ms = 60000;
+    reset_simulation(sim_supercap_charged, sim_bus_normal);
+    run_simulation(0, duration_ms);
+    EXPECT_EQ(0, wakeups);
+    EXPECT_EQ(0, monitor.wakeups);
+    EXPECT_EQ(monitor.rings, interrupts);
+    EXPECT_EQ(duration_ms / (SIM_CHANNELS * ADC_MONITOR_RING_LENGTH), monitor.rings);
+
+    // the former readout only sampled the channels once per ECCS sweep, a sweep of 7 steps of the 20 ms mode task
+    const uint32_t sweep_ms = 7 * 20;
+    printf("[   INFO   ] sample period: former %lu ms (once per ECCS sweep, only in the modes that run it), "
+           "monitor %d ms\n", (unsigned long)sweep_ms, SIM_CHANNELS);
+    printf("[   INFO   ] detection latency: comparator channel %d ms, ring channels %d ms\n", SIM_CHANNELS,
+           SIM_CHANNELS * ADC_MONITOR_RING_LENGTH);
+    printf("[   INFO   ] %lu s without limit violations: %d interrupts (full rings), %d CPU wake-ups\n",
+           (unsigned long)(duration_ms / 1000), interrupts, wakeups);
+}
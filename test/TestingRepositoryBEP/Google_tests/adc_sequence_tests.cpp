@@ -0,0 +1,166 @@
+/*
+ * adc_sequence_tests.cpp file
+ *
+ * Testing file for the layout of the ADC12 conversion sequence. The ADC is simulated: every slot converts the voltage
+ * of the analog input of the slot, with a small noise on every sample. Below is a list of all tested functionalities
+ * and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Valid test: Oversamplings that are no power of 2 or too large, unknown inputs, too many slots and an empty table
+ *   are not valid.
+ * - Layout test: Every channel takes as many consecutive slots as its oversampling, in the order of the table.
+ * - Average test: The samples of a channel are averaged and rounded to the nearest count, 16 full scale samples do not
+ *   overflow.
+ * - Sequence test: A simulated sequence returns the voltage of every channel, also with the channels of the RDS that
+ *   the former single channel readout mixed up.
+ * - Cycles test: The conversion time of a sequence is the sample and conversion time of every slot.
+ * - Cost test: Reports the conversion time and the CPU work of a snapshot of the RDS channels compared with the former
+ *   readout of one channel at a time.
+ */
+
+#include "gtest/gtest.h"
+#include <system_health_lib/adc_sequence.h>
+#include <cstdio>
+
+// Channels of the RDS, see ADC_CHANNELS in adc_manager.h: the supercap voltage on A7 and the bus sense on A11
+static const Adc_channel_config rds_channels[2] = {{7, 4}, {11, 4}};
+
+// Simulated ADC, the 12-bit value of every analog input and a noise pattern of the samples
+static uint16_t input_value[ADC_SEQUENCE_MAX_INPUT + 1];
+static const int16_t sample_noise[4] = {2, -1, 1, -2};
+
+static void simulate_sequence(const uint8_t *slot_inputs, uint8_t slots, uint16_t *memory) {
+    for (uint8_t slot = 0; slot < slots; slot++) {
+        memory[slot] = (uint16_t)(input_value[slot_inputs[slot]] + sample_noise[slot % 4]);
+    }
+}
+
+TEST(adcSequenceTestSuite, validTest) {
+    EXPECT_TRUE(adc_sequence_valid(rds_channels, 2));
+
+    Adc_channel_config channels[3] = {{7, 1}, {11, 16}, {0, 8}};
+    EXPECT_TRUE(adc_sequence_valid(channels, 3));
+    EXPECT_FALSE(adc_sequence_valid(channels, 0));
+
+    channels[0].oversampling = 3;
+    EXPECT_FALSE(adc_sequence_valid(channels, 3));
+    channels[0].oversampling = 0;
+    EXPECT_FALSE(adc_sequence_valid(channels, 3));
+    channels[0].oversampling = 32;
+    EXPECT_FALSE(adc_sequence_valid(channels, 3));
+
+    channels[0].oversampling = 1;
+    channels[2].input = ADC_SEQUENCE_MAX_INPUT + 1;
+    EXPECT_FALSE(adc_sequence_valid(channels, 3));
+
+    // 16 + 16 + 8 samples do not fit in 32 slots
+    channels[2].input = 0;
+    channels[0].oversampling = 16;
+    EXPECT_FALSE(adc_sequence_valid(channels, 3));
+    channels[2].oversampling = 0;
+    EXPECT_FALSE(adc_sequence_valid(channels, 3));
+    EXPECT_TRUE(adc_sequence_valid(channels, 2));
+}
+
+TEST(adcSequenceTestSuite, layoutTest) {
+    uint8_t slot_inputs[ADC_SEQUENCE_MAX_SLOTS];
+    ASSERT_EQ(8, adc_sequence_layout(rds_channels, 2, slot_inputs));
+    for (int slot = 0; slot < 4; slot++) {
+        EXPECT_EQ(7, slot_inputs[slot]);
+        EXPECT_EQ(11, slot_inputs[slot + 4]);
+    }
+
+    Adc_channel_config channels[3] = {{3, 1}, {5, 2}, {9, 1}};
+    ASSERT_EQ(4, adc_sequence_layout(channels, 3, slot_inputs));
+    EXPECT_EQ(3, slot_inputs[0]);
+    EXPECT_EQ(5, slot_inputs[1]);
+    EXPECT_EQ(5, slot_inputs[2]);
+    EXPECT_EQ(9, slot_inputs[3]);
+}
+
+TEST(adcSequenceTestSuite, averageTest) {
+    Adc_channel_config channels[3] = {{0, 4}, {1, 4}, {2, 1}};
+    uint16_t memory[9] = {1, 2, 2, 2, 1, 1, 2, 2, 4095};
+    uint16_t results[3];
+    adc_sequence_average(channels, 3, memory, results);
+    EXPECT_EQ(2, results[0]);       // 1.75
+    EXPECT_EQ(2, results[1]);       // 1.5 rounds up
+    EXPECT_EQ(4095, results[2]);    // a single sample is not changed
+
+    Adc_channel_config full_scale = {0, ADC_SEQUENCE_MAX_OVERSAMPLING};
+    uint16_t full_memory[ADC_SEQUENCE_MAX_OVERSAMPLING];
+    for (int slot = 0; slot < ADC_SEQUENCE_MAX_OVERSAMPLING; slot++) {
+        full_memory[slot] = 4095;
+    }
+    adc_sequence_average(&full_scale, 1, full_memory, results);
+    EXPECT_EQ(4095, results[0]);
+}
+
+TEST(adcSequenceTestSuite, sequenceTest) {
+    uint8_t slot_inputs[ADC_SEQUENCE_MAX_SLOTS];
+    uint16_t memory[ADC_SEQUENCE_MAX_SLOTS];
+    uint16_t results[2];
+    input_value[7] = 2800;
+    input_value[11] = 1200;
+    // the former readouts or-ed their input into ADC12MCTL0, after both had run once they converted A15 (7 | 11)
+    input_value[7 | 11] = 0;
+
+    uint8_t slots = adc_sequence_layout(rds_channels, 2, slot_inputs);
+    simulate_sequence(slot_inputs, slots, memory);
+    adc_sequence_average(rds_channels, 2, memory, results);
+    EXPECT_EQ(2800, results[0]);
+    EXPECT_EQ(1200, results[1]);
+
+    // a new snapshot returns the new values of both channels
+    input_value[7] = 100;
+    input_value[11] = 4000;
+    simulate_sequence(slot_inputs, slots, memory);
+    adc_sequence_average(rds_channels, 2, memory, results);
+    EXPECT_EQ(100, results[0]);
+    EXPECT_EQ(4000, results[1]);
+}
+
+TEST(adcSequenceTestSuite, cyclesTest) {
+    EXPECT_EQ(30u, adc_sequence_cycles(16, 1));
+    EXPECT_EQ(240u, adc_sequence_cycles(16, 8));
+    EXPECT_EQ(0u, adc_sequence_cycles(16, 0));
+}
+
+TEST(adcSequenceTestSuite, costTest) {
+    // The former readout of one channel, counted from the code: 4 register writes to select the channel, 4 to enable
+    // and 4 to disable the interrupt, the trigger, 1 interrupt and 1 wake-up of the CPU, for one sample.
+    const int former_writes_per_channel = 13;
+    const int former_interrupts_per_channel = 1;
+    // A snapshot: the trigger, 1 interrupt and 1 wake-up for all channels, the configuration is written once at boot.
+    const int snapshot_writes = 1;
+    const int snapshot_interrupts = 1;
+    const uint16_t sample_cycles = 16;
+
+    uint8_t slot_inputs[ADC_SEQUENCE_MAX_SLOTS];
+    uint8_t slots = adc_sequence_layout(rds_channels, 2, slot_inputs);
+
+    // the ECCS sweep reads both channels, the former readout with one sample per channel
+    uint32_t former_cycles = 2 * adc_sequence_cycles(sample_cycles, 1);
+    int former_writes = 2 * former_writes_per_channel;
+    int former_interrupts = 2 * former_interrupts_per_channel;
+    uint32_t snapshot_cycles = adc_sequence_cycles(sample_cycles, slots);
+    // the same snapshot without oversampling
+    uint32_t single_cycles = adc_sequence_cycles(sample_cycles, 2);
+    // the former readout with the same oversampling needs a readout per sample
+    int former_oversampled_interrupts = slots * former_interrupts_per_channel;
+    int former_oversampled_writes = slots * former_writes_per_channel;
+
+    printf("[   INFO   ] both RDS channels, former: %lu ADC cycles, %d register writes, %d interrupts\n",
+           (unsigned long)former_cycles, former_writes, former_interrupts);
+    printf("[   INFO   ] both RDS channels, snapshot: %lu ADC cycles (%lu without oversampling), %d register write, "
+           "%d interrupt\n", (unsigned long)snapshot_cycles, (unsigned long)single_cycles, snapshot_writes,
+           snapshot_interrupts);
+    printf("[   INFO   ] %d samples, former: %d register writes, %d interrupts, snapshot: %d, %d\n", slots,
+           former_oversampled_writes, former_oversampled_interrupts, snapshot_writes, snapshot_interrupts);
+
+    EXPECT_EQ(former_cycles, single_cycles);
+    EXPECT_LT(snapshot_interrupts, former_interrupts);
+    EXPECT_LT(snapshot_writes, former_writes);
+}
@@ -0,0 +1,522 @@
+/*
+ * arq_tests.cpp file
+ *
+ * Testing file for the sliding-window ARQ of the lander link. Multiple tests are executed here to demonstrate that the ARQ behaves as expected. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - In order test: Frames are delivered in order as normal Messages that handle_message accepts.
+ * - Piggybacked ACK test: An outgoing frame acknowledges the received frames, no separate ACK is needed.
+ * - Delayed ACK test: A separate ACK is only sent when no outgoing frame carried it within the ACK delay.
+ * - Duplicate test: A frame that is received twice is delivered once.
+ * - Reorder test: Frames that arrive after a lost frame are buffered and delivered once the lost frame is in.
+ * - Selective retransmission test: Only the lost frame is sent again, not the frames after it.
+ * - Window full test: No more frames than the window are outstanding, too large payloads are refused.
+ * - Give up test: A frame is given up after max_transmissions and the receiver skips it.
+ * - Restart test: The receiver starts again when the sender restarted its sequence numbers.
+ * - Early restart test: A sender that restarts after 1, 4 or 8 frames of a session gets its first frames delivered,
+ *   although their sequence numbers fall inside the window of the old session, and accepts the ACK of the receiver.
+ * - Session retransmission test: A frame of the same session that was already delivered is still a duplicate.
+ * - Loopback goodput test: Two links over a simulated 115200 baud line deliver every frame once and in order at
+ *   several loss rates and report the goodput compared with stop-and-wait.
+ */
+
+#include "gtest/gtest.h"
+#include "lander_communication.h"
+#include <lander_communication_lib/arq.h>
+#include <cstdio>
+#include <cstring>
+
+#define CAPTURE_SIZE 32
+
+// Frames sent by a link, kept as the Messages the other side would receive
+typedef struct {
+    Message frames[CAPTURE_SIZE];
+    uint8_t count;
+    Message delivered[CAPTURE_SIZE];
+    uint8_t delivered_count;
+} Capture;
+
+static bool capture_send(ARQ_link *link, uint8_t msg_type, const Payload_segment *segments, uint8_t segment_count) {
+    Capture *capture = (Capture *)link->context;
+    Message *msg = &capture->frames[capture->count++ % CAPTURE_SIZE];
+    msg->start_byte = MSG_START_BYTE;
+    msg->msg_type = msg_type;
+    msg->length = 0;
+    for (uint8_t i = 0; i < segment_count; i++) {
+        memcpy(&msg->payload[msg->length], segments[i].data, segments[i].length);
+        msg->length += segments[i].length;
+    }
+    msg->checksum = calculate_checksum_helper(msg->msg_type, msg->length, msg->payload);
+    msg->end_byte = MSG_END_BYTE;
+    return true;
+}
+
+static void capture_deliver(ARQ_link *link, const Message *msg) {
+    Capture *capture = (Capture *)link->context;
+    capture->delivered[capture->delivered_count++ % CAPTURE_SIZE] = *msg;
+}
+
+static void init_link(ARQ_link *link, Capture *capture, uint8_t window, uint8_t max_transmissions) {
+    ARQ_config config;
+    config.window = window;
+    config.timeout = 15;
+    config.max_transmissions = max_transmissions;
+    config.ack_delay = 2;
+    config.session = 0;
+    memset(capture, 0, sizeof(*capture));
+    arq_init(link, &config, capture_send, capture_deliver, capture);
+}
+
+// arq_receive changes the message, so the captured frame is copied first
+static void receive_copy(ARQ_link *link, const Message *frame, uint16_t now) {
+    Message msg = *frame;
+    ASSERT_TRUE(arq_is_frame(&msg));
+    arq_receive(link, &msg, now);
+}
+
+static const uint8_t PAYLOAD_A[] = "first";
+static const uint8_t PAYLOAD_B[] = "second";
+static const uint8_t PAYLOAD_C[] = "third";
+static const uint8_t PAYLOAD_D[] = "fourth";
+
+TEST(arqTestSuite, inOrderTest) {
+    ARQ_link sender, receiver;
+    Capture sent, received;
+    init_link(&sender, &sent, 4, 0);
+    init_link(&receiver, &received, 4, 0);
+
+    EXPECT_TRUE(arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_A, sizeof(PAYLOAD_A) - 1, 0));
+    EXPECT_TRUE(arq_send(&sender, MSG_TYPE_RESPONSE, PAYLOAD_B, sizeof(PAYLOAD_B) - 1, 0));
+    EXPECT_EQ(2, sent.count);
+    EXPECT_EQ(MSG_TYPE_DATA | MSG_TYPE_RELIABLE, sent.frames[0].msg_type);
+    EXPECT_EQ(ARQ_HEADER_SIZE + sizeof(PAYLOAD_A) - 1, sent.frames[0].length);
+
+    receive_copy(&receiver, &sent.frames[0], 1);
+    receive_copy(&receiver, &sent.frames[1], 1);
+
+    ASSERT_EQ(2, received.delivered_count);
+    const Message *first = &received.delivered[0];
+    EXPECT_EQ(MSG_START_BYTE, first->start_byte);
+    EXPECT_EQ(MSG_TYPE_DATA, first->msg_type);
+    EXPECT_EQ(sizeof(PAYLOAD_A) - 1, first->length);
+    EXPECT_EQ(0, memcmp(PAYLOAD_A, first->payload, first->length));
+    EXPECT_EQ(calculate_checksum_helper(first->msg_type, first->length, first->payload), first->checksum);
+    EXPECT_EQ(MSG_END_BYTE, first->end_byte);
+    EXPECT_EQ(MSG_TYPE_RESPONSE, received.delivered[1].msg_type);
+    EXPECT_EQ(0, memcmp(PAYLOAD_B, received.delivered[1].payload, sizeof(PAYLOAD_B) - 1));
+    EXPECT_EQ(2, receiver.expected);
+}
+
+TEST(arqTestSuite, piggybackedAckTest) {
+    ARQ_link rds, lander;
+    Capture rds_capture, lander_capture;
+    init_link(&rds, &rds_capture, 4, 0);
+    init_link(&lander, &lander_capture, 4, 0);
+
+    arq_send(&rds, MSG_TYPE_DATA, PAYLOAD_A, sizeof(PAYLOAD_A) - 1, 0);
+    arq_send(&rds, MSG_TYPE_DATA, PAYLOAD_B, sizeof(PAYLOAD_B) - 1, 0);
+    receive_copy(&lander, &rds_capture.frames[0], 1);
+    receive_copy(&lander, &rds_capture.frames[1], 1);
+
+    // the lander answers before the ACK delay, the answer carries the ACK
+    arq_send(&lander, MSG_TYPE_TRANSIT_MODE, PAYLOAD_C, sizeof(PAYLOAD_C) - 1, 1);
+    arq_poll(&lander, 10);
+    EXPECT_EQ(1, lander_capture.count);
+    EXPECT_EQ(0, lander.statistics.acks_sent);
+
+    receive_copy(&rds, &lander_capture.frames[0], 2);
+    EXPECT_EQ(0, arq_outstanding(&rds));
+    EXPECT_EQ(2, rds.statistics.acknowledged);
+    EXPECT_EQ(1, rds_capture.delivered_count);
+}
+
+TEST(arqTestSuite, delayedAckTest) {
+    ARQ_link sender, receiver;
+    Capture sent, received;
+    init_link(&sender, &sent, 4, 0);
+    init_link(&receiver, &received, 4, 0);
+
+    arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_A, sizeof(PAYLOAD_A) - 1, 0);
+    receive_copy(&receiver, &sent.frames[0], 100);
+
+    arq_poll(&receiver, 101);
+    EXPECT_EQ(0, received.count);
+    arq_poll(&receiver, 102);
+    ASSERT_EQ(1, received.count);
+    const Message *ack = &received.frames[0];
+    EXPECT_EQ(MSG_TYPE_ARQ_ACK, ack->msg_type);
+    EXPECT_EQ(ARQ_ACK_SIZE, ack->length);
+    EXPECT_EQ(1, ack->payload[0]);
+    EXPECT_EQ(0, ack->payload[1]);
+
+    // the ACK is sent once
+    arq_poll(&receiver, 200);
+    EXPECT_EQ(1, received.count);
+
+    receive_copy(&sender, ack, 103);
+    EXPECT_EQ(0, arq_outstanding(&sender));
+}
+
+TEST(arqTestSuite, duplicateTest) {
+    ARQ_link sender, receiver;
+    Capture sent, received;
+    init_link(&sender, &sent, 4, 0);
+    init_link(&receiver, &received, 4, 0);
+
+    arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_A, sizeof(PAYLOAD_A) - 1, 0);
+    // the ACK got lost, the sender repeats the frame
+    arq_poll(&sender, 15);
+    ASSERT_EQ(2, sent.count);
+
+    receive_copy(&receiver, &sent.frames[0], 1);
+    receive_copy(&receiver, &sent.frames[1], 16);
+
+    EXPECT_EQ(1, received.delivered_count);
+    EXPECT_EQ(1, receiver.statistics.duplicates);
+    EXPECT_EQ(1, sender.statistics.retransmissions);
+}
+
+TEST(arqTestSuite, reorderTest) {
+    ARQ_link sender, receiver;
+    Capture sent, received;
+    init_link(&sender, &sent, 4, 0);
+    init_link(&receiver, &received, 4, 0);
+
+    arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_A, sizeof(PAYLOAD_A) - 1, 0);
+    arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_B, sizeof(PAYLOAD_B) - 1, 0);
+    arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_C, sizeof(PAYLOAD_C) - 1, 0);
+
+    // the first frame is lost
+    receive_copy(&receiver, &sent.frames[1], 1);
+    receive_copy(&receiver, &sent.frames[2], 1);
+    EXPECT_EQ(0, received.delivered_count);
+    EXPECT_EQ(2, receiver.statistics.out_of_order);
+
+    arq_poll(&receiver, 3);
+    ASSERT_EQ(1, received.count);
+    EXPECT_EQ(0, received.frames[0].payload[0]);
+    EXPECT_EQ(0x03, received.frames[0].payload[1]);
+
+    receive_copy(&receiver, &sent.frames[0], 16);
+    ASSERT_EQ(3, received.delivered_count);
+    EXPECT_EQ(0, memcmp(PAYLOAD_A, received.delivered[0].payload, sizeof(PAYLOAD_A) - 1));
+    EXPECT_EQ(0, memcmp(PAYLOAD_B, received.delivered[1].payload, sizeof(PAYLOAD_B) - 1));
+    EXPECT_EQ(0, memcmp(PAYLOAD_C, received.delivered[2].payload, sizeof(PAYLOAD_C) - 1));
+    EXPECT_EQ(3, receiver.expected);
+    EXPECT_EQ(0, receiver.rx_mask);
+}
+
+TEST(arqTestSuite, selectiveRetransmissionTest) {
+    ARQ_link sender, receiver;
+    Capture sent, received;
+    init_link(&sender, &sent, 4, 0);
+    init_link(&receiver, &received, 4, 0);
+
+    arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_A, sizeof(PAYLOAD_A) - 1, 0);
+    arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_B, sizeof(PAYLOAD_B) - 1, 0);
+    arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_C, sizeof(PAYLOAD_C) - 1, 0);
+    arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_D, sizeof(PAYLOAD_D) - 1, 0);
+
+    // the second frame is lost
+    receive_copy(&receiver, &sent.frames[0], 1);
+    receive_copy(&receiver, &sent.frames[2], 1);
+    receive_copy(&receiver, &sent.frames[3], 1);
+    arq_poll(&receiver, 3);
+    ASSERT_EQ(1, received.count);
+    receive_copy(&sender, &received.frames[0], 4);
+    EXPECT_EQ(3, arq_outstanding(&sender));
+
+    arq_poll(&sender, 15);
+    ASSERT_EQ(5, sent.count);
+    EXPECT_EQ(1, sent.frames[4].payload[0]);
+    EXPECT_EQ(1, sender.statistics.retransmissions);
+
+    receive_copy(&receiver, &sent.frames[4], 16);
+    EXPECT_EQ(4, received.delivered_count);
+    EXPECT_EQ(0, memcmp(PAYLOAD_B, received.delivered[1].payload, sizeof(PAYLOAD_B) - 1));
+}
+
+TEST(arqTestSuite, windowFullTest) {
+    ARQ_link sender;
+    Capture sent;
+    init_link(&sender, &sent, 2, 0);
+    static uint8_t large[MAX_PAYLOAD_SIZE];
+
+    EXPECT_FALSE(arq_send(&sender, MSG_TYPE_DATA, large, ARQ_MAX_PAYLOAD_SIZE + 1, 0));
+    EXPECT_TRUE(arq_send(&sender, MSG_TYPE_DATA, large, ARQ_MAX_PAYLOAD_SIZE, 0));
+    EXPECT_TRUE(arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_A, sizeof(PAYLOAD_A) - 1, 0));
+    EXPECT_FALSE(arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_B, sizeof(PAYLOAD_B) - 1, 0));
+    EXPECT_EQ(2, arq_outstanding(&sender));
+    EXPECT_EQ(2, sent.count);
+}
+
+TEST(arqTestSuite, giveUpTest) {
+    ARQ_link sender, receiver;
+    Capture sent, received;
+    init_link(&sender, &sent, 4, 2);
+    init_link(&receiver, &received, 4, 0);
+
+    arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_A, sizeof(PAYLOAD_A) - 1, 0);
+    arq_poll(&sender, 15);
+    arq_poll(&sender, 30);
+    EXPECT_EQ(2, sent.count);
+    EXPECT_EQ(1, sender.statistics.failed);
+    EXPECT_TRUE(arq_is_done(&sender, 0));
+    EXPECT_EQ(0, arq_outstanding(&sender));
+
+    // both transmissions were lost, the next frame makes the receiver skip the given up one
+    arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_B, sizeof(PAYLOAD_B) - 1, 31);
+    receive_copy(&receiver, &sent.frames[2], 32);
+    ASSERT_EQ(1, received.delivered_count);
+    EXPECT_EQ(0, memcmp(PAYLOAD_B, received.delivered[0].payload, sizeof(PAYLOAD_B) - 1));
+    EXPECT_EQ(1, receiver.statistics.skipped);
+}
+
+TEST(arqTestSuite, restartTest) {
+    ARQ_link sender, receiver;
+    Capture sent, received;
+    init_link(&sender, &sent, 4, 0);
+    init_link(&receiver, &received, 4, 0);
+    receiver.expected = 100;
+
+    arq_send(&sender, MSG_TYPE_INIT, PAYLOAD_A, sizeof(PAYLOAD_A) - 1, 0);
+    receive_copy(&receiver, &sent.frames[0], 1);
+
+    EXPECT_EQ(1, receiver.statistics.resynchronisations);
+    ASSERT_EQ(1, received.delivered_count);
+    EXPECT_EQ(MSG_TYPE_INIT, received.delivered[0].msg_type);
+    EXPECT_EQ(1, receiver.expected);
+}
+
+TEST(arqTestSuite, earlyRestartTest) {
+    const uint8_t frames_before_restart[] = {1, 4, 8};
+    for (uint8_t c = 0; c < sizeof(frames_before_restart); c++) {
+        uint8_t frames = frames_before_restart[c];
+        ARQ_link sender, receiver;
+        Capture sent, received;
+        init_link(&sender, &sent, 4, 0);
+        init_link(&receiver, &received, 4, 0);
+
+        // a session in which every frame is acknowledged right away
+        uint16_t now = 0;
+        for (uint8_t i = 0; i < frames; i++) {
+            ASSERT_TRUE(arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_A, sizeof(PAYLOAD_A) - 1, now));
+            receive_copy(&receiver, &sent.frames[sent.count - 1], now);
+            now += 2;
+            arq_poll(&receiver, now);
+            receive_copy(&sender, &received.frames[received.count - 1], now);
+        }
+        ASSERT_EQ(frames, receiver.expected);
+        ASSERT_EQ(0, arq_outstanding(&sender));
+
+        // the sender restarts in a new session and starts with the initialisation at sequence number 0
+        ARQ_config config = sender.config;
+        config.session++;
+        arq_init(&sender, &config, capture_send, capture_deliver, &sent);
+        ASSERT_TRUE(arq_send(&sender, MSG_TYPE_INIT, PAYLOAD_B, sizeof(PAYLOAD_B) - 1, now));
+        ASSERT_TRUE(arq_send(&sender, MSG_TYPE_DATA, PAYLOAD_C, sizeof(PAYLOAD_C) - 1, now));
+        receive_copy(&receiver, &sent.frames[sent.count - 2], now);
+        receive_copy(&receiver, &sent.frames[sent.count - 1], now);
+
+        EXPECT_EQ(1, receiver.statistics.resynchronisations) << (int)frames << " frames";
+        EXPECT_EQ(0, receiver.statistics.duplicates) << (int)frames << " frames";
+        ASSERT_EQ(frames + 2, received.delivered_count) << (int)frames << " frames";
+        EXPECT_EQ(MSG_TYPE_INIT, received.delivered[frames].msg_type);
+        EXPECT_EQ(0, memcmp(PAYLOAD_B, received.delivered[frames].payload, sizeof(PAYLOAD_B) - 1));
+        EXPECT_EQ(MSG_TYPE_DATA, received.delivered[frames + 1].msg_type);
+        EXPECT_EQ(2, receiver.expected);
+
+        // the ACK of the receiver lies in the window of the new session
+        now += 2;
+        arq_poll(&receiver, now);
+        receive_copy(&sender, &received.frames[received.count - 1], now);
+        EXPECT_EQ(0, arq_outstanding(&sender)) << (int)frames << " frames";
+        EXPECT_EQ(2, sender.statistics.acknowledged);
+    }
+}
+
+TEST(arqTestSuite, sessionRetransmissionTest) {
+    ARQ_link sender, receiver;
+    Capture sent, received;
+    init_link(&sender, &sent, 4, 0);
+    init_link(&receiver, &received, 4, 0);
+    sender.config.session = 1;
+
+    arq_send(&sender, MSG_TYPE_INIT, PAYLOAD_A, sizeof(PAYLOAD_A) - 1, 0);
+    receive_copy(&receiver, &sent.frames[0], 1);
+    // the ACK got lost, the sender repeats the frame in the same session
+    arq_poll(&sender, 20);
+    ASSERT_EQ(2, sent.count);
+    receive_copy(&receiver, &sent.frames[1], 21);
+
+    EXPECT_EQ(1, received.delivered_count);
+    EXPECT_EQ(1, receiver.statistics.duplicates);
+    EXPECT_EQ(0, receiver.statistics.resynchronisations);
+    EXPECT_EQ(1, receiver.expected);
+}
+
+// Loopback simulation: one RDS and one lander link over a 115200 baud line, one tick is 100 us
+#define SIM_TICK_US 100
+#define SIM_FRAMES 200
+#define SIM_PAYLOAD_SIZE 16
+#define SIM_QUEUE_SIZE 64
+
+typedef struct {
+    Message msg;
+    uint32_t arrival_us;
+} Sim_frame;
+
+// One direction of the line
+typedef struct {
+    Sim_frame frames[SIM_QUEUE_SIZE];
+    uint8_t head;
+    uint8_t tail;
+    uint32_t busy_until_us;
+    uint32_t loss_per_mille;
+    uint32_t random;
+    uint32_t *now_us;
+    ARQ_link *peer;
+    uint16_t next_index;        // index the lander expects next in the payload
+    bool in_order;
+} Sim_line;
+
+static bool sim_lost(Sim_line *line) {
+    line->random = line->random * 1103515245u + 12345u;
+    return ((line->random >> 16) % 1000) < line->loss_per_mille;
+}
+
+static bool sim_send(ARQ_link *link, uint8_t msg_type, const Payload_segment *segments, uint8_t segment_count) {
+    Sim_line *line = (Sim_line *)link->context;
+    SLIP_frame_info info;
+    if (!slip_frame_prepare(msg_type, segments, segment_count, FRAME_CHECK_XOR8, &info)) {
+        return false;
+    }
+
+    // 10 bits per character at 115200 baud
+    uint32_t start = line->busy_until_us > *line->now_us ? line->busy_until_us : *line->now_us;
+    line->busy_until_us = start + (uint32_t)info.encoded_length * 10 * 1000000 / 115200;
+    if (sim_lost(line)) {
+        return true;
+    }
+
+    Sim_frame *frame = &line->frames[line->head++ % SIM_QUEUE_SIZE];
+    frame->arrival_us = line->busy_until_us;
+    frame->msg.start_byte = MSG_START_BYTE;
+    frame->msg.msg_type = msg_type;
+    frame->msg.length = 0;
+    for (uint8_t i = 0; i < segment_count; i++) {
+        memcpy(&frame->msg.payload[frame->msg.length], segments[i].data, segments[i].length);
+        frame->msg.length += segments[i].length;
+    }
+    frame->msg.checksum = info.checksum;
+    frame->msg.end_byte = MSG_END_BYTE;
+    return true;
+}
+
+static void sim_deliver(ARQ_link *link, const Message *msg) {
+    Sim_line *line = (Sim_line *)link->context;
+    uint16_t index = (uint16_t)(msg->payload[0] | (msg->payload[1] << 8));
+    if (index != line->next_index) {
+        line->in_order = false;
+    }
+    line->next_index++;
+}
+
+// Hands the frames that have arrived to the other side
+static void sim_receive(Sim_line *line, uint32_t now_us) {
+    while (line->tail != line->head && line->frames[line->tail % SIM_QUEUE_SIZE].arrival_us <= now_us) {
+        Message msg = line->frames[line->tail++ % SIM_QUEUE_SIZE].msg;
+        arq_receive(line->peer, &msg, (uint16_t)(now_us / SIM_TICK_US));
+    }
+}
+
+typedef struct {
+    uint32_t elapsed_us;
+    uint16_t delivered;
+    uint16_t transmissions;
+    bool in_order;
+} Sim_result;
+
+static Sim_result simulate(uint8_t window, uint32_t loss_per_mille) {
+    static uint8_t payloads[SIM_FRAMES][SIM_PAYLOAD_SIZE];
+    uint32_t now_us = 0;
+    Sim_line to_lander, to_rds;
+    memset(&to_lander, 0, sizeof(to_lander));
+    memset(&to_rds, 0, sizeof(to_rds));
+
+    ARQ_link rds, lander;
+    ARQ_config config;
+    config.window = window;
+    config.timeout = 150;       // 15 ms, like the firmware
+    config.max_transmissions = 0;
+    config.ack_delay = 20;      // 2 ms
+    config.session = 0;
+    arq_init(&rds, &config, sim_send, sim_deliver, &to_lander);
+    arq_init(&lander, &config, sim_send, sim_deliver, &to_rds);
+
+    to_lander.loss_per_mille = loss_per_mille;
+    to_lander.random = 1;
+    to_lander.now_us = &now_us;
+    to_lander.peer = &lander;
+    to_rds.loss_per_mille = loss_per_mille;
+    to_rds.random = 2;
+    to_rds.now_us = &now_us;
+    to_rds.peer = &rds;
+    // the lander counts what it receives from the RDS
+    lander.context = &to_rds;
+    to_rds.in_order = true;
+
+    for (uint16_t i = 0; i < SIM_FRAMES; i++) {
+        memset(payloads[i], 'x', SIM_PAYLOAD_SIZE);
+        payloads[i][0] = (uint8_t)i;
+        payloads[i][1] = (uint8_t)(i >> 8);
+    }
+
+    uint16_t queued = 0;
+    while ((queued < SIM_FRAMES || arq_outstanding(&rds) != 0) && now_us < 60000000) {
+        uint16_t now = (uint16_t)(now_us / SIM_TICK_US);
+        sim_receive(&to_lander, now_us);
+        sim_receive(&to_rds, now_us);
+        // a frame is only queued when the line is free, like uart_tx_reserve waits for room
+        while (queued < SIM_FRAMES && to_lander.busy_until_us <= now_us &&
+               arq_send(&rds, MSG_TYPE_DATA, payloads[queued], SIM_PAYLOAD_SIZE, now)) {
+            queued++;
+        }
+        arq_poll(&rds, now);
+        arq_poll(&lander, now);
+        now_us += SIM_TICK_US;
+    }
+
+    Sim_result result;
+    result.elapsed_us = now_us;
+    result.delivered = to_rds.next_index;
+    result.transmissions = (uint16_t)(rds.statistics.sent + rds.statistics.retransmissions);
+    result.in_order = to_rds.in_order;
+    return result;
+}
+
+TEST(arqTestSuite, loopbackGoodputTest) {
+    const uint32_t loss_rates[] = {0, 10, 50, 100, 200};
+
+    for (uint8_t i = 0; i < sizeof(loss_rates) / sizeof(loss_rates[0]); i++) {
+        Sim_result stop_and_wait = simulate(1, loss_rates[i]);
+        Sim_result window_4 = simulate(4, loss_rates[i]);
+        Sim_result window_8 = simulate(8, loss_rates[i]);
+
+        const Sim_result *results[] = {&stop_and_wait, &window_4, &window_8};
+        for (uint8_t j = 0; j < 3; j++) {
+            EXPECT_EQ(SIM_FRAMES, results[j]->delivered);
+            EXPECT_TRUE(results[j]->in_order);
+        }
+        EXPECT_LT(window_4.elapsed_us, stop_and_wait.elapsed_us);
+
+        double bytes = (double)SIM_FRAMES * SIM_PAYLOAD_SIZE;
+        printf("[   INFO   ] loss %4.1f %%: goodput stop-and-wait %6.0f B/s, window 4 %6.0f B/s, window 8 %6.0f B/s "
+               "(%u, %u, %u transmissions)\n", loss_rates[i] / 10.0,
+               bytes * 1e6 / stop_and_wait.elapsed_us, bytes * 1e6 / window_4.elapsed_us,
+               bytes * 1e6 / window_8.elapsed_us, stop_and_wait.transmissions, window_4.transmissions,
+               window_8.transmissions);
+    }
+}
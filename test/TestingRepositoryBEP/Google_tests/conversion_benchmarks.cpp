@@ -0,0 +1,212 @@
+/*
+ * conversion_benchmarks.cpp file
+ *
+ * Microbenchmarks of the conversions of the sensor readouts: the float reference conversions, which the host copies of
+ * supercap_readout.cpp and temp_sensors.cpp keep, against the integer conversions of sensor_fixed_point.h. Every
+ * conversion runs over all of its inputs:
+ *  - voltage: every ADC result from 0 to 4095,
+ *  - frequency: every valid period of a temperature sensor, 5000 to 26666 ticks,
+ *  - temperature: the same periods to degrees Celsius, for the float conversion through the frequency,
+ *  - heater: the decision of the heater for the same periods, from the float temperature against 20 and 40 degrees
+ *    Celsius and from the period against the periods of those thresholds.
+ *
+ * For every conversion the time per conversion and the time stamp counter cycles per conversion (x86 hosts only) are
+ * reported:
+ *
+ *   Conversion_benchmarks_run [--smoke]
+ *
+ *  --smoke             run every benchmark once without timing it properly, used by ctest
+ *
+ * The host has a floating point unit, the MSP430 has not. On the host a float division is a single instruction, on the
+ * MSP430 a call into the software floating point library of a few hundred cycles, so the host times are a lower bound
+ * of the gain. Configure with -DCMAKE_BUILD_TYPE=Release for the numbers.
+ *
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ */
+
+#include "supercap_readout.h"
+#include "temp_sensors.h"
+#include <system_health_lib/sensor_fixed_point.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCHMARK_HAS_TSC 1
+#else
+#define BENCHMARK_HAS_TSC 0
+#endif
+
+#define BENCHMARK_REPEATS 5
+
+// Sink for the results of the benchmarked conversions, such that the compiler cannot remove the calls
+static volatile float benchmark_float_sink;
+static volatile int32_t benchmark_fixed_sink;
+
+// Every pass converts all inputs of a conversion and returns how many there were
+typedef uint32_t (*Conversion_pass)(void);
+
+static uint32_t voltage_float(void) {
+    float sum = 0;
+    for (uint16_t adc_value = 0; adc_value <= SENSOR_ADC_MAX_VALUE; adc_value++) {
+        sum += convert_adc_to_voltage(adc_value);
+    }
+    benchmark_float_sink = sum;
+    return SENSOR_ADC_MAX_VALUE + 1;
+}
+
+static uint32_t voltage_fixed(void) {
+    int32_t sum = 0;
+    for (uint16_t adc_value = 0; adc_value <= SENSOR_ADC_MAX_VALUE; adc_value++) {
+        sum += adc_to_millivolts(adc_value);
+    }
+    benchmark_fixed_sink = sum;
+    return SENSOR_ADC_MAX_VALUE + 1;
+}
+
+static uint32_t frequency_float(void) {
+    float sum = 0;
+    for (uint32_t period = SENSOR_MIN_PERIOD; period <= SENSOR_MAX_PERIOD; period++) {
+        sum += calculateFrequency((float)period);
+    }
+    benchmark_float_sink = sum;
+    return SENSOR_MAX_PERIOD - SENSOR_MIN_PERIOD + 1;
+}
+
+static uint32_t frequency_fixed(void) {
+    int32_t sum = 0;
+    for (uint32_t period = SENSOR_MIN_PERIOD; period <= SENSOR_MAX_PERIOD; period++) {
+        sum += (int32_t)period_to_centihertz((uint16_t)period);
+    }
+    benchmark_fixed_sink = sum;
+    return SENSOR_MAX_PERIOD - SENSOR_MIN_PERIOD + 1;
+}
+
+static uint32_t temperature_float(void) {
+    float sum = 0;
+    for (uint32_t period = SENSOR_MIN_PERIOD; period <= SENSOR_MAX_PERIOD; period++) {
+        sum += frequency_to_temperature(calculateFrequency((float)period));
+    }
+    benchmark_float_sink = sum;
+    return SENSOR_MAX_PERIOD - SENSOR_MIN_PERIOD + 1;
+}
+
+static uint32_t temperature_fixed(void) {
+    int32_t sum = 0;
+    for (uint32_t period = SENSOR_MIN_PERIOD; period <= SENSOR_MAX_PERIOD; period++) {
+        sum += period_to_centidegrees((uint16_t)period);
+    }
+    benchmark_fixed_sink = sum;
+    return SENSOR_MAX_PERIOD - SENSOR_MIN_PERIOD + 1;
+}
+
+static uint32_t temperature_fixed_frequency(void) {
+    int32_t sum = 0;
+    for (uint32_t period = SENSOR_MIN_PERIOD; period <= SENSOR_MAX_PERIOD; period++) {
+        sum += centihertz_to_centidegrees(period_to_centihertz((uint16_t)period));
+    }
+    benchmark_fixed_sink = sum;
+    return SENSOR_MAX_PERIOD - SENSOR_MIN_PERIOD + 1;
+}
+
+static uint32_t heater_float(void) {
+    int32_t decisions = 0;
+    for (uint32_t period = SENSOR_MIN_PERIOD; period <= SENSOR_MAX_PERIOD; period++) {
+        float temperature = frequency_to_temperature(calculateFrequency((float)period));
+        decisions += (temperature > 40) - (temperature < 20);
+    }
+    benchmark_fixed_sink = decisions;
+    return SENSOR_MAX_PERIOD - SENSOR_MIN_PERIOD + 1;
+}
+
+static uint32_t heater_period(void) {
+    static constexpr uint16_t on_below = centidegrees_to_period(2000);
+    static constexpr uint16_t off_from = centidegrees_to_period(4001);
+    int32_t decisions = 0;
+    for (uint32_t period = SENSOR_MIN_PERIOD; period <= SENSOR_MAX_PERIOD; period++) {
+        // volatile, such that the compiler cannot count the decisions of the whole range at once
+        volatile uint16_t sample = (uint16_t)period;
+        decisions += (sample >= off_from) - (sample < on_below);
+    }
+    benchmark_fixed_sink = decisions;
+    return SENSOR_MAX_PERIOD - SENSOR_MIN_PERIOD + 1;
+}
+
+typedef struct {
+    const char *name;
+    Conversion_pass pass;
+} Conversion_benchmark;
+
+static const Conversion_benchmark benchmarks[] = {
+    {"voltage/float", voltage_float},
+    {"voltage/fixed", voltage_fixed},
+    {"frequency/float", frequency_float},
+    {"frequency/fixed", frequency_fixed},
+    {"temperature/float", temperature_float},
+    {"temperature/fixed", temperature_fixed},
+    {"temperature/fixed_frequency", temperature_fixed_frequency},
+    {"heater/float", heater_float},
+    {"heater/period", heater_period},
+};
+
+#define BENCHMARK_COUNT (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+/*
+ * Runs passes of a conversion for at least minimum_ns, the best of BENCHMARK_REPEATS repeats is taken.
+ */
+static void run_benchmark(Conversion_pass pass, double minimum_ns, double *ns_per_conversion,
+                          double *cycles_per_conversion) {
+    double best_ns = 0;
+    double best_cycles = 0;
+    for (uint8_t repeat = 0; repeat < BENCHMARK_REPEATS; repeat++) {
+        uint64_t conversions = 0;
+        double elapsed_ns = 0;
+        uint64_t cycles = 0;
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        do {
+#if BENCHMARK_HAS_TSC
+            uint64_t start = __rdtsc();
+            conversions += pass();
+            cycles += __rdtsc() - start;
+#else
+            conversions += pass();
+#endif
+            elapsed_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+        } while (elapsed_ns < minimum_ns);
+
+        double ns = elapsed_ns / conversions;
+        if (repeat == 0 || ns < best_ns) {
+            best_ns = ns;
+            best_cycles = (double)cycles / conversions;
+        }
+    }
+    *ns_per_conversion = best_ns;
+    *cycles_per_conversion = best_cycles;
+}
+
+int main(int argc, char **argv) {
+    bool smoke = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--smoke") == 0) {
+            smoke = true;
+        } else {
+            fprintf(stderr, "unknown argument %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    const double minimum_ns = smoke ? 0 : 20e6;
+    printf("%-30s %16s %18s\n", "conversion", "ns/conversion", "cycles/conversion");
+    for (uint8_t b = 0; b < BENCHMARK_COUNT; b++) {
+        double ns_per_conversion;
+        double cycles_per_conversion;
+        run_benchmark(benchmarks[b].pass, minimum_ns, &ns_per_conversion, &cycles_per_conversion);
+        if (BENCHMARK_HAS_TSC) {
+            printf("%-30s %16.2f %18.1f\n", benchmarks[b].name, ns_per_conversion, cycles_per_conversion);
+        } else {
+            printf("%-30s %16.2f %18s\n", benchmarks[b].name, ns_per_conversion, "-");
+        }
+    }
+    return 0;
+}
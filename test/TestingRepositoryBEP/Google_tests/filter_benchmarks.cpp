@@ -0,0 +1,234 @@
+/*
+ * filter_benchmarks.cpp file
+ *
+ * Microbenchmarks of the median of the temperature periods: the exchange sort of the former temperature readout
+ * against the sorting network and the median network of sensor_filters.h, with std::nth_element as a reference. Every
+ * median runs over two sets of PERIOD_CAPTURE_COUNT periods:
+ *  - sensor: periods of a 200 Hz sensor with a few counts of jitter and now and then a missing or doubled period,
+ *  - random: random periods over the whole 16 bits.
+ *
+ * For every median and set the time per median and the time stamp counter cycles per median (x86 hosts only) are
+ * reported, together with the compare-exchanges per median, which are the same on every machine:
+ *
+ *   Filter_benchmarks_run [--smoke]
+ *
+ *  --smoke             run every benchmark once without timing it properly, used by ctest
+ *
+ * The host times are only good for a comparison between the medians, the MSP430 has no cache and no branch
+ * prediction, there the compare-exchanges are the better measure. The networks are only unrolled by an optimizing
+ * build, configure with -DCMAKE_BUILD_TYPE=Release for the numbers.
+ *
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ */
+
+#include <system_health_lib/period_capture.h>
+#include <system_health_lib/sensor_filters.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCHMARK_HAS_TSC 1
+#else
+#define BENCHMARK_HAS_TSC 0
+#endif
+
+#define SET_MEDIANS 1024
+#define SET_COUNT 2
+#define BENCHMARK_REPEATS 5
+
+// Periods of one set
+typedef struct {
+    const char *name;
+    uint16_t periods[SET_MEDIANS][PERIOD_CAPTURE_COUNT];
+} Period_set;
+
+typedef uint16_t (*Median_function)(const uint16_t *periods);
+
+// Sink for the results of the benchmarked medians, such that the compiler cannot remove the calls
+static volatile uint32_t benchmark_sink;
+
+static uint32_t random_state = 0x2545F491;
+
+// xorshift32, the sets are the same on every run
+static uint32_t random_next(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+// The median of the former temperature readout
+static uint16_t median_exchange_sort(const uint16_t *periods) {
+    uint16_t sorted[PERIOD_CAPTURE_COUNT];
+    uint8_t i, j;
+    for (i = 0; i < PERIOD_CAPTURE_COUNT; i++) {
+        sorted[i] = periods[i];
+    }
+    uint16_t temp;
+    for (i = 0; i < PERIOD_CAPTURE_COUNT; i++) {
+        for (j = i + 1; j < PERIOD_CAPTURE_COUNT; j++) {
+            if (sorted[i] > sorted[j]) {
+                temp = sorted[i];
+                sorted[i] = sorted[j];
+                sorted[j] = temp;
+            }
+        }
+    }
+    return sorted[PERIOD_CAPTURE_COUNT / 2];
+}
+
+static uint16_t median_sorting_network(const uint16_t *periods) {
+    uint16_t sorted[PERIOD_CAPTURE_COUNT];
+    memcpy(sorted, periods, sizeof(sorted));
+    filter_sort<PERIOD_CAPTURE_COUNT>(sorted);
+    return sorted[PERIOD_CAPTURE_COUNT / 2];
+}
+
+static uint16_t median_network(const uint16_t *periods) {
+    return filter_median<PERIOD_CAPTURE_COUNT>(periods);
+}
+
+static uint16_t median_nth_element(const uint16_t *periods) {
+    uint16_t copy[PERIOD_CAPTURE_COUNT];
+    memcpy(copy, periods, sizeof(copy));
+    std::nth_element(copy, copy + PERIOD_CAPTURE_COUNT / 2, copy + PERIOD_CAPTURE_COUNT);
+    return copy[PERIOD_CAPTURE_COUNT / 2];
+}
+
+typedef struct {
+    const char *name;
+    Median_function median;
+    uint16_t compare_exchanges;     // 0 when it depends on the input
+} Median_benchmark;
+
+static const Median_benchmark benchmarks[] = {
+    {"exchange_sort", median_exchange_sort, PERIOD_CAPTURE_COUNT * (PERIOD_CAPTURE_COUNT - 1) / 2},
+    {"sorting_network", median_sorting_network, Filter_network<PERIOD_CAPTURE_COUNT, false>::size},
+    {"median_network", median_network, Filter_network<PERIOD_CAPTURE_COUNT, true>::size},
+    {"nth_element", median_nth_element, 0},
+};
+
+#define BENCHMARK_COUNT (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+static void build_sets(Period_set *sets) {
+    sets[0].name = "sensor";
+    for (uint16_t m = 0; m < SET_MEDIANS; m++) {
+        for (uint8_t i = 0; i < PERIOD_CAPTURE_COUNT; i++) {
+            uint32_t r = random_next();
+            uint16_t period = (uint16_t)(20000 + (r % 9) - 4);
+            if ((r >> 8) % 16 == 0) {
+                period = (r >> 12) & 1 ? PERIOD_CAPTURE_MISSING : 40000;
+            }
+            sets[0].periods[m][i] = period;
+        }
+    }
+    sets[1].name = "random";
+    for (uint16_t m = 0; m < SET_MEDIANS; m++) {
+        for (uint8_t i = 0; i < PERIOD_CAPTURE_COUNT; i++) {
+            sets[1].periods[m][i] = (uint16_t)random_next();
+        }
+    }
+}
+
+static bool check_medians(const Period_set *set) {
+    for (uint16_t m = 0; m < SET_MEDIANS; m++) {
+        uint16_t expected = median_exchange_sort(set->periods[m]);
+        for (uint8_t b = 1; b < BENCHMARK_COUNT; b++) {
+            if (benchmarks[b].median(set->periods[m]) != expected) {
+                fprintf(stderr, "%s gives another median than the exchange sort for set %s\n", benchmarks[b].name,
+                        set->name);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void run_pass(Median_function median, const Period_set *set) {
+    uint32_t sum = 0;
+    for (uint16_t m = 0; m < SET_MEDIANS; m++) {
+        sum += median(set->periods[m]);
+    }
+    benchmark_sink = sum;
+}
+
+/*
+ * Runs passes over a set for at least minimum_ns, the best of BENCHMARK_REPEATS repeats is taken.
+ */
+static void run_benchmark(Median_function median, const Period_set *set, double minimum_ns, double *ns_per_median,
+                          double *cycles_per_median) {
+    double best_ns_per_pass = 0;
+    double best_cycles_per_pass = 0;
+    for (uint8_t repeat = 0; repeat < BENCHMARK_REPEATS; repeat++) {
+        uint32_t passes = 0;
+        double elapsed_ns = 0;
+        uint64_t cycles = 0;
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        do {
+#if BENCHMARK_HAS_TSC
+            uint64_t start = __rdtsc();
+            run_pass(median, set);
+            cycles += __rdtsc() - start;
+#else
+            run_pass(median, set);
+#endif
+            passes++;
+            elapsed_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+        } while (elapsed_ns < minimum_ns);
+
+        double ns_per_pass = elapsed_ns / passes;
+        if (repeat == 0 || ns_per_pass < best_ns_per_pass) {
+            best_ns_per_pass = ns_per_pass;
+            best_cycles_per_pass = (double)cycles / passes;
+        }
+    }
+    *ns_per_median = best_ns_per_pass / SET_MEDIANS;
+    *cycles_per_median = best_cycles_per_pass / SET_MEDIANS;
+}
+
+int main(int argc, char **argv) {
+    bool smoke = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--smoke") == 0) {
+            smoke = true;
+        } else {
+            fprintf(stderr, "unknown argument %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    static Period_set sets[SET_COUNT];
+    build_sets(sets);
+    for (uint8_t s = 0; s < SET_COUNT; s++) {
+        if (!check_medians(&sets[s])) {
+            return 1;
+        }
+    }
+
+    const double minimum_ns = smoke ? 0 : 20e6;
+    printf("%-30s %12s %14s %18s\n", "median of 9 periods", "ns/median", "cycles/median", "compare-exchanges");
+    for (uint8_t b = 0; b < BENCHMARK_COUNT; b++) {
+        for (uint8_t s = 0; s < SET_COUNT; s++) {
+            char name[64];
+            double ns_per_median;
+            double cycles_per_median;
+            snprintf(name, sizeof(name), "%s/%s", benchmarks[b].name, sets[s].name);
+            run_benchmark(benchmarks[b].median, &sets[s], minimum_ns, &ns_per_median, &cycles_per_median);
+            char compare_exchanges[16];
+            if (benchmarks[b].compare_exchanges) {
+                snprintf(compare_exchanges, sizeof(compare_exchanges), "%u", benchmarks[b].compare_exchanges);
+            } else {
+                snprintf(compare_exchanges, sizeof(compare_exchanges), "-");
+            }
+            if (BENCHMARK_HAS_TSC) {
+                printf("%-30s %12.2f %14.1f %18s\n", name, ns_per_median, cycles_per_median, compare_exchanges);
+            } else {
+                printf("%-30s %12.2f %14s %18s\n", name, ns_per_median, "-", compare_exchanges);
+            }
+        }
+    }
+    return 0;
+}
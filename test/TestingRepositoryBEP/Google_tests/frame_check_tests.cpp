@@ -0,0 +1,255 @@
+/*
+ * frame_check_tests.cpp file
+ *
+ * Testing file for the frame checks of the Message protocol (XOR checksum and CRC-16-CCITT). Multiple tests are executed here to demonstrate that the checks behave as expected. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Check value test: The CRC of "123456789" is the published CRC-16-CCITT check value 0x29B1.
+ * - Table test: Every entry of the compile-time table equals the bit by bit calculation.
+ * - Block and update test: Calculating the CRC per byte or per block gives the same result.
+ * - XOR checksum test: FRAME_CHECK_XOR8 gives the same checksum as calculate_checksum_helper.
+ * - Frame check size test: The XOR checksum takes one byte and the CRC two bytes.
+ * - Double bit error test: Two flips in the same bit position pass the XOR checksum but are caught by the CRC.
+ * - CRC frame round trip test: A CRC frame written by the frame writer is accepted by the decoder.
+ * - CRC frame corruption test: The decoder rejects a CRC frame with two flipped bits.
+ * - Escaped CRC test: CRC bytes that are equal to SLIP characters are escaped and accepted.
+ * - Throughput benchmark: Reports the throughput of the XOR checksum, the software CRC and the hardware CRC.
+ */
+
+#include "gtest/gtest.h"
+#include "lander_communication.h"
+#include <lander_communication_lib/frame_check.h>
+#include <lander_communication_lib/slip_frame_writer.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+// Cycle estimates of the MSP430FR5969 per byte at 16 MHz with one FRAM wait state, from the instruction timings of the
+// inner loops: XOR (mov.b @Rn+, xor, loop), table CRC (index calculation, table read, shift, xor, loop) and hardware
+// CRC (mov.b @Rn+ to CRCDIRB_L, loop)
+#define SIM_SMCLK_HZ            16000000UL
+#define SIM_XOR_CYCLES          6UL
+#define SIM_TABLE_CRC_CYCLES    16UL
+#define SIM_HARDWARE_CRC_CYCLES 6UL
+
+// Bit by bit CRC-16-CCITT, used as reference
+static uint16_t crc16_bitwise(uint16_t crc, const uint8_t *data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// Writes a frame with the frame writer and returns the bytes on the wire
+static uint16_t write_frame(uint8_t msg_type, const uint8_t *payload, uint8_t length, Frame_check_type check,
+                            uint8_t *wire) {
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+    Payload_segment segment = {payload, length};
+    SLIP_frame_info info;
+    EXPECT_TRUE(slip_frame_prepare(msg_type, &segment, 1, check, &info));
+    slip_frame_write(&queue, &info, &segment, 1);
+    uint16_t wire_length = 0;
+    while (uart_tx_queue_pop(&queue, &wire[wire_length])) {
+        wire_length++;
+    }
+    EXPECT_EQ(info.encoded_length, wire_length);
+    return wire_length;
+}
+
+// Feeds characters to a decoder and returns the last result that was not SLIP_STREAM_BUSY
+static SLIP_stream_result decode(SLIP_stream_decoder *decoder, const uint8_t *data, uint16_t length) {
+    SLIP_stream_result last = SLIP_STREAM_BUSY;
+    for (uint16_t i = 0; i < length; i++) {
+        SLIP_stream_result result = slip_stream_decode_byte(decoder, data[i]);
+        if (result != SLIP_STREAM_BUSY) {
+            last = result;
+        }
+    }
+    return last;
+}
+
+// The table is generated by the compiler, so it can be checked at compile time as well
+static_assert(crc16_make_table().entry[0x10] == 0x1231, "CRC16 table is not generated at compile time");
+
+TEST(frameCheckTestSuite, checkValueTest) {
+    const uint8_t data[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    EXPECT_EQ(0x29B1, crc16_block_software(CRC16_CCITT_INIT, data, sizeof(data)));
+    EXPECT_EQ(0x29B1, frame_check_block(FRAME_CHECK_CRC16, frame_check_init(FRAME_CHECK_CRC16), data, sizeof(data)));
+}
+
+TEST(frameCheckTestSuite, tableTest) {
+    for (uint16_t i = 0; i < 256; i++) {
+        uint8_t byte = (uint8_t)i;
+        EXPECT_EQ(crc16_bitwise(0, &byte, 1), crc16_table.entry[i]);
+    }
+}
+
+TEST(frameCheckTestSuite, blockAndUpdateTest) {
+    uint8_t data[200];
+    for (uint16_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 13 + 7);
+    }
+    uint16_t crc = CRC16_CCITT_INIT;
+    for (uint16_t i = 0; i < sizeof(data); i++) {
+        crc = frame_check_update(FRAME_CHECK_CRC16, crc, data[i]);
+    }
+
+    EXPECT_EQ(crc16_bitwise(CRC16_CCITT_INIT, data, sizeof(data)), crc);
+    EXPECT_EQ(crc, crc16_block_software(CRC16_CCITT_INIT, data, sizeof(data)));
+}
+
+TEST(frameCheckTestSuite, xorChecksumTest) {
+    uint8_t frame[] = {0x01, 0x04, 0x74, 0x65, 0x73, 0x74};
+
+    EXPECT_EQ(0x13, frame_check_block(FRAME_CHECK_XOR8, frame_check_init(FRAME_CHECK_XOR8), frame, sizeof(frame)));
+    EXPECT_EQ(calculate_checksum_helper(0x01, 4, &frame[2]),
+              frame_check_block(FRAME_CHECK_XOR8, frame_check_init(FRAME_CHECK_XOR8), frame, sizeof(frame)));
+}
+
+TEST(frameCheckTestSuite, frameCheckSizeTest) {
+    EXPECT_EQ(1, frame_check_size(FRAME_CHECK_XOR8));
+    EXPECT_EQ(2, frame_check_size(FRAME_CHECK_CRC16));
+}
+
+TEST(frameCheckTestSuite, doubleBitErrorTest) {
+    // flip the same bit in every pair of bytes of a 32 byte frame
+    uint8_t frame[32];
+    for (uint16_t i = 0; i < sizeof(frame); i++) {
+        frame[i] = (uint8_t)(i * 31);
+    }
+    uint16_t xor_reference = frame_check_block(FRAME_CHECK_XOR8, 0, frame, sizeof(frame));
+    uint16_t crc_reference = crc16_block_software(CRC16_CCITT_INIT, frame, sizeof(frame));
+    unsigned long errors = 0;
+    unsigned long missed_by_xor = 0;
+    unsigned long missed_by_crc = 0;
+
+    for (uint16_t first = 0; first < sizeof(frame); first++) {
+        for (uint16_t second = first + 1; second < sizeof(frame); second++) {
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                uint8_t corrupted[sizeof(frame)];
+                memcpy(corrupted, frame, sizeof(frame));
+                corrupted[first] ^= (uint8_t)(1 << bit);
+                corrupted[second] ^= (uint8_t)(1 << bit);
+                errors++;
+                if (frame_check_block(FRAME_CHECK_XOR8, 0, corrupted, sizeof(corrupted)) == xor_reference) {
+                    missed_by_xor++;
+                }
+                if (crc16_block_software(CRC16_CCITT_INIT, corrupted, sizeof(corrupted)) == crc_reference) {
+                    missed_by_crc++;
+                }
+            }
+        }
+    }
+
+    printf("[   INFO   ] %lu double bit errors in the same bit position: XOR misses %lu, CRC16 misses %lu\n",
+           errors, missed_by_xor, missed_by_crc);
+    EXPECT_EQ(errors, missed_by_xor);
+    EXPECT_EQ(0, missed_by_crc);
+}
+
+TEST(frameCheckTestSuite, crcFrameRoundTripTest) {
+    uint8_t ring[256];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, sizeof(ring), FRAME_CHECK_CRC16);
+    const uint8_t payload[] = {'t', 'e', 's', 't'};
+    uint8_t wire[UART_TX_QUEUE_SIZE];
+
+    uint16_t length = write_frame(MSG_TYPE_INIT, payload, sizeof(payload), FRAME_CHECK_CRC16, wire);
+    // END, start byte, type, length, payload, two CRC bytes, end byte, END
+    EXPECT_EQ(12, length);
+    ASSERT_EQ(SLIP_STREAM_FRAME_READY, decode(&decoder, wire, length));
+
+    const uint8_t covered[] = {MSG_TYPE_INIT, sizeof(payload), 't', 'e', 's', 't'};
+    EXPECT_EQ(crc16_bitwise(CRC16_CCITT_INIT, covered, sizeof(covered)), decoder.last_frame.checksum);
+    EXPECT_EQ(decoder.last_frame.checksum >> 8, wire[8]);
+    EXPECT_EQ(decoder.last_frame.checksum & 0xFF, wire[9]);
+}
+
+TEST(frameCheckTestSuite, crcFrameCorruptionTest) {
+    uint8_t ring[256];
+    SLIP_stream_decoder xor_decoder;
+    SLIP_stream_decoder crc_decoder;
+    slip_stream_init(&xor_decoder, ring, sizeof(ring), FRAME_CHECK_XOR8);
+    slip_stream_init(&crc_decoder, ring, sizeof(ring), FRAME_CHECK_CRC16);
+    const uint8_t payload[] = {'D', 'E', 'P', 'L', 'O', 'Y'};
+    uint8_t xor_wire[UART_TX_QUEUE_SIZE];
+    uint8_t crc_wire[UART_TX_QUEUE_SIZE];
+    uint16_t xor_length = write_frame(MSG_TYPE_DATA, payload, sizeof(payload), FRAME_CHECK_XOR8, xor_wire);
+    uint16_t crc_length = write_frame(MSG_TYPE_DATA, payload, sizeof(payload), FRAME_CHECK_CRC16, crc_wire);
+
+    // flip bit 1 of the first and the third payload byte ('D' becomes 'F', 'P' becomes 'R')
+    xor_wire[4] ^= 0x02;
+    xor_wire[6] ^= 0x02;
+    crc_wire[4] ^= 0x02;
+    crc_wire[6] ^= 0x02;
+
+    EXPECT_EQ(SLIP_STREAM_FRAME_READY, decode(&xor_decoder, xor_wire, xor_length));
+    EXPECT_EQ(SLIP_STREAM_INVALID_CHECKSUM, decode(&crc_decoder, crc_wire, crc_length));
+    EXPECT_EQ(1, crc_decoder.invalid_checksums);
+}
+
+TEST(frameCheckTestSuite, escapedCrcTest) {
+    uint8_t ring[256];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, sizeof(ring), FRAME_CHECK_CRC16);
+    uint8_t wire[UART_TX_QUEUE_SIZE];
+    int escaped_frames = 0;
+
+    // search payloads whose CRC contains a SLIP character
+    for (uint16_t value = 0; value < 256; value++) {
+        uint8_t payload[] = {(uint8_t)value, 0x55};
+        const uint8_t covered[] = {MSG_TYPE_DATA, sizeof(payload), payload[0], payload[1]};
+        uint16_t crc = crc16_bitwise(CRC16_CCITT_INIT, covered, sizeof(covered));
+        uint8_t high = (uint8_t)(crc >> 8);
+        uint8_t low = (uint8_t)crc;
+        if (high != SLIP_END && high != SLIP_ESC && low != SLIP_END && low != SLIP_ESC) {
+            continue;
+        }
+        escaped_frames++;
+        uint16_t length = write_frame(MSG_TYPE_DATA, payload, sizeof(payload), FRAME_CHECK_CRC16, wire);
+        EXPECT_EQ(SLIP_STREAM_FRAME_READY, decode(&decoder, wire, length));
+        EXPECT_EQ(crc, decoder.last_frame.checksum);
+        slip_stream_release(&decoder, &decoder.last_frame);
+    }
+    EXPECT_GT(escaped_frames, 0);
+}
+
+TEST(frameCheckTestSuite, throughputBenchmark) {
+    const int rounds = 20000;
+    uint8_t frame[MAX_PAYLOAD_SIZE + 2];
+    for (uint16_t i = 0; i < sizeof(frame); i++) {
+        frame[i] = (uint8_t)(i * 7);
+    }
+    volatile uint16_t sink = 0;
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        sink = sink + frame_check_block(FRAME_CHECK_XOR8, (uint16_t)round, frame, sizeof(frame));
+    }
+    double xor_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    begin = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        sink = sink + crc16_block_software((uint16_t)round, frame, sizeof(frame));
+    }
+    double crc_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    double bytes = (double)rounds * sizeof(frame);
+    printf("[   INFO   ] host:   XOR %7.1f MB/s, table CRC16 %7.1f MB/s\n", 1000.0 * bytes / xor_ns,
+           1000.0 * bytes / crc_ns);
+    // the hardware CRC module only exists on the MSP430, so its throughput comes from the cycle model
+    printf("[   INFO   ] MSP430: XOR %7.2f MB/s, table CRC16 %7.2f MB/s, hardware CRC16 %7.2f MB/s (estimated)\n",
+           SIM_SMCLK_HZ / (double)SIM_XOR_CYCLES / 1e6, SIM_SMCLK_HZ / (double)SIM_TABLE_CRC_CYCLES / 1e6,
+           SIM_SMCLK_HZ / (double)SIM_HARDWARE_CRC_CYCLES / 1e6);
+    printf("[   INFO   ] UART at 115200 baud needs %.3f MB/s, a %u byte frame costs %lu / %lu / %lu cycles\n",
+           11520.0 / 1e6, (unsigned)sizeof(frame), sizeof(frame) * SIM_XOR_CYCLES,
+           sizeof(frame) * SIM_TABLE_CRC_CYCLES, sizeof(frame) * SIM_HARDWARE_CRC_CYCLES);
+    EXPECT_GT(crc_ns, 0.0);
+}
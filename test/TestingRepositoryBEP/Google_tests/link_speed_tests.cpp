@@ -0,0 +1,349 @@
+/*
+ * link_speed_tests.cpp file
+ *
+ * Testing file for the baud rate calculator and the link speed negotiation of the lander link. Multiple tests are executed here to demonstrate that they behave as expected. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Calculator test: The register settings and errors match the user's guide, also for the 115200 baud settings that
+ *   uart_init used to hard-code. Some of the checks are done at compile time.
+ * - Settings table test: link_speed_settings holds the calculated settings of every speed of LINK_SPEEDS.
+ * - Negotiate test: Two sides over a simulated line switch to 1M baud and keep exchanging data.
+ * - Slower side test: The fastest speed both sides support is chosen.
+ * - Dead speed test: Both sides fall back to 115200 baud when nothing gets through at the selected speed.
+ * - Step down test: A side steps down one speed when errors rise, and the link keeps running.
+ * - Not negotiating side test: A side that does not know MSG_TYPE_LINK_SPEED leaves the link at 115200 baud.
+ * - Lossy line test: With frames lost at every speed both sides always end up at the same speed, which is nearly always
+ *   1M baud because lost commands are sent again.
+ */
+
+#include "gtest/gtest.h"
+#include "lander_communication.h"
+#include <lander_communication_lib/link_speed.h>
+#include <lander_communication_lib/slip_frame_writer.h>
+#include <cstdio>
+#include <cstring>
+
+// the calculator is constexpr, the firmware checks its speeds the same way in link_speed.cpp
+static_assert(uart_baud_setting(16000000, 115200).brw == 8, "UCBRx of 115200 baud");
+static_assert(uart_baud_setting(16000000, 115200).mctlw == 0xF7A1, "UCBRSx 0xF7, UCBRFx 10 and UCOS16");
+static_assert(uart_baud_error(16000000, 1000000) == 0, "1M baud is an integer divider of 16 MHz");
+static_assert(uart_baud_error(32768, 9600) > UART_BAUD_MAX_ERROR, "9600 baud on ACLK is rejected");
+
+TEST(linkSpeedTestSuite, calculatorTest) {
+    // user's guide table 30-5
+    UART_baud_setting setting = uart_baud_setting(16000000, 9600);
+    EXPECT_EQ(104, setting.brw);
+    EXPECT_EQ(UART_MCTLW_UCOS16 | 2 << UART_MCTLW_UCBRF_SHIFT | 0xD6 << UART_MCTLW_UCBRS_SHIFT, setting.mctlw);
+
+    setting = uart_baud_setting(16000000, 57600);
+    EXPECT_EQ(17, setting.brw);
+    EXPECT_EQ(UART_MCTLW_UCOS16 | 5 << UART_MCTLW_UCBRF_SHIFT | 0xDD << UART_MCTLW_UCBRS_SHIFT, setting.mctlw);
+
+    setting = uart_baud_setting(16000000, 230400);
+    EXPECT_EQ(4, setting.brw);
+    EXPECT_EQ(UART_MCTLW_UCOS16 | 5 << UART_MCTLW_UCBRF_SHIFT | 0x55 << UART_MCTLW_UCBRS_SHIFT, setting.mctlw);
+
+    setting = uart_baud_setting(16000000, 460800);
+    EXPECT_EQ(2, setting.brw);
+    EXPECT_EQ(UART_MCTLW_UCOS16 | 2 << UART_MCTLW_UCBRF_SHIFT | 0xBB << UART_MCTLW_UCBRS_SHIFT, setting.mctlw);
+
+    // no oversampling at a divider of 16 or lower
+    setting = uart_baud_setting(16000000, 1000000);
+    EXPECT_EQ(16, setting.brw);
+    EXPECT_EQ(0, setting.mctlw);
+
+    // max TX error of table 30-5, in 0.01 %
+    EXPECT_EQ(64u, uart_baud_error(1000000, 9600));
+    EXPECT_EQ(736u, uart_baud_error(1000000, 115200));
+    EXPECT_LE(uart_baud_error(16000000, 115200), (uint32_t)UART_BAUD_MAX_ERROR);
+    EXPECT_GT(uart_baud_error(1000000, 115200), (uint32_t)UART_BAUD_MAX_ERROR);
+}
+
+TEST(linkSpeedTestSuite, settingsTableTest) {
+    const uint32_t bauds[] = {115200, 230400, 460800, 1000000};
+    ASSERT_EQ(sizeof(bauds) / sizeof(bauds[0]), (size_t)LINK_SPEED_COUNT);
+
+    for (uint8_t i = 0; i < LINK_SPEED_COUNT; i++) {
+        UART_baud_setting setting = uart_baud_setting(UART_BRCLK_HZ, bauds[i]);
+        EXPECT_EQ(bauds[i], link_speed_baud((Link_speed)i));
+        EXPECT_EQ(setting.brw, link_speed_settings[i].brw);
+        EXPECT_EQ(setting.mctlw, link_speed_settings[i].mctlw);
+        printf("[   INFO   ] %7u baud: UCBRx %3u, UCAxMCTLW 0x%04X, max TX error %.2f %%\n", bauds[i],
+               link_speed_settings[i].brw, link_speed_settings[i].mctlw,
+               uart_baud_error(UART_BRCLK_HZ, bauds[i]) / 100.0);
+    }
+    EXPECT_EQ(0u, link_speed_baud(LINK_SPEED_COUNT));
+    EXPECT_EQ(LINK_SPEED_115200, LINK_SPEED_DEFAULT);
+}
+
+#define SIM_TICK_US 20
+#define SIM_QUEUE_SIZE 64
+#define SIM_DATA_PERIOD_US 2000
+#define SIM_DATA_SIZE 16
+
+typedef struct {
+    Message msg;
+    uint32_t arrival_us;
+    Link_speed speed;           // speed of the sender when the frame was sent
+    bool corrupted;
+} Sim_frame;
+
+typedef struct Sim_side Sim_side;
+
+// One side of the line with the frames it sends to the other side
+struct Sim_side {
+    Link_speed_negotiator negotiator;
+    Sim_side *peer;
+    Sim_frame frames[SIM_QUEUE_SIZE];
+    uint8_t head;
+    uint8_t tail;
+    uint32_t busy_until_us;
+    uint32_t *now_us;
+    uint32_t random;
+    uint32_t loss_per_mille[LINK_SPEED_COUNT];  // frames corrupted on the line, per speed
+    bool negotiates;            // false for a side that ignores MSG_TYPE_LINK_SPEED
+    uint16_t data_received;     // DATA frames received at the right speed
+};
+
+static bool sim_corrupted(Sim_side *side, Link_speed speed) {
+    side->random = side->random * 1103515245u + 12345u;
+    return ((side->random >> 16) % 1000) < side->loss_per_mille[speed];
+}
+
+static bool sim_send_frame(Sim_side *side, uint8_t msg_type, const uint8_t *payload, uint8_t length) {
+    Payload_segment segment = {payload, length};
+    SLIP_frame_info info;
+    if (!slip_frame_prepare(msg_type, &segment, 1, FRAME_CHECK_XOR8, &info)) {
+        return false;
+    }
+
+    // 10 bits per character at the current speed of the sender
+    Link_speed speed = side->negotiator.speed;
+    uint32_t start = side->busy_until_us > *side->now_us ? side->busy_until_us : *side->now_us;
+    side->busy_until_us = start + (uint32_t)info.encoded_length * 10 * 1000000 / link_speed_baud(speed);
+
+    Sim_frame *frame = &side->frames[side->head++ % SIM_QUEUE_SIZE];
+    frame->arrival_us = side->busy_until_us;
+    frame->speed = speed;
+    frame->corrupted = sim_corrupted(side, speed);
+    frame->msg.start_byte = MSG_START_BYTE;
+    frame->msg.msg_type = msg_type;
+    frame->msg.length = length;
+    memcpy(frame->msg.payload, payload, length);
+    frame->msg.checksum = info.checksum;
+    frame->msg.end_byte = MSG_END_BYTE;
+    return true;
+}
+
+static bool sim_send(Link_speed_negotiator *negotiator, const uint8_t *payload, uint8_t length) {
+    return sim_send_frame((Sim_side *)negotiator->context, MSG_TYPE_LINK_SPEED, payload, length);
+}
+
+static void sim_apply(Link_speed_negotiator *negotiator, Link_speed speed) {
+    // the firmware flushes the queue first, the frames that are already on the line keep their speed
+}
+
+// Hands the frames that have arrived to the other side, a frame at another speed than the receiver is garbage
+static void sim_receive(Sim_side *side, uint32_t now_us) {
+    Sim_side *peer = side->peer;
+    while (side->tail != side->head && side->frames[side->tail % SIM_QUEUE_SIZE].arrival_us <= now_us) {
+        Sim_frame *frame = &side->frames[side->tail++ % SIM_QUEUE_SIZE];
+        uint16_t now = (uint16_t)(now_us / 1000);
+        if (!peer->negotiates) {
+            continue;
+        }
+        if (frame->corrupted || frame->speed != peer->negotiator.speed) {
+            link_speed_frame_received(&peer->negotiator, false, now);
+            continue;
+        }
+        link_speed_frame_received(&peer->negotiator, true, now);
+        if (frame->msg.msg_type == MSG_TYPE_LINK_SPEED) {
+            link_speed_receive(&peer->negotiator, &frame->msg, now);
+        } else {
+            peer->data_received++;
+        }
+    }
+}
+
+static void sim_init(Sim_side *rds, Sim_side *lander, uint32_t *now_us, uint8_t rds_speeds, uint8_t lander_speeds) {
+    memset(rds, 0, sizeof(*rds));
+    memset(lander, 0, sizeof(*lander));
+
+    // the ticks are milliseconds, like the firmware
+    Link_speed_config config;
+    config.timeout = 20;
+    config.max_tries = 3;
+    config.error_window = 32;
+    config.max_errors = 8;
+    link_speed_init(&rds->negotiator, &config, rds_speeds, sim_send, sim_apply, rds);
+    link_speed_init(&lander->negotiator, &config, lander_speeds, sim_send, sim_apply, lander);
+
+    rds->peer = lander;
+    rds->now_us = now_us;
+    rds->random = 1;
+    rds->negotiates = true;
+    lander->peer = rds;
+    lander->now_us = now_us;
+    lander->random = 2;
+    lander->negotiates = true;
+    *now_us = 0;
+}
+
+// Runs the line for a while, both sides send a DATA frame every SIM_DATA_PERIOD_US when their line is free
+static void sim_run(Sim_side *rds, Sim_side *lander, uint32_t *now_us, uint32_t duration_us) {
+    static const uint8_t data[SIM_DATA_SIZE] = "data of the RDS";
+    uint32_t end_us = *now_us + duration_us;
+    Sim_side *sides[] = {rds, lander};
+
+    while (*now_us < end_us) {
+        uint16_t now = (uint16_t)(*now_us / 1000);
+        sim_receive(rds, *now_us);
+        sim_receive(lander, *now_us);
+        for (uint8_t i = 0; i < 2; i++) {
+            if (*now_us % SIM_DATA_PERIOD_US == 0 && sides[i]->busy_until_us <= *now_us) {
+                sim_send_frame(sides[i], MSG_TYPE_DATA, data, SIM_DATA_SIZE);
+            }
+            if (sides[i]->negotiates) {
+                link_speed_poll(&sides[i]->negotiator, now);
+            }
+        }
+        *now_us += SIM_TICK_US;
+    }
+}
+
+TEST(linkSpeedTestSuite, negotiateTest) {
+    Sim_side rds, lander;
+    uint32_t now_us;
+    sim_init(&rds, &lander, &now_us, LINK_SPEED_ALL, LINK_SPEED_ALL);
+
+    sim_run(&rds, &lander, &now_us, 10000);
+    EXPECT_TRUE(link_speed_propose(&rds.negotiator, (uint16_t)(now_us / 1000)));
+    EXPECT_FALSE(link_speed_propose(&rds.negotiator, (uint16_t)(now_us / 1000)));
+    sim_run(&rds, &lander, &now_us, 100000);
+
+    EXPECT_EQ(LINK_SPEED_1000000, rds.negotiator.speed);
+    EXPECT_EQ(LINK_SPEED_1000000, lander.negotiator.speed);
+    EXPECT_EQ(LINK_SPEED_IDLE, rds.negotiator.state);
+    EXPECT_EQ(LINK_SPEED_IDLE, lander.negotiator.state);
+    EXPECT_EQ(1, rds.negotiator.statistics.switches);
+    EXPECT_EQ(1, lander.negotiator.statistics.switches);
+    EXPECT_EQ(0, rds.negotiator.statistics.fallbacks);
+    EXPECT_EQ(0, lander.negotiator.statistics.fallbacks);
+
+    // the data keeps flowing at the new speed
+    uint16_t received = lander.data_received;
+    sim_run(&rds, &lander, &now_us, 100000);
+    EXPECT_GE(lander.data_received - received, 45);
+}
+
+TEST(linkSpeedTestSuite, slowerSideTest) {
+    Sim_side rds, lander;
+    uint32_t now_us;
+    sim_init(&rds, &lander, &now_us, LINK_SPEED_ALL,
+             LINK_SPEED_BIT(LINK_SPEED_230400) | LINK_SPEED_BIT(LINK_SPEED_460800));
+
+    link_speed_propose(&rds.negotiator, 0);
+    sim_run(&rds, &lander, &now_us, 100000);
+
+    EXPECT_EQ(LINK_SPEED_460800, rds.negotiator.speed);
+    EXPECT_EQ(LINK_SPEED_460800, lander.negotiator.speed);
+    EXPECT_EQ(LINK_SPEED_BIT(LINK_SPEED_115200) | LINK_SPEED_BIT(LINK_SPEED_230400) |
+              LINK_SPEED_BIT(LINK_SPEED_460800), rds.negotiator.common);
+    EXPECT_EQ(rds.negotiator.common, lander.negotiator.common);
+}
+
+TEST(linkSpeedTestSuite, deadSpeedTest) {
+    Sim_side rds, lander;
+    uint32_t now_us;
+    sim_init(&rds, &lander, &now_us, LINK_SPEED_ALL, LINK_SPEED_ALL);
+    rds.loss_per_mille[LINK_SPEED_1000000] = 1000;
+    lander.loss_per_mille[LINK_SPEED_1000000] = 1000;
+
+    link_speed_propose(&rds.negotiator, 0);
+    sim_run(&rds, &lander, &now_us, 200000);
+
+    EXPECT_EQ(LINK_SPEED_115200, rds.negotiator.speed);
+    EXPECT_EQ(LINK_SPEED_115200, lander.negotiator.speed);
+    EXPECT_EQ(1, rds.negotiator.statistics.fallbacks);
+    EXPECT_EQ(1, lander.negotiator.statistics.fallbacks);
+    EXPECT_EQ(0, rds.negotiator.statistics.switches);
+
+    // the link works again at the default speed
+    uint16_t received = lander.data_received;
+    sim_run(&rds, &lander, &now_us, 100000);
+    EXPECT_GE(lander.data_received - received, 45);
+}
+
+TEST(linkSpeedTestSuite, stepDownTest) {
+    Sim_side rds, lander;
+    uint32_t now_us;
+    sim_init(&rds, &lander, &now_us, LINK_SPEED_ALL, LINK_SPEED_ALL);
+
+    link_speed_propose(&rds.negotiator, 0);
+    sim_run(&rds, &lander, &now_us, 100000);
+    ASSERT_EQ(LINK_SPEED_1000000, rds.negotiator.speed);
+
+    // 1M baud gets noisy
+    rds.loss_per_mille[LINK_SPEED_1000000] = 300;
+    lander.loss_per_mille[LINK_SPEED_1000000] = 300;
+    sim_run(&rds, &lander, &now_us, 200000);
+
+    EXPECT_EQ(LINK_SPEED_460800, rds.negotiator.speed);
+    EXPECT_EQ(LINK_SPEED_460800, lander.negotiator.speed);
+    EXPECT_EQ(1, rds.negotiator.statistics.step_downs + lander.negotiator.statistics.step_downs);
+    EXPECT_EQ(0, rds.negotiator.statistics.fallbacks);
+    EXPECT_EQ(0, lander.negotiator.statistics.fallbacks);
+
+    uint16_t received = lander.data_received;
+    sim_run(&rds, &lander, &now_us, 100000);
+    EXPECT_GE(lander.data_received - received, 45);
+}
+
+TEST(linkSpeedTestSuite, notNegotiatingSideTest) {
+    Sim_side rds, lander;
+    uint32_t now_us;
+    sim_init(&rds, &lander, &now_us, LINK_SPEED_ALL, LINK_SPEED_ALL);
+    lander.negotiates = false;
+
+    EXPECT_TRUE(link_speed_propose(&rds.negotiator, 0));
+    EXPECT_EQ(LINK_SPEED_PROPOSED, rds.negotiator.state);
+    // PROPOSE is sent 3 times, 80 ms apart
+    sim_run(&rds, &lander, &now_us, 200000);
+    EXPECT_EQ(LINK_SPEED_PROPOSED, rds.negotiator.state);
+    sim_run(&rds, &lander, &now_us, 100000);
+
+    EXPECT_EQ(LINK_SPEED_115200, rds.negotiator.speed);
+    EXPECT_EQ(LINK_SPEED_IDLE, rds.negotiator.state);
+    EXPECT_EQ(0, rds.negotiator.statistics.fallbacks);
+    EXPECT_EQ(0, rds.negotiator.statistics.switches);
+}
+
+TEST(linkSpeedTestSuite, lossyLineTest) {
+    uint16_t switched = 0;
+
+    for (uint32_t seed = 1; seed <= 50; seed++) {
+        Sim_side rds, lander;
+        uint32_t now_us;
+        sim_init(&rds, &lander, &now_us, LINK_SPEED_ALL, LINK_SPEED_ALL);
+        rds.random = seed;
+        lander.random = seed * 7919u;
+        for (uint8_t i = 0; i < LINK_SPEED_COUNT; i++) {
+            rds.loss_per_mille[i] = 50;
+            lander.loss_per_mille[i] = 50;
+        }
+
+        link_speed_propose(&rds.negotiator, 0);
+        sim_run(&rds, &lander, &now_us, 500000);
+
+        EXPECT_EQ(rds.negotiator.speed, lander.negotiator.speed) << "seed " << seed;
+        EXPECT_EQ(LINK_SPEED_IDLE, rds.negotiator.state) << "seed " << seed;
+        EXPECT_EQ(LINK_SPEED_IDLE, lander.negotiator.state) << "seed " << seed;
+        if (rds.negotiator.speed == LINK_SPEED_1000000) {
+            switched++;
+        }
+    }
+    printf("[   INFO   ] 5 %% frame loss: %u of 50 links negotiated 1M baud\n", switched);
+    EXPECT_GE(switched, 45);
+}
@@ -0,0 +1,265 @@
+/*
+ * message_batch_tests.cpp file
+ *
+ * Testing file for the message batch and its container frames. Multiple tests are executed here to demonstrate that the batch behaves as expected. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Empty batch test: A new batch has nothing to send.
+ * - Single message test: A batch with one message is sent as a normal frame.
+ * - Container test: A batch with several messages is sent as a container that unpacks to the same messages.
+ * - Telemetry merge test: Consecutive binary telemetry messages share one sub-record.
+ * - Mixed merge test: Telemetry messages are only merged when they follow each other.
+ * - Size limit test: A message that does not fit is refused and the container stays within the size limit.
+ * - Broken container test: An incomplete sub-record is not unpacked.
+ * - Statistics test: The batched messages and sent frames are counted.
+ * - ECCS sweep report: Reports the frames and bytes of a full ECCS sweep with and without batching.
+ */
+
+#include "gtest/gtest.h"
+#include "lander_communication.h"
+#include "telemetry_decoder.h"
+#include <lander_communication_lib/message_batch.h>
+#include <lander_communication_lib/telemetry.h>
+#include <cstdio>
+#include <cstring>
+
+static bool add_text(Message_batch *batch, uint8_t msg_type, const char *text) {
+    Payload_segment segment = {(const uint8_t *)text, (uint8_t)strlen(text)};
+    return message_batch_add(batch, msg_type, &segment, 1);
+}
+
+// Builds the Message the lander receives when the batch is sent
+static void batch_to_message(const Message_batch *batch, Message *msg) {
+    Payload_segment segment;
+    msg->start_byte = MSG_START_BYTE;
+    message_batch_frame(batch, &msg->msg_type, &segment);
+    msg->length = segment.length;
+    memcpy(msg->payload, segment.data, segment.length);
+    msg->checksum = calculate_checksum_helper(msg->msg_type, msg->length, msg->payload);
+    msg->end_byte = MSG_END_BYTE;
+}
+
+TEST(messageBatchTestSuite, emptyBatchTest) {
+    Message_batch batch;
+    message_batch_init(&batch);
+
+    EXPECT_TRUE(message_batch_is_empty(&batch));
+    EXPECT_EQ(0, batch.length);
+}
+
+TEST(messageBatchTestSuite, singleMessageTest) {
+    Message_batch batch;
+    message_batch_init(&batch);
+    ASSERT_TRUE(add_text(&batch, MSG_TYPE_DATA, "NEA 1 is ready"));
+    EXPECT_FALSE(message_batch_is_empty(&batch));
+
+    Message msg;
+    batch_to_message(&batch, &msg);
+    EXPECT_EQ(MSG_TYPE_DATA, msg.msg_type);
+    ASSERT_EQ(strlen("NEA 1 is ready"), msg.length);
+    EXPECT_EQ(0, memcmp("NEA 1 is ready", msg.payload, msg.length));
+}
+
+TEST(messageBatchTestSuite, containerTest) {
+    Message_batch batch;
+    message_batch_init(&batch);
+    ASSERT_TRUE(add_text(&batch, MSG_TYPE_DATA, "umbilical cord connected"));
+    ASSERT_TRUE(add_text(&batch, MSG_TYPE_ERROR, "Temperature sensor 1 is broken"));
+    ASSERT_TRUE(add_text(&batch, MSG_TYPE_RESPONSE, ""));
+
+    Message container;
+    batch_to_message(&batch, &container);
+    EXPECT_EQ(MSG_TYPE_CONTAINER, container.msg_type);
+    EXPECT_EQ(3 * MESSAGE_BATCH_RECORD_HEADER_SIZE + 24 + 30, container.length);
+
+    Message msg;
+    uint8_t offset = 0;
+    ASSERT_TRUE(message_container_next(&container, &offset, &msg));
+    EXPECT_EQ(MSG_TYPE_DATA, msg.msg_type);
+    EXPECT_EQ(0, memcmp("umbilical cord connected", msg.payload, msg.length));
+    EXPECT_EQ(calculate_checksum_helper(msg.msg_type, msg.length, msg.payload), msg.checksum);
+    EXPECT_EQ(MSG_START_BYTE, msg.start_byte);
+    EXPECT_EQ(MSG_END_BYTE, msg.end_byte);
+    ASSERT_TRUE(message_container_next(&container, &offset, &msg));
+    EXPECT_EQ(MSG_TYPE_ERROR, msg.msg_type);
+    EXPECT_EQ(0, memcmp("Temperature sensor 1 is broken", msg.payload, msg.length));
+    ASSERT_TRUE(message_container_next(&container, &offset, &msg));
+    EXPECT_EQ(MSG_TYPE_RESPONSE, msg.msg_type);
+    EXPECT_EQ(0, msg.length);
+    EXPECT_FALSE(message_container_next(&container, &offset, &msg));
+}
+
+TEST(messageBatchTestSuite, telemetryMergeTest) {
+    Message_batch batch;
+    message_batch_init(&batch);
+    Telemetry_frame frame;
+
+    telemetry_encode_event(TELEMETRY_BINARY, EVENT_NEA1_READY, &frame);
+    ASSERT_TRUE(message_batch_add(&batch, frame.msg_type, frame.segments, frame.segment_count));
+    telemetry_encode_measurement(TELEMETRY_BINARY, MEASUREMENT_BUS_VOLTAGE, 3300, &frame);
+    ASSERT_TRUE(message_batch_add(&batch, frame.msg_type, frame.segments, frame.segment_count));
+    telemetry_encode_event(TELEMETRY_BINARY, EVENT_NEA2_NOT_READY, &frame);
+    ASSERT_TRUE(message_batch_add(&batch, frame.msg_type, frame.segments, frame.segment_count));
+    EXPECT_EQ(1, batch.records);
+
+    // one telemetry frame with three records, no container needed
+    Message msg;
+    batch_to_message(&batch, &msg);
+    EXPECT_EQ(MSG_TYPE_TELEMETRY, msg.msg_type);
+    EXPECT_EQ(5, msg.length);
+
+    char text[UART_BUFFER_SIZE];
+    EXPECT_EQ(3, telemetry_decode(&msg, text, sizeof(text)));
+    EXPECT_STREQ("NEA 1 is ready\n3.300 is the current bus voltage\nNEA 2 is not ready\n", text);
+}
+
+TEST(messageBatchTestSuite, mixedMergeTest) {
+    Message_batch batch;
+    message_batch_init(&batch);
+    const uint8_t event_1 = EVENT_NEA1_READY;
+    const uint8_t event_2 = EVENT_NEA2_READY;
+    Payload_segment segment_1 = {&event_1, 1};
+    Payload_segment segment_2 = {&event_2, 1};
+
+    ASSERT_TRUE(message_batch_add(&batch, MSG_TYPE_TELEMETRY, &segment_1, 1));
+    ASSERT_TRUE(add_text(&batch, MSG_TYPE_ACK, "ACK"));
+    ASSERT_TRUE(message_batch_add(&batch, MSG_TYPE_TELEMETRY, &segment_2, 1));
+    EXPECT_EQ(3, batch.records);
+
+    Message container, msg;
+    batch_to_message(&batch, &container);
+    uint8_t offset = 0;
+    ASSERT_TRUE(message_container_next(&container, &offset, &msg));
+    EXPECT_EQ(MSG_TYPE_TELEMETRY, msg.msg_type);
+    EXPECT_EQ(EVENT_NEA1_READY, msg.payload[0]);
+    ASSERT_TRUE(message_container_next(&container, &offset, &msg));
+    EXPECT_EQ(MSG_TYPE_ACK, msg.msg_type);
+    ASSERT_TRUE(message_container_next(&container, &offset, &msg));
+    EXPECT_EQ(MSG_TYPE_TELEMETRY, msg.msg_type);
+    EXPECT_EQ(EVENT_NEA2_READY, msg.payload[0]);
+}
+
+TEST(messageBatchTestSuite, sizeLimitTest) {
+    Message_batch batch;
+    message_batch_init(&batch);
+    const char *text = "Power to the rover is switched off";
+
+    uint8_t added = 0;
+    while (add_text(&batch, MSG_TYPE_DATA, text)) {
+        added++;
+    }
+    EXPECT_EQ(MESSAGE_BATCH_SIZE_LIMIT / (MESSAGE_BATCH_RECORD_HEADER_SIZE + strlen(text)), added);
+    EXPECT_LE(batch.length, MESSAGE_BATCH_SIZE_LIMIT);
+
+    // a message that does not fit in an empty batch has to be sent on its own
+    static uint8_t large[MAX_PAYLOAD_SIZE];
+    Payload_segment segment = {large, MESSAGE_BATCH_SIZE_LIMIT};
+    message_batch_clear(&batch);
+    EXPECT_FALSE(message_batch_add(&batch, MSG_TYPE_DATA, &segment, 1));
+    segment.length = MESSAGE_BATCH_SIZE_LIMIT - MESSAGE_BATCH_RECORD_HEADER_SIZE;
+    EXPECT_TRUE(message_batch_add(&batch, MSG_TYPE_DATA, &segment, 1));
+}
+
+TEST(messageBatchTestSuite, brokenContainerTest) {
+    Message container, msg;
+    container.msg_type = MSG_TYPE_CONTAINER;
+    container.payload[0] = MSG_TYPE_DATA;
+    container.payload[1] = 5;
+    container.payload[2] = 'a';
+    container.length = 3;
+    uint8_t offset = 0;
+    EXPECT_FALSE(message_container_next(&container, &offset, &msg));
+
+    container.length = 1;
+    EXPECT_FALSE(message_container_next(&container, &offset, &msg));
+}
+
+TEST(messageBatchTestSuite, statisticsTest) {
+    Message_batch batch;
+    message_batch_init(&batch);
+
+    add_text(&batch, MSG_TYPE_DATA, "a");
+    add_text(&batch, MSG_TYPE_DATA, "b");
+    message_batch_clear(&batch);
+    message_batch_clear(&batch);
+    add_text(&batch, MSG_TYPE_DATA, "c");
+    message_batch_clear(&batch);
+
+    EXPECT_EQ(3, batch.batched_messages);
+    EXPECT_EQ(2, batch.sent_frames);
+}
+
+// Frames and bytes on the wire of a sequence of telemetry messages
+typedef struct {
+    uint16_t frames;
+    uint16_t bytes;
+} Wire_count;
+
+static void count_frame(Wire_count *count, uint8_t msg_type, const Payload_segment *segments, uint8_t segment_count) {
+    SLIP_frame_info info;
+    ASSERT_TRUE(slip_frame_prepare(msg_type, segments, segment_count, FRAME_CHECK_XOR8, &info));
+    count->frames++;
+    count->bytes += info.encoded_length;
+}
+
+// send_batched and flush_message_batch of lander_communication.cpp
+static void count_batched(Message_batch *batch, Wire_count *count, const Telemetry_frame *frame) {
+    if (message_batch_add(batch, frame->msg_type, frame->segments, frame->segment_count)) {
+        return;
+    }
+    uint8_t msg_type;
+    Payload_segment segment;
+    message_batch_frame(batch, &msg_type, &segment);
+    count_frame(count, msg_type, &segment, 1);
+    message_batch_clear(batch);
+    ASSERT_TRUE(message_batch_add(batch, frame->msg_type, frame->segments, frame->segment_count));
+}
+
+// The messages of RDS_electronics_status_check when both temperature sensors work and the NEAs are reported one by one
+static uint8_t eccs_sweep(Telemetry_format format, Telemetry_frame *frames) {
+    uint8_t count = 0;
+    telemetry_encode_event(format, EVENT_UMBILICAL_CONNECTED, &frames[count++]);
+    telemetry_encode_measurement(format, MEASUREMENT_BUS_VOLTAGE, 3281, &frames[count++]);
+    telemetry_encode_measurement(format, MEASUREMENT_TEMP_SENSOR_1, 2150, &frames[count++]);
+    telemetry_encode_measurement(format, MEASUREMENT_TEMP_SENSOR_2, -412, &frames[count++]);
+    telemetry_encode_measurement(format, MEASUREMENT_SUPERCAP_VOLTAGE, 2731, &frames[count++]);
+    telemetry_encode_event(format, EVENT_NEA1_READY, &frames[count++]);
+    telemetry_encode_event(format, EVENT_NEA2_NOT_READY, &frames[count++]);
+    telemetry_encode_event(format, EVENT_NEA3_READY, &frames[count++]);
+    telemetry_encode_event(format, EVENT_NEA4_READY, &frames[count++]);
+    return count;
+}
+
+TEST(messageBatchTestSuite, eccsSweepReport) {
+    const Telemetry_format formats[] = {TELEMETRY_ASCII, TELEMETRY_BINARY};
+    const char *names[] = {"ASCII ", "binary"};
+
+    for (uint8_t f = 0; f < 2; f++) {
+        Telemetry_frame frames[16];
+        uint8_t message_count = eccs_sweep(formats[f], frames);
+
+        Wire_count single = {0, 0};
+        for (uint8_t i = 0; i < message_count; i++) {
+            count_frame(&single, frames[i].msg_type, frames[i].segments, frames[i].segment_count);
+        }
+
+        Wire_count batched = {0, 0};
+        Message_batch batch;
+        message_batch_init(&batch);
+        for (uint8_t i = 0; i < message_count; i++) {
+            count_batched(&batch, &batched, &frames[i]);
+        }
+        uint8_t msg_type;
+        Payload_segment segment;
+        message_batch_frame(&batch, &msg_type, &segment);
+        count_frame(&batched, msg_type, &segment, 1);
+
+        EXPECT_LT(batched.frames, single.frames);
+        EXPECT_LT(batched.bytes, single.bytes);
+        printf("[   INFO   ] ECCS sweep, %s telemetry, %u messages: %u frames / %u bytes one by one, "
+               "%u frames / %u bytes batched (%.1f %% fewer bytes)\n", names[f], message_count, single.frames,
+               single.bytes, batched.frames, batched.bytes, 100.0 * (single.bytes - batched.bytes) / single.bytes);
+    }
+}
@@ -0,0 +1,243 @@
+/*
+ * message_dispatch_tests.cpp file
+ *
+ * Testing file for the message dispatcher. Multiple tests are executed here to demonstrate that the dispatcher behaves as expected. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Type handler test: A message is handed to the handler of its message type.
+ * - Unhandled test: Messages without handler or with a type out of range are counted as unhandled.
+ * - Command test: A command is handed to its own handler.
+ * - Exact command test: "T" does not match "TB" or "TX", those go to the handler of the type.
+ * - Same command other type test: A command only matches for the message type it was registered for.
+ * - Replace handler test: Registering a command again replaces its handler.
+ * - Register limits test: Commands of a wrong size, types out of range, NULL handlers and a full table are refused.
+ * - Dispatch benchmark: Reports the dispatch cost per message type, compared with the former switch and if-chain.
+ */
+
+#include "gtest/gtest.h"
+#include "lander_communication.h"
+#include <lander_communication_lib/message_dispatch.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+// Last handler that was called, and how often handlers were called
+static int last_handler;
+static volatile uint32_t handler_calls;
+
+static void handler_1(const Message *msg) { last_handler = 1; handler_calls++; }
+static void handler_2(const Message *msg) { last_handler = 2; handler_calls++; }
+static void handler_3(const Message *msg) { last_handler = 3; handler_calls++; }
+
+static Message make_message(uint8_t msg_type, const char *payload) {
+    Message msg;
+    msg.start_byte = MSG_START_BYTE;
+    msg.msg_type = msg_type;
+    msg.length = (uint8_t)strlen(payload);
+    memcpy(msg.payload, payload, msg.length);
+    msg.checksum = calculate_checksum_helper(msg.msg_type, msg.length, msg.payload);
+    msg.end_byte = MSG_END_BYTE;
+    return msg;
+}
+
+TEST(messageDispatchTestSuite, typeHandlerTest) {
+    Message_dispatcher dispatcher;
+    message_dispatch_init(&dispatcher, NULL);
+    message_dispatch_register(&dispatcher, MSG_TYPE_INIT, handler_1);
+    message_dispatch_register(&dispatcher, MSG_TYPE_DATA, handler_2);
+
+    Message msg = make_message(MSG_TYPE_DATA, "1234");
+    last_handler = 0;
+    EXPECT_TRUE(message_dispatch(&dispatcher, &msg));
+    EXPECT_EQ(2, last_handler);
+    msg = make_message(MSG_TYPE_INIT, "INIT");
+    EXPECT_TRUE(message_dispatch(&dispatcher, &msg));
+    EXPECT_EQ(1, last_handler);
+    EXPECT_EQ(0, dispatcher.unhandled);
+}
+
+TEST(messageDispatchTestSuite, unhandledTest) {
+    const Message_handler handlers[MESSAGE_DISPATCH_TYPE_COUNT] = {NULL, handler_1};
+    Message_dispatcher dispatcher;
+    message_dispatch_init(&dispatcher, handlers);
+
+    Message msg = make_message(MSG_TYPE_ERROR, "");
+    last_handler = 0;
+    EXPECT_FALSE(message_dispatch(&dispatcher, &msg));
+    msg = make_message(0xF0, "");
+    EXPECT_FALSE(message_dispatch(&dispatcher, &msg));
+    EXPECT_EQ(0, last_handler);
+    EXPECT_EQ(2, dispatcher.unhandled);
+
+    msg = make_message(MSG_TYPE_INIT, "");
+    EXPECT_TRUE(message_dispatch(&dispatcher, &msg));
+    EXPECT_EQ(1, last_handler);
+}
+
+TEST(messageDispatchTestSuite, commandTest) {
+    Message_dispatcher dispatcher;
+    message_dispatch_init(&dispatcher, NULL);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_TRANSIT_MODE, "GS", handler_1);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_TRANSIT_MODE, "T", handler_2);
+
+    Message msg = make_message(MSG_TYPE_TRANSIT_MODE, "GS");
+    EXPECT_TRUE(message_dispatch(&dispatcher, &msg));
+    EXPECT_EQ(1, last_handler);
+    msg = make_message(MSG_TYPE_TRANSIT_MODE, "T");
+    EXPECT_TRUE(message_dispatch(&dispatcher, &msg));
+    EXPECT_EQ(2, last_handler);
+    msg = make_message(MSG_TYPE_TRANSIT_MODE, "G");
+    EXPECT_FALSE(message_dispatch(&dispatcher, &msg));
+}
+
+TEST(messageDispatchTestSuite, exactCommandTest) {
+    Message_dispatcher dispatcher;
+    message_dispatch_init(&dispatcher, NULL);
+    message_dispatch_register(&dispatcher, MSG_TYPE_REQUEST, handler_3);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_REQUEST, "T", handler_1);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_REQUEST, "TA", handler_2);
+
+    const char *other_payloads[] = {"TB", "TX", "TAB", "", "t"};
+    for (const char *payload : other_payloads) {
+        Message msg = make_message(MSG_TYPE_REQUEST, payload);
+        last_handler = 0;
+        EXPECT_TRUE(message_dispatch(&dispatcher, &msg));
+        EXPECT_EQ(3, last_handler) << "payload \"" << payload << "\"";
+    }
+    Message msg = make_message(MSG_TYPE_REQUEST, "TA");
+    message_dispatch(&dispatcher, &msg);
+    EXPECT_EQ(2, last_handler);
+}
+
+TEST(messageDispatchTestSuite, sameCommandOtherTypeTest) {
+    Message_dispatcher dispatcher;
+    message_dispatch_init(&dispatcher, NULL);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_TRANSIT_MODE, "D", handler_1);
+
+    Message msg = make_message(MSG_TYPE_DATA, "D");
+    last_handler = 0;
+    EXPECT_FALSE(message_dispatch(&dispatcher, &msg));
+    EXPECT_EQ(0, last_handler);
+}
+
+TEST(messageDispatchTestSuite, replaceHandlerTest) {
+    Message_dispatcher dispatcher;
+    message_dispatch_init(&dispatcher, NULL);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_TRANSIT_MODE, "PD", handler_1);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_TRANSIT_MODE, "PD", handler_2);
+    EXPECT_EQ(1, dispatcher.command_count);
+
+    Message msg = make_message(MSG_TYPE_TRANSIT_MODE, "PD");
+    message_dispatch(&dispatcher, &msg);
+    EXPECT_EQ(2, last_handler);
+}
+
+TEST(messageDispatchTestSuite, registerLimitsTest) {
+    Message_dispatcher dispatcher;
+    message_dispatch_init(&dispatcher, NULL);
+
+    EXPECT_FALSE(message_dispatch_register(&dispatcher, MESSAGE_DISPATCH_TYPE_COUNT, handler_1));
+    EXPECT_FALSE(message_dispatch_register_command(&dispatcher, MESSAGE_DISPATCH_TYPE_COUNT, "A", handler_1));
+    EXPECT_FALSE(message_dispatch_register_command(&dispatcher, MSG_TYPE_REQUEST, "", handler_1));
+    EXPECT_FALSE(message_dispatch_register_command(&dispatcher, MSG_TYPE_REQUEST, "ABC", handler_1));
+    EXPECT_FALSE(message_dispatch_register_command(&dispatcher, MSG_TYPE_REQUEST, "A", NULL));
+
+    char opcode[2] = {'A', '\0'};
+    for (uint8_t i = 0; i < MESSAGE_DISPATCH_COMMAND_COUNT; i++) {
+        opcode[0] = (char)('A' + i);
+        EXPECT_TRUE(message_dispatch_register_command(&dispatcher, MSG_TYPE_REQUEST, opcode, handler_1));
+    }
+    EXPECT_FALSE(message_dispatch_register_command(&dispatcher, MSG_TYPE_REQUEST, "Z", handler_1));
+    EXPECT_EQ(MESSAGE_DISPATCH_COMMAND_COUNT, dispatcher.command_count);
+}
+
+// The former handle_message: a switch on the message type and an if-chain over the payload
+static void switch_dispatch(const Message *msg) {
+    switch (msg->msg_type) {
+        case MSG_TYPE_INIT:
+            handler_1(msg);
+            break;
+        case MSG_TYPE_ACK:
+            handler_2(msg);
+            break;
+        case MSG_TYPE_REQUEST:
+            if (msg->payload[0] == 'T' && msg->payload[1] == 'A') {
+                handler_1(msg);
+            } else if (msg->payload[0] == 'T' && msg->payload[1] == 'B') {
+                handler_2(msg);
+            } else {}
+            break;
+        case MSG_TYPE_DATA:
+        case MSG_TYPE_RESPONSE:
+            break;
+        case MSG_TYPE_DEPLOY:
+            handler_3(msg);
+            break;
+        case MSG_TYPE_TRANSIT_MODE:
+            if (msg->payload[0] == 'G' && msg->payload[1] == 'S') {
+                handler_1(msg);
+            } else if (msg->payload[0] == 'L' && msg->payload[1] == 'I') {
+                handler_2(msg);
+            } else if (msg->payload[0] == 'T') {
+                handler_3(msg);
+            } else if (msg->payload[0] == 'P' && msg->payload[1] == 'D') {
+                handler_1(msg);
+            } else if (msg->payload[0] == 'D') {
+                handler_2(msg);
+            } else {}
+            break;
+        case MSG_TYPE_ERROR:
+        default:
+            break;
+    }
+}
+
+TEST(messageDispatchTestSuite, dispatchBenchmark) {
+    // the same handlers as lander_dispatch_init
+    const Message_handler handlers[MESSAGE_DISPATCH_TYPE_COUNT] = {NULL, handler_1, handler_2, NULL, NULL, NULL,
+                                                                   NULL, handler_3};
+    Message_dispatcher dispatcher;
+    message_dispatch_init(&dispatcher, handlers);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_REQUEST, "TA", handler_1);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_REQUEST, "TB", handler_2);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_TRANSIT_MODE, "GS", handler_1);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_TRANSIT_MODE, "LI", handler_2);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_TRANSIT_MODE, "T", handler_3);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_TRANSIT_MODE, "PD", handler_1);
+    message_dispatch_register_command(&dispatcher, MSG_TYPE_TRANSIT_MODE, "D", handler_2);
+
+    struct {
+        const char *name;
+        Message msg;
+    } cases[] = {
+        {"INIT           ", make_message(MSG_TYPE_INIT, "INIT")},
+        {"ACK            ", make_message(MSG_TYPE_ACK, "ACK")},
+        {"REQUEST TB     ", make_message(MSG_TYPE_REQUEST, "TB")},
+        {"DATA           ", make_message(MSG_TYPE_DATA, "1234")},
+        {"DEPLOY         ", make_message(MSG_TYPE_DEPLOY, "")},
+        {"TRANSIT_MODE GS", make_message(MSG_TYPE_TRANSIT_MODE, "GS")},
+        {"TRANSIT_MODE D ", make_message(MSG_TYPE_TRANSIT_MODE, "D")},
+        {"ERROR          ", make_message(MSG_TYPE_ERROR, "")},
+    };
+
+    const uint32_t iterations = 200000;
+    for (auto &c : cases) {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            message_dispatch(&dispatcher, &c.msg);
+        }
+        double table_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+        begin = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            switch_dispatch(&c.msg);
+        }
+        double switch_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+        printf("[   INFO   ] %s: table %.1f ns/message, switch %.1f ns/message\n", c.name, table_ns / iterations,
+               switch_ns / iterations);
+    }
+    EXPECT_GT(handler_calls, 0u);
+}
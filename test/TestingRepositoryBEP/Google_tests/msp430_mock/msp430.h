@@ -0,0 +1,121 @@
+/*
+ * msp430.h file (host mock)
+ *
+ * Register level mock of the parts of the MSP430FR5969 that the UART driver uart_communication.cpp uses, such that the
+ * real driver and its interrupt service routine can be compiled and tested on the host. Only the tests of the driver
+ * put this directory on their include path.
+ *
+ * The eUSCI_A1 is modelled like the user's guide describes it:
+ *  - UCTXIFG is set when the transmit buffer is empty, after a reset and whenever UCA1TXBUF moves into the shift
+ *    register. Writing UCA1TXBUF clears it.
+ *  - UCTXCPTIFG is set when the shift register has sent its character and the transmit buffer is empty.
+ *  - UCBUSY is set while a character is sent or received.
+ *  - Reading UCA1IV returns the pending enabled interrupt with the highest priority and clears its flag.
+ *  - An interrupt is taken while GIE is set and the flag and its enable bit are both set.
+ *
+ * Time only passes in msp430_mock_uart_step(), one character time per call. The CPU sleeps through a character time in
+ * low_power_sleep() and reading UCA1STATW while the transmitter is busy takes one. A sleep that no interrupt ends
+ * throws Msp430_mock_deadlock instead of hanging the test.
+ *
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ */
+
+#ifndef MSP430_MOCK_H
+#define MSP430_MOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdexcept>
+
+#define BIT5 0x0020
+#define BIT6 0x0040
+
+// Registers that only hold their value
+extern volatile uint8_t P2SEL0;
+extern volatile uint8_t P2SEL1;
+extern volatile uint16_t PM5CTL0;
+extern volatile uint16_t UCA1CTLW0;
+extern volatile uint8_t UCA1CTL1;
+extern volatile uint8_t UCA1BR0;
+extern volatile uint8_t UCA1BR1;
+extern volatile uint16_t UCA1MCTLW;
+extern volatile uint16_t UCA1IE;
+extern volatile uint16_t UCA1IFG;
+extern volatile uint16_t UCA1RXBUF;
+
+// UCA1TXBUF, writing it clears UCTXIFG
+struct Msp430_mock_txbuf {
+    Msp430_mock_txbuf &operator=(uint16_t character);
+};
+extern Msp430_mock_txbuf UCA1TXBUF;
+
+// UCA1IV, reading it clears the flag of the interrupt it returns
+struct Msp430_mock_iv {
+    operator uint16_t();
+};
+extern Msp430_mock_iv UCA1IV;
+
+// UCA1STATW, a read while the eUSCI is busy is a busy-wait of a character time
+struct Msp430_mock_statw {
+    operator uint16_t();
+};
+extern Msp430_mock_statw UCA1STATW;
+
+#define LOCKLPM5 0x0001
+#define UCSWRST 0x0001
+#define UCSSEL__SMCLK 0x0080
+#define UCBUSY 0x0001
+#define UCRXIE 0x0001
+#define UCTXIE 0x0002
+#define UCRXIFG 0x0001
+#define UCTXIFG 0x0002
+#define UCTXCPTIE 0x0008
+#define UCTXCPTIFG 0x0008
+
+#define USCI_NONE 0x00
+#define USCI_UART_UCRXIFG 0x02
+#define USCI_UART_UCTXIFG 0x04
+#define USCI_UART_UCSTTIFG 0x06
+#define USCI_UART_UCTXCPTIFG 0x08
+
+#define LPM0_bits 0x0010
+#define LPM4_bits 0x00F0
+
+// The vector number is not used, interrupt(USCI_A1_VECTOR) turns into __attribute__((used))
+#define USCI_A1_VECTOR 0
+#define interrupt(vector) used
+
+#define __even_in_range(value, range) (value)
+#define __bic_SR_register_on_exit(bits) ((void)(bits))
+void __disable_interrupt(void);
+void __enable_interrupt(void);
+
+// Thrown by low_power_sleep() when the CPU would never wake up again
+struct Msp430_mock_deadlock : std::runtime_error {
+    Msp430_mock_deadlock() : std::runtime_error("the CPU sleeps and no interrupt can wake it up") {}
+};
+
+/*
+ * Puts the eUSCI_A1 in its state after a reset: transmit buffer empty, nothing on the wire, interrupts disabled.
+ */
+void msp430_mock_reset(void);
+
+/*
+ * Lets one character time pass: the shift register sends its character, the transmit buffer moves into the shift
+ * register, and the pending interrupts are taken.
+ */
+void msp430_mock_uart_step(void);
+
+/*
+ * Lets the other side transmit or stop transmitting. While it transmits, the receiver keeps UCBUSY set; the received
+ * characters themselves are not modelled.
+ */
+void msp430_mock_set_receiving(bool on);
+
+/*
+ * Returns the characters that have left the shift register since msp430_mock_reset(), and how many there are.
+ */
+const uint8_t *msp430_mock_wire(uint16_t *length);
+
+#endif // MSP430_MOCK_H
@@ -0,0 +1,153 @@
+/*
+ * msp430_mock.cpp file
+ *
+ * Register level mock of the eUSCI_A1 of the MSP430FR5969 and of low_power_sleep(), see msp430.h in this directory.
+ *
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ */
+
+#include <msp430.h>
+#include <system_health_lib/low_power.h>
+
+// Sleeps without a single interrupt after which the CPU is considered to sleep forever
+#define MSP430_MOCK_MAX_IDLE_SLEEPS 10000
+
+#define MSP430_MOCK_WIRE_SIZE 4096
+
+volatile uint8_t P2SEL0;
+volatile uint8_t P2SEL1;
+volatile uint16_t PM5CTL0;
+volatile uint16_t UCA1CTLW0;
+volatile uint8_t UCA1CTL1;
+volatile uint8_t UCA1BR0;
+volatile uint8_t UCA1BR1;
+volatile uint16_t UCA1MCTLW;
+volatile uint16_t UCA1IE;
+volatile uint16_t UCA1IFG;
+volatile uint16_t UCA1RXBUF;
+Msp430_mock_txbuf UCA1TXBUF;
+Msp430_mock_iv UCA1IV;
+Msp430_mock_statw UCA1STATW;
+
+// interrupt service routine of uart_communication.cpp
+void USCI_A1_ISR(void);
+
+static bool interrupts_enabled = true;
+static bool transmit_buffer_full = false;
+static uint8_t transmit_buffer;
+static bool shift_register_busy = false;
+static uint8_t shift_register;
+static bool receiving = false;
+static uint8_t wire[MSP430_MOCK_WIRE_SIZE];
+static uint16_t wire_length = 0;
+static uint32_t idle_sleeps = 0;
+
+Msp430_mock_txbuf &Msp430_mock_txbuf::operator=(uint16_t character) {
+    transmit_buffer = (uint8_t)character;
+    transmit_buffer_full = true;
+    UCA1IFG &= ~UCTXIFG;
+    return *this;
+}
+
+Msp430_mock_iv::operator uint16_t() {
+    uint16_t pending = UCA1IE & UCA1IFG;
+    if (pending & UCRXIFG) {
+        UCA1IFG &= ~UCRXIFG;
+        return USCI_UART_UCRXIFG;
+    }
+    if (pending & UCTXIFG) {
+        UCA1IFG &= ~UCTXIFG;
+        return USCI_UART_UCTXIFG;
+    }
+    if (pending & UCTXCPTIFG) {
+        UCA1IFG &= ~UCTXCPTIFG;
+        return USCI_UART_UCTXCPTIFG;
+    }
+    return USCI_NONE;
+}
+
+Msp430_mock_statw::operator uint16_t() {
+    if (!shift_register_busy && !transmit_buffer_full && !receiving) {
+        return 0;
+    }
+    // a busy-wait on a receiver that stays busy never ends
+    if (receiving && ++idle_sleeps > MSP430_MOCK_MAX_IDLE_SLEEPS) {
+        throw Msp430_mock_deadlock();
+    }
+    msp430_mock_uart_step();
+    return UCBUSY;
+}
+
+void __disable_interrupt(void) {
+    interrupts_enabled = false;
+}
+
+void __enable_interrupt(void) {
+    interrupts_enabled = true;
+}
+
+/*
+ * Takes the pending interrupts of the eUSCI_A1, returns whether there was one.
+ */
+static bool take_interrupts(void) {
+    bool taken = false;
+    while (interrupts_enabled && (UCA1IE & UCA1IFG & (UCRXIE | UCTXIE | UCTXCPTIE)) != 0) {
+        USCI_A1_ISR();
+        taken = true;
+    }
+    if (taken) {
+        idle_sleeps = 0;
+    }
+    return taken;
+}
+
+void msp430_mock_reset(void) {
+    UCA1IE = 0;
+    UCA1IFG = UCTXIFG;
+    interrupts_enabled = true;
+    transmit_buffer_full = false;
+    shift_register_busy = false;
+    receiving = false;
+    wire_length = 0;
+    idle_sleeps = 0;
+}
+
+void msp430_mock_uart_step(void) {
+    bool sent = shift_register_busy;
+    if (shift_register_busy) {
+        if (wire_length < MSP430_MOCK_WIRE_SIZE) {
+            wire[wire_length++] = shift_register;
+        }
+        shift_register_busy = false;
+    }
+    if (transmit_buffer_full) {
+        shift_register = transmit_buffer;
+        shift_register_busy = true;
+        transmit_buffer_full = false;
+        UCA1IFG |= UCTXIFG;
+    } else if (sent) {
+        UCA1IFG |= UCTXCPTIFG;
+    }
+    take_interrupts();
+}
+
+void msp430_mock_set_receiving(bool on) {
+    receiving = on;
+}
+
+const uint8_t *msp430_mock_wire(uint16_t *length) {
+    *length = wire_length;
+    return wire;
+}
+
+// Called with interrupts disabled, like the firmware does in LOW_POWER_WAIT_UNTIL. The 1 ms system tick wakes the CPU
+// as well, so the sleep always ends after a character time; it only fails when no interrupt comes for a long time.
+void low_power_sleep(void) {
+    if (++idle_sleeps > MSP430_MOCK_MAX_IDLE_SLEEPS) {
+        throw Msp430_mock_deadlock();
+    }
+    interrupts_enabled = true;
+    msp430_mock_uart_step();
+    interrupts_enabled = false;
+}
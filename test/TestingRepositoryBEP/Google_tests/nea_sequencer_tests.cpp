@@ -0,0 +1,389 @@
+/*
+ * nea_sequencer_tests.cpp file
+ *
+ * Testing file for the polled firing sequence of the NEAs. The NEAs are simulated: a NEA is released when its flag is
+ * high while the supercaps charged long enough, and faults can be injected on the ready pins. Time is simulated in
+ * quarter seconds and the sequence is polled every quarter second, like the deployment task does. Below is a list of
+ * all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Full sequence test: All four NEAs are fired in order, one at a time and only after the supercaps charged. The time
+ *   of every NEA is reported and the charge is switched off at the end.
+ * - Retry test: A NEA that is still ready after firing is charged and fired again, a NEA that is still ready after
+ *   NEA_MAX_ATTEMPTS is given up and the sequence goes on with the next NEA.
+ * - Reported time test: The telemetry value of a NEA that needed 2 or NEA_MAX_ATTEMPTS attempts is its time in whole
+ *   seconds and fits in the int16_t of a measurement.
+ * - Reported result test: The RELEASED or NOT_RELEASED event and the attempts measurement that NEA_readout.cpp
+ *   sends for every NEA, picked like it does from the NEA number, name that NEA and its result.
+ * - Stuck pin test: Ready pins stuck high on all NEAs, every NEA is tried NEA_MAX_ATTEMPTS times.
+ * - Abort test: An abort in every state switches all flags off right away and nothing is fired afterwards.
+ * - Hold test: A held sequence does not fire until it is resumed, a pulse that is firing is finished.
+ * - Abort latency test: Reports the worst time from an abort command to the flags being switched off, compared with
+ *   the former loop that only returned after the whole sequence.
+ */
+
+#include "gtest/gtest.h"
+#include <system_health_lib/nea_sequencer.h>
+#include <lander_communication_lib/telemetry.h>
+#include <lander_communication_lib/payload_messages.h>
+#include <cstdio>
+#include <string>
+
+// Simulated pins
+static bool charge_on;
+static uint16_t charged_quarters;
+static bool fire_flag[NEA_COUNT];
+static bool nea_released[NEA_COUNT];
+
+// Injected faults: the attempt at which a NEA releases, 0 for never, and ready pins stuck high
+static uint8_t release_attempt[NEA_COUNT];
+static uint8_t fired_count[NEA_COUNT];
+static bool ready_stuck_high[NEA_COUNT];
+
+// What the sequencer did
+static int fire_errors;
+static int fired_after_abort;
+static bool aborted;
+static int attempt_reports;
+static int nea_reports;
+static bool reported_released[NEA_COUNT];
+static uint8_t reported_attempts[NEA_COUNT];
+static uint16_t reported_quarters[NEA_COUNT];
+static uint16_t sim_quarters;
+
+static void sim_set_charge(bool on) {
+    if (on && !charge_on) {
+        charged_quarters = 0;
+    }
+    charge_on = on;
+}
+
+static void sim_set_fire(uint8_t nea, bool on) {
+    if (on) {
+        // one NEA at a time, and only with charged supercaps
+        for (int i = 0; i < NEA_COUNT; i++) {
+            if (fire_flag[i]) {
+                fire_errors++;
+            }
+        }
+        if (!charge_on || charged_quarters < NEA_CHARGE_QUARTERS) {
+            fire_errors++;
+        }
+        if (aborted) {
+            fired_after_abort++;
+        }
+        fired_count[nea]++;
+        if (fired_count[nea] == release_attempt[nea]) {
+            nea_released[nea] = true;
+        }
+    }
+    fire_flag[nea] = on;
+}
+
+static bool sim_read_ready(uint8_t nea) {
+    return ready_stuck_high[nea] || !nea_released[nea];
+}
+
+static void sim_report_attempt(uint8_t nea, bool ready) {
+    attempt_reports++;
+}
+
+static void sim_report_nea(uint8_t nea, bool released, uint8_t attempts, uint16_t quarters) {
+    nea_reports++;
+    reported_released[nea] = released;
+    reported_attempts[nea] = attempts;
+    reported_quarters[nea] = quarters;
+}
+
+static const Nea_sequencer_hardware sim_hardware = {sim_set_charge, sim_set_fire, sim_read_ready, sim_report_attempt,
+                                                    sim_report_nea};
+
+static void reset_simulation(void) {
+    charge_on = false;
+    charged_quarters = 0;
+    for (int i = 0; i < NEA_COUNT; i++) {
+        fire_flag[i] = false;
+        nea_released[i] = false;
+        release_attempt[i] = 1;
+        fired_count[i] = 0;
+        ready_stuck_high[i] = false;
+        reported_released[i] = false;
+        reported_attempts[i] = 0;
+        reported_quarters[i] = 0;
+    }
+    fire_errors = 0;
+    fired_after_abort = 0;
+    aborted = false;
+    attempt_reports = 0;
+    nea_reports = 0;
+    sim_quarters = 500;
+}
+
+// Advances the simulation by a quarter second
+static void sim_quarter(void) {
+    sim_quarters++;
+    if (charge_on) {
+        charged_quarters++;
+    }
+}
+
+// A NEA flag that goes low empties the supercaps, they are charged again from 0
+static bool any_fire_flag(void) {
+    for (int i = 0; i < NEA_COUNT; i++) {
+        if (fire_flag[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Polls the sequence every quarter second until it is over or the time limit, returns the duration
+static uint32_t run_sequence(Nea_sequencer *sequencer, uint32_t limit) {
+    uint32_t quarters = 0;
+    bool was_firing = false;
+    while (!nea_sequencer_poll(sequencer, sim_quarters) && quarters < limit) {
+        bool firing = any_fire_flag();
+        if (was_firing && !firing) {
+            charged_quarters = 0;
+        }
+        was_firing = firing;
+        sim_quarter();
+        quarters++;
+    }
+    return quarters;
+}
+
+TEST(neaSequencerTestSuite, fullSequenceTest) {
+    reset_simulation();
+    Nea_sequencer sequencer;
+    nea_sequencer_init(&sequencer, &sim_hardware);
+    EXPECT_EQ(NEA_SEQUENCE_IDLE, sequencer.state);
+    EXPECT_FALSE(nea_sequencer_poll(&sequencer, sim_quarters));
+
+    nea_sequencer_start(&sequencer, sim_quarters);
+    EXPECT_TRUE(charge_on);
+    EXPECT_EQ(NEA_SEQUENCE_CHARGING, sequencer.state);
+    uint32_t quarters = run_sequence(&sequencer, 100000);
+
+    EXPECT_EQ(NEA_SEQUENCE_DONE, sequencer.state);
+    EXPECT_EQ((uint32_t)NEA_COUNT * (NEA_CHARGE_QUARTERS + NEA_FIRE_QUARTERS), quarters);
+    EXPECT_EQ(0, fire_errors);
+    EXPECT_FALSE(charge_on);
+    EXPECT_EQ(NEA_COUNT, nea_reports);
+    EXPECT_EQ(NEA_COUNT, attempt_reports);
+    for (int i = 0; i < NEA_COUNT; i++) {
+        EXPECT_EQ(1, fired_count[i]);
+        EXPECT_FALSE(fire_flag[i]);
+        EXPECT_TRUE(reported_released[i]);
+        EXPECT_TRUE(sequencer.released[i]);
+        EXPECT_EQ(1, reported_attempts[i]);
+        EXPECT_EQ(NEA_CHARGE_QUARTERS + NEA_FIRE_QUARTERS, reported_quarters[i]);
+    }
+}
+
+TEST(neaSequencerTestSuite, retryTest) {
+    reset_simulation();
+    Nea_sequencer sequencer;
+    nea_sequencer_init(&sequencer, &sim_hardware);
+    // NEA 2 releases at its second attempt, NEA 3 never
+    release_attempt[1] = 2;
+    release_attempt[2] = 0;
+    nea_sequencer_start(&sequencer, sim_quarters);
+    run_sequence(&sequencer, 100000);
+
+    EXPECT_EQ(NEA_SEQUENCE_DONE, sequencer.state);
+    EXPECT_EQ(0, fire_errors);
+    EXPECT_EQ(1, fired_count[0]);
+    EXPECT_EQ(2, fired_count[1]);
+    EXPECT_EQ(NEA_MAX_ATTEMPTS, fired_count[2]);
+    // the NEA after the one that was given up is still fired
+    EXPECT_EQ(1, fired_count[3]);
+    EXPECT_TRUE(reported_released[1]);
+    EXPECT_FALSE(reported_released[2]);
+    EXPECT_TRUE(reported_released[3]);
+    EXPECT_EQ(2, reported_attempts[1]);
+    EXPECT_EQ(NEA_MAX_ATTEMPTS, reported_attempts[2]);
+    EXPECT_EQ(2 * (NEA_CHARGE_QUARTERS + NEA_FIRE_QUARTERS), reported_quarters[1]);
+    EXPECT_EQ(1 + 2 + NEA_MAX_ATTEMPTS + 1, attempt_reports);
+}
+
+TEST(neaSequencerTestSuite, reportedTimeTest) {
+    reset_simulation();
+    Nea_sequencer sequencer;
+    nea_sequencer_init(&sequencer, &sim_hardware);
+    release_attempt[1] = 2;
+    release_attempt[2] = 0;
+    nea_sequencer_start(&sequencer, sim_quarters);
+    run_sequence(&sequencer, 100000);
+    ASSERT_EQ(NEA_SEQUENCE_DONE, sequencer.state);
+    ASSERT_EQ(2, reported_attempts[1]);
+    ASSERT_EQ(NEA_MAX_ATTEMPTS, reported_attempts[2]);
+
+    // 721 quarters is 180.25 s, 1442 quarters is 360.5 s and 2163 quarters is 540.75 s
+    EXPECT_EQ(180, nea_sequencer_seconds(reported_quarters[0]));
+    EXPECT_EQ(361, nea_sequencer_seconds(reported_quarters[1]));
+    EXPECT_EQ(541, nea_sequencer_seconds(reported_quarters[2]));
+    // the longest sequence of a NEA still fits
+    EXPECT_GT(nea_sequencer_seconds(NEA_MAX_ATTEMPTS * (NEA_CHARGE_QUARTERS + NEA_FIRE_QUARTERS) + 100), 0);
+
+    // the telemetry shows the time in seconds
+    const Telemetry_measurement_info *info = telemetry_measurement_info(MEASUREMENT_NEA3_SEQUENCE_TIME);
+    ASSERT_NE(nullptr, info);
+    uint8_t text[8];
+    uint8_t length = telemetry_format_value(nea_sequencer_seconds(reported_quarters[2]), info->decimals, text);
+    EXPECT_EQ("541", std::string((const char *)text, length));
+}
+
+TEST(neaSequencerTestSuite, reportedResultTest) {
+    reset_simulation();
+    Nea_sequencer sequencer;
+    nea_sequencer_init(&sequencer, &sim_hardware);
+    release_attempt[1] = 2;
+    release_attempt[2] = 0;
+    nea_sequencer_start(&sequencer, sim_quarters);
+    run_sequence(&sequencer, 100000);
+    ASSERT_EQ(NEA_SEQUENCE_DONE, sequencer.state);
+
+    for (uint8_t nea = 0; nea < NEA_COUNT; nea++) {
+        uint8_t event = (uint8_t)((reported_released[nea] ? EVENT_NEA1_RELEASED : EVENT_NEA1_NOT_RELEASED) + 2 * nea);
+        const Telemetry_event_info *info = telemetry_event_info(event);
+        ASSERT_NE(nullptr, info);
+        char expected[48];
+        snprintf(expected, sizeof(expected), reported_released[nea] ? "NEA %d is released" :
+                 "NEA %d is not released after the last attempt", nea + 1);
+        EXPECT_EQ(std::string(expected), std::string((const char *)payload_message_text((Message_id)info->message),
+                                                     payload_message_length((Message_id)info->message)));
+
+        const Telemetry_measurement_info *attempts =
+            telemetry_measurement_info(MEASUREMENT_NEA1_SEQUENCE_ATTEMPTS + nea);
+        ASSERT_NE(nullptr, attempts);
+        uint8_t text[TELEMETRY_VALUE_TEXT_SIZE];
+        uint8_t length = telemetry_format_value(reported_attempts[nea], attempts->decimals, text);
+        EXPECT_EQ(std::to_string(reported_attempts[nea]), std::string((const char *)text, length));
+    }
+    EXPECT_FALSE(reported_released[2]);
+    EXPECT_EQ(NEA_MAX_ATTEMPTS, reported_attempts[2]);
+}
+
+TEST(neaSequencerTestSuite, stuckPinTest) {
+    reset_simulation();
+    Nea_sequencer sequencer;
+    nea_sequencer_init(&sequencer, &sim_hardware);
+    for (int i = 0; i < NEA_COUNT; i++) {
+        ready_stuck_high[i] = true;
+    }
+    nea_sequencer_start(&sequencer, sim_quarters);
+    uint32_t quarters = run_sequence(&sequencer, 100000);
+
+    EXPECT_EQ(NEA_SEQUENCE_DONE, sequencer.state);
+    EXPECT_EQ((uint32_t)NEA_COUNT * NEA_MAX_ATTEMPTS * (NEA_CHARGE_QUARTERS + NEA_FIRE_QUARTERS), quarters);
+    for (int i = 0; i < NEA_COUNT; i++) {
+        EXPECT_EQ(NEA_MAX_ATTEMPTS, fired_count[i]);
+        EXPECT_FALSE(reported_released[i]);
+    }
+    EXPECT_EQ(0, fire_errors);
+}
+
+TEST(neaSequencerTestSuite, abortTest) {
+    Nea_sequencer sequencer;
+    // abort while charging, while firing and while recharging for a retry
+    const uint32_t abort_at[3] = {100, NEA_CHARGE_QUARTERS, NEA_CHARGE_QUARTERS + NEA_FIRE_QUARTERS + 100};
+    const Nea_sequence_state abort_state[3] = {NEA_SEQUENCE_CHARGING, NEA_SEQUENCE_FIRING, NEA_SEQUENCE_RETRY};
+    for (int i = 0; i < 3; i++) {
+        reset_simulation();
+        release_attempt[0] = 2;
+        nea_sequencer_init(&sequencer, &sim_hardware);
+        nea_sequencer_start(&sequencer, sim_quarters);
+        run_sequence(&sequencer, abort_at[i]);
+        EXPECT_EQ(abort_state[i], sequencer.state);
+
+        EXPECT_TRUE(nea_sequencer_abort(&sequencer));
+        aborted = true;
+        EXPECT_FALSE(charge_on);
+        EXPECT_FALSE(any_fire_flag());
+        EXPECT_EQ(NEA_SEQUENCE_ABORTED, sequencer.state);
+
+        EXPECT_TRUE(nea_sequencer_poll(&sequencer, (uint16_t)(sim_quarters + 10000)));
+        EXPECT_EQ(0, fired_after_abort);
+        EXPECT_FALSE(nea_sequencer_abort(&sequencer));
+    }
+
+    // an idle sequence cannot be aborted
+    nea_sequencer_init(&sequencer, &sim_hardware);
+    EXPECT_FALSE(nea_sequencer_abort(&sequencer));
+}
+
+TEST(neaSequencerTestSuite, holdTest) {
+    reset_simulation();
+    Nea_sequencer sequencer;
+    nea_sequencer_init(&sequencer, &sim_hardware);
+    nea_sequencer_start(&sequencer, sim_quarters);
+    run_sequence(&sequencer, 100);
+    nea_sequencer_hold(&sequencer, true);
+
+    // charged, but not fired while held
+    run_sequence(&sequencer, 2 * NEA_CHARGE_QUARTERS);
+    EXPECT_EQ(NEA_SEQUENCE_CHARGING, sequencer.state);
+    EXPECT_EQ(0, fired_count[0]);
+
+    nea_sequencer_hold(&sequencer, false);
+    EXPECT_FALSE(nea_sequencer_poll(&sequencer, sim_quarters));
+    EXPECT_EQ(NEA_SEQUENCE_FIRING, sequencer.state);
+
+    // a hold while firing finishes the pulse
+    nea_sequencer_hold(&sequencer, true);
+    sim_quarter();
+    nea_sequencer_poll(&sequencer, sim_quarters);
+    EXPECT_FALSE(fire_flag[0]);
+    EXPECT_TRUE(sequencer.released[0]);
+    EXPECT_EQ(NEA_SEQUENCE_CHARGING, sequencer.state);
+    EXPECT_EQ(1, sequencer.nea);
+    EXPECT_EQ(100 + 2 * NEA_CHARGE_QUARTERS + NEA_FIRE_QUARTERS, reported_quarters[0]);
+
+    nea_sequencer_hold(&sequencer, false);
+    run_sequence(&sequencer, 100000);
+    EXPECT_EQ(NEA_SEQUENCE_DONE, sequencer.state);
+    EXPECT_EQ(0, fire_errors);
+}
+
+TEST(neaSequencerTestSuite, abortLatencyTest) {
+    // aborts at pseudo-random moments of the sequence, the lander link task handles a command within a quarter second
+    uint32_t seed = 2024;
+    uint32_t worst_latency = 0;
+    uint32_t former_worst_latency = 0;
+    const uint32_t full_sequence = (uint32_t)NEA_COUNT * (NEA_CHARGE_QUARTERS + NEA_FIRE_QUARTERS);
+    Nea_sequencer sequencer;
+    for (int i = 0; i < 50; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t abort_at = (seed >> 8) % full_sequence;
+
+        reset_simulation();
+        nea_sequencer_init(&sequencer, &sim_hardware);
+        nea_sequencer_start(&sequencer, sim_quarters);
+        run_sequence(&sequencer, abort_at);
+        uint16_t command = sim_quarters;
+        sim_quarter();
+        nea_sequencer_abort(&sequencer);
+        aborted = true;
+        uint32_t latency = (uint16_t)(sim_quarters - command);
+        if (latency > worst_latency) {
+            worst_latency = latency;
+        }
+        EXPECT_FALSE(any_fire_flag());
+        EXPECT_FALSE(charge_on);
+        run_sequence(&sequencer, full_sequence);
+        EXPECT_EQ(0, fired_after_abort);
+
+        // the former loop handled the command, but only returned after the whole sequence
+        uint32_t former_latency = full_sequence - abort_at;
+        if (former_latency > former_worst_latency) {
+            former_worst_latency = former_latency;
+        }
+    }
+
+    printf("[   INFO   ] worst abort latency: former loop %.2f s, sequencer %.2f s\n", former_worst_latency / 4.0,
+           worst_latency / 4.0);
+    EXPECT_LE(worst_latency, 1u);
+}
@@ -0,0 +1,82 @@
+/*
+ * payload_messages_tests.cpp file
+ *
+ * Testing file for the payload message catalog. Multiple tests are executed here to demonstrate that the catalog behaves as expected. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Compile time length test: The length of a message is known at compile time.
+ * - Catalog test: Every message has its text and length, the texts are stored back to back.
+ * - Checksum test: The compile-time checksum equals the XOR checksum over the frame.
+ * - Unknown ID test: An ID outside the catalog gives the empty message.
+ * - Single definition test: Telemetry frames point to the same copy of a message as the message catalog.
+ * - Catalog size report: Reports the FRAM used by the catalog.
+ */
+
+#include "gtest/gtest.h"
+#include "lander_communication.h"
+#include <lander_communication_lib/payload_messages.h>
+#include <lander_communication_lib/telemetry.h>
+#include <cstdio>
+#include <cstring>
+
+static_assert(PAYLOAD_LENGTH(ACK) == 3, "the length of a message is known at compile time");
+static_assert(PAYLOAD_LENGTH(EMPTY) == 0, "the empty message has no characters");
+
+TEST(payloadMessagesTestSuite, compileTimeLengthTest) {
+    uint8_t buffer[PAYLOAD_LENGTH(TEMP_SENSOR_1)];
+    EXPECT_EQ(strlen(" is the current temperature of sensor 1"), sizeof(buffer));
+    EXPECT_EQ(4, PAYLOAD_LENGTH(INIT));
+}
+
+TEST(payloadMessagesTestSuite, catalogTest) {
+    EXPECT_EQ(0, memcmp("INIT", payload_message_text(MSG_ID_INIT), PAYLOAD_LENGTH(INIT)));
+    EXPECT_EQ(0, memcmp("TM", payload_message_text(MSG_ID_TRANSIT_MODE), PAYLOAD_LENGTH(TRANSIT_MODE)));
+    EXPECT_EQ(0, memcmp("INVALID_CHECKSUM", payload_message_text(MSG_ID_INVALID_CHECKSUM), 16));
+    EXPECT_EQ(16, payload_message_length(MSG_ID_INVALID_CHECKSUM));
+
+    // the texts are stored back to back in the order of their IDs
+    for (uint8_t id = 0; id + 1 < MSG_ID_END; id++) {
+        EXPECT_EQ(payload_message_text((Message_id)(id + 1)),
+                  payload_message_text((Message_id)id) + payload_message_length((Message_id)id));
+    }
+}
+
+TEST(payloadMessagesTestSuite, checksumTest) {
+    EXPECT_EQ(calculate_checksum_helper(MSG_TYPE_ACK, 3, (const uint8_t *)"ACK"), PAYLOAD_CHECKSUM(MSG_TYPE_ACK, ACK));
+    EXPECT_EQ(calculate_checksum_helper(MSG_TYPE_INIT, 4, (const uint8_t *)"INIT"),
+              PAYLOAD_CHECKSUM(MSG_TYPE_INIT, INIT));
+    EXPECT_EQ(calculate_checksum_helper(MSG_TYPE_ERROR, 0, (const uint8_t *)""), PAYLOAD_CHECKSUM(MSG_TYPE_ERROR, EMPTY));
+
+    const uint8_t msg_type = MSG_TYPE_RELIABLE | MSG_TYPE_DATA;
+    uint8_t checksum = PAYLOAD_CHECKSUM(msg_type, SUPERCAP3_NOT_READY);
+    EXPECT_EQ(calculate_checksum_helper(msg_type, PAYLOAD_LENGTH(SUPERCAP3_NOT_READY),
+                                        payload_message_text(MSG_ID_SUPERCAP3_NOT_READY)), checksum);
+}
+
+TEST(payloadMessagesTestSuite, unknownIdTest) {
+    EXPECT_EQ(payload_message_text(MSG_ID_EMPTY), payload_message_text(MSG_ID_END));
+    EXPECT_EQ(payload_message_text(MSG_ID_EMPTY), payload_message_text((Message_id)200));
+    EXPECT_EQ(0, payload_message_length(MSG_ID_END));
+}
+
+TEST(payloadMessagesTestSuite, singleDefinitionTest) {
+    Telemetry_frame frame;
+    telemetry_encode_event(TELEMETRY_ASCII, EVENT_NEA1_READY, &frame);
+    EXPECT_EQ(payload_message_text(MSG_ID_NEA1_READY), frame.segments[0].data);
+    EXPECT_EQ(PAYLOAD_LENGTH(NEA1_READY), frame.segments[0].length);
+
+    telemetry_encode_measurement(TELEMETRY_ASCII, MEASUREMENT_BUS_VOLTAGE, 3300, &frame);
+    EXPECT_EQ(payload_message_text(MSG_ID_BUS_VOLTAGE), frame.segments[1].data);
+}
+
+TEST(payloadMessagesTestSuite, catalogSizeReport) {
+    uint16_t characters = payload_message_text(MSG_ID_EMPTY) - payload_message_text(MSG_ID_INIT);
+    // one null terminator after the last text and a 16-bit offset for every message and the end
+    uint16_t text_bytes = characters + 1;
+    uint16_t table_bytes = (MSG_ID_END + 1) * sizeof(uint16_t);
+
+    printf("[   INFO   ] %u messages: %u bytes of text and %u bytes of offsets, %u bytes in total\n",
+           (unsigned)MSG_ID_END, text_bytes, table_bytes, text_bytes + table_bytes);
+}
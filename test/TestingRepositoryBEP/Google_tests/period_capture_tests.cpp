@@ -0,0 +1,193 @@
+/*
+ * period_capture_tests.cpp file
+ *
+ * Testing file for the period measurement of the temperature sensors. The capture timer is simulated: Timer_B0 counts
+ * at 4 MHz and wraps around after 16 bits, every oscillator has a rising edge at its phase and every period after it.
+ * The edges of both sensors are handed to their measurement in the order of time, as the capture interrupts do. Below
+ * is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Edge test: The first edge starts the first period, the measurement is done after PERIOD_CAPTURE_COUNT periods and
+ *   later edges are ignored.
+ * - Wrap test: A period over the wrap around of the timer is measured correctly.
+ * - Median test: The median ignores outliers, periods that were not captured count as PERIOD_CAPTURE_MISSING.
+ * - Concurrent test: Both sensors are measured at the same time, the acquisition takes the time of the slowest sensor
+ *   instead of the time of both. Reports the time compared with the former readout one sensor after the other.
+ * - Dead sensor test: A sensor without edges ends the acquisition at the timeout, the other sensor is still measured.
+ */
+
+#include "gtest/gtest.h"
+#include <system_health_lib/period_capture.h>
+#include <cmath>
+#include <cstdio>
+
+// Timer_B0 ticks per ms, SMCLK / 4
+#define SIM_TICKS_PER_MS 4000
+// Timeout of an acquisition, TEMPERATURE_ACQUISITION_TIMEOUT_MS
+#define SIM_TIMEOUT_MS 70
+// Timeout of a single period of the former readout
+#define SIM_FORMER_TIMEOUT_MS 16
+
+// Simulated oscillator, a period of 0 is a dead sensor
+typedef struct {
+    double period;      // timer ticks
+    double phase;       // ticks to the first edge
+} Sim_oscillator;
+
+// First edge of an oscillator after a time in ticks, or a time beyond every timeout for a dead sensor
+static double sim_next_edge(const Sim_oscillator *oscillator, double after) {
+    if (oscillator->period == 0) {
+        return 1e12;
+    }
+    if (after < oscillator->phase) {
+        return oscillator->phase;
+    }
+    // an edge at the time itself is not after it, also with the rounding of the division
+    double k = std::floor((after - oscillator->phase) / oscillator->period + 1e-9) + 1;
+    return oscillator->phase + k * oscillator->period;
+}
+
+// Acquisition of both sensors at once from a start time, returns the time in ms it took
+static double sim_acquisition(const Sim_oscillator *oscillators, Period_capture *captures, double start) {
+    double next[2];
+    double timeout = start + SIM_TIMEOUT_MS * SIM_TICKS_PER_MS;
+    for (int sensor = 0; sensor < 2; sensor++) {
+        period_capture_start(&captures[sensor]);
+        next[sensor] = sim_next_edge(&oscillators[sensor], start);
+    }
+    double now = start;
+    while (!(period_capture_done(&captures[0]) && period_capture_done(&captures[1]))) {
+        int sensor = (!period_capture_done(&captures[0]) &&
+                      (period_capture_done(&captures[1]) || next[0] <= next[1])) ? 0 : 1;
+        if (next[sensor] > timeout) {
+            return (timeout - start) / SIM_TICKS_PER_MS;
+        }
+        now = next[sensor];
+        period_capture_edge(&captures[sensor], (uint16_t)(uint32_t)std::llround(now));
+        next[sensor] = sim_next_edge(&oscillators[sensor], now);
+    }
+    return (now - start) / SIM_TICKS_PER_MS;
+}
+
+// The former readout of one sensor: every period waits for a first and a second edge, or the timeout of 16 ms
+static double sim_former_readout(const Sim_oscillator *oscillator, double start) {
+    double now = start;
+    for (int run = 0; run < PERIOD_CAPTURE_COUNT; run++) {
+        double timeout = now + SIM_FORMER_TIMEOUT_MS * SIM_TICKS_PER_MS;
+        double first = sim_next_edge(oscillator, now);
+        double second = sim_next_edge(oscillator, first);
+        now = second > timeout ? timeout : second;
+    }
+    return (now - start) / SIM_TICKS_PER_MS;
+}
+
+TEST(periodCaptureTestSuite, edgeTest) {
+    Period_capture capture;
+    period_capture_start(&capture);
+    EXPECT_FALSE(period_capture_edge(&capture, 1000));
+    EXPECT_EQ(0, capture.count);
+    for (int edge = 1; edge < PERIOD_CAPTURE_COUNT; edge++) {
+        EXPECT_FALSE(period_capture_edge(&capture, (uint16_t)(1000 + edge * 5000)));
+    }
+    EXPECT_FALSE(period_capture_done(&capture));
+    EXPECT_TRUE(period_capture_edge(&capture, (uint16_t)(1000 + PERIOD_CAPTURE_COUNT * 5000)));
+    EXPECT_TRUE(period_capture_done(&capture));
+    for (int i = 0; i < PERIOD_CAPTURE_COUNT; i++) {
+        EXPECT_EQ(5000, capture.periods[i]);
+    }
+
+    // later edges do not change the periods
+    EXPECT_TRUE(period_capture_edge(&capture, 100));
+    EXPECT_EQ(PERIOD_CAPTURE_COUNT, capture.count);
+    EXPECT_EQ(5000, period_capture_median(&capture));
+
+    // a new measurement starts over
+    period_capture_start(&capture);
+    EXPECT_FALSE(period_capture_done(&capture));
+    EXPECT_FALSE(period_capture_edge(&capture, 7));
+    EXPECT_FALSE(period_capture_edge(&capture, 17));
+    EXPECT_EQ(10, capture.periods[0]);
+}
+
+TEST(periodCaptureTestSuite, wrapTest) {
+    Period_capture capture;
+    period_capture_start(&capture);
+    period_capture_edge(&capture, 60000);
+    period_capture_edge(&capture, 4000);
+    EXPECT_EQ(9536, capture.periods[0]);
+}
+
+TEST(periodCaptureTestSuite, medianTest) {
+    Period_capture capture;
+    const uint16_t periods[PERIOD_CAPTURE_COUNT] = {5003, 60000, 4998, 5001, 2, 5000, 4999, 5002, 30000};
+    period_capture_start(&capture);
+    uint16_t edge = 0;
+    period_capture_edge(&capture, edge);
+    for (int i = 0; i < PERIOD_CAPTURE_COUNT; i++) {
+        edge = (uint16_t)(edge + periods[i]);
+        period_capture_edge(&capture, edge);
+    }
+    EXPECT_EQ(5001, period_capture_median(&capture));
+
+    // 5 of 9 periods still give a period of the sensor, 4 do not
+    period_capture_start(&capture);
+    edge = 0;
+    period_capture_edge(&capture, edge);
+    for (int i = 0; i < 5; i++) {
+        edge = (uint16_t)(edge + 5000 + i);
+        period_capture_edge(&capture, edge);
+    }
+    EXPECT_EQ(5000, period_capture_median(&capture));
+    capture.count = 4;
+    EXPECT_EQ(PERIOD_CAPTURE_MISSING, period_capture_median(&capture));
+}
+
+TEST(periodCaptureTestSuite, concurrentTest) {
+    // 200 Hz and 700 Hz at 4 MHz
+    const Sim_oscillator oscillators[2] = {{20000, 1234}, {4000000.0 / 700, 3001}};
+    Period_capture captures[2];
+    double start = 65000;
+    double acquisition_ms = sim_acquisition(oscillators, captures, start);
+
+    ASSERT_TRUE(period_capture_done(&captures[0]));
+    ASSERT_TRUE(period_capture_done(&captures[1]));
+    EXPECT_EQ(20000, period_capture_median(&captures[0]));
+    EXPECT_NEAR(4000000.0 / 700, period_capture_median(&captures[1]), 1);
+
+    // at most one period to the first edge and the periods of the slowest sensor
+    double slowest_ms = 20000.0 / SIM_TICKS_PER_MS;
+    EXPECT_LE(acquisition_ms, (PERIOD_CAPTURE_COUNT + 1) * slowest_ms);
+    EXPECT_LE(acquisition_ms, SIM_TIMEOUT_MS);
+
+    double former_ms = sim_former_readout(&oscillators[0], start);
+    former_ms += sim_former_readout(&oscillators[1], start + former_ms * SIM_TICKS_PER_MS);
+    printf("[   INFO   ] 200 Hz and 700 Hz sensors: former %.1f ms one after the other, concurrent %.1f ms\n",
+           former_ms, acquisition_ms);
+    EXPECT_LT(acquisition_ms, former_ms);
+
+    // both at the lowest valid frequency still fit in the timeout
+    const Sim_oscillator slow[2] = {{4000000.0 / 150, 26000}, {4000000.0 / 150, 100}};
+    acquisition_ms = sim_acquisition(slow, captures, 0);
+    EXPECT_TRUE(period_capture_done(&captures[0]));
+    EXPECT_TRUE(period_capture_done(&captures[1]));
+    EXPECT_LT(acquisition_ms, SIM_TIMEOUT_MS);
+}
+
+TEST(periodCaptureTestSuite, deadSensorTest) {
+    const Sim_oscillator oscillators[2] = {{10000, 500}, {0, 0}};
+    Period_capture captures[2];
+    double acquisition_ms = sim_acquisition(oscillators, captures, 0);
+
+    EXPECT_DOUBLE_EQ(SIM_TIMEOUT_MS, acquisition_ms);
+    EXPECT_TRUE(period_capture_done(&captures[0]));
+    EXPECT_EQ(10000, period_capture_median(&captures[0]));
+    EXPECT_FALSE(period_capture_done(&captures[1]));
+    EXPECT_EQ(PERIOD_CAPTURE_MISSING, period_capture_median(&captures[1]));
+
+    double former_ms = sim_former_readout(&oscillators[0], 0);
+    former_ms += sim_former_readout(&oscillators[1], former_ms * SIM_TICKS_PER_MS);
+    printf("[   INFO   ] one dead sensor: former %.1f ms, concurrent %.1f ms\n", former_ms, acquisition_ms);
+    EXPECT_LT(acquisition_ms, former_ms);
+}
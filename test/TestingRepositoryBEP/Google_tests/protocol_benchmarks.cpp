@@ -0,0 +1,374 @@
+/*
+ * protocol_benchmarks.cpp file
+ *
+ * Microbenchmarks of the hot paths of the lander protocol: slip_encode, slip_decode, convert_message_to_array,
+ * convert_array_to_message, calculate_checksum_helper and the firmware frame writer and stream decoder. Every function
+ * runs over three payload mixes:
+ *  - ascii:  the status messages of the payload message catalog,
+ *  - escape: 64 byte binary payloads in which a quarter of the bytes are SLIP END or ESC characters,
+ *  - max:    binary payloads of MAX_PAYLOAD_SIZE bytes without SLIP characters.
+ *
+ * For every function and mix the time per payload byte and the frames per second are reported. The results are
+ * written to a JSON file and compared against a baseline of an earlier run:
+ *
+ *   Benchmarks_run [--baseline FILE] [--update-baseline] [--output FILE] [--threshold PERCENT] [--smoke]
+ *
+ *  --baseline FILE     baseline to compare against, default benchmark_baseline.json. It is written when it does not
+ *                      exist yet.
+ *  --update-baseline   overwrite the baseline with the results of this run
+ *  --output FILE       also write the results of this run to FILE
+ *  --threshold PERCENT slowdown that counts as a regression, default 10
+ *  --smoke             run every benchmark once without timing it properly, used by ctest
+ *
+ * The program exits with 1 when a benchmark is slower than the baseline by more than the threshold. Baselines are only
+ * comparable on the same machine and build type.
+ *
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ */
+
+#include "lander_communication.h"
+#include <lander_communication_lib/payload_messages.h>
+#include <lander_communication_lib/slip_frame_writer.h>
+#include <lander_communication_lib/slip_stream_decoder.h>
+#include <lander_communication_lib/uart_tx_queue.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define MIX_FRAME_COUNT 48
+#define MIX_COUNT 3
+#define BENCHMARK_REPEATS 5
+#define BENCHMARK_NAME_SIZE 64
+
+// Frames of one payload mix, in every form the benchmarked functions take or produce
+typedef struct {
+    const char *name;
+    uint8_t frame_count;
+    uint32_t payload_bytes;     // payload bytes of all frames together
+    Message messages[MIX_FRAME_COUNT];
+    uint8_t serialized[MIX_FRAME_COUNT][UART_BUFFER_SIZE];
+    uint8_t serialized_length[MIX_FRAME_COUNT];
+    uint8_t encoded[MIX_FRAME_COUNT][UART_BUFFER_SIZE];
+    uint16_t encoded_length[MIX_FRAME_COUNT];
+} Payload_mix;
+
+typedef struct {
+    char name[BENCHMARK_NAME_SIZE];
+    double ns_per_byte;
+    double frames_per_s;
+} Benchmark_result;
+
+// Sink for the results of the benchmarked functions, such that the compiler cannot remove the calls
+static volatile uint32_t benchmark_sink;
+
+static uint32_t random_state = 0x2545F491;
+
+// xorshift32, the mixes are the same on every run
+static uint8_t random_byte(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return (uint8_t)random_state;
+}
+
+static uint8_t random_plain_byte(void) {
+    uint8_t byte;
+    do {
+        byte = random_byte();
+    } while (byte == SLIP_END || byte == SLIP_ESC);
+    return byte;
+}
+
+static bool is_slip_character(uint8_t byte) {
+    return byte == SLIP_END || byte == SLIP_ESC;
+}
+
+static void add_frame(Payload_mix *mix, uint8_t msg_type, const uint8_t *payload, uint8_t length) {
+    Message *msg = &mix->messages[mix->frame_count];
+    msg->start_byte = MSG_START_BYTE;
+    msg->msg_type = msg_type;
+    msg->length = length;
+    memcpy(msg->payload, payload, length);
+    msg->checksum = calculate_checksum_helper(msg_type, length, msg->payload);
+    msg->end_byte = MSG_END_BYTE;
+
+    convert_message_to_array(msg, mix->serialized[mix->frame_count], &mix->serialized_length[mix->frame_count]);
+    if (!slip_encode(mix->serialized[mix->frame_count], mix->serialized_length[mix->frame_count],
+                     mix->encoded[mix->frame_count], &mix->encoded_length[mix->frame_count])) {
+        fprintf(stderr, "frame %u of mix %s does not fit in the UART buffer\n", mix->frame_count, mix->name);
+        exit(2);
+    }
+    mix->payload_bytes += length;
+    mix->frame_count++;
+}
+
+static void build_mixes(Payload_mix *mixes) {
+    uint8_t payload[MAX_PAYLOAD_SIZE];
+
+    mixes[0].name = "ascii";
+    for (uint8_t id = 0; id < MSG_ID_END && mixes[0].frame_count < MIX_FRAME_COUNT; id++) {
+        add_frame(&mixes[0], MSG_TYPE_DATA, payload_message_text((Message_id)id), payload_message_length((Message_id)id));
+    }
+
+    mixes[1].name = "escape";
+    for (uint8_t f = 0; f < 32; f++) {
+        for (uint8_t i = 0; i < 64; i++) {
+            uint8_t r = random_byte();
+            payload[i] = (r < 32) ? SLIP_END : (r < 64) ? SLIP_ESC : random_byte();
+        }
+        add_frame(&mixes[1], MSG_TYPE_TELEMETRY, payload, 64);
+    }
+
+    mixes[2].name = "max";
+    for (uint8_t f = 0; f < 16; f++) {
+        for (uint8_t i = 0; i < MAX_PAYLOAD_SIZE; i++) {
+            payload[i] = random_plain_byte();
+        }
+        // an escaped checksum would make the frame one byte too large for the UART buffer
+        while (is_slip_character((uint8_t)calculate_checksum_helper(MSG_TYPE_DATA, MAX_PAYLOAD_SIZE, payload))) {
+            payload[0] = random_plain_byte();
+        }
+        add_frame(&mixes[2], MSG_TYPE_DATA, payload, MAX_PAYLOAD_SIZE);
+    }
+}
+
+/* One pass over all frames of a mix for every benchmarked function */
+
+static void pass_slip_encode(const Payload_mix *mix) {
+    uint8_t output[UART_BUFFER_SIZE];
+    uint16_t length = 0;
+    for (uint8_t f = 0; f < mix->frame_count; f++) {
+        slip_encode(mix->serialized[f], mix->serialized_length[f], output, &length);
+        benchmark_sink += length;
+    }
+}
+
+static void pass_slip_decode(const Payload_mix *mix) {
+    uint8_t output[UART_BUFFER_SIZE];
+    uint16_t length = 0;
+    for (uint8_t f = 0; f < mix->frame_count; f++) {
+        slip_decode(mix->encoded[f], mix->encoded_length[f], output, &length);
+        benchmark_sink += length;
+    }
+}
+
+static void pass_convert_message_to_array(const Payload_mix *mix) {
+    uint8_t output[UART_BUFFER_SIZE];
+    uint8_t length = 0;
+    for (uint8_t f = 0; f < mix->frame_count; f++) {
+        convert_message_to_array(&mix->messages[f], output, &length);
+        benchmark_sink += length;
+    }
+}
+
+static void pass_convert_array_to_message(const Payload_mix *mix) {
+    static Message msg;
+    for (uint8_t f = 0; f < mix->frame_count; f++) {
+        convert_array_to_message(mix->serialized[f], mix->serialized_length[f], &msg);
+        benchmark_sink += msg.length;
+    }
+}
+
+static void pass_calculate_checksum(const Payload_mix *mix) {
+    for (uint8_t f = 0; f < mix->frame_count; f++) {
+        const Message *msg = &mix->messages[f];
+        benchmark_sink += calculate_checksum_helper(msg->msg_type, msg->length, msg->payload);
+    }
+}
+
+static void pass_slip_frame_write(const Payload_mix *mix) {
+    static UART_TX_queue queue;
+    for (uint8_t f = 0; f < mix->frame_count; f++) {
+        const Message *msg = &mix->messages[f];
+        Payload_segment segment = {msg->payload, msg->length};
+        SLIP_frame_info info;
+        uart_tx_queue_init(&queue);
+        slip_frame_prepare(msg->msg_type, &segment, 1, FRAME_CHECK_XOR8, &info);
+        slip_frame_write(&queue, &info, &segment, 1);
+        benchmark_sink += queue.head;
+    }
+}
+
+static void pass_slip_stream_decode(const Payload_mix *mix) {
+    static uint8_t ring[512];
+    static SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, sizeof(ring), FRAME_CHECK_XOR8);
+    for (uint8_t f = 0; f < mix->frame_count; f++) {
+        for (uint16_t i = 0; i < mix->encoded_length[f]; i++) {
+            if (slip_stream_decode_byte(&decoder, mix->encoded[f][i]) == SLIP_STREAM_FRAME_READY) {
+                benchmark_sink += decoder.last_frame.length;
+                slip_stream_release(&decoder, &decoder.last_frame);
+            }
+        }
+    }
+}
+
+typedef void (*Benchmark_pass)(const Payload_mix *mix);
+
+static const struct {
+    const char *name;
+    Benchmark_pass pass;
+} benchmarks[] = {
+    {"slip_encode", pass_slip_encode},
+    {"slip_decode", pass_slip_decode},
+    {"convert_message_to_array", pass_convert_message_to_array},
+    {"convert_array_to_message", pass_convert_array_to_message},
+    {"calculate_checksum_helper", pass_calculate_checksum},
+    {"slip_frame_write", pass_slip_frame_write},
+    {"slip_stream_decode", pass_slip_stream_decode},
+};
+
+#define BENCHMARK_COUNT (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+/*
+ * Runs passes until the minimum time has passed, and keeps the fastest of BENCHMARK_REPEATS tries.
+ */
+static void run_benchmark(Benchmark_pass pass, const Payload_mix *mix, double minimum_ns, Benchmark_result *result) {
+    double best_ns_per_pass = 0;
+    for (uint8_t repeat = 0; repeat < BENCHMARK_REPEATS; repeat++) {
+        uint32_t passes = 0;
+        double elapsed_ns = 0;
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        do {
+            pass(mix);
+            passes++;
+            elapsed_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+        } while (elapsed_ns < minimum_ns);
+
+        double ns_per_pass = elapsed_ns / passes;
+        if (repeat == 0 || ns_per_pass < best_ns_per_pass) {
+            best_ns_per_pass = ns_per_pass;
+        }
+    }
+    result->ns_per_byte = best_ns_per_pass / mix->payload_bytes;
+    result->frames_per_s = mix->frame_count * 1e9 / best_ns_per_pass;
+}
+
+static bool write_results(const char *path, const Benchmark_result *results, uint8_t count) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        return false;
+    }
+    fprintf(file, "{\n  \"version\": 1,\n  \"results\": {\n");
+    for (uint8_t i = 0; i < count; i++) {
+        fprintf(file, "    \"%s\": {\"ns_per_byte\": %.4f, \"frames_per_s\": %.0f}%s\n", results[i].name,
+                results[i].ns_per_byte, results[i].frames_per_s, (i + 1 < count) ? "," : "");
+    }
+    fprintf(file, "  }\n}\n");
+    fclose(file);
+    return true;
+}
+
+/*
+ * Reads the whole baseline file, NULL if it does not exist.
+ */
+static char *read_file(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *text = (char *)malloc((size_t)size + 1);
+    size_t read = fread(text, 1, (size_t)size, file);
+    text[read] = '\0';
+    fclose(file);
+    return text;
+}
+
+/*
+ * Finds the ns/byte of a benchmark in a baseline written by write_results, false if it is not in there.
+ */
+static bool baseline_ns_per_byte(const char *baseline, const char *name, double *ns_per_byte) {
+    char key[BENCHMARK_NAME_SIZE + 32];
+    snprintf(key, sizeof(key), "\"%s\": {\"ns_per_byte\": ", name);
+    const char *entry = strstr(baseline, key);
+    if (entry == NULL) {
+        return false;
+    }
+    *ns_per_byte = strtod(entry + strlen(key), NULL);
+    return *ns_per_byte > 0;
+}
+
+int main(int argc, char **argv) {
+    const char *baseline_path = "benchmark_baseline.json";
+    const char *output_path = NULL;
+    bool update_baseline = false;
+    bool smoke = false;
+    double threshold = 10;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--update-baseline") == 0) {
+            update_baseline = true;
+        } else if (strcmp(argv[i], "--smoke") == 0) {
+            smoke = true;
+        } else {
+            fprintf(stderr, "unknown argument %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    static Payload_mix mixes[MIX_COUNT];
+    build_mixes(mixes);
+
+    static Benchmark_result results[BENCHMARK_COUNT * MIX_COUNT];
+    uint8_t result_count = 0;
+    const double minimum_ns = smoke ? 0 : 20e6;
+
+    printf("%-40s %12s %14s\n", "benchmark", "ns/byte", "frames/s");
+    for (uint8_t b = 0; b < BENCHMARK_COUNT; b++) {
+        for (uint8_t m = 0; m < MIX_COUNT; m++) {
+            Benchmark_result *result = &results[result_count++];
+            snprintf(result->name, sizeof(result->name), "%s/%s", benchmarks[b].name, mixes[m].name);
+            run_benchmark(benchmarks[b].pass, &mixes[m], minimum_ns, result);
+            printf("%-40s %12.3f %14.0f\n", result->name, result->ns_per_byte, result->frames_per_s);
+        }
+    }
+
+    if (smoke) {
+        return 0;
+    }
+    if (output_path != NULL && !write_results(output_path, results, result_count)) {
+        fprintf(stderr, "cannot write %s\n", output_path);
+        return 2;
+    }
+
+    char *baseline = read_file(baseline_path);
+    if (baseline == NULL || update_baseline) {
+        free(baseline);
+        if (!write_results(baseline_path, results, result_count)) {
+            fprintf(stderr, "cannot write %s\n", baseline_path);
+            return 2;
+        }
+        printf("baseline written to %s\n", baseline_path);
+        return 0;
+    }
+
+    uint8_t regressions = 0;
+    printf("\n%-40s %12s %12s %9s\n", "compared with baseline", "baseline", "now", "change");
+    for (uint8_t i = 0; i < result_count; i++) {
+        double reference;
+        if (!baseline_ns_per_byte(baseline, results[i].name, &reference)) {
+            printf("%-40s %12s %12.3f %9s\n", results[i].name, "-", results[i].ns_per_byte, "new");
+            continue;
+        }
+        double change = 100.0 * (results[i].ns_per_byte - reference) / reference;
+        bool regression = change > threshold;
+        regressions += regression;
+        printf("%-40s %12.3f %12.3f %+8.1f%%%s\n", results[i].name, reference, results[i].ns_per_byte, change,
+               regression ? "  REGRESSION" : "");
+    }
+    free(baseline);
+
+    printf("%u of %u benchmarks slower than the baseline by more than %.0f%%\n", regressions, result_count, threshold);
+    return (regressions != 0) ? 1 : 0;
+}
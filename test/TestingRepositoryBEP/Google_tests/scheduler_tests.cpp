@@ -0,0 +1,345 @@
+/*
+ * scheduler_tests.cpp file
+ *
+ * Testing file for the cooperative task scheduler of the RDS. Time is a simulated clock that the tasks advance by their execution time. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Periodic test: A periodic task runs once every period, also when the scheduler is called more often.
+ * - Priority test: Of the released tasks the first one of the table runs first.
+ * - Event test: An event task only runs when it is signalled, signals before the run are merged, and a task can signal
+ *   itself to run again.
+ * - Mode test: A mode enables its task set and disables the other tasks, tasks of both modes keep running.
+ * - Overrun test: A run that ends after the deadline is an overrun, without a deadline a release that comes before
+ *   the previous run is one. Skipped periods are not queued, the worst latency and response time are kept.
+ * - Command latency test: The transit modes are simulated with the execution times of the RDS checkup steps. Reports
+ *   the worst time from a transit mode command to the start of the new mode, compared with the former loops of the
+ *   modes that only looked at the mode after a whole checkup sweep.
+ */
+
+#include "gtest/gtest.h"
+#include <system_health_lib/scheduler.h>
+#include <cstdio>
+
+// Simulated clock in ticks, the scheduler sees the lower 16 bits
+static uint32_t sim_now;
+
+static uint16_t sim_clock(void) {
+    return (uint16_t)sim_now;
+}
+
+// Execution time of a run of a test task, and the order in which tasks ran
+static uint16_t task_cost[8];
+static int run_order[64];
+static int run_count;
+
+static void record_task(Task *task) {
+    int id = *(int *)task->context;
+    run_order[run_count++ % 64] = id;
+    sim_now += task_cost[id];
+}
+
+static int ids[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+static Task make_task(int id, uint16_t period, uint16_t deadline, uint8_t modes) {
+    Task task = {record_task, period, deadline, modes, &ids[id]};
+    return task;
+}
+
+// Calls the scheduler until the simulated clock reaches the last tick, idle time is spent a tick at a time
+static void run_until(Scheduler *scheduler, uint32_t last) {
+    while (sim_now < last) {
+        if (!scheduler_run_next(scheduler)) {
+            sim_now++;
+        }
+    }
+}
+
+static void reset_simulation(void) {
+    sim_now = 0;
+    run_count = 0;
+    for (int i = 0; i < 8; i++) {
+        task_cost[i] = 0;
+    }
+}
+
+TEST(schedulerTestSuite, periodicTest) {
+    reset_simulation();
+    Task tasks[1] = {make_task(0, 10, 0, SCHEDULER_ALL_MODES)};
+    Scheduler scheduler;
+    ASSERT_TRUE(scheduler_init(&scheduler, tasks, 1, sim_clock, NULL));
+
+    // not enabled before the first mode
+    EXPECT_FALSE(scheduler_run_next(&scheduler));
+    scheduler_set_mode(&scheduler, 0);
+    run_until(&scheduler, 95);
+    // released at 0, 10, ..., 90
+    EXPECT_EQ(10, tasks[0].statistics.runs);
+    EXPECT_EQ(0, tasks[0].statistics.worst_latency);
+    EXPECT_EQ(0, tasks[0].statistics.overruns);
+}
+
+TEST(schedulerTestSuite, priorityTest) {
+    reset_simulation();
+    Task tasks[3] = {make_task(0, 10, 0, SCHEDULER_ALL_MODES), make_task(1, 10, 0, SCHEDULER_ALL_MODES),
+                     make_task(2, 10, 0, SCHEDULER_ALL_MODES)};
+    Scheduler scheduler;
+    scheduler_init(&scheduler, tasks, 3, sim_clock, NULL);
+    task_cost[2] = 4;
+
+    scheduler_set_mode(&scheduler, 0);
+    run_until(&scheduler, 20);
+    ASSERT_EQ(6, run_count);
+    int expected[6] = {0, 1, 2, 0, 1, 2};
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(expected[i], run_order[i]);
+    }
+}
+
+// Event task that signals itself until it ran three times
+static Scheduler *repeat_scheduler;
+
+static void repeat_task(Task *task) {
+    record_task(task);
+    if (task->statistics.runs < 2) {
+        scheduler_signal(repeat_scheduler, task);
+    }
+}
+
+TEST(schedulerTestSuite, eventTest) {
+    reset_simulation();
+    Task tasks[2] = {make_task(0, 0, 0, SCHEDULER_ALL_MODES), make_task(1, 0, 0, SCHEDULER_ALL_MODES)};
+    tasks[1].run = repeat_task;
+    Scheduler scheduler;
+    scheduler_init(&scheduler, tasks, 2, sim_clock, NULL);
+    repeat_scheduler = &scheduler;
+    scheduler_set_mode(&scheduler, 0);
+
+    run_until(&scheduler, 50);
+    EXPECT_EQ(0, run_count);
+
+    scheduler_signal(&scheduler, &tasks[0]);
+    scheduler_signal(&scheduler, &tasks[0]);
+    run_until(&scheduler, 100);
+    EXPECT_EQ(1, tasks[0].statistics.runs);
+
+    scheduler_signal(&scheduler, &tasks[1]);
+    run_until(&scheduler, 150);
+    EXPECT_EQ(3, tasks[1].statistics.runs);
+}
+
+TEST(schedulerTestSuite, modeTest) {
+    reset_simulation();
+    Task tasks[3] = {make_task(0, 10, 0, SCHEDULER_ALL_MODES), make_task(1, 10, 0, SCHEDULER_MODE(1)),
+                     make_task(2, 0, 0, SCHEDULER_MODE(2))};
+    Scheduler scheduler;
+    scheduler_init(&scheduler, tasks, 3, sim_clock, NULL);
+
+    scheduler_set_mode(&scheduler, 1);
+    run_until(&scheduler, 25);
+    EXPECT_EQ(3, tasks[0].statistics.runs);
+    EXPECT_EQ(3, tasks[1].statistics.runs);
+
+    // a signal for a task of another mode is ignored
+    scheduler_signal(&scheduler, &tasks[2]);
+    EXPECT_FALSE(tasks[2].released);
+
+    scheduler_set_mode(&scheduler, 2);
+    EXPECT_FALSE(tasks[1].enabled);
+    EXPECT_TRUE(tasks[2].enabled);
+    scheduler_signal(&scheduler, &tasks[2]);
+    run_until(&scheduler, 55);
+    // the task of both modes keeps its period, released at 30, 40 and 50
+    EXPECT_EQ(6, tasks[0].statistics.runs);
+    EXPECT_EQ(3, tasks[1].statistics.runs);
+    EXPECT_EQ(1, tasks[2].statistics.runs);
+
+    // a waiting release is dropped when the task is disabled
+    scheduler_signal(&scheduler, &tasks[2]);
+    scheduler_set_mode(&scheduler, 1);
+    scheduler_set_mode(&scheduler, 2);
+    run_until(&scheduler, 70);
+    EXPECT_EQ(1, tasks[2].statistics.runs);
+}
+
+// Overruns reported to the overrun function
+static int reported_overruns[8];
+
+static void count_overrun(Scheduler *scheduler, Task *task) {
+    reported_overruns[*(int *)task->context]++;
+}
+
+TEST(schedulerTestSuite, overrunTest) {
+    reset_simulation();
+    Task tasks[2] = {make_task(0, 10, 5, SCHEDULER_ALL_MODES), make_task(1, 100, 30, SCHEDULER_ALL_MODES)};
+    Scheduler scheduler;
+    scheduler_init(&scheduler, tasks, 2, sim_clock, count_overrun);
+    reported_overruns[0] = 0;
+    reported_overruns[1] = 0;
+
+    // the second task takes 25 ticks: the release of the first task at 10 waits until 26, the one at 20 is skipped
+    // and the run ends at 27, after the deadline
+    task_cost[0] = 1;
+    task_cost[1] = 25;
+    scheduler_set_mode(&scheduler, 0);
+    run_until(&scheduler, 100);
+    EXPECT_EQ(1, tasks[0].statistics.overruns);
+    EXPECT_EQ(1, reported_overruns[0]);
+    EXPECT_EQ(9, tasks[0].statistics.runs);
+
+    // without a deadline, a signal at 100 that still waits at the release of 106 is an overrun
+    tasks[0].deadline = 0;
+    scheduler_signal(&scheduler, &tasks[0]);
+    sim_now = 107;
+    scheduler_run_next(&scheduler);
+    EXPECT_EQ(2, tasks[0].statistics.overruns);
+    EXPECT_EQ(2, reported_overruns[0]);
+    EXPECT_EQ(0, tasks[1].statistics.overruns);
+    EXPECT_EQ(17, tasks[0].statistics.worst_response);
+    EXPECT_EQ(16, tasks[0].statistics.worst_latency);
+    EXPECT_EQ(26, tasks[1].statistics.worst_response);
+
+    // the second task overruns its deadline of 30
+    task_cost[1] = 40;
+    run_until(&scheduler, 200);
+    EXPECT_EQ(1, tasks[1].statistics.overruns);
+    EXPECT_EQ(1, reported_overruns[1]);
+
+    Task invalid[1] = {make_task(0, SCHEDULER_MAX_PERIOD + 1, 0, SCHEDULER_ALL_MODES)};
+    EXPECT_FALSE(scheduler_init(&scheduler, invalid, 1, sim_clock, NULL));
+}
+
+// Simulation of the transit modes. The execution times in ms of the RDS checkup steps: umbilical cord, bus voltage,
+// temperature sensor 1 and 2 (9 periods of a slow oscillator), heat resistor control, supercap voltage and NEAs.
+#define CHECKUP_STEPS 7
+static const uint16_t checkup_cost[CHECKUP_STEPS] = {1, 2, 60, 60, 1, 2, 1};
+
+// Commands of the lander: the tick at which a transit mode command has been received
+#define COMMAND_COUNT 200
+static uint32_t command_arrival[COMMAND_COUNT];
+static int next_command;            // first command that has not been handled
+static bool mode_change_pending;    // a command has been handled, the new mode has not started
+static uint32_t pending_arrival;
+static uint32_t worst_reaction;
+static int reactions;
+
+// Handles the commands that have been received, like process_received_data
+static void sim_process_received_data(void) {
+    while (next_command < COMMAND_COUNT && command_arrival[next_command] <= sim_now) {
+        if (!mode_change_pending) {
+            mode_change_pending = true;
+            pending_arrival = command_arrival[next_command];
+        }
+        next_command++;
+    }
+}
+
+// Starts the new mode, the reaction to the command
+static void sim_enter_mode(void) {
+    uint32_t reaction = sim_now - pending_arrival;
+    if (reaction > worst_reaction) {
+        worst_reaction = reaction;
+    }
+    reactions++;
+    mode_change_pending = false;
+}
+
+static void make_commands(void) {
+    uint32_t seed = 12345;
+    uint32_t tick = 100;
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        seed = seed * 1103515245u + 12345u;
+        tick += 200 + (seed >> 16) % 1000;
+        command_arrival[i] = tick;
+    }
+    next_command = 0;
+    mode_change_pending = false;
+    worst_reaction = 0;
+    reactions = 0;
+    sim_now = 0;
+}
+
+// Former loop of a mode: the checkup step ran the whole sweep, handling messages between its steps, and the loop only
+// looked at the transit mode after the step
+static void former_mode_loops(uint32_t end) {
+    while (sim_now < end) {
+        // send transit request, umbilical check, connection status and rover connection steps
+        for (int step = 0; step < 4 && !mode_change_pending; step++) {
+            sim_now += 1;
+            sim_process_received_data();
+        }
+        if (!mode_change_pending) {
+            for (int step = 0; step < CHECKUP_STEPS; step++) {
+                sim_now += checkup_cost[step];
+                sim_process_received_data();
+            }
+            sim_now += 1;
+            sim_process_received_data();
+        }
+        if (mode_change_pending) {
+            sim_enter_mode();
+        }
+    }
+}
+
+// Task set of the scheduler
+static int checkup_step;
+
+static void sim_link_task(Task *task) {
+    sim_now += 1;
+    sim_process_received_data();
+}
+
+static void sim_mode_task(Task *task) {
+    sim_now += checkup_cost[checkup_step];
+    checkup_step = (checkup_step + 1) % CHECKUP_STEPS;
+}
+
+TEST(schedulerTestSuite, commandLatencyTest) {
+    make_commands();
+    uint32_t end = command_arrival[COMMAND_COUNT - 1] + 1000;
+    former_mode_loops(end);
+    uint32_t former_worst = worst_reaction;
+    EXPECT_EQ(COMMAND_COUNT, reactions);
+
+    // the same modes as task sets, the lander link task runs every 5 ms and when a frame comes in
+    make_commands();
+    Task tasks[3] = {
+        {sim_link_task, 5, 200, SCHEDULER_ALL_MODES, NULL},
+        {sim_mode_task, 20, 250, SCHEDULER_MODE(0), NULL},
+        {sim_mode_task, 20, 250, SCHEDULER_MODE(1), NULL},
+    };
+    Scheduler scheduler;
+    scheduler_init(&scheduler, tasks, 3, sim_clock, NULL);
+    uint8_t mode = 0;
+    checkup_step = 0;
+    scheduler_set_mode(&scheduler, mode);
+    while (sim_now < end) {
+        if (mode_change_pending) {
+            sim_enter_mode();
+            mode ^= 1;
+            checkup_step = 0;
+            scheduler_set_mode(&scheduler, mode);
+        }
+        if (next_command < COMMAND_COUNT && command_arrival[next_command] <= sim_now) {
+            scheduler_signal(&scheduler, &tasks[0]);
+        }
+        if (!scheduler_run_next(&scheduler)) {
+            sim_now++;
+        }
+    }
+    uint32_t scheduler_worst = worst_reaction;
+    EXPECT_EQ(COMMAND_COUNT, reactions);
+
+    printf("[   INFO   ] worst command to reaction latency: former mode loops %lu ms, scheduler %lu ms\n",
+           (unsigned long)former_worst, (unsigned long)scheduler_worst);
+    printf("[   INFO   ] lander link task: worst latency %u ms, worst response %u ms, %u overruns\n",
+           tasks[0].statistics.worst_latency, tasks[0].statistics.worst_response, tasks[0].statistics.overruns);
+
+    // a command waits at most for the longest checkup step and the lander link task
+    EXPECT_LE(scheduler_worst, 60u + 1u + 1u);
+    EXPECT_LT(scheduler_worst, former_worst);
+    EXPECT_LE(tasks[0].statistics.worst_latency, 60);
+    EXPECT_EQ(0, tasks[0].statistics.overruns + tasks[1].statistics.overruns + tasks[2].statistics.overruns);
+}
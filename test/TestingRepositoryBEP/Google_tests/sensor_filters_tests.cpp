@@ -0,0 +1,247 @@
+/*
+ * sensor_filters_tests.cpp file
+ *
+ * Testing file for the streaming sensor filters. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Network test: The sorting network of every size up to 16 sorts all inputs of zeros and ones, and the median
+ *   network gives the median of all of them, which proves them for every input. Reports the compare-exchanges compared
+ *   with the exchange sort.
+ * - Median test: The median of random samples of several sizes and types is the one of std::nth_element.
+ * - Running window test: Median, mean, minimum and maximum while the window fills up and after it wraps around, also
+ *   for negative samples.
+ * - EMA test: The first sample starts the average, a constant input is reached exactly, a step is followed with the
+ *   weight of the filter, also for negative samples.
+ * - Hampel test: A spike is replaced by the median, a step passes after half of the window, noise within the minimum
+ *   deviation passes.
+ * - Channel test: A noisy ADC channel with spikes is closer to the signal after the outlier rejection and the average of
+ *   the ECCS. Reports the worst error of the samples and of the filtered samples.
+ */
+
+#include "gtest/gtest.h"
+#include <system_health_lib/sensor_filters.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+static uint32_t random_state = 0x2545F491;
+
+// xorshift32, the samples are the same on every run
+static uint32_t random_next(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+template <uint8_t N>
+static void check_network(void) {
+    for (uint32_t bits = 0; bits < (1u << N); bits++) {
+        uint8_t values[N];
+        uint8_t ones = 0;
+        for (uint8_t i = 0; i < N; i++) {
+            values[i] = (bits >> i) & 1;
+            ones += values[i];
+        }
+        uint8_t median = filter_median<N>(values);
+        ASSERT_EQ(N - N / 2 <= ones ? 1 : 0, median) << "median network of " << (int)N << " inputs";
+        filter_sort<N>(values);
+        for (uint8_t i = 0; i < N; i++) {
+            ASSERT_EQ(i >= N - ones ? 1 : 0, values[i]) << "sorting network of " << (int)N << " inputs";
+        }
+    }
+    printf("[   INFO   ] %2d inputs: sort %3d, median %3d compare-exchanges, exchange sort %3d\n", N,
+           Filter_network<N, false>::size, Filter_network<N, true>::size, N * (N - 1) / 2);
+}
+
+template <uint8_t N>
+struct Network_check {
+    static void run(void) {
+        Network_check<N - 1>::run();
+        check_network<N>();
+    }
+};
+
+template <>
+struct Network_check<0> {
+    static void run(void) {
+    }
+};
+
+template <uint8_t N, typename T>
+static void check_random_medians(T low, T high) {
+    for (int run = 0; run < 1000; run++) {
+        T values[N];
+        for (uint8_t i = 0; i < N; i++) {
+            values[i] = (T)(low + (T)(random_next() % (uint32_t)(high - low + 1)));
+        }
+        T expected[N];
+        std::copy(values, values + N, expected);
+        std::nth_element(expected, expected + N / 2, expected + N);
+        ASSERT_EQ(expected[N / 2], filter_median<N>(values));
+    }
+}
+
+TEST(sensorFiltersTestSuite, networkTest) {
+    Network_check<16>::run();
+    EXPECT_EQ(24, (Filter_network<9, true>::size));
+    EXPECT_EQ(FILTER_NETWORK_MAX_COMPARATORS, (Filter_network<FILTER_NETWORK_MAX_INPUTS, false>::size));
+}
+
+TEST(sensorFiltersTestSuite, medianTest) {
+    check_random_medians<9, uint16_t>(0, 65535);
+    check_random_medians<9, uint16_t>(4990, 5010);
+    check_random_medians<5, int16_t>(-2000, 2000);
+    check_random_medians<8, int16_t>(-3, 3);
+    check_random_medians<32, uint16_t>(0, 4095);
+
+    // an even amount gives the higher of the middle samples
+    const int16_t values[4] = {40, -10, 30, 20};
+    EXPECT_EQ(30, filter_median<4>(values));
+    const uint8_t one = 7;
+    EXPECT_EQ(7, filter_median<1>(&one));
+}
+
+TEST(sensorFiltersTestSuite, runningWindowTest) {
+    Running_window<uint16_t, 5> window;
+    EXPECT_EQ(0, window.count);
+    EXPECT_EQ(0, window.mean());
+    EXPECT_EQ(0, window.median());
+
+    window.push(10);
+    window.push(40);
+    EXPECT_FALSE(window.full());
+    EXPECT_EQ(25, window.mean());
+    EXPECT_EQ(40, window.median());
+    EXPECT_EQ(10, window.min());
+    EXPECT_EQ(40, window.max());
+
+    window.push(20);
+    window.push(30);
+    window.push(1000);
+    EXPECT_TRUE(window.full());
+    EXPECT_EQ(220, window.mean());
+    EXPECT_EQ(30, window.median());
+
+    // 10 and 40 leave the window
+    window.push(5);
+    window.push(25);
+    EXPECT_EQ(5, window.count);
+    EXPECT_EQ(216, window.mean());
+    EXPECT_EQ(25, window.median());
+    EXPECT_EQ(5, window.min());
+    EXPECT_EQ(1000, window.max());
+
+    // the mean of negative samples is rounded to the nearest as well
+    Running_window<int16_t, 4> negative;
+    negative.push(-1);
+    negative.push(-2);
+    EXPECT_EQ(-2, negative.mean());
+    negative.push(-4);
+    negative.push(-4);
+    EXPECT_EQ(-3, negative.mean());
+    EXPECT_EQ(-2, negative.median());
+    EXPECT_EQ(-4, negative.min());
+    EXPECT_EQ(-1, negative.max());
+
+    window.reset();
+    EXPECT_EQ(0, window.count);
+    EXPECT_EQ(0, window.sum);
+}
+
+TEST(sensorFiltersTestSuite, emaTest) {
+    Ema_filter<uint16_t, 2> ema;
+    EXPECT_EQ(1000, ema.update(1000));
+
+    // a quarter of the way every sample
+    EXPECT_EQ(1250, ema.update(2000));
+    EXPECT_EQ(1438, ema.update(2000));
+
+    // without the extra bits the average would stop 3 counts below the input
+    for (int i = 0; i < 100; i++) {
+        ema.update(2000);
+    }
+    EXPECT_EQ(2000, ema.value());
+    for (int i = 0; i < 100; i++) {
+        ema.update(3);
+    }
+    EXPECT_EQ(3, ema.value());
+
+    Ema_filter<int16_t, 3> negative;
+    EXPECT_EQ(-800, negative.update(-800));
+    EXPECT_EQ(-600, negative.update(800));
+    for (int i = 0; i < 200; i++) {
+        negative.update(-5);
+    }
+    EXPECT_EQ(-5, negative.value());
+
+    negative.reset();
+    EXPECT_EQ(123, negative.update(123));
+}
+
+TEST(sensorFiltersTestSuite, hampelTest) {
+    Hampel_filter<uint16_t, 5> hampel;
+
+    // the window fills up without filtering
+    const uint16_t start[4] = {1000, 1002, 999, 1001};
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(start[i], hampel.update(start[i]));
+    }
+    EXPECT_EQ(1001, hampel.update(3000));
+    EXPECT_EQ(1u, hampel.rejected);
+    EXPECT_EQ(1000, hampel.update(1000));
+    EXPECT_EQ(1u, hampel.rejected);
+
+    // the spike stays in the window until it is the oldest sample
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(1000, hampel.update(1000));
+    }
+
+    // a step of the signal passes once it is in more than half of the window
+    EXPECT_NE(2000, hampel.update(2000));
+    EXPECT_NE(2000, hampel.update(2000));
+    EXPECT_EQ(2000, hampel.update(2000));
+    EXPECT_EQ(2000, hampel.update(2000));
+
+    // on a quiet channel the MAD is 0, noise within the minimum deviation passes, a spike does not
+    Hampel_filter<int16_t, 5, 4> quiet;
+    for (int i = 0; i < 5; i++) {
+        quiet.update(-100);
+    }
+    EXPECT_EQ(-97, quiet.update(-97));
+    EXPECT_EQ(-104, quiet.update(-104));
+    EXPECT_EQ(-100, quiet.update(100));
+    EXPECT_EQ(1u, quiet.rejected);
+
+    hampel.reset();
+    EXPECT_EQ(0u, hampel.rejected);
+    EXPECT_EQ(50, hampel.update(50));
+}
+
+TEST(sensorFiltersTestSuite, channelTest) {
+    // the bus sense at half of the scale with +-8 counts of noise and a spike of the full scale in one of every 7
+    // sweeps, filtered as the ECCS does
+    Hampel_filter<uint16_t, 5, 16> hampel;
+    Ema_filter<uint16_t, 2> ema;
+    const int signal = 2048;
+    int worst_raw = 0;
+    int worst_filtered = 0;
+    for (int sweep = 0; sweep < 1000; sweep++) {
+        int sample = signal + (int)(random_next() % 17) - 8;
+        if (sweep % 7 == 3) {
+            sample = (random_next() & 1) ? 4095 : 0;
+        }
+        uint16_t filtered = ema.update(hampel.update((uint16_t)sample));
+        // a spike before the window is full passes, and the average takes some sweeps to forget it
+        if (sweep >= 20) {
+            worst_raw = std::max(worst_raw, std::abs(sample - signal));
+            worst_filtered = std::max(worst_filtered, std::abs((int)filtered - signal));
+        }
+    }
+    EXPECT_LE(worst_filtered, 8);
+    EXPECT_LT(worst_filtered, worst_raw);
+    printf("[   INFO   ] bus sense with spikes: worst error %d counts, filtered %d counts, %u spikes rejected\n",
+           worst_raw, worst_filtered, hampel.rejected);
+}
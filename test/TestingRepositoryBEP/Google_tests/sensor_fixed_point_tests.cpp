@@ -0,0 +1,183 @@
+/*
+ * sensor_fixed_point_tests.cpp file
+ *
+ * Testing file for the integer conversions of the sensor readouts. Every conversion is compared with the float
+ * conversion it replaces. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Millivolts test: Every ADC result gives convert_adc_to_voltage() rounded to millivolts, 0 and 4095 give 0 mV and
+ *   3640 mV exactly.
+ * - Centihertz test: Every valid period gives calculateFrequency() rounded to centihertz within 1 step, a period of 0
+ *   gives 0.
+ * - Centidegrees test: Every valid period gives frequency_to_temperature(calculateFrequency()) rounded to centidegrees
+ *   within 1 step, every frequency in centihertz gives frequency_to_temperature() within 1 step. Above 327.67
+ *   degrees Celsius both saturate. Reports the worst errors.
+ * - Analytic test: Every valid period gives the temperature of the oscillator and PT1000 formula in double precision
+ *   rounded to centidegrees within 1 step.
+ * - Threshold test: For every valid period, a comparison of its temperature with a threshold is the same as the
+ *   comparison of the period with centidegrees_to_period() of the threshold, also for the thresholds of the heater.
+ *   Reports the periods of the heater thresholds.
+ * - Range test: Periods and frequencies just outside of 150 Hz to 800 Hz give SENSOR_CENTIDEGREES_ERROR, as the float
+ *   conversion gives -99 degrees.
+ * - Format test: fixed_to_uint8_array_2() gives the layout of float_to_uint8_array_2() for positive and negative
+ *   values, within 1 in the last decimal, as the float conversion truncates.
+ */
+
+#include "gtest/gtest.h"
+#include "supercap_readout.h"
+#include "temp_sensors.h"
+#include <system_health_lib/sensor_fixed_point.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// float_to_uint8_array_2() that the firmware used before fixed_to_uint8_array_2(), kept here as the reference
+static void float_to_uint8_array_2(float value, uint8_t *array) {
+    int integer_part = (int)value;
+    int decimal_part = (int)((value - integer_part) * 10000);
+
+    bool is_negative = false;
+    if (value < 0) {
+        is_negative = true;
+        integer_part = -integer_part;
+        decimal_part = -decimal_part;
+    }
+
+    if (is_negative) {
+        array[0] = '-';
+    } else {
+        array[0] = '0' + ((integer_part / 100) % 10);
+    }
+    array[1] = '0' + ((integer_part / 10) % 10);
+    array[2] = '0' + (integer_part % 10);
+    array[3] = '.';
+    array[4] = '0' + ((decimal_part / 1000) % 10);
+    array[5] = '0' + ((decimal_part / 100) % 10);
+    array[6] = '0' + ((decimal_part / 10) % 10);
+    array[7] = '0' + (decimal_part % 10);
+    array[8] = '\0';
+}
+
+// Float temperature in centidegrees limited to the int16_t range, above 327.67 degrees Celsius the conversions saturate
+static double limited_centidegrees(float temperature) {
+    return std::min(temperature * 100.0, 32767.0);
+}
+
+// Value of a formatted array in 0.0001 steps
+static long formatted_value(const uint8_t *array) {
+    return lround(strtod((const char *)array, NULL) * 10000);
+}
+
+TEST(sensorFixedPointTestSuite, millivoltsTest) {
+    for (uint16_t adc_value = 0; adc_value <= SENSOR_ADC_MAX_VALUE; adc_value++) {
+        long expected = lroundf(convert_adc_to_voltage(adc_value) * 1000);
+        ASSERT_EQ(expected, adc_to_millivolts(adc_value)) << "ADC result " << adc_value;
+    }
+    EXPECT_EQ(0, adc_to_millivolts(0));
+    EXPECT_EQ(SENSOR_ADC_FULL_SCALE_MILLIVOLTS, adc_to_millivolts(SENSOR_ADC_MAX_VALUE));
+}
+
+TEST(sensorFixedPointTestSuite, centihertzTest) {
+    for (uint32_t period = SENSOR_MIN_PERIOD; period <= SENSOR_MAX_PERIOD; period++) {
+        double expected = calculateFrequency((float)period) * 100.0;
+        ASSERT_NEAR(expected, (double)period_to_centihertz((uint16_t)period), 1.0) << "period " << period;
+    }
+    EXPECT_EQ(80000u, period_to_centihertz(5000));
+    EXPECT_EQ(0u, period_to_centihertz(0));
+}
+
+TEST(sensorFixedPointTestSuite, centidegreesTest) {
+    double worst_period = 0;
+    double worst_frequency = 0;
+    for (uint32_t period = SENSOR_MIN_PERIOD; period <= SENSOR_MAX_PERIOD; period++) {
+        double expected = limited_centidegrees(frequency_to_temperature(calculateFrequency((float)period)));
+        int16_t through_period = period_to_centidegrees((uint16_t)period);
+        ASSERT_NEAR(expected, through_period, 1.0) << "period " << period;
+        worst_period = std::max(worst_period, std::fabs(expected - through_period));
+    }
+    for (uint32_t centihertz = SENSOR_MIN_FREQUENCY_HZ * 100; centihertz <= SENSOR_MAX_FREQUENCY_HZ * 100;
+         centihertz++) {
+        double expected = limited_centidegrees(frequency_to_temperature(centihertz / 100.0f));
+        int16_t through_frequency = centihertz_to_centidegrees(centihertz);
+        ASSERT_NEAR(expected, through_frequency, 1.0) << "centihertz " << centihertz;
+        worst_frequency = std::max(worst_frequency, std::fabs(expected - through_frequency));
+    }
+
+    // 1000 ohm is 0 degrees Celsius, 7683 ticks or 520.6 Hz is close to the 20 degrees Celsius of the heater
+    EXPECT_EQ(0, centihertz_to_centidegrees(lround(100.0 / (SENSOR_OSCILLATOR_FACTOR * SENSOR_OSCILLATOR_CAPACITANCE *
+                                                            SENSOR_RTD_R0_OHM))));
+    EXPECT_NEAR(1987, period_to_centidegrees(7683), 1);
+    EXPECT_EQ(32767, period_to_centidegrees(SENSOR_MAX_PERIOD));
+    printf("[   INFO   ] worst error against the float temperature: %.3f centidegrees through the period, "
+           "%.3f from the frequency\n", worst_period, worst_frequency);
+}
+
+TEST(sensorFixedPointTestSuite, analyticTest) {
+    for (uint32_t period = SENSOR_MIN_PERIOD; period <= SENSOR_MAX_PERIOD; period++) {
+        double resistance =
+            period / (SENSOR_CAPTURE_CLOCK_HZ * SENSOR_OSCILLATOR_FACTOR * SENSOR_OSCILLATOR_CAPACITANCE);
+        double expected = std::min(100.0 * (resistance - SENSOR_RTD_R0_OHM) / SENSOR_RTD_OHM_PER_DEGREE, 32767.0);
+        ASSERT_NEAR(expected, period_to_centidegrees((uint16_t)period), 1.0) << "period " << period;
+    }
+}
+
+TEST(sensorFixedPointTestSuite, thresholdTest) {
+    const int16_t thresholds[] = {1, 2000, 2500, 4000, 4001, 10000, 32767};
+    for (int16_t threshold : thresholds) {
+        uint16_t threshold_period = centidegrees_to_period(threshold);
+        for (uint32_t period = SENSOR_MIN_PERIOD; period <= SENSOR_MAX_PERIOD; period++) {
+            ASSERT_EQ(period_to_centidegrees((uint16_t)period) >= threshold, period >= threshold_period)
+                << "threshold " << threshold << " period " << period;
+        }
+    }
+
+    // the heater: on below 20 degrees Celsius, off above 40 degrees Celsius
+    static constexpr uint16_t on_below = centidegrees_to_period(2000);
+    static constexpr uint16_t off_from = centidegrees_to_period(4001);
+    static_assert(on_below < off_from, "the heater thresholds overlap");
+    EXPECT_LT(period_to_centidegrees(on_below - 1), 2000);
+    EXPECT_GE(period_to_centidegrees(on_below), 2000);
+    EXPECT_LE(period_to_centidegrees(off_from - 1), 4000);
+    EXPECT_GT(period_to_centidegrees(off_from), 4000);
+    printf("[   INFO   ] heater on below %u ticks (%.2f Hz), off from %u ticks (%.2f Hz)\n", on_below,
+           (double)SENSOR_CAPTURE_CLOCK_HZ / on_below, off_from, (double)SENSOR_CAPTURE_CLOCK_HZ / off_from);
+}
+
+TEST(sensorFixedPointTestSuite, rangeTest) {
+    EXPECT_EQ(-99.0f, frequency_to_temperature(calculateFrequency((float)(SENSOR_MIN_PERIOD - 1))));
+    EXPECT_EQ(SENSOR_CENTIDEGREES_ERROR, period_to_centidegrees(SENSOR_MIN_PERIOD - 1));
+    EXPECT_EQ(SENSOR_CENTIDEGREES_ERROR, period_to_centidegrees(SENSOR_MAX_PERIOD + 1));
+    EXPECT_EQ(SENSOR_CENTIDEGREES_ERROR, period_to_centidegrees(0));
+    EXPECT_EQ(SENSOR_CENTIDEGREES_ERROR, period_to_centidegrees(0xFFFF));
+    EXPECT_EQ(SENSOR_CENTIDEGREES_ERROR, centihertz_to_centidegrees(SENSOR_MIN_FREQUENCY_HZ * 100 - 1));
+    EXPECT_EQ(SENSOR_CENTIDEGREES_ERROR, centihertz_to_centidegrees(SENSOR_MAX_FREQUENCY_HZ * 100 + 1));
+    EXPECT_EQ(SENSOR_CENTIDEGREES_ERROR, centihertz_to_centidegrees(0));
+    EXPECT_NE(SENSOR_CENTIDEGREES_ERROR, period_to_centidegrees(SENSOR_MIN_PERIOD));
+    EXPECT_NE(SENSOR_CENTIDEGREES_ERROR, period_to_centidegrees(SENSOR_MAX_PERIOD));
+}
+
+TEST(sensorFixedPointTestSuite, formatTest) {
+    uint8_t fixed[9];
+    uint8_t reference[9];
+
+    fixed_to_uint8_array_2(36400, fixed);
+    EXPECT_STREQ("003.6400", (const char *)fixed);
+    fixed_to_uint8_array_2(-123456, fixed);
+    EXPECT_STREQ("-12.3456", (const char *)fixed);
+    fixed_to_uint8_array_2(9999999, fixed);
+    EXPECT_STREQ("999.9999", (const char *)fixed);
+    fixed_to_uint8_array_2(0, fixed);
+    EXPECT_STREQ("000.0000", (const char *)fixed);
+
+    // millivolts and centidegrees over their whole range
+    for (int32_t step = -9999; step <= 99999; step += 7) {
+        float value = step / 100.0f;
+        float_to_uint8_array_2(value, reference);
+        fixed_to_uint8_array_2(step * 100, fixed);
+        ASSERT_EQ(0, memcmp(reference, fixed, 3)) << reference << " " << fixed;
+        ASSERT_LE(labs(formatted_value(reference) - formatted_value(fixed)), 1) << reference << " " << fixed;
+    }
+}
@@ -0,0 +1,297 @@
+/*
+ * slip_frame_writer_tests.cpp file
+ *
+ * Testing file for the scatter-gather frame writer that is used by send_messagev. Multiple tests are executed here to demonstrate that the writer behaves as expected. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Single segment test: A frame with one segment is the same as the frame of the old send_message path.
+ * - Two segment test: A constant string followed by a formatted number gives the same frame as one joined payload.
+ * - Checksum test: The checksum over the segments is the same as calculate_checksum_helper.
+ * - Empty payload test: A frame without segments is written correctly.
+ * - Escaped header test: A length and checksum that are equal to SLIP characters are escaped.
+ * - Payload too large test: Segments that are larger than MAX_PAYLOAD_SIZE together are refused.
+ * - Encoded length test: The prepared encoded length is exactly the amount of bytes written into the queue.
+ * - Wrap around test: A frame that crosses the end of the transmission queue is written correctly.
+ * - Random segments test: Random payloads split into random segments are the same as the old path.
+ * - Round trip test: Frames written by the writer are accepted by the streaming decoder.
+ * - Copy and time benchmark: Reports the bytes copied and time per frame compared with the old send_message path.
+ */
+
+#include "gtest/gtest.h"
+#include "lander_communication.h"
+#include <lander_communication_lib/slip_frame_writer.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+// The old send_message path: create_message, convert_message_to_array, slip_encode and uart_write
+static uint16_t old_send_message(UART_TX_queue *queue, uint8_t msg_type, const uint8_t *payload, uint8_t length) {
+    static uint8_t buffer[UART_BUFFER_SIZE];
+    static uint8_t temp_buffer[UART_BUFFER_SIZE];
+    uint8_t serialized_length;
+    uint16_t encoded_length = 0;
+
+    Message msg;
+    msg.start_byte = MSG_START_BYTE;
+    msg.msg_type = msg_type;
+    msg.length = length;
+    memcpy(msg.payload, payload, length);
+    msg.checksum = calculate_checksum_helper(msg_type, length, payload);
+    msg.end_byte = MSG_END_BYTE;
+
+    convert_message_to_array(&msg, temp_buffer, &serialized_length);
+    if (!slip_encode(temp_buffer, serialized_length, buffer, &encoded_length)) {
+        return 0;
+    }
+    uart_tx_queue_push(queue, buffer, encoded_length);
+    return encoded_length;
+}
+
+// Takes everything out of the queue like the TX interrupt does
+static uint16_t drain(UART_TX_queue *queue, uint8_t *wire) {
+    uint16_t length = 0;
+    while (uart_tx_queue_pop(queue, &wire[length])) {
+        length++;
+    }
+    return length;
+}
+
+// Writes a frame with the writer and returns the bytes on the wire
+static uint16_t write_frame(uint8_t msg_type, const Payload_segment *segments, uint8_t count, uint8_t *wire) {
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+    SLIP_frame_info info;
+    EXPECT_TRUE(slip_frame_prepare(msg_type, segments, count, FRAME_CHECK_XOR8, &info));
+    slip_frame_write(&queue, &info, segments, count);
+    uint16_t length = drain(&queue, wire);
+    EXPECT_EQ(info.encoded_length, length);
+    return length;
+}
+
+// Writes a frame with the old path and returns the bytes on the wire
+static uint16_t write_old_frame(uint8_t msg_type, const uint8_t *payload, uint8_t length, uint8_t *wire) {
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+    old_send_message(&queue, msg_type, payload, length);
+    return drain(&queue, wire);
+}
+
+TEST(slipFrameWriterTestSuite, singleSegmentTest) {
+    Payload_segment segment = {(const uint8_t *)"test", 4};
+    uint8_t wire[UART_TX_QUEUE_SIZE];
+    uint8_t expected[] = {0xC0, 0x7E, 0x01, 0x04, 0x74, 0x65, 0x73, 0x74, 0x13, 0x7F, 0xC0};
+
+    EXPECT_EQ(sizeof(expected), write_frame(0x01, &segment, 1, wire));
+    EXPECT_EQ(0, memcmp(expected, wire, sizeof(expected)));
+}
+
+TEST(slipFrameWriterTestSuite, twoSegmentTest) {
+    const char text[] = "Temperature: ";
+    const char number[] = "-12";
+    Payload_segment segments[] = {{(const uint8_t *)text, sizeof(text) - 1}, {(const uint8_t *)number, sizeof(number) - 1}};
+    const char joined[] = "Temperature: -12";
+    uint8_t wire[UART_TX_QUEUE_SIZE];
+    uint8_t expected[UART_TX_QUEUE_SIZE];
+
+    uint16_t length = write_frame(MSG_TYPE_DATA, segments, 2, wire);
+    uint16_t expected_length = write_old_frame(MSG_TYPE_DATA, (const uint8_t *)joined, sizeof(joined) - 1, expected);
+    EXPECT_EQ(expected_length, length);
+    EXPECT_EQ(0, memcmp(expected, wire, length));
+}
+
+TEST(slipFrameWriterTestSuite, checksumTest) {
+    uint8_t first[] = {0x10, 0x20, 0x30};
+    uint8_t second[] = {0x01, 0x02};
+    uint8_t joined[] = {0x10, 0x20, 0x30, 0x01, 0x02};
+    Payload_segment segments[] = {{first, sizeof(first)}, {second, sizeof(second)}};
+    SLIP_frame_info info;
+
+    EXPECT_TRUE(slip_frame_prepare(MSG_TYPE_RESPONSE, segments, 2, FRAME_CHECK_XOR8, &info));
+    EXPECT_EQ(calculate_checksum_helper(MSG_TYPE_RESPONSE, sizeof(joined), joined), info.checksum);
+    EXPECT_EQ(sizeof(joined), info.length);
+}
+
+TEST(slipFrameWriterTestSuite, emptyPayloadTest) {
+    uint8_t wire[UART_TX_QUEUE_SIZE];
+    uint8_t expected[] = {0xC0, 0x7E, 0x02, 0x00, 0x02, 0x7F, 0xC0};
+
+    EXPECT_EQ(sizeof(expected), write_frame(MSG_TYPE_ACK, NULL, 0, wire));
+    EXPECT_EQ(0, memcmp(expected, wire, sizeof(expected)));
+}
+
+TEST(slipFrameWriterTestSuite, escapedHeaderTest) {
+    // a payload of 0xC0 bytes, so the length byte has to be escaped
+    uint8_t payload[0xC0];
+    memset(payload, 0x00, sizeof(payload));
+    payload[0] = 0xC0 ^ MSG_TYPE_DATA ^ 0xDB;  // makes the checksum 0xDB
+    Payload_segment segment = {payload, sizeof(payload)};
+    uint8_t wire[UART_TX_QUEUE_SIZE];
+    uint8_t expected[UART_TX_QUEUE_SIZE];
+
+    uint16_t length = write_frame(MSG_TYPE_DATA, &segment, 1, wire);
+    uint16_t expected_length = write_old_frame(MSG_TYPE_DATA, payload, sizeof(payload), expected);
+    EXPECT_EQ(expected_length, length);
+    EXPECT_EQ(0, memcmp(expected, wire, length));
+    EXPECT_EQ(SLIP_ESC, wire[3]);
+    EXPECT_EQ(SLIP_ESC_END, wire[4]);
+}
+
+TEST(slipFrameWriterTestSuite, payloadTooLargeTest) {
+    uint8_t payload[200] = {0};
+    Payload_segment segments[] = {{payload, 200}, {payload, 50}};
+    SLIP_frame_info info;
+
+    EXPECT_FALSE(slip_frame_prepare(MSG_TYPE_DATA, segments, 2, FRAME_CHECK_XOR8, &info));
+    segments[1].length = MAX_PAYLOAD_SIZE - 200;
+    EXPECT_TRUE(slip_frame_prepare(MSG_TYPE_DATA, segments, 2, FRAME_CHECK_XOR8, &info));
+}
+
+TEST(slipFrameWriterTestSuite, encodedLengthTest) {
+    uint8_t payload[] = {SLIP_END, SLIP_ESC, 0x01, SLIP_END};
+    Payload_segment segment = {payload, sizeof(payload)};
+    SLIP_frame_info info;
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+
+    EXPECT_TRUE(slip_frame_prepare(MSG_TYPE_DATA, &segment, 1, FRAME_CHECK_XOR8, &info));
+    slip_frame_write(&queue, &info, &segment, 1);
+    EXPECT_EQ(info.encoded_length, uart_tx_queue_used(&queue));
+    EXPECT_EQ(info.encoded_length, queue.high_water);
+}
+
+TEST(slipFrameWriterTestSuite, wrapAroundTest) {
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+    uint8_t filler[200] = {0};
+    uint8_t wire[UART_TX_QUEUE_SIZE];
+
+    // move the indexes close to the end of the ring
+    uart_tx_queue_push(&queue, filler, sizeof(filler));
+    drain(&queue, wire);
+
+    uint8_t payload[100];
+    for (uint16_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)(i * 5);
+    }
+    Payload_segment segment = {payload, sizeof(payload)};
+    SLIP_frame_info info;
+    slip_frame_prepare(MSG_TYPE_DATA, &segment, 1, FRAME_CHECK_XOR8, &info);
+    slip_frame_write(&queue, &info, &segment, 1);
+    uint16_t length = drain(&queue, wire);
+
+    uint8_t expected[UART_TX_QUEUE_SIZE];
+    EXPECT_EQ(write_old_frame(MSG_TYPE_DATA, payload, sizeof(payload), expected), length);
+    EXPECT_EQ(0, memcmp(expected, wire, length));
+}
+
+TEST(slipFrameWriterTestSuite, randomSegmentsTest) {
+    srand(11);
+    for (int round = 0; round < 300; round++) {
+        uint8_t payload[150];
+        uint8_t length = (uint8_t)(rand() % sizeof(payload));
+        for (uint8_t i = 0; i < length; i++) {
+            payload[i] = (uint8_t)rand();
+        }
+
+        // split the payload at random places
+        Payload_segment segments[4];
+        uint8_t count = 0;
+        uint8_t offset = 0;
+        while (count < 3 && offset < length) {
+            uint8_t part = (uint8_t)(rand() % (length - offset + 1));
+            segments[count].data = &payload[offset];
+            segments[count].length = part;
+            offset += part;
+            count++;
+        }
+        segments[count].data = &payload[offset];
+        segments[count].length = length - offset;
+        count++;
+
+        uint8_t msg_type = (uint8_t)(1 + rand() % 9);
+        uint8_t wire[UART_TX_QUEUE_SIZE];
+        uint8_t expected[UART_TX_QUEUE_SIZE];
+        uint16_t wire_length = write_frame(msg_type, segments, count, wire);
+        uint16_t expected_length = write_old_frame(msg_type, payload, length, expected);
+        ASSERT_EQ(expected_length, wire_length);
+        ASSERT_EQ(0, memcmp(expected, wire, wire_length));
+    }
+}
+
+TEST(slipFrameWriterTestSuite, roundTripTest) {
+    uint8_t ring[256];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, sizeof(ring), FRAME_CHECK_XOR8);
+    uint8_t header[] = {'N', 'E', 'A', SLIP_END};
+    uint8_t value[] = {SLIP_ESC, '7'};
+    Payload_segment segments[] = {{header, sizeof(header)}, {value, sizeof(value)}};
+    uint8_t wire[UART_TX_QUEUE_SIZE];
+
+    uint16_t length = write_frame(MSG_TYPE_DATA, segments, 2, wire);
+    SLIP_stream_result result = SLIP_STREAM_BUSY;
+    for (uint16_t i = 0; i < length; i++) {
+        result = slip_stream_decode_byte(&decoder, wire[i]);
+    }
+    ASSERT_EQ(SLIP_STREAM_FRAME_READY, result);
+
+    Message msg;
+    slip_stream_frame_to_message(&decoder, &decoder.last_frame, &msg);
+    uint8_t joined[] = {'N', 'E', 'A', SLIP_END, SLIP_ESC, '7'};
+    EXPECT_EQ(sizeof(joined), msg.length);
+    EXPECT_EQ(0, memcmp(joined, msg.payload, sizeof(joined)));
+}
+
+TEST(slipFrameWriterTestSuite, copyAndTimeBenchmark) {
+    // a typical status message: a constant catalog message followed by a formatted number
+    const char text[] = "Supercapacitor 1 voltage in mV: ";
+    const char number[] = "12345";
+    uint8_t joined[sizeof(text) + sizeof(number)];
+    memcpy(joined, text, sizeof(text) - 1);
+    memcpy(&joined[sizeof(text) - 1], number, sizeof(number) - 1);
+    const uint8_t payload_length = sizeof(text) + sizeof(number) - 2;
+    Payload_segment segments[] = {{(const uint8_t *)text, sizeof(text) - 1}, {(const uint8_t *)number, sizeof(number) - 1}};
+    const int rounds = 200000;
+    uint8_t wire[UART_TX_QUEUE_SIZE];
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+
+    // old path, the caller first joins the string and the number in its own buffer
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    uint16_t encoded_length = 0;
+    for (int round = 0; round < rounds; round++) {
+        memcpy(&joined[sizeof(text) - 1], number, sizeof(number) - 1);
+        encoded_length = old_send_message(&queue, MSG_TYPE_DATA, joined, payload_length);
+        queue.tail = queue.head;
+    }
+    double old_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    // scatter-gather path
+    begin = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        SLIP_frame_info info;
+        slip_frame_prepare(MSG_TYPE_DATA, segments, 2, FRAME_CHECK_XOR8, &info);
+        slip_frame_write(&queue, &info, segments, 2);
+        queue.tail = queue.head;
+    }
+    double new_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    // bytes written per frame: joining the number, copying into the Message, returning the Message by value,
+    // serialising, encoding and copying into the queue, against only encoding into the queue
+    unsigned long old_copied = (sizeof(number) - 1) + payload_length + sizeof(Message) + (payload_length + 5u)
+                               + 2u * encoded_length;
+    unsigned long new_copied = encoded_length;
+    printf("[   INFO   ] %u byte payload in 2 segments, %u bytes on the wire\n", payload_length, encoded_length);
+    printf("[   INFO   ] old send_message: %4lu bytes copied, %6.1f ns per frame, 512 bytes of static buffers\n",
+           old_copied, old_ns / rounds);
+    printf("[   INFO   ] send_messagev:    %4lu bytes copied, %6.1f ns per frame, no buffers\n",
+           new_copied, new_ns / rounds);
+
+    // both paths put the same frame on the wire
+    uint8_t expected[UART_TX_QUEUE_SIZE];
+    EXPECT_EQ(write_old_frame(MSG_TYPE_DATA, joined, payload_length, expected), write_frame(MSG_TYPE_DATA, segments, 2, wire));
+    EXPECT_EQ(0, memcmp(expected, wire, encoded_length));
+    EXPECT_LT(new_copied, old_copied);
+}
@@ -0,0 +1,222 @@
+/*
+ * slip_scan_tests.cpp file
+ *
+ * Testing file for the word at a time SLIP helpers and the slip_encode fast path that uses them. Multiple tests are executed here to demonstrate that the fast path gives exactly the same output as the former byte by byte encoder. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Word position test: A special byte is found at every position of a word, also next to the other special byte.
+ * - Word no special test: Bytes that only differ from SLIP END or ESC in one bit, and zero bytes, are not reported.
+ * - Encode bit exact test: slip_encode gives the same bytes, length and result as the byte by byte encoder for random payloads of every length.
+ * - Encode overflow test: slip_encode refuses exactly the inputs that the byte by byte encoder refused.
+ * - Encode benchmark: Reports slip_encode against the byte by byte encoder for plain, escape-heavy and maximum size payloads.
+ */
+
+#include "gtest/gtest.h"
+#include "lander_communication.h"
+#include <lander_communication_lib/slip_scan.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+
+static uint32_t random_state = 0x12345678;
+
+static uint8_t random_byte(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return (uint8_t)random_state;
+}
+
+// Random byte of which about one in eight is SLIP END or ESC
+static uint8_t random_payload_byte(void) {
+    uint8_t r = random_byte();
+    return (r < 16) ? SLIP_END : (r < 32) ? SLIP_ESC : random_byte();
+}
+
+/*
+ * The former slip_encode, checking every byte, kept as reference for the fast path.
+ */
+static bool slip_encode_bytewise(const uint8_t *buffer, uint16_t length, uint8_t *output_buffer,
+                                 uint16_t *received_length) {
+    uint16_t index = 0;
+    output_buffer[index++] = SLIP_END;
+
+    for (uint16_t i = 0; i < length; i++) {
+        switch (buffer[i]) {
+            case SLIP_END:
+                if (index + 2 >= UART_BUFFER_SIZE) {
+                    return false;
+                }
+                output_buffer[index++] = SLIP_ESC;
+                output_buffer[index++] = SLIP_ESC_END;
+                break;
+            case SLIP_ESC:
+                if (index + 2 >= UART_BUFFER_SIZE) {
+                    return false;
+                }
+                output_buffer[index++] = SLIP_ESC;
+                output_buffer[index++] = SLIP_ESC_ESC;
+                break;
+            default:
+                if (index >= UART_BUFFER_SIZE - 1) {
+                    return false;
+                }
+                output_buffer[index++] = buffer[i];
+        }
+    }
+
+    output_buffer[index++] = SLIP_END;
+
+    *received_length = index;
+    return true;
+}
+
+TEST(slipScanTestSuite, wordPositionTest) {
+    uint8_t bytes[sizeof(Slip_scan_word)];
+    Slip_scan_word word;
+
+    for (uint8_t position = 0; position < sizeof(Slip_scan_word); position++) {
+        for (uint8_t special : {SLIP_END, SLIP_ESC}) {
+            memset(bytes, 'A', sizeof(bytes));
+            bytes[position] = special;
+            memcpy(&word, bytes, sizeof(word));
+            ASSERT_TRUE(slip_word_has_special(word));
+
+            // the other special byte in the same word
+            bytes[(position + 1) % sizeof(bytes)] = (special == SLIP_END) ? SLIP_ESC : SLIP_END;
+            memcpy(&word, bytes, sizeof(word));
+            ASSERT_TRUE(slip_word_has_special(word));
+        }
+    }
+}
+
+TEST(slipScanTestSuite, wordNoSpecialTest) {
+    uint8_t bytes[sizeof(Slip_scan_word)];
+    Slip_scan_word word;
+
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        for (uint8_t i = 0; i < sizeof(bytes); i++) {
+            bytes[i] = (uint8_t)(((i & 1) ? SLIP_END : SLIP_ESC) ^ (1 << bit));
+        }
+        memcpy(&word, bytes, sizeof(word));
+        EXPECT_FALSE(slip_word_has_special(word));
+    }
+
+    // bytes around the special ones, and a zero byte that makes a borrow in the word
+    const uint8_t neighbours[] = {0x00, 0xBF, 0xC1, 0xDA, 0xDC, 0xFF, 0x01, 0x80};
+    for (uint8_t shift = 0; shift < sizeof(neighbours); shift++) {
+        for (uint8_t i = 0; i < sizeof(bytes); i++) {
+            bytes[i] = neighbours[(i + shift) % sizeof(neighbours)];
+        }
+        memcpy(&word, bytes, sizeof(word));
+        EXPECT_FALSE(slip_word_has_special(word));
+    }
+}
+
+TEST(slipScanTestSuite, encodeBitExactTest) {
+    uint8_t input[MAX_PAYLOAD_SIZE + 8];
+    uint8_t expected_output[UART_BUFFER_SIZE];
+    uint8_t output[UART_BUFFER_SIZE];
+
+    for (uint16_t length = 0; length <= MAX_PAYLOAD_SIZE; length++) {
+        for (uint8_t round = 0; round < 8; round++) {
+            // every alignment of the input
+            uint8_t *data = &input[round];
+            for (uint16_t i = 0; i < length; i++) {
+                data[i] = (round & 1) ? random_byte() : random_payload_byte();
+            }
+            uint16_t expected_length = 0;
+            uint16_t output_length = 0;
+            bool expected_result = slip_encode_bytewise(data, length, expected_output, &expected_length);
+            bool result = slip_encode(data, length, output, &output_length);
+            ASSERT_EQ(result, expected_result) << "length " << length;
+            if (result) {
+                ASSERT_EQ(output_length, expected_length);
+                ASSERT_EQ(memcmp(output, expected_output, output_length), 0) << "length " << length;
+            }
+        }
+    }
+}
+
+TEST(slipScanTestSuite, encodeOverflowTest) {
+    uint8_t data[UART_BUFFER_SIZE];
+    uint8_t output[UART_BUFFER_SIZE];
+    uint8_t expected_output[UART_BUFFER_SIZE];
+    uint16_t length = 0;
+    uint16_t expected_length = 0;
+
+    // 254 plain bytes and two END characters fill the buffer exactly, one more byte does not fit
+    memset(data, 'A', sizeof(data));
+    EXPECT_TRUE(slip_encode(data, UART_BUFFER_SIZE - 2, output, &length));
+    EXPECT_EQ(length, UART_BUFFER_SIZE);
+    EXPECT_FALSE(slip_encode(data, UART_BUFFER_SIZE - 1, output, &length));
+
+    // an escaped byte at the very end, at every position around the limit
+    for (uint16_t plain = UART_BUFFER_SIZE - 8; plain < UART_BUFFER_SIZE - 1; plain++) {
+        memset(data, 'A', sizeof(data));
+        data[plain] = SLIP_END;
+        bool expected_result = slip_encode_bytewise(data, plain + 1, expected_output, &expected_length);
+        EXPECT_EQ(slip_encode(data, plain + 1, output, &length), expected_result) << plain;
+    }
+
+    // only escaped bytes
+    memset(data, SLIP_ESC, sizeof(data));
+    for (uint16_t count = 124; count < 130; count++) {
+        bool expected_result = slip_encode_bytewise(data, count, expected_output, &expected_length);
+        EXPECT_EQ(slip_encode(data, count, output, &length), expected_result) << count;
+    }
+}
+
+TEST(slipScanTestSuite, encodeBenchmark) {
+    const uint16_t iterations = 20000;
+    uint8_t plain[MAX_PAYLOAD_SIZE];
+    uint8_t escaped[64];
+    uint8_t output[UART_BUFFER_SIZE];
+    uint16_t length = 0;
+    volatile uint32_t sink = 0;
+
+    for (uint16_t i = 0; i < sizeof(plain); i++) {
+        plain[i] = (uint8_t)('A' + i % 26);
+    }
+    for (uint16_t i = 0; i < sizeof(escaped); i++) {
+        escaped[i] = random_payload_byte();
+    }
+
+    const struct {
+        const char *name;
+        const uint8_t *data;
+        uint16_t length;
+    } cases[] = {
+        {"status string", plain, 20},
+        {"escape-heavy 64 bytes", escaped, sizeof(escaped)},
+        {"plain 249 bytes", plain, sizeof(plain)},
+    };
+
+    // both encoders are called through a pointer, such that neither is inlined in the loop
+    typedef bool (*Encoder)(const uint8_t *, uint16_t, uint8_t *, uint16_t *);
+    Encoder volatile encoders[2] = {slip_encode, slip_encode_bytewise};
+
+    for (const auto &c : cases) {
+        double best_ns[2] = {0, 0};
+        for (uint8_t repeat = 0; repeat < 3; repeat++) {
+            for (uint8_t e = 0; e < 2; e++) {
+                Encoder encoder = encoders[e];
+                std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+                for (uint16_t n = 0; n < iterations; n++) {
+                    encoder(c.data, c.length, output, &length);
+                    sink += length;
+                }
+                double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+                if (repeat == 0 || ns < best_ns[e]) {
+                    best_ns[e] = ns;
+                }
+            }
+        }
+
+        printf("[   INFO   ] %s: slip_encode %.2f ns/byte, byte by byte %.2f ns/byte\n", c.name,
+               best_ns[0] / iterations / c.length, best_ns[1] / iterations / c.length);
+    }
+}
@@ -0,0 +1,404 @@
+/*
+ * slip_stream_decoder_tests.cpp file
+ *
+ * Testing file for the incremental SLIP decoder that runs in the RX interrupt. Multiple tests are executed here to demonstrate that the decoder behaves as expected. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Normal frame test: A valid frame is reported with the right message type, length and payload.
+ * - Escaped payload test: END and ESC characters inside the payload are un-escaped.
+ * - Empty payload test: A frame without payload is accepted.
+ * - Maximum payload size test: A frame with MAX_PAYLOAD_SIZE payload bytes is accepted.
+ * - Invalid checksum test: A frame with a wrong checksum is rejected and its ring buffer space is given back.
+ * - Start byte test: A frame that does not start with MSG_START_BYTE is rejected.
+ * - End byte test: A frame that does not end with MSG_END_BYTE is rejected.
+ * - Invalid escape test: An ESC character followed by anything else than ESC_END or ESC_ESC is rejected.
+ * - Length too large test: A length byte larger than MAX_PAYLOAD_SIZE is rejected.
+ * - Truncated frame test: A frame that is closed before all fields arrived is rejected.
+ * - Too long frame test: A frame with more bytes than announced is rejected.
+ * - Noise before frame test: Characters before the first END character are ignored.
+ * - Back to back frames test: One END character closes a frame and opens the next one.
+ * - Resynchronisation test: A valid frame after a broken one is received.
+ * - Overflow test: A frame that does not fit next to a frame in use by the main loop is rejected.
+ * - Drop last frame test: The space of a frame that cannot be queued is given back.
+ * - Abort test: Aborting halfway a frame gives the space back and waits for a new END character.
+ * - In frame test: The decoder only reports to be in a frame once a character after the opening END arrived.
+ * - Wrap around test: A payload that crosses the end of the ring buffer is copied out correctly.
+ * - Same result as slip_decode test: The decoder gives the same message as slip_decode and convert_array_to_message.
+ * - Per byte cost benchmark: Reports the decoding cost per byte compared with the old three pass path.
+ */
+
+#include "gtest/gtest.h"
+#include "lander_communication.h"
+#include <lander_communication_lib/slip_stream_decoder.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+#define TEST_RING_SIZE 256
+
+// Builds a SLIP encoded frame of the Message protocol
+static uint16_t build_encoded_frame(uint8_t msg_type, const uint8_t *payload, uint8_t length, uint8_t *output) {
+    Message msg;
+    msg.start_byte = MSG_START_BYTE;
+    msg.msg_type = msg_type;
+    msg.length = length;
+    memcpy(msg.payload, payload, length);
+    msg.checksum = calculate_checksum_helper(msg_type, length, payload);
+    msg.end_byte = MSG_END_BYTE;
+
+    uint8_t serialized[UART_BUFFER_SIZE];
+    uint8_t serialized_length;
+    convert_message_to_array(&msg, serialized, &serialized_length);
+
+    uint16_t encoded_length = 0;
+    slip_encode(serialized, serialized_length, output, &encoded_length);
+    return encoded_length;
+}
+
+// Feeds characters to the decoder and returns the last result that was not SLIP_STREAM_BUSY
+static SLIP_stream_result feed(SLIP_stream_decoder *decoder, const uint8_t *data, uint16_t length) {
+    SLIP_stream_result last = SLIP_STREAM_BUSY;
+    for (uint16_t i = 0; i < length; i++) {
+        SLIP_stream_result result = slip_stream_decode_byte(decoder, data[i]);
+        if (result != SLIP_STREAM_BUSY) {
+            last = result;
+        }
+    }
+    return last;
+}
+
+TEST(slipStreamDecoderTestSuite, normalFrameTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t encoded[] = {0xC0, 0x7E, 0x01, 0x04, 0x74, 0x65, 0x73, 0x74, 0x13, 0x7F, 0xC0};
+
+    EXPECT_EQ(SLIP_STREAM_FRAME_READY, feed(&decoder, encoded, sizeof(encoded)));
+
+    Message msg;
+    slip_stream_frame_to_message(&decoder, &decoder.last_frame, &msg);
+    EXPECT_EQ(MSG_START_BYTE, msg.start_byte);
+    EXPECT_EQ(0x01, msg.msg_type);
+    EXPECT_EQ(4, msg.length);
+    EXPECT_EQ(0, memcmp("test", msg.payload, 4));
+    EXPECT_EQ(0x13, msg.checksum);
+    EXPECT_EQ(MSG_END_BYTE, msg.end_byte);
+}
+
+TEST(slipStreamDecoderTestSuite, escapedPayloadTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t payload[] = {0xC0, 0x01, 0xDB, 0xDB, 0xC0};
+    uint8_t encoded[UART_BUFFER_SIZE];
+    uint16_t encoded_length = build_encoded_frame(0x05, payload, sizeof(payload), encoded);
+
+    EXPECT_EQ(SLIP_STREAM_FRAME_READY, feed(&decoder, encoded, encoded_length));
+
+    Message msg;
+    slip_stream_frame_to_message(&decoder, &decoder.last_frame, &msg);
+    EXPECT_EQ(sizeof(payload), msg.length);
+    EXPECT_EQ(0, memcmp(payload, msg.payload, sizeof(payload)));
+}
+
+TEST(slipStreamDecoderTestSuite, emptyPayloadTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t encoded[UART_BUFFER_SIZE];
+    uint16_t encoded_length = build_encoded_frame(0x03, NULL, 0, encoded);
+
+    EXPECT_EQ(SLIP_STREAM_FRAME_READY, feed(&decoder, encoded, encoded_length));
+    EXPECT_EQ(0x03, decoder.last_frame.msg_type);
+    EXPECT_EQ(0, decoder.last_frame.length);
+}
+
+TEST(slipStreamDecoderTestSuite, maximumPayloadSizeTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t payload[MAX_PAYLOAD_SIZE];
+    memset(payload, 'A', sizeof(payload));
+    uint8_t encoded[UART_BUFFER_SIZE];
+    uint16_t encoded_length = build_encoded_frame(0x05, payload, MAX_PAYLOAD_SIZE, encoded);
+
+    EXPECT_EQ(SLIP_STREAM_FRAME_READY, feed(&decoder, encoded, encoded_length));
+    EXPECT_EQ(MAX_PAYLOAD_SIZE, decoder.last_frame.length);
+}
+
+TEST(slipStreamDecoderTestSuite, invalidChecksumTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t encoded[] = {0xC0, 0x7E, 0x01, 0x04, 0x74, 0x65, 0x73, 0x74, 0x14, 0x7F, 0xC0};
+
+    EXPECT_EQ(SLIP_STREAM_INVALID_CHECKSUM, feed(&decoder, encoded, sizeof(encoded)));
+    EXPECT_EQ(1, decoder.invalid_checksums);
+    EXPECT_EQ(decoder.read_index, decoder.write_index);
+}
+
+TEST(slipStreamDecoderTestSuite, startByteTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t encoded[] = {0xC0, 0x7D, 0x01, 0x04, 0x74, 0x65, 0x73, 0x74, 0x13, 0x7F, 0xC0};
+
+    EXPECT_EQ(SLIP_STREAM_INVALID_MESSAGE, feed(&decoder, encoded, sizeof(encoded)));
+    EXPECT_EQ(1, decoder.invalid_messages);
+}
+
+TEST(slipStreamDecoderTestSuite, endByteTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t encoded[] = {0xC0, 0x7E, 0x01, 0x04, 0x74, 0x65, 0x73, 0x74, 0x13, 0x7E, 0xC0};
+
+    EXPECT_EQ(SLIP_STREAM_INVALID_MESSAGE, feed(&decoder, encoded, sizeof(encoded)));
+}
+
+TEST(slipStreamDecoderTestSuite, invalidEscapeTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t encoded[] = {0xC0, 0x7E, 0x01, 0x01, 0xDB, 0x01, 0x01, 0x7F, 0xC0};
+
+    EXPECT_EQ(SLIP_STREAM_INVALID_MESSAGE, feed(&decoder, encoded, sizeof(encoded)));
+}
+
+TEST(slipStreamDecoderTestSuite, lengthTooLargeTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t encoded[] = {0xC0, 0x7E, 0x01, MAX_PAYLOAD_SIZE + 1};
+
+    EXPECT_EQ(SLIP_STREAM_INVALID_MESSAGE, feed(&decoder, encoded, sizeof(encoded)));
+}
+
+TEST(slipStreamDecoderTestSuite, truncatedFrameTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t encoded[] = {0xC0, 0x7E, 0x01, 0x04, 0x74, 0x65, 0xC0};
+
+    EXPECT_EQ(SLIP_STREAM_INVALID_MESSAGE, feed(&decoder, encoded, sizeof(encoded)));
+    EXPECT_EQ(decoder.read_index, decoder.write_index);
+}
+
+TEST(slipStreamDecoderTestSuite, tooLongFrameTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t encoded[] = {0xC0, 0x7E, 0x01, 0x04, 0x74, 0x65, 0x73, 0x74, 0x13, 0x7F, 0x00, 0xC0};
+
+    EXPECT_EQ(SLIP_STREAM_INVALID_MESSAGE, feed(&decoder, encoded, sizeof(encoded)));
+}
+
+TEST(slipStreamDecoderTestSuite, noiseBeforeFrameTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t encoded[] = {0x7E, 0x13, 0x7F, 0xDB, 0xC0, 0x7E, 0x01, 0x04, 0x74, 0x65, 0x73, 0x74, 0x13, 0x7F, 0xC0};
+
+    EXPECT_EQ(SLIP_STREAM_FRAME_READY, feed(&decoder, encoded, sizeof(encoded)));
+    EXPECT_EQ(0, decoder.invalid_messages);
+}
+
+TEST(slipStreamDecoderTestSuite, backToBackFramesTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    // the END character in the middle closes the first frame and opens the second one
+    uint8_t encoded[] = {0xC0, 0x7E, 0x02, 0x00, 0x02, 0x7F, 0xC0, 0x7E, 0x07, 0x01, 0x44, 0x42, 0x7F, 0xC0};
+    int frames = 0;
+
+    for (uint16_t i = 0; i < sizeof(encoded); i++) {
+        if (slip_stream_decode_byte(&decoder, encoded[i]) == SLIP_STREAM_FRAME_READY) {
+            frames++;
+            if (frames == 1) {
+                EXPECT_EQ(0x02, decoder.last_frame.msg_type);
+            } else {
+                EXPECT_EQ(0x07, decoder.last_frame.msg_type);
+                EXPECT_EQ('D', ring[decoder.last_frame.offset]);
+            }
+        }
+    }
+    EXPECT_EQ(2, frames);
+}
+
+TEST(slipStreamDecoderTestSuite, resynchronisationTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t broken[] = {0xC0, 0x7E, 0x01, 0x04, 0x74, 0xDB, 0x00, 0x73, 0x74, 0x13, 0x7F, 0xC0};
+    uint8_t valid[] = {0x7E, 0x01, 0x04, 0x74, 0x65, 0x73, 0x74, 0x13, 0x7F, 0xC0};
+
+    EXPECT_EQ(SLIP_STREAM_INVALID_MESSAGE, feed(&decoder, broken, sizeof(broken)));
+    EXPECT_EQ(SLIP_STREAM_FRAME_READY, feed(&decoder, valid, sizeof(valid)));
+}
+
+TEST(slipStreamDecoderTestSuite, overflowTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t payload[200];
+    memset(payload, 'x', sizeof(payload));
+    uint8_t encoded[UART_BUFFER_SIZE];
+    uint16_t encoded_length = build_encoded_frame(0x05, payload, sizeof(payload), encoded);
+
+    // the first frame is not released by the main loop, so the second one does not fit
+    EXPECT_EQ(SLIP_STREAM_FRAME_READY, feed(&decoder, encoded, encoded_length));
+    SLIP_stream_frame first = decoder.last_frame;
+    EXPECT_EQ(SLIP_STREAM_OVERFLOW, feed(&decoder, encoded, encoded_length));
+    EXPECT_EQ(1, decoder.overflows);
+
+    // once released there is room again
+    slip_stream_release(&decoder, &first);
+    EXPECT_EQ(SLIP_STREAM_FRAME_READY, feed(&decoder, encoded, encoded_length));
+}
+
+TEST(slipStreamDecoderTestSuite, dropLastFrameTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t encoded[] = {0xC0, 0x7E, 0x01, 0x04, 0x74, 0x65, 0x73, 0x74, 0x13, 0x7F, 0xC0};
+
+    EXPECT_EQ(SLIP_STREAM_FRAME_READY, feed(&decoder, encoded, sizeof(encoded)));
+    slip_stream_drop_last_frame(&decoder);
+    EXPECT_EQ(decoder.read_index, decoder.write_index);
+}
+
+TEST(slipStreamDecoderTestSuite, abortTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t partial[] = {0xC0, 0x7E, 0x01, 0x04, 0x74, 0x65};
+    uint8_t rest[] = {0x73, 0x74, 0x13, 0x7F, 0xC0};
+
+    feed(&decoder, partial, sizeof(partial));
+    slip_stream_abort(&decoder);
+    EXPECT_EQ(decoder.read_index, decoder.write_index);
+    EXPECT_FALSE(slip_stream_in_frame(&decoder));
+
+    // the rest of the aborted frame is not taken for a new frame
+    EXPECT_EQ(SLIP_STREAM_BUSY, feed(&decoder, rest, sizeof(rest)));
+}
+
+TEST(slipStreamDecoderTestSuite, inFrameTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+
+    EXPECT_FALSE(slip_stream_in_frame(&decoder));
+    slip_stream_decode_byte(&decoder, 0xC0);
+    EXPECT_FALSE(slip_stream_in_frame(&decoder));
+    slip_stream_decode_byte(&decoder, 0x7E);
+    EXPECT_TRUE(slip_stream_in_frame(&decoder));
+}
+
+TEST(slipStreamDecoderTestSuite, wrapAroundTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    uint8_t payload[150];
+    for (uint16_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)(i + 1);
+    }
+    uint8_t encoded[UART_BUFFER_SIZE];
+    uint16_t encoded_length = build_encoded_frame(0x05, payload, sizeof(payload), encoded);
+
+    for (int round = 0; round < 3; round++) {
+        EXPECT_EQ(SLIP_STREAM_FRAME_READY, feed(&decoder, encoded, encoded_length));
+        Message msg;
+        slip_stream_frame_to_message(&decoder, &decoder.last_frame, &msg);
+        EXPECT_EQ(0, memcmp(payload, msg.payload, sizeof(payload)));
+        slip_stream_release(&decoder, &decoder.last_frame);
+    }
+}
+
+TEST(slipStreamDecoderTestSuite, sameResultAsSlipDecodeTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    srand(7);
+
+    for (int round = 0; round < 200; round++) {
+        uint8_t payload[120];
+        uint8_t length = (uint8_t)(rand() % sizeof(payload));
+        for (uint8_t i = 0; i < length; i++) {
+            payload[i] = (uint8_t)rand();
+        }
+        uint8_t encoded[UART_BUFFER_SIZE];
+        uint16_t encoded_length = build_encoded_frame((uint8_t)(1 + rand() % 9), payload, length, encoded);
+
+        // old path
+        uint8_t decoded[UART_BUFFER_SIZE];
+        uint16_t decoded_length;
+        Message expected;
+        ASSERT_TRUE(slip_decode(encoded, encoded_length, decoded, &decoded_length));
+        ASSERT_TRUE(convert_array_to_message(decoded, decoded_length, &expected));
+
+        // streaming decoder
+        ASSERT_EQ(SLIP_STREAM_FRAME_READY, feed(&decoder, encoded, encoded_length));
+        Message actual;
+        slip_stream_frame_to_message(&decoder, &decoder.last_frame, &actual);
+        slip_stream_release(&decoder, &decoder.last_frame);
+
+        EXPECT_EQ(expected.start_byte, actual.start_byte);
+        EXPECT_EQ(expected.msg_type, actual.msg_type);
+        EXPECT_EQ(expected.length, actual.length);
+        EXPECT_EQ(0, memcmp(expected.payload, actual.payload, expected.length));
+        EXPECT_EQ(expected.checksum, actual.checksum);
+        EXPECT_EQ(expected.end_byte, actual.end_byte);
+    }
+}
+
+TEST(slipStreamDecoderTestSuite, perByteCostBenchmark) {
+    const int rounds = 20000;
+    uint8_t payload[MAX_PAYLOAD_SIZE];
+    for (uint16_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)(i * 7);  // includes some END and ESC characters
+    }
+    uint8_t encoded[UART_BUFFER_SIZE];
+    uint16_t encoded_length = build_encoded_frame(0x05, payload, 200, encoded);
+    volatile uint8_t sink = 0;
+
+    // old path: unwrap the ring buffer, slip_decode and convert_array_to_message
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        uint8_t temp_buffer[UART_BUFFER_SIZE];
+        uint8_t decoded[UART_BUFFER_SIZE];
+        uint16_t decoded_length;
+        Message msg;
+        memcpy(temp_buffer, encoded, encoded_length);
+        slip_decode(temp_buffer, encoded_length, decoded, &decoded_length);
+        convert_array_to_message(decoded, decoded_length, &msg);
+        sink = sink + msg.payload[round % msg.length];
+    }
+    double three_pass_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    // streaming decoder plus the single copy out of the ring buffer
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    begin = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        Message msg;
+        for (uint16_t i = 0; i < encoded_length; i++) {
+            if (slip_stream_decode_byte(&decoder, encoded[i]) == SLIP_STREAM_FRAME_READY) {
+                slip_stream_frame_to_message(&decoder, &decoder.last_frame, &msg);
+                slip_stream_release(&decoder, &decoder.last_frame);
+                sink = sink + msg.payload[round % msg.length];
+            }
+        }
+    }
+    double streaming_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    double bytes = (double)rounds * encoded_length;
+    printf("[   INFO   ] three pass decode: %6.2f ns/byte, 770 bytes of buffers on the stack\n", three_pass_ns / bytes);
+    printf("[   INFO   ] streaming decode:  %6.2f ns/byte, %u bytes of decoder state\n", streaming_ns / bytes,
+           (unsigned)sizeof(SLIP_stream_decoder));
+    EXPECT_EQ(0, decoder.invalid_messages + decoder.invalid_checksums + decoder.overflows);
+}
@@ -0,0 +1,292 @@
+/*
+ * soft_timer_tests.cpp file
+ *
+ * Testing file for the software timers of the RDS. The system tick is simulated by calling soft_timer_tick with increasing ticks. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - One-shot test: A one-shot timer expires once, at the tick of its delay.
+ * - Periodic test: A periodic timer expires every period until it is stopped.
+ * - Order test: Timers expire in the order of their expiry, timers of the same tick in the order they were started.
+ * - Restart and stop test: A restarted timer is rescheduled, a stopped timer does not expire.
+ * - Callback test: Callbacks are called at the expiry and can restart their own timer and stop other timers.
+ * - Skipped ticks test: Skipped ticks are caught up, a periodic timer expires once for every period that passed.
+ * - Wrap-around test: Timers keep their order and delay across the wrap-around of the 16-bit tick.
+ * - Range test: Delays of 0 or above SOFT_TIMER_MAX_DELAY are refused, the next expiry is reported.
+ * - Concurrent timeouts test: The ARQ wait, a temperature capture, the UART inter-byte timeout and the 0.25 s timer of
+ *   the supercap check run at the same time on one tick.
+ */
+
+#include "gtest/gtest.h"
+#include <system_health_lib/soft_timer.h>
+
+// Order in which the callbacks were called
+static int expired_order[16];
+static int expired_count;
+
+static void record_expiry(Soft_timer *timer) {
+    expired_order[expired_count++ % 16] = *(int *)timer->context;
+}
+
+// Ticks the list from the tick after its current one up to and including the last tick
+static void run_until(Soft_timer_list *list, uint16_t last) {
+    while (list->now != last) {
+        soft_timer_tick(list, (uint16_t)(list->now + 1));
+    }
+}
+
+TEST(softTimerTestSuite, oneShotTest) {
+    Soft_timer_list list;
+    Soft_timer timer;
+    soft_timer_list_init(&list, 0);
+    soft_timer_init(&timer, NULL, NULL);
+
+    EXPECT_TRUE(soft_timer_start(&list, &timer, 5, 0));
+    run_until(&list, 4);
+    EXPECT_FALSE(soft_timer_expired(&timer));
+    EXPECT_TRUE(timer.running);
+    run_until(&list, 5);
+    EXPECT_TRUE(soft_timer_expired(&timer));
+    EXPECT_FALSE(timer.running);
+    run_until(&list, 100);
+    EXPECT_EQ(1, timer.expirations);
+    EXPECT_EQ(NULL, list.first);
+}
+
+TEST(softTimerTestSuite, periodicTest) {
+    Soft_timer_list list;
+    Soft_timer timer;
+    soft_timer_list_init(&list, 0);
+    soft_timer_init(&timer, NULL, NULL);
+
+    soft_timer_start(&list, &timer, 250, 250);
+    run_until(&list, 249);
+    EXPECT_EQ(0, timer.expirations);
+    run_until(&list, 250);
+    EXPECT_EQ(1, timer.expirations);
+    run_until(&list, 1000);
+    EXPECT_EQ(4, timer.expirations);
+    run_until(&list, 1249);
+    EXPECT_EQ(4, timer.expirations);
+
+    soft_timer_stop(&list, &timer);
+    run_until(&list, 2000);
+    EXPECT_EQ(4, timer.expirations);
+    EXPECT_FALSE(timer.running);
+}
+
+TEST(softTimerTestSuite, orderTest) {
+    Soft_timer_list list;
+    Soft_timer timers[6];
+    int ids[6] = {0, 1, 2, 3, 4, 5};
+    uint16_t delays[6] = {30, 10, 20, 10, 5, 30};
+    soft_timer_list_init(&list, 0);
+    for (int i = 0; i < 6; i++) {
+        soft_timer_init(&timers[i], record_expiry, &ids[i]);
+        soft_timer_start(&list, &timers[i], delays[i], 0);
+    }
+
+    expired_count = 0;
+    run_until(&list, 30);
+    int expected[6] = {4, 1, 3, 2, 0, 5};
+    ASSERT_EQ(6, expired_count);
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(expected[i], expired_order[i]);
+    }
+}
+
+TEST(softTimerTestSuite, restartAndStopTest) {
+    Soft_timer_list list;
+    Soft_timer first;
+    Soft_timer second;
+    soft_timer_list_init(&list, 0);
+    soft_timer_init(&first, NULL, NULL);
+    soft_timer_init(&second, NULL, NULL);
+
+    soft_timer_start(&list, &first, 10, 0);
+    soft_timer_start(&list, &second, 20, 0);
+    run_until(&list, 8);
+    // restarting works like the inter-byte timeout that is restarted at every received byte
+    soft_timer_start(&list, &first, 10, 0);
+    EXPECT_EQ(&second, list.first->next);
+    run_until(&list, 17);
+    EXPECT_FALSE(soft_timer_expired(&first));
+    run_until(&list, 18);
+    EXPECT_TRUE(soft_timer_expired(&first));
+
+    soft_timer_stop(&list, &second);
+    soft_timer_stop(&list, &second);
+    run_until(&list, 40);
+    EXPECT_FALSE(soft_timer_expired(&second));
+    EXPECT_EQ(NULL, list.first);
+}
+
+// Ticks at which the backoff timer expired
+static uint16_t backoff_ticks[8];
+static int backoff_count;
+
+// Callback that restarts its own timer with the double delay, until the delay would be larger than 8
+static void backoff_callback(Soft_timer *timer) {
+    Soft_timer_list *list = (Soft_timer_list *)timer->context;
+    backoff_ticks[backoff_count++ % 8] = list->now;
+    uint16_t delay = (uint16_t)(1u << backoff_count);
+    if (delay <= 8) {
+        soft_timer_start(list, timer, delay, 0);
+    }
+}
+
+// Callback that stops the timer in its context
+static void stop_other_callback(Soft_timer *timer) {
+    Soft_timer_list *list = (Soft_timer_list *)((void **)timer->context)[0];
+    Soft_timer *other = (Soft_timer *)((void **)timer->context)[1];
+    soft_timer_stop(list, other);
+}
+
+TEST(softTimerTestSuite, callbackTest) {
+    Soft_timer_list list;
+    Soft_timer backoff;
+    Soft_timer stopper;
+    Soft_timer periodic;
+    void *stopper_context[2] = {&list, &periodic};
+    soft_timer_list_init(&list, 0);
+    soft_timer_init(&backoff, backoff_callback, &list);
+    soft_timer_init(&stopper, stop_other_callback, stopper_context);
+    soft_timer_init(&periodic, NULL, NULL);
+
+    // the backoff timer expires at 1, 3, 7 and 15 and is then not restarted anymore
+    soft_timer_start(&list, &backoff, 1, 0);
+    soft_timer_start(&list, &periodic, 3, 3);
+    soft_timer_start(&list, &stopper, 10, 0);
+    backoff_count = 0;
+    run_until(&list, 40);
+    EXPECT_FALSE(backoff.running);
+    ASSERT_EQ(4, backoff_count);
+    EXPECT_EQ(1, backoff_ticks[0]);
+    EXPECT_EQ(3, backoff_ticks[1]);
+    EXPECT_EQ(7, backoff_ticks[2]);
+    EXPECT_EQ(15, backoff_ticks[3]);
+
+    // the periodic timer expired at 3, 6 and 9 before it was stopped at 10
+    EXPECT_EQ(3, periodic.expirations);
+    EXPECT_FALSE(periodic.running);
+    EXPECT_EQ(NULL, list.first);
+}
+
+TEST(softTimerTestSuite, skippedTicksTest) {
+    Soft_timer_list list;
+    Soft_timer periodic;
+    Soft_timer one_shot;
+    soft_timer_list_init(&list, 0);
+    soft_timer_init(&periodic, NULL, NULL);
+    soft_timer_init(&one_shot, NULL, NULL);
+
+    soft_timer_start(&list, &periodic, 10, 10);
+    soft_timer_start(&list, &one_shot, 25, 0);
+    // the tick is handled late, e.g. because interrupts were disabled for a while
+    soft_timer_tick(&list, 35);
+    EXPECT_EQ(3, periodic.expirations);
+    EXPECT_EQ(1, one_shot.expirations);
+    // the periodic timer keeps its phase
+    soft_timer_tick(&list, 39);
+    EXPECT_EQ(3, periodic.expirations);
+    soft_timer_tick(&list, 40);
+    EXPECT_EQ(4, periodic.expirations);
+}
+
+TEST(softTimerTestSuite, wrapAroundTest) {
+    Soft_timer_list list;
+    Soft_timer timers[3];
+    int ids[3] = {0, 1, 2};
+    soft_timer_list_init(&list, 65530);
+    for (int i = 0; i < 3; i++) {
+        soft_timer_init(&timers[i], record_expiry, &ids[i]);
+    }
+
+    soft_timer_start(&list, &timers[0], 20, 0);    // expires at 14
+    soft_timer_start(&list, &timers[1], 3, 0);     // expires at 65533
+    soft_timer_start(&list, &timers[2], 6, 0);     // expires at 0
+    expired_count = 0;
+    run_until(&list, 13);
+    EXPECT_EQ(2, expired_count);
+    EXPECT_EQ(1, expired_order[0]);
+    EXPECT_EQ(2, expired_order[1]);
+    run_until(&list, 14);
+    EXPECT_EQ(3, expired_count);
+    EXPECT_EQ(0, expired_order[2]);
+}
+
+TEST(softTimerTestSuite, rangeTest) {
+    Soft_timer_list list;
+    Soft_timer timer;
+    soft_timer_list_init(&list, 100);
+    soft_timer_init(&timer, NULL, NULL);
+
+    EXPECT_EQ(0, soft_timer_next_expiry(&list));
+    EXPECT_FALSE(soft_timer_start(&list, &timer, 0, 0));
+    EXPECT_FALSE(soft_timer_start(&list, &timer, SOFT_TIMER_MAX_DELAY + 1, 0));
+    EXPECT_FALSE(soft_timer_start(&list, &timer, 10, SOFT_TIMER_MAX_DELAY + 1));
+    EXPECT_FALSE(timer.running);
+
+    EXPECT_TRUE(soft_timer_start(&list, &timer, SOFT_TIMER_MAX_DELAY, 0));
+    EXPECT_EQ(SOFT_TIMER_MAX_DELAY, soft_timer_next_expiry(&list));
+    run_until(&list, (uint16_t)(100 + SOFT_TIMER_MAX_DELAY - 1));
+    EXPECT_EQ(1, soft_timer_next_expiry(&list));
+    EXPECT_FALSE(soft_timer_expired(&timer));
+    run_until(&list, (uint16_t)(100 + SOFT_TIMER_MAX_DELAY));
+    EXPECT_TRUE(soft_timer_expired(&timer));
+    EXPECT_EQ(0, soft_timer_next_expiry(&list));
+}
+
+// State of the simulated UART receiver, the callback of the inter-byte timeout throws the frame away
+static bool uart_frame_aborted;
+
+static void uart_timeout_callback(Soft_timer *timer) {
+    uart_frame_aborted = true;
+}
+
+TEST(softTimerTestSuite, concurrentTimeoutsTest) {
+    Soft_timer_list list;
+    Soft_timer arq_wait;
+    Soft_timer temperature;
+    Soft_timer uart_timeout;
+    Soft_timer quarter_second;
+    soft_timer_list_init(&list, 1000);
+    soft_timer_init(&arq_wait, NULL, NULL);
+    soft_timer_init(&temperature, NULL, NULL);
+    soft_timer_init(&uart_timeout, uart_timeout_callback, NULL);
+    soft_timer_init(&quarter_second, NULL, NULL);
+    uart_frame_aborted = false;
+
+    soft_timer_start(&list, &quarter_second, 250, 250);
+    soft_timer_start(&list, &arq_wait, 15, 0);
+    soft_timer_start(&list, &temperature, 16, 0);
+
+    uint16_t arq_expired_at = 0;
+    uint16_t temperature_expired_at = 0;
+    uint16_t uart_expired_at = 0;
+    for (uint16_t tick = 1001; tick <= 1500; tick++) {
+        // a byte arrives before every tick up to tick 1040, each byte restarts the inter-byte timeout
+        if (tick <= 1040) {
+            soft_timer_start(&list, &uart_timeout, 2, 0);
+        }
+        soft_timer_tick(&list, tick);
+        if (arq_expired_at == 0 && soft_timer_expired(&arq_wait)) {
+            arq_expired_at = tick;
+        }
+        if (temperature_expired_at == 0 && soft_timer_expired(&temperature)) {
+            temperature_expired_at = tick;
+        }
+        if (uart_expired_at == 0 && uart_frame_aborted) {
+            uart_expired_at = tick;
+        }
+    }
+
+    EXPECT_EQ(1015, arq_expired_at);
+    EXPECT_EQ(1016, temperature_expired_at);
+    // the last byte arrived between tick 1039 and 1040, the timeout of 2 ticks expires at tick 1041
+    EXPECT_EQ(1041, uart_expired_at);
+    EXPECT_EQ(2, quarter_second.expirations);
+    soft_timer_stop(&list, &quarter_second);
+    EXPECT_EQ(NULL, list.first);
+}
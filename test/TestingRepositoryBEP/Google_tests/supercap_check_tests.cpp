@@ -0,0 +1,242 @@
+/*
+ * supercap_check_tests.cpp file
+ *
+ * Testing file for the polled functionality check of the supercapacitors. The caps are simulated: a cap charges while
+ * its charge cap flag is on and the voltage pin reads the cap that is on its charge flag. Time is simulated in
+ * quarter seconds. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Parallel test: With a budget of three caps all caps charge together and are checked after 2 minutes.
+ * - Budget test: Never more caps charge at the same time than the budget, a waiting cap starts when a cap is checked.
+ * - Polling test: Polling before a cap charged long enough does nothing, every result is reported once when it is
+ *   known, polling after the check is done does nothing.
+ * - Fault test: A cap that does not reach the ready voltage and a failed conversion are not ready.
+ * - Isolation test: A cap is measured with the discharge flag on and only its own charge flag on.
+ * - Duration test: Reports the duration of the check compared with the former check that charged the caps one after
+ *   the other.
+ */
+
+#include "gtest/gtest.h"
+#include <system_health_lib/supercap_check.h>
+#include <cmath>
+#include <cstdio>
+
+// Simulated caps, the voltage after charging is final_voltage * (1 - e^(-t / tau))
+static bool charge_flag[SUPERCAP_COUNT];
+static bool discharge_flag;
+static float charged_quarters[SUPERCAP_COUNT];
+static float final_voltage[SUPERCAP_COUNT];
+static float tau_quarters[SUPERCAP_COUNT];
+static bool conversion_fails;
+
+// What the check did
+static int max_charging;
+static int isolation_errors;
+static int measurements;
+static int reported_cap[SUPERCAP_COUNT * 2];
+static bool reported_ready[SUPERCAP_COUNT * 2];
+static uint16_t reported_at[SUPERCAP_COUNT * 2];
+static int report_count;
+static uint16_t sim_quarters;
+
+static void sim_set_charge(uint8_t cap, bool on) {
+    charge_flag[cap] = on;
+    if (!on) {
+        return;
+    }
+    int charging = 0;
+    for (int i = 0; i < SUPERCAP_COUNT; i++) {
+        charging += charge_flag[i] ? 1 : 0;
+    }
+    if (charging > max_charging) {
+        max_charging = charging;
+    }
+}
+
+static void sim_set_discharge(bool on) {
+    discharge_flag = on;
+}
+
+static uint16_t sim_measure(void) {
+    measurements++;
+    int connected = -1;
+    int count = 0;
+    for (int i = 0; i < SUPERCAP_COUNT; i++) {
+        if (charge_flag[i]) {
+            connected = i;
+            count++;
+        }
+    }
+    if (count != 1 || !discharge_flag) {
+        isolation_errors++;
+        return 0;
+    }
+    if (conversion_fails) {
+        return 0xFFFF;
+    }
+    float voltage = final_voltage[connected] * (1.0f - expf(-charged_quarters[connected] / tau_quarters[connected]));
+    return (uint16_t)lroundf(voltage * 1000);
+}
+
+static void sim_report(uint8_t cap, bool ready) {
+    if (report_count < SUPERCAP_COUNT * 2) {
+        reported_cap[report_count] = cap;
+        reported_ready[report_count] = ready;
+        reported_at[report_count] = sim_quarters;
+    }
+    report_count++;
+}
+
+static const Supercap_check_hardware sim_hardware = {sim_set_charge, sim_set_discharge, sim_measure, sim_report};
+
+// Good caps reach 3.3 V, after 2 minutes they are at about 3.1 V
+static void reset_simulation(void) {
+    for (int i = 0; i < SUPERCAP_COUNT; i++) {
+        charge_flag[i] = true;
+        charged_quarters[i] = 0;
+        final_voltage[i] = 3.3f;
+        tau_quarters[i] = 160;
+    }
+    discharge_flag = true;
+    conversion_fails = false;
+    max_charging = 0;
+    isolation_errors = 0;
+    measurements = 0;
+    report_count = 0;
+    sim_quarters = 1000;
+}
+
+// Polls the check every quarter second, like the deployment task, until it is done or the time limit
+static uint16_t run_check(Supercap_check *check, uint8_t budget, uint16_t limit) {
+    uint16_t start = sim_quarters;
+    supercap_check_start(check, &sim_hardware, budget, sim_quarters);
+    while (!supercap_check_poll(check, sim_quarters) && (uint16_t)(sim_quarters - start) < limit) {
+        sim_quarters++;
+        for (int i = 0; i < SUPERCAP_COUNT; i++) {
+            if (charge_flag[i]) {
+                charged_quarters[i]++;
+            }
+        }
+    }
+    return (uint16_t)(sim_quarters - start);
+}
+
+TEST(supercapCheckTestSuite, parallelTest) {
+    reset_simulation();
+    Supercap_check check;
+    EXPECT_EQ(SUPERCAP_CHARGE_QUARTERS, run_check(&check, SUPERCAP_COUNT, 5000));
+    EXPECT_EQ(SUPERCAP_COUNT, max_charging);
+    ASSERT_EQ(SUPERCAP_COUNT, report_count);
+    for (int i = 0; i < SUPERCAP_COUNT; i++) {
+        EXPECT_EQ(i, reported_cap[i]);
+        EXPECT_TRUE(reported_ready[i]);
+        EXPECT_TRUE(check.ready[i]);
+        EXPECT_FALSE(charge_flag[i]);
+    }
+    EXPECT_FALSE(discharge_flag);
+}
+
+TEST(supercapCheckTestSuite, budgetTest) {
+    reset_simulation();
+    Supercap_check check;
+    EXPECT_EQ(2 * SUPERCAP_CHARGE_QUARTERS, run_check(&check, 2, 5000));
+    EXPECT_EQ(2, max_charging);
+    EXPECT_EQ(3, report_count);
+    EXPECT_EQ(2, reported_cap[2]);
+    EXPECT_EQ(1000 + 2 * SUPERCAP_CHARGE_QUARTERS, reported_at[2]);
+
+    reset_simulation();
+    EXPECT_EQ(3 * SUPERCAP_CHARGE_QUARTERS, run_check(&check, 1, 5000));
+    EXPECT_EQ(1, max_charging);
+
+    // a budget of 0 is taken as 1
+    reset_simulation();
+    EXPECT_EQ(3 * SUPERCAP_CHARGE_QUARTERS, run_check(&check, 0, 5000));
+    EXPECT_EQ(1, max_charging);
+}
+
+TEST(supercapCheckTestSuite, pollingTest) {
+    reset_simulation();
+    Supercap_check check;
+    supercap_check_start(&check, &sim_hardware, 2, 0);
+    EXPECT_FALSE(supercap_check_poll(&check, 0));
+    EXPECT_FALSE(supercap_check_poll(&check, SUPERCAP_CHARGE_QUARTERS - 1));
+    EXPECT_EQ(0, measurements);
+
+    // the first two caps are reported as soon as they charged, the third one is still charging
+    sim_quarters = SUPERCAP_CHARGE_QUARTERS;
+    EXPECT_FALSE(supercap_check_poll(&check, SUPERCAP_CHARGE_QUARTERS));
+    EXPECT_EQ(2, report_count);
+    EXPECT_EQ(SUPERCAP_CHARGING, check.state[2]);
+    EXPECT_TRUE(charge_flag[2]);
+
+    EXPECT_TRUE(supercap_check_poll(&check, 2 * SUPERCAP_CHARGE_QUARTERS));
+    EXPECT_TRUE(supercap_check_done(&check));
+    EXPECT_TRUE(supercap_check_poll(&check, 3 * SUPERCAP_CHARGE_QUARTERS));
+    EXPECT_EQ(3, report_count);
+    EXPECT_EQ(3, measurements);
+
+    // the quarter seconds wrap around during the check
+    reset_simulation();
+    supercap_check_start(&check, &sim_hardware, SUPERCAP_COUNT, 0xFF00);
+    EXPECT_FALSE(supercap_check_poll(&check, 0x0000));
+    EXPECT_TRUE(supercap_check_poll(&check, (uint16_t)(0xFF00 + SUPERCAP_CHARGE_QUARTERS)));
+}
+
+TEST(supercapCheckTestSuite, faultTest) {
+    reset_simulation();
+    Supercap_check check;
+    // cap 2 leaks and stays at 2 V
+    final_voltage[1] = 2.0f;
+    run_check(&check, SUPERCAP_COUNT, 5000);
+    EXPECT_TRUE(check.ready[0]);
+    EXPECT_FALSE(check.ready[1]);
+    EXPECT_TRUE(check.ready[2]);
+    EXPECT_FALSE(reported_ready[1]);
+
+    // a failed conversion reads 0xFFFF mV
+    reset_simulation();
+    conversion_fails = true;
+    run_check(&check, SUPERCAP_COUNT, 5000);
+    for (int i = 0; i < SUPERCAP_COUNT; i++) {
+        EXPECT_FALSE(check.ready[i]);
+    }
+}
+
+TEST(supercapCheckTestSuite, isolationTest) {
+    reset_simulation();
+    Supercap_check check;
+    // all flags are switched off at the start
+    supercap_check_start(&check, &sim_hardware, 1, sim_quarters);
+    EXPECT_TRUE(charge_flag[0]);
+    EXPECT_FALSE(charge_flag[1]);
+    EXPECT_FALSE(charge_flag[2]);
+    EXPECT_FALSE(discharge_flag);
+
+    reset_simulation();
+    run_check(&check, SUPERCAP_COUNT, 5000);
+    EXPECT_EQ(3, measurements);
+    EXPECT_EQ(0, isolation_errors);
+}
+
+TEST(supercapCheckTestSuite, durationTest) {
+    // the former check charged the caps one after the other, 2 minutes per cap
+    uint32_t former_quarters = SUPERCAP_COUNT * SUPERCAP_CHARGE_QUARTERS;
+    uint16_t budget_quarters[SUPERCAP_COUNT + 1];
+    Supercap_check check;
+    for (uint8_t budget = 1; budget <= SUPERCAP_COUNT; budget++) {
+        reset_simulation();
+        budget_quarters[budget] = run_check(&check, budget, 5000);
+        EXPECT_EQ(0, isolation_errors);
+        EXPECT_EQ(3, report_count);
+    }
+
+    printf("[   INFO   ] supercap check duration: former %.1f s, budget 1 %.1f s, budget 2 %.1f s, budget 3 %.1f s\n",
+           former_quarters / 4.0, budget_quarters[1] / 4.0, budget_quarters[2] / 4.0, budget_quarters[3] / 4.0);
+
+    EXPECT_EQ(former_quarters, budget_quarters[1]);
+    EXPECT_LT(budget_quarters[2], former_quarters);
+    EXPECT_EQ(SUPERCAP_CHARGE_QUARTERS, budget_quarters[SUPERCAP_COUNT]);
+}
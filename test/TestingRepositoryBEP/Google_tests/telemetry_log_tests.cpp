@@ -0,0 +1,635 @@
+/*
+ * telemetry_log_tests.cpp file
+ *
+ * Testing file for the store-and-forward telemetry log. The FRAM block is simulated by a file that is mapped into
+ * memory with mmap: a reset unmaps and maps the file again, what was written stays like it does in FRAM. Below is a
+ * list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Size test: A block that is too small or has no index slots is refused, a new block is an empty log.
+ * - Append test: Entries of every payload length are read back with their sequence numbers and times, payloads that
+ *   are empty or too large are refused.
+ * - Wrap test: When the ring is full the oldest entries are overwritten, the log keeps the newest entries without gaps.
+ * - Reset test: The log is found again after a reset, the sequence numbers go on and the times keep going up.
+ * - Seek sequence test: For every sequence number in and around the log the cursor lands on the same entry as a walk
+ *   from the oldest entry, most searches start from an index slot.
+ * - Seek time test: For every time in and around the log the cursor lands on the first entry with at least that time,
+ *   also with entries that have the same time. Reports how many searches used the index.
+ * - Power cut test: The power fails after every byte of many appends, with the ring wrapping and index slots being
+ *   written. After the reset the log holds either the old entries or the old entries plus the new one, without gaps,
+ *   at most the oldest entries that had to make room are gone, and searching still works.
+ * - Torn index test: An index slot that points to the wrong place, is torn or still holds an overwritten entry is not
+ *   trusted, the search walks instead.
+ * - Damaged entry test: After a reset the log ends in front of an entry whose bytes are damaged.
+ * - Acknowledge test: The acknowledged sequence number only moves forward, stays within the log and survives a reset.
+ * - Replay test: The lander commands select entries by sequence number, by time and the unacknowledged backlog, the
+ *   frames hold as many entries as fit and end with FINISHED. Wrong commands are refused.
+ * - Replay restore test: A frame that cannot be sent yet is built again the same after restoring the replay.
+ */
+
+#include "gtest/gtest.h"
+#include <lander_communication_lib/telemetry_log.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// FRAM block simulated by a memory mapped file
+typedef struct {
+    char path[32];
+    int fd;
+    uint8_t *block;
+    uint16_t size;
+} Fram_file;
+
+// Entry as the tests expect it
+typedef struct {
+    uint32_t seq;
+    uint32_t time;
+    std::vector<uint8_t> payload;
+} Expected_entry;
+
+// Context of the write function that cuts the power after an amount of bytes
+typedef struct {
+    uint32_t written;       // bytes written so far
+    uint32_t budget;        // bytes that reach the FRAM before the power fails
+} Write_budget;
+
+static void fram_map(Fram_file *fram, void *address, int flags) {
+    void *block = mmap(address, fram->size, PROT_READ | PROT_WRITE, MAP_SHARED | flags, fram->fd, 0);
+    ASSERT_NE(MAP_FAILED, block);
+    fram->block = (uint8_t *)block;
+}
+
+static void fram_open(Fram_file *fram, uint16_t size) {
+    strcpy(fram->path, "/tmp/telemetry_log_XXXXXX");
+    fram->fd = mkstemp(fram->path);
+    ASSERT_GE(fram->fd, 0);
+    ASSERT_EQ(0, ftruncate(fram->fd, size));
+    fram->size = size;
+    fram_map(fram, NULL, 0);
+}
+
+// A reset: the memory is unmapped and mapped again at the same address like FRAM, the file keeps what was written
+static void fram_reset(Fram_file *fram) {
+    munmap(fram->block, fram->size);
+    fram_map(fram, fram->block, MAP_FIXED);
+}
+
+static void fram_close(Fram_file *fram) {
+    munmap(fram->block, fram->size);
+    close(fram->fd);
+    unlink(fram->path);
+}
+
+// Writes byte by byte and drops every byte after the budget, like FRAM when the power fails
+static void budget_write(Telemetry_log *log, uint8_t *destination, const uint8_t *source, uint16_t length) {
+    Write_budget *budget = (Write_budget *)log->context;
+    for (uint16_t i = 0; i < length; i++) {
+        if (budget->written < budget->budget) {
+            destination[i] = source[i];
+        }
+        budget->written++;
+    }
+}
+
+// Payload of an entry, 1 to TELEMETRY_LOG_MAX_PAYLOAD bytes depending on its sequence number
+static uint8_t payload_of(uint32_t seq, uint8_t *payload) {
+    uint8_t length = (uint8_t)(1 + (seq * 5) % TELEMETRY_LOG_MAX_PAYLOAD);
+    for (uint8_t i = 0; i < length; i++) {
+        payload[i] = (uint8_t)(seq * 31 + i * 7);
+    }
+    return length;
+}
+
+// Time given to the log for an entry, some entries share their time
+static uint32_t now_of(uint32_t seq) {
+    return seq * 3 / 2;
+}
+
+/*
+ * Appends the entry with the next sequence number and adds it to the expected entries.
+ */
+static void append_next(Telemetry_log *log, std::vector<Expected_entry> &expected) {
+    uint8_t payload[TELEMETRY_LOG_MAX_PAYLOAD];
+    uint32_t seq = log->control.next_seq;
+    uint8_t length = payload_of(seq, payload);
+    ASSERT_TRUE(telemetry_log_append(log, payload, length, now_of(seq)));
+    ASSERT_EQ(seq + 1, log->control.next_seq);
+    Expected_entry entry = {seq, log->control.last_time, std::vector<uint8_t>(payload, payload + length)};
+    ASSERT_EQ(seq, expected.size());
+    expected.push_back(entry);
+}
+
+/*
+ * Reads the log from the oldest entry on and compares every entry with the expected ones.
+ */
+static void check_entries(Telemetry_log *log, const std::vector<Expected_entry> &expected) {
+    Telemetry_log_cursor cursor;
+    Telemetry_log_entry entry;
+    telemetry_log_seek_seq(log, 0, &cursor);
+    ASSERT_EQ(log->control.tail_seq, cursor.seq);
+    uint32_t count = 0;
+    while (telemetry_log_read(log, &cursor, &entry)) {
+        ASSERT_LT(entry.seq, expected.size());
+        const Expected_entry &reference = expected[entry.seq];
+        ASSERT_EQ(log->control.tail_seq + count, entry.seq);
+        ASSERT_EQ(reference.time, entry.time) << "entry " << entry.seq;
+        ASSERT_EQ(reference.payload.size(), entry.length) << "entry " << entry.seq;
+        ASSERT_EQ(0, memcmp(reference.payload.data(), entry.payload, entry.length)) << "entry " << entry.seq;
+        count++;
+    }
+    ASSERT_EQ(telemetry_log_count(log), count);
+    ASSERT_EQ(log->control.next_seq, cursor.seq);
+}
+
+/*
+ * Compares telemetry_log_seek_seq and telemetry_log_seek_time with a walk for every sequence number and time in and
+ * around the log.
+ */
+static void check_seeks(Telemetry_log *log, const std::vector<Expected_entry> &expected) {
+    Telemetry_log_cursor cursor;
+    Telemetry_log_entry entry;
+    uint32_t tail = log->control.tail_seq;
+    uint32_t next = log->control.next_seq;
+    for (uint32_t seq = tail > 20 ? tail - 20 : 0; seq <= next + 20; seq++) {
+        telemetry_log_seek_seq(log, seq, &cursor);
+        uint32_t target = seq < tail ? tail : (seq > next ? next : seq);
+        ASSERT_EQ(target, cursor.seq) << "sequence number " << seq;
+        if (target < next) {
+            ASSERT_TRUE(telemetry_log_read(log, &cursor, &entry));
+            ASSERT_EQ(target, entry.seq);
+        } else {
+            ASSERT_FALSE(telemetry_log_read(log, &cursor, &entry));
+        }
+    }
+    if (tail == next) {
+        return;
+    }
+    uint32_t first_time = expected[tail].time;
+    uint32_t last_time = expected[next - 1].time;
+    for (uint32_t time = first_time > 5 ? first_time - 5 : 0; time <= last_time + 5; time++) {
+        // the first entry with at least the time
+        uint32_t target = tail;
+        while (target < next && expected[target].time < time) {
+            target++;
+        }
+        telemetry_log_seek_time(log, time, &cursor);
+        ASSERT_EQ(target, cursor.seq) << "time " << time;
+    }
+}
+
+/*
+ * Splits the payload of an ENTRIES frame into its entries.
+ */
+static std::vector<Expected_entry> parse_entries(const uint8_t *payload, uint8_t length) {
+    std::vector<Expected_entry> entries;
+    EXPECT_EQ(TELEMETRY_LOG_ENTRIES, payload[0]);
+    uint8_t position = 1;
+    while (position < length) {
+        Expected_entry entry;
+        entry.seq = (uint32_t)payload[position] << 24 | (uint32_t)payload[position + 1] << 16 |
+                    (uint32_t)payload[position + 2] << 8 | payload[position + 3];
+        entry.time = (uint32_t)payload[position + 4] << 24 | (uint32_t)payload[position + 5] << 16 |
+                     (uint32_t)payload[position + 6] << 8 | payload[position + 7];
+        uint8_t entry_length = payload[position + 8];
+        position = (uint8_t)(position + TELEMETRY_LOG_REPLAY_HEADER_SIZE);
+        entry.payload.assign(payload + position, payload + position + entry_length);
+        position = (uint8_t)(position + entry_length);
+        entries.push_back(entry);
+    }
+    EXPECT_EQ(length, position);
+    return entries;
+}
+
+/*
+ * Runs a replay to its end and returns the sequence numbers it sent, checking every entry against the expected ones
+ * and the FINISHED frame.
+ */
+static std::vector<uint32_t> run_replay(Telemetry_log *log, Telemetry_log_replay *replay,
+                                        const std::vector<Expected_entry> &expected, uint8_t size) {
+    std::vector<uint32_t> sent;
+    uint8_t payload[255];
+    for (;;) {
+        uint8_t length = telemetry_log_replay_next(log, replay, payload, size);
+        EXPECT_LE(length, size);
+        EXPECT_NE(0, length);
+        if (length == 0 || payload[0] == TELEMETRY_LOG_FINISHED) {
+            EXPECT_EQ(5, length);
+            uint32_t next = (uint32_t)payload[1] << 24 | (uint32_t)payload[2] << 16 | (uint32_t)payload[3] << 8 |
+                            payload[4];
+            EXPECT_EQ(log->control.next_seq, next);
+            break;
+        }
+        std::vector<Expected_entry> entries = parse_entries(payload, length);
+        EXPECT_FALSE(entries.empty());
+        for (const Expected_entry &entry : entries) {
+            EXPECT_EQ(expected[entry.seq].time, entry.time);
+            EXPECT_EQ(expected[entry.seq].payload, entry.payload);
+            sent.push_back(entry.seq);
+        }
+    }
+    EXPECT_FALSE(replay->active);
+    EXPECT_EQ(0, telemetry_log_replay_next(log, replay, payload, size));
+    return sent;
+}
+
+static std::vector<uint32_t> sequence(uint32_t first, uint32_t end) {
+    std::vector<uint32_t> numbers;
+    for (uint32_t seq = first; seq < end; seq++) {
+        numbers.push_back(seq);
+    }
+    return numbers;
+}
+
+TEST(telemetryLogTestSuite, sizeTest) {
+    Fram_file fram;
+    fram_open(&fram, 1024);
+    Telemetry_log log;
+    uint32_t overhead = telemetry_log_block_size(0, 4);
+    EXPECT_EQ(overhead + 500, telemetry_log_block_size(500, 4));
+    EXPECT_FALSE(telemetry_log_open(&log, fram.block, (uint16_t)(overhead + 20), 4, NULL));
+    EXPECT_FALSE(telemetry_log_open(&log, fram.block, fram.size, 0, NULL));
+    ASSERT_TRUE(telemetry_log_open(&log, fram.block, fram.size, 4, NULL));
+    EXPECT_EQ(0u, telemetry_log_count(&log));
+    EXPECT_EQ(0u, log.control.next_seq);
+    EXPECT_EQ(0, log.statistics.recovered);
+    EXPECT_EQ(fram.size - overhead, log.ring_size);
+    fram_close(&fram);
+}
+
+TEST(telemetryLogTestSuite, appendTest) {
+    Fram_file fram;
+    fram_open(&fram, 4096);
+    Telemetry_log log;
+    ASSERT_TRUE(telemetry_log_open(&log, fram.block, fram.size, 8, NULL));
+    std::vector<Expected_entry> expected;
+    for (uint32_t i = 0; i < 100; i++) {
+        append_next(&log, expected);
+    }
+    EXPECT_EQ(100u, telemetry_log_count(&log));
+    EXPECT_EQ(0, log.statistics.overwritten);
+    check_entries(&log, expected);
+
+    uint8_t payload[TELEMETRY_LOG_MAX_PAYLOAD + 1] = {0};
+    EXPECT_FALSE(telemetry_log_append(&log, payload, 0, 1000));
+    EXPECT_FALSE(telemetry_log_append(&log, payload, TELEMETRY_LOG_MAX_PAYLOAD + 1, 1000));
+    EXPECT_EQ(100u, telemetry_log_count(&log));
+
+    // a time that goes back is kept at the time of the newest entry
+    uint32_t last_time = log.control.last_time;
+    ASSERT_TRUE(telemetry_log_append(&log, payload, 1, 0));
+    EXPECT_EQ(last_time, log.control.last_time);
+
+    telemetry_log_clear(&log);
+    EXPECT_EQ(0u, telemetry_log_count(&log));
+    EXPECT_EQ(101u, log.control.next_seq);
+    fram_close(&fram);
+}
+
+TEST(telemetryLogTestSuite, wrapTest) {
+    Fram_file fram;
+    fram_open(&fram, 600);
+    Telemetry_log log;
+    ASSERT_TRUE(telemetry_log_open(&log, fram.block, fram.size, 4, NULL));
+    std::vector<Expected_entry> expected;
+    for (uint32_t i = 0; i < 2000; i++) {
+        append_next(&log, expected);
+        ASSERT_LT(telemetry_log_count(&log), 2000u);
+    }
+    uint32_t count = telemetry_log_count(&log);
+    EXPECT_GT(count, 20u);
+    EXPECT_EQ(2000u, log.control.next_seq);
+    EXPECT_EQ(2000u - count, log.statistics.overwritten);
+    check_entries(&log, expected);
+    printf("[   INFO   ] a ring of %u bytes holds the newest %u of 2000 entries\n", log.ring_size, count);
+    fram_close(&fram);
+}
+
+TEST(telemetryLogTestSuite, resetTest) {
+    Fram_file fram;
+    fram_open(&fram, 2048);
+    Telemetry_log log;
+    ASSERT_TRUE(telemetry_log_open(&log, fram.block, fram.size, 8, NULL));
+    std::vector<Expected_entry> expected;
+    for (uint32_t i = 0; i < 300; i++) {
+        append_next(&log, expected);
+    }
+    telemetry_log_acknowledge(&log, 250);
+    Telemetry_log_control control = log.control;
+
+    fram_reset(&fram);
+    Telemetry_log recovered;
+    ASSERT_TRUE(telemetry_log_open(&recovered, fram.block, fram.size, 8, NULL));
+    EXPECT_EQ(1, recovered.statistics.recovered);
+    EXPECT_EQ(0, recovered.statistics.truncated);
+    EXPECT_EQ(control.tail_seq, recovered.control.tail_seq);
+    EXPECT_EQ(control.next_seq, recovered.control.next_seq);
+    EXPECT_EQ(250u, recovered.control.acked_seq);
+    check_entries(&recovered, expected);
+
+    // the caller starts counting again at 0, the times of the log go on from the newest entry
+    uint8_t payload[1] = {0x42};
+    ASSERT_TRUE(telemetry_log_append(&recovered, payload, 1, 7));
+    EXPECT_EQ(301u, recovered.control.next_seq);
+    EXPECT_EQ(control.last_time + 7, recovered.control.last_time);
+    fram_close(&fram);
+}
+
+TEST(telemetryLogTestSuite, seekSeqTest) {
+    Fram_file fram;
+    fram_open(&fram, 3000);
+    Telemetry_log log;
+    ASSERT_TRUE(telemetry_log_open(&log, fram.block, fram.size, 32, NULL));
+    std::vector<Expected_entry> expected;
+    check_seeks(&log, expected);
+    for (uint32_t i = 0; i < 1500; i++) {
+        append_next(&log, expected);
+        if (i % 97 == 0) {
+            check_seeks(&log, expected);
+        }
+    }
+    log.statistics.index_hits = 0;
+    log.statistics.index_misses = 0;
+    check_seeks(&log, expected);
+    EXPECT_GT(log.statistics.index_hits, 0);
+    EXPECT_EQ(0, log.statistics.index_misses);
+    fram_close(&fram);
+}
+
+TEST(telemetryLogTestSuite, seekTimeTest) {
+    Fram_file fram;
+    fram_open(&fram, 8192);
+    Telemetry_log log;
+    ASSERT_TRUE(telemetry_log_open(&log, fram.block, fram.size, 64, NULL));
+    std::vector<Expected_entry> expected;
+    for (uint32_t i = 0; i < 3000; i++) {
+        append_next(&log, expected);
+    }
+    log.statistics.index_hits = 0;
+    log.statistics.index_misses = 0;
+    check_seeks(&log, expected);
+    EXPECT_GT(log.statistics.index_hits, 0);
+    EXPECT_EQ(0, log.statistics.index_misses);
+    printf("[   INFO   ] %u entries of %u in the log, %u searches started from an index slot\n",
+           telemetry_log_count(&log), 3000, log.statistics.index_hits);
+    fram_close(&fram);
+}
+
+TEST(telemetryLogTestSuite, powerCutTest) {
+    Fram_file fram;
+    fram_open(&fram, 400);
+    Telemetry_log log;
+    ASSERT_TRUE(telemetry_log_open(&log, fram.block, fram.size, 3, NULL));
+    std::vector<Expected_entry> expected;
+    for (uint32_t i = 0; i < 60; i++) {
+        append_next(&log, expected);
+    }
+
+    std::vector<uint8_t> snapshot(fram.size);
+    uint32_t cuts = 0;
+    for (uint32_t append = 0; append < 60; append++) {
+        memcpy(snapshot.data(), fram.block, fram.size);
+        Telemetry_log before = log;
+
+        // the whole append, to know its bytes and its result
+        Write_budget budget = {0, UINT32_MAX};
+        log.write = budget_write;
+        log.context = &budget;
+        append_next(&log, expected);
+        uint32_t bytes = budget.written;
+        uint32_t full_tail = log.control.tail_seq;
+        std::vector<uint8_t> after(fram.block, fram.block + fram.size);
+
+        for (uint32_t cut = 0; cut < bytes; cut++) {
+            memcpy(fram.block, snapshot.data(), fram.size);
+            Telemetry_log cut_log = before;
+            Write_budget cut_budget = {0, cut};
+            cut_log.write = budget_write;
+            cut_log.context = &cut_budget;
+            uint8_t payload[TELEMETRY_LOG_MAX_PAYLOAD];
+            uint8_t length = payload_of(before.control.next_seq, payload);
+            telemetry_log_append(&cut_log, payload, length, now_of(before.control.next_seq));
+
+            fram_reset(&fram);
+            Telemetry_log recovered;
+            ASSERT_TRUE(telemetry_log_open(&recovered, fram.block, fram.size, 3, NULL));
+            uint32_t next = recovered.control.next_seq;
+            ASSERT_TRUE(next == before.control.next_seq || next == before.control.next_seq + 1)
+                << "append " << append << " cut after " << cut << " bytes";
+            ASSERT_GE(recovered.control.tail_seq, before.control.tail_seq);
+            ASSERT_LE(recovered.control.tail_seq, full_tail);
+            check_entries(&recovered, expected);
+            check_seeks(&recovered, expected);
+
+            // the log goes on after the reset
+            ASSERT_TRUE(telemetry_log_append(&recovered, payload, 1, 0));
+            ASSERT_EQ(next + 1, recovered.control.next_seq);
+            cuts++;
+        }
+
+        // go on from the whole append
+        memcpy(fram.block, after.data(), fram.size);
+        log.write = NULL;
+        log.context = NULL;
+    }
+    EXPECT_GT(log.statistics.overwritten, 0);
+    printf("[   INFO   ] %u power cuts, every log was recovered\n", cuts);
+    fram_close(&fram);
+}
+
+TEST(telemetryLogTestSuite, tornIndexTest) {
+    Fram_file fram;
+    fram_open(&fram, 4096);
+    Telemetry_log log;
+    ASSERT_TRUE(telemetry_log_open(&log, fram.block, fram.size, 16, NULL));
+    std::vector<Expected_entry> expected;
+    for (uint32_t i = 0; i < 600; i++) {
+        append_next(&log, expected);
+    }
+    // the first indexed entries in the log
+    uint32_t indexed = (log.control.tail_seq + 2 * TELEMETRY_LOG_INDEX_INTERVAL) & ~(TELEMETRY_LOG_INDEX_INTERVAL - 1u);
+    ASSERT_LT(indexed + 2 * TELEMETRY_LOG_INDEX_INTERVAL, log.control.next_seq);
+    uint16_t slot_size = sizeof(Telemetry_log_index_slot);
+    Telemetry_log_index_slot slot;
+
+    // the first slot points into the middle of another entry
+    uint8_t *slot_bytes = &log.index[(indexed / TELEMETRY_LOG_INDEX_INTERVAL % log.index_slots) * slot_size];
+    memcpy(&slot, slot_bytes, slot_size);
+    ASSERT_EQ(indexed, slot.seq);
+    slot.offset = (uint16_t)(slot.offset + 3);
+    memcpy(slot_bytes, &slot, slot_size);
+    // the second slot is torn halfway
+    indexed += TELEMETRY_LOG_INDEX_INTERVAL;
+    slot_bytes = &log.index[(indexed / TELEMETRY_LOG_INDEX_INTERVAL % log.index_slots) * slot_size];
+    memset(&slot_bytes[slot_size / 2], 0xA5, slot_size / 2);
+    // the third slot still holds the overwritten entry that used the slot before
+    indexed += TELEMETRY_LOG_INDEX_INTERVAL;
+    slot_bytes = &log.index[(indexed / TELEMETRY_LOG_INDEX_INTERVAL % log.index_slots) * slot_size];
+    memcpy(&slot, slot_bytes, slot_size);
+    slot.seq = indexed - log.index_slots * TELEMETRY_LOG_INDEX_INTERVAL;
+    ASSERT_LT(slot.seq, log.control.tail_seq);
+    memcpy(slot_bytes, &slot, slot_size);
+
+    log.statistics.index_misses = 0;
+    check_seeks(&log, expected);
+    EXPECT_GT(log.statistics.index_misses, 0);
+    fram_close(&fram);
+}
+
+TEST(telemetryLogTestSuite, damagedEntryTest) {
+    Fram_file fram;
+    fram_open(&fram, 4096);
+    Telemetry_log log;
+    ASSERT_TRUE(telemetry_log_open(&log, fram.block, fram.size, 8, NULL));
+    std::vector<Expected_entry> expected;
+    for (uint32_t i = 0; i < 100; i++) {
+        append_next(&log, expected);
+    }
+
+    // a payload byte of entry 70
+    Telemetry_log_cursor cursor;
+    telemetry_log_seek_seq(&log, 70, &cursor);
+    log.ring[cursor.offset + TELEMETRY_LOG_ENTRY_HEADER_SIZE] ^= 0x01;
+
+    fram_reset(&fram);
+    Telemetry_log recovered;
+    ASSERT_TRUE(telemetry_log_open(&recovered, fram.block, fram.size, 8, NULL));
+    EXPECT_EQ(1, recovered.statistics.truncated);
+    EXPECT_EQ(70u, recovered.control.next_seq);
+    EXPECT_EQ(70u, telemetry_log_count(&recovered));
+    check_entries(&recovered, expected);
+
+    // the sequence numbers go on where the log ends
+    expected.resize(70);
+    append_next(&recovered, expected);
+    check_entries(&recovered, expected);
+    fram_close(&fram);
+}
+
+TEST(telemetryLogTestSuite, acknowledgeTest) {
+    Fram_file fram;
+    fram_open(&fram, 2048);
+    Telemetry_log log;
+    ASSERT_TRUE(telemetry_log_open(&log, fram.block, fram.size, 8, NULL));
+    std::vector<Expected_entry> expected;
+    for (uint32_t i = 0; i < 50; i++) {
+        append_next(&log, expected);
+    }
+    EXPECT_EQ(0u, log.control.acked_seq);
+    telemetry_log_acknowledge(&log, 20);
+    EXPECT_EQ(20u, log.control.acked_seq);
+    telemetry_log_acknowledge(&log, 10);
+    EXPECT_EQ(20u, log.control.acked_seq);
+    telemetry_log_acknowledge(&log, 1000);
+    EXPECT_EQ(50u, log.control.acked_seq);
+
+    fram_reset(&fram);
+    Telemetry_log recovered;
+    ASSERT_TRUE(telemetry_log_open(&recovered, fram.block, fram.size, 8, NULL));
+    EXPECT_EQ(50u, recovered.control.acked_seq);
+    fram_close(&fram);
+}
+
+TEST(telemetryLogTestSuite, replayTest) {
+    Fram_file fram;
+    fram_open(&fram, 4096);
+    Telemetry_log log;
+    ASSERT_TRUE(telemetry_log_open(&log, fram.block, fram.size, 8, NULL));
+    std::vector<Expected_entry> expected;
+    for (uint32_t i = 0; i < 400; i++) {
+        append_next(&log, expected);
+    }
+    uint32_t tail = log.control.tail_seq;
+    ASSERT_GT(tail, 0u);
+    Telemetry_log_replay replay;
+    telemetry_log_replay_init(&replay);
+    uint8_t payload[8];
+    EXPECT_EQ(0, telemetry_log_replay_next(&log, &replay, payload, sizeof(payload)));
+
+    // entries 300 to 339
+    const uint8_t by_sequence[] = {TELEMETRY_LOG_SEQUENCE, 0, 0, 300 >> 8, 300 & 0xFF, 0, 40};
+    ASSERT_TRUE(telemetry_log_command(&log, &replay, by_sequence, sizeof(by_sequence)));
+    EXPECT_EQ(sequence(300, 340), run_replay(&log, &replay, expected, 96));
+
+    // from an overwritten entry on, the replay starts at the oldest one
+    const uint8_t from_start[] = {TELEMETRY_LOG_SEQUENCE, 0, 0, 0, 0, 0xFF, 0xFF};
+    ASSERT_TRUE(telemetry_log_command(&log, &replay, from_start, sizeof(from_start)));
+    EXPECT_EQ(sequence(tail, 400), run_replay(&log, &replay, expected, 26));
+
+    // the times 450 to 480 are entries 300 to 320
+    const uint8_t by_time[] = {TELEMETRY_LOG_TIME, 0, 0, 450 >> 8, 450 & 0xFF, 0, 0, 480 >> 8, 480 & 0xFF};
+    ASSERT_TRUE(telemetry_log_command(&log, &replay, by_time, sizeof(by_time)));
+    EXPECT_EQ(sequence(300, 321), run_replay(&log, &replay, expected, 255));
+
+    // the backlog follows the entries that are added while it is sent
+    const uint8_t ack[] = {TELEMETRY_LOG_ACK, 0, 0, 380 >> 8, 380 & 0xFF};
+    ASSERT_TRUE(telemetry_log_command(&log, &replay, ack, sizeof(ack)));
+    EXPECT_EQ(380u, log.control.acked_seq);
+    const uint8_t backlog[] = {TELEMETRY_LOG_BACKLOG};
+    ASSERT_TRUE(telemetry_log_command(&log, &replay, backlog, sizeof(backlog)));
+    uint8_t frame[96];
+    uint8_t length = telemetry_log_replay_next(&log, &replay, frame, sizeof(frame));
+    std::vector<Expected_entry> first_frame = parse_entries(frame, length);
+    ASSERT_FALSE(first_frame.empty());
+    EXPECT_EQ(380u, first_frame[0].seq);
+    for (uint32_t i = 0; i < 10; i++) {
+        append_next(&log, expected);
+    }
+    EXPECT_EQ(sequence(first_frame.back().seq + 1, 410), run_replay(&log, &replay, expected, sizeof(frame)));
+
+    // stop
+    ASSERT_TRUE(telemetry_log_command(&log, &replay, backlog, sizeof(backlog)));
+    const uint8_t stop[] = {TELEMETRY_LOG_STOP};
+    ASSERT_TRUE(telemetry_log_command(&log, &replay, stop, sizeof(stop)));
+    EXPECT_EQ(0, telemetry_log_replay_next(&log, &replay, frame, sizeof(frame)));
+
+    // wrong commands
+    EXPECT_FALSE(telemetry_log_command(&log, &replay, by_sequence, sizeof(by_sequence) - 1));
+    EXPECT_FALSE(telemetry_log_command(&log, &replay, by_time, sizeof(by_time) - 1));
+    EXPECT_FALSE(telemetry_log_command(&log, &replay, ack, 1));
+    EXPECT_FALSE(telemetry_log_command(&log, &replay, by_sequence, 0));
+    const uint8_t unknown[] = {'Q'};
+    EXPECT_FALSE(telemetry_log_command(&log, &replay, unknown, sizeof(unknown)));
+    EXPECT_FALSE(replay.active);
+    fram_close(&fram);
+}
+
+TEST(telemetryLogTestSuite, replayRestoreTest) {
+    Fram_file fram;
+    fram_open(&fram, 4096);
+    Telemetry_log log;
+    ASSERT_TRUE(telemetry_log_open(&log, fram.block, fram.size, 8, NULL));
+    std::vector<Expected_entry> expected;
+    for (uint32_t i = 0; i < 100; i++) {
+        append_next(&log, expected);
+    }
+    Telemetry_log_replay replay;
+    telemetry_log_replay_init(&replay);
+    telemetry_log_replay_backlog(&log, &replay);
+
+    // the transmission queue is full every other time, the frame is built again
+    std::vector<uint32_t> sent;
+    uint8_t frame[64];
+    uint8_t again[64];
+    for (;;) {
+        Telemetry_log_replay previous = replay;
+        uint8_t length = telemetry_log_replay_next(&log, &replay, frame, sizeof(frame));
+        replay = previous;
+        ASSERT_EQ(length, telemetry_log_replay_next(&log, &replay, again, sizeof(again)));
+        ASSERT_EQ(0, memcmp(frame, again, length));
+        if (again[0] == TELEMETRY_LOG_FINISHED) {
+            break;
+        }
+        for (const Expected_entry &entry : parse_entries(again, length)) {
+            sent.push_back(entry.seq);
+        }
+    }
+    EXPECT_EQ(sequence(0, 100), sent);
+    EXPECT_EQ(100, replay.sent_entries);
+    fram_close(&fram);
+}
@@ -0,0 +1,223 @@
+/*
+ * telemetry_tests.cpp file
+ *
+ * Testing file for the telemetry catalog, its ASCII and binary encoding and the host side decoder. Multiple tests are executed here to demonstrate that the telemetry behaves as expected. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Binary event test: An event is sent as its 1 byte ID in a MSG_TYPE_TELEMETRY frame.
+ * - ASCII event test: An event is sent as its catalog message with its original message type.
+ * - Binary measurement test: A measurement is its ID followed by a 16-bit value, high byte first.
+ * - ASCII measurement test: A measurement is a decimal number followed by its description, also the active fraction
+ *   of the CPU in a transit mode.
+ * - Format value test: Fixed-point values are written with the right amount of decimals and sign.
+ * - Unknown ID test: IDs outside the catalog are refused.
+ * - Decode round trip test: The decoder turns every binary event and measurement into the text of ASCII telemetry.
+ * - Several records test: A telemetry frame with several records is decoded record by record.
+ * - Broken record test: Unknown and incomplete records are reported.
+ * - Savings report: Reports the bytes on the wire for every event in ASCII and binary telemetry.
+ */
+
+#include "gtest/gtest.h"
+#include "lander_communication.h"
+#include "telemetry_decoder.h"
+#include <lander_communication_lib/telemetry.h>
+#include <cstdio>
+#include <cstring>
+
+// Joins the segments of a telemetry frame into a Message, like send_messagev puts them on the wire
+static void frame_to_message(const Telemetry_frame *frame, Message *msg) {
+    msg->start_byte = MSG_START_BYTE;
+    msg->msg_type = frame->msg_type;
+    msg->length = 0;
+    for (uint8_t i = 0; i < frame->segment_count; i++) {
+        memcpy(&msg->payload[msg->length], frame->segments[i].data, frame->segments[i].length);
+        msg->length += frame->segments[i].length;
+    }
+    msg->checksum = calculate_checksum_helper(msg->msg_type, msg->length, msg->payload);
+    msg->end_byte = MSG_END_BYTE;
+}
+
+TEST(telemetryTestSuite, binaryEventTest) {
+    Telemetry_frame frame;
+    Message msg;
+    ASSERT_TRUE(telemetry_encode_event(TELEMETRY_BINARY, EVENT_SUPERCAP3_NOT_READY, &frame));
+    frame_to_message(&frame, &msg);
+
+    EXPECT_EQ(MSG_TYPE_TELEMETRY, msg.msg_type);
+    EXPECT_EQ(1, msg.length);
+    EXPECT_EQ(EVENT_SUPERCAP3_NOT_READY, msg.payload[0]);
+}
+
+TEST(telemetryTestSuite, asciiEventTest) {
+    Telemetry_frame frame;
+    Message msg;
+    ASSERT_TRUE(telemetry_encode_event(TELEMETRY_ASCII, EVENT_SUPERCAP3_NOT_READY, &frame));
+    frame_to_message(&frame, &msg);
+    EXPECT_EQ(MSG_TYPE_DATA, msg.msg_type);
+    EXPECT_EQ(strlen("supercapacitor 3 is not ready"), msg.length);
+    EXPECT_EQ(0, memcmp("supercapacitor 3 is not ready", msg.payload, msg.length));
+
+    ASSERT_TRUE(telemetry_encode_event(TELEMETRY_ASCII, EVENT_TEMP_SENSOR_1_BROKEN, &frame));
+    EXPECT_EQ(MSG_TYPE_ERROR, frame.msg_type);
+    ASSERT_TRUE(telemetry_encode_event(TELEMETRY_ASCII, EVENT_TRANSIT, &frame));
+    EXPECT_EQ(MSG_TYPE_RESPONSE, frame.msg_type);
+}
+
+TEST(telemetryTestSuite, binaryMeasurementTest) {
+    Telemetry_frame frame;
+    Message msg;
+    ASSERT_TRUE(telemetry_encode_measurement(TELEMETRY_BINARY, MEASUREMENT_TEMP_SENSOR_1, -1234, &frame));
+    frame_to_message(&frame, &msg);
+
+    EXPECT_EQ(MSG_TYPE_TELEMETRY, msg.msg_type);
+    ASSERT_EQ(TELEMETRY_MEASUREMENT_RECORD_SIZE, msg.length);
+    EXPECT_EQ(MEASUREMENT_TEMP_SENSOR_1, msg.payload[0]);
+    EXPECT_EQ(0xFB, msg.payload[1]);
+    EXPECT_EQ(0x2E, msg.payload[2]);
+}
+
+TEST(telemetryTestSuite, asciiMeasurementTest) {
+    Telemetry_frame frame;
+    Message msg;
+    ASSERT_TRUE(telemetry_encode_measurement(TELEMETRY_ASCII, MEASUREMENT_BUS_VOLTAGE, 3300, &frame));
+    frame_to_message(&frame, &msg);
+
+    const char *expected = "3.300 is the current bus voltage";
+    EXPECT_EQ(MSG_TYPE_DATA, msg.msg_type);
+    ASSERT_EQ(strlen(expected), msg.length);
+    EXPECT_EQ(0, memcmp(expected, msg.payload, msg.length));
+
+    // the active fraction of the CPU has one measurement per transit mode
+    ASSERT_TRUE(telemetry_encode_measurement(TELEMETRY_ASCII, MEASUREMENT_CPU_ACTIVE_TRANSIT, 25, &frame));
+    frame_to_message(&frame, &msg);
+    expected = "2.5 % of the time the CPU was awake in TRANSIT";
+    ASSERT_EQ(strlen(expected), msg.length);
+    EXPECT_EQ(0, memcmp(expected, msg.payload, msg.length));
+}
+
+TEST(telemetryTestSuite, formatValueTest) {
+    uint8_t text[TELEMETRY_VALUE_TEXT_SIZE];
+    uint8_t length;
+
+    length = telemetry_format_value(0, 3, text);
+    EXPECT_EQ(0, memcmp("0.000", text, length));
+    length = telemetry_format_value(7, 2, text);
+    EXPECT_EQ(0, memcmp("0.07", text, length));
+    length = telemetry_format_value(-550, 2, text);
+    EXPECT_EQ(0, memcmp("-5.50", text, length));
+    length = telemetry_format_value(12345, 0, text);
+    EXPECT_EQ(0, memcmp("12345", text, length));
+    length = telemetry_format_value(-32768, 2, text);
+    ASSERT_EQ(7, length);
+    EXPECT_EQ(0, memcmp("-327.68", text, length));
+}
+
+TEST(telemetryTestSuite, unknownIdTest) {
+    Telemetry_frame frame;
+    EXPECT_FALSE(telemetry_encode_event(TELEMETRY_BINARY, (Telemetry_event)0, &frame));
+    EXPECT_FALSE(telemetry_encode_event(TELEMETRY_BINARY, TELEMETRY_EVENT_END, &frame));
+    EXPECT_FALSE(telemetry_encode_measurement(TELEMETRY_ASCII, TELEMETRY_MEASUREMENT_END, 0, &frame));
+    EXPECT_EQ(0, telemetry_record_size(0));
+    EXPECT_EQ(0, telemetry_record_size(0x7F));
+    EXPECT_EQ(0, telemetry_record_size(0xFF));
+}
+
+TEST(telemetryTestSuite, decodeRoundTripTest) {
+    Telemetry_frame frame;
+    Message binary, ascii;
+    char text[UART_BUFFER_SIZE];
+    char expected[UART_BUFFER_SIZE];
+
+    for (uint8_t id = 1; id < TELEMETRY_EVENT_END; id++) {
+        ASSERT_TRUE(telemetry_encode_event(TELEMETRY_BINARY, (Telemetry_event)id, &frame));
+        frame_to_message(&frame, &binary);
+        ASSERT_TRUE(telemetry_encode_event(TELEMETRY_ASCII, (Telemetry_event)id, &frame));
+        frame_to_message(&frame, &ascii);
+
+        EXPECT_EQ(1, telemetry_decode(&binary, text, sizeof(text)));
+        snprintf(expected, sizeof(expected), "%.*s\n", ascii.length, (const char *)ascii.payload);
+        EXPECT_STREQ(expected, text);
+    }
+
+    const int16_t values[] = {0, 1, -1, 3300, -2750, 32767, -32768};
+    for (uint8_t id = TELEMETRY_FIRST_MEASUREMENT; id < TELEMETRY_MEASUREMENT_END; id++) {
+        for (uint8_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            ASSERT_TRUE(telemetry_encode_measurement(TELEMETRY_BINARY, (Telemetry_measurement)id, values[i], &frame));
+            frame_to_message(&frame, &binary);
+            ASSERT_TRUE(telemetry_encode_measurement(TELEMETRY_ASCII, (Telemetry_measurement)id, values[i], &frame));
+            frame_to_message(&frame, &ascii);
+
+            EXPECT_EQ(1, telemetry_decode(&binary, text, sizeof(text)));
+            snprintf(expected, sizeof(expected), "%.*s\n", ascii.length, (const char *)ascii.payload);
+            EXPECT_STREQ(expected, text);
+        }
+    }
+}
+
+TEST(telemetryTestSuite, severalRecordsTest) {
+    Message msg;
+    msg.msg_type = MSG_TYPE_TELEMETRY;
+    const uint8_t records[] = {EVENT_NEA1_READY, MEASUREMENT_TEMP_SENSOR_2, 0x08, 0x66, EVENT_POWER_ROVER_OFF};
+    memcpy(msg.payload, records, sizeof(records));
+    msg.length = sizeof(records);
+
+    char text[UART_BUFFER_SIZE];
+    EXPECT_EQ(3, telemetry_decode(&msg, text, sizeof(text)));
+    EXPECT_STREQ("NEA 1 is ready\n21.50 is the current temperature of sensor 2\nPower to the rover is switched off\n", text);
+
+    // text that does not fit is cut off
+    char small[10];
+    EXPECT_EQ(3, telemetry_decode(&msg, small, sizeof(small)));
+    EXPECT_STREQ("NEA 1 is ", small);
+}
+
+TEST(telemetryTestSuite, brokenRecordTest) {
+    Message msg;
+    char text[UART_BUFFER_SIZE];
+    msg.msg_type = MSG_TYPE_TELEMETRY;
+
+    // unknown ID
+    msg.payload[0] = 0x7F;
+    msg.length = 1;
+    EXPECT_EQ(-1, telemetry_decode(&msg, text, sizeof(text)));
+
+    // measurement without its value
+    msg.payload[0] = EVENT_NEA2_READY;
+    msg.payload[1] = MEASUREMENT_BUS_VOLTAGE;
+    msg.payload[2] = 0x0C;
+    msg.length = 3;
+    EXPECT_EQ(-1, telemetry_decode(&msg, text, sizeof(text)));
+}
+
+TEST(telemetryTestSuite, savingsReport) {
+    Telemetry_frame frame;
+    SLIP_frame_info info;
+    uint32_t ascii_bytes = 0;
+    uint32_t binary_bytes = 0;
+    uint8_t count = 0;
+
+    for (uint8_t id = 1; id < TELEMETRY_EVENT_END; id++) {
+        telemetry_encode_event(TELEMETRY_ASCII, (Telemetry_event)id, &frame);
+        ASSERT_TRUE(slip_frame_prepare(frame.msg_type, frame.segments, frame.segment_count, FRAME_CHECK_XOR8, &info));
+        ascii_bytes += info.encoded_length;
+        telemetry_encode_event(TELEMETRY_BINARY, (Telemetry_event)id, &frame);
+        ASSERT_TRUE(slip_frame_prepare(frame.msg_type, frame.segments, frame.segment_count, FRAME_CHECK_XOR8, &info));
+        binary_bytes += info.encoded_length;
+        count++;
+    }
+    for (uint8_t id = TELEMETRY_FIRST_MEASUREMENT; id < TELEMETRY_MEASUREMENT_END; id++) {
+        telemetry_encode_measurement(TELEMETRY_ASCII, (Telemetry_measurement)id, 2150, &frame);
+        ASSERT_TRUE(slip_frame_prepare(frame.msg_type, frame.segments, frame.segment_count, FRAME_CHECK_XOR8, &info));
+        ascii_bytes += info.encoded_length;
+        telemetry_encode_measurement(TELEMETRY_BINARY, (Telemetry_measurement)id, 2150, &frame);
+        ASSERT_TRUE(slip_frame_prepare(frame.msg_type, frame.segments, frame.segment_count, FRAME_CHECK_XOR8, &info));
+        binary_bytes += info.encoded_length;
+        count++;
+    }
+
+    EXPECT_LT(binary_bytes, ascii_bytes);
+    printf("[   INFO   ] %u telemetry frames: %u bytes on the wire in ASCII, %u bytes in binary (%.1f %% less)\n",
+           count, ascii_bytes, binary_bytes, 100.0 * (ascii_bytes - binary_bytes) / ascii_bytes);
+}
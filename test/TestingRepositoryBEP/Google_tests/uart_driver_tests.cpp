@@ -0,0 +1,201 @@
+/*
+ * uart_driver_tests.cpp file
+ *
+ * Testing file for the transmit path of the UART driver uart_communication.cpp. The real driver and its interrupt
+ * service routine run against the register mock in msp430_mock/, which clears UCTXIFG on the UCA1IV read like the
+ * eUSCI does. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Consecutive frames test: Frames written with uart_write after the queue has drained are all sent, not only the
+ *   first one after the reset.
+ * - TX start test: Frames that are written straight into TX_queue and started with uart_tx_start are all sent.
+ * - Idle flag test: When the queue has drained the TX interrupt is disabled and UCTXIFG is set, such that enabling the
+ *   interrupt again starts the next frame.
+ * - Block policy test: A frame larger than the queue is sent completely while uart_write sleeps for room, also after
+ *   an earlier frame has drained.
+ * - Drop frame policy test: A frame that does not fit is dropped as a whole and counted, the next one is sent.
+ * - Reserve test: uart_tx_reserve sleeps until the room is there and refuses frames larger than the queue.
+ * - Flush test: uart_flush returns once the last character has left the shift register.
+ * - Flush while receiving test: uart_flush sleeps on the transmit complete interrupt and returns while the lander keeps
+ *   transmitting, the busy receiver does not hold it up.
+ * - Idle flush test: uart_flush returns right away when nothing has been sent, also after an earlier flush.
+ */
+
+#include "gtest/gtest.h"
+#include <msp430.h>
+#include <lander_communication_lib/uart_communication.h>
+#include <system_health_lib/main_system_init.h>
+#include <cstring>
+#include <vector>
+
+// Parts of the firmware outside of the driver that it uses
+volatile transit_states transit_state;
+
+bool system_timer_start(Soft_timer *timer, uint16_t delay_ms, uint16_t period_ms) {
+    return true;
+}
+
+void system_timer_stop(Soft_timer *timer) {}
+
+// Character times after which the transmitter is expected to be done
+#define DRIVER_MAX_STEPS 4000
+
+/*
+ * Resets the eUSCI and configures the driver like boot_up_initialisation does.
+ */
+static void driver_reset(UART_TX_full_policy policy) {
+    msp430_mock_reset();
+    uart_configure();
+    TX_full_policy = policy;
+}
+
+/*
+ * Lets character times pass until the queue and the transmitter are empty, a few more such that the TX interrupt has
+ * seen the empty queue.
+ */
+static void run_until_idle(void) {
+    uint16_t steps = 0;
+    while ((!uart_tx_queue_is_empty(&TX_queue) || UCA1STATW != 0) && steps < DRIVER_MAX_STEPS) {
+        msp430_mock_uart_step();
+        steps++;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        msp430_mock_uart_step();
+    }
+}
+
+static std::vector<uint8_t> wire_contents(void) {
+    uint16_t length;
+    const uint8_t *wire = msp430_mock_wire(&length);
+    return std::vector<uint8_t>(wire, wire + length);
+}
+
+static std::vector<uint8_t> make_frame(uint16_t length, uint8_t seed) {
+    std::vector<uint8_t> frame(length);
+    for (uint16_t i = 0; i < length; i++) {
+        frame[i] = (uint8_t)(seed + i * 7);
+    }
+    return frame;
+}
+
+TEST(uartDriverTestSuite, consecutiveFramesTest) {
+    driver_reset(UART_TX_BLOCK);
+    std::vector<uint8_t> expected;
+    for (uint8_t f = 0; f < 4; f++) {
+        std::vector<uint8_t> frame = make_frame((uint16_t)(20 + f * 30), f);
+        ASSERT_TRUE(uart_write(frame.data(), (uint16_t)frame.size()));
+        expected.insert(expected.end(), frame.begin(), frame.end());
+        run_until_idle();
+        ASSERT_EQ(expected, wire_contents()) << "frame " << (int)f;
+    }
+}
+
+TEST(uartDriverTestSuite, txStartTest) {
+    driver_reset(UART_TX_BLOCK);
+    std::vector<uint8_t> expected;
+    for (uint8_t f = 0; f < 4; f++) {
+        std::vector<uint8_t> frame = make_frame(50, (uint8_t)(f * 11));
+        ASSERT_TRUE(uart_tx_reserve((uint16_t)frame.size()));
+        ASSERT_EQ(frame.size(), uart_tx_queue_push(&TX_queue, frame.data(), (uint16_t)frame.size()));
+        uart_tx_start();
+        expected.insert(expected.end(), frame.begin(), frame.end());
+        run_until_idle();
+        ASSERT_EQ(expected, wire_contents()) << "frame " << (int)f;
+    }
+}
+
+TEST(uartDriverTestSuite, idleFlagTest) {
+    driver_reset(UART_TX_BLOCK);
+    std::vector<uint8_t> frame = make_frame(10, 1);
+    ASSERT_TRUE(uart_write(frame.data(), (uint16_t)frame.size()));
+    run_until_idle();
+    EXPECT_EQ(0, UCA1IE & UCTXIE);
+    EXPECT_EQ(UCTXIFG, UCA1IFG & UCTXIFG);
+    EXPECT_EQ(UCRXIE, UCA1IE & UCRXIE);
+}
+
+TEST(uartDriverTestSuite, blockPolicyTest) {
+    driver_reset(UART_TX_BLOCK);
+    std::vector<uint8_t> first = make_frame(30, 3);
+    ASSERT_TRUE(uart_write(first.data(), (uint16_t)first.size()));
+    run_until_idle();
+
+    std::vector<uint8_t> large = make_frame(600, 5);
+    ASSERT_TRUE(uart_write(large.data(), (uint16_t)large.size()));
+    run_until_idle();
+
+    std::vector<uint8_t> expected = first;
+    expected.insert(expected.end(), large.begin(), large.end());
+    EXPECT_EQ(expected, wire_contents());
+    EXPECT_EQ(0, TX_queue.dropped_frames);
+}
+
+TEST(uartDriverTestSuite, dropFramePolicyTest) {
+    driver_reset(UART_TX_DROP_FRAME);
+    std::vector<uint8_t> frame = make_frame(200, 9);
+    EXPECT_TRUE(uart_write(frame.data(), (uint16_t)frame.size()));
+    EXPECT_FALSE(uart_write(frame.data(), (uint16_t)frame.size()));
+    EXPECT_EQ(1, TX_queue.dropped_frames);
+    run_until_idle();
+    EXPECT_EQ(frame, wire_contents());
+
+    // after the queue has drained the next frame is sent again
+    EXPECT_TRUE(uart_write(frame.data(), (uint16_t)frame.size()));
+    run_until_idle();
+    EXPECT_EQ(2 * frame.size(), wire_contents().size());
+}
+
+TEST(uartDriverTestSuite, reserveTest) {
+    driver_reset(UART_TX_BLOCK);
+    std::vector<uint8_t> first = make_frame(40, 2);
+    ASSERT_TRUE(uart_write(first.data(), (uint16_t)first.size()));
+    run_until_idle();
+
+    std::vector<uint8_t> full = make_frame(UART_TX_QUEUE_SIZE - 10, 4);
+    ASSERT_TRUE(uart_write(full.data(), (uint16_t)full.size()));
+    EXPECT_TRUE(uart_tx_reserve(200));
+    EXPECT_GE(uart_tx_queue_free(&TX_queue), 200);
+    EXPECT_FALSE(uart_tx_reserve(UART_TX_QUEUE_SIZE));
+    EXPECT_EQ(1, TX_queue.dropped_frames);
+    run_until_idle();
+    EXPECT_EQ(first.size() + full.size(), wire_contents().size());
+}
+
+TEST(uartDriverTestSuite, flushTest) {
+    driver_reset(UART_TX_BLOCK);
+    std::vector<uint8_t> expected;
+    for (uint8_t f = 0; f < 3; f++) {
+        std::vector<uint8_t> frame = make_frame(64, (uint8_t)(f * 3));
+        ASSERT_TRUE(uart_write(frame.data(), (uint16_t)frame.size()));
+        uart_flush();
+        expected.insert(expected.end(), frame.begin(), frame.end());
+        EXPECT_TRUE(uart_tx_queue_is_empty(&TX_queue));
+        EXPECT_EQ(expected, wire_contents()) << "frame " << (int)f;
+    }
+}
+
+TEST(uartDriverTestSuite, flushWhileReceivingTest) {
+    driver_reset(UART_TX_BLOCK);
+    msp430_mock_set_receiving(true);
+    std::vector<uint8_t> expected;
+    for (uint8_t f = 0; f < 3; f++) {
+        std::vector<uint8_t> frame = make_frame(40, (uint8_t)(f * 5));
+        ASSERT_TRUE(uart_write(frame.data(), (uint16_t)frame.size()));
+        ASSERT_NO_THROW(uart_flush());
+        expected.insert(expected.end(), frame.begin(), frame.end());
+        EXPECT_EQ(expected, wire_contents()) << "frame " << (int)f;
+    }
+    EXPECT_EQ(0, UCA1IE & UCTXCPTIE);
+}
+
+TEST(uartDriverTestSuite, idleFlushTest) {
+    driver_reset(UART_TX_BLOCK);
+    ASSERT_NO_THROW(uart_flush());
+    std::vector<uint8_t> frame = make_frame(20, 6);
+    ASSERT_TRUE(uart_write(frame.data(), (uint16_t)frame.size()));
+    uart_flush();
+    ASSERT_NO_THROW(uart_flush());
+    EXPECT_EQ(frame, wire_contents());
+}
@@ -0,0 +1,227 @@
+/*
+ * uart_rx_queue_tests.cpp file
+ *
+ * Testing file for the UART receive queue. Multiple tests are executed here to demonstrate that the queue behaves as expected. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Empty queue test: A freshly initialised queue is empty and has nothing to peek at.
+ * - Push and pop test: Frames come out of the queue in the order they were put in.
+ * - Full queue test: A frame that does not fit is dropped and counted.
+ * - High water test: The largest amount of waiting frames is remembered.
+ * - Wrap around test: The descriptor indexes wrap around without losing frames.
+ * - Lander burst test: A mode change, an ACK and a request sent back to back are all received while the main loop is busy.
+ * - Descriptor overflow test: Frames beyond the queue size are dropped and their ring buffer space is given back.
+ * - Ring buffer overflow test: Frames that do not fit in the ring buffer next to the waiting ones are counted as overflows.
+ */
+
+#include "gtest/gtest.h"
+#include "lander_communication.h"
+#include <lander_communication_lib/uart_rx_queue.h>
+#include <cstring>
+
+#define TEST_RING_SIZE 256
+
+// uart_interrupt_handler from uart_communication.cpp without the timeout and state handling
+static void simulated_rx_interrupt(SLIP_stream_decoder *decoder, UART_RX_queue *queue, const uint8_t *data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        if (slip_stream_decode_byte(decoder, data[i]) == SLIP_STREAM_FRAME_READY) {
+            if (!uart_rx_queue_push(queue, &decoder->last_frame)) {
+                slip_stream_drop_last_frame(decoder);
+            }
+        }
+    }
+}
+
+// uart_receive_frame from uart_communication.cpp
+static bool simulated_receive_frame(SLIP_stream_decoder *decoder, UART_RX_queue *queue, Message *msg) {
+    const SLIP_stream_frame *frame = uart_rx_queue_peek(queue);
+    if (frame == NULL) {
+        return false;
+    }
+    slip_stream_frame_to_message(decoder, frame, msg);
+    slip_stream_release(decoder, frame);
+    uart_rx_queue_pop(queue);
+    return true;
+}
+
+// Appends a SLIP encoded frame of the Message protocol to a stream of characters
+static void append_frame(uint8_t msg_type, const char *payload, uint8_t *stream, uint16_t *stream_length) {
+    Message msg;
+    msg.start_byte = MSG_START_BYTE;
+    msg.msg_type = msg_type;
+    msg.length = (uint8_t)strlen(payload);
+    memcpy(msg.payload, payload, msg.length);
+    msg.checksum = calculate_checksum_helper(msg_type, msg.length, msg.payload);
+    msg.end_byte = MSG_END_BYTE;
+    uint8_t serialized[UART_BUFFER_SIZE];
+    uint8_t serialized_length;
+    convert_message_to_array(&msg, serialized, &serialized_length);
+    uint16_t encoded_length;
+    slip_encode(serialized, serialized_length, &stream[*stream_length], &encoded_length);
+    *stream_length += encoded_length;
+}
+
+static SLIP_stream_frame make_frame(uint8_t msg_type, uint8_t length, uint16_t offset) {
+    SLIP_stream_frame frame;
+    frame.msg_type = msg_type;
+    frame.length = length;
+    frame.offset = offset;
+    frame.checksum = 0;
+    return frame;
+}
+
+TEST(uartRxQueueTestSuite, emptyQueueTest) {
+    UART_RX_queue queue;
+    uart_rx_queue_init(&queue);
+
+    EXPECT_TRUE(uart_rx_queue_is_empty(&queue));
+    EXPECT_EQ(0, uart_rx_queue_count(&queue));
+    EXPECT_EQ(NULL, uart_rx_queue_peek(&queue));
+    EXPECT_FALSE(uart_rx_queue_pop(&queue));
+}
+
+TEST(uartRxQueueTestSuite, pushAndPopTest) {
+    UART_RX_queue queue;
+    uart_rx_queue_init(&queue);
+
+    for (uint8_t i = 0; i < 3; i++) {
+        SLIP_stream_frame frame = make_frame(i + 1, i, i * 10);
+        EXPECT_TRUE(uart_rx_queue_push(&queue, &frame));
+    }
+    EXPECT_EQ(3, uart_rx_queue_count(&queue));
+
+    for (uint8_t i = 0; i < 3; i++) {
+        const SLIP_stream_frame *frame = uart_rx_queue_peek(&queue);
+        ASSERT_TRUE(frame != NULL);
+        EXPECT_EQ(i + 1, frame->msg_type);
+        EXPECT_EQ(i * 10, frame->offset);
+        EXPECT_TRUE(uart_rx_queue_pop(&queue));
+    }
+    EXPECT_TRUE(uart_rx_queue_is_empty(&queue));
+    EXPECT_EQ(3, queue.received_frames);
+}
+
+TEST(uartRxQueueTestSuite, fullQueueTest) {
+    UART_RX_queue queue;
+    uart_rx_queue_init(&queue);
+    SLIP_stream_frame frame = make_frame(MSG_TYPE_ACK, 0, 0);
+
+    for (uint8_t i = 0; i < UART_RX_QUEUE_SIZE - 1; i++) {
+        EXPECT_TRUE(uart_rx_queue_push(&queue, &frame));
+    }
+    EXPECT_FALSE(uart_rx_queue_push(&queue, &frame));
+    EXPECT_EQ(UART_RX_QUEUE_SIZE - 1, uart_rx_queue_count(&queue));
+    EXPECT_EQ(1, queue.dropped_frames);
+}
+
+TEST(uartRxQueueTestSuite, highWaterTest) {
+    UART_RX_queue queue;
+    uart_rx_queue_init(&queue);
+    SLIP_stream_frame frame = make_frame(MSG_TYPE_ACK, 0, 0);
+
+    uart_rx_queue_push(&queue, &frame);
+    uart_rx_queue_push(&queue, &frame);
+    uart_rx_queue_push(&queue, &frame);
+    uart_rx_queue_pop(&queue);
+    uart_rx_queue_pop(&queue);
+    uart_rx_queue_push(&queue, &frame);
+
+    EXPECT_EQ(3, queue.high_water);
+}
+
+TEST(uartRxQueueTestSuite, wrapAroundTest) {
+    UART_RX_queue queue;
+    uart_rx_queue_init(&queue);
+
+    for (uint16_t i = 0; i < 5 * UART_RX_QUEUE_SIZE; i++) {
+        SLIP_stream_frame first = make_frame(MSG_TYPE_DATA, 1, i);
+        SLIP_stream_frame second = make_frame(MSG_TYPE_DATA, 2, i + 1);
+        EXPECT_TRUE(uart_rx_queue_push(&queue, &first));
+        EXPECT_TRUE(uart_rx_queue_push(&queue, &second));
+        EXPECT_EQ(i, uart_rx_queue_peek(&queue)->offset);
+        uart_rx_queue_pop(&queue);
+        EXPECT_EQ(i + 1, uart_rx_queue_peek(&queue)->offset);
+        uart_rx_queue_pop(&queue);
+    }
+    EXPECT_EQ(0, queue.dropped_frames);
+}
+
+TEST(uartRxQueueTestSuite, landerBurstTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    UART_RX_queue queue;
+    uart_rx_queue_init(&queue);
+
+    // the lander sends a mode change, an ACK and a request before the main loop gets to process_received_data
+    uint8_t stream[3 * UART_BUFFER_SIZE];
+    uint16_t stream_length = 0;
+    append_frame(MSG_TYPE_TRANSIT_MODE, "PD", stream, &stream_length);
+    append_frame(MSG_TYPE_ACK, "", stream, &stream_length);
+    append_frame(MSG_TYPE_REQUEST, "status", stream, &stream_length);
+    simulated_rx_interrupt(&decoder, &queue, stream, stream_length);
+
+    EXPECT_EQ(3, uart_rx_queue_count(&queue));
+
+    Message msg;
+    ASSERT_TRUE(simulated_receive_frame(&decoder, &queue, &msg));
+    EXPECT_EQ(MSG_TYPE_TRANSIT_MODE, msg.msg_type);
+    EXPECT_EQ(0, memcmp("PD", msg.payload, 2));
+    ASSERT_TRUE(simulated_receive_frame(&decoder, &queue, &msg));
+    EXPECT_EQ(MSG_TYPE_ACK, msg.msg_type);
+    ASSERT_TRUE(simulated_receive_frame(&decoder, &queue, &msg));
+    EXPECT_EQ(MSG_TYPE_REQUEST, msg.msg_type);
+    EXPECT_EQ(0, memcmp("status", msg.payload, 6));
+    EXPECT_FALSE(simulated_receive_frame(&decoder, &queue, &msg));
+
+    EXPECT_EQ(0, queue.dropped_frames);
+    EXPECT_EQ(decoder.read_index, decoder.write_index);
+}
+
+TEST(uartRxQueueTestSuite, descriptorOverflowTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    UART_RX_queue queue;
+    uart_rx_queue_init(&queue);
+
+    uint8_t stream[UART_RX_QUEUE_SIZE * 16];
+    uint16_t stream_length = 0;
+    for (uint8_t i = 0; i < UART_RX_QUEUE_SIZE; i++) {
+        append_frame(MSG_TYPE_DATA, "ab", stream, &stream_length);
+    }
+    simulated_rx_interrupt(&decoder, &queue, stream, stream_length);
+
+    EXPECT_EQ(UART_RX_QUEUE_SIZE - 1, uart_rx_queue_count(&queue));
+    EXPECT_EQ(1, queue.dropped_frames);
+
+    // only the queued frames occupy the ring buffer
+    Message msg;
+    while (simulated_receive_frame(&decoder, &queue, &msg)) {}
+    EXPECT_EQ(decoder.read_index, decoder.write_index);
+}
+
+TEST(uartRxQueueTestSuite, ringBufferOverflowTest) {
+    uint8_t ring[TEST_RING_SIZE];
+    SLIP_stream_decoder decoder;
+    slip_stream_init(&decoder, ring, TEST_RING_SIZE, FRAME_CHECK_XOR8);
+    UART_RX_queue queue;
+    uart_rx_queue_init(&queue);
+    char payload[101];
+    memset(payload, 'x', 100);
+    payload[100] = '\0';
+
+    // three frames of 100 bytes do not fit in a ring buffer of 256 bytes at the same time
+    uint8_t stream[3 * UART_BUFFER_SIZE];
+    uint16_t stream_length = 0;
+    append_frame(MSG_TYPE_DATA, payload, stream, &stream_length);
+    append_frame(MSG_TYPE_DATA, payload, stream, &stream_length);
+    append_frame(MSG_TYPE_DATA, payload, stream, &stream_length);
+    simulated_rx_interrupt(&decoder, &queue, stream, stream_length);
+
+    EXPECT_EQ(2, uart_rx_queue_count(&queue));
+    EXPECT_EQ(1, decoder.overflows);
+    EXPECT_EQ(0, queue.dropped_frames);
+}
@@ -0,0 +1,116 @@
+/*
+ * uart_tx_queue_tests.cpp file
+ *
+ * Testing file for the UART transmission queue. Multiple tests are executed here to demonstrate that the queue behaves as expected. Below is a list of all tested functionalities and situations.
+ * Created on 17/10/2026.
+ * Last edited: 17/10/2026.
+ *
+ * Tests:
+ * - Empty queue test: A freshly initialised queue is empty and has UART_TX_QUEUE_SIZE - 1 free slots.
+ * - Push and pop test: Bytes come out of the queue in the order they were put in.
+ * - Pop from empty queue test: Popping an empty queue fails and leaves the output untouched.
+ * - Full queue test: Pushing more bytes than there is room for only queues the bytes that fit.
+ * - Push byte when full test: A single byte cannot be added to a full queue.
+ * - Wrap around test: A frame that crosses the end of the ring buffer is sent unchanged.
+ * - High water test: The largest fill level is remembered.
+ *
+ * uart_write, the full policies and the TX interrupt are tested on the real driver in uart_driver_tests.cpp.
+ */
+
+#include "gtest/gtest.h"
+#include <lander_communication_lib/uart_tx_queue.h>
+#include <cstring>
+
+TEST(uartTxQueueTestSuite, emptyQueueTest) {
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+
+    EXPECT_TRUE(uart_tx_queue_is_empty(&queue));
+    EXPECT_EQ(0, uart_tx_queue_used(&queue));
+    EXPECT_EQ(UART_TX_QUEUE_SIZE - 1, uart_tx_queue_free(&queue));
+}
+
+TEST(uartTxQueueTestSuite, pushAndPopTest) {
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+    uint8_t input[] = {0xC0, 0x7E, 0x01, 0x04, 0x74, 0x65, 0x73, 0x74, 0x13, 0x7F, 0xC0};
+
+    EXPECT_EQ(sizeof(input), uart_tx_queue_push(&queue, input, sizeof(input)));
+    EXPECT_EQ(sizeof(input), uart_tx_queue_used(&queue));
+
+    for (uint16_t i = 0; i < sizeof(input); i++) {
+        uint8_t character = 0;
+        EXPECT_TRUE(uart_tx_queue_pop(&queue, &character));
+        EXPECT_EQ(input[i], character);
+    }
+    EXPECT_TRUE(uart_tx_queue_is_empty(&queue));
+}
+
+TEST(uartTxQueueTestSuite, popFromEmptyQueueTest) {
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+    uint8_t character = 0xAA;
+
+    EXPECT_FALSE(uart_tx_queue_pop(&queue, &character));
+    EXPECT_EQ(0xAA, character);
+}
+
+TEST(uartTxQueueTestSuite, fullQueueTest) {
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+    uint8_t input[300];
+    memset(input, 0x55, sizeof(input));
+
+    EXPECT_EQ(UART_TX_QUEUE_SIZE - 1, uart_tx_queue_push(&queue, input, sizeof(input)));
+    EXPECT_EQ(0, uart_tx_queue_free(&queue));
+    EXPECT_EQ(0, uart_tx_queue_push(&queue, input, 1));
+}
+
+TEST(uartTxQueueTestSuite, pushByteWhenFullTest) {
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+
+    for (uint16_t i = 0; i < UART_TX_QUEUE_SIZE - 1; i++) {
+        EXPECT_TRUE(uart_tx_queue_push_byte(&queue, (uint8_t)i));
+    }
+    EXPECT_FALSE(uart_tx_queue_push_byte(&queue, 0x00));
+}
+
+TEST(uartTxQueueTestSuite, wrapAroundTest) {
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+    uint8_t filler[200] = {0};
+    uint8_t input[100];
+    for (uint16_t i = 0; i < sizeof(input); i++) {
+        input[i] = (uint8_t)(i * 3);
+    }
+
+    // move the indexes close to the end of the ring
+    uart_tx_queue_push(&queue, filler, sizeof(filler));
+    uint8_t character;
+    for (uint16_t i = 0; i < sizeof(filler); i++) {
+        uart_tx_queue_pop(&queue, &character);
+    }
+
+    EXPECT_EQ(sizeof(input), uart_tx_queue_push(&queue, input, sizeof(input)));
+    for (uint16_t i = 0; i < sizeof(input); i++) {
+        EXPECT_TRUE(uart_tx_queue_pop(&queue, &character));
+        EXPECT_EQ(input[i], character);
+    }
+    EXPECT_TRUE(uart_tx_queue_is_empty(&queue));
+}
+
+TEST(uartTxQueueTestSuite, highWaterTest) {
+    UART_TX_queue queue;
+    uart_tx_queue_init(&queue);
+    uint8_t input[120] = {0};
+    uint8_t character;
+
+    uart_tx_queue_push(&queue, input, 120);
+    for (uint16_t i = 0; i < 100; i++) {
+        uart_tx_queue_pop(&queue, &character);
+    }
+    uart_tx_queue_push(&queue, input, 50);
+
+    EXPECT_EQ(120, queue.high_water);
+}
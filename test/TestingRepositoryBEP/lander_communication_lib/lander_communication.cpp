@@ -11,6 +11,7 @@
  */
 
 #include "lander_communication.h"
+#include <lander_communication_lib/slip_scan.h>
 #include <cstring>
 
 
@@ -101,7 +102,26 @@ bool slip_encode(const uint8_t *buffer, uint16_t length, uint8_t *output_buffer,
     uint16_t index = 0;
     output_buffer[index++] = END;
 
-    for (uint16_t i = 0; i < length; i++) {
+    uint16_t i = 0;
+    while (i < length) {
+        // fast path: aligned words without END or ESC are copied at once, as long as they fit before the final END
+        if (((uintptr_t)&buffer[i] & (sizeof(Slip_scan_word) - 1)) == 0) {
+            while (length - i >= sizeof(Slip_scan_word) && index + sizeof(Slip_scan_word) < UART_BUFFER_SIZE) {
+                Slip_scan_word word;
+                memcpy(&word, &buffer[i], sizeof(word));
+                if (slip_word_has_special(word)) {
+                    break;
+                }
+                memcpy(&output_buffer[index], &word, sizeof(word));
+                index += sizeof(Slip_scan_word);
+                i += sizeof(Slip_scan_word);
+            }
+            if (i == length) {
+                break;
+            }
+        }
+
+        // byte by byte around special bytes, at the unaligned start and in the last bytes
         switch (buffer[i]) {
             case END:
                 if (index + 2 >= UART_BUFFER_SIZE) {
@@ -126,6 +146,7 @@ bool slip_encode(const uint8_t *buffer, uint16_t length, uint8_t *output_buffer,
                 }
                 output_buffer[index++] = buffer[i];
         }
+        i++;
     }
 
     output_buffer[index++] = END;
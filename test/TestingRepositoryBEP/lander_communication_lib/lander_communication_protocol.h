@@ -16,14 +16,22 @@
 #include <cstdint>
 
 // Message type codes
-#define MSG_TYPE_INIT        0x01
-#define MSG_TYPE_ACK         0x02
-#define MSG_TYPE_REQUEST     0x03
-#define MSG_TYPE_DATA        0x04
-#define MSG_TYPE_RESPONSE    0x05
-#define MSG_TYPE_DEPLOYMENT  0x06
-#define MSG_TYPE_MODE        0x07
-#define MSG_TYPE_ERROR       0x08
+#define MSG_TYPE_INIT           0x01
+#define MSG_TYPE_ACK            0x02
+#define MSG_TYPE_NACK           0x03
+#define MSG_TYPE_REQUEST        0x04
+#define MSG_TYPE_DATA           0x05
+#define MSG_TYPE_RESPONSE       0x06
+#define MSG_TYPE_DEPLOY         0x07
+#define MSG_TYPE_TRANSIT_MODE   0x08
+#define MSG_TYPE_ERROR          0x09
+#define MSG_TYPE_ARQ_ACK        0x0A    // ACK of the sliding-window ARQ, see arq.h
+#define MSG_TYPE_TELEMETRY      0x0B    // binary telemetry records, see telemetry.h
+#define MSG_TYPE_CONTAINER      0x0C    // several messages in one frame, see message_batch.h
+#define MSG_TYPE_LINK_SPEED     0x0D    // link speed negotiation, see link_speed.h
+
+// Set in the message type of frames that are sent through the sliding-window ARQ
+#define MSG_TYPE_RELIABLE       0x80
 
 #define MSG_START_BYTE  0x7E
 #define MSG_END_BYTE    0x7F
@@ -36,7 +44,7 @@ typedef struct {
     uint8_t msg_type;
     uint8_t length;
     uint8_t payload[MAX_PAYLOAD_SIZE]; // pointer to payload array
-    uint8_t checksum;
+    uint16_t checksum; // same layout as the firmware Message, the host copy only uses the XOR checksum
     uint8_t end_byte;
 } Message;
 
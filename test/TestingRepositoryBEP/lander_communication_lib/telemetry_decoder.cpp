@@ -0,0 +1,62 @@
+/*
+ * telemetry_decoder.cpp file
+ *
+ * Host side decoder of the RDS telemetry, see telemetry_decoder.h.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#include "telemetry_decoder.h"
+#include <cstddef>
+
+// Appends characters to the text as long as they fit next to the null terminator
+static void append(char *text, uint16_t size, uint16_t *length, const uint8_t *characters, uint16_t count) {
+    for (uint16_t i = 0; i < count && *length + 1 < size; i++) {
+        text[(*length)++] = (char)characters[i];
+    }
+    text[*length] = '\0';
+}
+
+int telemetry_decode(const Message *msg, char *text, uint16_t size) {
+    uint16_t length = 0;
+    if (size == 0) {
+        return -1;
+    }
+    text[0] = '\0';
+
+    if (msg->msg_type != MSG_TYPE_TELEMETRY) {
+        append(text, size, &length, msg->payload, msg->length);
+        return 1;
+    }
+
+    int records = 0;
+    const uint8_t newline = '\n';
+    uint8_t index = 0;
+    while (index < msg->length) {
+        uint8_t id = msg->payload[index];
+        uint8_t record_size = telemetry_record_size(id);
+        if (record_size == 0 || index + record_size > msg->length) {
+            return -1;
+        }
+
+        const Telemetry_event_info *event = telemetry_event_info(id);
+        if (event != NULL) {
+            append(text, size, &length, payload_message_text((Message_id)event->message),
+                   payload_message_length((Message_id)event->message));
+        } else {
+            const Telemetry_measurement_info *measurement = telemetry_measurement_info(id);
+            int16_t value = (int16_t)((msg->payload[index + 1] << 8) | msg->payload[index + 2]);
+            uint8_t value_text[TELEMETRY_VALUE_TEXT_SIZE];
+            uint8_t value_length = telemetry_format_value(value, measurement->decimals, value_text);
+            append(text, size, &length, value_text, value_length);
+            append(text, size, &length, payload_message_text((Message_id)measurement->message),
+                   payload_message_length((Message_id)measurement->message));
+        }
+        append(text, size, &length, &newline, 1);
+        index += record_size;
+        records++;
+    }
+    return records;
+}
@@ -0,0 +1,33 @@
+/*
+ * telemetry_decoder.h file
+ *
+ * Host side decoder of the RDS telemetry. It turns the records of binary telemetry (MSG_TYPE_TELEMETRY) back into the
+ * same text that ASCII telemetry sends, using the telemetry catalog of the firmware.
+ *
+ * created: 17/10/2026
+ * Last edited: 17/10/2026
+ *
+ */
+
+#ifndef TELEMETRY_DECODER_H
+#define TELEMETRY_DECODER_H
+
+#include "lander_communication_protocol.h"
+#include <lander_communication_lib/telemetry.h>
+#include <cstdint>
+
+/*
+ * Turns a telemetry message into text, one line per event or measurement. The payload of an ASCII telemetry message
+ * is copied as it is. The text is always null terminated and cut off when it does not fit.
+ *
+ * parameters:
+ *  const Message *msg: received message
+ *  char *text: array for the text
+ *  uint16_t size: size of the array
+ *
+ * Returns:
+ *  int : amount of decoded records (1 for an ASCII message), -1 if a binary record is unknown or incomplete
+ */
+int telemetry_decode(const Message *msg, char *text, uint16_t size);
+
+#endif // TELEMETRY_DECODER_H